@@ -0,0 +1,57 @@
+/*
+ * ADC_SAMPLER.H - Continuous ADC sampling with statistics
+ * ESP-IDF adc_continuous DMA driver when available (Arduino Core 3.x),
+ * calibrated analogReadMilliVolts() polling task otherwise (Core 2.x).
+ * Per-channel mean / RMS / noise / min / max, noise histogram and
+ * optional FFT magnitude spectrum, all in millivolts (eFuse calibration)
+ */
+
+#ifndef ADC_SAMPLER_H
+#define ADC_SAMPLER_H
+
+#include <Arduino.h>
+
+#define ADC_SAMPLER_MAX_CHANNELS 8
+#define ADC_SAMPLER_WINDOW 1024          // Samples kept per channel (histogram / FFT)
+#define ADC_SAMPLER_FFT_SIZE 256         // Power of two, <= ADC_SAMPLER_WINDOW
+#define ADC_SAMPLER_HISTOGRAM_BINS 16
+
+struct ADCChannelStats {
+  int pin = -1;
+  uint32_t count = 0;       // Samples in the interval since the previous snapshot
+  float meanMv = 0.0;
+  float rmsMv = 0.0;        // Total RMS (DC + AC)
+  float noiseMv = 0.0;      // Standard deviation (AC RMS)
+  uint16_t minMv = 0;
+  uint16_t maxMv = 0;
+};
+
+struct ADCHistogram {
+  uint16_t startMv = 0;
+  uint16_t binMv = 1;
+  uint16_t counts[ADC_SAMPLER_HISTOGRAM_BINS] = {0};
+};
+
+struct ADCSamplerStatus {
+  bool running = false;
+  bool dma = false;             // true: adc_continuous, false: polling fallback
+  bool calibrated = false;      // eFuse calibration scheme in use
+  uint8_t channelCount = 0;
+  uint32_t sampleRate = 0;      // Aggregate conversions per second
+  uint32_t perChannelRate = 0;
+  uint32_t totalSamples = 0;
+  uint32_t overruns = 0;        // DMA pool overflows / late polling cycles
+  String error = "";
+};
+
+extern ADCSamplerStatus adcSamplerStatus;
+
+// Function declarations
+bool isADC1Pin(int pin);                    // Sampler channels: ADC1 only (ADC2 is shared with Wi-Fi)
+bool startADCSampler(const int* pins, uint8_t count, uint32_t sampleRate, String& error);
+void stopADCSampler();
+uint8_t snapshotADCSamplerStats(ADCChannelStats* out, uint8_t maxCount);
+bool computeADCHistogram(uint8_t channel, ADCHistogram& histogram);
+uint16_t computeADCSpectrum(uint8_t channel, float* magnitudesMv, uint16_t maxBins, float& binHz);
+
+#endif // ADC_SAMPLER_H
@@ -0,0 +1,43 @@
+/*
+ * ALLOC_TRACER.H - Per-scope heap allocation counters
+ * AllocScope counts malloc/calloc/realloc/free (String, new/delete and
+ * everything built on them) made by the calling task until it goes out of
+ * scope. Scopes nest; an inner scope's counts are added to the outer one.
+ * On target the hooks come from the linker's --wrap of the malloc family
+ * (ENABLE_ALLOC_TRACER, env esp32s3_n16r8_alloctrace); the native env
+ * calls them from native/shims/shim_heap.cpp. Direct heap_caps_malloc()
+ * calls are only counted in the native env
+ */
+
+#ifndef ALLOC_TRACER_H
+#define ALLOC_TRACER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Plain struct: zero it before opening a scope
+struct AllocCounters {
+  uint32_t allocations;             // malloc/calloc, realloc counts as free + allocation
+  uint32_t frees;
+  uint32_t bytes;                   // Block sizes allocated
+  int32_t live;                     // Bytes allocated - bytes freed inside the scope
+  int32_t peak;                     // Highest live value
+};
+
+class AllocScope {
+public:
+  explicit AllocScope(AllocCounters& counters);
+  ~AllocScope();
+  AllocScope(const AllocScope&) = delete;
+  AllocScope& operator=(const AllocScope&) = delete;
+
+private:
+  AllocCounters* previous;
+  void* previousTask;
+};
+
+// Allocator hooks (wrappers / native shim), block size in bytes
+void allocTracerOnAlloc(size_t bytes);
+void allocTracerOnFree(size_t bytes);
+
+#endif // ALLOC_TRACER_H
@@ -0,0 +1,59 @@
+/*
+ * API_ROUTES.H - Response bodies of the /api routes with an allocation budget
+ * Each send*() renders one route from data the handler has already
+ * collected and sends it on the DiagnosticWebServer. Sensor updates, ADC
+ * snapshots, Wi-Fi and ESP-IDF reads stay in main.cpp, so the native tests
+ * run these bodies unchanged and measure them against http_alloc_budgets.h
+ */
+
+#ifndef API_ROUTES_H
+#define API_ROUTES_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "adc_sampler.h"
+#include "boot_profiler.h"
+#include "diagnostic_info.h"
+#include "environmental_sensors.h"
+#include "gps_module.h"
+#include "http_metrics.h"
+#include "loop_monitor.h"
+#include "task_profiler.h"
+
+// /api/adc-stream inputs, copied out of the sampler by the handler
+struct ADCStreamSnapshot {
+  ADCChannelStats stats[ADC_SAMPLER_MAX_CHANNELS];
+  uint8_t count = 0;
+  ADCHistogram histograms[ADC_SAMPLER_MAX_CHANNELS];
+  bool hasHistogram[ADC_SAMPLER_MAX_CHANNELS] = {};  // ?hist=0 or not enough samples: false
+  int spectrumChannel = -1;                          // -1 = no spectrum requested (?fft=)
+  float magnitudes[ADC_SAMPLER_FFT_SIZE / 2];
+  uint16_t bins = 0;
+  float binHz = 0.0;
+};
+
+// Function declarations
+void sendGPSData(DiagnosticWebServer& server, const GPSData& gps);
+void sendGPSSatellites(DiagnosticWebServer& server, const GPSData& gps, const GPSSkyView& sky, bool available);
+void sendEnvironmentalSensors(DiagnosticWebServer& server, const EnvironmentalData& env);
+void sendMemoryDetails(DiagnosticWebServer& server, const DetailedMemoryInfo& memory);
+void sendADCStream(DiagnosticWebServer& server, const ADCSamplerStatus& status, const ADCStreamSnapshot& snapshot);
+void sendBootProfile(DiagnosticWebServer& server, const BootProfile& profile, bool complete);
+#if ENABLE_HTTP_METRICS
+void sendHttpMetrics(DiagnosticWebServer& server);             // Registered routes and request arena
+#endif
+#if ENABLE_TASK_PROFILER
+void sendTasks(DiagnosticWebServer& server, const TaskProfilerData& data, uint8_t coreCount);
+#endif
+#if ENABLE_LOOP_MONITOR
+void sendLoopMonitor(DiagnosticWebServer& server, const LoopMonitorData& data);
+#endif
+#if ENABLE_TRACE
+void sendTrace(DiagnosticWebServer& server);                   // Streamed; caller pauses recording
+#endif
+#if ENABLE_OPENMETRICS
+void sendMetrics(DiagnosticWebServer& server, bool wifiConnected, long rssi, float chipTemperature,
+                 const EnvironmentalData& env, const GPSData& gps, bool gpsAvailable);
+#endif
+
+#endif // API_ROUTES_H
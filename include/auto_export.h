@@ -0,0 +1,111 @@
+/*
+ * AUTO_EXPORT.H - Periodic diagnostic snapshot export (ENABLE_AUTO_EXPORT)
+ * loop() captures a fixed-size POD snapshot into the back slot of a double
+ * buffer and publishes it; readers pin the published slot, so a capture never
+ * writes a slot that is being read. The export task serializes the pinned
+ * snapshot line by line (TXT/JSON/CSV, 512-byte buffer) to SD or LittleFS
+ * and keeps the newest AUTO_EXPORT_RETENTION_FILES files
+ */
+
+#ifndef AUTO_EXPORT_H
+#define AUTO_EXPORT_H
+
+#include <Arduino.h>
+
+#define AUTO_EXPORT_FORMAT_TXT 0
+#define AUTO_EXPORT_FORMAT_JSON 1
+#define AUTO_EXPORT_FORMAT_CSV 2
+
+#define AUTO_EXPORT_STORAGE_AUTO 0       // SD when mounted, LittleFS otherwise
+#define AUTO_EXPORT_STORAGE_SD 1
+#define AUTO_EXPORT_STORAGE_LITTLEFS 2
+
+#define SNAPSHOT_TEST_COUNT 7
+
+// Plain struct (no String): copied and serialized without heap allocation
+struct DiagnosticSnapshot {
+  uint32_t seq;
+  uint32_t capturedMs;
+  char chipModel[16];
+  char chipRevision[8];
+  uint8_t cpuCores;
+  uint16_t cpuFreqMHz;
+  uint32_t flashSize;
+  char macAddress[18];
+  char sdkVersion[32];
+  char idfVersion[32];
+  float temperature;               // -999 = n/a
+  char resetReason[24];
+
+  uint32_t heapSize;
+  uint32_t freeHeap;
+  uint32_t minFreeHeap;
+  uint32_t maxAllocHeap;
+  uint32_t psramSize;
+  uint32_t psramFree;
+  uint32_t psramLargestBlock;
+
+  char wifiSSID[33];
+  int8_t wifiRSSI;
+  char ipAddress[16];
+  bool mdnsAvailable;
+
+  uint8_t gpioCount;
+  uint8_t i2cCount;
+  char i2cDevices[64];
+  char testResults[SNAPSHOT_TEST_COUNT][40];   // Order of snapshotTestNames[]
+  uint32_t cpuBenchmarkUs;
+  uint32_t memBenchmarkUs;
+
+  bool aht20Available;
+  bool bmp280Available;
+  float temperatureAht20;          // -999 = n/a
+  float temperatureBmp280;
+  float humidity;
+  float pressure;
+  float altitude;
+
+  bool gpsAvailable;
+  bool gpsFix;
+  uint8_t satellites;
+  double latitude;
+  double longitude;
+  float gpsAltitude;
+  float speed;
+  float hdop;
+  bool gpsDateTime;
+  uint16_t year;
+  uint8_t month, day, hour, minute, second;
+};
+
+struct AutoExportStatus {
+  bool enabled = false;
+  bool busy = false;
+  uint8_t format = AUTO_EXPORT_FORMAT_JSON;
+  uint32_t snapshots = 0;          // Captures published
+  uint32_t captureSkips = 0;       // Back slot still pinned by a reader
+  uint32_t lastCaptureUs = 0;
+  uint32_t exports = 0;
+  uint32_t exportErrors = 0;
+  uint32_t deleted = 0;            // Files removed by retention
+  uint32_t lastExportMs = 0;       // Duration of the last file write
+  uint32_t lastBytes = 0;
+  uint32_t files = 0;              // Files currently kept
+  uint32_t keptBytes = 0;
+  char lastFile[40] = "";
+  char storage[10] = "";
+};
+
+extern AutoExportStatus autoExportStatus;
+extern const char* const snapshotTestNames[SNAPSHOT_TEST_COUNT];
+
+// Function declarations
+DiagnosticSnapshot* snapshotBeginWrite();          // Back slot, nullptr while a reader still pins it
+void snapshotPublish();
+const DiagnosticSnapshot* snapshotAcquire();       // Pins the published slot, nullptr before the first capture
+void snapshotRelease(const DiagnosticSnapshot* snapshot);
+bool startAutoExport();
+bool requestAutoExport(bool sdReady);              // Wakes the export task for the published snapshot
+const char* autoExportFormatName(uint8_t format);
+
+#endif // AUTO_EXPORT_H
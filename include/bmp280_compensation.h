@@ -0,0 +1,139 @@
+/*
+ * BMP280_COMPENSATION.H - Bosch BMP280 integer compensation and altitude
+ * Pure functions over the cached calibration: no I2C, no floating point in
+ * the compensation itself (datasheet section 8.2, 32-bit temperature and
+ * 64-bit pressure formulas), so the native bench checks them against the
+ * datasheet example and the double-precision reference.
+ * Altitude uses a 128-segment table of (p / p0)^(1 / 5.255) with linear
+ * interpolation instead of pow(): error below 0.6 m down to 270 hPa at sea
+ * level (~10 km) and below 0.1 m for p / p0 >= 0.75 (~2.4 km)
+ */
+
+#ifndef BMP280_COMPENSATION_H
+#define BMP280_COMPENSATION_H
+
+#include <stdint.h>
+#include <math.h>
+
+#define BMP280_CALIB_SIZE 24                // dig_T1..dig_P9, registers 0x88-0x9F
+#define BMP280_DATA_SIZE 6                  // press_msb..temp_xlsb, registers 0xF7-0xFC
+#define BMP280_ADC_SKIPPED 0x80000          // Output of a skipped (or not yet converted) measurement
+
+#define BMP280_ALTITUDE_SEGMENTS 128
+#define BMP280_ALTITUDE_RATIO_MIN 0.25f     // p / p0 covered by the table, pow() outside
+#define BMP280_ALTITUDE_RATIO_MAX 1.25f
+
+struct BMP280Calibration {
+  uint16_t T1 = 0;
+  int16_t T2 = 0;
+  int16_t T3 = 0;
+  uint16_t P1 = 0;
+  int16_t P2 = 0;
+  int16_t P3 = 0;
+  int16_t P4 = 0;
+  int16_t P5 = 0;
+  int16_t P6 = 0;
+  int16_t P7 = 0;
+  int16_t P8 = 0;
+  int16_t P9 = 0;
+};
+
+// Little-endian words from one burst read of 0x88-0x9F
+inline void bmp280ParseCalibration(const uint8_t* raw, BMP280Calibration& cal) {
+  uint16_t words[12];
+  for (uint8_t i = 0; i < 12; i++) {
+    words[i] = (uint16_t)(raw[i * 2] | (raw[i * 2 + 1] << 8));
+  }
+  cal.T1 = words[0];
+  cal.T2 = (int16_t)words[1];
+  cal.T3 = (int16_t)words[2];
+  cal.P1 = words[3];
+  cal.P2 = (int16_t)words[4];
+  cal.P3 = (int16_t)words[5];
+  cal.P4 = (int16_t)words[6];
+  cal.P5 = (int16_t)words[7];
+  cal.P6 = (int16_t)words[8];
+  cal.P7 = (int16_t)words[9];
+  cal.P8 = (int16_t)words[10];
+  cal.P9 = (int16_t)words[11];
+}
+
+// 20-bit ADC values from one burst read of 0xF7-0xFC
+inline void bmp280ParseData(const uint8_t* raw, int32_t& adcP, int32_t& adcT) {
+  adcP = (int32_t)(((uint32_t)raw[0] << 12) | ((uint32_t)raw[1] << 4) | (raw[2] >> 4));
+  adcT = (int32_t)(((uint32_t)raw[3] << 12) | ((uint32_t)raw[4] << 4) | (raw[5] >> 4));
+}
+
+// Signed arithmetic throughout: below ~0 °C, adcT / 8 < 2 * T1
+inline int32_t bmp280TemperatureFine(int32_t adcT, const BMP280Calibration& cal) {
+  int32_t var1 = (((adcT >> 3) - ((int32_t)cal.T1 << 1)) * (int32_t)cal.T2) >> 11;
+  int32_t delta = (adcT >> 4) - (int32_t)cal.T1;
+  int32_t var2 = (((delta * delta) >> 12) * (int32_t)cal.T3) >> 14;
+  return var1 + var2;
+}
+
+// °C x100
+inline int32_t bmp280TemperatureCenti(int32_t tFine) {
+  return (tFine * 5 + 128) >> 8;
+}
+
+// Pa in Q24.8 (Pa x256), 0 when the calibration is invalid
+inline uint32_t bmp280PressureQ8(int32_t adcP, int32_t tFine, const BMP280Calibration& cal) {
+  int64_t var1 = (int64_t)tFine - 128000;
+  int64_t var2 = var1 * var1 * (int64_t)cal.P6;
+  var2 += (var1 * (int64_t)cal.P5) * 131072;
+  var2 += (int64_t)cal.P4 * 34359738368LL;
+  var1 = ((var1 * var1 * (int64_t)cal.P3) >> 8) + ((var1 * (int64_t)cal.P2) * 4096);
+  var1 = ((((int64_t)1 << 47) + var1) * (int64_t)cal.P1) >> 33;
+  if (var1 == 0) return 0;
+  int64_t p = 1048576 - adcP;
+  p = ((p * 2147483648LL - var2) * 3125) / var1;
+  var1 = ((int64_t)cal.P9 * (p >> 13) * (p >> 13)) >> 25;
+  var2 = ((int64_t)cal.P8 * p) >> 19;
+  p = ((p + var1 + var2) >> 8) + ((int64_t)cal.P7 << 4);
+  return (uint32_t)p;
+}
+
+// Table built on first use (129 powf calls), read-only afterwards
+inline const float* bmp280AltitudeTable() {
+  static float table[BMP280_ALTITUDE_SEGMENTS + 1];
+  static bool built = false;
+  if (!built) {
+    const float step = (BMP280_ALTITUDE_RATIO_MAX - BMP280_ALTITUDE_RATIO_MIN) / BMP280_ALTITUDE_SEGMENTS;
+    for (int i = 0; i <= BMP280_ALTITUDE_SEGMENTS; i++) {
+      table[i] = powf(BMP280_ALTITUDE_RATIO_MIN + step * i, 1.0f / 5.255f);
+    }
+    built = true;
+  }
+  return table;
+}
+
+// International barometric formula, 44330 * (1 - (p / p0)^(1 / 5.255))
+inline float bmp280AltitudeM(float pressureHpa, float seaLevelHpa) {
+  float ratio = pressureHpa / seaLevelHpa;
+  if (!(ratio >= BMP280_ALTITUDE_RATIO_MIN && ratio < BMP280_ALTITUDE_RATIO_MAX)) {
+    return 44330.0f * (1.0f - powf(ratio, 1.0f / 5.255f));
+  }
+  const float* table = bmp280AltitudeTable();
+  float position = (ratio - BMP280_ALTITUDE_RATIO_MIN) *
+                   (BMP280_ALTITUDE_SEGMENTS / (BMP280_ALTITUDE_RATIO_MAX - BMP280_ALTITUDE_RATIO_MIN));
+  int index = (int)position;
+  if (index >= BMP280_ALTITUDE_SEGMENTS) index = BMP280_ALTITUDE_SEGMENTS - 1;
+  float fraction = position - index;
+  return 44330.0f * (1.0f - (table[index] + (table[index + 1] - table[index]) * fraction));
+}
+
+// ctrl_meas / config field codes from the config.h settings
+constexpr uint8_t bmp280OversamplingCode(int factor) {
+  return factor >= 16 ? 5 : factor >= 8 ? 4 : factor >= 4 ? 3 : factor >= 2 ? 2 : factor >= 1 ? 1 : 0;
+}
+
+constexpr uint8_t bmp280FilterCode(int coefficient) {
+  return coefficient >= 16 ? 4 : coefficient >= 8 ? 3 : coefficient >= 4 ? 2 : coefficient >= 2 ? 1 : 0;
+}
+
+constexpr uint8_t bmp280StandbyCode(int ms) {
+  return ms >= 4000 ? 7 : ms >= 2000 ? 6 : ms >= 1000 ? 5 : ms >= 500 ? 4 : ms >= 250 ? 3 : ms >= 125 ? 2 : ms >= 62 ? 1 : 0;
+}
+
+#endif // BMP280_COMPENSATION_H
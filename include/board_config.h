@@ -112,6 +112,13 @@
 #define DISTANCE_ECHO_PIN 35  // ECHO — entrée, diviseur obligatoire
 
 
+// ============================================================
+// Banc GPIO (relier OUT → IN par un fil pour la latence ISR)
+// ============================================================
+#define GPIO_BENCH_OUT_PIN 14  // Sortie toggle — GPIO libre
+#define GPIO_BENCH_IN_PIN   3  // Entrée interruption — strapping JTAG, lu au boot uniquement
+
+
 
 // =========================================================
 //         CONFIGURATION ESP32 CLASSIC (WROOM DevKitC)
@@ -222,6 +229,14 @@
 #define DISTANCE_ECHO_PIN 35 // ECHO — entrée, diviseur obligatoire
 
 
+// ============================================================
+// Banc GPIO
+// ============================================================
+// Aucune paire libre sur le WROOM : toggle sur PWM_PIN, pas de boucle ISR
+#define GPIO_BENCH_OUT_PIN PWM_PIN  // Sortie toggle — partagée avec PWM
+#define GPIO_BENCH_IN_PIN  -1       // Relier à une entrée libre pour la latence ISR
+
+
 #else
 #error "Aucune cible définie ! Vérifiez platformio.ini (TARGET_ESP32_...)"
 #endif
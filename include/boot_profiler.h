@@ -0,0 +1,57 @@
+/*
+ * BOOT_PROFILER.H - Dependency-aware deferred boot and boot-time profiler
+ * setup() starts the web server first; the remaining init stages form a
+ * small graph run one per loop() pass (foreground) or in their own task
+ * (background, e.g. Wi-Fi association). Every stage is timed with
+ * esp_timer (common timeline) and the CPU cycle counter of its core
+ */
+
+#ifndef BOOT_PROFILER_H
+#define BOOT_PROFILER_H
+
+#include <Arduino.h>
+
+#define BOOT_PROFILE_MAX_STAGES 24
+#define BOOT_DEP(id) (1UL << (id))
+
+struct BootStageRecord {
+  const char* name = nullptr;
+  uint8_t core = 0;
+  bool background = false;
+  bool done = false;
+  uint64_t startUs = 0;         // esp_timer_get_time(), since boot
+  uint32_t durationUs = 0;
+  uint32_t cycles = 0;          // CPU cycles on `core`, 0 if the counter wrapped
+};
+
+struct BootProfile {
+  BootStageRecord stages[BOOT_PROFILE_MAX_STAGES];
+  uint8_t count = 0;
+  uint32_t cpuMhz = 0;
+  uint64_t serverReadyUs = 0;
+  uint64_t firstResponseUs = 0;
+  uint64_t bootCompleteUs = 0;
+};
+
+typedef void (*BootStageFn)();
+
+struct BootGraphStage {
+  const char* name;
+  BootStageFn run;
+  uint32_t dependsOn;           // BOOT_DEP() mask of stage indexes in the same table
+  bool background;              // Own task (blocking stages), otherwise run from loop()
+};
+
+extern BootProfile bootProfile;
+
+// Function declarations
+uint8_t bootStageBegin(const char* name, bool background = false);
+void bootStageEnd(uint8_t record);
+void bootMarkServerReady();
+void bootMarkFirstResponse();
+void bootGraphStart(const BootGraphStage* stages, uint8_t count);
+bool bootGraphStep();           // Call from loop(): false once every stage has finished
+bool bootGraphComplete();
+bool bootGraphStageDone(uint8_t index);  // True without a graph (nothing pending)
+
+#endif // BOOT_PROFILER_H
@@ -0,0 +1,38 @@
+/*
+ * CBOR_ENCODER.H - JSON text to CBOR (RFC 8949) transcoder for API responses
+ * Strict single-pass parser: objects/arrays become indefinite-length maps and
+ * arrays, integers use major types 0/1, decimals the smallest float width that
+ * keeps the printed value (half when exact, single up to 6 significant
+ * digits, double otherwise). No allocation; call once with out = nullptr to
+ * size the buffer, then again to encode
+ * Chunked bodies are transcoded fragment by fragment: CborStream keeps the
+ * open maps/arrays between calls, so each fragment must end between two
+ * JSON tokens (never inside a string or a number)
+ */
+
+#ifndef CBOR_ENCODER_H
+#define CBOR_ENCODER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define CBOR_MAX_DEPTH 32
+
+// Returns the encoded size, 0 on invalid JSON or when out is too small
+size_t jsonToCbor(const char* json, size_t length, uint8_t* out, size_t capacity);
+
+struct CborStream {
+  uint32_t maps;                    // Bit d set: the container at depth d is a map
+  uint8_t depth;
+  uint8_t expect;                   // Next token allowed (internal)
+  bool failed;                      // Invalid JSON seen, later fragments refused
+};
+
+void cborStreamBegin(CborStream& stream);
+// Same contract as jsonToCbor(); out = nullptr sizes the fragment without
+// advancing the stream
+size_t jsonFragmentToCbor(CborStream& stream, const char* json, size_t length, uint8_t* out, size_t capacity);
+// True once the top-level value is closed
+bool cborStreamComplete(const CborStream& stream);
+
+#endif // CBOR_ENCODER_H
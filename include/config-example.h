@@ -54,6 +54,16 @@
 
 // --- Sensors Common ---
 #define DEFAULT_DHT_SENSOR_TYPE 22   // 11 for DHT11, 22 for DHT22
+#define ENABLE_DHT_BACKGROUND true   // Read DHT_PIN from boot; /api/dht-test serves the cached reading
+#define DHT_READ_INTERVAL_MS 3000    // >= 1000 for DHT11, >= 2000 for DHT22
+#define DHT_MEDIAN_WINDOW 5          // Valid readings in the median filter
+#define DISTANCE_AUTOSTART false     // Start HC-SR04 ranging at boot (otherwise from /api/distance-stream)
+#define DISTANCE_SAMPLE_RATE_HZ 10   // Trigger rate, capped at 16 Hz (60 ms re-arm)
+#define DISTANCE_MEDIAN_WINDOW 5     // Readings in the median filter before the Kalman stage
+#define BMP280_OVERSAMPLING_P 16     // 0 (skip), 1, 2, 4, 8, 16: pressure noise vs conversion time
+#define BMP280_OVERSAMPLING_T 2      // x2 is enough for the pressure compensation
+#define BMP280_IIR_FILTER 4          // 0 (off), 2, 4, 8, 16: in-sensor filter against slams and gusts
+#define BMP280_STANDBY_MS 62         // Normal mode standby: 0 (0.5), 62 (62.5), 125, 250, 500, 1000, 2000, 4000
 
 // --- TFT Common ---
 #define ENABLE_TFT_DISPLAY  true
@@ -67,6 +77,10 @@
 #define GPS_TIMEOUT         5000
 #define GPS_FIX_TIMEOUT     60000
 #define HDOP_GOOD_THRESHOLD 2.0
+#define ENABLE_GPS_UBX      false   // u-blox M8+: switch to binary NAV-PVT/NAV-SAT at boot, NMEA fallback
+#define GPS_UBX_BAUD        115200  // Receiver and ESP32 UART baud rate in UBX mode
+#define GPS_UBX_RATE_HZ     10      // Navigation rate, 1-10 Hz (NEO-6M: 5 Hz max)
+#define ENABLE_GPS_PPS      true    // PPS interrupt on GPS_PPS_PIN: UTC timekeeping, drift and jitter (/api/gps/pps)
 
 // ========== GPIO TEST CONFIGURATION ==========
 #define ENABLE_GPIO_TEST false
@@ -79,6 +93,22 @@
 #define MQTT_USER ""
 #define MQTT_PASSWORD ""
 #define MQTT_TOPIC_PREFIX "esp32-diagnostic"
+// Telemetry topic MQTT_TOPIC_PREFIX/<mac>/telemetry (JSON batches), status topic .../status (retained)
+// Runtime control at /api/mqtt, decode with tools/mqtt_telemetry.py
+#define MQTT_AUTOSTART true                  // Start once Wi-Fi is connected
+#define MQTT_QOS 1                           // 0 = fire and forget, 1 = backlog advances on PUBACK
+#define MQTT_SAMPLE_INTERVAL_MS 1000
+#define MQTT_PUBLISH_INTERVAL_MS 10000       // Partial batches leave at least this often
+#define MQTT_MIN_INTERVAL_MS 100
+#define MQTT_BATCH_RECORDS 20                // Records per message (about 90 bytes each)
+#define MQTT_PAYLOAD_BYTES 2048
+#define MQTT_BACKLOG_RECORDS 8192            // 32 bytes each in PSRAM (2 h 16 at 1 Hz)
+#define MQTT_BACKLOG_RECORDS_INTERNAL 256    // Fallback without PSRAM
+#define MQTT_DRAIN_BURST 4                   // QoS 0: full batches per wake-up while catching up
+#define MQTT_ACK_TIMEOUT_MS 15000            // QoS 1: re-send a batch without PUBACK
+#define MQTT_RECONNECT_MS 10000
+#define MQTT_SENSOR_REFRESH_MS 2000
+#define MQTT_TASK_PRIORITY 1
 
 // Enable Bluetooth/BLE diagnostics (if supported by hardware)
 #define ENABLE_BLE_DIAGNOSTICS false
@@ -92,6 +122,56 @@
 // Enable CPU benchmarking
 #define ENABLE_CPU_BENCHMARK true
 
+// Enable GPIO toggle-rate / interrupt-latency benchmark (/api/gpio-benchmark)
+// Wire GPIO_BENCH_OUT_PIN to GPIO_BENCH_IN_PIN (board_config.h) for the ISR latency pass
+#define ENABLE_GPIO_BENCHMARK true
+#define GPIO_BENCH_TOGGLE_ITERATIONS 10000   // Full HIGH/LOW periods per method
+#define GPIO_BENCH_ISR_SAMPLES 200           // Edges per latency pass (idle / Wi-Fi load)
+#define GPIO_BENCH_UDP_PAYLOAD 1024          // Datagram size used to load Wi-Fi
+
+// Enable software logic analyzer (/api/la/arm, /api/la/status, /api/la/capture)
+// Samples up to 8 GPIOs from a cycle-counted loop on core 1 into PSRAM
+#define ENABLE_LOGIC_ANALYZER true
+#define LA_MAX_SAMPLE_RATE 2000000           // Hz, above this the loop cannot keep up
+#define LA_MAX_SAMPLES 1048576               // 1 byte per sample (PSRAM)
+#define LA_MAX_INTERNAL_SAMPLES 16384        // Fallback limit without PSRAM
+#define LA_MAX_CAPTURE_MS 1000               // Core 1 is monopolized during capture
+#define LA_ARMED_BURST_MS 50                 // Yield 1 tick every N ms while waiting for trigger
+#define LA_TASK_PRIORITY 5
+
+// Enable continuous ADC sampling with statistics (/api/adc-continuous, /api/adc-stream)
+// Uses the ESP-IDF adc_continuous DMA driver on Arduino Core 3.x (ADC1 pins only);
+// falls back to calibrated analogReadMilliVolts() polling (1 sample/channel/tick) otherwise
+#define ENABLE_ADC_CONTINUOUS true
+#define ENABLE_ADC_DMA true
+#define ADC_CONTINUOUS_DEFAULT_RATE 20000    // Aggregate conversions per second (all channels)
+
+// Enable SD card throughput benchmark (/api/sd-benchmark, /api/sd-benchmark-results)
+// Sequential write/read at 512 B..64 KB blocks + random 4 KB IOPS, repeated per SPI clock
+// Writes a temporary /diag_bench.bin of SD_BENCH_FILE_SIZE_KB, removed at the end
+#define ENABLE_SD_BENCHMARK true
+#define SD_BENCH_SPI_CLOCKS_KHZ {4000, 10000, 20000, 40000}  // Up to 4 clocks (sdSPI)
+#define SD_BENCH_FILE_SIZE_KB 512            // Bytes written/read per block size
+#define SD_BENCH_MAX_FILE_SIZE_KB 4096       // Upper bound for ?size_kb=
+#define SD_BENCH_RANDOM_OPS 100              // Random 4 KB reads, then writes, per clock
+
+// Enable background SD data logger (/api/sd-logger)
+// 32-byte binary records (envData, gpsData, heap, RSSI) in SD_LOG_DIR/LOGnnnnn.BIN,
+// convert offline with tools/sd_log_convert.py
+#define ENABLE_SD_LOGGER true
+#define SD_LOG_AUTOSTART false               // Start logging at boot when a card is present
+#define SD_LOG_DIR "/logs"
+#define SD_LOG_DEFAULT_INTERVAL_MS 1000      // Sampling period
+#define SD_LOG_MIN_INTERVAL_MS 10
+#define SD_LOG_BUFFER_BYTES 8192             // Per buffer (x2), multiple of 512
+#define SD_LOG_FLUSH_MS 5000                 // Hand whole sectors to the writer at least this often
+#define SD_LOG_ROTATE_KB 4096                // New file above this size...
+#define SD_LOG_ROTATE_MINUTES 60             // ...or after this age (0 = size only)
+#define SD_LOG_TIME_SYNC_MS 10000            // millis() -> UTC anchor record while the GPS PPS is locked
+#define SD_LOG_SENSOR_REFRESH_MS 2000        // loop() refresh of the AHT20/BMP280 readings
+#define SD_LOG_SAMPLER_PRIORITY 4            // Above the writer: sampling never waits for the card
+#define SD_LOG_WRITER_PRIORITY 2
+
 // ========== WEB SERVER CONFIGURATION ==========
 #define WEB_SERVER_PORT 80
 
@@ -101,10 +181,41 @@
 // Maximum number of simultaneous web clients
 #define MAX_WEB_CLIENTS 4
 
+// Per-route latency histogram, response bytes and heap delta (/api/metrics/http)
+// Table of HTTP_METRICS_MAX_ROUTES x ~200 bytes, PSRAM when available
+#define ENABLE_HTTP_METRICS true
+#define HTTP_METRICS_MAX_ROUTES 128          // Routes registered with server.on()
+
+// Heap allocations per request (count, bytes, peak) in /api/metrics/http,
+// checked against a per-route budget. Needs the malloc --wrap linker flags:
+// build with env esp32s3_n16r8_alloctrace, which sets it to 1
+#ifndef ENABLE_ALLOC_TRACER
+#define ENABLE_ALLOC_TRACER false
+#endif
+#define HTTP_ALLOC_BUDGET_DEFAULT 64         // Allocations per call, routes without their own budget
+
+// Per-request arena for response text and CBOR buffers, reset after each
+// handler (PSRAM when present, internal SRAM otherwise). Larger responses
+// spill to the heap; watch "arena" in /api/metrics/http before shrinking it
+#define REQUEST_ARENA_SIZE 8192              // Bytes, 0 = disabled (heap only)
+
+// OpenMetrics / Prometheus scrape endpoint (/metrics), cached values only
+#define ENABLE_OPENMETRICS true
+
+// CBOR responses for JSON APIs (Accept: application/cbor or ?fmt=cbor)
+// Adds X-Gen-Us / X-Encode-Us timing headers; compare with tools/api_bench.py
+#define ENABLE_CBOR_API true
+
 // ========== EXPORT CONFIGURATION ==========
 // Enable automatic export generation after boot
 #define ENABLE_AUTO_EXPORT false
-#define AUTO_EXPORT_DELAY_SECONDS 30
+#define AUTO_EXPORT_DELAY_SECONDS 30         // First snapshot after boot
+#define AUTO_EXPORT_INTERVAL_SECONDS 300     // Then one snapshot file per interval (/api/auto-export)
+#define AUTO_EXPORT_FORMAT 1                 // 0 = TXT, 1 = JSON, 2 = CSV (must be enabled below)
+#define AUTO_EXPORT_STORAGE 0                // 0 = SD when mounted else LittleFS, 1 = SD only, 2 = LittleFS only
+#define AUTO_EXPORT_DIR "/exports"
+#define AUTO_EXPORT_RETENTION_FILES 48       // Oldest files deleted beyond this count...
+#define AUTO_EXPORT_RETENTION_KB 512         // ...or this total size
 
 // Export file formats to generate
 #define ENABLE_TXT_EXPORT true
@@ -119,6 +230,24 @@
 #define RGB_LED_TASK_STACK 2048
 #define BUZZER_TASK_STACK 2048
 
+// FreeRTOS task profiler (/api/tasks): CPU % per task and lowest stack headroom,
+// use it to size the stacks above. Needs configUSE_TRACE_FACILITY (default in Arduino-ESP32)
+#define ENABLE_TASK_PROFILER true
+#define TASK_PROFILER_INTERVAL_MS 1000       // Snapshot period (window = 10 snapshots)
+#define TASK_STACK_WARN_BYTES 512            // Serial warning + flag below this headroom
+
+// Main loop monitor (/api/loop-monitor): per-phase latency histograms and the
+// longest stalls with the HTTP route that caused them, also on Serial
+#define ENABLE_LOOP_MONITOR true
+#define LOOP_STALL_THRESHOLD_MS 100          // Iterations above this are stalls
+
+// Binary trace rings (/api/trace -> tools/trace_to_chrome.py -> chrome://tracing)
+// 16-byte events per core: HTTP routes, async tests, Wi-Fi events, TRACE_* macros
+#define ENABLE_TRACE true
+#define TRACE_RING_EVENTS 256                // Per core, power of two (x16 bytes)
+#define TRACE_MAX_NAMES 192                  // Interned names (every route counts)
+#define TRACE_SYNC_INTERVAL_MS 1000          // Cycle counter anchors, keep < 8 s
+
 // Task priorities (0 = lowest, higher numbers = higher priority)
 #define HARDWARE_TEST_TASK_PRIORITY 1
 #define WEB_SERVER_TASK_PRIORITY 2
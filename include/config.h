@@ -34,6 +34,16 @@
 
 // --- Sensors Common ---
 #define DEFAULT_DHT_SENSOR_TYPE 22
+#define ENABLE_DHT_BACKGROUND true
+#define DHT_READ_INTERVAL_MS 3000
+#define DHT_MEDIAN_WINDOW 5
+#define DISTANCE_AUTOSTART false
+#define DISTANCE_SAMPLE_RATE_HZ 10
+#define DISTANCE_MEDIAN_WINDOW 5
+#define BMP280_OVERSAMPLING_P 16
+#define BMP280_OVERSAMPLING_T 2
+#define BMP280_IIR_FILTER 4
+#define BMP280_STANDBY_MS 62
 
 // --- TFT Common ---
 #define ENABLE_TFT_DISPLAY  true
@@ -55,6 +65,10 @@
 #define GPS_TIMEOUT         5000
 #define GPS_FIX_TIMEOUT     60000
 #define HDOP_GOOD_THRESHOLD 2.0
+#define ENABLE_GPS_UBX      false
+#define GPS_UBX_BAUD        115200
+#define GPS_UBX_RATE_HZ     10
+#define ENABLE_GPS_PPS      true
 
 // --- Features Common ---
 #define ENABLE_GPIO_TEST false
@@ -64,21 +78,93 @@
 #define MQTT_USER ""
 #define MQTT_PASSWORD ""
 #define MQTT_TOPIC_PREFIX "esp32-diagnostic"
+#define MQTT_AUTOSTART true
+#define MQTT_QOS 1
+#define MQTT_SAMPLE_INTERVAL_MS 1000
+#define MQTT_PUBLISH_INTERVAL_MS 10000
+#define MQTT_MIN_INTERVAL_MS 100
+#define MQTT_BATCH_RECORDS 20
+#define MQTT_PAYLOAD_BYTES 2048
+#define MQTT_BACKLOG_RECORDS 8192
+#define MQTT_BACKLOG_RECORDS_INTERNAL 256
+#define MQTT_DRAIN_BURST 4
+#define MQTT_ACK_TIMEOUT_MS 15000
+#define MQTT_RECONNECT_MS 10000
+#define MQTT_SENSOR_REFRESH_MS 2000
+#define MQTT_TASK_PRIORITY 1
 
 #define ENABLE_BLE_DIAGNOSTICS false
 #define ENABLE_SPI_SCAN true
 #define ENABLE_MEMORY_STRESS_TEST true
 #define ENABLE_CPU_BENCHMARK true
 
+// --- GPIO Benchmark Common ---
+// Loopback pins GPIO_BENCH_OUT_PIN / GPIO_BENCH_IN_PIN are defined in board_config.h
+#define ENABLE_GPIO_BENCHMARK true
+#define GPIO_BENCH_TOGGLE_ITERATIONS 10000
+#define GPIO_BENCH_ISR_SAMPLES 200
+#define GPIO_BENCH_UDP_PAYLOAD 1024
+
+// --- Logic Analyzer Common ---
+#define ENABLE_LOGIC_ANALYZER true
+#define LA_MAX_SAMPLE_RATE 2000000
+#define LA_MAX_SAMPLES 1048576
+#define LA_MAX_INTERNAL_SAMPLES 16384
+#define LA_MAX_CAPTURE_MS 1000
+#define LA_ARMED_BURST_MS 50
+#define LA_TASK_PRIORITY 5
+
+// --- Continuous ADC Common ---
+#define ENABLE_ADC_CONTINUOUS true
+#define ENABLE_ADC_DMA true
+#define ADC_CONTINUOUS_DEFAULT_RATE 20000
+
+// --- SD Benchmark Common ---
+#define ENABLE_SD_BENCHMARK true
+#define SD_BENCH_SPI_CLOCKS_KHZ {4000, 10000, 20000, 40000}
+#define SD_BENCH_FILE_SIZE_KB 512
+#define SD_BENCH_MAX_FILE_SIZE_KB 4096
+#define SD_BENCH_RANDOM_OPS 100
+
+// --- SD Logger Common ---
+#define ENABLE_SD_LOGGER true
+#define SD_LOG_AUTOSTART false
+#define SD_LOG_DIR "/logs"
+#define SD_LOG_DEFAULT_INTERVAL_MS 1000
+#define SD_LOG_MIN_INTERVAL_MS 10
+#define SD_LOG_BUFFER_BYTES 8192
+#define SD_LOG_FLUSH_MS 5000
+#define SD_LOG_ROTATE_KB 4096
+#define SD_LOG_ROTATE_MINUTES 60
+#define SD_LOG_TIME_SYNC_MS 10000
+#define SD_LOG_SENSOR_REFRESH_MS 2000
+#define SD_LOG_SAMPLER_PRIORITY 4
+#define SD_LOG_WRITER_PRIORITY 2
+
 // --- Buttons Common ---
 #define ENABLE_BUTTONS true
 
 #define WEB_SERVER_PORT 80
 #define ENABLE_CORS false
 #define MAX_WEB_CLIENTS 4
+#define ENABLE_HTTP_METRICS true
+#define HTTP_METRICS_MAX_ROUTES 128
+#ifndef ENABLE_ALLOC_TRACER
+#define ENABLE_ALLOC_TRACER false
+#endif
+#define HTTP_ALLOC_BUDGET_DEFAULT 64
+#define REQUEST_ARENA_SIZE 8192
+#define ENABLE_OPENMETRICS true
+#define ENABLE_CBOR_API true
 
 #define ENABLE_AUTO_EXPORT false
 #define AUTO_EXPORT_DELAY_SECONDS 30
+#define AUTO_EXPORT_INTERVAL_SECONDS 300
+#define AUTO_EXPORT_FORMAT 1
+#define AUTO_EXPORT_STORAGE 0
+#define AUTO_EXPORT_DIR "/exports"
+#define AUTO_EXPORT_RETENTION_FILES 48
+#define AUTO_EXPORT_RETENTION_KB 512
 #define ENABLE_TXT_EXPORT true
 #define ENABLE_JSON_EXPORT true
 #define ENABLE_CSV_EXPORT true
@@ -90,6 +176,18 @@
 #define RGB_LED_TASK_STACK 2048
 #define BUZZER_TASK_STACK 2048
 
+#define ENABLE_TASK_PROFILER true
+#define TASK_PROFILER_INTERVAL_MS 1000
+#define TASK_STACK_WARN_BYTES 512
+
+#define ENABLE_LOOP_MONITOR true
+#define LOOP_STALL_THRESHOLD_MS 100
+
+#define ENABLE_TRACE true
+#define TRACE_RING_EVENTS 256
+#define TRACE_MAX_NAMES 192
+#define TRACE_SYNC_INTERVAL_MS 1000
+
 #define HARDWARE_TEST_TASK_PRIORITY 1
 #define WEB_SERVER_TASK_PRIORITY 2
 
@@ -0,0 +1,35 @@
+/*
+ * CYCLE_COUNTER.H - CPU cycle counter helpers
+ * Thin inline wrappers usable from tasks and IRAM interrupt handlers,
+ * compatible with ESP-IDF 4.4 (Arduino Core 2.x) and ESP-IDF 5.x (Core 3.x)
+ */
+
+#ifndef CYCLE_COUNTER_H
+#define CYCLE_COUNTER_H
+
+#include <Arduino.h>
+#include <esp_attr.h>
+#include <esp_idf_version.h>
+
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+  #include <esp_cpu.h>
+#else
+  #include <hal/cpu_hal.h>
+#endif
+
+// Per-core counter: compare only values read on the same core
+static inline uint32_t IRAM_ATTR diagCycleCount() {
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+  return (uint32_t)esp_cpu_get_cycle_count();
+#else
+  return cpu_hal_get_cycle_count();
+#endif
+}
+
+static inline uint32_t diagCyclesToNs(uint32_t cycles) {
+  uint32_t mhz = getCpuFrequencyMhz();
+  if (mhz == 0) return 0;
+  return (uint32_t)(((uint64_t)cycles * 1000ULL) / mhz);
+}
+
+#endif // CYCLE_COUNTER_H
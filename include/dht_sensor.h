@@ -0,0 +1,64 @@
+/*
+ * DHT_SENSOR.H - Background DHT11/DHT22 reader
+ * maintainDHTSensor() runs the read cycle from loop() without busy-waiting:
+ * start pulse (held across loop iterations for the 18 ms DHT11 one), then a
+ * CHANGE interrupt timestamps every edge of the 40-bit response with
+ * micros(); the frame is decoded from the edge list on the next call.
+ * Valid readings feed a median filter; handlers only read dhtSensorStatus
+ */
+
+#ifndef DHT_SENSOR_H
+#define DHT_SENSOR_H
+
+#include <Arduino.h>
+
+#define DHT_MAX_EDGES 96                 // Full frame: 85 edges with the release one
+#define DHT_FRAME_MIN_EDGES 81           // 40 high pulses + the final release
+#define DHT_BIT_THRESHOLD_US 48          // High pulse: 26-28 us = 0, 70 us = 1
+#define DHT_PULSE_MAX_US 120             // Longer high pulse = glitch or lost edge
+#define DHT_FAILURE_BACKOFF 5            // Consecutive failures before slowing down
+
+enum DHTReadResult : uint8_t {
+  DHT_READ_NONE = 0,                     // No read yet
+  DHT_READ_OK,
+  DHT_READ_TIMEOUT,                      // Too few edges: no sensor or no answer
+  DHT_READ_FRAME_ERROR,                  // Pulse widths out of range
+  DHT_READ_CHECKSUM_ERROR
+};
+
+struct DHTSensorStatus {
+  bool running = false;
+  int pin = -1;
+  uint8_t type = 22;                     // 11 or 22
+  bool valid = false;                    // At least one reading in the filter
+  float temperature = -999.0f;           // Median of the last DHT_MEDIAN_WINDOW readings
+  float humidity = -999.0f;
+  float lastTemperature = -999.0f;       // Last valid reading, unfiltered
+  float lastHumidity = -999.0f;
+  uint8_t samples = 0;                   // Readings currently in the filter
+  DHTReadResult lastResult = DHT_READ_NONE;
+  uint8_t lastEdges = 0;                 // Edges captured by the last read
+  uint32_t lastReadMs = 0;               // millis() of the last valid reading
+  uint32_t reads = 0;
+  uint32_t okReads = 0;
+  uint32_t timeouts = 0;
+  uint32_t frameErrors = 0;
+  uint32_t checksumErrors = 0;
+  uint32_t consecutiveFailures = 0;
+};
+
+extern DHTSensorStatus dhtSensorStatus;
+
+// Function declarations
+void beginDHTSensor(int pin, uint8_t type);   // pin < 0 stops the reader
+void stopDHTSensor();
+void maintainDHTSensor();                     // Called from loop()
+void requestDHTRead();                        // Next maintainDHTSensor() starts a read
+const char* dhtReadResultName(DHTReadResult result);
+
+// Decoding helpers (no hardware access)
+DHTReadResult decodeDHTFrame(const uint32_t* edgesUs, uint8_t count, uint8_t data[5]);
+void convertDHTFrame(const uint8_t data[5], uint8_t type, int16_t& temperatureDeci, int16_t& humidityDeci);
+int16_t medianDHTValue(const int16_t* values, uint8_t count);
+
+#endif // DHT_SENSOR_H
@@ -0,0 +1,105 @@
+/*
+ * DIAGNOSTIC_INFO.H - Collected system information as plain records
+ * DiagnosticInfo and DetailedMemoryInfo hold scalars, inline char arrays and
+ * pointers to immutable strings only: a refresh overwrites them in place
+ * without touching the heap, and a snapshot is a plain struct copy, so the
+ * records can be double-buffered between a collector and the handlers.
+ * MAC and IPv4 addresses are kept packed and the memory status is an enum;
+ * their text is produced at render time with the format*() helpers
+ */
+
+#ifndef DIAGNOSTIC_INFO_H
+#define DIAGNOSTIC_INFO_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <type_traits>
+
+#define DIAG_SSID_SIZE 33                  // 32-byte 802.11 SSID + NUL
+#define DIAG_I2C_MAX_DEVICES 16            // Addresses kept by scanI2C(); i2cCount counts them all
+
+enum MemoryStatus : uint8_t {
+  MEMORY_STATUS_EXCELLENT,                 // Fragmentation < 20 %
+  MEMORY_STATUS_GOOD,                      // < 40 %
+  MEMORY_STATUS_AVERAGE,                   // < 60 %
+  MEMORY_STATUS_CRITICAL
+};
+
+struct DiagnosticInfo {
+  unsigned long uptime;                    // millis() at the last collectDiagnosticInfo()
+  uint32_t heapSize;
+  uint32_t freeHeap;
+  uint32_t minFreeHeap;
+  uint32_t maxAllocHeap;
+  uint32_t flashSize;
+  uint32_t psramSize;
+  uint32_t cpuFreqMHz;
+  uint32_t ipAddress;                      // IPv4 as IPAddress stores it (first octet in the low byte), 0 = not connected
+  float temperature;                       // -999 = no sensor
+  unsigned long cpuBenchmark;              // us, 0 = not run
+  unsigned long memBenchmark;
+
+  const char* chipModel;                   // Static strings, valid for the whole run
+  const char* sdkVersion;
+  const char* idfVersion;
+  const char* gpioList;
+
+  uint16_t chipRevision;
+  int8_t wifiRSSI;                         // -127 when not connected
+  uint8_t cpuCores;
+  uint8_t totalGPIO;
+  uint8_t i2cCount;
+  bool hasWiFi;
+  bool hasBT;
+  bool mdnsAvailable;
+  uint8_t mac[6];                          // Wi-Fi station MAC
+  uint8_t i2cAddresses[DIAG_I2C_MAX_DEVICES];
+  char wifiSSID[DIAG_SSID_SIZE];
+};
+
+struct DetailedMemoryInfo {
+  uint32_t flashSizeReal;
+  uint32_t flashSizeChip;
+
+  uint32_t psramTotal;
+  uint32_t psramFree;
+  uint32_t psramUsed;
+  uint32_t psramLargestBlock;
+  const char* psramType;                   // Static string or nullptr
+
+  uint32_t sramTotal;
+  uint32_t sramFree;
+  uint32_t sramUsed;
+  uint32_t sramLargestBlock;
+
+  float fragmentationPercent;
+  MemoryStatus memoryStatus;               // Translated by memoryStatusText() when rendered
+  bool psramAvailable;
+  bool psramConfigured;
+  bool psramBoardSupported;
+  bool sramTestPassed;
+  bool psramTestPassed;
+};
+
+static_assert(std::is_trivially_copyable<DiagnosticInfo>::value, "DiagnosticInfo must stay a plain record");
+static_assert(std::is_trivially_copyable<DetailedMemoryInfo>::value, "DetailedMemoryInfo must stay a plain record");
+
+// Render-time text, returned by value (stack buffers)
+struct AddressText {
+  char text[18];
+};
+
+struct I2CDevicesText {
+  char text[DIAG_I2C_MAX_DEVICES * 6 + 8];
+};
+
+// "AA:BB:CC:DD:EE:FF"
+AddressText formatMacAddress(const uint8_t (&mac)[6]);
+// Dotted quad, empty for 0 (not connected)
+AddressText formatIPv4(uint32_t address);
+// "0x3C, 0x76", "Aucun" when the scan found nothing
+I2CDevicesText formatI2CDevices(const DiagnosticInfo& info);
+// Current language, pointer into flash
+const char* memoryStatusText(MemoryStatus status);
+
+#endif // DIAGNOSTIC_INFO_H
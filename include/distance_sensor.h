@@ -0,0 +1,81 @@
+/*
+ * DISTANCE_SENSOR.H - Background HC-SR04 ranging engine
+ * maintainDistanceSensor() fires the 10 us trigger from loop() at the
+ * configured rate (never faster than the 60 ms re-arm), a CHANGE interrupt
+ * on ECHO timestamps both edges with micros() and the pulse is converted
+ * on a later call: speed of sound from the envData temperature, median of
+ * the last DISTANCE_MEDIAN_WINDOW readings, then a 1-D Kalman filter.
+ * Readings go to a ring that /api/distance-stream drains
+ */
+
+#ifndef DISTANCE_SENSOR_H
+#define DISTANCE_SENSOR_H
+
+#include <Arduino.h>
+
+#define DISTANCE_MIN_PERIOD_MS 60          // HC-SR04 re-arm time
+#define DISTANCE_MAX_RATE_HZ (1000 / DISTANCE_MIN_PERIOD_MS)
+#define DISTANCE_ECHO_TIMEOUT_MS 60        // No echo: the module gives up after ~38 ms
+#define DISTANCE_MIN_ECHO_US 116           // ~2 cm
+#define DISTANCE_MAX_ECHO_US 23500         // ~4 m
+#define DISTANCE_DEFAULT_TEMPERATURE 20.0f // When envData has no temperature
+#define DISTANCE_TEMP_REFRESH_MS 10000     // envData refresh while ranging
+#define DISTANCE_KALMAN_Q 1.0f             // Process noise, cm^2 per reading
+#define DISTANCE_KALMAN_R 4.0f             // Measurement noise, cm^2
+#define DISTANCE_KALMAN_RESET_CM 50.0f     // Larger jump = new target, filter restarts
+#define DISTANCE_STREAM_SAMPLES 64
+
+struct DistanceSample {
+  uint32_t timestampMs;                    // millis() of the trigger
+  float rawCm;
+  float filteredCm;
+};
+
+struct DistanceKalman {
+  float estimate = 0.0f;
+  float variance = 0.0f;
+  bool initialized = false;
+
+  float update(float measurement);
+  void reset() { initialized = false; }
+};
+
+struct DistanceSensorStatus {
+  bool running = false;
+  int trigPin = -1;
+  int echoPin = -1;
+  uint16_t rateHz = 0;
+  bool valid = false;                      // At least one reading in range
+  float rawCm = -1.0f;                     // Last in-range reading
+  float medianCm = -1.0f;
+  float filteredCm = -1.0f;                // Kalman output, served to the UI
+  uint32_t lastEchoUs = 0;
+  float temperatureC = DISTANCE_DEFAULT_TEMPERATURE;  // Used for the last conversion
+  bool temperatureFromSensor = false;
+  float soundSpeed = 0.0f;                 // m/s
+  uint32_t lastReadMs = 0;
+  uint32_t triggers = 0;
+  uint32_t readings = 0;                   // Echoes in range
+  uint32_t timeouts = 0;                   // No echo or echo still high after DISTANCE_ECHO_TIMEOUT_MS
+  uint32_t outOfRange = 0;
+  uint32_t busySkips = 0;                  // ECHO still high at trigger time
+  uint32_t sampleSeq = 0;                  // Readings pushed to the stream ring
+};
+
+extern DistanceSensorStatus distanceSensorStatus;
+
+// Function declarations
+void beginDistanceSensor(int trigPin, int echoPin, uint16_t rateHz);
+void stopDistanceSensor();
+void maintainDistanceSensor();              // Called from loop()
+void requestDistanceReading();              // Next call triggers regardless of the rate
+// Copies the readings after `cursor` (oldest first) and advances it;
+// `dropped` counts readings overwritten before they were read
+uint8_t readDistanceSamples(uint32_t& cursor, DistanceSample* out, uint8_t maxCount, uint32_t& dropped);
+
+// Conversion helpers (no hardware access)
+float speedOfSound(float temperatureC);     // m/s, dry air
+float echoToDistanceCm(uint32_t echoUs, float temperatureC);
+float medianDistanceValue(const float* values, uint8_t count);
+
+#endif // DISTANCE_SENSOR_H
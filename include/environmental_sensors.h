@@ -25,6 +25,7 @@ struct EnvironmentalData {
   float temperature_bmp280 = -999.0;
   float pressure = -999.0;      // hPa
   float altitude = -999.0;      // meters (calculated)
+  uint32_t bmp280_compensation_cycles = 0;  // CPU cycles of the last integer compensation
   String bmp280_status = "Not detected";
   
   // Combined
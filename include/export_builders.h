@@ -0,0 +1,53 @@
+/*
+ * EXPORT_BUILDERS.H - Bodies of /export/txt, /export/json, /export/csv and /print
+ * The builders only read an ExportContext: values that need the Wi-Fi stack
+ * or ESP-IDF (flash type, netmask, reset reason...) are resolved by the
+ * handler, so the same code runs in the native tests
+ */
+
+#ifndef EXPORT_BUILDERS_H
+#define EXPORT_BUILDERS_H
+
+#include <Arduino.h>
+#include "diagnostic_info.h"
+#include "environmental_sensors.h"
+#include "gps_module.h"
+
+// Last result text of each hardware test, as kept by main.cpp
+struct ExportTestResults {
+  const String& builtinLed;
+  const String& neopixel;
+  const String& oled;
+  const String& adc;
+  const String& pwm;
+  const String& sd;
+  const String& rotary;
+  const String& stress;
+};
+
+struct ExportContext {
+  const DiagnosticInfo& diag;
+  const DetailedMemoryInfo& memory;
+  const EnvironmentalData& env;
+  const GPSData& gps;
+  bool gpsAvailable;
+  ExportTestResults tests;
+  const String& spiInfo;
+  String flashType;
+  String flashSpeed;
+  String wifiQuality;
+  String stableUrl;
+  String subnetMask;
+  String gateway;
+  String dns;
+  String resetReason;
+};
+
+// Function declarations
+String buildExportTXT(const ExportContext& ctx);
+String buildExportJSON(const ExportContext& ctx);
+String buildExportCSV(const ExportContext& ctx);
+String buildPrintHTML(const ExportContext& ctx);     // Print view, window.print() on load
+String formatUptime(unsigned long days, unsigned long hours, unsigned long minutes);
+
+#endif // EXPORT_BUILDERS_H
@@ -0,0 +1,49 @@
+/*
+ * GPIO_BENCHMARK.H - GPIO toggle-rate and interrupt-latency benchmark
+ * Toggle rate: digitalWrite vs gpio_set_level vs direct W1TS/W1TC registers
+ * ISR latency: GPIO_BENCH_OUT_PIN wired to GPIO_BENCH_IN_PIN (loopback),
+ * measured with the CPU cycle counter, Wi-Fi idle then under UDP load
+ */
+
+#ifndef GPIO_BENCHMARK_H
+#define GPIO_BENCHMARK_H
+
+#include <Arduino.h>
+
+struct GPIOLatencyStats {
+  uint16_t samples = 0;
+  uint16_t missed = 0;
+  uint32_t minCycles = 0;
+  uint32_t avgCycles = 0;
+  uint32_t p99Cycles = 0;
+  uint32_t maxCycles = 0;
+};
+
+struct GPIOBenchmarkData {
+  bool completed = false;
+  int outPin = -1;
+  int inPin = -1;
+  uint32_t cpuMhz = 0;
+  uint32_t iterations = 0;
+
+  // Max toggle frequency (full period = 2 writes), in kHz
+  float digitalWriteKHz = 0.0;
+  float gpioSetLevelKHz = 0.0;
+  float registerKHz = 0.0;
+
+  bool loopbackDetected = false;
+  GPIOLatencyStats idle;
+  GPIOLatencyStats loaded;
+  bool loadActive = false;
+  uint32_t loadPackets = 0;
+
+  unsigned long durationMs = 0;
+};
+
+extern GPIOBenchmarkData gpioBenchmarkData;
+extern String gpioBenchmarkTestResult;
+
+// Function declarations
+void runGPIOBenchmark();
+
+#endif // GPIO_BENCHMARK_H
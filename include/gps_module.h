@@ -2,6 +2,13 @@
  * GPS_MODULE.H - GPS NEO-6M/NEO-8M/NEO-M8 Module Handler
  * Uses UART1 with pins configured in config.h
  * Parses NMEA sentences for location, altitude, satellites, HDOP
+ * GSV/GSA bursts from every talker (GP, GL, GA, GB/BD, GQ, GN) are assembled
+ * into a fixed satellite table (gpsSkyView): no heap, one constellation
+ * replaced per completed GSV burst, used-in-fix flags from GSA
+ * UBX mode (u-blox M8 and later): the receiver is switched to binary NAV-PVT
+ * / NAV-SAT / NAV-DOP output at GPS_UBX_BAUD and up to 10 Hz; frames are decoded by the
+ * streaming UBXDecoder from the same UART and fill the same gpsData /
+ * gpsSkyView. No NAV-PVT for GPS_UBX_TIMEOUT_MS falls back to NMEA at 9600
  */
 
 #ifndef GPS_MODULE_H
@@ -10,6 +17,77 @@
 #include <Arduino.h>
 #include <HardwareSerial.h>
 
+#define GPS_NMEA_BAUD 9600                // Receiver factory default
+#define GPS_UBX_SWITCH_MS 100              // CFG-PRT sent at 9600, receiver changes baud rate
+#define GPS_UBX_TIMEOUT_MS 2500            // No NAV-PVT: configuration failed or receiver reset
+#define GPS_UBX_MAX_RATE_HZ 10             // NEO-M8 with two constellations
+#define GPS_MAX_SATELLITES 48        // In view, all constellations (multi-GNSS: 30-40 typical)
+#define GPS_SKYVIEW_TIMEOUT_MS 5000  // Constellation dropped when its GSV bursts stop
+
+// Numbered like the NMEA 4.10 GSA/GSV system ID
+enum GPSConstellation : uint8_t {
+  GPS_SYSTEM_UNKNOWN = 0,
+  GPS_SYSTEM_GPS,                    // Includes SBAS (PRN 33-64)
+  GPS_SYSTEM_GLONASS,
+  GPS_SYSTEM_GALILEO,
+  GPS_SYSTEM_BEIDOU,
+  GPS_SYSTEM_QZSS,
+  GPS_SYSTEM_COUNT
+};
+
+enum GPSProtocol : uint8_t {
+  GPS_PROTOCOL_NMEA = 0,
+  GPS_PROTOCOL_UBX_CONFIG,                 // CFG sent, waiting for the first NAV-PVT
+  GPS_PROTOCOL_UBX
+};
+
+struct GPSProtocolStatus {
+  GPSProtocol protocol = GPS_PROTOCOL_NMEA;
+  uint32_t baud = GPS_NMEA_BAUD;           // ESP32 side of the UART
+  uint8_t rateHz = 1;                      // Requested UBX navigation rate
+  uint32_t configStartMs = 0;
+  uint32_t configAcks = 0;                 // ACK-ACK / ACK-NAK for our CFG messages
+  uint32_t configNaks = 0;
+  uint32_t ubxFrames = 0;                  // Valid UBX frames (decoder)
+  uint32_t ubxChecksumErrors = 0;
+  uint32_t ubxOversize = 0;
+  uint32_t navPvt = 0;
+  uint32_t navSat = 0;
+  uint32_t navDop = 0;
+  uint32_t lastNavMs = 0;                  // Last NAV-PVT
+  uint32_t navIntervalMs = 0;              // Between the last two NAV-PVT
+  uint32_t hAccMm = 0;                     // NAV-PVT horizontal accuracy estimate
+  uint32_t nmeaSentences = 0;
+  uint32_t fallbacks = 0;
+  char fallbackReason[16] = "";
+};
+
+struct GPSSatellite {
+  uint16_t prn = 0;                  // As sent (u-blox extended numbering above 255)
+  GPSConstellation system = GPS_SYSTEM_UNKNOWN;
+  int8_t elevation = -1;             // Degrees, -1 = not reported
+  int16_t azimuth = -1;              // Degrees, -1 = not reported
+  uint8_t snr = 0;                   // C/N0 dB-Hz, 0 = not tracked
+  bool usedInFix = false;
+};
+
+struct GPSSkyView {
+  GPSSatellite satellites[GPS_MAX_SATELLITES];
+  uint8_t count = 0;                 // Satellites in view
+  uint8_t used = 0;                  // PRNs listed by the last GSA of each constellation
+  uint8_t tracked = 0;               // With an SNR
+  uint8_t meanSnr = 0;               // dB-Hz, over tracked satellites
+  uint8_t maxSnr = 0;
+  uint32_t updatedMs = 0;            // Last GSV burst committed, 0 = none yet
+  uint32_t gsvBursts = 0;
+  uint32_t gsvErrors = 0;            // Bursts dropped: sentence lost or out of order
+  uint32_t gsaSentences = 0;
+  uint32_t startMs = 0;              // initGPS(), time-to-first-fix origin
+  uint32_t ttffMs = 0;               // 0 = no fix yet
+  uint32_t reacquireMs = 0;          // Last fix loss to fix
+  uint32_t fixLosses = 0;
+};
+
 // GPS Data Structure
 struct GPSData {
   bool valid = false;
@@ -29,6 +107,7 @@ struct GPSData {
   
   uint8_t satellites = 0;
   uint8_t satellites_used = 0;
+  uint8_t satellites_in_view = 0;  // GSV, all constellations
   
   uint16_t year = 0;
   uint8_t month = 0;
@@ -42,6 +121,8 @@ struct GPSData {
 };
 
 extern GPSData gpsData;
+extern GPSSkyView gpsSkyView;
+extern GPSProtocolStatus gpsProtocolStatus;
 extern HardwareSerial& gpsSerial;
 extern String gpsTestResult;
 extern bool gpsAvailable;
@@ -49,11 +130,18 @@ extern bool gpsAvailable;
 // Function declarations
 void initGPS();
 void updateGPS();
+void resetGPSSkyView();   // Empty table, time-to-first-fix restarts now
+void maintainGPS();       // Called from loop(): drains the UART in UBX mode, configuration and fallback
+bool startGPSUbx(uint32_t baud, uint8_t rateHz);
+void stopGPSUbx();        // Back to NMEA at GPS_NMEA_BAUD
+const char* gpsProtocolName(GPSProtocol protocol);
 void testGPS();
 void parseGPRMC(const String& sentence);
 void parseGPGGA(const String& sentence);
-void parseGPGSA(const String& sentence);
-void parseGPGSV(const String& sentence);
-void handlePPSInterrupt();
+void parseGPGSA(const char* sentence);   // Any talker
+void parseGPGSV(const char* sentence);   // Any talker
+GPSConstellation gpsConstellationFromTalker(const char* sentence);  // GN = UNKNOWN (mixed)
+GPSConstellation gpsConstellationFromPRN(uint16_t prn);
+const char* gpsConstellationName(GPSConstellation system);
 
 #endif // GPS_MODULE_H
@@ -0,0 +1,80 @@
+/*
+ * GPS_TIME.H - PPS-disciplined timekeeping
+ * A RISING interrupt on the receiver's PPS output stamps each second with
+ * esp_timer_get_time() and the CPU cycle counter. maintainGPSTime() fits the
+ * last GPS_PPS_HISTORY edges with a least-squares line (local microseconds
+ * per GPS second): the slope gives the oscillator drift in ppm, the residuals
+ * the edge jitter. RMC / NAV-PVT time labels the edge that started its
+ * second, and the fitted line then converts any esp_timer value to UTC with
+ * sub-millisecond resolution (gpsTimeFromLocal), also across short PPS
+ * outages (holdover). The newlib clock (time(), gettimeofday()) follows it
+ */
+
+#ifndef GPS_TIME_H
+#define GPS_TIME_H
+
+#include <Arduino.h>
+
+#define GPS_PPS_HISTORY 64                // Edges in the drift fit (~1 min)
+#define GPS_PPS_MIN_EDGES 4               // Before the fit is trusted
+#define GPS_PPS_MAX_ERROR_US 500          // Edge farther from the predicted second: glitch
+#define GPS_PPS_RESYNC_GLITCHES 3         // Consecutive glitches: the receiver re-phased, fit restarts
+#define GPS_PPS_TIMEOUT_MS 1500           // No edge: holdover on the last fit
+#define GPS_PPS_MAX_GAP_S 10              // Shorter gaps are bridged by the fit, longer ones restart it
+#define GPS_TIME_HOLDOVER_S 600           // Time no longer served after this long without PPS
+#define GPS_TIME_UTC_WINDOW_MS 950        // UTC sentence must follow the edge it labels within this
+#define GPS_TIME_RELABEL_COUNT 3          // Disagreeing labels in a row before the UTC second is replaced
+#define GPS_TIME_STEP_US 10000            // System clock stepped above this offset, slewed below
+#define GPS_TIME_SLEW_US 50
+
+enum GPSTimeState : uint8_t {
+  GPS_TIME_NONE = 0,
+  GPS_TIME_PPS,                            // Edges arriving, UTC second not labelled yet
+  GPS_TIME_LOCKED,
+  GPS_TIME_HOLDOVER                        // PPS lost, UTC extrapolated from the last fit
+};
+
+struct GPSTimeStatus {
+  bool running = false;
+  int pin = -1;
+  GPSTimeState state = GPS_TIME_NONE;
+  uint32_t edges = 0;                      // Interrupts
+  uint32_t accepted = 0;                   // Edges added to the fit
+  uint32_t glitches = 0;                   // Off the predicted second (noise, GPIO36/39 errata)
+  uint32_t skipped = 0;                    // Seconds without a processed edge
+  uint32_t resyncs = 0;
+  uint32_t labels = 0;                     // UTC seconds matched to an edge
+  uint32_t relabels = 0;                   // UTC second replaced after GPS_TIME_RELABEL_COUNT mismatches
+  uint32_t locks = 0;
+  uint32_t lastEdgeMs = 0;
+  uint32_t lastIntervalUs = 0;
+  uint8_t fitEdges = 0;
+  double driftPpm = 0.0;                   // esp_timer vs GPS, positive = local clock fast
+  float jitterRmsUs = 0.0f;                // Edge residuals from the fit
+  float jitterPeakUs = 0.0f;
+  uint32_t cpuHz = 0;                      // Cycle counter between consecutive edges
+  float cpuDriftPpm = 0.0f;                // Against getCpuFrequencyMhz()
+  uint32_t utcSeconds = 0;                 // Unix time of the last labelled edge
+  uint32_t lockedSinceMs = 0;
+  int32_t systemOffsetUs = 0;              // gettimeofday() - UTC before the last correction
+  uint32_t systemSteps = 0;
+  uint32_t systemSlews = 0;
+};
+
+extern GPSTimeStatus gpsTimeStatus;
+
+// Function declarations
+void beginGPSTime(int ppsPin);
+void stopGPSTime();
+void maintainGPSTime();                     // Called from maintainGPS(): folds new edges into the fit
+// UTC second just decoded (RMC or NAV-PVT on the second); `receivedMs` = millis() at decode
+void gpsTimeOnUtc(uint32_t unixSeconds, uint32_t receivedMs);
+// Any task: false when neither locked nor in holdover
+bool gpsTimeFromLocal(int64_t espTimerUs, uint64_t& utcUs);
+bool gpsTimeNow(uint64_t& utcUs);
+// Consistent esp_timer -> UTC anchor for exports (trace dump, SD log sync records)
+bool gpsTimeAnchor(int64_t& espTimerUs, uint64_t& utcUs, double& driftPpm);
+const char* gpsTimeStateName(GPSTimeState state);
+uint32_t gpsUnixTime(uint16_t year, uint8_t month, uint8_t day, uint8_t hour, uint8_t minute, uint8_t second);
+
+#endif // GPS_TIME_H
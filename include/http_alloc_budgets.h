@@ -0,0 +1,80 @@
+/*
+ * HTTP_ALLOC_BUDGETS.H - Heap allocation budget per route (server.on() 3rd argument)
+ * A budget is a target, not a measurement plus margin. It adds three parts:
+ * - HTTP_ALLOC_RESPONSE: what WebServer itself allocates to answer (status
+ *   line and header Strings, X-Gen-Us included)
+ * - HTTP_ALLOC_NETWORK(_STREAM): what lwIP may take in the handler's task on
+ *   the device (one pbuf per TCP segment with TCP core locking)
+ * - HTTP_ALLOC_HANDLER_*: what the handler may allocate on its own
+ * Routes that build their body in the request arena (request_arena.h) are
+ * allowed nothing on their own. When one goes over, fix the route; do not
+ * raise the number.
+ *
+ * Checked by the native tests (test/test_native, test_alloc_budget_*):
+ * main.cpp's handler bodies (api_routes.h, export_builders.h) served by
+ * DiagnosticWebServer on the native shims, which keep the Arduino-ESP32
+ * String growth policy and build the response headers like the device
+ * WebServer. Second call of each route (first one sizes the header
+ * buffers), tables at their largest: HTTP_METRICS_MAX_ROUTES routes called,
+ * TASK_PROFILER_MAX_TASKS tasks, both trace rings and TRACE_MAX_NAMES names
+ * full with a PPS time anchor, BOOT_PROFILE_MAX_STAGES stages,
+ * LOOP_STALL_TOP stalls, ADC_SAMPLER_MAX_CHANNELS channels with histograms
+ * and spectrum, GPS_MAX_SATELLITES satellites in view, clock frozen so the
+ * counts are reproducible. There is no lwIP on the host, so a route fails
+ * when it goes over HTTP_ALLOC_RESPONSE + its handler share.
+ *
+ * /api/overview and /api/dashboard read the IDF and the Wi-Fi driver and do
+ * not run on the host. Their shares come from the code: /api/overview
+ * formats into the arena with no String helper, and /api/dashboard adds
+ * the copy of its ?fields= argument. tools/alloc_budget_check.py checks
+ * both on the device. /api/wifi-scan stays unchecked (0): its count grows
+ * with the networks found, and the scan driver allocates on its own.
+ */
+
+#ifndef HTTP_ALLOC_BUDGETS_H
+#define HTTP_ALLOC_BUDGETS_H
+
+#include <stdint.h>
+
+// Host ceiling for one JSON answer: 13 to 17 depending on the header lengths
+#define HTTP_ALLOC_RESPONSE 17
+// Single body: at most REQUEST_ARENA_SIZE bytes, 6 segments plus the headers
+#define HTTP_ALLOC_NETWORK 8
+// Chunked bodies: /metrics at full tables is ~64 KB, i.e. 46 chunks of
+// METRICS_CHUNK_SIZE, each split over two segments by its chunk framing
+#define HTTP_ALLOC_NETWORK_STREAM 96
+
+constexpr uint16_t httpAllocBudget(uint16_t handler, uint16_t network = HTTP_ALLOC_NETWORK) {
+  return HTTP_ALLOC_RESPONSE + network + handler;
+}
+
+// Handler share per call; 0 = everything in the request arena
+#define HTTP_ALLOC_HANDLER_ARENA 0
+#define HTTP_ALLOC_HANDLER_DASHBOARD 1         // String copy of ?fields=
+// String builders (export_builders.cpp): today's count is a ceiling to bring
+// down, never to raise
+#define HTTP_ALLOC_HANDLER_EXPORT_TXT 92
+#define HTTP_ALLOC_HANDLER_EXPORT_JSON 104
+#define HTTP_ALLOC_HANDLER_EXPORT_CSV 128
+#define HTTP_ALLOC_HANDLER_PRINT 326
+
+#define HTTP_ALLOC_BUDGET_GPS httpAllocBudget(HTTP_ALLOC_HANDLER_ARENA)
+#define HTTP_ALLOC_BUDGET_GPS_SATELLITES httpAllocBudget(HTTP_ALLOC_HANDLER_ARENA)
+#define HTTP_ALLOC_BUDGET_ENVIRONMENTAL httpAllocBudget(HTTP_ALLOC_HANDLER_ARENA)
+#define HTTP_ALLOC_BUDGET_MEMORY_DETAILS httpAllocBudget(HTTP_ALLOC_HANDLER_ARENA)
+#define HTTP_ALLOC_BUDGET_ADC_STREAM httpAllocBudget(HTTP_ALLOC_HANDLER_ARENA)
+#define HTTP_ALLOC_BUDGET_BOOT_PROFILE httpAllocBudget(HTTP_ALLOC_HANDLER_ARENA)
+#define HTTP_ALLOC_BUDGET_TASKS httpAllocBudget(HTTP_ALLOC_HANDLER_ARENA)
+#define HTTP_ALLOC_BUDGET_LOOP_MONITOR httpAllocBudget(HTTP_ALLOC_HANDLER_ARENA)
+#define HTTP_ALLOC_BUDGET_OVERVIEW httpAllocBudget(HTTP_ALLOC_HANDLER_ARENA)
+#define HTTP_ALLOC_BUDGET_DASHBOARD httpAllocBudget(HTTP_ALLOC_HANDLER_DASHBOARD)
+#define HTTP_ALLOC_BUDGET_HTTP_METRICS httpAllocBudget(HTTP_ALLOC_HANDLER_ARENA, HTTP_ALLOC_NETWORK_STREAM)
+#define HTTP_ALLOC_BUDGET_TRACE httpAllocBudget(HTTP_ALLOC_HANDLER_ARENA, HTTP_ALLOC_NETWORK_STREAM)
+#define HTTP_ALLOC_BUDGET_METRICS httpAllocBudget(HTTP_ALLOC_HANDLER_ARENA, HTTP_ALLOC_NETWORK_STREAM)
+#define HTTP_ALLOC_BUDGET_EXPORT_TXT httpAllocBudget(HTTP_ALLOC_HANDLER_EXPORT_TXT)
+#define HTTP_ALLOC_BUDGET_EXPORT_JSON httpAllocBudget(HTTP_ALLOC_HANDLER_EXPORT_JSON)
+#define HTTP_ALLOC_BUDGET_EXPORT_CSV httpAllocBudget(HTTP_ALLOC_HANDLER_EXPORT_CSV)
+#define HTTP_ALLOC_BUDGET_PRINT httpAllocBudget(HTTP_ALLOC_HANDLER_PRINT)
+#define HTTP_ALLOC_BUDGET_WIFI_SCAN 0
+
+#endif // HTTP_ALLOC_BUDGETS_H
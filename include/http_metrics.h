@@ -0,0 +1,104 @@
+/*
+ * HTTP_METRICS.H - Per-route request latency, response size and heap delta
+ * DiagnosticWebServer wraps every on() registration: each call is timed
+ * with esp_timer into a LatencyHistogram, body bytes are counted in
+ * send()/sendContent() and free heap is sampled around the handler; the
+ * call is also bracketed by trace begin/end events named after the route.
+ * Fixed table allocated once, nothing allocated per request.
+ * ENABLE_ALLOC_TRACER: heap allocations made by the handler are counted
+ * (alloc_tracer.h) and checked against the route's allocation budget
+ * ENABLE_CBOR_API: application/json bodies passed to send() or streamed with
+ * beginJsonStream() are transcoded to CBOR when the request asks for it
+ * (Accept: application/cbor or ?fmt=cbor); other content types (OpenMetrics,
+ * CSV/TXT exports, HTML, logic analyzer captures) ignore the request
+ * Every handler runs with the request arena (request_arena.h) and the arena
+ * is reset when it returns, whatever the ENABLE_* flags
+ */
+
+#ifndef HTTP_METRICS_H
+#define HTTP_METRICS_H
+
+#include <Arduino.h>
+#include <WebServer.h>
+#include <cstring>
+#include "cbor_encoder.h"
+#include "config.h"
+#include "latency_histogram.h"
+#include "request_arena.h"
+
+struct HttpRouteMetrics {
+  const char* uri;                  // String literal passed to on()
+  LatencyHistogram latency;         // count = calls
+  uint64_t bytesTotal;              // Response bodies (headers excluded)
+  uint32_t bytesMax;
+  int64_t heapDeltaTotal;           // Free heap after - before; drifting negative = leak
+  int32_t heapDeltaMin;
+  int32_t heapDeltaMax;
+  uint16_t allocBudget;             // Allocations per call, 0 = unchecked
+  uint32_t allocMax;                // ENABLE_ALLOC_TRACER only
+  uint64_t allocTotal;
+  uint32_t allocBytesMax;
+  int32_t allocPeakMax;             // Highest live heap inside one call
+  uint32_t overBudget;              // Calls above allocBudget
+};
+
+class DiagnosticWebServer : public WebServer {
+public:
+  explicit DiagnosticWebServer(int port) : WebServer(port) {}
+
+  // Hides WebServer::on(): registers a metrics slot and times the handler
+  void on(const char* uri, THandlerFunction handler, uint16_t allocBudget = HTTP_ALLOC_BUDGET_DEFAULT);
+
+  // Hides WebServer::begin(): also collects the Accept header
+  void begin();
+
+  // Same overloads as WebServer, body bytes counted for the current route
+  void send(int code, const char* contentType = NULL, const String& content = String(""));
+  void send(int code, const String& contentType, const String& content) {
+    send(code, contentType.c_str(), content);
+  }
+  void send(int code, const char* contentType, const char* content) {
+    send(code, contentType, String(content));
+  }
+  // Arena body sent in place (no String copy); 500 if the text could not be built
+  void send(int code, const char* contentType, const ArenaText& content);
+  void sendContent(const String& content) {
+    responseBytes += content.length();
+    WebServer::sendContent(content);
+  }
+  void sendContent(const char* content) {
+    sendContent(content, strlen(content));
+  }
+  void sendContent(const char* content, size_t size) {
+    responseBytes += size;
+    WebServer::sendContent(content, size);
+  }
+
+  // Chunked JSON body; every fragment must end between two JSON tokens
+  // (transcoded one by one when CBOR was asked for)
+  void beginJsonStream(int code);
+  void sendJsonFragment(const char* json, size_t length);
+  void endJsonStream();
+
+  // Last request URI without the String copy made by uri()
+  const String& currentUri() const { return _currentUri; }
+
+  uint32_t responseBytes = 0;
+
+private:
+  bool sendCbor(int code, const char* json, size_t length, int64_t encodeStart);
+
+  int64_t requestStartUs = 0;       // Set while a registered handler runs (X-Gen-Us)
+  bool cborRequested = false;
+  bool streamCbor = false;          // Current chunked body goes out as CBOR
+  CborStream cborStream = {};
+  uint8_t* cborChunk = nullptr;     // Arena buffer reused by every fragment
+  size_t cborChunkSize = 0;
+};
+
+// Function declarations
+uint16_t getHttpRouteCount();
+const HttpRouteMetrics* getHttpRouteMetrics(uint16_t index);
+void resetHttpMetrics();
+
+#endif // HTTP_METRICS_H
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <Arduino.h>
+#include <initializer_list>
+#include "request_arena.h"
 
 struct JsonFieldSpec {
   const char* key;
@@ -29,3 +31,8 @@ inline JsonFieldSpec jsonFloatField(const char* key, double value, uint8_t decim
   return {key, String(value, static_cast<unsigned int>(decimals)), true};
 }
 
+String jsonEscape(const char* raw);
+void jsonEscapeTo(ArenaText& out, const char* raw);
+void appendJsonField(String& json, bool& first, const JsonFieldSpec& field);
+void appendJsonField(ArenaText& json, bool& first, const JsonFieldSpec& field);
+String buildJsonObject(std::initializer_list<JsonFieldSpec> fields);
@@ -173,6 +173,8 @@ class TextField {
   X(echo_pin, "Echo Pin", "Broche Echo") \
   X(measure_distance, "Measure Distance", "Mesurer la distance") \
   X(distance, "Distance", "Distance") \
+  X(distance_raw, "Raw distance", "Distance brute") \
+  X(sound_speed, "Speed of sound", "Vitesse du son") \
   X(motion_sensor, "PIR (Motion Detector)", "Capteur de présence") \
   X(motion_sensor_desc, "Passive infrared motion detection sensor", "Détecteur de mouvement PIR") \
   X(check_motion, "Check Motion", "Détecter le mouvement") \
@@ -506,6 +508,25 @@ class TextField {
   X(button_released, "Released", "Relâché") \
   X(monitor_button, "Monitor", "Surveiller") \
   X(stop_monitoring, "Stop", "Arrêter") \
+  X(adc_continuous, "Continuous ADC (DMA)", "ADC continu (DMA)") \
+  X(adc_continuous_desc, "Samples selected ADC1 pins at up to tens of kS/s with calibrated mean, RMS, noise histogram and FFT spectrum", "Échantillonne les broches ADC1 choisies jusqu'à plusieurs dizaines de kS/s : moyenne, RMS, histogramme de bruit et spectre FFT calibrés") \
+  X(adc_pins, "Pins", "Broches") \
+  X(adc_rate, "Rate (S/s)", "Fréquence (S/s)") \
+  X(adc_uncalibrated, "no eFuse calibration", "sans calibration eFuse") \
+  X(start_stream, "Start stream", "Démarrer le flux") \
+  X(stop_stream, "Stop stream", "Arrêter le flux") \
+  X(overruns, "Overruns", "Débordements") \
+  X(samples, "samples", "échantillons") \
+  X(sd_benchmark, "Benchmark", "Benchmark") \
+  X(sd_logger, "Data logger", "Enregistreur") \
+  X(sd_log_interval, "Interval (ms)", "Intervalle (ms)") \
+  X(sd_log_start, "Start logging", "Démarrer l'enregistrement") \
+  X(sd_log_stop, "Stop logging", "Arrêter l'enregistrement") \
+  X(sd_log_file, "Log file", "Fichier journal") \
+  X(sd_log_records, "Records", "Enregistrements") \
+  X(sd_log_dropped, "dropped", "perdus") \
+  X(sd_log_writes, "Buffers written", "Tampons écrits") \
+  X(sd_log_errors, "Write errors", "Erreurs d'écriture") \
   X(coming_soon, "Coming Soon", "Bientôt disponible")
 
 namespace Texts {
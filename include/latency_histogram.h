@@ -0,0 +1,89 @@
+/*
+ * LATENCY_HISTOGRAM.H - Fixed-size log-linear (HDR-style) latency histogram
+ * 4 sub-buckets per power of two from 32 us to 16.8 s (bucket width <= 25 %),
+ * uint16 counts halved together on saturation. Shared by the HTTP route
+ * metrics and the loop monitor; header-only, no allocation
+ */
+
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <Arduino.h>
+
+#define LATENCY_HIST_SUB_BUCKETS 4
+#define LATENCY_HIST_MIN_EXPONENT 5                // Bucket 0 = [0, 32 us)
+#define LATENCY_HIST_MAX_EXPONENT 23               // Last octave [8.4 s, 16.8 s), saturates above
+#define LATENCY_HIST_BUCKETS (1 + (LATENCY_HIST_MAX_EXPONENT - LATENCY_HIST_MIN_EXPONENT + 1) * LATENCY_HIST_SUB_BUCKETS)
+
+// Plain struct: valid when zero-filled (static storage, calloc, memset)
+struct LatencyHistogram {
+  uint32_t count;
+  uint64_t totalUs;
+  uint32_t maxUs;
+  uint16_t buckets[LATENCY_HIST_BUCKETS];
+};
+
+static inline uint16_t latencyBucket(uint32_t us) {
+  if (us < (1UL << LATENCY_HIST_MIN_EXPONENT)) {
+    return 0;
+  }
+  uint8_t exponent = 31 - __builtin_clz(us);
+  if (exponent > LATENCY_HIST_MAX_EXPONENT) {
+    return LATENCY_HIST_BUCKETS - 1;
+  }
+  uint8_t sub = (us >> (exponent - 2)) & (LATENCY_HIST_SUB_BUCKETS - 1);
+  return 1 + (exponent - LATENCY_HIST_MIN_EXPONENT) * LATENCY_HIST_SUB_BUCKETS + sub;
+}
+
+// Highest value falling in the bucket
+static inline uint32_t latencyBucketUpperBound(uint16_t bucket) {
+  if (bucket == 0) {
+    return (1UL << LATENCY_HIST_MIN_EXPONENT) - 1;
+  }
+  uint8_t exponent = LATENCY_HIST_MIN_EXPONENT + (bucket - 1) / LATENCY_HIST_SUB_BUCKETS;
+  uint8_t sub = (bucket - 1) % LATENCY_HIST_SUB_BUCKETS;
+  uint32_t width = 1UL << (exponent - 2);
+  return ((LATENCY_HIST_SUB_BUCKETS + sub) << (exponent - 2)) + width - 1;
+}
+
+static inline void latencyRecord(LatencyHistogram& histogram, uint32_t us) {
+  histogram.count++;
+  histogram.totalUs += us;
+  if (us > histogram.maxUs) histogram.maxUs = us;
+
+  uint16_t bucket = latencyBucket(us);
+  if (histogram.buckets[bucket] == UINT16_MAX) {
+    // Saturation : on divise tout par deux, les proportions restent valides
+    for (uint16_t i = 0; i < LATENCY_HIST_BUCKETS; i++) {
+      histogram.buckets[i] >>= 1;
+    }
+  }
+  histogram.buckets[bucket]++;
+}
+
+// Nearest rank; upper bound of the bucket, capped at the exact maximum
+static inline uint32_t latencyPercentile(const LatencyHistogram& histogram, uint8_t percent) {
+  uint32_t total = 0;
+  for (uint16_t i = 0; i < LATENCY_HIST_BUCKETS; i++) {
+    total += histogram.buckets[i];
+  }
+  if (total == 0) {
+    return 0;
+  }
+  const uint32_t rank = (total * percent + 99) / 100;
+  uint32_t seen = 0;
+  for (uint16_t i = 0; i < LATENCY_HIST_BUCKETS - 1; i++) {
+    seen += histogram.buckets[i];
+    if (seen >= rank) {
+      uint32_t bound = latencyBucketUpperBound(i);
+      return bound < histogram.maxUs ? bound : histogram.maxUs;
+    }
+  }
+  return histogram.maxUs;
+}
+
+static inline uint32_t latencyAverage(const LatencyHistogram& histogram) {
+  return histogram.count > 0 ? (uint32_t)(histogram.totalUs / histogram.count) : 0;
+}
+
+#endif // LATENCY_HISTOGRAM_H
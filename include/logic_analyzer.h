@@ -0,0 +1,73 @@
+/*
+ * LOGIC_ANALYZER.H - Software logic analyzer on spare GPIOs
+ * Cycle-counted sampling loop pinned to core 1, up to 8 channels,
+ * PSRAM capture buffer, edge/level trigger with pre-trigger window.
+ * Export: compact run-length encoding (LARL) or VCD text
+ */
+
+#ifndef LOGIC_ANALYZER_H
+#define LOGIC_ANALYZER_H
+
+#include <Arduino.h>
+
+#define LA_MAX_CHANNELS 8
+#define LA_RLE_MAGIC "LARL"
+#define LA_RLE_VERSION 1
+#define LA_RLE_HEADER_SIZE 32
+
+enum LogicAnalyzerTrigger : uint8_t {
+  LA_TRIGGER_NONE = 0,
+  LA_TRIGGER_RISING,
+  LA_TRIGGER_FALLING,
+  LA_TRIGGER_HIGH,
+  LA_TRIGGER_LOW
+};
+
+enum LogicAnalyzerState : uint8_t {
+  LA_STATE_IDLE = 0,
+  LA_STATE_ARMED,
+  LA_STATE_CAPTURING,
+  LA_STATE_DONE,
+  LA_STATE_TIMEOUT,
+  LA_STATE_ERROR
+};
+
+struct LogicAnalyzerConfig {
+  uint8_t channelCount = 0;
+  int8_t pins[LA_MAX_CHANNELS] = {-1, -1, -1, -1, -1, -1, -1, -1};
+  uint32_t sampleRate = 1000000;   // Hz
+  uint32_t sampleCount = 65536;
+  LogicAnalyzerTrigger trigger = LA_TRIGGER_NONE;
+  uint8_t triggerChannel = 0;
+  uint8_t pretriggerPercent = 10;
+  uint32_t timeoutMs = 2000;       // Max wait for the trigger condition
+};
+
+struct LogicAnalyzerCapture {
+  LogicAnalyzerState state = LA_STATE_IDLE;
+  LogicAnalyzerConfig config;
+  uint8_t* samples = nullptr;      // One byte per sample, bit n = channel n
+  uint32_t capacity = 0;           // Allocated bytes
+  uint32_t length = 0;             // Valid samples
+  uint32_t triggerIndex = 0;       // Sample index of the trigger
+  uint32_t lateSamples = 0;        // Samples taken more than one period late
+  uint32_t actualRate = 0;         // Measured sample rate (Hz)
+  bool inPSRAM = false;
+  String error = "";
+};
+
+extern LogicAnalyzerCapture laCapture;
+
+// Function declarations
+bool configureLogicAnalyzer(const LogicAnalyzerConfig& config, String& error);
+void runLogicAnalyzerCapture();
+const char* logicAnalyzerStateName(LogicAnalyzerState state);
+const char* logicAnalyzerTriggerName(LogicAnalyzerTrigger trigger);
+LogicAnalyzerTrigger parseLogicAnalyzerTrigger(const String& name);
+// Chunked exporters: call the header writer once, then the encoder until it returns 0
+size_t writeLogicAnalyzerRLEHeader(uint8_t* out, size_t outSize);
+size_t encodeLogicAnalyzerRLE(uint32_t& cursor, uint8_t* out, size_t outSize);
+size_t writeLogicAnalyzerVCDHeader(char* out, size_t outSize);
+size_t encodeLogicAnalyzerVCD(uint32_t& cursor, char* out, size_t outSize);
+
+#endif // LOGIC_ANALYZER_H
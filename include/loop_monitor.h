@@ -0,0 +1,61 @@
+/*
+ * LOOP_MONITOR.H - Main loop phase timing, jitter and stall recorder
+ * loop() marks the end of each phase; phases are timed with the CPU cycle
+ * counter (loopTask stays on one core) into LatencyHistograms, together
+ * with the busy time and begin-to-begin period of every iteration.
+ * Iterations above LOOP_STALL_THRESHOLD_MS keep the slowest phase and its
+ * culprit (HTTP route) in a top-N table and are reported on Serial
+ */
+
+#ifndef LOOP_MONITOR_H
+#define LOOP_MONITOR_H
+
+#include <Arduino.h>
+#include "latency_histogram.h"
+
+#define LOOP_STALL_TOP 8
+#define LOOP_STALL_CULPRIT_LEN 40
+
+enum LoopPhase : uint8_t {
+  LOOP_PHASE_HEARTBEAT = 0,   // NeoPixel fade + show()
+  LOOP_PHASE_HTTP,            // server.handleClient()
+  LOOP_PHASE_BOOT,            // bootGraphStep()
+  LOOP_PHASE_NETWORK,         // maintainNetworkServices()
+  LOOP_PHASE_WIFI_STATUS,     // updateNeoPixelWifiStatus()
+  LOOP_PHASE_BUTTONS,
+  LOOP_PHASE_SD_LOGGER,
+  LOOP_PHASE_TASK_PROFILER,
+  LOOP_PHASE_SENSORS,         // maintainDHTSensor() + maintainDistanceSensor()
+  LOOP_PHASE_PERIODIC,        // 30 s collectDiagnosticInfo() + serial update
+  LOOP_PHASE_COUNT
+};
+
+struct LoopStall {
+  uint32_t atMs;
+  uint32_t durationUs;        // Whole iteration
+  uint32_t phaseUs;           // Slowest phase
+  uint8_t phase;
+  char culprit[LOOP_STALL_CULPRIT_LEN];
+};
+
+struct LoopMonitorData {
+  uint32_t loops;
+  uint32_t stalls;            // Iterations above LOOP_STALL_THRESHOLD_MS
+  LatencyHistogram busy;      // loopMonitorBegin() -> loopMonitorEnd()
+  LatencyHistogram period;    // Begin -> next begin, delay(10) included
+  LatencyHistogram phases[LOOP_PHASE_COUNT];
+  LoopStall top[LOOP_STALL_TOP];  // Longest first
+  uint8_t topCount;
+};
+
+extern LoopMonitorData loopMonitorData;
+
+// Function declarations
+void loopMonitorBegin();
+void loopMonitorMark(LoopPhase phase, const char* detail = nullptr);  // End of `phase`
+void loopMonitorEnd();
+void resetLoopMonitor();
+const char* loopPhaseName(uint8_t phase);
+void printLoopMonitorSummary();
+
+#endif // LOOP_MONITOR_H
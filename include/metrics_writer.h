@@ -0,0 +1,89 @@
+/*
+ * METRICS_WRITER.H - OpenMetrics text rendered into a fixed chunk buffer
+ * printf-style lines go into one TCP-segment-sized buffer that is handed
+ * to sendContent() whenever the next line would not fit: no String and
+ * no heap allocation while rendering /metrics
+ */
+
+#ifndef METRICS_WRITER_H
+#define METRICS_WRITER_H
+
+#include <Arduino.h>
+#include <stdarg.h>
+#include "http_metrics.h"
+
+#define METRICS_CHUNK_SIZE 1436            // One TCP segment (MSS 1436 in lwIP defaults)
+#define METRICS_CONTENT_TYPE "application/openmetrics-text; version=1.0.0; charset=utf-8"
+
+class MetricsWriter {
+public:
+  explicit MetricsWriter(DiagnosticWebServer& server) : server(server) {}
+
+  void begin() {
+    server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+    server.send(200, METRICS_CONTENT_TYPE, "");
+  }
+
+  // "# TYPE" / "# UNIT" / "# HELP" block; unit must be the name suffix (OpenMetrics)
+  void family(const char* name, const char* type, const char* help, const char* unit = nullptr) {
+    printf("# TYPE %s %s\n", name, type);
+    if (unit) printf("# UNIT %s %s\n", name, unit);
+    printf("# HELP %s %s\n", name, help);
+  }
+
+  void printf(const char* format, ...) __attribute__((format(printf, 2, 3))) {
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(buffer + used, sizeof(buffer) - used, format, args);
+    va_end(args);
+    if (length < 0) return;
+    if (used + length >= sizeof(buffer)) {
+      // Ligne trop longue pour la place restante : on vide le tampon et on recommence
+      flush();
+      va_start(args, format);
+      length = vsnprintf(buffer, sizeof(buffer), format, args);
+      va_end(args);
+      if (length < 0) return;
+      if ((size_t)length >= sizeof(buffer)) length = sizeof(buffer) - 1;
+    }
+    used += length;
+  }
+
+  // Label value with \, " and newline escaped, truncated to fit `size`
+  static const char* escapeLabel(char* out, size_t size, const char* value) {
+    size_t o = 0;
+    for (const char* p = value; *p && o + 2 < size; p++) {
+      if (*p == '\\' || *p == '"') {
+        out[o++] = '\\';
+        out[o++] = *p;
+      } else if (*p == '\n') {
+        out[o++] = '\\';
+        out[o++] = 'n';
+      } else {
+        out[o++] = *p;
+      }
+    }
+    out[o] = '\0';
+    return out;
+  }
+
+  void finish() {
+    printf("# EOF\n");
+    flush();
+    server.sendContent("");
+  }
+
+private:
+  void flush() {
+    if (used > 0) {
+      server.sendContent(buffer, used);
+      used = 0;
+    }
+  }
+
+  DiagnosticWebServer& server;
+  char buffer[METRICS_CHUNK_SIZE];
+  size_t used = 0;
+};
+
+#endif // METRICS_WRITER_H
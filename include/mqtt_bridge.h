@@ -0,0 +1,57 @@
+/*
+ * MQTT_BRIDGE.H - Batched MQTT telemetry publisher (ESP-IDF esp-mqtt client)
+ * Bridge task samples SDLogRecord snapshots (envData, gpsData, heap, RSSI)
+ * into a backlog ring (PSRAM when present) and publishes them as compact
+ * JSON batches. While the broker is unreachable the ring keeps filling
+ * (oldest dropped when full); after reconnect it drains with one QoS 1
+ * batch in flight, or a bounded burst per tick at QoS 0.
+ * Topics: MQTT_TOPIC_PREFIX/<mac>/telemetry, MQTT_TOPIC_PREFIX/<mac>/status
+ * (retained, last will "offline"). Decode with tools/mqtt_telemetry.py
+ */
+
+#ifndef MQTT_BRIDGE_H
+#define MQTT_BRIDGE_H
+
+#include <Arduino.h>
+#include "latency_histogram.h"
+
+#define MQTT_PAYLOAD_VERSION 1
+
+struct MqttBridgeStatus {
+  bool running = false;
+  bool connected = false;
+  uint8_t qos = 0;
+  uint32_t sampleIntervalMs = 0;
+  uint32_t publishIntervalMs = 0;
+  uint32_t backlogCapacity = 0;     // Records
+  bool backlogInPsram = false;
+  uint32_t backlogRecords = 0;      // Sampled, not yet acknowledged
+  uint32_t recordsSampled = 0;
+  uint32_t recordsPublished = 0;    // Sent (QoS 0) or acknowledged (QoS 1)
+  uint32_t recordsDropped = 0;      // Overwritten in a full backlog
+  uint32_t batchesPublished = 0;
+  uint32_t batchSeq = 0;            // Sequence number of the last batch sent
+  uint32_t publishErrors = 0;
+  uint32_t retransmits = 0;         // QoS 1 batches re-sent after an ack timeout
+  uint32_t connects = 0;
+  uint32_t disconnects = 0;
+  uint32_t lastPayloadBytes = 0;
+  uint32_t bytesPublished = 0;
+  uint64_t busyUs = 0;              // Encode + publish time spent by the bridge task
+  uint32_t clientHeapBytes = 0;     // Heap taken by esp-mqtt (buffers, task) at start
+  uint32_t backlogHeapBytes = 0;
+  uint32_t stackFreeBytes = 0;      // Bridge task stack high water mark
+  LatencyHistogram publishUs;       // Per batch: encode + esp_mqtt_client_publish()
+  String error = "";
+};
+
+extern MqttBridgeStatus mqttBridgeStatus;
+
+// Function declarations
+bool startMqttBridge(uint32_t sampleIntervalMs, uint32_t publishIntervalMs, uint8_t qos, String& error);
+void stopMqttBridge();     // Keeps the client (and running) if the task has not exited after 3 s
+void maintainMqttBridge();  // Called from loop(): autostart on Wi-Fi, sensor refresh for the sampler
+const char* getMqttDeviceId();
+uint32_t getMqttBridgeUptimeMs();
+
+#endif // MQTT_BRIDGE_H
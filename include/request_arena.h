@@ -0,0 +1,107 @@
+/*
+ * REQUEST_ARENA.H - Per-request bump arena for HTTP handler temporaries
+ * One block reserved at startup (PSRAM first, internal SRAM otherwise):
+ * response text (ArenaText), CBOR buffers and scratch space are carved from
+ * it by moving a pointer, and DiagnosticWebServer::on() releases everything
+ * in one step once the handler has returned. Nothing is handed back to the
+ * heap piecemeal, so polling the API no longer fragments it.
+ * Loop task only; memory taken from the arena must not outlive the request
+ * (tasks started by a handler copy what they keep). A request that does not
+ * fit spills to the heap; spills are freed with the arena and counted
+ */
+
+#ifndef REQUEST_ARENA_H
+#define REQUEST_ARENA_H
+
+#include <Arduino.h>
+#include <stdarg.h>
+#include "config.h"
+
+#define REQUEST_ARENA_MAX_SPILLS 8        // Heap blocks one request may add when the arena is full
+
+struct RequestArenaStats {
+  uint32_t capacity;                // Bytes, 0 = not allocated (every request spills)
+  bool inPsram;
+  uint32_t used;                    // Current request
+  uint32_t highWater;               // Largest request since boot / reset
+  uint32_t requests;                // reset() calls with something allocated
+  uint32_t spills;                  // Heap blocks taken because the arena was full
+  uint32_t spillBytes;
+  uint32_t failures;                // Allocations refused (spill table full or heap exhausted)
+};
+
+class RequestArena {
+public:
+  // Reserves the block once; false leaves the arena empty (spill only)
+  bool begin(size_t capacity);
+
+  // 4-byte aligned block, nullptr when neither the arena nor the heap can serve it
+  void* allocate(size_t size);
+
+  // Grows the last block in place; false when it is not the last one or does not fit
+  bool extend(void* block, size_t oldSize, size_t newSize);
+
+  // Releases every block of the request (arena and spills)
+  void reset();
+
+  void stats(RequestArenaStats& out) const;
+  void clearStats();
+
+private:
+  uint8_t* base = nullptr;
+  size_t capacity = 0;
+  size_t used = 0;
+  size_t highWater = 0;
+  bool inPsram = false;
+  void* spill[REQUEST_ARENA_MAX_SPILLS] = {};
+  uint8_t spillCount = 0;
+  size_t spillUsed = 0;              // Spilled bytes of the current request (high-water)
+  uint32_t requests = 0;
+  uint32_t spills = 0;
+  uint32_t spillBytes = 0;
+  uint32_t failures = 0;
+};
+
+extern RequestArena requestArena;
+
+// Growable NUL-terminated text in the arena: String-like appends plus printf,
+// so /api bodies are formatted without String heap traffic.
+// After a failed allocation ok() is false and further appends are dropped
+class ArenaText {
+public:
+  explicit ArenaText(size_t reserve = 256, RequestArena& arena = requestArena);
+  ArenaText(const ArenaText&) = delete;
+  ArenaText& operator=(const ArenaText&) = delete;
+
+  ArenaText& operator+=(const char* text) {
+    if (text) append(text, strlen(text));
+    return *this;
+  }
+  ArenaText& operator+=(const String& text) {
+    append(text.c_str(), text.length());
+    return *this;
+  }
+  ArenaText& operator+=(char c) {
+    append(&c, 1);
+    return *this;
+  }
+
+  void append(const char* text, size_t length);
+  void printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+  void clear();                     // Keeps the block: reused by streamed chunks
+
+  const char* c_str() const { return buffer ? buffer : ""; }
+  size_t length() const { return used; }
+  bool ok() const { return !failed; }
+
+private:
+  bool reserve(size_t size);
+
+  RequestArena& arena;
+  char* buffer = nullptr;
+  size_t size = 0;                  // Block size, NUL included
+  size_t used = 0;
+  bool failed = false;
+};
+
+#endif // REQUEST_ARENA_H
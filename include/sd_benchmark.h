@@ -0,0 +1,70 @@
+/*
+ * SD_BENCHMARK.H - SD card throughput benchmark over sdSPI
+ * Sequential write/read at block sizes 512 B..64 KB and random 4 KB
+ * read/write IOPS, repeated at several SPI clocks. DMA-capable aligned
+ * buffers, per-operation latency percentiles, temporary file removed
+ */
+
+#ifndef SD_BENCHMARK_H
+#define SD_BENCHMARK_H
+
+#include <Arduino.h>
+#include <SPI.h>
+
+#define SD_BENCH_BLOCK_SIZES 8           // 512, 1K, 2K, 4K, 8K, 16K, 32K, 64K
+#define SD_BENCH_MAX_CLOCKS 4
+#define SD_BENCH_RANDOM_BLOCK 4096
+#define SD_BENCH_FILE "/diag_bench.bin"
+
+struct SDLatencyStats {
+  uint32_t ops = 0;
+  uint32_t p50Us = 0;
+  uint32_t p95Us = 0;
+  uint32_t p99Us = 0;
+  uint32_t maxUs = 0;
+};
+
+struct SDSequentialResult {
+  uint32_t blockSize = 0;
+  bool tested = false;
+  float writeMBps = 0.0;
+  float readMBps = 0.0;
+  SDLatencyStats writeLatency;
+  SDLatencyStats readLatency;
+};
+
+struct SDClockResult {
+  uint32_t clockKHz = 0;
+  bool mounted = false;
+  SDSequentialResult sequential[SD_BENCH_BLOCK_SIZES];
+  float randomReadIops = 0.0;
+  float randomWriteIops = 0.0;
+  SDLatencyStats randomReadLatency;
+  SDLatencyStats randomWriteLatency;
+};
+
+struct SDBenchmarkConfig {
+  uint32_t clocksKHz[SD_BENCH_MAX_CLOCKS] = {0};
+  uint8_t clockCount = 0;
+  uint32_t fileSizeKB = 0;        // Sequential file size per block size
+  uint32_t randomOps = 0;         // Random 4 KB reads (and writes) per clock
+};
+
+struct SDBenchmarkData {
+  bool completed = false;
+  SDBenchmarkConfig config;
+  uint32_t bufferBytes = 0;       // Largest DMA-capable buffer obtained
+  SDClockResult clocks[SD_BENCH_MAX_CLOCKS];
+  bool remounted = false;         // Card mounted again at the default clock
+  unsigned long durationMs = 0;
+};
+
+extern SDBenchmarkData sdBenchmarkData;
+extern SDBenchmarkConfig sdBenchmarkConfig;
+extern String sdBenchmarkTestResult;
+
+// Function declarations
+void resetSDBenchmarkConfig();
+void runSDBenchmark(SPIClass& spi, int csPin);
+
+#endif // SD_BENCHMARK_H
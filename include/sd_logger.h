@@ -0,0 +1,95 @@
+/*
+ * SD_LOGGER.H - Double-buffered background SD data logger
+ * Sampler task (fixed period, never touches the card) fills one of two
+ * RAM buffers with 32-byte binary records (envData, gpsData, heap, RSSI);
+ * writer task appends whole 512-byte sectors, flushes periodically and
+ * rotates files by size or age. With a GPS PPS lock, a time sync record
+ * every SD_LOG_TIME_SYNC_MS anchors the millis() timestamps to UTC.
+ * Decode with tools/sd_log_convert.py
+ */
+
+#ifndef SD_LOGGER_H
+#define SD_LOGGER_H
+
+#include <Arduino.h>
+#include <stddef.h>
+
+#define SD_LOG_MAGIC "ESDL"
+#define SD_LOG_VERSION 2                        // 2: time sync records
+#define SD_LOG_SECTOR_SIZE 512
+#define SD_LOG_HEADER_SIZE SD_LOG_SECTOR_SIZE   // Keeps records sector-aligned in the file
+
+// Record flags
+#define SD_LOG_FLAG_AHT20 0x01
+#define SD_LOG_FLAG_BMP280 0x02
+#define SD_LOG_FLAG_GPS_FIX 0x04
+#define SD_LOG_FLAG_WIFI 0x08
+#define SD_LOG_FLAG_TIME_SYNC 0x80      // SDLogTimeSync, not a sample
+
+// Fixed-point, little endian, 16 records per sector
+struct __attribute__((packed)) SDLogRecord {
+  uint32_t timestampMs;         // millis()
+  int16_t temperatureCenti;     // °C x100, INT16_MIN = n/a
+  uint16_t humidityCenti;       // %RH x100, 0xFFFF = n/a
+  uint32_t pressurePa;          // 0 = n/a
+  int32_t latitudeE7;           // degrees x1e7
+  int32_t longitudeE7;
+  int16_t altitudeDm;           // GPS altitude, decimeters
+  uint8_t satellites;
+  uint8_t flags;                // SD_LOG_FLAG_*
+  uint32_t freeHeap;
+  int8_t rssi;                  // dBm, 0 = not connected
+  uint8_t satellitesUsed;       // GSA, signal quality history
+  uint8_t snrMean;              // dB-Hz over tracked satellites, 0 = none
+  uint8_t snrMax;
+};
+
+// Same size and flags offset as SDLogRecord, interleaved with the samples
+struct __attribute__((packed)) SDLogTimeSync {
+  uint32_t timestampMs;         // millis() of the anchor
+  uint16_t timestampSubUs;      // Microseconds within that millisecond
+  uint16_t reserved0;
+  uint32_t utcSeconds;          // Unix time of the anchor
+  uint32_t utcMicros;
+  int32_t driftPpb;             // Local clock vs GPS, positive = local fast
+  uint16_t reserved1;
+  uint8_t state;                // GPSTimeState
+  uint8_t flags;                // SD_LOG_FLAG_TIME_SYNC
+  uint32_t jitterRmsNs;         // PPS edge jitter
+  uint8_t reserved[4];
+};
+
+static_assert(sizeof(SDLogRecord) == 32, "SDLogRecord must stay 32 bytes");
+static_assert(sizeof(SDLogTimeSync) == sizeof(SDLogRecord), "SDLogTimeSync must match SDLogRecord");
+static_assert(offsetof(SDLogTimeSync, flags) == offsetof(SDLogRecord, flags), "Flags must share one offset");
+static_assert(SD_LOG_SECTOR_SIZE % sizeof(SDLogRecord) == 0, "Records must tile a sector");
+
+struct SDLoggerStatus {
+  bool running = false;
+  uint32_t intervalMs = 0;
+  uint32_t fileIndex = 0;
+  char fileName[24] = "";         // Fixed buffer: updated by the writer task on rotation
+  uint32_t fileBytes = 0;
+  uint32_t recordsLogged = 0;     // Records handed to the writer
+  uint32_t recordsDropped = 0;    // Both buffers busy (writer stalled)
+  uint32_t lateTicks = 0;         // Sampler woke up more than one period late
+  uint32_t buffersWritten = 0;
+  uint32_t bytesWritten = 0;
+  uint32_t writeErrors = 0;
+  uint32_t rotations = 0;
+  uint32_t timeSyncs = 0;         // SDLogTimeSync records written among the samples
+  uint32_t lastWriteMs = 0;       // Duration of the last buffer write
+  uint32_t maxWriteMs = 0;        // Worst SD stall absorbed by the double buffer
+  String error = "";
+};
+
+extern SDLoggerStatus sdLoggerStatus;
+
+// Function declarations
+bool startSDLogger(uint32_t intervalMs, String& error);
+bool stopSDLogger();        // False: tasks still flushing, logger stays running
+void maintainSDLogger();    // Called from loop(): refreshes envData / gpsData for the sampler
+void fillSDLogRecord(SDLogRecord& record);  // Snapshot of the last known values, no bus access
+bool fillSDLogTimeSync(SDLogRecord& slot);  // False without PPS-disciplined time
+
+#endif // SD_LOGGER_H
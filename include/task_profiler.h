@@ -0,0 +1,64 @@
+/*
+ * TASK_PROFILER.H - FreeRTOS task CPU share and stack headroom sampler
+ * Periodic uxTaskGetSystemState() snapshots (from loop()): per-task CPU %
+ * of its core over the last interval and a sliding window, idle share
+ * per core, and the lowest stack high-water mark seen for every task,
+ * including short-lived async test tasks that have since exited
+ */
+
+#ifndef TASK_PROFILER_H
+#define TASK_PROFILER_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#define TASK_PROFILER_MAX_TASKS 40
+#define TASK_PROFILER_NAME_LEN 16
+#define TASK_PROFILER_WINDOW 10             // Samples in the sliding window
+#define TASK_PROFILER_ANY_CORE -1
+
+struct TaskProfileEntry {
+  TaskHandle_t handle = nullptr;
+  char name[TASK_PROFILER_NAME_LEN] = "";
+  int8_t core = TASK_PROFILER_ANY_CORE;
+  uint8_t priority = 0;
+  uint8_t state = 0;                  // eTaskState of the last sample
+  bool alive = false;
+  bool idle = false;
+  bool stackWarning = false;          // Headroom fell below TASK_STACK_WARN_BYTES
+  uint32_t stackMinBytes = UINT32_MAX;
+  uint32_t lastRunTime = 0;
+  uint32_t windowRunTime[TASK_PROFILER_WINDOW] = {};
+  float cpuLast = 0.0;                // % of one core, last interval
+  float cpuWindow = 0.0;              // % of one core, sliding window
+};
+
+struct TaskProfilerCore {
+  float idleLast = 0.0;
+  float idleWindow = 0.0;
+};
+
+struct TaskProfilerData {
+  bool available = false;             // configUSE_TRACE_FACILITY
+  bool runTimeStats = false;          // configGENERATE_RUN_TIME_STATS
+  uint32_t samples = 0;
+  uint32_t lastSampleMs = 0;
+  uint32_t windowElapsed = 0;         // Run-time counter units covered by the window
+  uint8_t windowFill = 0;
+  uint16_t liveTasks = 0;
+  uint16_t overflows = 0;             // Snapshots skipped: more tasks than TASK_PROFILER_MAX_TASKS
+  uint8_t warnings = 0;
+  TaskProfilerCore cores[2];
+  TaskProfileEntry tasks[TASK_PROFILER_MAX_TASKS];
+  uint8_t taskCount = 0;
+};
+
+extern TaskProfilerData taskProfilerData;
+
+// Function declarations
+void maintainTaskProfiler();        // Called from loop(): one snapshot per TASK_PROFILER_INTERVAL_MS
+void resetTaskProfiler();
+const char* taskStateName(uint8_t state);
+
+#endif // TASK_PROFILER_H
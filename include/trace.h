@@ -0,0 +1,84 @@
+/*
+ * TRACE.H - Per-core binary trace rings and debug log macros
+ * TRACE_BEGIN/END/INSTANT record 16-byte events (cycle count, task, interned
+ * name ID, argument) into the ring of the calling core. Slots are reserved
+ * with an atomic increment, so tasks and ISRs never take a lock; names are
+ * interned once per call site. Dump at /api/trace, convert to Chrome
+ * trace_event JSON with tools/trace_to_chrome.py
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <Arduino.h>
+#include <esp_attr.h>
+#include "config.h"
+
+#define TRACE_EVENT_BEGIN 'B'
+#define TRACE_EVENT_END 'E'
+#define TRACE_EVENT_INSTANT 'i'
+#define TRACE_EVENT_SYNC 's'             // Anchor for cycle -> esp_timer conversion
+
+#define TRACE_NAME_NONE 0
+#define TRACE_NAME_OVERFLOW 1            // Name table full
+
+static_assert((TRACE_RING_EVENTS & (TRACE_RING_EVENTS - 1)) == 0, "TRACE_RING_EVENTS must be a power of two");
+
+struct TraceEvent {
+  uint32_t cycles;                       // CPU cycle counter of the ring's core
+  uint32_t task;                         // TaskHandle_t, 0 = ISR
+  uint32_t arg;
+  uint16_t name;
+  uint8_t type;                          // TRACE_EVENT_*
+  uint8_t reserved;
+};
+
+static_assert(sizeof(TraceEvent) == 16, "TraceEvent must stay 16 bytes");
+
+struct TraceRing {
+  TraceEvent events[TRACE_RING_EVENTS];
+  volatile uint32_t head;                // Total events ever reserved
+  uint32_t syncCycles;                   // Last traceSync() on this core
+  uint64_t syncUs;
+};
+
+// Function declarations
+void traceBegin();                       // Starts the core 0 sync timer
+uint16_t IRAM_ATTR traceIntern(const char* name);
+void IRAM_ATTR traceRecord(uint8_t type, uint16_t name, uint32_t arg);
+void traceSync();                        // Anchors the calling core's cycle counter to esp_timer
+void maintainTrace();                    // Called from loop(): traceSync() every TRACE_SYNC_INTERVAL_MS
+void traceSetActive(bool active);
+bool traceIsActive();
+void traceClear();
+uint8_t traceRingCount();
+const TraceRing& traceRingForCore(uint8_t core);
+uint16_t traceNameCount();
+const char* traceName(uint16_t id);
+
+#if ENABLE_TRACE
+  // Name must outlive the trace (string literal); interned by pointer on first use
+  #define TRACE_EVENT(type, name, arg) do { \
+    static uint16_t traceNameId = TRACE_NAME_NONE; \
+    if (traceNameId == TRACE_NAME_NONE) traceNameId = traceIntern(name); \
+    traceRecord((type), traceNameId, (uint32_t)(arg)); \
+  } while (0)
+#else
+  #define TRACE_EVENT(type, name, arg) do { } while (0)
+#endif
+
+#define TRACE_BEGIN(name) TRACE_EVENT(TRACE_EVENT_BEGIN, name, 0)
+#define TRACE_END(name) TRACE_EVENT(TRACE_EVENT_END, name, 0)
+#define TRACE_INSTANT(name, arg) TRACE_EVENT(TRACE_EVENT_INSTANT, name, arg)
+
+// Verbose serial logs, compiled out unless DIAGNOSTIC_DEBUG is set in config.h
+#if DIAGNOSTIC_DEBUG
+  #define DIAG_DEBUGF(...) Serial.printf(__VA_ARGS__)
+  #define DIAG_DEBUGLN(text) Serial.println(text)
+#else
+  // Arguments still type-checked (and variables still used), then dropped
+  #define DIAG_DEBUGF(...) do { if (0) Serial.printf(__VA_ARGS__); } while (0)
+  #define DIAG_DEBUGLN(text) do { if (0) Serial.println(text); } while (0)
+#endif
+
+#endif // TRACE_H
@@ -0,0 +1,78 @@
+/*
+ * UBX_PROTOCOL.H - u-blox UBX binary protocol: streaming frame decoder and
+ * frame builder. Frames are B5 62 | class | id | length (LE) | payload |
+ * CK_A CK_B (8-bit Fletcher over class..payload). The decoder takes one byte
+ * at a time straight from the UART, keeps a single fixed payload buffer and
+ * resynchronizes on the next sync pair after a bad checksum
+ */
+
+#ifndef UBX_PROTOCOL_H
+#define UBX_PROTOCOL_H
+
+#include <Arduino.h>
+
+#define UBX_SYNC_CHAR_1 0xB5
+#define UBX_SYNC_CHAR_2 0x62
+#define UBX_FRAME_OVERHEAD 8                // Sync (2), class, id, length (2), checksum (2)
+#define UBX_MAX_PAYLOAD (8 + 12 * 64)       // NAV-SAT with 64 satellites; longer frames are skipped
+
+#define UBX_CLASS_NAV 0x01
+#define UBX_CLASS_ACK 0x05
+#define UBX_CLASS_CFG 0x06
+#define UBX_CLASS_NMEA 0xF0
+
+#define UBX_NAV_DOP 0x04
+#define UBX_NAV_PVT 0x07
+#define UBX_NAV_SAT 0x35
+#define UBX_ACK_NAK 0x00
+#define UBX_ACK_ACK 0x01
+#define UBX_CFG_PRT 0x00
+#define UBX_CFG_MSG 0x01
+#define UBX_CFG_RATE 0x08
+
+#define UBX_NAV_DOP_LENGTH 18
+#define UBX_NAV_PVT_LENGTH 92
+#define UBX_NAV_SAT_HEADER 8
+#define UBX_NAV_SAT_BLOCK 12
+
+enum UBXPushResult : uint8_t {
+  UBX_PUSH_IDLE = 0,                        // Byte is not part of a frame (NMEA text)
+  UBX_PUSH_BUSY,                            // Byte consumed, frame not complete
+  UBX_PUSH_FRAME,                           // Valid frame in cls/id/length/payload
+  UBX_PUSH_ERROR                            // Frame dropped (checksum)
+};
+
+struct UBXDecoder {
+  uint8_t cls = 0;
+  uint8_t id = 0;
+  uint16_t length = 0;
+  uint8_t payload[UBX_MAX_PAYLOAD];
+  uint32_t frames = 0;
+  uint32_t checksumErrors = 0;
+  uint32_t oversizeFrames = 0;              // Skipped without decoding
+
+  UBXPushResult push(uint8_t byte);
+  bool inFrame() const { return state != 0; }
+  void reset() { state = 0; }
+
+private:
+  uint8_t state = 0;
+  uint32_t index = 0;
+  uint8_t ckA = 0;
+  uint8_t ckB = 0;
+};
+
+// Little-endian field readers
+inline uint16_t ubxU2(const uint8_t* p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+inline int16_t ubxI2(const uint8_t* p) { return (int16_t)ubxU2(p); }
+inline uint32_t ubxU4(const uint8_t* p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+inline int32_t ubxI4(const uint8_t* p) { return (int32_t)ubxU4(p); }
+
+// Function declarations
+void ubxChecksum(const uint8_t* data, size_t length, uint8_t& ckA, uint8_t& ckB);
+// Writes a complete frame to `out` (length + UBX_FRAME_OVERHEAD bytes) and returns its size
+size_t ubxBuildFrame(uint8_t cls, uint8_t id, const uint8_t* payload, uint16_t length, uint8_t* out);
+
+#endif // UBX_PROTOCOL_H
@@ -9,12 +9,13 @@
 #include <pgmspace.h>
 
 #include "languages.h"
+#include "http_metrics.h"
 
 // [OPT-003] Extern declarations with clear organization
 // Core infrastructure
 extern const char* DIAGNOSTIC_VERSION_STR;
 extern const char* MDNS_HOSTNAME_STR;
-extern WebServer server;
+extern DiagnosticWebServer server;
 extern DiagnosticInfo diagnosticData;
 extern const char* const DIAGNOSTIC_SECURE_SCHEME;
 extern const char* const DIAGNOSTIC_LEGACY_SCHEME;
@@ -104,16 +105,37 @@ var host=link.getAttribute('data-access-host');var secure=link.getAttribute('dat
 continue;}
 var useSecure=shouldPreferSecureAccess(host,secure,legacy);var scheme=useSecure?secure:legacy;link.href=scheme+host;link.classList.remove('disabled');link.setAttribute('aria-disabled','false');if(labelNode){if(!useSecure&&legacyLabel){labelNode.textContent=legacyLabel;}else{labelNode.textContent=scheme+labelHost;}}}}
 document.addEventListener('DOMContentLoaded',()=>{fetchTranslations(currentLang).then(t=>{setTranslationsCache(t);updateInterfaceTexts();}).catch(err=>{console.warn('Translations unavailable',err);setTimeout(()=>refetchTranslations().catch(retryErr=>console.error('Translations retry failed',retryErr)),1000);});initNavigation();applyAccessLinkScheme();loadAllData();startAutoUpdate();});function startAutoUpdate(){if(updateTimer)clearInterval(updateTimer);updateTimer=setInterval(()=>{if(isConnected)updateLiveData();},UPDATE_INTERVAL);}
-async function loadAllData(){showUpdateIndicator();try{await Promise.all([updateSystemInfo(),updateMemoryInfo(),updateWiFiInfo(),updatePeripheralsInfo()]);isConnected=true;updateStatusIndicator(true);}catch(error){console.error('Erreur:',error);isConnected=false;updateStatusIndicator(false);}
+const DASHBOARD_FIELDS='system,chip,memory,wifi,gpio,leds,screens';const DASHBOARD_REUSE_MS=5000;let dashboardRequest=null;let dashboardRequestTime=0;function loadDashboard(fields){const now=Date.now();if(dashboardRequest&&now-dashboardRequestTime<DASHBOARD_REUSE_MS){return dashboardRequest;}
+const request=fetchApi('/api/dashboard?fields='+fields).then(r=>{if(!r.ok)throw new Error('dashboard fetch failed');return readApiResponse(r);});if(fields===DASHBOARD_FIELDS){dashboardRequest=request;dashboardRequestTime=now;request.catch(()=>{dashboardRequest=null;});}
+return request;}
+async function loadAllData(){showUpdateIndicator();try{const d=await loadDashboard(DASHBOARD_FIELDS);updateSystemInfo(d.system);isConnected=true;updateStatusIndicator(true);}catch(error){console.error('Erreur:',error);isConnected=false;updateStatusIndicator(false);}
 hideUpdateIndicator();}
-async function updateLiveData(){try{const response=await fetch('/api/status');const data=await response.json();updateRealtimeValues(data);isConnected=true;updateStatusIndicator(true);}catch(error){console.error('Erreur:',error);isConnected=false;updateStatusIndicator(false);}}
-async function updateSystemInfo(){const r=await fetch('/api/system-info');const d=await r.json();const chipModelEl=document.getElementById('chipModel');if(chipModelEl){chipModelEl.textContent=d.chipModel||'';}
+function decodeCbor(buffer){const view=new DataView(buffer);const bytes=new Uint8Array(buffer);const utf8=new TextDecoder();let pos=0;const BREAK={};function length(info){if(info<24)return info;if(info===24)return view.getUint8(pos++);if(info===25){pos+=2;return view.getUint16(pos-2);}
+if(info===26){pos+=4;return view.getUint32(pos-4);}
+if(info===27){pos+=8;return view.getUint32(pos-8)*4294967296+view.getUint32(pos-4);}
+if(info===31)return-1;throw new Error('CBOR: invalid length');}
+function single(value){for(let p=1;p<10;p++){const candidate=parseFloat(value.toPrecision(p));if(Math.fround(candidate)===value)return candidate;}
+return value;}
+function half(bits){const exponent=(bits>>10)&0x1f;const mantissa=bits&0x3ff;const value=exponent===0?mantissa*Math.pow(2,-24):exponent===31?(mantissa?NaN:Infinity):(1024+mantissa)*Math.pow(2,exponent-25);return bits&0x8000?-value:value;}
+function item(){const initial=bytes[pos++];if(initial===undefined)throw new Error('CBOR: truncated');if(initial===0xff)return BREAK;const major=initial>>5;const info=initial&0x1f;if(major===7){if(info===20)return false;if(info===21)return true;if(info===22||info===23)return null;if(info===25){pos+=2;return half(view.getUint16(pos-2));}
+if(info===26){pos+=4;return single(view.getFloat32(pos-4));}
+if(info===27){pos+=8;return view.getFloat64(pos-8);}
+throw new Error('CBOR: unsupported simple value');}
+const n=length(info);if(major===0)return n;if(major===1)return-1-n;if(major===2||major===3){const slice=bytes.subarray(pos,pos+n);pos+=n;return major===3?utf8.decode(slice):slice;}
+if(major===4){const list=[];while(n<0||list.length<n){const v=item();if(v===BREAK)break;list.push(v);}
+return list;}
+if(major===5){const obj={};for(let i=0;n<0||i<n;i++){const key=item();if(key===BREAK)break;obj[key]=item();}
+return obj;}
+throw new Error('CBOR: unsupported major type '+major);}
+return item();}
+async function readApiResponse(r){const type=r.headers.get('Content-Type')||'';if(type.indexOf('application/cbor')===0){return decodeCbor(await r.arrayBuffer());}
+return r.json();}
+function fetchApi(url){return fetch(url,{headers:{'Accept':'application/cbor, application/json'}});}
+async function updateLiveData(){try{const response=await fetchApi('/api/status');const data=await readApiResponse(response);updateRealtimeValues(data);isConnected=true;updateStatusIndicator(true);}catch(error){console.error('Erreur:',error);isConnected=false;updateStatusIndicator(false);}}
+function updateSystemInfo(d){const chipModelEl=document.getElementById('chipModel');if(chipModelEl){chipModelEl.textContent=d.chipModel||'';}
 const ipLabel=document.getElementById('ipAddressText');const ipLink=document.getElementById('ipAddressLink');const hasIp=d.ipAddress&&d.ipAddress.length;const secureScheme=(ipLink&&ipLink.getAttribute('data-secure'))||'https://';const legacyScheme=(ipLink&&ipLink.getAttribute('data-legacy'))||'http://';if(ipLabel){if(hasIp){clearTranslationAttributes(ipLabel);ipLabel.textContent=legacyScheme+d.ipAddress;}else{ipLabel.setAttribute('data-i18n','ip_unavailable');translateElement(ipLabel,getCurrentTranslations());}}
 if(ipLink){if(hasIp){ipLink.href=legacyScheme+d.ipAddress;ipLink.setAttribute('data-access-host',d.ipAddress);ipLink.setAttribute('data-access-label',d.ipAddress);ipLink.setAttribute('data-legacy-label',legacyScheme+d.ipAddress);ipLink.setAttribute('aria-disabled','false');ipLink.classList.remove('disabled');}else{ipLink.href='#';ipLink.setAttribute('data-access-host','');ipLink.setAttribute('data-access-label','');ipLink.setAttribute('data-legacy-label','');ipLink.setAttribute('aria-disabled','true');ipLink.classList.add('disabled');}}
 applyAccessLinkScheme();}
-async function updateMemoryInfo(){await fetch('/api/memory');}
-async function updateWiFiInfo(){await fetch('/api/wifi-info');}
-async function updatePeripheralsInfo(){await fetch('/api/peripherals');}
 function showTab(tabName,btn){var contents=document.querySelectorAll('.tab-content');for(var i=0;i<contents.length;i++){contents[i].classList.remove('active');}
 var tab=document.getElementById(tabName);if(tab){tab.classList.add('active');}else{loadTab(tabName);}
 setActiveTabButton(tabName,btn);}
@@ -128,7 +150,7 @@ for(var n=0;n<navs.length;n++){(function(nav){nav.addEventListener('click',funct
 var active=document.querySelector('.nav-btn.active');if(!active){var list=document.querySelectorAll('.nav-btn');if(list.length>0){active=list[0];}}
 if(active){showTab(active.getAttribute('data-tab'),active);}else{showTab('overview');}}
 async function loadTab(tabName){const c=document.getElementById('tabContainer');let tab=document.getElementById(tabName);if(!tab){tab=document.createElement('div');tab.id=tabName;tab.className='tab-content';c.appendChild(tab);}
-tab.innerHTML='<div class="section"><div class="loading"></div><p style="text-align:center" data-i18n="loading">'+tr('loading')+'</p></div>';tab.classList.add('active');try{if(tabName==='overview'){const r=await fetch('/api/overview');const d=await r.json();tab.innerHTML=buildOverview(d);}else if(tabName==='display-signal'){const leds=await fetch('/api/leds-info');const screens=await fetch('/api/screens-info');const ld=await leds.json();const sd=await screens.json();tab.innerHTML=buildDisplaySignal(ld,sd);}else if(tabName==='sensors'){tab.innerHTML=buildSensors();loadEnvironmentalData();}else if(tabName==='input-devices'){tab.innerHTML=buildInputDevices();}else if(tabName==='memory'){tab.innerHTML=buildMemory();}else if(tabName==='hardware-tests'){tab.innerHTML=buildHardwareTests();}else if(tabName==='wireless'){tab.innerHTML=buildWireless();loadWirelessInfo();}else if(tabName==='benchmark'){tab.innerHTML=buildBenchmark();}else if(tabName==='export'){tab.innerHTML=buildExport();}
+tab.innerHTML='<div class="section"><div class="loading"></div><p style="text-align:center" data-i18n="loading">'+tr('loading')+'</p></div>';tab.classList.add('active');try{if(tabName==='overview'){const d=await loadDashboard(DASHBOARD_FIELDS);tab.innerHTML=buildOverview(d);}else if(tabName==='display-signal'){const d=await loadDashboard('leds,screens');tab.innerHTML=buildDisplaySignal(d.leds,d.screens);}else if(tabName==='sensors'){tab.innerHTML=buildSensors();loadEnvironmentalData();}else if(tabName==='input-devices'){tab.innerHTML=buildInputDevices();}else if(tabName==='memory'){tab.innerHTML=buildMemory();}else if(tabName==='hardware-tests'){tab.innerHTML=buildHardwareTests();}else if(tabName==='wireless'){tab.innerHTML=buildWireless();loadWirelessInfo();}else if(tabName==='benchmark'){tab.innerHTML=buildBenchmark();}else if(tabName==='export'){tab.innerHTML=buildExport();}
 updateInterfaceTexts();}catch(e){tab.innerHTML='<div class="section"><h2 data-i18n="error_label" data-i18n-prefix="❌">'+tr('error_label')+'</h2><p>'+String(e)+'</p></div>';updateInterfaceTexts();}}
 function buildOverview(d){let h='<div class="section"><h2 data-i18n="chip_info" data-i18n-prefix="🔧">'+tr('chip_info')+'</h2><div class="info-grid">';h+='<div class="info-item"><div class="info-label" data-i18n="full_model">'+tr('full_model')+'</div><div class="info-value">'+d.chip.model+' <span data-i18n="revision">'+tr('revision')+'</span> '+d.chip.revision+'</div></div>';const cpuSummary=d.chip.cores+' <span data-i18n="cores">'+tr('cores')+'</span> @ '+d.chip.freq+' MHz';h+='<div class="info-item"><div class="info-label" data-i18n="cpu_cores">'+tr('cpu_cores')+'</div><div class="info-value">'+cpuSummary+'</div></div>';h+='<div class="info-item"><div class="info-label" data-i18n="mac_wifi">'+tr('mac_wifi')+'</div><div class="info-value">'+d.chip.mac+'</div></div>';h+='<div class="info-item"><div class="info-label" data-i18n="uptime">'+tr('uptime')+'</div><div class="info-value" id="uptime">'+formatUptime(d.chip.uptime)+'</div></div>';if(d.chip.temperature!==-999){h+='<div class="info-item"><div class="info-label" data-i18n="cpu_temp">'+tr('cpu_temp')+'</div><div class="info-value" id="temperature">'+d.chip.temperature.toFixed(1)+' °C</div></div>';}
 h+='</div></div>';h+='<div class="section"><h2 data-i18n="memory_details" data-i18n-prefix="💾">'+tr('memory_details')+'</h2>';h+='<h3 data-i18n="flash_memory" data-i18n-prefix="📦">'+tr('flash_memory')+'</h3><div class="info-grid">';h+='<div class="info-item"><div class="info-label" data-i18n="real_size">'+tr('real_size')+'</div><div class="info-value">'+(d.memory.flash.real/1048576).toFixed(2)+' MB</div></div>';h+='<div class="info-item"><div class="info-label" data-i18n="flash_type">'+tr('flash_type')+'</div><div class="info-value">'+d.memory.flash.type+'</div></div>';h+='<div class="info-item"><div class="info-label" data-i18n="flash_speed">'+tr('flash_speed')+'</div><div class="info-value">'+d.memory.flash.speed+' MHz</div></div>';h+='</div>';h+='<h3 data-i18n="internal_sram" data-i18n-prefix="🧠">'+tr('internal_sram')+'</h3><div class="info-grid">';h+='<div class="info-item"><div class="info-label" data-i18n="total_size">'+tr('total_size')+'</div><div class="info-value" id="sram-total">'+(d.memory.sram.total/1024).toFixed(2)+' KB</div></div>';h+='<div class="info-item"><div class="info-label" data-i18n="free">'+tr('free')+'</div><div class="info-value" id="sram-free">'+(d.memory.sram.free/1024).toFixed(2)+' KB</div></div>';h+='<div class="info-item"><div class="info-label" data-i18n="used">'+tr('used')+'</div><div class="info-value" id="sram-used">'+(d.memory.sram.used/1024).toFixed(2)+' KB</div></div>';h+='<div class="info-item"><div class="info-label" data-i18n="memory_fragmentation">'+tr('memory_fragmentation')+'</div><div class="info-value" id="fragmentation">'+d.memory.fragmentation.toFixed(1)+'%</div></div>';h+='</div>';const sramPct=((d.memory.sram.used/d.memory.sram.total)*100).toFixed(1);h+='<div class="progress-bar"><div class="progress-fill" id="sram-progress" style="width:'+sramPct+'%">'+sramPct+'%</div></div>';if(d.memory.psram.total>0){h+='<h3 data-i18n="psram_external" data-i18n-prefix="📦">'+tr('psram_external')+'</h3><div class="info-grid">';h+='<div class="info-item"><div class="info-label" data-i18n="total_size">'+tr('total_size')+'</div><div class="info-value" id="psram-total">'+(d.memory.psram.total/1048576).toFixed(2)+' MB</div></div>';h+='<div class="info-item"><div class="info-label" data-i18n="free">'+tr('free')+'</div><div class="info-value" id="psram-free">'+(d.memory.psram.free/1048576).toFixed(2)+' MB</div></div>';h+='<div class="info-item"><div class="info-label" data-i18n="used">'+tr('used')+'</div><div class="info-value" id="psram-used">'+(d.memory.psram.used/1048576).toFixed(2)+' MB</div></div>';h+='</div>';const psramPct=((d.memory.psram.used/d.memory.psram.total)*100).toFixed(1);h+='<div class="progress-bar"><div class="progress-fill" id="psram-progress" style="width:'+psramPct+'%">'+psramPct+'%</div></div>';}
@@ -140,7 +162,7 @@ h+='</div></div>';if(d.tft){h+='<div class="section"><h2 data-i18n="tft_screen"
 h+='</select><br>';h+=' <span style="margin-left:15px">Driver:</span> <select id="tftDriver" style="width:100px;padding:5px"><option value="ILI9341"'+(d.tft.driver==='ILI9341'?' selected':'')+'>ILI9341</option><option value="ST7789"'+(d.tft.driver==='ST7789'?' selected':'')+'>ST7789</option></select><br>';h+='<div style="margin-top:15px;padding:10px;background:#f0f8ff;border-radius:5px">';h+='<strong data-i18n="tft_brightness">'+tr('tft_brightness')+'</strong><br>';h+='<input type="range" id="tftBrightnessSlider" min="0" max="255" value="255" style="width:80%;margin:10px 0" oninput="updateBrightnessValue(this.value)" onchange="setTFTBrightnessLevel(this.value)">';h+='<span id="tftBrightnessValue" style="margin-left:10px;font-weight:bold">255</span> / 255<br>';h+='<button class="btn btn-sm" onclick="setTFTBrightnessLevel(0)" style="margin:2px">OFF</button> ';h+='<button class="btn btn-sm" onclick="setTFTBrightnessLevel(64)" style="margin:2px">25%</button> ';h+='<button class="btn btn-sm" onclick="setTFTBrightnessLevel(128)" style="margin:2px">50%</button> ';h+='<button class="btn btn-sm" onclick="setTFTBrightnessLevel(192)" style="margin:2px">75%</button> ';h+='<button class="btn btn-sm" onclick="setTFTBrightnessLevel(255)" style="margin:2px">100%</button>';h+='</div>';h+='<button class="btn btn-primary" data-i18n="apply_config" data-i18n-prefix="⚙️" onclick="configTFT()">'+tr('apply_config')+'</button>';h+='</div>';if(hasTft){h+='<div style="margin-top:15px"><button class="btn btn-primary" data-i18n="full_test" data-i18n-prefix="🧪" onclick="testTFT()">'+tr('full_test')+'</button> <button class="btn btn-success" data-i18n="boot_screen" data-i18n-prefix="🏠" onclick="tftBoot()">'+tr('boot_screen')+'</button></div>';h+='<div class="tft-step-grid" style="margin-top:15px;display:grid;grid-template-columns:repeat(auto-fit,minmax(180px,1fr));gap:10px">';h+='<button class="btn btn-secondary" data-i18n="tft_step_boot" data-i18n-prefix="🏁" onclick="tftStep(\'boot\')">'+tr('tft_step_boot')+'</button>';h+='<button class="btn btn-secondary" data-i18n="tft_step_colors" data-i18n-prefix="🎨" onclick="tftStep(\'colors\')">'+tr('tft_step_colors')+'</button>';h+='<button class="btn btn-secondary" data-i18n="tft_step_shapes" data-i18n-prefix="🟦" onclick="tftStep(\'shapes\')">'+tr('tft_step_shapes')+'</button>';h+='<button class="btn btn-secondary" data-i18n="tft_step_text" data-i18n-prefix="🔤" onclick="tftStep(\'text\')">'+tr('tft_step_text')+'</button>';h+='<button class="btn btn-secondary" data-i18n="tft_step_lines" data-i18n-prefix="📏" onclick="tftStep(\'lines\')">'+tr('tft_step_lines')+'</button>';h+='<button class="btn btn-secondary" data-i18n="tft_step_animation" data-i18n-prefix="[SQ]" onclick="tftStep(\'animation\')">'+tr('tft_step_animation')+'</button>';h+='<button class="btn btn-secondary" data-i18n="tft_step_progress" data-i18n-prefix="📊" onclick="tftStep(\'progress\')">'+tr('tft_step_progress')+'</button>';h+='<button class="btn btn-secondary" data-i18n="tft_step_final" data-i18n-prefix="[OK]" onclick="tftStep(\'final\')">'+tr('tft_step_final')+'</button>';h+='</div>';}else{h+='<p class="status-live error" data-i18n="no_detected">'+tr('no_detected')+'</p>';h+='<p style="margin-top:10px;color:#555" data-i18n="check_wiring">'+tr('check_wiring')+'</p>';}
 h+='</div></div>';}
 return h;}
-function buildTests(){let h='';h+='<div class="section"><h2 data-i18n="adc_test" data-i18n-prefix="📊">'+tr('adc_test')+'</h2>';h+='<p data-i18n="adc_desc">'+tr('adc_desc')+'</p>';h+='<div style="text-align:center;margin:20px 0"><button class="btn btn-primary" data-i18n="start_adc_test" data-i18n-prefix="▶️" onclick="testADC()">'+tr('start_adc_test')+'</button></div>';h+='<div id="adc-status" class="status-live" data-i18n="click_to_test">'+tr('click_to_test')+'</div>';h+='<div id="adc-results" class="info-grid"></div></div>';h+='<div class="section"><h2 data-i18n="pwm_test" data-i18n-prefix="🎚️">'+tr('pwm_test')+'</h2>';h+='<p data-i18n="pwm_test_desc">'+tr('pwm_test_desc')+'</p>';h+='<div style="text-align:center;margin:20px 0"><button class="btn btn-primary" data-i18n="start_pwm_test" data-i18n-prefix="🎛️" onclick="runPWMTest()">'+tr('start_pwm_test')+'</button></div>';h+='<div id="pwm-status" class="status-live" data-i18n="click_to_test">'+tr('click_to_test')+'</div></div>';h+='<div class="section"><h2 data-i18n="spi_scan" data-i18n-prefix="🧰">'+tr('spi_scan')+'</h2>';h+='<p data-i18n="spi_scan_desc">'+tr('spi_scan_desc')+'</p>';h+='<div style="text-align:center;margin:20px 0"><button class="btn btn-info" data-i18n="start_spi_scan" data-i18n-prefix="🔍" onclick="runSPIScan()">'+tr('start_spi_scan')+'</button></div>';h+='<div id="spi-status" class="status-live" data-i18n="click_to_scan">'+tr('click_to_scan')+'</div>';h+='<div id="spi-results" class="info-grid"></div></div>';h+='<div class="section"><h2 data-i18n="memory_stress" data-i18n-prefix="🔥">'+tr('memory_stress')+'</h2>';h+='<p data-i18n="stress_desc">'+tr('stress_desc')+'</p>';h+='<div style="text-align:center;margin:20px 0"><button class="btn btn-danger" data-i18n="start_stress" data-i18n-prefix="🚀" onclick="runStressTest()">'+tr('start_stress')+'</button></div>';h+='<p style="color:#dc3545;font-weight:bold;text-align:center" data-i18n="stress_warning" data-i18n-prefix="⚠️">'+tr('stress_warning')+'</p>';h+='<div id="stress-status" class="status-live" data-i18n="not_tested">'+tr('not_tested')+'</div>';h+='<div id="stress-results" class="info-grid"></div></div>';return h;}
+function buildTests(){let h='';h+='<div class="section"><h2 data-i18n="adc_test" data-i18n-prefix="📊">'+tr('adc_test')+'</h2>';h+='<p data-i18n="adc_desc">'+tr('adc_desc')+'</p>';h+='<div style="text-align:center;margin:20px 0"><button class="btn btn-primary" data-i18n="start_adc_test" data-i18n-prefix="▶️" onclick="testADC()">'+tr('start_adc_test')+'</button></div>';h+='<div id="adc-status" class="status-live" data-i18n="click_to_test">'+tr('click_to_test')+'</div>';h+='<div id="adc-results" class="info-grid"></div></div>';h+='<div class="section"><h2 data-i18n="adc_continuous" data-i18n-prefix="📈">'+tr('adc_continuous')+'</h2>';h+='<p data-i18n="adc_continuous_desc">'+tr('adc_continuous_desc')+'</p>';h+='<div style="text-align:center;margin:20px 0">';h+='<span data-i18n="adc_pins">'+tr('adc_pins')+'</span>: <input type="text" id="adc-stream-pins" value="" placeholder="4,5" style="width:100px;padding:5px;margin:5px;border:1px solid #ccc;border-radius:5px"> ';h+='<span data-i18n="adc_rate">'+tr('adc_rate')+'</span>: <input type="number" id="adc-stream-rate" value="20000" min="1000" max="80000" step="1000" style="width:100px;padding:5px;margin:5px;border:1px solid #ccc;border-radius:5px"> ';h+='<button id="adc-stream-btn" class="btn btn-primary" data-i18n="start_stream" data-i18n-prefix="▶️" onclick="toggleADCStream()">'+tr('start_stream')+'</button></div>';h+='<div id="adc-stream-status" class="status-live" data-i18n="click_to_test">'+tr('click_to_test')+'</div>';h+='<div id="adc-stream-results" class="info-grid"></div>';h+='<canvas id="adc-spectrum" width="512" height="120" style="width:100%;max-width:640px;display:block;margin:10px auto;background:#f8f9fa;border-radius:5px"></canvas></div>';h+='<div class="section"><h2 data-i18n="pwm_test" data-i18n-prefix="🎚️">'+tr('pwm_test')+'</h2>';h+='<p data-i18n="pwm_test_desc">'+tr('pwm_test_desc')+'</p>';h+='<div style="text-align:center;margin:20px 0"><button class="btn btn-primary" data-i18n="start_pwm_test" data-i18n-prefix="🎛️" onclick="runPWMTest()">'+tr('start_pwm_test')+'</button></div>';h+='<div id="pwm-status" class="status-live" data-i18n="click_to_test">'+tr('click_to_test')+'</div></div>';h+='<div class="section"><h2 data-i18n="spi_scan" data-i18n-prefix="🧰">'+tr('spi_scan')+'</h2>';h+='<p data-i18n="spi_scan_desc">'+tr('spi_scan_desc')+'</p>';h+='<div style="text-align:center;margin:20px 0"><button class="btn btn-info" data-i18n="start_spi_scan" data-i18n-prefix="🔍" onclick="runSPIScan()">'+tr('start_spi_scan')+'</button></div>';h+='<div id="spi-status" class="status-live" data-i18n="click_to_scan">'+tr('click_to_scan')+'</div>';h+='<div id="spi-results" class="info-grid"></div></div>';h+='<div class="section"><h2 data-i18n="memory_stress" data-i18n-prefix="🔥">'+tr('memory_stress')+'</h2>';h+='<p data-i18n="stress_desc">'+tr('stress_desc')+'</p>';h+='<div style="text-align:center;margin:20px 0"><button class="btn btn-danger" data-i18n="start_stress" data-i18n-prefix="🚀" onclick="runStressTest()">'+tr('start_stress')+'</button></div>';h+='<p style="color:#dc3545;font-weight:bold;text-align:center" data-i18n="stress_warning" data-i18n-prefix="⚠️">'+tr('stress_warning')+'</p>';h+='<div id="stress-status" class="status-live" data-i18n="not_tested">'+tr('not_tested')+'</div>';h+='<div id="stress-results" class="info-grid"></div></div>';return h;}
 function buildGpio(){let h='<div class="section"><h2 data-i18n="gpio_test" data-i18n-prefix="🔌">'+tr('gpio_test')+'</h2>';h+='<p data-i18n="gpio_desc">'+tr('gpio_desc')+'</p>';h+='<div style="text-align:center;margin:20px 0"><button class="btn btn-primary" data-i18n="test_all_gpio" data-i18n-prefix="🧪" onclick="testAllGPIO()">'+tr('test_all_gpio')+'</button></div>';h+='<div id="gpio-status" class="status-live" data-i18n="click_to_test">'+tr('click_to_test')+'</div>';h+='<p style="margin-top:10px;color:#555" data-i18n="gpio_warning">'+tr('gpio_warning')+'</p>';h+='<div id="gpio-results" class="gpio-grid"></div></div>';return h;}
 function buildWireless(){let h='<div class="section"><h2 data-i18n="wifi_scanner" data-i18n-prefix="📡">'+tr('wifi_scanner')+'</h2><p data-i18n="wireless_intro">'+tr('wireless_intro')+'</p>';h+='<div class="info-grid" id="current-wifi-info">';h+='<div class="info-item"><div class="info-label" data-i18n="wifi_status">'+tr('wifi_status')+'</div><div class="info-value" id="wifi-connected">-</div></div>';h+='<div class="info-item"><div class="info-label" data-i18n="wifi_ssid">'+tr('wifi_ssid')+'</div><div class="info-value" id="wifi-current-ssid">-</div></div>';h+='<div class="info-item"><div class="info-label" data-i18n="ip_address">'+tr('ip_address')+'</div><div class="info-value" id="wifi-ip">-</div></div>';h+='<div class="info-item"><div class="info-label" data-i18n="gateway">'+tr('gateway')+'</div><div class="info-value" id="wifi-gateway">-</div></div>';h+='<div class="info-item"><div class="info-label" data-i18n="dns_server">'+tr('dns_server')+'</div><div class="info-value" id="wifi-dns">-</div></div>';h+='<div class="info-item"><div class="info-label" data-i18n="wifi_rssi">'+tr('wifi_rssi')+'</div><div class="info-value" id="wifi-rssi">-</div></div>';h+='</div>';h+='<p data-i18n="wifi_desc">'+tr('wifi_desc')+'</p>';h+='<div style="text-align:center;margin:20px 0"><button class="btn btn-primary" data-i18n="scan_networks" data-i18n-prefix="🔍" onclick="scanWiFi()">'+tr('scan_networks')+'</button></div>';h+='<div id="wifi-status" class="status-live" data-i18n="click_to_scan">'+tr('click_to_scan')+'</div>';h+='<div id="wifi-results" class="wifi-list"></div></div>';h+='<div class="section"><h2 data-i18n="gps_module" data-i18n-prefix="🛰️">'+tr('gps_module')+'</h2><p data-i18n="gps_module_desc">'+tr('gps_module_desc')+'</p>';h+='<div class="card"><div class="info-grid" id="gps-info">';h+='<div class="info-item"><div class="info-label" data-i18n="gps_status">'+tr('gps_status')+'</div><div class="info-value" id="gps-status-value">-</div></div>';h+='<div class="info-item"><div class="info-label" data-i18n="gps_latitude">'+tr('gps_latitude')+'</div><div class="info-value" id="gps-latitude">-</div></div>';h+='<div class="info-item"><div class="info-label" data-i18n="gps_longitude">'+tr('gps_longitude')+'</div><div class="info-value" id="gps-longitude">-</div></div>';h+='<div class="info-item"><div class="info-label" data-i18n="gps_altitude">'+tr('gps_altitude')+'</div><div class="info-value" id="gps-altitude">-</div></div>';h+='<div class="info-item"><div class="info-label" data-i18n="gps_satellites">'+tr('gps_satellites')+'</div><div class="info-value" id="gps-satellites">-</div></div>';h+='<div class="info-item"><div class="info-label" data-i18n="gps_hdop">'+tr('gps_hdop')+'</div><div class="info-value" id="gps-hdop">-</div></div>';h+='</div>';h+='<div style="text-align:center;margin:15px 0">';h+='<button class="btn btn-primary" onclick="loadGPSData()" data-i18n="refresh_gps" data-i18n-prefix="🔄">'+tr('refresh_gps')+'</button> ';h+='<button class="btn btn-info" onclick="testGPS()" data-i18n="test_gps" data-i18n-prefix="🧪">'+tr('test_gps')+'</button>';h+='</div><div id="gps-test-status" class="status-live"></div></div></div>';return h;}
 function buildBenchmark(){let h='<div class="section"><h2 data-i18n="performance_bench" data-i18n-prefix="⚡">'+tr('performance_bench')+'</h2>';h+='<p data-i18n="benchmark_desc">'+tr('benchmark_desc')+'</p>';h+='<div style="text-align:center;margin:20px 0"><button class="btn btn-primary" data-i18n="run_benchmarks" data-i18n-prefix="🚀" onclick="runBenchmarks()">'+tr('run_benchmarks')+'</button></div>';h+='<div class="info-grid" id="benchmark-results">';h+='<div class="info-item"><div class="info-label" data-i18n="cpu_benchmark">'+tr('cpu_benchmark')+'</div><div class="info-value" id="cpu-bench" data-i18n="not_tested">'+tr('not_tested')+'</div></div>';h+='<div class="info-item"><div class="info-label" data-i18n="memory_benchmark">'+tr('memory_benchmark')+'</div><div class="info-value" id="mem-bench" data-i18n="not_tested">'+tr('not_tested')+'</div></div>';h+='<div class="info-item"><div class="info-label" data-i18n="cpu_perf_score">'+tr('cpu_perf_score')+'</div><div class="info-value" id="cpu-score" data-i18n="not_tested">'+tr('not_tested')+'</div></div>';h+='<div class="info-item"><div class="info-label" data-i18n="memory_bandwidth">'+tr('memory_bandwidth')+'</div><div class="info-value" id="mem-speed" data-i18n="not_tested">'+tr('not_tested')+'</div></div>';h+='<div class="info-item"><div class="info-label" data-i18n="memory_stress">'+tr('memory_stress')+'</div><div class="info-value" id="mem-stress" data-i18n="not_tested">'+tr('not_tested')+'</div></div>';h+='<div class="info-item"><div class="info-label" data-i18n="stress_duration">'+tr('stress_duration')+'</div><div class="info-value" id="stress-duration" data-i18n="not_tested">'+tr('not_tested')+'</div></div>';h+='<div class="info-item"><div class="info-label" data-i18n="allocations_label">'+tr('allocations_label')+'</div><div class="info-value" id="mem-allocs" data-i18n="not_tested">'+tr('not_tested')+'</div></div>';h+='</div></div>';return h;}
@@ -148,8 +170,8 @@ function buildExport(){let h='<div class="section"><h2 data-i18n="data_export" d
 function buildDisplaySignal(ledsData,screensData){let h='<div class=\"section\"><p data-i18n=\"display_signal_intro\">'+tr('display_signal_intro')+'</p></div>';h+=buildLeds(ledsData);h+=buildScreens(screensData);h+='<div class="section"><h2 data-i18n="rgb_led" data-i18n-prefix="💡">'+tr('rgb_led')+'</h2>';h+='<p data-i18n="rgb_led_desc">'+tr('rgb_led_desc')+'</p>';h+='<div class="card"><div class="info-grid">';h+='<div class="info-item"><div class="info-label" data-i18n="rgb_led_pins">'+tr('rgb_led_pins')+'</div>';h+='<div style="display:flex;gap:5px">';h+='<input type="number" id="rgbPinR" value="'+RGB_LED_PIN_R+'" style="width:60px" placeholder="R"/>';h+='<input type="number" id="rgbPinG" value="'+RGB_LED_PIN_G+'" style="width:60px" placeholder="G"/>';h+='<input type="number" id="rgbPinB" value="'+RGB_LED_PIN_B+'" style="width:60px" placeholder="B"/>';h+='<button class="btn btn-info" onclick="applyRGBConfig()" data-i18n="apply_config">'+tr('apply_config')+'</button></div></div></div>';h+='<div style="text-align:center;margin:15px 0">';h+='<button class="btn btn-primary" onclick="testRGBLed()" data-i18n="test_rgb_led" data-i18n-prefix="▶️">'+tr('test_rgb_led')+'</button> ';h+='<button class="btn btn-danger" onclick="setRGBColor(255,0,0)" data-i18n="red">'+tr('red')+'</button> ';h+='<button class="btn btn-success" onclick="setRGBColor(0,255,0)" data-i18n="green">'+tr('green')+'</button> ';h+='<button class="btn btn-info" onclick="setRGBColor(0,0,255)" data-i18n="blue">'+tr('blue')+'</button> ';h+='<button class="btn" style="background:#fff;color:#000;border:1px solid #ddd" onclick="setRGBColor(255,255,255)" data-i18n="white">'+tr('white')+'</button> ';h+='<button class="btn" style="background:#333" onclick="setRGBColor(0,0,0)" data-i18n="off">'+tr('off')+'</button>';h+='</div><div id="rgb-status" class="status-live" data-i18n="click_to_test">'+tr('click_to_test')+'</div></div></div>';h+='<div class="section"><h2 data-i18n="buzzer" data-i18n-prefix="🔔">'+tr('buzzer')+'</h2>';h+='<p data-i18n="buzzer_desc">'+tr('buzzer_desc')+'</p>';h+='<div class="card"><div class="info-grid">';h+='<div class="info-item"><div class="info-label" data-i18n="buzzer_pin">'+tr('buzzer_pin')+'</div>';h+='<div style="display:flex;gap:5px">';h+='<input type="number" id="buzzerPin" value="'+BUZZER_PIN+'" style="width:80px"/>';h+='<button class="btn btn-info" onclick="applyBuzzerConfig()" data-i18n="apply_config">'+tr('apply_config')+'</button></div></div></div>';h+='<div style="text-align:center;margin:15px 0">';h+='<button class="btn btn-primary" onclick="testBuzzer()" data-i18n="test_buzzer" data-i18n-prefix="▶️">'+tr('test_buzzer')+'</button> ';h+='<button class="btn btn-warning" onclick="playTone(1000,300)" data-i18n="beep">'+tr('beep')+'</button>';h+='</div><div id="buzzer-status" class="status-live" data-i18n="click_to_test">'+tr('click_to_test')+'</div></div></div>';return h;}
 function buildHardwareTests(){let h=buildGpio();h+=buildTests();return h;}
 function buildInputDevices(){let h='<div class="section"><h2 data-i18n="input_devices_section" data-i18n-prefix="🎮">'+tr('input_devices_section')+'</h2><p data-i18n="input_devices_intro">'+tr('input_devices_intro')+'</p>';h+='<h3 data-i18n="rotary_encoder" data-i18n-prefix="🎚️">'+tr('rotary_encoder')+'</h3>';h+='<p data-i18n="rotary_encoder_desc">'+tr('rotary_encoder_desc')+'</p>';h+='<div class="card"><div class="info-grid">';h+='<div class="info-item"><div class="info-label" data-i18n="rotary_pins">'+tr('rotary_pins')+'</div>';h+='<div style="display:flex;gap:5px;flex-wrap:wrap">';h+='<span data-i18n="rotary_pin_clk">'+tr('rotary_pin_clk')+'</span>: <input type="number" id="rotaryClk" value="'+ROTARY_CLK_PIN+'" min="0" max="48" style="width:70px"/> ';h+='<span data-i18n="rotary_pin_dt">'+tr('rotary_pin_dt')+'</span>: <input type="number" id="rotaryDt" value="'+ROTARY_DT_PIN+'" min="0" max="48" style="width:70px"/> ';h+='<span data-i18n="rotary_pin_sw">'+tr('rotary_pin_sw')+'</span>: <input type="number" id="rotarySw" value="'+ROTARY_SW_PIN+'" min="0" max="48" style="width:70px"/> ';h+='<button class="btn btn-info" onclick="applyRotaryConfig()" data-i18n="apply_config">'+tr('apply_config')+'</button></div></div>';h+='<div class="info-item"><div class="info-label" data-i18n="rotary_position">'+tr('rotary_position')+'</div>';h+='<div id="rotary-position" style="font-size:1.5em;font-weight:bold;color:#667eea">0</div></div>';h+='<div class="info-item"><div class="info-label" data-i18n="rotary_button">'+tr('rotary_button')+'</div>';h+='<div id="rotary-button" style="font-size:1.2em" data-i18n="rotary_button_released">'+tr('rotary_button_released')+'</div></div></div>';h+='<div style="text-align:center;margin:15px 0">';h+='<button class="btn btn-primary" onclick="testRotary()" data-i18n="test_rotary" data-i18n-prefix="▶️">'+tr('test_rotary')+'</button> ';h+='<button class="btn btn-info" id="rotary-monitor-btn" onclick="toggleRotaryMonitoring()" data-i18n="rotary_monitor" data-i18n-prefix="👁️">'+tr('rotary_monitor')+'</button> ';h+='<button class="btn btn-warning" onclick="resetRotaryPosition()" data-i18n="rotary_reset">'+tr('rotary_reset')+'</button>';h+='</div><div id="rotary-status" class="status-live" data-i18n="click_to_test">'+tr('click_to_test')+'</div></div>';h+='<h3 data-i18n="button_boot" data-i18n-prefix="🔘">'+tr('button_boot')+'</h3>';h+='<p data-i18n="button_boot_desc">'+tr('button_boot_desc')+'</p>';h+='<div class="card"><div class="info-grid">';h+='<div class="info-item"><div class="info-label" data-i18n="button_pin">'+tr('button_pin')+'</div>';h+='<div class="info-value">GPIO '+BUTTON_BOOT+' <span style="font-size:0.8em;color:#666">(non configurable)</span></div></div>';h+='<div class="info-item"><div class="info-label" data-i18n="button_state">'+tr('button_state')+'</div>';h+='<div id="boot-button-state" style="font-size:1.2em;color:#28a745" data-i18n="button_released">'+tr('button_released')+'</div></div></div>';h+='<div style="text-align:center;margin:15px 0">';h+='<button class="btn btn-info" id="boot-monitor-btn" onclick="toggleBootButtonMonitoring()" data-i18n="monitor_button" data-i18n-prefix="👁️">'+tr('monitor_button')+'</button>';h+='</div></div>';h+='<h3 data-i18n="button_1" data-i18n-prefix="🔘">'+tr('button_1')+'</h3>';h+='<p data-i18n="button_1_desc">'+tr('button_1_desc')+'</p>';h+='<div class="card"><div class="info-grid">';h+='<div class="info-item"><div class="info-label" data-i18n="button_pin">'+tr('button_pin')+'</div>';h+='<div style="display:flex;gap:5px">';h+='<input type="number" id="button1-pin" value="'+BUTTON_1+'" min="0" max="48" style="width:70px"/> ';h+='<button class="btn btn-info" onclick="applyButtonConfig(\'button1\')" data-i18n="apply_config">'+tr('apply_config')+'</button></div></div>';h+='<div class="info-item"><div class="info-label" data-i18n="button_state">'+tr('button_state')+'</div>';h+='<div id="button1-state" style="font-size:1.2em;color:#28a745" data-i18n="button_released">'+tr('button_released')+'</div></div></div>';h+='<div style="text-align:center;margin:15px 0">';h+='<button class="btn btn-info" id="button1-monitor-btn" onclick="toggleButton1Monitoring()" data-i18n="monitor_button" data-i18n-prefix="👁️">'+tr('monitor_button')+'</button>';h+='</div></div>';h+='<h3 data-i18n="button_2" data-i18n-prefix="🔘">'+tr('button_2')+'</h3>';h+='<p data-i18n="button_2_desc">'+tr('button_2_desc')+'</p>';h+='<div class="card"><div class="info-grid">';h+='<div class="info-item"><div class="info-label" data-i18n="button_pin">'+tr('button_pin')+'</div>';h+='<div style="display:flex;gap:5px">';h+='<input type="number" id="button2-pin" value="'+BUTTON_2+'" min="0" max="48" style="width:70px"/> ';h+='<button class="btn btn-info" onclick="applyButtonConfig(\'button2\')" data-i18n="apply_config">'+tr('apply_config')+'</button></div></div>';h+='<div class="info-item"><div class="info-label" data-i18n="button_state">'+tr('button_state')+'</div>';h+='<div id="button2-state" style="font-size:1.2em;color:#28a745" data-i18n="button_released">'+tr('button_released')+'</div></div></div>';h+='<div style="text-align:center;margin:15px 0">';h+='<button class="btn btn-info" id="button2-monitor-btn" onclick="toggleButton2Monitoring()" data-i18n="monitor_button" data-i18n-prefix="👁️">'+tr('monitor_button')+'</button>';h+='</div></div>';h+='</div>';return h;}
-function buildMemory(){let h='<div class="section"><h2 data-i18n="memory_section" data-i18n-prefix="💾">'+tr('memory_section')+'</h2><p data-i18n="memory_intro">'+tr('memory_intro')+'</p>';h+='<h3 data-i18n="sd_card" data-i18n-prefix="💾">'+tr('sd_card')+'</h3>';h+='<p data-i18n="sd_card_desc">'+tr('sd_card_desc')+'</p>';h+='<p class="coming" data-i18n="coming_soon">'+tr('coming_soon')+'</p>';h+='<div class="card"><div class="info-grid">';h+='<div class="info-item"><div class="info-label" data-i18n="sd_pins_spi">'+tr('sd_pins_spi')+'</div>';h+='<div style="display:flex;gap:5px;flex-wrap:wrap">';h+='<span data-i18n="sd_pin_miso">'+tr('sd_pin_miso')+'</span>: <input type="number" id="sdMiso" value="'+SD_MISO_PIN+'" min="0" max="48" style="width:70px"/> ';h+='<span data-i18n="sd_pin_mosi">'+tr('sd_pin_mosi')+'</span>: <input type="number" id="sdMosi" value="'+SD_MOSI_PIN+'" min="0" max="48" style="width:70px"/> ';h+='<span data-i18n="sd_pin_sclk">'+tr('sd_pin_sclk')+'</span>: <input type="number" id="sdSclk" value="'+SD_SCLK_PIN+'" min="0" max="48" style="width:70px"/> ';h+='<span data-i18n="sd_pin_cs">'+tr('sd_pin_cs')+'</span>: <input type="number" id="sdCs" value="'+SD_CS_PIN+'" min="0" max="48" style="width:70px"/> ';h+='<button class="btn btn-info" onclick="applySDConfig()" data-i18n="apply_config">'+tr('apply_config')+'</button></div></div></div>';h+='<p style="margin-top:10px;padding:10px;background:#fff3cd;border-left:4px solid #ffc107;color:#856404;border-radius:4px"><strong>⚠️ '+tr('gpio_shared_warning')+'</strong><br>'+tr('gpio_13_shared_desc')+'</p>';h+='<div style="text-align:center;margin:15px 0">';h+='<button class="btn btn-primary" onclick="testSD()" data-i18n="test_sd" data-i18n-prefix="▶️">'+tr('test_sd')+'</button> ';h+='<button class="btn btn-success" onclick="testSDRead()" data-i18n="sd_test_read" data-i18n-prefix="📖">'+tr('sd_test_read')+'</button> ';h+='<button class="btn btn-warning" onclick="testSDWrite()" data-i18n="sd_test_write" data-i18n-prefix="✍️">'+tr('sd_test_write')+'</button> ';h+='<button class="btn btn-danger" onclick="formatSD()" data-i18n="sd_format" data-i18n-prefix="⚠️">'+tr('sd_format')+'</button> ';h+='<button class="btn btn-info" onclick="loadSDInfo()" data-i18n="refresh" data-i18n-prefix="🔄">'+tr('refresh')+'</button>';h+='</div><div id="sd-status" class="status-live" data-i18n="click_to_test">'+tr('click_to_test')+'</div>';h+='<div id="sd-results" class="info-grid"></div></div>';h+='</div>';return h;}
-function buildSensors(){let h='<div class="section"><h2 data-i18n="sensors_section" data-i18n-prefix="📡">'+tr('sensors_section')+'</h2><p data-i18n="sensors_intro">'+tr('sensors_intro')+'</p>';h+='<h3 data-i18n="dht_sensor" data-i18n-prefix="🌡️">'+tr('dht_sensor')+'</h3>';h+='<p data-i18n="dht_sensor_desc">'+tr('dht_sensor_desc')+'</p>';h+='<div class="card"><div class="info-grid">';h+='<div class="info-item"><div class="info-label" data-i18n="dht_sensor_pin">'+tr('dht_sensor_pin')+'</div>';h+='<div style="display:flex;gap:5px">';h+='<input type="number" id="dhtPin" value="'+DHT_PIN+'" style="width:80px"/>';h+='<button class="btn btn-info" onclick="applyDHTConfig()" data-i18n="apply_config">'+tr('apply_config')+'</button></div></div>';h+='<div class="info-item"><div class="info-label" data-i18n="dht_sensor_type">'+tr('dht_sensor_type')+'</div>';h+='<div><select id="dhtSensorType" style="min-width:140px">';h+='<option value="22" data-i18n="dht11_option">'+tr('dht11_option')+'</option>';h+='<option value="22" data-i18n="dht22_option">'+tr('dht22_option')+'</option></select></div></div></div>';h+='<div style="text-align:center;margin:15px 0">';h+='<button class="btn btn-primary" onclick="testDHTSensor()" data-i18n="test_dht_sensor" data-i18n-prefix="▶️">'+tr('test_dht_sensor')+'</button>';h+='</div><div id="dht-status" class="status-live" data-i18n="click_to_test">'+tr('click_to_test')+'</div>';h+='<div id="dht-results" class="info-grid"></div></div>';h+='<h3 data-i18n="environmental_sensors" data-i18n-prefix="🌦️">'+tr('environmental_sensors')+'</h3>';h+='<p data-i18n="environmental_sensors_desc">'+tr('environmental_sensors_desc')+'</p>';h+='<div class="card"><div class="info-grid" id="env-info">';h+='<div class="info-item"><div class="info-label" data-i18n="aht20_sensor">'+tr('aht20_sensor')+'</div><div class="info-value" id="env-aht20-status">-</div></div>';h+='<div class="info-item"><div class="info-label" data-i18n="bmp280_sensor">'+tr('bmp280_sensor')+'</div><div class="info-value" id="env-bmp280-status">-</div></div>';h+='<div class="info-item"><div class="info-label" data-i18n="temperature_avg">'+tr('temperature_avg')+'</div><div class="info-value" id="env-temp-avg">-</div></div>';h+='<div class="info-item"><div class="info-label" data-i18n="humidity">'+tr('humidity')+'</div><div class="info-value" id="env-humidity">-</div></div>';h+='<div class="info-item"><div class="info-label" data-i18n="pressure_hpa">'+tr('pressure_hpa')+'</div><div class="info-value" id="env-pressure">-</div></div>';h+='<div class="info-item"><div class="info-label" data-i18n="altitude_calculated">'+tr('altitude_calculated')+'</div><div class="info-value" id="env-altitude">-</div></div>';h+='</div>';h+='<div style="text-align:center;margin:15px 0">';h+='<button class="btn btn-primary" onclick="loadEnvironmentalData()" data-i18n="refresh_env_sensors" data-i18n-prefix="🔄">'+tr('refresh_env_sensors')+'</button> ';h+='<button class="btn btn-info" onclick="testEnvironmentalSensors()" data-i18n="test_env_sensors" data-i18n-prefix="🧪">'+tr('test_env_sensors')+'</button>';h+='</div><div id="env-status" class="status-live"></div></div>';h+='<h3 data-i18n="light_sensor" data-i18n-prefix="☀️">'+tr('light_sensor')+'</h3>';h+='<p data-i18n="light_sensor_desc">'+tr('light_sensor_desc')+'</p>';h+='<div class="card"><div class="info-grid">';h+='<div class="info-item"><div class="info-label" data-i18n="light_sensor_pin">'+tr('light_sensor_pin')+'</div>';h+='<div style="display:flex;gap:5px">';h+='<input type="number" id="lightPin" value="'+LIGHT_SENSOR_PIN+'" style="width:80px"/>';h+='<button class="btn btn-info" onclick="applyLightConfig()" data-i18n="apply_config">'+tr('apply_config')+'</button></div></div></div>';h+='<div style="text-align:center;margin:15px 0">';h+='<button class="btn btn-primary" onclick="testLightSensor()" data-i18n="test_light_sensor" data-i18n-prefix="▶️">'+tr('test_light_sensor')+'</button>';h+='</div><div id="light-status" class="status-live" data-i18n="click_to_test">'+tr('click_to_test')+'</div>';h+='<div id="light-results" class="info-grid"></div></div>';h+='<h3 data-i18n="distance_sensor" data-i18n-prefix="📏">'+tr('distance_sensor')+'</h3>';h+='<p data-i18n="distance_sensor_desc">'+tr('distance_sensor_desc')+'</p>';h+='<div class="card"><div class="info-grid">';h+='<div class="info-item"><div class="info-label" data-i18n="distance_pins">'+tr('distance_pins')+'</div>';h+='<div style="display:flex;gap:5px">';h+='<input type="number" id="distTrig" value="'+DISTANCE_TRIG_PIN+'" style="width:60px" data-i18n-placeholder="label_trig" placeholder="'+tr('label_trig')+'"/>';h+='<input type="number" id="distEcho" value="'+DISTANCE_ECHO_PIN+'" style="width:60px" data-i18n-placeholder="label_echo" placeholder="'+tr('label_echo')+'"/>';h+='<button class="btn btn-info" onclick="applyDistanceConfig()" data-i18n="apply_config">'+tr('apply_config')+'</button></div></div></div>';h+='<div style="text-align:center;margin:15px 0">';h+='<button class="btn btn-primary" onclick="testDistanceSensor()" data-i18n="test_distance_sensor" data-i18n-prefix="▶️">'+tr('test_distance_sensor')+'</button>';h+='</div><div id="distance-status" class="status-live" data-i18n="click_to_test">'+tr('click_to_test')+'</div>';h+='<div id="distance-results" class="info-grid"></div></div>';h+='<h3 data-i18n="motion_sensor" data-i18n-prefix="👁️">'+tr('motion_sensor')+'</h3>';h+='<p data-i18n="motion_sensor_desc">'+tr('motion_sensor_desc')+'</p>';h+='<div class="card"><div class="info-grid">';h+='<div class="info-item"><div class="info-label" data-i18n="motion_sensor_pin">'+tr('motion_sensor_pin')+'</div>';h+='<div style="display:flex;gap:5px">';h+='<input type="number" id="motionPin" value="'+MOTION_SENSOR_PIN+'" style="width:80px"/>';h+='<button class="btn btn-info" onclick="applyMotionConfig()" data-i18n="apply_config">'+tr('apply_config')+'</button></div></div></div>';h+='<div style="text-align:center;margin:15px 0">';h+='<button class="btn btn-primary" onclick="testMotionSensor()" data-i18n="test_motion_sensor" data-i18n-prefix="▶️">'+tr('test_motion_sensor')+'</button>';h+='</div><div id="motion-status" class="status-live" data-i18n="click_to_test">'+tr('click_to_test')+'</div>';h+='<div id="motion-results" class="info-grid"></div></div>';h+='</div>';return h;}
+function buildMemory(){let h='<div class="section"><h2 data-i18n="memory_section" data-i18n-prefix="💾">'+tr('memory_section')+'</h2><p data-i18n="memory_intro">'+tr('memory_intro')+'</p>';h+='<h3 data-i18n="sd_card" data-i18n-prefix="💾">'+tr('sd_card')+'</h3>';h+='<p data-i18n="sd_card_desc">'+tr('sd_card_desc')+'</p>';h+='<p class="coming" data-i18n="coming_soon">'+tr('coming_soon')+'</p>';h+='<div class="card"><div class="info-grid">';h+='<div class="info-item"><div class="info-label" data-i18n="sd_pins_spi">'+tr('sd_pins_spi')+'</div>';h+='<div style="display:flex;gap:5px;flex-wrap:wrap">';h+='<span data-i18n="sd_pin_miso">'+tr('sd_pin_miso')+'</span>: <input type="number" id="sdMiso" value="'+SD_MISO_PIN+'" min="0" max="48" style="width:70px"/> ';h+='<span data-i18n="sd_pin_mosi">'+tr('sd_pin_mosi')+'</span>: <input type="number" id="sdMosi" value="'+SD_MOSI_PIN+'" min="0" max="48" style="width:70px"/> ';h+='<span data-i18n="sd_pin_sclk">'+tr('sd_pin_sclk')+'</span>: <input type="number" id="sdSclk" value="'+SD_SCLK_PIN+'" min="0" max="48" style="width:70px"/> ';h+='<span data-i18n="sd_pin_cs">'+tr('sd_pin_cs')+'</span>: <input type="number" id="sdCs" value="'+SD_CS_PIN+'" min="0" max="48" style="width:70px"/> ';h+='<button class="btn btn-info" onclick="applySDConfig()" data-i18n="apply_config">'+tr('apply_config')+'</button></div></div></div>';h+='<p style="margin-top:10px;padding:10px;background:#fff3cd;border-left:4px solid #ffc107;color:#856404;border-radius:4px"><strong>⚠️ '+tr('gpio_shared_warning')+'</strong><br>'+tr('gpio_13_shared_desc')+'</p>';h+='<div style="text-align:center;margin:15px 0">';h+='<button class="btn btn-primary" onclick="testSD()" data-i18n="test_sd" data-i18n-prefix="▶️">'+tr('test_sd')+'</button> ';h+='<button class="btn btn-success" onclick="testSDRead()" data-i18n="sd_test_read" data-i18n-prefix="📖">'+tr('sd_test_read')+'</button> ';h+='<button class="btn btn-warning" onclick="testSDWrite()" data-i18n="sd_test_write" data-i18n-prefix="✍️">'+tr('sd_test_write')+'</button> ';h+='<button class="btn btn-danger" onclick="formatSD()" data-i18n="sd_format" data-i18n-prefix="⚠️">'+tr('sd_format')+'</button> ';h+='<button class="btn btn-info" onclick="loadSDInfo()" data-i18n="refresh" data-i18n-prefix="🔄">'+tr('refresh')+'</button> ';h+='<button class="btn btn-secondary" onclick="benchmarkSD()" data-i18n="sd_benchmark" data-i18n-prefix="⏱️">'+tr('sd_benchmark')+'</button>';h+='</div><div id="sd-status" class="status-live" data-i18n="click_to_test">'+tr('click_to_test')+'</div>';h+='<div id="sd-results" class="info-grid"></div>';h+='<div style="text-align:center;margin:15px 0"><strong data-i18n="sd_logger">'+tr('sd_logger')+'</strong> ';h+='<span data-i18n="sd_log_interval">'+tr('sd_log_interval')+'</span>: <input type="number" id="sdLogInterval" value="1000" min="10" max="600000" style="width:90px"/> ';h+='<button id="sd-log-btn" class="btn btn-success" onclick="toggleSDLogger()" data-i18n="sd_log_start" data-i18n-prefix="⏺️">'+tr('sd_log_start')+'</button></div>';h+='<div id="sd-log-results" class="info-grid"></div></div>';h+='</div>';return h;}
+function buildSensors(){let h='<div class="section"><h2 data-i18n="sensors_section" data-i18n-prefix="📡">'+tr('sensors_section')+'</h2><p data-i18n="sensors_intro">'+tr('sensors_intro')+'</p>';h+='<h3 data-i18n="dht_sensor" data-i18n-prefix="🌡️">'+tr('dht_sensor')+'</h3>';h+='<p data-i18n="dht_sensor_desc">'+tr('dht_sensor_desc')+'</p>';h+='<div class="card"><div class="info-grid">';h+='<div class="info-item"><div class="info-label" data-i18n="dht_sensor_pin">'+tr('dht_sensor_pin')+'</div>';h+='<div style="display:flex;gap:5px">';h+='<input type="number" id="dhtPin" value="'+DHT_PIN+'" style="width:80px"/>';h+='<button class="btn btn-info" onclick="applyDHTConfig()" data-i18n="apply_config">'+tr('apply_config')+'</button></div></div>';h+='<div class="info-item"><div class="info-label" data-i18n="dht_sensor_type">'+tr('dht_sensor_type')+'</div>';h+='<div><select id="dhtSensorType" style="min-width:140px">';h+='<option value="22" data-i18n="dht11_option">'+tr('dht11_option')+'</option>';h+='<option value="22" data-i18n="dht22_option">'+tr('dht22_option')+'</option></select></div></div></div>';h+='<div style="text-align:center;margin:15px 0">';h+='<button class="btn btn-primary" onclick="testDHTSensor()" data-i18n="test_dht_sensor" data-i18n-prefix="▶️">'+tr('test_dht_sensor')+'</button>';h+='</div><div id="dht-status" class="status-live" data-i18n="click_to_test">'+tr('click_to_test')+'</div>';h+='<div id="dht-results" class="info-grid"></div></div>';h+='<h3 data-i18n="environmental_sensors" data-i18n-prefix="🌦️">'+tr('environmental_sensors')+'</h3>';h+='<p data-i18n="environmental_sensors_desc">'+tr('environmental_sensors_desc')+'</p>';h+='<div class="card"><div class="info-grid" id="env-info">';h+='<div class="info-item"><div class="info-label" data-i18n="aht20_sensor">'+tr('aht20_sensor')+'</div><div class="info-value" id="env-aht20-status">-</div></div>';h+='<div class="info-item"><div class="info-label" data-i18n="bmp280_sensor">'+tr('bmp280_sensor')+'</div><div class="info-value" id="env-bmp280-status">-</div></div>';h+='<div class="info-item"><div class="info-label" data-i18n="temperature_avg">'+tr('temperature_avg')+'</div><div class="info-value" id="env-temp-avg">-</div></div>';h+='<div class="info-item"><div class="info-label" data-i18n="humidity">'+tr('humidity')+'</div><div class="info-value" id="env-humidity">-</div></div>';h+='<div class="info-item"><div class="info-label" data-i18n="pressure_hpa">'+tr('pressure_hpa')+'</div><div class="info-value" id="env-pressure">-</div></div>';h+='<div class="info-item"><div class="info-label" data-i18n="altitude_calculated">'+tr('altitude_calculated')+'</div><div class="info-value" id="env-altitude">-</div></div>';h+='</div>';h+='<div style="text-align:center;margin:15px 0">';h+='<button class="btn btn-primary" onclick="loadEnvironmentalData()" data-i18n="refresh_env_sensors" data-i18n-prefix="🔄">'+tr('refresh_env_sensors')+'</button> ';h+='<button class="btn btn-info" onclick="testEnvironmentalSensors()" data-i18n="test_env_sensors" data-i18n-prefix="🧪">'+tr('test_env_sensors')+'</button>';h+='</div><div id="env-status" class="status-live"></div></div>';h+='<h3 data-i18n="light_sensor" data-i18n-prefix="☀️">'+tr('light_sensor')+'</h3>';h+='<p data-i18n="light_sensor_desc">'+tr('light_sensor_desc')+'</p>';h+='<div class="card"><div class="info-grid">';h+='<div class="info-item"><div class="info-label" data-i18n="light_sensor_pin">'+tr('light_sensor_pin')+'</div>';h+='<div style="display:flex;gap:5px">';h+='<input type="number" id="lightPin" value="'+LIGHT_SENSOR_PIN+'" style="width:80px"/>';h+='<button class="btn btn-info" onclick="applyLightConfig()" data-i18n="apply_config">'+tr('apply_config')+'</button></div></div></div>';h+='<div style="text-align:center;margin:15px 0">';h+='<button class="btn btn-primary" onclick="testLightSensor()" data-i18n="test_light_sensor" data-i18n-prefix="▶️">'+tr('test_light_sensor')+'</button>';h+='</div><div id="light-status" class="status-live" data-i18n="click_to_test">'+tr('click_to_test')+'</div>';h+='<div id="light-results" class="info-grid"></div></div>';h+='<h3 data-i18n="distance_sensor" data-i18n-prefix="📏">'+tr('distance_sensor')+'</h3>';h+='<p data-i18n="distance_sensor_desc">'+tr('distance_sensor_desc')+'</p>';h+='<div class="card"><div class="info-grid">';h+='<div class="info-item"><div class="info-label" data-i18n="distance_pins">'+tr('distance_pins')+'</div>';h+='<div style="display:flex;gap:5px">';h+='<input type="number" id="distTrig" value="'+DISTANCE_TRIG_PIN+'" style="width:60px" data-i18n-placeholder="label_trig" placeholder="'+tr('label_trig')+'"/>';h+='<input type="number" id="distEcho" value="'+DISTANCE_ECHO_PIN+'" style="width:60px" data-i18n-placeholder="label_echo" placeholder="'+tr('label_echo')+'"/>';h+='<button class="btn btn-info" onclick="applyDistanceConfig()" data-i18n="apply_config">'+tr('apply_config')+'</button></div></div></div>';h+='<div style="text-align:center;margin:15px 0">';h+='<button class="btn btn-primary" onclick="testDistanceSensor()" data-i18n="test_distance_sensor" data-i18n-prefix="▶️">'+tr('test_distance_sensor')+'</button> ';h+='<button id="distance-stream-btn" class="btn btn-info" onclick="toggleDistanceStream()" data-i18n="start_stream" data-i18n-prefix="📈">'+tr('start_stream')+'</button>';h+='</div><div id="distance-status" class="status-live" data-i18n="click_to_test">'+tr('click_to_test')+'</div>';h+='<div id="distance-results" class="info-grid"></div>';h+='<canvas id="distance-chart" width="512" height="100" style="width:100%;max-width:640px;display:none;margin:10px auto;background:#f8f9fa;border-radius:5px"></canvas></div>';h+='<h3 data-i18n="motion_sensor" data-i18n-prefix="👁️">'+tr('motion_sensor')+'</h3>';h+='<p data-i18n="motion_sensor_desc">'+tr('motion_sensor_desc')+'</p>';h+='<div class="card"><div class="info-grid">';h+='<div class="info-item"><div class="info-label" data-i18n="motion_sensor_pin">'+tr('motion_sensor_pin')+'</div>';h+='<div style="display:flex;gap:5px">';h+='<input type="number" id="motionPin" value="'+MOTION_SENSOR_PIN+'" style="width:80px"/>';h+='<button class="btn btn-info" onclick="applyMotionConfig()" data-i18n="apply_config">'+tr('apply_config')+'</button></div></div></div>';h+='<div style="text-align:center;margin:15px 0">';h+='<button class="btn btn-primary" onclick="testMotionSensor()" data-i18n="test_motion_sensor" data-i18n-prefix="▶️">'+tr('test_motion_sensor')+'</button>';h+='</div><div id="motion-status" class="status-live" data-i18n="click_to_test">'+tr('click_to_test')+'</div>';h+='<div id="motion-results" class="info-grid"></div></div>';h+='</div>';return h;}
 async function testBuiltinLED(){setStatus('builtin-led-status',{key:'test_in_progress'},null);const r=await fetch('/api/builtin-led-test');const d=await r.json();setStatus('builtin-led-status',d.result,d.success?'success':'error');}
 async function ledBlink(){setStatus('builtin-led-status',{key:'transmission'},null);const r=await fetch('/api/builtin-led-control?action=blink');const d=await r.json();setStatus('builtin-led-status',d.message,null);}
 async function ledFade(){setStatus('builtin-led-status',{key:'transmission'},null);const r=await fetch('/api/builtin-led-control?action=fade');const d=await r.json();setStatus('builtin-led-status',d.message,null);}
@@ -179,6 +201,11 @@ function updateBrightnessValue(value){document.getElementById('tftBrightnessValu
 async function setTFTBrightnessLevel(level){const slider=document.getElementById('tftBrightnessSlider');const valueDisplay=document.getElementById('tftBrightnessValue');if(slider)slider.value=level;if(valueDisplay)valueDisplay.textContent=level;try{const r=await fetch('/api/tft-brightness?value='+level,{method:'POST'});const d=await r.json();if(d.success){console.log('TFT brightness set to '+level+'/255');}else{console.error('Failed to set TFT brightness: '+d.message);}}catch(e){console.error('Error setting TFT brightness: '+e);}}
 async function getTFTBrightness(){try{const r=await fetch('/api/tft-brightness');const d=await r.json();if(d.success&&d.brightness!==undefined){const slider=document.getElementById('tftBrightnessSlider');const valueDisplay=document.getElementById('tftBrightnessValue');if(slider)slider.value=d.brightness;if(valueDisplay)valueDisplay.textContent=d.brightness;}}catch(e){console.error('Error getting TFT brightness: '+e);}}
 async function testADC(){setStatus('adc-status',{key:'test_in_progress'},null);const r=await fetch('/api/adc-test');const d=await r.json();let h='';d.readings.forEach(rd=>{h+='<div class="info-item"><div class="info-label">GPIO '+rd.pin+'</div><div class="info-value">'+rd.raw+' ('+rd.voltage.toFixed(2)+'V)</div></div>';});document.getElementById('adc-results').innerHTML=h;setStatus('adc-status',d.result,null);}
+let adcStreamInterval=null;async function toggleADCStream(){const btn=document.getElementById('adc-stream-btn');if(adcStreamInterval){clearInterval(adcStreamInterval);adcStreamInterval=null;await fetch('/api/adc-continuous?action=stop');btn.textContent='▶️ '+tr('start_stream');btn.className='btn btn-primary';setStatus('adc-stream-status',tr('stop_monitoring'),null);return;}
+const pins=document.getElementById('adc-stream-pins').value.trim();const rate=document.getElementById('adc-stream-rate').value;let url='/api/adc-continuous?action=start&rate='+encodeURIComponent(rate);if(pins)url+='&pins='+encodeURIComponent(pins);const r=await fetch(url);const d=await r.json();if(!d.running){setStatus('adc-stream-status',d.message||d.error,'error');return;}
+btn.textContent='⏸️ '+tr('stop_stream');btn.className='btn btn-danger';setStatus('adc-stream-status',(d.dma?'DMA':'polling')+' @ '+d.per_channel_rate+' S/s/ch'+(d.calibrated?'':' ('+tr('adc_uncalibrated')+')'),'success');adcStreamInterval=setInterval(updateADCStream,500);}
+async function updateADCStream(){const r=await fetch('/api/adc-stream?fft=0');const d=await r.json();let h='';d.channels.forEach(ch=>{h+='<div class="info-item"><div class="info-label">GPIO '+ch.pin+'</div><div class="info-value">';h+=ch.mean_mv.toFixed(1)+' mV (RMS '+ch.rms_mv.toFixed(1)+', σ '+ch.noise_mv.toFixed(2)+')<br>';h+=ch.min_mv+' … '+ch.max_mv+' mV, '+ch.count+' '+tr('samples');if(ch.histogram){const peak=Math.max(1,...ch.histogram.counts);h+='<div style="display:flex;align-items:flex-end;height:30px;gap:1px;margin-top:5px">';ch.histogram.counts.forEach(c=>{h+='<div style="flex:1;background:#667eea;height:'+Math.round(c*100/peak)+'%"></div>';});h+='</div>';}
+h+='</div></div>';});h+='<div class="info-item"><div class="info-label">'+tr('overruns')+'</div><div class="info-value">'+d.overruns+'</div></div>';document.getElementById('adc-stream-results').innerHTML=h;const cv=document.getElementById('adc-spectrum');if(cv&&d.spectrum&&d.spectrum.mags_mv.length>1){const ctx=cv.getContext('2d');const mags=d.spectrum.mags_mv.slice(1);const peak=Math.max(0.01,...mags);ctx.clearRect(0,0,cv.width,cv.height);ctx.fillStyle='#667eea';const w=cv.width/mags.length;mags.forEach((m,i)=>{const bh=m/peak*(cv.height-14);ctx.fillRect(i*w,cv.height-bh,Math.max(1,w-1),bh);});const top=mags.indexOf(peak)+1;ctx.fillStyle='#333';ctx.fillText((top*d.spectrum.bin_hz).toFixed(0)+' Hz: '+peak.toFixed(2)+' mV',4,11);}}
 async function testAllGPIO(){setStatus('gpio-status',{key:'test_in_progress'},null);const r=await fetch('/api/test-gpio');const d=await r.json();let h='';d.results.forEach(g=>{h+='<div class="gpio-item '+(g.working?'gpio-ok':'gpio-fail')+'">GPIO '+g.pin+'<br>'+(g.working?'✅ OK':'❌ FAIL')+'</div>';});document.getElementById('gpio-results').innerHTML=h;setStatus('gpio-status',{key:'gpio_test_complete',replacements:{count:d.results.length}},null);}
 async function scanWiFi(){setStatus('wifi-status',{key:'wifi_scan_in_progress'},null);const r=await fetch('/api/wifi-scan');const d=await r.json();let h='';d.networks.forEach(n=>{const icon=n.rssi>=-60?'🟢':n.rssi>=-70?'🟡':'🔴';const color=n.rssi>=-60?'#28a745':n.rssi>=-70?'#ffc107':'#dc3545';h+='<div class="wifi-item"><div style="display:flex;justify-content:space-between"><div><strong>'+icon+' '+n.ssid+'</strong><br><small>'+n.bssid+' | '+tr('wifi_channel')+' '+n.channel+'</small></div>';h+='<div style="font-size:1.3em;font-weight:bold;color:'+color+'">'+n.rssi+' dBm</div></div></div>';});document.getElementById('wifi-results').innerHTML=h;setStatus('wifi-status',{key:'wifi_networks_found',replacements:{count:d.networks.length}},null);}
 async function loadWirelessInfo(){try{const r=await fetch('/api/wifi-info');const d=await r.json();const connectedNode=document.getElementById('wifi-connected');const ssidNode=document.getElementById('wifi-current-ssid');const ipNode=document.getElementById('wifi-ip');const gatewayNode=document.getElementById('wifi-gateway');const dnsNode=document.getElementById('wifi-dns');const rssiNode=document.getElementById('wifi-rssi');if(connectedNode){clearTranslationAttributes(connectedNode);connectedNode.textContent=d.connected?tr('connected'):tr('disconnected');connectedNode.style.color=d.connected?'#28a745':'#dc3545';}
@@ -188,14 +215,14 @@ if(gatewayNode){clearTranslationAttributes(gatewayNode);gatewayNode.textContent=
 if(dnsNode){clearTranslationAttributes(dnsNode);dnsNode.textContent=d.dns||'-';}
 if(rssiNode){clearTranslationAttributes(rssiNode);rssiNode.textContent=d.connected?(d.rssi+' dBm'):'-';}}catch(e){console.error('Error loading WiFi info:',e);}
 loadGPSData();}
-async function loadGPSData(){try{const r=await fetch('/api/gps');const d=await r.json();const statusNode=document.getElementById('gps-status-value');const latNode=document.getElementById('gps-latitude');const lonNode=document.getElementById('gps-longitude');const altNode=document.getElementById('gps-altitude');const satNode=document.getElementById('gps-satellites');const hdopNode=document.getElementById('gps-hdop');if(statusNode){clearTranslationAttributes(statusNode);statusNode.textContent=d.status||'-';statusNode.style.color=d.status==='Fix OK'?'#28a745':'#dc3545';}
+async function loadGPSData(){try{const r=await fetchApi('/api/gps');const d=await readApiResponse(r);const statusNode=document.getElementById('gps-status-value');const latNode=document.getElementById('gps-latitude');const lonNode=document.getElementById('gps-longitude');const altNode=document.getElementById('gps-altitude');const satNode=document.getElementById('gps-satellites');const hdopNode=document.getElementById('gps-hdop');if(statusNode){clearTranslationAttributes(statusNode);statusNode.textContent=d.status||'-';statusNode.style.color=d.status==='Fix OK'?'#28a745':'#dc3545';}
 if(latNode){clearTranslationAttributes(latNode);latNode.textContent=d.latitude?d.latitude.toFixed(6)+'°':'-';}
 if(lonNode){clearTranslationAttributes(lonNode);lonNode.textContent=d.longitude?d.longitude.toFixed(6)+'°':'-';}
 if(altNode){clearTranslationAttributes(altNode);altNode.textContent=d.altitude?d.altitude.toFixed(1)+' m':'-';}
 if(satNode){clearTranslationAttributes(satNode);satNode.textContent=d.satellites||'0';}
 if(hdopNode){clearTranslationAttributes(hdopNode);hdopNode.textContent=d.hdop?d.hdop.toFixed(2):'-';}}catch(e){console.error('Error loading GPS data:',e);}}
 async function testGPS(){setStatus('gps-test-status',{key:'test_in_progress'},null);try{const r=await fetch('/api/gps-test');const d=await r.json();setStatus('gps-test-status',{text:d.result||'Test complete'},d.success?'success':'error');setTimeout(()=>loadGPSData(),1000);}catch(e){setStatus('gps-test-status',{key:'error_label'},'error');}}
-async function loadEnvironmentalData(){try{const r=await fetch('/api/environmental-sensors');const d=await r.json();const aht20Node=document.getElementById('env-aht20-status');const bmp280Node=document.getElementById('env-bmp280-status');const tempNode=document.getElementById('env-temp-avg');const humNode=document.getElementById('env-humidity');const pressNode=document.getElementById('env-pressure');const altNode=document.getElementById('env-altitude');if(aht20Node){clearTranslationAttributes(aht20Node);aht20Node.textContent=d.aht20_available?'✅ '+tr('available'):'❌ '+tr('not_available');aht20Node.style.color=d.aht20_available?'#28a745':'#dc3545';}
+async function loadEnvironmentalData(){try{const r=await fetchApi('/api/environmental-sensors');const d=await readApiResponse(r);const aht20Node=document.getElementById('env-aht20-status');const bmp280Node=document.getElementById('env-bmp280-status');const tempNode=document.getElementById('env-temp-avg');const humNode=document.getElementById('env-humidity');const pressNode=document.getElementById('env-pressure');const altNode=document.getElementById('env-altitude');if(aht20Node){clearTranslationAttributes(aht20Node);aht20Node.textContent=d.aht20_available?'✅ '+tr('available'):'❌ '+tr('not_available');aht20Node.style.color=d.aht20_available?'#28a745':'#dc3545';}
 if(bmp280Node){clearTranslationAttributes(bmp280Node);bmp280Node.textContent=d.bmp280_available?'✅ '+tr('available'):'❌ '+tr('not_available');bmp280Node.style.color=d.bmp280_available?'#28a745':'#dc3545';}
 if(tempNode){clearTranslationAttributes(tempNode);tempNode.textContent=d.temperature_avg?d.temperature_avg.toFixed(1)+' °C':'-';}
 if(humNode){clearTranslationAttributes(humNode);humNode.textContent=d.humidity?d.humidity.toFixed(1)+' %':'-';}
@@ -232,7 +259,8 @@ async function applyDHTConfig(){const pin=parseInt(document.getElementById('dhtP
 if(type){params.append('type',type);}
 const query=params.toString();const resp=await fetch('/api/dht-config'+(query.length?'?'+query:''));const d=await resp.json();if(d.type!==undefined){document.getElementById('dhtSensorType').value=String(d.type);}
 setStatus('dht-status',d.message,d.success?'success':'error');}
-async function testDHTSensor(){setStatus('dht-status',{key:'test_in_progress'},null);document.getElementById('dht-results').innerHTML='';const r=await fetch('/api/dht-test');const d=await r.json();if(d.type!==undefined){document.getElementById('dhtSensorType').value=String(d.type);}
+async function testDHTSensor(){setStatus('dht-status',{key:'test_in_progress'},null);document.getElementById('dht-results').innerHTML='';const r=await fetch('/api/dht-test');const d=await r.json();if(d.pending){setTimeout(testDHTSensor,500);return;}
+if(d.type!==undefined){document.getElementById('dhtSensorType').value=String(d.type);}
 if(d.success){let h='';if(d.type!==undefined){h+='<div class="info-item"><div class="info-label" data-i18n="dht_sensor_type">'+tr('dht_sensor_type')+'</div><div class="info-value">'+(Number(d.type)===22?tr('dht22_option'):tr('dht11_option'))+'</div></div>';}
 h+='<div class="info-item"><div class="info-label" data-i18n="temperature">'+tr('temperature')+'</div><div class="info-value">'+d.temperature.toFixed(1)+' °C</div></div>';h+='<div class="info-item"><div class="info-label" data-i18n="humidity">'+tr('humidity')+'</div><div class="info-value">'+d.humidity.toFixed(1)+' %</div></div>';document.getElementById('dht-results').innerHTML=h;}
 setStatus('dht-status',d.result,d.success?'success':'error');}
@@ -240,8 +268,14 @@ async function applyLightConfig(){const pin=parseInt(document.getElementById('li
 async function testLightSensor(){setStatus('light-status',{key:'test_in_progress'},null);document.getElementById('light-results').innerHTML='';const r=await fetch('/api/light-sensor-test');const d=await r.json();if(d.success){let h='';h+='<div class="info-item"><div class="info-label" data-i18n="light_level">'+tr('light_level')+'</div><div class="info-value">'+d.value+' / 4095</div></div>';document.getElementById('light-results').innerHTML=h;}
 setStatus('light-status',d.result,d.success?'success':'error');}
 async function applyDistanceConfig(){const trig=parseInt(document.getElementById('distTrig').value);const echo=parseInt(document.getElementById('distEcho').value);const resp=await fetch('/api/distance-sensor-config?trig='+trig+'&echo='+echo);const d=await resp.json();setStatus('distance-status',d.message,d.success?'success':'error');}
-async function testDistanceSensor(){setStatus('distance-status',{key:'test_in_progress'},null);document.getElementById('distance-results').innerHTML='';const r=await fetch('/api/distance-sensor-test');const d=await r.json();if(d.success){let h='';h+='<div class="info-item"><div class="info-label" data-i18n="distance">'+tr('distance')+'</div><div class="info-value">'+d.distance.toFixed(2)+' cm</div></div>';document.getElementById('distance-results').innerHTML=h;}
+async function testDistanceSensor(){setStatus('distance-status',{key:'test_in_progress'},null);document.getElementById('distance-results').innerHTML='';const r=await fetch('/api/distance-sensor-test');const d=await r.json();if(d.pending){setTimeout(testDistanceSensor,300);return;}
+if(d.success){let h='';h+='<div class="info-item"><div class="info-label" data-i18n="distance">'+tr('distance')+'</div><div class="info-value">'+d.distance.toFixed(2)+' cm</div></div>';document.getElementById('distance-results').innerHTML=h;}
 setStatus('distance-status',d.result,d.success?'success':'error');}
+let distanceStreamInterval=null;let distanceHistory=[];let distanceStreamNext=0;async function toggleDistanceStream(){const btn=document.getElementById('distance-stream-btn');const cv=document.getElementById('distance-chart');if(distanceStreamInterval){clearInterval(distanceStreamInterval);distanceStreamInterval=null;await fetch('/api/distance-stream?action=stop');btn.textContent='📈 '+tr('start_stream');btn.className='btn btn-info';setStatus('distance-status',tr('stop_monitoring'),null);return;}
+const r=await fetch('/api/distance-stream?action=start');const d=await r.json();if(!d.running){setStatus('distance-status',d.message||tr('configuration_invalid'),'error');return;}
+distanceHistory=[];distanceStreamNext=d.next;if(cv)cv.style.display='block';btn.textContent='⏸️ '+tr('stop_stream');btn.className='btn btn-danger';setStatus('distance-status',d.rate_hz+' Hz','success');distanceStreamInterval=setInterval(updateDistanceStream,250);}
+async function updateDistanceStream(){const r=await fetch('/api/distance-stream?since='+distanceStreamNext);const d=await r.json();distanceStreamNext=d.next;d.samples.forEach(s=>distanceHistory.push(s));if(distanceHistory.length>200)distanceHistory=distanceHistory.slice(-200);let h='';h+='<div class="info-item"><div class="info-label" data-i18n="distance">'+tr('distance')+'</div><div class="info-value">'+(d.valid?d.distance_cm.toFixed(1)+' cm':'-')+'</div></div>';h+='<div class="info-item"><div class="info-label" data-i18n="distance_raw">'+tr('distance_raw')+'</div><div class="info-value">'+(d.valid?d.raw_cm.toFixed(1)+' cm':'-')+'</div></div>';h+='<div class="info-item"><div class="info-label" data-i18n="sound_speed">'+tr('sound_speed')+'</div><div class="info-value">'+d.sound_speed.toFixed(1)+' m/s ('+d.temperature_c.toFixed(1)+' °C)</div></div>';h+='<div class="info-item"><div class="info-label">Timeouts</div><div class="info-value">'+d.timeouts+' / '+d.triggers+'</div></div>';document.getElementById('distance-results').innerHTML=h;const cv=document.getElementById('distance-chart');if(cv&&distanceHistory.length>1){const ctx=cv.getContext('2d');const values=distanceHistory.map(s=>s[1]).concat(distanceHistory.map(s=>s[2]));const lo=Math.min(...values);const hi=Math.max(lo+1,...values);const x=i=>i*cv.width/(distanceHistory.length-1);const y=v=>cv.height-4-(v-lo)/(hi-lo)*(cv.height-16);ctx.clearRect(0,0,cv.width,cv.height);[[1,'#c3c8f5'],[2,'#667eea']].forEach(([k,color])=>{ctx.strokeStyle=color;ctx.beginPath();distanceHistory.forEach((s,i)=>{if(i)ctx.lineTo(x(i),y(s[k]));else ctx.moveTo(x(i),y(s[k]));});ctx.stroke();});ctx.fillStyle='#333';ctx.fillText(lo.toFixed(1)+' … '+hi.toFixed(1)+' cm',4,11);}
+if(!d.running){clearInterval(distanceStreamInterval);distanceStreamInterval=null;}}
 async function applyMotionConfig(){const pin=parseInt(document.getElementById('motionPin').value);const resp=await fetch('/api/motion-sensor-config?pin='+pin);const d=await resp.json();setStatus('motion-status',d.message,d.success?'success':'error');}
 async function testMotionSensor(){setStatus('motion-status',{key:'test_in_progress'},null);document.getElementById('motion-results').innerHTML='';const r=await fetch('/api/motion-sensor-test');const d=await r.json();if(d.success){let h='';const motionText=d.motion?tr('motion_detected'):tr('no_motion');const motionBadge=d.motion?'badge-warning':'badge-success';h+='<div class="info-item"><div class="info-label">Status</div><div class="info-value"><span class="badge '+motionBadge+'">'+motionText+'</span></div></div>';document.getElementById('motion-results').innerHTML=h;}
 setStatus('motion-status',d.result,d.success?'success':'error');}
@@ -249,6 +283,15 @@ async function applySDConfig(){const miso=document.getElementById('sdMiso').valu
 async function testSD(){setStatus('sd-status',{key:'test_in_progress'},null);const r=await fetch('/api/sd-test');const d=await r.json();setStatus('sd-status',d.result,d.success?'success':'error');}
 async function loadSDInfo(){setStatus('sd-status',{key:'loading'},null);const r=await fetch('/api/sd-info');const d=await r.json();const res=document.getElementById('sd-results');if(res&&d.available){res.innerHTML='<div class="info-item"><div class="info-label">Type</div><div class="info-value">'+d.type+'</div></div>'+'<div class="info-item"><div class="info-label">Taille</div><div class="info-value">'+d.size_mb+' MB</div></div>'+'<div class="info-item"><div class="info-label">Total</div><div class="info-value">'+d.total_mb+' MB</div></div>'+'<div class="info-item"><div class="info-label">Utilisé</div><div class="info-value">'+d.used_mb+' MB</div></div>';}
 setStatus('sd-status',d.result,d.available?'success':'error');}
+function renderSDBenchmark(d){const fmtBlock=b=>b>=1024?(b/1024)+' KB':b+' B';let h='';d.clocks.forEach(c=>{let v='';if(!c.mounted){v=tr('not_detected');}else{c.sequential.forEach(s=>{v+=fmtBlock(s.block)+': W '+s.write_mbps.toFixed(2)+' / R '+s.read_mbps.toFixed(2)+' MB/s (p99 '+s.write_us.p99+' / '+s.read_us.p99+' µs)<br>';});v+='4K random: '+c.random_4k.read_iops.toFixed(0)+' / '+c.random_4k.write_iops.toFixed(0)+' IOPS (p99 '+c.random_4k.read_us.p99+' / '+c.random_4k.write_us.p99+' µs)';}
+h+='<div class="info-item"><div class="info-label">SPI '+(c.khz/1000)+' MHz</div><div class="info-value" style="font-size:0.85em">'+v+'</div></div>';});document.getElementById('sd-results').innerHTML=h;}
+async function benchmarkSD(){setStatus('sd-status',{key:'test_in_progress'},null);const r=await fetch('/api/sd-benchmark');let d=await r.json();while(d.running){await new Promise(res=>setTimeout(res,1000));d=await(await fetch('/api/sd-benchmark-results')).json();}
+if(d.clocks)renderSDBenchmark(d);setStatus('sd-status',d.result||d.message,d.completed?'success':'error');}
+let sdLoggerInterval=null;function renderSDLogger(d){const btn=document.getElementById('sd-log-btn');if(btn){btn.textContent=d.running?'⏹️ '+tr('sd_log_stop'):'⏺️ '+tr('sd_log_start');btn.className=d.running?'btn btn-danger':'btn btn-success';}
+const items=[[tr('sd_log_file'),d.file+' ('+(d.file_bytes/1024).toFixed(1)+' KB)'],[tr('sd_log_records'),d.records_logged+' / '+d.records_dropped+' '+tr('sd_log_dropped')],[tr('sd_log_writes'),d.buffers_written+' ('+d.last_write_ms+' ms, max '+d.max_write_ms+' ms)'],[tr('sd_log_errors'),d.write_errors+' / '+d.late_ticks+' late, '+d.rotations+' rotations']];let h='';items.forEach(it=>{h+='<div class="info-item"><div class="info-label">'+it[0]+'</div><div class="info-value">'+it[1]+'</div></div>';});document.getElementById('sd-log-results').innerHTML=h;}
+async function toggleSDLogger(){const running=sdLoggerInterval!==null;let url='/api/sd-logger?action='+(running?'stop':'start');if(!running)url+='&interval_ms='+encodeURIComponent(document.getElementById('sdLogInterval').value);const r=await fetch(url);const d=await r.json();if(sdLoggerInterval){clearInterval(sdLoggerInterval);sdLoggerInterval=null;}
+if(d.success===false){setStatus('sd-status',d.message,'error');return;}
+renderSDLogger(d);if(d.running){sdLoggerInterval=setInterval(async()=>{const d=await(await fetch('/api/sd-logger')).json();renderSDLogger(d);if(!d.running){clearInterval(sdLoggerInterval);sdLoggerInterval=null;}},2000);}}
 async function testSDRead(){setStatus('sd-status',{key:'sd_read_test_running'},null);const r=await fetch('/api/sd-test-read');const d=await r.json();setStatus('sd-status',d.result,d.success?'success':'error');}
 async function testSDWrite(){setStatus('sd-status',{key:'sd_write_test_running'},null);const r=await fetch('/api/sd-test-write');const d=await r.json();setStatus('sd-status',d.result,d.success?'success':'error');}
 async function formatSD(){if(!confirm(tr('sd_format_confirm'))){return;}
@@ -382,14 +425,15 @@ String generateHTML() {
   html += diagnosticData.chipModel;
   html += "</span>";
   html += "</h1>";
-  bool ipAvailable = diagnosticData.ipAddress.length() > 0;
+  const AddressText ipText = formatIPv4(diagnosticData.ipAddress);
+  bool ipAvailable = diagnosticData.ipAddress != 0;
   String secureScheme = String(DIAGNOSTIC_SECURE_SCHEME);
   String legacyScheme = String(DIAGNOSTIC_LEGACY_SCHEME);
   String mdnsHost = String(MDNS_HOSTNAME_STR) + ".local";
   String mdnsLegacyUrl = legacyScheme + mdnsHost;
   String mdnsDisplayUrl = mdnsLegacyUrl;
-  String ipAccessHref = ipAvailable ? (legacyScheme + diagnosticData.ipAddress) : String("#");
-  String ipLegacyHref = ipAvailable ? (legacyScheme + diagnosticData.ipAddress) : String();
+  String ipAccessHref = ipAvailable ? (legacyScheme + ipText.text) : String("#");
+  String ipLegacyHref = ipAvailable ? (legacyScheme + ipText.text) : String();
   String ipAccessClass = String("access-link");
   if (!ipAvailable) {
     ipAccessClass += " disabled";
@@ -421,13 +465,13 @@ String generateHTML() {
   html += "' href='";
   html += ipAccessHref;
   html += "' data-access-host='";
-  html += (ipAvailable ? diagnosticData.ipAddress : String(""));
+  html += ipText.text;
   html += "' data-secure='";
   html += secureScheme;
   html += "' data-legacy='";
   html += legacyScheme;
   html += "' data-access-label='";
-  html += (ipAvailable ? diagnosticData.ipAddress : String(""));
+  html += ipText.text;
   html += "' data-legacy-label='";
   html += ipLegacyHref;
   html += "' data-label-id='ipAddressText' aria-disabled='";
@@ -577,9 +621,9 @@ String generateHTMLLite() {
   html += "</div>";
   html += "<div class='content'>";
   // Liens d'accès minimaux
-  bool ipAvailable = diagnosticData.ipAddress.length() > 0;
+  bool ipAvailable = diagnosticData.ipAddress != 0;
   String mdns = String(MDNS_HOSTNAME_STR) + ".local";
-  String href = ipAvailable ? String(DIAGNOSTIC_LEGACY_SCHEME) + diagnosticData.ipAddress : String("#");
+  String href = ipAvailable ? String(DIAGNOSTIC_LEGACY_SCHEME) + formatIPv4(diagnosticData.ipAddress).text : String("#");
   html += "<div class='section'><div class='access'>";
   html += "mDNS: <a href='http://"; html += mdns; html += "'>"; html += mdns; html += "</a>";
   html += " &nbsp; | &nbsp; IP: ";
@@ -0,0 +1,96 @@
+/*
+ * BENCH.H - Micro-benchmark harness for the native env
+ * Google Benchmark style: BENCH(name) registers a function, the timed region
+ * is the `for (auto _ : state)` loop. Setup before the loop is not measured.
+ * Reports ns/op plus allocations and bytes per iteration from shim_heap.h
+ */
+
+#ifndef NATIVE_BENCH_H
+#define NATIVE_BENCH_H
+
+#include <chrono>
+#include <cstdint>
+#include "shim_heap.h"
+
+class BenchState {
+public:
+  explicit BenchState(uint64_t iterations) : iterations(iterations) {}
+
+  struct Value {
+    ~Value() {}  // Non trivial : pas d'avertissement "unused variable" sur `_`
+  };
+
+  class Iterator {
+  public:
+    Iterator(BenchState* state, uint64_t remaining) : state(state), remaining(remaining) {}
+    Value operator*() const { return Value(); }
+    Iterator& operator++() {
+      remaining--;
+      return *this;
+    }
+    bool operator!=(const Iterator&) {
+      if (remaining) return true;
+      state->stop();
+      return false;
+    }
+
+  private:
+    BenchState* state;
+    uint64_t remaining;
+  };
+
+  Iterator begin() {
+    heapStart = shimHeap;
+    start = std::chrono::steady_clock::now();
+    return Iterator(this, iterations);
+  }
+  Iterator end() { return Iterator(this, 0); }
+
+  const uint64_t iterations;
+  double elapsedNs = 0;
+  uint64_t allocations = 0;
+  uint64_t bytesAllocated = 0;
+
+private:
+  void stop() {
+    elapsedNs = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    allocations = shimHeap.allocations - heapStart.allocations;
+    bytesAllocated = shimHeap.bytesAllocated - heapStart.bytesAllocated;
+  }
+
+  std::chrono::steady_clock::time_point start;
+  ShimHeapStats heapStart = {};
+};
+
+typedef void (*BenchFunction)(BenchState& state);
+
+struct BenchRegistrar {
+  BenchRegistrar(const char* name, BenchFunction function);
+};
+
+// Sanity check on a benchmark's output; failures of the final (reported) run
+// are printed and make the process exit with 1
+bool benchCheck(bool condition, const char* expression, const char* file, int line);
+
+// Shared fixture (bench_sensors.cpp): fake AHT20 + BMP280 on Wire, sensors initialised
+void benchAttachEnvironmentalSensors();
+
+#define BENCH(name)                                                   \
+  static void bench_##name(BenchState& state);                        \
+  static BenchRegistrar benchRegistrar_##name(#name, bench_##name);   \
+  static void bench_##name(BenchState& state)
+
+#define BENCH_CHECK(condition) benchCheck((condition), #condition, __FILE__, __LINE__)
+
+// Allocation budget per iteration, checked after the timed loop
+#define BENCH_ALLOC_BUDGET(perIteration) \
+  BENCH_CHECK(state.allocations <= (uint64_t)(perIteration) * state.iterations)
+
+// Keeps the compiler from discarding a result computed inside the loop
+template <typename T>
+inline void benchKeep(const T& value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+#endif // NATIVE_BENCH_H
@@ -0,0 +1,126 @@
+/*
+ * BENCH_API.CPP - JSON building, CBOR transcoding and handler dispatch
+ */
+
+#include <Arduino.h>
+#include "alloc_tracer.h"
+#include "api_routes.h"
+#include "bench.h"
+#include "cbor_encoder.h"
+#include "environmental_sensors.h"
+#include "gps_module.h"
+#include "http_alloc_budgets.h"
+#include "http_metrics.h"
+#include "json_helpers.h"
+#include "request_arena.h"
+
+// Réponse /api/overview typique (~1 Ko)
+static const char OVERVIEW_JSON[] =
+    "{\"chip\":{\"model\":\"ESP32-S3\",\"revision\":\"0\",\"cores\":2,\"freq\":240,"
+    "\"mac\":\"F4:12:FA:5C:38:A0\",\"uptime\":86400123,\"temperature\":41.5},"
+    "\"memory\":{\"sram\":{\"total\":327680,\"free\":198432,\"used\":129248},"
+    "\"psram\":{\"total\":8386295,\"free\":8180224,\"used\":206071},"
+    "\"flash\":{\"total\":16777216,\"type\":\"QIO\"},\"fragmentation\":12.4},"
+    "\"wifi\":{\"connected\":true,\"ssid\":\"Atelier \\\"lab\\\"\",\"rssi\":-61,"
+    "\"quality\":\"Good\",\"ip\":\"192.168.1.20\",\"gateway\":\"192.168.1.1\","
+    "\"dns\":\"192.168.1.1\",\"channel\":6},"
+    "\"gpio\":{\"total\":45,\"available\":[1,2,4,5,6,7,15,16,17,18,21,38,39,40,41,42],"
+    "\"i2c\":{\"sda\":21,\"scl\":20},\"spi\":{\"mosi\":11,\"miso\":13,\"sclk\":12}}}";
+
+static const char ESCAPE_INPUT[] = "SSID \"Atelier\"\tcanal 6\r\nC:\\esp32\\diag";
+
+BENCH(json_build_object) {
+  String value;
+  for (auto _ : state) {
+    value = buildJsonObject({
+        jsonBoolField("success", true),
+        jsonStringField("model", "ESP32-S3"),
+        jsonNumberField("cores", 2),
+        jsonNumberField("freq", 240),
+        jsonNumberField("heap", 198432u),
+        jsonFloatField("temperature", 41.53, 1),
+        jsonStringField("ssid", "Atelier \"lab\""),
+        jsonNumberField("rssi", -61),
+        jsonStringField("ip", "192.168.1.20"),
+        jsonFloatField("fragmentation", 12.4),
+    });
+    benchKeep(value);
+  }
+  BENCH_CHECK(value.startsWith("{\"success\":true,\"model\":\"ESP32-S3\""));
+  BENCH_CHECK(value.indexOf("\"ssid\":\"Atelier \\\"lab\\\"\"") > 0);
+  BENCH_ALLOC_BUDGET(3);
+}
+
+BENCH(json_escape) {
+  String escaped;
+  for (auto _ : state) {
+    escaped = jsonEscape(ESCAPE_INPUT);
+    benchKeep(escaped);
+  }
+  BENCH_CHECK(escaped == "SSID \\\"Atelier\\\"\\tcanal 6\\r\\nC:\\\\esp32\\\\diag");
+  BENCH_ALLOC_BUDGET(1);
+}
+
+BENCH(cbor_transcode_overview) {
+  static uint8_t out[1024];
+  size_t size = 0;
+  for (auto _ : state) {
+    size = jsonToCbor(OVERVIEW_JSON, sizeof(OVERVIEW_JSON) - 1, out, sizeof(out));
+    benchKeep(size);
+  }
+  BENCH_CHECK(size > 0 && size < sizeof(OVERVIEW_JSON) - 1);
+  BENCH_CHECK(jsonToCbor(OVERVIEW_JSON, sizeof(OVERVIEW_JSON) - 1, nullptr, 0) == size);
+  BENCH_ALLOC_BUDGET(0);
+}
+
+static DiagnosticWebServer benchServer(80);
+
+// Mêmes handlers que setupWebServer() dans main.cpp, budgets de http_alloc_budgets.h
+static void benchRegisterRoutes() {
+  static bool registered = false;
+  if (!registered) {
+    requestArena.begin(REQUEST_ARENA_SIZE);
+    benchServer.on("/api/environmental-sensors", []() {
+      updateEnvironmentalSensors();
+      sendEnvironmentalSensors(benchServer, envData);
+    }, HTTP_ALLOC_BUDGET_ENVIRONMENTAL);
+    benchServer.on("/api/gps", []() {
+      updateGPS();
+      sendGPSData(benchServer, gpsData);
+    }, HTTP_ALLOC_BUDGET_GPS);
+    registered = true;
+  }
+}
+
+BENCH(http_gps) {
+  benchRegisterRoutes();
+  // Horloge figée : X-Gen-Us garde la même longueur, donc le même nombre d'allocations par appel
+  shimFreezeClock(true);
+  benchServer.shimRequest("/api/gps");  // Premier appel : fait grandir le tampon d'en-têtes
+  AllocCounters allocs = {};
+  for (auto _ : state) {
+    allocs = {};
+    AllocScope scope(allocs);
+    benchServer.shimRequest("/api/gps");
+  }
+  shimFreezeClock(false);
+  BENCH_CHECK(benchServer.shimCode == 200);
+  BENCH_CHECK(strstr(benchServer.shimBody, "\"fix_type\":\"") != nullptr);
+  BENCH_CHECK((uint64_t)allocs.allocations * state.iterations == state.allocations);
+  BENCH_CHECK(allocs.live == 0);
+  BENCH_ALLOC_BUDGET(HTTP_ALLOC_RESPONSE + HTTP_ALLOC_HANDLER_ARENA);
+}
+
+BENCH(http_environmental_sensors) {
+  benchAttachEnvironmentalSensors();
+  benchRegisterRoutes();
+  benchServer.shimRequest("/api/environmental-sensors");
+  for (auto _ : state) {
+    benchServer.shimRequest("/api/environmental-sensors");
+  }
+  BENCH_CHECK(benchServer.shimCode == 200);
+  BENCH_CHECK(strcmp(benchServer.shimContentType, "application/json") == 0);
+  BENCH_CHECK(benchServer.shimBodyLength > 0 && benchServer.shimBody[0] == '{');
+  BENCH_CHECK(strstr(benchServer.shimBody, "\"combined_status\":\"Both sensors OK\"") != nullptr);
+  BENCH_ALLOC_BUDGET(HTTP_ALLOC_RESPONSE + HTTP_ALLOC_HANDLER_ARENA);
+}
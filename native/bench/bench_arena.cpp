@@ -0,0 +1,66 @@
+/*
+ * BENCH_ARENA.CPP - Request arena: response text build + reset, heap spill
+ */
+
+#include <Arduino.h>
+#include "alloc_tracer.h"
+#include "bench.h"
+#include "json_helpers.h"
+#include "request_arena.h"
+
+// Une réponse /api/dashboard complète : ~1,5 Ko en sections printf et champs échappés
+static size_t benchBuildDashboard(RequestArena& arena) {
+  ArenaText json(256, arena);  // Volontairement petit : la croissance en place est mesurée aussi
+  json += "{";
+  for (int section = 0; section < 7; section++) {
+    json.printf("%s\"section%d\":{\"model\":\"%s\",\"cores\":%d,\"freq\":%u,\"uptime\":%lu,\"temperature\":%.1f,",
+                section ? "," : "", section, "ESP32-S3", 2, 240u, 86400123ul, 41.53);
+    json.printf("\"sram\":{\"total\":%u,\"free\":%u,\"used\":%u},\"fragmentation\":%.1f,",
+                327680u, 198432u, 129248u, 12.4);
+    json += "\"wifi\":{\"ssid\":\"";
+    jsonEscapeTo(json, "Atelier \"lab\"");
+    json += '"';
+    bool first = false;
+    appendJsonField(json, first, jsonNumberField("rssi", -61));  // Valeur courte : String sans tas
+    json += "}}";
+  }
+  json += "}";
+  return json.ok() ? json.length() : 0;
+}
+
+BENCH(arena_dashboard_text) {
+  static RequestArena arena;
+  arena.begin(REQUEST_ARENA_SIZE);
+  size_t length = 0;
+  for (auto _ : state) {
+    length = benchBuildDashboard(arena);
+    arena.reset();
+    benchKeep(length);
+  }
+  RequestArenaStats stats;
+  arena.stats(stats);
+  BENCH_CHECK(length > 1400);
+  BENCH_CHECK(stats.used == 0 && stats.spills == 0 && stats.failures == 0);
+  BENCH_CHECK(stats.highWater < 2 * length);  // Croissance en place : pas de copies abandonnées
+  BENCH_ALLOC_BUDGET(0);
+}
+
+BENCH(arena_spill_to_heap) {
+  static RequestArena arena;
+  arena.begin(512);  // Trop petit pour la réponse : le reste part sur le tas
+  size_t length = 0;
+  AllocCounters allocs = {};
+  for (auto _ : state) {
+    allocs = {};
+    AllocScope scope(allocs);
+    length = benchBuildDashboard(arena);
+    arena.reset();
+    benchKeep(length);
+  }
+  RequestArenaStats stats;
+  arena.stats(stats);
+  BENCH_CHECK(length > 1400);
+  BENCH_CHECK(stats.spills > 0 && stats.failures == 0);
+  BENCH_CHECK(allocs.live == 0);  // Débordements libérés par reset()
+  BENCH_ALLOC_BUDGET(REQUEST_ARENA_MAX_SPILLS);
+}
@@ -0,0 +1,108 @@
+/*
+ * BENCH_DHT.CPP - DHT frame decoding and the background read cycle
+ * (dht_sensor.cpp) against a simulated DHT22 driven through the pin shim
+ */
+
+#include <Arduino.h>
+#include "bench.h"
+#include "dht_sensor.h"
+
+#define BENCH_DHT_PIN 40
+
+// DHT22 : 48.2 %RH, 21.4 °C
+static const uint8_t dhtFrame[5] = {0x01, 0xE2, 0x00, 0xD6, 0xB9};
+
+// Fronts d'une réponse complète, avec une gigue de quelques µs (ISR retardée par le Wi-Fi)
+static uint8_t buildDHTEdges(const uint8_t data[5], uint32_t* edges) {
+  uint32_t t = 1000;
+  uint8_t count = 0;
+  edges[count++] = t;        // Relâchement de la ligne
+  t += 30;
+  edges[count++] = t;        // Réponse : 80 µs bas, 80 µs haut
+  t += 80;
+  edges[count++] = t;
+  t += 80;
+  for (uint8_t bit = 0; bit < 40; bit++) {
+    bool one = (data[bit / 8] >> (7 - bit % 8)) & 1;
+    edges[count++] = t;      // Début du bit : 50 µs bas
+    t += 50 + bit % 3;
+    edges[count++] = t;      // Impulsion haute : la durée code le bit
+    t += (one ? 70 : 27) + bit % 5;
+  }
+  edges[count++] = t;        // 50 µs bas, puis la ligne est relâchée
+  t += 50;
+  edges[count++] = t;
+  return count;
+}
+
+// Le capteur simulé rejoue la trame sur la broche : chaque front passe par l'ISR du lecteur
+static void playDHTFrame(const uint8_t data[5]) {
+  uint32_t edges[DHT_MAX_EDGES];
+  uint8_t count = buildDHTEdges(data, edges);
+  int level = LOW;
+  for (uint8_t i = 0; i < count; i++) {
+    if (i) shimAdvanceMicros(edges[i] - edges[i - 1]);
+    level = level == LOW ? HIGH : LOW;
+    shimSetPinLevel(BENCH_DHT_PIN, level);
+  }
+}
+
+static void runDHTCycle(const uint8_t data[5]) {
+  requestDHTRead();
+  maintainDHTSensor();       // Impulsion de départ DHT22 puis interruption armée
+  playDHTFrame(data);
+  shimAdvanceMicros(10000);
+  maintainDHTSensor();       // Décodage
+}
+
+// Trames abîmées, checksum et conversion : test_dht_* (test/test_native)
+BENCH(dht_decode_frame) {
+  uint32_t edges[DHT_MAX_EDGES];
+  uint8_t count = buildDHTEdges(dhtFrame, edges);
+  uint8_t data[5] = {0};
+  DHTReadResult result = DHT_READ_NONE;
+  for (auto _ : state) {
+    result = decodeDHTFrame(edges, count, data);
+    benchKeep(data);
+  }
+  BENCH_CHECK(count == 85 && result == DHT_READ_OK && memcmp(data, dhtFrame, 5) == 0);
+  BENCH_ALLOC_BUDGET(0);
+}
+
+BENCH(dht_background_read) {
+  beginDHTSensor(BENCH_DHT_PIN, 22);
+  for (auto _ : state) {
+    runDHTCycle(dhtFrame);
+  }
+  const DHTSensorStatus& status = dhtSensorStatus;
+  // Une préemption de l'hôte entre deux fronts simulés allonge une impulsion,
+  // comme une ISR servie en retard : trame rejetée et comptée, jamais acceptée fausse
+  BENCH_CHECK(status.reads == state.iterations);
+  BENCH_CHECK(status.okReads + status.timeouts + status.frameErrors + status.checksumErrors == status.reads);
+  BENCH_CHECK(status.okReads * 100 >= status.reads * 99);
+  BENCH_CHECK(status.lastEdges == 85);
+  BENCH_CHECK(fabsf(status.temperature - 21.4f) < 0.01f && fabsf(status.humidity - 48.2f) < 0.01f);
+  BENCH_ALLOC_BUDGET(0);
+}
+
+BENCH(dht_median_rejects_outliers) {
+  // 85.0 °C avec un checksum correct : valeur aberrante que seule la médiane écarte
+  static const uint8_t spike[5] = {0x01, 0xE2, 0x03, 0x52, 0x38};
+  uint8_t corrupted[5];
+  memcpy(corrupted, dhtFrame, sizeof(corrupted));
+  corrupted[1] ^= 0x04;      // Bit inversé : checksum faux
+  for (auto _ : state) {
+    beginDHTSensor(BENCH_DHT_PIN, 22);
+    runDHTCycle(dhtFrame);
+    runDHTCycle(spike);
+    runDHTCycle(dhtFrame);
+    runDHTCycle(corrupted);
+    runDHTCycle(dhtFrame);
+  }
+  const DHTSensorStatus& status = dhtSensorStatus;
+  BENCH_CHECK(status.samples >= 3 && status.checksumErrors + status.frameErrors >= 1);  // 4 sans préemption de l'hôte
+  BENCH_CHECK(fabsf(status.lastTemperature - 21.4f) < 0.01f);
+  BENCH_CHECK(fabsf(status.temperature - 21.4f) < 0.01f);
+  stopDHTSensor();
+  BENCH_ALLOC_BUDGET(0);
+}
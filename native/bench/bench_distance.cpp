@@ -0,0 +1,86 @@
+/*
+ * BENCH_DISTANCE.CPP - HC-SR04 ranging engine (distance_sensor.cpp):
+ * conversion, filters, and the trigger/echo cycle against a simulated module
+ */
+
+#include <Arduino.h>
+#include "bench.h"
+#include "config.h"
+#include "distance_sensor.h"
+
+#define BENCH_TRIG_PIN 12
+#define BENCH_ECHO_PIN 13
+
+// Un cycle complet : déclenchement, écho simulé sur la broche ECHO, décodage
+static void runDistanceCycle(uint32_t echoUs) {
+  requestDistanceReading();
+  maintainDistanceSensor();
+  shimAdvanceMicros(450);    // Salve de 8 impulsions à 40 kHz avant la montée d'ECHO
+  shimSetPinLevel(BENCH_ECHO_PIN, HIGH);
+  shimAdvanceMicros(echoUs);
+  shimSetPinLevel(BENCH_ECHO_PIN, LOW);
+  shimAdvanceMicros(1000);
+  maintainDistanceSensor();
+}
+
+// Conversion, filtres et curseur de l'anneau : test_distance_* (test/test_native)
+BENCH(distance_sound_speed) {
+  float distance = 0.0f;
+  for (auto _ : state) {
+    distance = echoToDistanceCm(5831, 20.0f);
+    benchKeep(distance);
+  }
+  BENCH_CHECK(fabsf(distance - 100.0f) < 0.1f);
+  BENCH_ALLOC_BUDGET(0);
+}
+
+BENCH(distance_filters) {
+  static const float readings[8] = {100.2f, 99.8f, 250.0f, 100.1f, 99.9f, 100.3f, 3.0f, 100.0f};
+  float window[DISTANCE_MEDIAN_WINDOW];
+  float filtered = 0.0f;
+  float worst = 0.0f;
+  for (auto _ : state) {
+    DistanceKalman kalman;
+    uint8_t count = 0;
+    worst = 0.0f;
+    for (uint8_t i = 0; i < 8; i++) {
+      window[i % DISTANCE_MEDIAN_WINDOW] = readings[i];
+      if (count < DISTANCE_MEDIAN_WINDOW) count++;
+      filtered = kalman.update(medianDistanceValue(window, count));
+      if (i >= 2 && fabsf(filtered - 100.0f) > worst) worst = fabsf(filtered - 100.0f);
+    }
+    benchKeep(filtered);
+  }
+  // Échos parasites isolés (250 cm, 3 cm) : écartés par la médiane avant le Kalman
+  BENCH_CHECK(worst < 0.5f);
+  BENCH_ALLOC_BUDGET(0);
+}
+
+BENCH(distance_background_cycle) {
+  beginDistanceSensor(BENCH_TRIG_PIN, BENCH_ECHO_PIN, 10);
+  for (auto _ : state) {
+    runDistanceCycle(5831);
+  }
+  const DistanceSensorStatus& status = distanceSensorStatus;
+  float expected = echoToDistanceCm(5831, status.temperatureC);
+  // Préemption de l'hôte entre les deux fronts simulés : écho plus long, absorbé par la médiane
+  // (ou hors plage s'il dépasse ~4 m)
+  BENCH_CHECK(status.triggers == state.iterations && status.readings + status.outOfRange == state.iterations);
+  BENCH_CHECK(status.timeouts == 0 && status.busySkips == 0);
+  BENCH_CHECK(fabsf(status.filteredCm - expected) < 0.5f);
+  BENCH_ALLOC_BUDGET(0);
+}
+
+BENCH(distance_no_echo_timeout) {
+  beginDistanceSensor(BENCH_TRIG_PIN, BENCH_ECHO_PIN, 10);
+  for (auto _ : state) {
+    requestDistanceReading();
+    maintainDistanceSensor();
+    shimAdvanceMicros(DISTANCE_ECHO_TIMEOUT_MS * 1000UL);
+    maintainDistanceSensor();
+  }
+  const DistanceSensorStatus& status = distanceSensorStatus;
+  BENCH_CHECK(status.timeouts == state.iterations && status.readings == 0 && !status.valid);
+  stopDistanceSensor();
+  BENCH_ALLOC_BUDGET(0);
+}
@@ -0,0 +1,430 @@
+/*
+ * BENCH_GPS.CPP - NMEA and UBX parsing benchmarks (gps_module.cpp, ubx_protocol.cpp)
+ * and the PPS timekeeping fit (gps_time.cpp) against a simulated drifting clock
+ */
+
+#include <Arduino.h>
+#include "bench.h"
+#include "gps_module.h"
+#include "gps_time.h"
+#include "ubx_protocol.h"
+
+#define BENCH_PPS_PIN 41
+#define BENCH_PPS_DRIFT_PPM 20      // Oscillateur local rapide : 1 000 020 µs par seconde GPS
+
+// Une seconde de sortie d'un récepteur NEO-6M (RMC, GGA, GSA, 3 GSV)
+static const char NMEA_BURST[] =
+    "$GPRMC,123519.00,A,4807.03812,N,01131.00046,E,0.224,84.40,230326,,,A*6A\r\n"
+    "$GPGGA,123519.00,4807.03812,N,01131.00046,E,1,08,0.94,545.4,M,46.9,M,,*47\r\n"
+    "$GPGSA,A,3,04,05,09,12,24,25,29,31,,,,,1.61,0.94,1.31*0D\r\n"
+    "$GPGSV,3,1,11,04,47,283,38,05,10,043,29,09,31,116,41,12,65,201,44*7B\r\n"
+    "$GPGSV,3,2,11,24,22,312,33,25,76,059,45,29,41,147,40,31,08,246,26*72\r\n"
+    "$GPGSV,3,3,11,02,03,030,,14,05,332,,20,12,161,18*4C\r\n";
+
+// Récepteur multi-GNSS (NMEA 4.10) : un GSA par constellation avec l'ID de système,
+// GSV GPS en L1 puis en L5 (signal 8, ignoré), GLONASS, Galileo (E1, signal 7), BeiDou
+static const char MULTI_GNSS_BURST[] =
+    "$GNGSA,A,3,02,05,12,13,15,20,24,25,,,,,1.21,0.66,1.01,1*02\r\n"
+    "$GNGSA,A,3,65,66,72,80,,,,,,,,,1.21,0.66,1.01,2*0E\r\n"
+    "$GNGSA,A,3,03,05,13,,,,,,,,,,1.21,0.66,1.01,3*05\r\n"
+    "$GNGSA,A,3,07,10,,,,,,,,,,,1.21,0.66,1.01,4*00\r\n"
+    "$GPGSV,3,1,10,02,48,302,42,05,21,061,35,12,67,118,47,13,11,291,28,1*62\r\n"
+    "$GPGSV,3,2,10,15,36,201,44,18,05,322,,20,22,148,39,24,54,075,45,1*68\r\n"
+    "$GPGSV,3,3,10,25,29,257,41,29,13,034,31,1*60\r\n"
+    "$GPGSV,2,1,07,02,48,302,40,05,21,061,33,12,67,118,44,15,36,201,41,8*6E\r\n"
+    "$GPGSV,2,2,07,24,54,075,43,25,29,257,38,29,13,034,,8*51\r\n"
+    "$GLGSV,2,1,06,65,42,044,38,66,71,285,43,72,18,125,30,80,35,334,37,1*7A\r\n"
+    "$GLGSV,2,2,06,81,09,205,,87,23,097,29,1*72\r\n"
+    "$GAGSV,1,1,04,03,62,098,44,05,27,303,40,13,41,212,42,21,08,151,,7*7B\r\n"
+    "$GBGSV,1,1,03,07,55,178,41,10,33,258,37,23,14,061,,1*40\r\n";
+
+static const GPSSatellite* findSatellite(GPSConstellation system, uint16_t prn) {
+  for (uint8_t i = 0; i < gpsSkyView.count; i++) {
+    if (gpsSkyView.satellites[i].system == system && gpsSkyView.satellites[i].prn == prn) {
+      return &gpsSkyView.satellites[i];
+    }
+  }
+  return nullptr;
+}
+
+static const char RMC_SENTENCE[] = "$GPRMC,123519.00,A,4807.03812,N,01131.00046,E,0.224,84.40,230326,,,A*6A";
+
+BENCH(gps_nmea_burst) {
+  Serial1.begin(9600);
+  gpsAvailable = true;
+  resetGPSSkyView();
+  // Premier passage : le tampon de ligne statique de updateGPS() atteint sa taille
+  Serial1.shimFeed(NMEA_BURST, sizeof(NMEA_BURST) - 1);
+  updateGPS();
+  for (auto _ : state) {
+    Serial1.shimFeed(NMEA_BURST, sizeof(NMEA_BURST) - 1);
+    updateGPS();
+  }
+  BENCH_CHECK(gpsData.hasFix);
+  BENCH_CHECK(gpsData.satellites == 8);
+  BENCH_CHECK(gpsData.satellites_used == 8);
+  BENCH_CHECK(gpsData.fix_type == "3D");
+  BENCH_CHECK(fabsf(gpsData.latitude - 48.11730f) < 1e-4f);
+  BENCH_CHECK(fabsf(gpsData.longitude - 11.51667f) < 1e-4f);
+  BENCH_CHECK(gpsData.year == 2026 && gpsData.month == 3 && gpsData.day == 23);
+  BENCH_CHECK(gpsData.satellites_in_view == 11 && gpsSkyView.tracked == 9 && gpsSkyView.maxSnr == 45);
+  BENCH_CHECK(gpsSkyView.ttffMs > 0 && gpsSkyView.gsvErrors == 0);
+  BENCH_ALLOC_BUDGET(0);  // Champs courts : tampon interne de String
+}
+
+BENCH(gps_multi_gnss_skyview) {
+  Serial1.begin(9600);
+  gpsAvailable = true;
+  resetGPSSkyView();
+  for (auto _ : state) {
+    Serial1.shimFeed(MULTI_GNSS_BURST, sizeof(MULTI_GNSS_BURST) - 1);
+    updateGPS();
+  }
+  const GPSSkyView& sky = gpsSkyView;
+  BENCH_CHECK(sky.count == 23 && sky.used == 17 && sky.tracked == 19);
+  BENCH_CHECK(gpsData.satellites_used == 17 && gpsData.satellites_in_view == 23);
+  BENCH_CHECK(sky.maxSnr == 47 && sky.meanSnr == 39);
+  BENCH_CHECK(sky.gsvBursts == state.iterations * 4 && sky.gsvErrors == 0);
+  BENCH_CHECK(fabsf(gpsData.vdop - 1.01f) < 1e-4f);  // Pas l'ID de système en dernier champ
+  // Même PRN dans deux constellations : entrées distinctes
+  const GPSSatellite* gps05 = findSatellite(GPS_SYSTEM_GPS, 5);
+  const GPSSatellite* gal05 = findSatellite(GPS_SYSTEM_GALILEO, 5);
+  BENCH_CHECK(gps05 && gps05->snr == 35 && gps05->usedInFix);    // L1, pas la valeur L5
+  BENCH_CHECK(gal05 && gal05->elevation == 27 && gal05->azimuth == 303 && gal05->usedInFix);
+  const GPSSatellite* glo81 = findSatellite(GPS_SYSTEM_GLONASS, 81);
+  BENCH_CHECK(glo81 && glo81->snr == 0 && !glo81->usedInFix);
+
+  // Phrase 2/3 perdue : rafale abandonnée, la table GPS précédente reste servie
+  static const char lost[] =
+      "$GPGSV,3,1,10,02,48,302,12,05,21,061,11,12,67,118,10,13,11,291,09,1*60\r\n"
+      "$GPGSV,3,3,10,25,29,257,41,29,13,034,31,1*60\r\n";
+  Serial1.shimFeed(lost, sizeof(lost) - 1);
+  updateGPS();
+  BENCH_CHECK(sky.gsvErrors == 1 && sky.count == 23);
+  BENCH_CHECK(findSatellite(GPS_SYSTEM_GPS, 2)->snr == 42);
+  BENCH_ALLOC_BUDGET(0);
+}
+
+BENCH(gps_parse_rmc) {
+  String sentence(RMC_SENTENCE);
+  for (auto _ : state) {
+    parseGPRMC(sentence);
+  }
+  BENCH_CHECK(gpsData.valid);
+  BENCH_CHECK(gpsData.hour == 12 && gpsData.minute == 35 && gpsData.second == 19);
+  BENCH_ALLOC_BUDGET(0);
+}
+
+// Relecture de 10 époques à 1 fix chacune : même contenu en NMEA (RMC, GGA, GSA, 3 GSV)
+// et en UBX (NAV-PVT + NAV-SAT + NAV-DOP), pour comparer le coût d'analyse par fix
+#define REPLAY_EPOCHS 10
+
+struct ReplaySatellite {
+  uint8_t prn;
+  int8_t elevation;
+  uint16_t azimuth;
+  uint8_t snr;
+  bool used;
+};
+
+static const ReplaySatellite replaySatellites[11] = {
+  {4, 47, 283, 38, true}, {5, 10, 43, 29, true}, {9, 31, 116, 41, true}, {12, 65, 201, 44, true},
+  {24, 22, 312, 33, true}, {25, 76, 59, 45, true}, {29, 41, 147, 40, true}, {31, 8, 246, 26, true},
+  {2, 3, 30, 0, false}, {14, 5, 332, 0, false}, {20, 12, 161, 18, false}
+};
+
+struct ReplayEpoch {
+  char data[640];
+  size_t size;
+};
+
+static ReplayEpoch nmeaReplay[REPLAY_EPOCHS];
+static ReplayEpoch ubxReplay[REPLAY_EPOCHS];
+
+static void appendNMEA(ReplayEpoch& epoch, const char* body) {
+  uint8_t checksum = 0;
+  for (const char* p = body; *p; p++) checksum ^= (uint8_t)*p;
+  epoch.size += snprintf(epoch.data + epoch.size, sizeof(epoch.data) - epoch.size, "$%s*%02X\r\n", body, checksum);
+}
+
+static void putU2(uint8_t* p, uint16_t value) {
+  p[0] = value & 0xFF;
+  p[1] = value >> 8;
+}
+
+static void putU4(uint8_t* p, uint32_t value) {
+  for (uint8_t i = 0; i < 4; i++) p[i] = (value >> (8 * i)) & 0xFF;
+}
+
+static void buildReplay() {
+  static bool built = false;
+  if (built) return;
+  built = true;
+  char body[96];
+  for (uint8_t e = 0; e < REPLAY_EPOCHS; e++) {
+    uint32_t minutes = 703812 + e * 10;       // 07.03812' + e x 0.0001'
+    ReplayEpoch& nmea = nmeaReplay[e];
+    nmea.size = 0;
+    snprintf(body, sizeof(body), "GPRMC,1235%02u.00,A,48%02lu.%05lu,N,01131.00046,E,0.224,84.40,230326,,,A",
+             10 + e, (unsigned long)(minutes / 100000), (unsigned long)(minutes % 100000));
+    appendNMEA(nmea, body);
+    snprintf(body, sizeof(body), "GPGGA,1235%02u.00,48%02lu.%05lu,N,01131.00046,E,1,08,0.94,545.4,M,46.9,M,,",
+             10 + e, (unsigned long)(minutes / 100000), (unsigned long)(minutes % 100000));
+    appendNMEA(nmea, body);
+    appendNMEA(nmea, "GPGSA,A,3,04,05,09,12,24,25,29,31,,,,,1.61,0.94,1.31");
+    for (uint8_t m = 0; m < 3; m++) {
+      int n = snprintf(body, sizeof(body), "GPGSV,3,%u,11", m + 1);
+      for (uint8_t i = m * 4; i < 11 && i < m * 4 + 4; i++) {
+        const ReplaySatellite& sat = replaySatellites[i];
+        n += snprintf(body + n, sizeof(body) - n, ",%02u,%02d,%03u,", sat.prn, sat.elevation, sat.azimuth);
+        if (sat.snr) n += snprintf(body + n, sizeof(body) - n, "%02u", sat.snr);
+      }
+      appendNMEA(nmea, body);
+    }
+
+    uint8_t pvt[UBX_NAV_PVT_LENGTH] = {0};
+    putU4(pvt, 131728000 + e * 1000);         // iTOW
+    putU2(pvt + 4, 2026);
+    pvt[6] = 3;
+    pvt[7] = 23;
+    pvt[8] = 12;
+    pvt[9] = 35;
+    pvt[10] = 10 + e;
+    pvt[11] = 0x07;                           // validDate | validTime | fullyResolved
+    pvt[20] = 3;                              // 3D
+    pvt[21] = 0x01;                           // gnssFixOK
+    pvt[23] = 8;
+    putU4(pvt + 24, (uint32_t)(int32_t)lround((11.0 + 31.00046 / 60.0) * 1e7));
+    putU4(pvt + 28, (uint32_t)(int32_t)lround((48.0 + minutes / 100000.0 / 60.0) * 1e7));
+    putU4(pvt + 36, 545400);                  // hMSL, mm
+    putU4(pvt + 40, 1800);                    // hAcc, mm
+    putU4(pvt + 60, 115);                     // 0.224 nœud
+    putU4(pvt + 64, 8440000);
+    putU2(pvt + 76, 161);
+    uint8_t sat[UBX_NAV_SAT_HEADER + 11 * UBX_NAV_SAT_BLOCK] = {0};
+    putU4(sat, 131728000 + e * 1000);
+    sat[4] = 1;
+    sat[5] = 11;
+    for (uint8_t i = 0; i < 11; i++) {
+      uint8_t* block = sat + UBX_NAV_SAT_HEADER + i * UBX_NAV_SAT_BLOCK;
+      block[1] = replaySatellites[i].prn;
+      block[2] = replaySatellites[i].snr;
+      block[3] = (uint8_t)replaySatellites[i].elevation;
+      putU2(block + 4, replaySatellites[i].azimuth);
+      putU4(block + 8, replaySatellites[i].used ? 0x0F : 0x01);   // svUsed | qualityInd
+    }
+    uint8_t dop[UBX_NAV_DOP_LENGTH] = {0};
+    putU4(dop, 131728000 + e * 1000);
+    putU2(dop + 6, 161);                      // pDOP
+    putU2(dop + 10, 131);                     // vDOP
+    putU2(dop + 12, 94);                      // hDOP
+    ReplayEpoch& ubx = ubxReplay[e];
+    ubx.size = ubxBuildFrame(UBX_CLASS_NAV, UBX_NAV_PVT, pvt, sizeof(pvt), (uint8_t*)ubx.data);
+    ubx.size += ubxBuildFrame(UBX_CLASS_NAV, UBX_NAV_SAT, sat, sizeof(sat), (uint8_t*)ubx.data + ubx.size);
+    ubx.size += ubxBuildFrame(UBX_CLASS_NAV, UBX_NAV_DOP, dop, sizeof(dop), (uint8_t*)ubx.data + ubx.size);
+  }
+}
+
+static void checkReplayFix() {
+  BENCH_CHECK(gpsData.hasFix && gpsData.fix_type == "3D");
+  BENCH_CHECK(gpsData.satellites == 8 && gpsData.satellites_used == 8 && gpsData.satellites_in_view == 11);
+  BENCH_CHECK(gpsSkyView.tracked == 9 && gpsSkyView.maxSnr == 45);
+  BENCH_CHECK(fabsf(gpsData.latitude - 48.11730f) < 1e-4f && fabsf(gpsData.longitude - 11.51667f) < 1e-4f);
+  BENCH_CHECK(fabsf(gpsData.altitude - 545.4f) < 0.01f && fabsf(gpsData.speed - 0.224f) < 0.001f);
+  BENCH_CHECK(gpsData.year == 2026 && gpsData.month == 3 && gpsData.day == 23 && gpsData.hour == 12);
+  BENCH_CHECK(fabsf(gpsData.hdop - 0.94f) < 1e-4f && fabsf(gpsData.vdop - 1.31f) < 1e-4f);
+}
+
+BENCH(gps_replay_nmea_fix) {
+  buildReplay();
+  Serial1.begin(9600);
+  gpsAvailable = true;
+  resetGPSSkyView();
+  uint32_t sentences = gpsProtocolStatus.nmeaSentences;
+  uint32_t epoch = 0;
+  for (auto _ : state) {
+    const ReplayEpoch& replay = nmeaReplay[epoch++ % REPLAY_EPOCHS];
+    Serial1.shimFeed(replay.data, replay.size);
+    updateGPS();
+  }
+  checkReplayFix();
+  BENCH_CHECK(gpsProtocolStatus.nmeaSentences - sentences == state.iterations * 6);
+  BENCH_CHECK(nmeaReplay[0].size > ubxReplay[0].size);   // Texte plus long que NAV-PVT + NAV-SAT + NAV-DOP (274 octets)
+  BENCH_ALLOC_BUDGET(0);
+}
+
+BENCH(gps_replay_ubx_fix) {
+  buildReplay();
+  Serial1.begin(9600);
+  gpsAvailable = true;
+  resetGPSSkyView();
+  uint32_t frames = gpsProtocolStatus.navPvt;
+  uint32_t epoch = 0;
+  for (auto _ : state) {
+    const ReplayEpoch& replay = ubxReplay[epoch++ % REPLAY_EPOCHS];
+    Serial1.shimFeed(replay.data, replay.size);
+    updateGPS();
+  }
+  checkReplayFix();
+  BENCH_CHECK(gpsProtocolStatus.navPvt - frames == state.iterations);
+  BENCH_CHECK(gpsProtocolStatus.protocol == GPS_PROTOCOL_UBX);   // NAV-PVT reçu : mode détecté
+
+  // Flux abîmé : checksum faux, trame tronquée puis resynchronisation, NMEA intercalé
+  static char stream[1024];
+  size_t size = 0;
+  const ReplayEpoch& good = ubxReplay[0];
+  memcpy(stream, good.data, good.size);
+  stream[40] ^= 0x10;                         // NAV-PVT corrompu
+  size = good.size;
+  memcpy(stream + size, good.data, 60);       // NAV-PVT coupé au milieu
+  size += 60;
+  memcpy(stream + size, nmeaReplay[0].data, nmeaReplay[0].size);
+  size += nmeaReplay[0].size;
+  memcpy(stream + size, good.data, good.size);
+  size += good.size;
+  uint32_t errors = gpsProtocolStatus.ubxChecksumErrors;
+  uint32_t pvt = gpsProtocolStatus.navPvt;
+  uint32_t sentences = gpsProtocolStatus.nmeaSentences;
+  Serial1.shimFeed(stream, size);
+  updateGPS();
+  // La trame coupée avale le début du texte NMEA : au plus une phrase perdue
+  BENCH_CHECK(gpsProtocolStatus.ubxChecksumErrors - errors >= 2);
+  BENCH_CHECK(gpsProtocolStatus.navPvt - pvt == 1);
+  BENCH_CHECK(gpsProtocolStatus.nmeaSentences - sentences >= 5);
+  checkReplayFix();
+  stopGPSUbx();
+  BENCH_ALLOC_BUDGET(0);
+}
+
+BENCH(gps_ubx_config_fallback) {
+  buildReplay();
+  Serial1.begin(9600);
+  gpsAvailable = true;
+  uint32_t fallbacks = gpsProtocolStatus.fallbacks;
+  bool configured = true;
+  for (auto _ : state) {
+    // Récepteur u-blox : ACK de CFG-RATE et premier NAV-PVT au nouveau débit
+    startGPSUbx(115200, 10);
+    shimAdvanceMicros(GPS_UBX_SWITCH_MS * 1000UL);
+    maintainGPS();
+    static const uint8_t ackRate[2] = {UBX_CLASS_CFG, UBX_CFG_RATE};
+    uint8_t ack[UBX_FRAME_OVERHEAD + 2];
+    size_t size = ubxBuildFrame(UBX_CLASS_ACK, UBX_ACK_ACK, ackRate, 2, ack);
+    Serial1.shimFeed((const char*)ack, size);
+    Serial1.shimFeed(ubxReplay[0].data, ubxReplay[0].size);
+    maintainGPS();
+    configured &= gpsProtocolStatus.protocol == GPS_PROTOCOL_UBX && gpsProtocolStatus.baud == 115200;
+    // Récepteur débranché : plus de NAV-PVT, retour au NMEA à 9600
+    shimAdvanceMicros((GPS_UBX_TIMEOUT_MS + 1) * 1000UL);
+    maintainGPS();
+    configured &= gpsProtocolStatus.protocol == GPS_PROTOCOL_NMEA && gpsProtocolStatus.baud == GPS_NMEA_BAUD;
+  }
+  BENCH_CHECK(configured && gpsProtocolStatus.configAcks == 1);
+  BENCH_CHECK(gpsProtocolStatus.fallbacks - fallbacks == state.iterations);
+  BENCH_CHECK(strcmp(gpsProtocolStatus.fallbackReason, "timeout") == 0);
+
+  // Récepteur NMEA seul (NEO-6 d'une autre marque) : ni ACK ni NAV-PVT
+  startGPSUbx(115200, 10);
+  shimAdvanceMicros(GPS_UBX_SWITCH_MS * 1000UL);
+  maintainGPS();
+  shimAdvanceMicros((GPS_UBX_TIMEOUT_MS + 1) * 1000UL);
+  maintainGPS();
+  BENCH_CHECK(gpsProtocolStatus.protocol == GPS_PROTOCOL_NMEA && strcmp(gpsProtocolStatus.fallbackReason, "no_ack") == 0);
+  BENCH_ALLOC_BUDGET(0);
+}
+
+// Une seconde GPS en temps local : fin de la seconde précédente, front PPS avec ±3 µs de gigue
+// pseudo-aléatoire, phrase UTC, puis fin de l'impulsion de 100 ms
+#define BENCH_PPS_PERIOD_US (1000000 + BENCH_PPS_DRIFT_PPM)
+static void ppsSecond(uint32_t& unixSeconds, uint32_t& seed, bool label = true) {
+  seed = seed * 1664525u + 1013904223u;
+  int32_t jitter = (int32_t)(seed >> 29) - 3;
+  shimAdvanceMicros(BENCH_PPS_PERIOD_US - 100000 + jitter);
+  shimSetPinLevel(BENCH_PPS_PIN, HIGH);
+  maintainGPSTime();
+  if (label) {
+    gpsTimeOnUtc(unixSeconds, millis());
+  }
+  unixSeconds++;
+  shimAdvanceMicros(100000 - jitter);
+  shimSetPinLevel(BENCH_PPS_PIN, LOW);
+}
+
+// Conversion UTC, décodage UBX et ajustement sans gigue : test_gps_*, test_ubx_* (test/test_native)
+BENCH(gps_pps_discipline) {
+  beginGPSTime(BENCH_PPS_PIN);
+  uint32_t unixSeconds = 1774269319UL;
+  uint32_t seed = 1;
+  for (auto _ : state) {
+    ppsSecond(unixSeconds, seed);
+  }
+  const GPSTimeStatus& status = gpsTimeStatus;
+  // Chaque front : premier de la droite, accepté ou rejeté (préemption de l'hôte > 500 µs)
+  BENCH_CHECK(status.state == (state.iterations >= GPS_PPS_MIN_EDGES ? GPS_TIME_LOCKED : GPS_TIME_PPS));
+  BENCH_CHECK(status.accepted + status.glitches + 1 >= state.iterations);
+  // Préemption de moins de 500 µs : saut de phase intégré à la droite, visible dans la gigue
+  // crête, les contrôles de dérive ne valent que pour une fenêtre sans saut
+  bool clean = state.iterations >= GPS_PPS_HISTORY && status.jitterPeakUs < 50.0f;
+  if (clean) {
+    BENCH_CHECK(fabs(status.driftPpm - BENCH_PPS_DRIFT_PPM) < 2.0);
+    BENCH_CHECK(fabsf(status.cpuDriftPpm - BENCH_PPS_DRIFT_PPM) < 2.0f);
+    BENCH_CHECK(status.jitterRmsUs > 1.0f);
+  }
+
+  // 100 ms locaux après le dernier front = 99 998 µs GPS
+  uint64_t utcUs = 0;
+  if (clean) {
+    BENCH_CHECK(gpsTimeNow(utcUs));
+    int64_t error = (int64_t)(utcUs - ((uint64_t)(unixSeconds - 1) * 1000000ULL + 99998ULL));
+    BENCH_CHECK(error > -50 && error < 50);
+  }
+  stopGPSTime();
+  BENCH_ALLOC_BUDGET(0);
+}
+
+BENCH(gps_pps_holdover_relabel) {
+  uint32_t locks = 0;
+  bool ok = true;
+  // Séquence exacte (un parasite, trois étiquettes) : une préemption de l'hôte ajouterait des glitchs
+  shimFreezeClock(true);
+  for (auto _ : state) {
+    beginGPSTime(BENCH_PPS_PIN);
+    uint32_t unixSeconds = 1774269319UL;
+    uint32_t seed = 7;
+    for (uint8_t i = 0; i < 8; i++) ppsSecond(unixSeconds, seed);
+    ok &= gpsTimeStatus.state == GPS_TIME_LOCKED;
+
+    // Impulsion parasite juste après le front : rejetée, le verrouillage tient
+    shimSetPinLevel(BENCH_PPS_PIN, HIGH);
+    shimSetPinLevel(BENCH_PPS_PIN, LOW);
+    maintainGPSTime();
+    ok &= gpsTimeStatus.glitches == 1 && gpsTimeStatus.state == GPS_TIME_LOCKED;
+
+    // Étiquettes décalées d'une seconde (phrase lue après le front suivant) : ignorées
+    // deux fois, adoptées à la troisième
+    unixSeconds++;
+    for (uint8_t i = 0; i < GPS_TIME_RELABEL_COUNT; i++) ppsSecond(unixSeconds, seed);
+    ok &= gpsTimeStatus.relabels == 1 && gpsTimeStatus.utcSeconds == unixSeconds - 1;
+
+    // PPS perdu deux secondes : l'heure reste servie en maintien, la droite enjambe la coupure
+    shimAdvanceMicros(2 * BENCH_PPS_PERIOD_US);
+    maintainGPSTime();
+    uint64_t utcUs = 0;
+    ok &= gpsTimeStatus.state == GPS_TIME_HOLDOVER && gpsTimeNow(utcUs);
+    unixSeconds += 2;
+    for (uint8_t i = 0; i < GPS_PPS_MIN_EDGES; i++) ppsSecond(unixSeconds, seed, i > 0);
+    ok &= gpsTimeStatus.state == GPS_TIME_LOCKED && gpsTimeStatus.utcSeconds == unixSeconds - 1;
+    locks += gpsTimeStatus.locks;
+
+    // Plus de PPS au-delà du maintien : heure invalide
+    shimAdvanceMicros(GPS_TIME_HOLDOVER_S * 1000000ULL + 1000000ULL);
+    maintainGPSTime();
+    maintainGPSTime();
+    ok &= gpsTimeStatus.state == GPS_TIME_NONE && !gpsTimeNow(utcUs);
+    stopGPSTime();
+  }
+  shimFreezeClock(false);
+  BENCH_CHECK(ok);
+  BENCH_CHECK(locks == 2 * state.iterations);
+  BENCH_ALLOC_BUDGET(0);
+}
@@ -0,0 +1,98 @@
+/*
+ * BENCH_MAIN.CPP - Native benchmark runner
+ * Usage: native_bench [--filter=<substring>] [--min-time=<seconds>] [--verbose]
+ */
+
+#include <Arduino.h>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "bench.h"
+
+struct BenchEntry {
+  const char* name;
+  BenchFunction function;
+};
+
+static std::vector<BenchEntry>& benchRegistry() {
+  static std::vector<BenchEntry> entries;
+  return entries;
+}
+
+struct BenchCheckFailure {
+  const char* expression;
+  const char* file;
+  int line;
+};
+
+// Échecs de la dernière exécution seulement (le calibrage relance la fonction)
+static BenchCheckFailure runFailures[8];
+static int runFailureCount = 0;
+
+BenchRegistrar::BenchRegistrar(const char* name, BenchFunction function) {
+  benchRegistry().push_back({name, function});
+}
+
+bool benchCheck(bool condition, const char* expression, const char* file, int line) {
+  if (!condition) {
+    if (runFailureCount < (int)(sizeof(runFailures) / sizeof(runFailures[0]))) {
+      runFailures[runFailureCount] = {expression, file, line};
+    }
+    runFailureCount++;
+  }
+  return condition;
+}
+
+// pio test -e native : le main() de la suite Unity (test/test_native) prend la place
+#ifndef PIO_UNIT_TESTING
+int main(int argc, char** argv) {
+  const char* filter = "";
+  double minTimeNs = 0.2e9;
+  for (int i = 1; i < argc; i++) {
+    if (strncmp(argv[i], "--filter=", 9) == 0) {
+      filter = argv[i] + 9;
+    } else if (strncmp(argv[i], "--min-time=", 11) == 0) {
+      minTimeNs = atof(argv[i] + 11) * 1e9;
+    } else if (strcmp(argv[i], "--verbose") == 0) {
+      Serial.shimEcho(true);
+    } else {
+      fprintf(stderr, "usage: %s [--filter=<substring>] [--min-time=<seconds>] [--verbose]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  int checkFailures = 0;
+  printf("%-28s %12s %12s %10s %10s\n", "Benchmark", "Iterations", "ns/op", "allocs/op", "bytes/op");
+  for (const BenchEntry& entry : benchRegistry()) {
+    if (!strstr(entry.name, filter)) continue;
+
+    // Itérations x10 (ou extrapolées) jusqu'à dépasser le temps minimal
+    uint64_t iterations = 1;
+    while (true) {
+      BenchState state(iterations);
+      runFailureCount = 0;
+      entry.function(state);
+      if (state.elapsedNs >= minTimeNs || iterations >= 1000000000ULL) {
+        double n = (double)state.iterations;
+        printf("%-28s %12llu %12.1f %10.2f %10.1f\n", entry.name, (unsigned long long)state.iterations,
+               state.elapsedNs / n, (double)state.allocations / n, (double)state.bytesAllocated / n);
+        for (int i = 0; i < runFailureCount && i < (int)(sizeof(runFailures) / sizeof(runFailures[0])); i++) {
+          printf("  CHECK FAILED %s:%d: %s\n", runFailures[i].file, runFailures[i].line, runFailures[i].expression);
+        }
+        checkFailures += runFailureCount;
+        break;
+      }
+      double perOp = state.elapsedNs > 0 ? state.elapsedNs / (double)iterations : 1.0;
+      uint64_t next = (uint64_t)(minTimeNs * 1.4 / perOp);
+      if (next > iterations * 10) next = iterations * 10;
+      iterations = next > iterations ? next : iterations + 1;
+    }
+  }
+
+  if (checkFailures) {
+    fprintf(stderr, "%d check(s) failed\n", checkFailures);
+    return 1;
+  }
+  return 0;
+}
+#endif // PIO_UNIT_TESTING
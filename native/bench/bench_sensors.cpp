@@ -0,0 +1,145 @@
+/*
+ * BENCH_SENSORS.CPP - AHT20 + BMP280 read path (environmental_sensors.cpp)
+ * against simulated I2C devices, and the BMP280 integer compensation and
+ * altitude table (bmp280_compensation.h) per sample
+ */
+
+#include <Arduino.h>
+#include <Wire.h>
+#include "bench.h"
+#include "bmp280_compensation.h"
+#include "config.h"
+#include "environmental_sensors.h"
+
+// Normalement définies par main.cpp (remappage des broches I2C)
+int i2c_sda = 21;
+int i2c_scl = 20;
+
+// AHT20 : 45.0 %RH, 22.5 °C (humidité 0x73333, température 0x5CCCD sur 20 bits)
+class FakeAHT20 : public I2CDevice {
+public:
+  void onWrite(const uint8_t* data, size_t size) override { (void)data; (void)size; }
+  size_t onRead(uint8_t* out, size_t size) override {
+    static const uint8_t frame[6] = {0x1C, 0x73, 0x33, 0x35, 0xCC, 0xCD};
+    size_t n = size < sizeof(frame) ? size : sizeof(frame);
+    memcpy(out, frame, n);
+    return n;
+  }
+};
+
+// BMP280 : registres avec pointeur auto-incrémenté, calibration et mesures
+// de l'exemple de la datasheet Bosch (section 3.12)
+class FakeBMP280 : public I2CDevice {
+public:
+  FakeBMP280() {
+    memset(regs, 0, sizeof(regs));
+    regs[0xD0] = 0x58;
+    static const int32_t calibration[12] = {27504, 26435, -1000, 36477, -10685, 3024,
+                                            2855, 140, -7, 15500, -14600, 6000};
+    for (int i = 0; i < 12; i++) {
+      regs[0x88 + i * 2] = (uint8_t)(calibration[i] & 0xFF);
+      regs[0x89 + i * 2] = (uint8_t)((calibration[i] >> 8) & 0xFF);
+    }
+    // adc_P = 415148, adc_T = 519888
+    regs[0xF7] = 0x65; regs[0xF8] = 0x5A; regs[0xF9] = 0xC0;
+    regs[0xFA] = 0x7E; regs[0xFB] = 0xED; regs[0xFC] = 0x00;
+  }
+  void onWrite(const uint8_t* data, size_t size) override {
+    if (size == 0) return;
+    pointer = data[0];
+    for (size_t i = 1; i < size; i++) regs[(uint8_t)(pointer + i - 1)] = data[i];
+  }
+  size_t onRead(uint8_t* out, size_t size) override {
+    for (size_t i = 0; i < size; i++) out[i] = regs[pointer++];
+    return size;
+  }
+  uint8_t reg(uint8_t address) const { return regs[address]; }
+
+private:
+  uint8_t regs[256];
+  uint8_t pointer = 0;
+};
+
+static FakeAHT20 fakeAHT20;
+static FakeBMP280 fakeBMP280;
+
+static const int32_t kCalibration[12] = {27504, 26435, -1000, 36477, -10685, 3024,
+                                         2855, 140, -7, 15500, -14600, 6000};
+
+static BMP280Calibration datasheetCalibration() {
+  uint8_t raw[BMP280_CALIB_SIZE];
+  for (int i = 0; i < 12; i++) {
+    raw[i * 2] = (uint8_t)(kCalibration[i] & 0xFF);
+    raw[i * 2 + 1] = (uint8_t)((kCalibration[i] >> 8) & 0xFF);
+  }
+  BMP280Calibration cal;
+  bmp280ParseCalibration(raw, cal);
+  return cal;
+}
+
+void benchAttachEnvironmentalSensors() {
+  Wire.shimAttach(0x38, &fakeAHT20);
+  Wire.shimAttach(0x76, &fakeBMP280);
+  initEnvironmentalSensors();
+}
+
+BENCH(env_update_sensors) {
+  benchAttachEnvironmentalSensors();
+  for (auto _ : state) {
+    updateEnvironmentalSensors();
+  }
+  BENCH_CHECK(envData.aht20_available && envData.bmp280_available);
+  BENCH_CHECK(envData.aht20_status == "OK");
+  BENCH_CHECK(envData.bmp280_status == "OK");
+  BENCH_CHECK(fabsf(envData.humidity - 45.0f) < 0.01f);
+  BENCH_CHECK(fabsf(envData.temperature_aht20 - 22.5f) < 0.01f);
+  // Exemple de la datasheet : 25,08 °C, 100653,27 Pa
+  BENCH_CHECK(fabsf(envData.temperature_bmp280 - 25.08f) < 0.001f);
+  BENCH_CHECK(fabsf(envData.pressure - 1006.5327f) < 0.001f);
+  BENCH_CHECK(fabsf(envData.altitude - 44330.0f * (1.0f - powf(1006.5327f / 1013.25f, 1.0f / 5.255f))) < 0.05f);
+  BENCH_CHECK(fakeBMP280.reg(0xF4) == ((bmp280OversamplingCode(BMP280_OVERSAMPLING_T) << 5) |
+                                       (bmp280OversamplingCode(BMP280_OVERSAMPLING_P) << 2) | 0x03));
+  BENCH_CHECK(fakeBMP280.reg(0xF5) == ((bmp280StandbyCode(BMP280_STANDBY_MS) << 5) |
+                                       (bmp280FilterCode(BMP280_IIR_FILTER) << 2)));
+  BENCH_ALLOC_BUDGET(0);
+}
+
+// Une compensation complète (température + pression) par itération, ns/op = par échantillon.
+// Exemple de la datasheet et écart aux formules en double : test_bmp280_* (test/test_native)
+BENCH(bmp280_compensation) {
+  const BMP280Calibration cal = datasheetCalibration();
+  // Balayage -19..61 °C, 700..1200 hPa : inclut adc_T / 8 < 2 * T1 (sous ~0 °C)
+  int32_t adcT[256];
+  int32_t adcP[256];
+  for (int i = 0; i < 256; i++) {
+    adcT[i] = 380000 + i * 800;
+    adcP[i] = 250000 + i * 1400;
+  }
+  uint32_t pressure = 0;
+  int32_t temperature = 0;
+  uint32_t index = 0;
+  for (auto _ : state) {
+    int32_t tFine = bmp280TemperatureFine(adcT[index & 255], cal);
+    temperature = bmp280TemperatureCenti(tFine);
+    pressure = bmp280PressureQ8(adcP[index & 255], tFine, cal);
+    benchKeep(temperature);
+    benchKeep(pressure);
+    index++;
+  }
+  BENCH_CHECK(bmp280TemperatureCenti(bmp280TemperatureFine(519888, cal)) == 2508);
+  BENCH_ALLOC_BUDGET(0);
+}
+
+// Bornes d'erreur de la table contre pow() : test_bmp280_altitude_bounds (test/test_native)
+BENCH(bmp280_altitude) {
+  bmp280AltitudeTable();
+  float altitude = 0.0f;
+  uint32_t index = 0;
+  for (auto _ : state) {
+    altitude = bmp280AltitudeM(300.0f + (index & 1023) * 0.78f, 1013.25f);
+    benchKeep(altitude);
+    index++;
+  }
+  BENCH_CHECK(fabsf(bmp280AltitudeM(1013.25f, 1013.25f)) < 0.01f);
+  BENCH_ALLOC_BUDGET(0);
+}
@@ -0,0 +1,118 @@
+/*
+ * ARDUINO.CPP - Clock, pin and FreeRTOS core stubs for the native env
+ */
+
+#include "Arduino.h"
+#include <chrono>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+// Opaque côté appelant, comme esp_timer_handle_t dans ESP-IDF
+struct esp_timer {
+  uint8_t unused;
+};
+
+static const auto clockStart = std::chrono::steady_clock::now();
+static uint64_t virtualOffsetUs = 0;
+static bool clockFrozen = false;
+static int64_t frozenElapsedUs = 0;
+static int pinLevels[64];
+static void (*pinHandlers[64])(void);
+static int pinModes[64];
+static uint8_t currentCore = 0;
+
+EspClass ESP;
+
+static int64_t hostElapsedUs() {
+  auto elapsed = std::chrono::steady_clock::now() - clockStart;
+  return std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+}
+
+int64_t esp_timer_get_time() {
+  return (clockFrozen ? frozenElapsedUs : hostElapsedUs()) + (int64_t)virtualOffsetUs;
+}
+
+unsigned long millis() {
+  return (unsigned long)(uint32_t)(esp_timer_get_time() / 1000);
+}
+
+unsigned long micros() {
+  return (unsigned long)(uint32_t)esp_timer_get_time();
+}
+
+void delay(uint32_t ms) {
+  virtualOffsetUs += (uint64_t)ms * 1000;
+}
+
+void delayMicroseconds(uint32_t us) {
+  virtualOffsetUs += us;
+}
+
+void shimAdvanceMicros(uint64_t us) {
+  virtualOffsetUs += us;
+}
+
+// Au dégel, l'horloge reprend là où elle s'était arrêtée (jamais de retour en arrière)
+void shimFreezeClock(bool frozen) {
+  if (frozen == clockFrozen) return;
+  if (frozen) {
+    frozenElapsedUs = hostElapsedUs();
+  } else {
+    virtualOffsetUs -= hostElapsedUs() - frozenElapsedUs;
+  }
+  clockFrozen = frozen;
+}
+
+void yield() {}
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t*, esp_timer_handle_t* handle) {
+  static esp_timer hostTimer;
+  *handle = &hostTimer;
+  return ESP_OK;
+}
+
+BaseType_t xPortGetCoreID() {
+  return currentCore;
+}
+
+void shimSetCoreID(uint8_t core) {
+  currentCore = core;
+}
+
+// Une seule tâche sur l'hôte : poignée fixe, non nulle comme sur le device
+TaskHandle_t xTaskGetCurrentTaskHandle() {
+  static uint32_t loopTask;
+  return &loopTask;
+}
+
+void pinMode(uint8_t, uint8_t) {}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+  if (pin < 64) pinLevels[pin] = value;
+}
+
+int digitalRead(uint8_t pin) {
+  return pin < 64 ? pinLevels[pin] : LOW;
+}
+
+// Un changement de niveau simulé déclenche l'ISR attachée, comme un front réel
+void shimSetPinLevel(uint8_t pin, int level) {
+  if (pin >= 64) return;
+  bool changed = pinLevels[pin] != level;
+  pinLevels[pin] = level;
+  if (!changed || !pinHandlers[pin]) return;
+  int mode = pinModes[pin];
+  if (mode == CHANGE || (mode == RISING && level == HIGH) || (mode == FALLING && level == LOW)) {
+    pinHandlers[pin]();
+  }
+}
+
+void attachInterrupt(uint8_t pin, void (*handler)(void), int mode) {
+  if (pin >= 64) return;
+  pinHandlers[pin] = handler;
+  pinModes[pin] = mode;
+}
+
+void detachInterrupt(uint8_t pin) {
+  if (pin < 64) pinHandlers[pin] = nullptr;
+}
@@ -0,0 +1,81 @@
+/*
+ * ARDUINO.H - Thin Arduino core for the native env (host build)
+ * Enough of the Arduino-ESP32 API for the hardware-independent modules:
+ * String, Serial/Serial1/Serial2, Wire, pin stubs and a clock where delay()
+ * advances virtual time instead of sleeping (benchmarks stay CPU bound)
+ */
+
+#ifndef NATIVE_ARDUINO_H
+#define NATIVE_ARDUINO_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "WString.h"
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+
+using std::max;
+using std::min;
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH 0x1
+#define LOW 0x0
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+#define INPUT_PULLDOWN 0x09
+#define RISING 0x01
+#define FALLING 0x02
+#define CHANGE 0x03
+
+#define PROGMEM
+#define PGM_P const char*
+#define IRAM_ATTR
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define digitalPinToInterrupt(pin) (pin)
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+inline uint32_t getCpuFrequencyMhz() { return 240; }
+
+// Heap figures from the counted shim heap (esp_heap_caps.h), no PSRAM
+class EspClass {
+public:
+  uint32_t getHeapSize() { return NATIVE_HEAP_SIZE; }
+  uint32_t getFreeHeap() { return (uint32_t)heap_caps_get_free_size(MALLOC_CAP_8BIT); }
+  uint32_t getMinFreeHeap() { return (uint32_t)(NATIVE_HEAP_SIZE - shimHeap.bytesPeak); }
+  uint32_t getMaxAllocHeap() { return (uint32_t)heap_caps_get_largest_free_block(MALLOC_CAP_8BIT); }
+  uint32_t getPsramSize() { return 0; }
+  uint32_t getFreePsram() { return 0; }
+};
+
+extern EspClass ESP;
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+void attachInterrupt(uint8_t pin, void (*handler)(void), int mode);
+void detachInterrupt(uint8_t pin);
+
+// Native only: simulated input level (fires the attached interrupt) and virtual
+// clock control for benchmarks
+void shimSetPinLevel(uint8_t pin, int level);
+void shimAdvanceMicros(uint64_t us);
+// Frozen: host time stops leaking into the clock, only shimAdvanceMicros() moves it
+void shimFreezeClock(bool frozen);
+
+#include "HardwareSerial.h"
+
+#endif // NATIVE_ARDUINO_H
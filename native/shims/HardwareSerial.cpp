@@ -0,0 +1,43 @@
+/*
+ * HARDWARESERIAL.CPP - Host UART for the native env
+ */
+
+#include "HardwareSerial.h"
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+
+HardwareSerial Serial(0);
+HardwareSerial Serial1(1);
+HardwareSerial Serial2(2);
+
+size_t HardwareSerial::write(const uint8_t* data, size_t size) {
+  if (echo) fwrite(data, 1, size, stdout);
+  return size;
+}
+
+size_t HardwareSerial::print(const char* text) {
+  return text ? write(reinterpret_cast<const uint8_t*>(text), strlen(text)) : 0;
+}
+
+size_t HardwareSerial::printf(const char* format, ...) {
+  if (!echo) return 0;
+  char buffer[512];
+  va_list args;
+  va_start(args, format);
+  int n = vsnprintf(buffer, sizeof(buffer), format, args);
+  va_end(args);
+  if (n < 0) return 0;
+  return write(reinterpret_cast<const uint8_t*>(buffer), (size_t)n < sizeof(buffer) ? (size_t)n : sizeof(buffer) - 1);
+}
+
+void HardwareSerial::shimFeed(const char* data, size_t size) {
+  if (rxPos > 0) {
+    memmove(rx, rx + rxPos, rxLength - rxPos);
+    rxLength -= rxPos;
+    rxPos = 0;
+  }
+  if (size > sizeof(rx) - rxLength) size = sizeof(rx) - rxLength;
+  memcpy(rx + rxLength, data, size);
+  rxLength += size;
+}
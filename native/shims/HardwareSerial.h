@@ -0,0 +1,69 @@
+/*
+ * HARDWARESERIAL.H - Host UART for the native env
+ * RX is a fixed buffer filled with shimFeed() (NMEA replay), TX is dropped
+ * unless shimEcho(true) copies it to stdout. No heap use
+ */
+
+#ifndef NATIVE_HARDWARESERIAL_H
+#define NATIVE_HARDWARESERIAL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "WString.h"
+
+#define SERIAL_8N1 0x800001c
+#define DEC 10
+#define HEX 16
+#define NATIVE_SERIAL_RX_SIZE 4096
+
+class HardwareSerial {
+public:
+  explicit HardwareSerial(int uartNumber) : uart(uartNumber) {}
+
+  void begin(unsigned long baud, uint32_t config = SERIAL_8N1, int8_t rxPin = -1, int8_t txPin = -1) {
+    (void)baud; (void)config; (void)rxPin; (void)txPin;
+    started = true;
+  }
+  void end() { started = false; }
+  void updateBaudRate(unsigned long baud) { (void)baud; }
+  size_t setRxBufferSize(size_t size) { return size; }
+  operator bool() const { return started; }
+
+  int available() const { return (int)(rxLength - rxPos); }
+  int peek() const { return rxPos < rxLength ? rx[rxPos] : -1; }
+  int read() { return rxPos < rxLength ? rx[rxPos++] : -1; }
+  void flush() {}
+
+  size_t write(uint8_t c) { return write(&c, 1); }
+  size_t write(const uint8_t* data, size_t size);
+  size_t print(const char* text);
+  size_t print(const String& text) { return write(reinterpret_cast<const uint8_t*>(text.c_str()), text.length()); }
+  size_t print(char c) { return write((uint8_t)c); }
+  template <typename T, typename = typename std::enable_if<std::is_arithmetic<T>::value>::type>
+  size_t print(T value) { return print(String(value)); }
+  template <typename T, typename = typename std::enable_if<std::is_integral<T>::value>::type>
+  size_t print(T value, int base) { return print(String(value, (unsigned char)base)); }
+  size_t println() { return print("\r\n"); }
+  template <typename T>
+  size_t println(const T& value) { return print(value) + println(); }
+  size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+  // Native only
+  void shimFeed(const char* data, size_t size);   // Appends to RX, drops what does not fit
+  void shimEcho(bool enable) { echo = enable; }
+
+private:
+  int uart;
+  bool started = false;
+  bool echo = false;
+  char rx[NATIVE_SERIAL_RX_SIZE];
+  size_t rxPos = 0;
+  size_t rxLength = 0;
+};
+
+extern HardwareSerial Serial;
+extern HardwareSerial Serial1;
+extern HardwareSerial Serial2;
+
+#endif // NATIVE_HARDWARESERIAL_H
@@ -0,0 +1,350 @@
+/*
+ * WSTRING.CPP - Host String implementation (native env)
+ */
+
+#include "WString.h"
+#include "shim_heap.h"
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+static void formatUnsigned(char* out, unsigned long long value, unsigned char base) {
+  char digits[66];
+  int n = 0;
+  if (base < 2 || base > 36) base = 10;
+  do {
+    unsigned d = (unsigned)(value % base);
+    digits[n++] = (char)(d < 10 ? '0' + d : 'a' + d - 10);
+    value /= base;
+  } while (value);
+  while (n) *out++ = digits[--n];
+  *out = '\0';
+}
+
+String::String(const char* cstr) {
+  invalidate();
+  if (cstr) copy(cstr, (unsigned int)strlen(cstr));
+}
+
+String::String(const char* cstr, unsigned int length) {
+  invalidate();
+  if (cstr) copy(cstr, length);
+}
+
+String::String(const String& str) {
+  invalidate();
+  copy(str.buffer(), str.len);
+}
+
+String::String(String&& rval) noexcept {
+  invalidate();
+  move(rval);
+}
+
+String::String(char c) {
+  invalidate();
+  copy(&c, 1);
+}
+
+String::String(unsigned char value, unsigned char base) : String((unsigned long long)value, base) {}
+String::String(int value, unsigned char base) : String((long long)value, base) {}
+String::String(unsigned int value, unsigned char base) : String((unsigned long long)value, base) {}
+String::String(long value, unsigned char base) : String((long long)value, base) {}
+String::String(unsigned long value, unsigned char base) : String((unsigned long long)value, base) {}
+
+String::String(long long value, unsigned char base) {
+  invalidate();
+  char buf[68];
+  if (value < 0 && base == 10) {
+    buf[0] = '-';
+    formatUnsigned(buf + 1, (unsigned long long)(-(value + 1)) + 1, base);
+  } else {
+    formatUnsigned(buf, (unsigned long long)value, base);
+  }
+  copy(buf, (unsigned int)strlen(buf));
+}
+
+String::String(unsigned long long value, unsigned char base) {
+  invalidate();
+  char buf[68];
+  formatUnsigned(buf, value, base);
+  copy(buf, (unsigned int)strlen(buf));
+}
+
+String::String(float value, unsigned int decimalPlaces) : String((double)value, decimalPlaces) {}
+
+String::String(double value, unsigned int decimalPlaces) {
+  invalidate();
+  char buf[352];
+  int n = snprintf(buf, sizeof(buf), "%.*f", (int)decimalPlaces, value);
+  copy(buf, n < 0 ? 0 : (unsigned int)n);
+}
+
+String::~String() {
+  shimFree(heap);
+}
+
+void String::invalidate() {
+  heap = nullptr;
+  cap = 0;
+  len = 0;
+  sso[0] = '\0';
+}
+
+bool String::changeBuffer(unsigned int maxStrLen) {
+  if (maxStrLen <= SSO_CAPACITY && !heap) {
+    return true;
+  }
+  // Arrondi à 16 octets comme WString::changeBuffer()
+  size_t newSize = (maxStrLen + 16) & ~(size_t)0xF;
+  char* newBuffer = static_cast<char*>(shimRealloc(heap, newSize));
+  if (!newBuffer) {
+    return false;
+  }
+  if (!heap) {
+    memcpy(newBuffer, sso, len + 1);
+  }
+  heap = newBuffer;
+  cap = (unsigned int)newSize - 1;
+  return true;
+}
+
+bool String::reserve(unsigned int size) {
+  if (size <= capacity()) {
+    return true;
+  }
+  return changeBuffer(size);
+}
+
+String& String::copy(const char* cstr, unsigned int length) {
+  if (!reserve(length)) {
+    return *this;
+  }
+  memmove(wbuffer(), cstr, length);
+  setLen(length);
+  return *this;
+}
+
+void String::move(String& rhs) {
+  if (rhs.heap) {
+    shimFree(heap);
+    heap = rhs.heap;
+    cap = rhs.cap;
+    len = rhs.len;
+    rhs.invalidate();
+    return;
+  }
+  copy(rhs.sso, rhs.len);
+  rhs.len = 0;
+  rhs.sso[0] = '\0';
+}
+
+String& String::operator=(const String& rhs) {
+  if (this != &rhs) copy(rhs.buffer(), rhs.len);
+  return *this;
+}
+
+String& String::operator=(String&& rval) noexcept {
+  if (this != &rval) move(rval);
+  return *this;
+}
+
+String& String::operator=(const char* cstr) {
+  if (cstr) {
+    copy(cstr, (unsigned int)strlen(cstr));
+  } else {
+    setLen(0);
+  }
+  return *this;
+}
+
+bool String::concat(const char* cstr) {
+  return cstr ? concat(cstr, (unsigned int)strlen(cstr)) : false;
+}
+
+bool String::concat(const char* cstr, unsigned int length) {
+  if (!cstr) return false;
+  if (length == 0) return true;
+  unsigned int newLen = len + length;
+  // cstr peut pointer dans notre propre tampon (s += s)
+  const char* base = buffer();
+  bool self = cstr >= base && cstr < base + len;
+  size_t offset = self ? (size_t)(cstr - base) : 0;
+  if (!reserve(newLen)) return false;
+  memmove(wbuffer() + len, self ? buffer() + offset : cstr, length);
+  setLen(newLen);
+  return true;
+}
+
+int String::compareTo(const String& s) const {
+  return strcmp(buffer(), s.buffer());
+}
+
+bool String::equals(const String& s) const {
+  return len == s.len && memcmp(buffer(), s.buffer(), len) == 0;
+}
+
+bool String::equals(const char* cstr) const {
+  return cstr ? strcmp(buffer(), cstr) == 0 : len == 0;
+}
+
+bool String::equalsIgnoreCase(const String& s) const {
+  if (len != s.len) return false;
+  for (unsigned int i = 0; i < len; i++) {
+    if (tolower((unsigned char)buffer()[i]) != tolower((unsigned char)s.buffer()[i])) return false;
+  }
+  return true;
+}
+
+bool String::startsWith(const String& prefix, unsigned int offset) const {
+  if (offset > len || prefix.len > len - offset) return false;
+  return strncmp(buffer() + offset, prefix.buffer(), prefix.len) == 0;
+}
+
+bool String::endsWith(const String& suffix) const {
+  if (suffix.len > len) return false;
+  return strcmp(buffer() + len - suffix.len, suffix.buffer()) == 0;
+}
+
+char& String::operator[](unsigned int index) {
+  static char dummy;
+  if (index >= len) {
+    dummy = 0;
+    return dummy;
+  }
+  return wbuffer()[index];
+}
+
+void String::toCharArray(char* buf, unsigned int bufsize, unsigned int index) const {
+  if (!bufsize || !buf) return;
+  if (index >= len) {
+    buf[0] = '\0';
+    return;
+  }
+  unsigned int n = bufsize - 1;
+  if (n > len - index) n = len - index;
+  memcpy(buf, buffer() + index, n);
+  buf[n] = '\0';
+}
+
+int String::indexOf(char ch, unsigned int fromIndex) const {
+  if (fromIndex >= len) return -1;
+  const char* found = static_cast<const char*>(memchr(buffer() + fromIndex, ch, len - fromIndex));
+  return found ? (int)(found - buffer()) : -1;
+}
+
+int String::indexOf(const String& str, unsigned int fromIndex) const {
+  if (fromIndex >= len) return -1;
+  const char* found = strstr(buffer() + fromIndex, str.buffer());
+  return found ? (int)(found - buffer()) : -1;
+}
+
+int String::lastIndexOf(char ch) const {
+  const char* found = strrchr(buffer(), ch);
+  return found ? (int)(found - buffer()) : -1;
+}
+
+int String::lastIndexOf(const String& str) const {
+  if (str.len == 0 || str.len > len) return -1;
+  for (int i = (int)(len - str.len); i >= 0; i--) {
+    if (memcmp(buffer() + i, str.buffer(), str.len) == 0) return i;
+  }
+  return -1;
+}
+
+String String::substring(unsigned int left, unsigned int right) const {
+  if (left > right) {
+    unsigned int temp = right;
+    right = left;
+    left = temp;
+  }
+  if (left >= len) return String();
+  if (right > len) right = len;
+  return String(buffer() + left, right - left);
+}
+
+void String::replace(char find, char replace) {
+  for (char* p = wbuffer(); *p; p++) {
+    if (*p == find) *p = replace;
+  }
+}
+
+void String::replace(const String& find, const String& replace) {
+  if (find.len == 0) return;
+  String result;
+  result.reserve(len);
+  unsigned int index = 0;
+  int found;
+  while ((found = indexOf(find, index)) >= 0) {
+    result.concat(buffer() + index, (unsigned int)found - index);
+    result.concat(replace);
+    index = (unsigned int)found + find.len;
+  }
+  result.concat(buffer() + index, len - index);
+  *this = static_cast<String&&>(result);
+}
+
+void String::remove(unsigned int index, unsigned int count) {
+  if (index >= len) return;
+  if (count > len - index) count = len - index;
+  char* p = wbuffer();
+  memmove(p + index, p + index + count, len - index - count);
+  setLen(len - count);
+}
+
+void String::toLowerCase() {
+  for (char* p = wbuffer(); *p; p++) *p = (char)tolower((unsigned char)*p);
+}
+
+void String::toUpperCase() {
+  for (char* p = wbuffer(); *p; p++) *p = (char)toupper((unsigned char)*p);
+}
+
+void String::trim() {
+  if (len == 0) return;
+  const char* p = buffer();
+  unsigned int begin = 0;
+  while (begin < len && isspace((unsigned char)p[begin])) begin++;
+  unsigned int end = len;
+  while (end > begin && isspace((unsigned char)p[end - 1])) end--;
+  len = end - begin;
+  if (begin) memmove(wbuffer(), p + begin, len);
+  wbuffer()[len] = '\0';
+}
+
+long String::toInt() const {
+  return atol(buffer());
+}
+
+float String::toFloat() const {
+  return (float)atof(buffer());
+}
+
+double String::toDouble() const {
+  return atof(buffer());
+}
+
+StringSumHelper& operator+(const StringSumHelper& lhs, const String& rhs) {
+  StringSumHelper& a = const_cast<StringSumHelper&>(lhs);
+  a.concat(rhs);
+  return a;
+}
+
+StringSumHelper& operator+(const StringSumHelper& lhs, const char* cstr) {
+  StringSumHelper& a = const_cast<StringSumHelper&>(lhs);
+  a.concat(cstr);
+  return a;
+}
+
+StringSumHelper& operator+(const StringSumHelper& lhs, char c) {
+  StringSumHelper& a = const_cast<StringSumHelper&>(lhs);
+  a.concat(c);
+  return a;
+}
+
+StringSumHelper& operator+(const StringSumHelper& lhs, const __FlashStringHelper* rhs) {
+  StringSumHelper& a = const_cast<StringSumHelper&>(lhs);
+  a.concat(rhs);
+  return a;
+}
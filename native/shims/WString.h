@@ -0,0 +1,157 @@
+/*
+ * WSTRING.H - Host (native env) copy of the Arduino-ESP32 String semantics
+ * Same inline capacity (11 chars) and 16-byte rounded growth as the 32-bit
+ * WString, so allocation counts measured on the host match the device.
+ * Heap traffic goes through shim_heap.h counters
+ */
+
+#ifndef NATIVE_WSTRING_H
+#define NATIVE_WSTRING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+class __FlashStringHelper;
+class StringSumHelper;
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper*>(string_literal))
+#define FPSTR(pstr_pointer) (reinterpret_cast<const __FlashStringHelper*>(pstr_pointer))
+
+class String {
+public:
+  String(const char* cstr = "");
+  String(const char* cstr, unsigned int length);
+  String(const String& str);
+  String(String&& rval) noexcept;
+  String(const __FlashStringHelper* str) : String(reinterpret_cast<const char*>(str)) {}
+  explicit String(char c);
+  explicit String(unsigned char value, unsigned char base = 10);
+  explicit String(int value, unsigned char base = 10);
+  explicit String(unsigned int value, unsigned char base = 10);
+  explicit String(long value, unsigned char base = 10);
+  explicit String(unsigned long value, unsigned char base = 10);
+  explicit String(long long value, unsigned char base = 10);
+  explicit String(unsigned long long value, unsigned char base = 10);
+  explicit String(float value, unsigned int decimalPlaces = 2);
+  explicit String(double value, unsigned int decimalPlaces = 2);
+  ~String();
+
+  String& operator=(const String& rhs);
+  String& operator=(String&& rval) noexcept;
+  String& operator=(const char* cstr);
+  String& operator=(const __FlashStringHelper* str) { return *this = reinterpret_cast<const char*>(str); }
+
+  bool reserve(unsigned int size);
+  unsigned int length() const { return len; }
+  bool isEmpty() const { return len == 0; }
+  const char* c_str() const { return buffer(); }
+  char* begin() { return wbuffer(); }
+  char* end() { return wbuffer() + len; }
+  const char* begin() const { return buffer(); }
+  const char* end() const { return buffer() + len; }
+
+  bool concat(const String& str) { return concat(str.buffer(), str.len); }
+  bool concat(const char* cstr);
+  bool concat(const char* cstr, unsigned int length);
+  bool concat(char c) { return concat(&c, 1); }
+  bool concat(const __FlashStringHelper* str) { return concat(reinterpret_cast<const char*>(str)); }
+  template <typename T, typename = typename std::enable_if<std::is_arithmetic<T>::value>::type>
+  bool concat(T value) { return concat(String(value)); }
+
+  template <typename T>
+  String& operator+=(const T& rhs) {
+    concat(rhs);
+    return *this;
+  }
+  String& operator+=(const char* cstr) {
+    concat(cstr);
+    return *this;
+  }
+
+  int compareTo(const String& s) const;
+  bool equals(const String& s) const;
+  bool equals(const char* cstr) const;
+  bool equalsIgnoreCase(const String& s) const;
+  bool operator==(const String& rhs) const { return equals(rhs); }
+  bool operator==(const char* cstr) const { return equals(cstr); }
+  bool operator!=(const String& rhs) const { return !equals(rhs); }
+  bool operator!=(const char* cstr) const { return !equals(cstr); }
+  bool operator<(const String& rhs) const { return compareTo(rhs) < 0; }
+  bool operator>(const String& rhs) const { return compareTo(rhs) > 0; }
+  bool startsWith(const String& prefix) const { return startsWith(prefix, 0); }
+  bool startsWith(const String& prefix, unsigned int offset) const;
+  bool endsWith(const String& suffix) const;
+
+  char charAt(unsigned int index) const { return index < len ? buffer()[index] : 0; }
+  void setCharAt(unsigned int index, char c) { if (index < len) wbuffer()[index] = c; }
+  char operator[](unsigned int index) const { return charAt(index); }
+  char& operator[](unsigned int index);
+  void toCharArray(char* buf, unsigned int bufsize, unsigned int index = 0) const;
+
+  int indexOf(char ch, unsigned int fromIndex = 0) const;
+  int indexOf(const String& str, unsigned int fromIndex = 0) const;
+  int lastIndexOf(char ch) const;
+  int lastIndexOf(const String& str) const;
+  String substring(unsigned int beginIndex) const { return substring(beginIndex, len); }
+  String substring(unsigned int beginIndex, unsigned int endIndex) const;
+
+  void replace(char find, char replace);
+  void replace(const String& find, const String& replace);
+  void remove(unsigned int index) { remove(index, (unsigned int)-1); }
+  void remove(unsigned int index, unsigned int count);
+  void toLowerCase();
+  void toUpperCase();
+  void trim();
+
+  long toInt() const;
+  float toFloat() const;
+  double toDouble() const;
+
+  // Chained a + b + c appends into one temporary, as in Arduino-ESP32
+  friend StringSumHelper& operator+(const StringSumHelper& lhs, const String& rhs);
+  friend StringSumHelper& operator+(const StringSumHelper& lhs, const char* cstr);
+  friend StringSumHelper& operator+(const StringSumHelper& lhs, char c);
+  friend StringSumHelper& operator+(const StringSumHelper& lhs, const __FlashStringHelper* rhs);
+
+private:
+  static const unsigned int SSO_CAPACITY = 11;   // 32-bit WString: sizeof(ptr struct) + 4 - 1
+
+  const char* buffer() const { return heap ? heap : sso; }
+  char* wbuffer() { return heap ? heap : sso; }
+  unsigned int capacity() const { return heap ? cap : SSO_CAPACITY; }
+  bool changeBuffer(unsigned int maxStrLen);
+  void setLen(unsigned int length) {
+    len = length;
+    wbuffer()[len] = '\0';
+  }
+  void invalidate();
+  String& copy(const char* cstr, unsigned int length);
+  void move(String& rhs);
+
+  char sso[SSO_CAPACITY + 1];
+  char* heap = nullptr;
+  unsigned int cap = 0;
+  unsigned int len = 0;
+};
+
+class StringSumHelper : public String {
+public:
+  StringSumHelper(const String& s) : String(s) {}
+  StringSumHelper(const char* p) : String(p) {}
+  StringSumHelper(char c) : String(c) {}
+  StringSumHelper(int num) : String(num) {}
+  StringSumHelper(unsigned int num) : String(num) {}
+  StringSumHelper(long num) : String(num) {}
+  StringSumHelper(unsigned long num) : String(num) {}
+  StringSumHelper(float num) : String(num) {}
+  StringSumHelper(double num) : String(num) {}
+};
+
+template <typename T, typename = typename std::enable_if<std::is_arithmetic<T>::value>::type>
+StringSumHelper& operator+(const StringSumHelper& lhs, T num) {
+  StringSumHelper& a = const_cast<StringSumHelper&>(lhs);
+  a.concat(num);
+  return a;
+}
+
+#endif // NATIVE_WSTRING_H
@@ -0,0 +1,115 @@
+/*
+ * WEBSERVER.CPP - Host WebServer for the native env
+ */
+
+#include "WebServer.h"
+
+void WebServer::on(const char* uri, THandlerFunction handler) {
+  routes.push_back({uri, handler});
+}
+
+bool WebServer::hasArg(const String& name) const {
+  for (int i = 0; i < argCount; i++) {
+    if (argNames[i] == name) return true;
+  }
+  return false;
+}
+
+String WebServer::arg(const String& name) const {
+  for (int i = 0; i < argCount; i++) {
+    if (argNames[i] == name) return argValues[i];
+  }
+  return String();
+}
+
+String WebServer::header(const String& name) const {
+  return name.equalsIgnoreCase("Accept") ? acceptHeader : String();
+}
+
+// sendHeader() / _prepareHeader() d'Arduino-ESP32, mêmes String temporaires
+void WebServer::sendHeader(const String& name, const String& value, bool first) {
+  String headerLine = name;
+  headerLine += F(": ");
+  headerLine += value;
+  headerLine += "\r\n";
+  if (first) {
+    responseHeaders = headerLine + responseHeaders;
+  } else {
+    responseHeaders += headerLine;
+  }
+}
+
+void WebServer::prepareHeader(String& response, int code, const char* contentType, size_t contentLength) {
+  shimCode = code;
+  snprintf(shimContentType, sizeof(shimContentType), "%s", contentType ? contentType : "text/html");
+  response = String(F("HTTP/1.")) + String(1) + ' ';
+  response += String(code);
+  response += ' ';
+  response += String(code == 200 ? F("OK") : F("Error"));
+  response += "\r\n";
+  sendHeader(String(F("Content-Type")), String(FPSTR(shimContentType)), true);
+  sendHeader(String(F("Content-Length")), String(contentLength));
+  sendHeader(String(F("Connection")), String(F("close")));
+  response += responseHeaders;
+  response += "\r\n";
+  responseHeaders = "";
+}
+
+void WebServer::captureHeader(const String& header) {
+  snprintf(shimHeaders, sizeof(shimHeaders), "%s", header.c_str());
+}
+
+void WebServer::send(int code, const char* contentType, const String& content) {
+  String header;
+  prepareHeader(header, code, contentType, content.length());
+  captureHeader(header);
+  if (content.length()) sendContent(content);
+}
+
+void WebServer::send_P(int code, PGM_P contentType, PGM_P content, size_t contentLength) {
+  String header;
+  prepareHeader(header, code, contentType, contentLength);
+  captureHeader(header);
+  sendContent(content, contentLength);
+}
+
+void WebServer::sendContent(const char* content, size_t size) {
+  if (shimBodyLength < NATIVE_HTTP_BODY_SIZE) {
+    size_t room = NATIVE_HTTP_BODY_SIZE - shimBodyLength;
+    size_t n = size < room ? size : room;
+    memcpy(shimBody + shimBodyLength, content, n);
+    shimBody[shimBodyLength + n] = '\0';
+  }
+  shimBodyLength += size;
+}
+
+bool WebServer::shimRequest(const char* uri, const char* query, const char* accept) {
+  _currentUri = uri;
+  acceptHeader = accept;
+  argCount = 0;
+  // Requête "a=1&b=2" sans décodage %xx
+  const char* p = query;
+  while (p && *p && argCount < NATIVE_HTTP_MAX_ARGS) {
+    const char* amp = strchr(p, '&');
+    const char* end = amp ? amp : p + strlen(p);
+    const char* eq = static_cast<const char*>(memchr(p, '=', end - p));
+    argNames[argCount] = String(p, (unsigned int)((eq ? eq : end) - p));
+    argValues[argCount] = eq ? String(eq + 1, (unsigned int)(end - eq - 1)) : String();
+    argCount++;
+    p = amp ? amp + 1 : nullptr;
+  }
+
+  shimCode = 0;
+  shimContentType[0] = '\0';
+  shimHeaders[0] = '\0';
+  shimBody[0] = '\0';
+  shimBodyLength = 0;
+  for (const Route& route : routes) {
+    if (strcmp(route.uri, uri) == 0) {
+      route.handler();
+      return true;
+    }
+  }
+  if (notFound) notFound();
+  return false;
+}
@@ -0,0 +1,78 @@
+/*
+ * WEBSERVER.H - Host WebServer for the native env (no sockets)
+ * shimRequest() dispatches a URI + query to the registered handler. The
+ * status line and headers are built with the same String operations as the
+ * Arduino-ESP32 WebServer, so a handler's allocation count includes them;
+ * what would go to the socket is copied into fixed buffers
+ */
+
+#ifndef NATIVE_WEBSERVER_H
+#define NATIVE_WEBSERVER_H
+
+#include <functional>
+#include <vector>
+#include "Arduino.h"
+
+#define CONTENT_LENGTH_UNKNOWN ((size_t)-1)
+#define NATIVE_HTTP_MAX_ARGS 8
+#define NATIVE_HTTP_BODY_SIZE 16384
+
+class WebServer {
+public:
+  typedef std::function<void(void)> THandlerFunction;
+
+  explicit WebServer(int port = 80) { (void)port; }
+  virtual ~WebServer() {}
+
+  virtual void begin() {}
+  void handleClient() {}
+  void on(const char* uri, THandlerFunction handler);
+  void onNotFound(THandlerFunction handler) { notFound = handler; }
+  void collectHeaders(const char* headerKeys[], const size_t headerKeysCount) { (void)headerKeys; (void)headerKeysCount; }
+
+  String uri() const { return _currentUri; }
+  int args() const { return argCount; }
+  bool hasArg(const String& name) const;
+  String arg(const String& name) const;
+  String header(const String& name) const;
+
+  void sendHeader(const String& name, const String& value, bool first = false);
+  void setContentLength(size_t length) { (void)length; }
+  void send(int code, const char* contentType = NULL, const String& content = String(""));
+  void send(int code, const String& contentType, const String& content) { send(code, contentType.c_str(), content); }
+  void send(int code, const char* contentType, const char* content) { send(code, contentType, String(content)); }
+  void send_P(int code, PGM_P contentType, PGM_P content, size_t contentLength);
+  void sendContent(const String& content) { sendContent(content.c_str(), content.length()); }
+  void sendContent(const char* content) { sendContent(content, strlen(content)); }
+  void sendContent(const char* content, size_t size);
+
+  // Native only: "accept" fills the Accept request header
+  bool shimRequest(const char* uri, const char* query = "", const char* accept = "");
+  int shimCode = 0;
+  char shimContentType[48] = "";
+  char shimHeaders[256] = "";      // Status line and headers of the last response
+  char shimBody[NATIVE_HTTP_BODY_SIZE + 1] = "";
+  size_t shimBodyLength = 0;       // Full length; shimBody keeps the first NATIVE_HTTP_BODY_SIZE bytes, NUL terminated
+
+protected:
+  String _currentUri;
+
+private:
+  void prepareHeader(String& response, int code, const char* contentType, size_t contentLength);
+  void captureHeader(const String& header);
+
+private:
+  struct Route {
+    const char* uri;
+    THandlerFunction handler;
+  };
+  std::vector<Route> routes;
+  THandlerFunction notFound;
+  String argNames[NATIVE_HTTP_MAX_ARGS];
+  String argValues[NATIVE_HTTP_MAX_ARGS];
+  int argCount = 0;
+  String acceptHeader;
+  String responseHeaders;
+};
+
+#endif // NATIVE_WEBSERVER_H
@@ -0,0 +1,44 @@
+/*
+ * WIRE.CPP - Host I2C bus for the native env
+ */
+
+#include "Wire.h"
+
+TwoWire Wire;
+
+void TwoWire::beginTransmission(uint8_t address) {
+  txAddress = address & 0x7F;
+  txLength = 0;
+}
+
+size_t TwoWire::write(uint8_t data) {
+  if (txLength >= sizeof(txBuffer)) return 0;
+  txBuffer[txLength++] = data;
+  return 1;
+}
+
+size_t TwoWire::write(const uint8_t* data, size_t size) {
+  size_t written = 0;
+  while (written < size && write(data[written])) written++;
+  return written;
+}
+
+uint8_t TwoWire::endTransmission(bool sendStop) {
+  (void)sendStop;
+  I2CDevice* device = devices[txAddress];
+  if (!device) return 2;  // NACK sur l'adresse, comme le driver ESP32
+  device->onWrite(txBuffer, txLength);
+  txLength = 0;
+  return 0;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t address, uint8_t quantity, bool sendStop) {
+  (void)sendStop;
+  rxPos = 0;
+  rxLength = 0;
+  I2CDevice* device = devices[address & 0x7F];
+  if (!device) return 0;
+  if (quantity > sizeof(rxBuffer)) quantity = sizeof(rxBuffer);
+  rxLength = device->onRead(rxBuffer, quantity);
+  return (uint8_t)rxLength;
+}
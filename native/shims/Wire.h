@@ -0,0 +1,56 @@
+/*
+ * WIRE.H - Host I2C bus for the native env
+ * Simulated devices register at an address; writes are forwarded to the
+ * device, requestFrom() asks it for bytes. Unregistered addresses NACK
+ */
+
+#ifndef NATIVE_WIRE_H
+#define NATIVE_WIRE_H
+
+#include <cstddef>
+#include <cstdint>
+
+#define NATIVE_I2C_BUFFER 128
+
+class I2CDevice {
+public:
+  virtual ~I2CDevice() {}
+  virtual void onWrite(const uint8_t* data, size_t size) = 0;   // One transmission
+  virtual size_t onRead(uint8_t* out, size_t size) = 0;         // Bytes returned
+};
+
+class TwoWire {
+public:
+  bool begin(int sda = -1, int scl = -1, uint32_t frequency = 0) {
+    (void)sda; (void)scl; (void)frequency;
+    return true;
+  }
+  bool end() { return true; }
+  bool setClock(uint32_t frequency) { (void)frequency; return true; }
+
+  void beginTransmission(uint8_t address);
+  void beginTransmission(int address) { beginTransmission((uint8_t)address); }
+  size_t write(uint8_t data);
+  size_t write(const uint8_t* data, size_t size);
+  uint8_t endTransmission(bool sendStop = true);
+  uint8_t requestFrom(uint8_t address, uint8_t quantity, bool sendStop = true);
+  uint8_t requestFrom(int address, int quantity) { return requestFrom((uint8_t)address, (uint8_t)quantity); }
+  int available() const { return (int)(rxLength - rxPos); }
+  int read() { return rxPos < rxLength ? rxBuffer[rxPos++] : -1; }
+
+  // Native only
+  void shimAttach(uint8_t address, I2CDevice* device) { devices[address & 0x7F] = device; }
+
+private:
+  I2CDevice* devices[128] = {};
+  uint8_t txAddress = 0;
+  uint8_t txBuffer[NATIVE_I2C_BUFFER];
+  size_t txLength = 0;
+  uint8_t rxBuffer[NATIVE_I2C_BUFFER];
+  size_t rxPos = 0;
+  size_t rxLength = 0;
+};
+
+extern TwoWire Wire;
+
+#endif // NATIVE_WIRE_H
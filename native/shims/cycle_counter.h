@@ -0,0 +1,20 @@
+/*
+ * CYCLE_COUNTER.H - Host cycle counter for the native env
+ * Derived from esp_timer_get_time() at getCpuFrequencyMhz(), so cycle and
+ * microsecond stamps agree like on the device (same crystal)
+ */
+
+#ifndef NATIVE_CYCLE_COUNTER_H
+#define NATIVE_CYCLE_COUNTER_H
+
+#include <Arduino.h>
+
+static inline uint32_t diagCycleCount() {
+  return (uint32_t)(esp_timer_get_time() * getCpuFrequencyMhz());
+}
+
+static inline uint32_t diagCyclesToNs(uint32_t cycles) {
+  return (uint32_t)(((uint64_t)cycles * 1000ULL) / getCpuFrequencyMhz());
+}
+
+#endif // NATIVE_CYCLE_COUNTER_H
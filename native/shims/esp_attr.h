@@ -0,0 +1,13 @@
+/*
+ * ESP_ATTR.H - Host section attributes (native env): plain memory
+ */
+
+#ifndef NATIVE_ESP_ATTR_H
+#define NATIVE_ESP_ATTR_H
+
+#ifndef IRAM_ATTR
+#define IRAM_ATTR
+#endif
+#define DRAM_ATTR
+
+#endif // NATIVE_ESP_ATTR_H
@@ -0,0 +1,40 @@
+/*
+ * ESP_HEAP_CAPS.H - Host heap_caps_* (native env): one counted heap, no PSRAM
+ */
+
+#ifndef NATIVE_ESP_HEAP_CAPS_H
+#define NATIVE_ESP_HEAP_CAPS_H
+
+#include "shim_heap.h"
+
+#define MALLOC_CAP_EXEC (1 << 0)
+#define MALLOC_CAP_32BIT (1 << 1)
+#define MALLOC_CAP_8BIT (1 << 2)
+#define MALLOC_CAP_DMA (1 << 3)
+#define MALLOC_CAP_SPIRAM (1 << 10)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+#define MALLOC_CAP_DEFAULT (1 << 12)
+
+#define NATIVE_HEAP_SIZE (320 * 1024)  // Nominal ESP32-S3 internal heap for free-size reports
+
+inline void* heap_caps_malloc(size_t size, uint32_t caps) {
+  return (caps & MALLOC_CAP_SPIRAM) ? nullptr : shimMalloc(size);
+}
+inline void* heap_caps_calloc(size_t count, size_t size, uint32_t caps) {
+  return (caps & MALLOC_CAP_SPIRAM) ? nullptr : shimCalloc(count, size);
+}
+inline void* heap_caps_realloc(void* ptr, size_t size, uint32_t caps) {
+  return (caps & MALLOC_CAP_SPIRAM) ? nullptr : shimRealloc(ptr, size);
+}
+inline void heap_caps_free(void* ptr) {
+  shimFree(ptr);
+}
+inline size_t heap_caps_get_free_size(uint32_t caps) {
+  if ((caps & MALLOC_CAP_SPIRAM) || shimHeap.bytesLive >= NATIVE_HEAP_SIZE) return 0;
+  return (size_t)(NATIVE_HEAP_SIZE - shimHeap.bytesLive);
+}
+inline size_t heap_caps_get_largest_free_block(uint32_t caps) {
+  return heap_caps_get_free_size(caps);
+}
+
+#endif // NATIVE_ESP_HEAP_CAPS_H
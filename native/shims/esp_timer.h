@@ -0,0 +1,27 @@
+/*
+ * ESP_TIMER.H - Host esp_timer_get_time() (native env), see Arduino.h clock
+ * Periodic timers are accepted but never fire (no scheduler on the host)
+ */
+
+#ifndef NATIVE_ESP_TIMER_H
+#define NATIVE_ESP_TIMER_H
+
+#include <cstdint>
+
+typedef int esp_err_t;
+#define ESP_OK 0
+
+typedef void (*esp_timer_cb_t)(void* arg);
+typedef struct esp_timer* esp_timer_handle_t;
+
+struct esp_timer_create_args_t {
+  esp_timer_cb_t callback;
+  void* arg;
+  const char* name;
+};
+
+int64_t esp_timer_get_time();
+esp_err_t esp_timer_create(const esp_timer_create_args_t* args, esp_timer_handle_t* handle);
+inline esp_err_t esp_timer_start_periodic(esp_timer_handle_t, uint64_t) { return ESP_OK; }
+
+#endif // NATIVE_ESP_TIMER_H
@@ -0,0 +1,44 @@
+/*
+ * FREERTOS.H - Host FreeRTOS port layer (native env)
+ * Single-threaded host: critical sections and interrupt masks are no-ops.
+ * xPortGetCoreID() returns the core chosen with shimSetCoreID(), so per-core
+ * tables (trace rings) can be filled for both cores. configUSE_TRACE_FACILITY
+ * is off: the task profiler reports itself unavailable unless a test fills it
+ */
+
+#ifndef NATIVE_FREERTOS_H
+#define NATIVE_FREERTOS_H
+
+#include <cstdint>
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+
+struct portMUX_TYPE {
+  uint32_t owner;
+};
+
+#define portMUX_INITIALIZER_UNLOCKED {0}
+#define portENTER_CRITICAL(mux) ((void)(mux))
+#define portEXIT_CRITICAL(mux) ((void)(mux))
+#define portENTER_CRITICAL_SAFE(mux) ((void)(mux))
+#define portEXIT_CRITICAL_SAFE(mux) ((void)(mux))
+#define portDISABLE_INTERRUPTS() do { } while (0)
+#define portENABLE_INTERRUPTS() do { } while (0)
+
+#define pdFALSE 0
+#define pdTRUE 1
+#define pdFAIL 0
+#define pdPASS 1
+
+#define configUSE_TRACE_FACILITY 0
+#define tskNO_AFFINITY 0x7FFFFFFF
+
+BaseType_t xPortGetCoreID();
+inline BaseType_t xPortInIsrContext() { return pdFALSE; }
+
+// Native only: core reported by xPortGetCoreID() from now on
+void shimSetCoreID(uint8_t core);
+
+#endif // NATIVE_FREERTOS_H
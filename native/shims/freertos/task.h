@@ -0,0 +1,32 @@
+/*
+ * TASK.H - Host FreeRTOS tasks (native env): no scheduler, task creation
+ * fails so callers take their inline fallback
+ */
+
+#ifndef NATIVE_FREERTOS_TASK_H
+#define NATIVE_FREERTOS_TASK_H
+
+#include "FreeRTOS.h"
+
+typedef void* TaskHandle_t;
+typedef void (*TaskFunction_t)(void*);
+
+typedef enum {
+  eRunning = 0,
+  eReady,
+  eBlocked,
+  eSuspended,
+  eDeleted,
+  eInvalid
+} eTaskState;
+
+TaskHandle_t xTaskGetCurrentTaskHandle();
+
+inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t, const char*, uint32_t, void*, UBaseType_t,
+                                          TaskHandle_t*, BaseType_t) {
+  return pdFAIL;
+}
+
+inline void vTaskDelete(TaskHandle_t) {}
+
+#endif // NATIVE_FREERTOS_TASK_H
@@ -0,0 +1,10 @@
+/*
+ * PGMSPACE.H - Host <pgmspace.h> (native env): PROGMEM data is plain memory
+ */
+
+#ifndef NATIVE_PGMSPACE_H
+#define NATIVE_PGMSPACE_H
+
+#include "Arduino.h"
+
+#endif // NATIVE_PGMSPACE_H
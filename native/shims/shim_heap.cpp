@@ -0,0 +1,101 @@
+/*
+ * SHIM_HEAP.CPP - Counted allocator for the native env
+ */
+
+#include "shim_heap.h"
+#include "alloc_tracer.h"
+#include <cstdlib>
+#include <new>
+
+ShimHeapStats shimHeap = {};
+
+// Taille stockée devant le bloc pour suivre les octets vivants
+struct alignas(std::max_align_t) ShimBlockHeader {
+  size_t size;
+};
+
+static void track(int64_t delta) {
+  shimHeap.bytesLive += delta;
+  if (shimHeap.bytesLive > shimHeap.bytesPeak) shimHeap.bytesPeak = shimHeap.bytesLive;
+}
+
+void* shimMalloc(size_t size) {
+  ShimBlockHeader* block = static_cast<ShimBlockHeader*>(malloc(sizeof(ShimBlockHeader) + size));
+  if (!block) return nullptr;
+  block->size = size;
+  shimHeap.allocations++;
+  shimHeap.bytesAllocated += size;
+  track((int64_t)size);
+  allocTracerOnAlloc(size);
+  return block + 1;
+}
+
+void* shimCalloc(size_t count, size_t size) {
+  void* ptr = shimMalloc(count * size);
+  if (ptr) {
+    for (size_t i = 0; i < count * size; i++) static_cast<char*>(ptr)[i] = 0;
+  }
+  return ptr;
+}
+
+void* shimRealloc(void* ptr, size_t size) {
+  if (!ptr) return shimMalloc(size);
+  ShimBlockHeader* block = static_cast<ShimBlockHeader*>(ptr) - 1;
+  size_t oldSize = block->size;
+  ShimBlockHeader* grown = static_cast<ShimBlockHeader*>(realloc(block, sizeof(ShimBlockHeader) + size));
+  if (!grown) return nullptr;
+  grown->size = size;
+  shimHeap.allocations++;
+  shimHeap.bytesAllocated += size;
+  track((int64_t)size - (int64_t)oldSize);
+  allocTracerOnFree(oldSize);
+  allocTracerOnAlloc(size);
+  return grown + 1;
+}
+
+void shimFree(void* ptr) {
+  if (!ptr) return;
+  ShimBlockHeader* block = static_cast<ShimBlockHeader*>(ptr) - 1;
+  shimHeap.frees++;
+  track(-(int64_t)block->size);
+  allocTracerOnFree(block->size);
+  free(block);
+}
+
+void shimHeapResetPeak() {
+  shimHeap.bytesPeak = shimHeap.bytesLive;
+}
+
+void* operator new(size_t size) {
+  void* ptr = shimMalloc(size ? size : 1);
+  if (!ptr) throw std::bad_alloc();
+  return ptr;
+}
+
+void* operator new[](size_t size) {
+  return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+  return shimMalloc(size ? size : 1);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+  return shimMalloc(size ? size : 1);
+}
+
+void operator delete(void* ptr) noexcept {
+  shimFree(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+  shimFree(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+  shimFree(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+  shimFree(ptr);
+}
@@ -0,0 +1,30 @@
+/*
+ * SHIM_HEAP.H - Allocation counters for the native env
+ * String, heap_caps_* and global operator new/delete all go through these,
+ * so a benchmark can report allocations and bytes per iteration. Each
+ * operation is also reported to alloc_tracer.h (AllocScope)
+ */
+
+#ifndef NATIVE_SHIM_HEAP_H
+#define NATIVE_SHIM_HEAP_H
+
+#include <cstddef>
+#include <cstdint>
+
+struct ShimHeapStats {
+  uint64_t allocations;            // malloc/calloc/new, and realloc that moves or grows from null
+  uint64_t frees;
+  uint64_t bytesAllocated;         // Requested sizes, realloc counted by its new size
+  int64_t bytesLive;
+  int64_t bytesPeak;
+};
+
+extern ShimHeapStats shimHeap;
+
+void* shimMalloc(size_t size);
+void* shimCalloc(size_t count, size_t size);
+void* shimRealloc(void* ptr, size_t size);
+void shimFree(void* ptr);
+void shimHeapResetPeak();
+
+#endif // NATIVE_SHIM_HEAP_H
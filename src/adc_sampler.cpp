@@ -0,0 +1,517 @@
+/*
+ * ADC_SAMPLER.CPP - Continuous ADC sampling implementation
+ */
+
+#include "adc_sampler.h"
+#include "config.h"
+#include <esp_idf_version.h>
+#include <esp_heap_caps.h>
+#include <driver/gpio.h>
+#include <soc/soc_caps.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <cmath>
+#include <cstring>
+
+#if defined(__has_include)
+  #if __has_include(<sdkconfig.h>)
+    #include <sdkconfig.h>
+  #endif
+  #if __has_include(<esp_adc/adc_continuous.h>)
+    #include <esp_adc/adc_continuous.h>
+    #include <esp_adc/adc_cali.h>
+    #include <esp_adc/adc_cali_scheme.h>
+    #define ADC_SAMPLER_HAS_CONTINUOUS 1
+  #endif
+#endif
+#if !defined(ADC_SAMPLER_HAS_CONTINUOUS)
+  #define ADC_SAMPLER_HAS_CONTINUOUS 0
+#endif
+
+// Global sampler status
+ADCSamplerStatus adcSamplerStatus;
+
+struct ADCChannelAccumulator {
+  int pin;
+  uint32_t count;
+  uint64_t sum;
+  uint64_t sumSq;
+  uint16_t minMv;
+  uint16_t maxMv;
+  uint16_t windowHead;
+  uint16_t windowFill;
+  uint16_t window[ADC_SAMPLER_WINDOW];
+};
+
+static ADCChannelAccumulator* accumulators = nullptr;
+static portMUX_TYPE adcSamplerMux = portMUX_INITIALIZER_UNLOCKED;
+static TaskHandle_t adcSamplerTaskHandle = nullptr;
+static volatile bool adcSamplerStopRequested = false;
+static volatile uint32_t adcSamplerOverruns = 0;
+
+static void resetAccumulator(ADCChannelAccumulator& acc) {
+  acc.count = 0;
+  acc.sum = 0;
+  acc.sumSq = 0;
+  acc.minMv = UINT16_MAX;
+  acc.maxMv = 0;
+}
+
+// Appelé avec adcSamplerMux verrouillé
+static inline void recordSample(ADCChannelAccumulator& acc, uint16_t mv) {
+  acc.count++;
+  acc.sum += mv;
+  acc.sumSq += (uint32_t)mv * mv;
+  if (mv < acc.minMv) acc.minMv = mv;
+  if (mv > acc.maxMv) acc.maxMv = mv;
+  acc.window[acc.windowHead] = mv;
+  acc.windowHead = (acc.windowHead + 1) % ADC_SAMPLER_WINDOW;
+  if (acc.windowFill < ADC_SAMPLER_WINDOW) acc.windowFill++;
+}
+
+static void pushSamples(const uint8_t* indices, const uint16_t* values, uint16_t count) {
+  portENTER_CRITICAL(&adcSamplerMux);
+  for (uint16_t i = 0; i < count; i++) {
+    recordSample(accumulators[indices[i]], values[i]);
+  }
+  adcSamplerStatus.totalSamples += count;
+  portEXIT_CRITICAL(&adcSamplerMux);
+}
+
+// ========== DMA (adc_continuous) ==========
+#if ADC_SAMPLER_HAS_CONTINUOUS
+
+#if CONFIG_IDF_TARGET_ESP32 || CONFIG_IDF_TARGET_ESP32S2
+  #define ADC_SAMPLER_OUTPUT_FORMAT ADC_DIGI_OUTPUT_FORMAT_TYPE1
+  #define ADC_SAMPLER_GET_CHANNEL(p) ((p)->type1.channel)
+  #define ADC_SAMPLER_GET_DATA(p) ((p)->type1.data)
+#else
+  #define ADC_SAMPLER_OUTPUT_FORMAT ADC_DIGI_OUTPUT_FORMAT_TYPE2
+  #define ADC_SAMPLER_GET_CHANNEL(p) ((p)->type2.channel)
+  #define ADC_SAMPLER_GET_DATA(p) ((p)->type2.data)
+#endif
+
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 1, 0)
+  #define ADC_SAMPLER_ATTEN ADC_ATTEN_DB_12
+#else
+  #define ADC_SAMPLER_ATTEN ADC_ATTEN_DB_11
+#endif
+
+#define ADC_SAMPLER_FRAME_SAMPLES 256
+#define ADC_SAMPLER_FRAME_BYTES (ADC_SAMPLER_FRAME_SAMPLES * SOC_ADC_DIGI_RESULT_BYTES)
+#define ADC_SAMPLER_LUT_SIZE (1 << SOC_ADC_DIGI_MAX_BITWIDTH)
+
+static adc_continuous_handle_t adcHandle = nullptr;
+static uint16_t* calibrationLut = nullptr;   // raw -> mV, évite adc_cali_raw_to_voltage par échantillon
+static bool calibrationValid = false;
+static int8_t channelToIndex[16];
+
+static bool IRAM_ATTR onADCPoolOverflow(adc_continuous_handle_t handle,
+                                        const adc_continuous_evt_data_t* edata,
+                                        void* userData) {
+  (void)handle;
+  (void)edata;
+  (void)userData;
+  adcSamplerOverruns++;
+  return false;
+}
+
+static bool buildCalibrationLut() {
+  if (calibrationLut) return calibrationValid;
+  calibrationLut = static_cast<uint16_t*>(heap_caps_malloc(ADC_SAMPLER_LUT_SIZE * sizeof(uint16_t), MALLOC_CAP_8BIT));
+  if (!calibrationLut) return false;
+
+  adc_cali_handle_t cali = nullptr;
+  esp_err_t err = ESP_ERR_NOT_SUPPORTED;
+#if ADC_CALI_SCHEME_CURVE_FITTING_SUPPORTED
+  adc_cali_curve_fitting_config_t caliConfig = {};
+  caliConfig.unit_id = ADC_UNIT_1;
+  caliConfig.atten = ADC_SAMPLER_ATTEN;
+  caliConfig.bitwidth = (adc_bitwidth_t)SOC_ADC_DIGI_MAX_BITWIDTH;
+  err = adc_cali_create_scheme_curve_fitting(&caliConfig, &cali);
+#elif ADC_CALI_SCHEME_LINE_FITTING_SUPPORTED
+  adc_cali_line_fitting_config_t caliConfig = {};
+  caliConfig.unit_id = ADC_UNIT_1;
+  caliConfig.atten = ADC_SAMPLER_ATTEN;
+  caliConfig.bitwidth = (adc_bitwidth_t)SOC_ADC_DIGI_MAX_BITWIDTH;
+  err = adc_cali_create_scheme_line_fitting(&caliConfig, &cali);
+#endif
+  calibrationValid = (err == ESP_OK);
+
+  for (int raw = 0; raw < ADC_SAMPLER_LUT_SIZE; raw++) {
+    int mv = 0;
+    if (!calibrationValid || adc_cali_raw_to_voltage(cali, raw, &mv) != ESP_OK) {
+      mv = (raw * 3300) / (ADC_SAMPLER_LUT_SIZE - 1);  // Nominal, sans eFuse
+    }
+    calibrationLut[raw] = (uint16_t)mv;
+  }
+
+  if (calibrationValid) {
+#if ADC_CALI_SCHEME_CURVE_FITTING_SUPPORTED
+    adc_cali_delete_scheme_curve_fitting(cali);
+#elif ADC_CALI_SCHEME_LINE_FITTING_SUPPORTED
+    adc_cali_delete_scheme_line_fitting(cali);
+#endif
+  }
+  return calibrationValid;
+}
+
+static void adcSamplerDMATask(void* parameters) {
+  (void)parameters;
+  static uint8_t frame[ADC_SAMPLER_FRAME_BYTES];
+  uint8_t indices[ADC_SAMPLER_FRAME_SAMPLES];
+  uint16_t values[ADC_SAMPLER_FRAME_SAMPLES];
+
+  while (!adcSamplerStopRequested) {
+    uint32_t received = 0;
+    esp_err_t err = adc_continuous_read(adcHandle, frame, sizeof(frame), &received, 100);
+    if (err == ESP_ERR_TIMEOUT) continue;
+    if (err != ESP_OK) {
+      vTaskDelay(1);
+      continue;
+    }
+
+    uint16_t count = 0;
+    for (uint32_t offset = 0; offset + SOC_ADC_DIGI_RESULT_BYTES <= received; offset += SOC_ADC_DIGI_RESULT_BYTES) {
+      const adc_digi_output_data_t* data = reinterpret_cast<const adc_digi_output_data_t*>(&frame[offset]);
+      uint32_t channel = ADC_SAMPLER_GET_CHANNEL(data);
+      uint32_t raw = ADC_SAMPLER_GET_DATA(data);
+      if (channel >= sizeof(channelToIndex) || channelToIndex[channel] < 0 || raw >= ADC_SAMPLER_LUT_SIZE) continue;
+      indices[count] = (uint8_t)channelToIndex[channel];
+      values[count] = calibrationLut[raw];
+      count++;
+    }
+    if (count > 0) pushSamples(indices, values, count);
+  }
+
+  adcSamplerTaskHandle = nullptr;
+  vTaskDelete(nullptr);
+}
+
+static void stopDMASampler() {
+  if (adcHandle) {
+    adc_continuous_stop(adcHandle);
+    adc_continuous_deinit(adcHandle);
+    adcHandle = nullptr;
+  }
+}
+
+static bool startDMASampler(const int* pins, uint8_t count, uint32_t& sampleRate, String& error) {
+  memset(channelToIndex, -1, sizeof(channelToIndex));
+  adc_digi_pattern_config_t pattern[ADC_SAMPLER_MAX_CHANNELS] = {};
+
+  for (uint8_t i = 0; i < count; i++) {
+    adc_unit_t unit;
+    adc_channel_t channel;
+    if (adc_continuous_io_to_channel(pins[i], &unit, &channel) != ESP_OK || unit != ADC_UNIT_1) {
+      error = "GPIO " + String(pins[i]) + " is not an ADC1 pin";
+      return false;
+    }
+    pattern[i].atten = ADC_SAMPLER_ATTEN;
+    pattern[i].channel = (uint8_t)channel;
+    pattern[i].unit = ADC_UNIT_1;
+    pattern[i].bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+    channelToIndex[channel] = (int8_t)i;
+  }
+
+  if (sampleRate < SOC_ADC_SAMPLE_FREQ_THRES_LOW) sampleRate = SOC_ADC_SAMPLE_FREQ_THRES_LOW;
+  if (sampleRate > SOC_ADC_SAMPLE_FREQ_THRES_HIGH) sampleRate = SOC_ADC_SAMPLE_FREQ_THRES_HIGH;
+
+  buildCalibrationLut();
+  if (!calibrationLut) {
+    error = "Calibration table allocation failed";
+    return false;
+  }
+
+  adc_continuous_handle_cfg_t handleConfig = {};
+  handleConfig.max_store_buf_size = ADC_SAMPLER_FRAME_BYTES * 4;
+  handleConfig.conv_frame_size = ADC_SAMPLER_FRAME_BYTES;
+  if (adc_continuous_new_handle(&handleConfig, &adcHandle) != ESP_OK) {
+    error = "adc_continuous_new_handle failed";
+    adcHandle = nullptr;
+    return false;
+  }
+
+  adc_continuous_config_t digiConfig = {};
+  digiConfig.pattern_num = count;
+  digiConfig.adc_pattern = pattern;
+  digiConfig.sample_freq_hz = sampleRate;
+  digiConfig.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+  digiConfig.format = ADC_SAMPLER_OUTPUT_FORMAT;
+
+  adc_continuous_evt_cbs_t callbacks = {};
+  callbacks.on_pool_ovf = onADCPoolOverflow;
+
+  if (adc_continuous_config(adcHandle, &digiConfig) != ESP_OK ||
+      adc_continuous_register_event_callbacks(adcHandle, &callbacks, nullptr) != ESP_OK ||
+      adc_continuous_start(adcHandle) != ESP_OK) {
+    error = "adc_continuous configuration failed";
+    adc_continuous_deinit(adcHandle);
+    adcHandle = nullptr;
+    return false;
+  }
+
+  if (xTaskCreatePinnedToCore(adcSamplerDMATask, "ADCSampler", 4096, nullptr, 2,
+                              &adcSamplerTaskHandle, tskNO_AFFINITY) != pdPASS) {
+    stopDMASampler();
+    error = "Unable to start sampler task";
+    return false;
+  }
+  adcSamplerStatus.calibrated = calibrationValid;
+  return true;
+}
+
+#endif // ADC_SAMPLER_HAS_CONTINUOUS
+
+// ========== POLLING FALLBACK (analogReadMilliVolts) ==========
+static void adcSamplerPollTask(void* parameters) {
+  (void)parameters;
+  const uint8_t count = adcSamplerStatus.channelCount;
+  uint8_t indices[ADC_SAMPLER_MAX_CHANNELS];
+  uint16_t values[ADC_SAMPLER_MAX_CHANNELS];
+  TickType_t lastWake = xTaskGetTickCount();
+
+  while (!adcSamplerStopRequested) {
+    // analogReadMilliVolts applique la calibration eFuse du core Arduino
+    for (uint8_t i = 0; i < count; i++) {
+      indices[i] = i;
+      values[i] = (uint16_t)analogReadMilliVolts(accumulators[i].pin);
+    }
+    pushSamples(indices, values, count);
+
+    TickType_t before = xTaskGetTickCount();
+    vTaskDelayUntil(&lastWake, 1);
+    if (lastWake - before > 1) adcSamplerOverruns++;
+  }
+
+  adcSamplerTaskHandle = nullptr;
+  vTaskDelete(nullptr);
+}
+
+// Arduino numérote les canaux ADC1 avant ceux de l'ADC2 (core 2.x et 3.x)
+bool isADC1Pin(int pin) {
+  if (pin < 0 || pin >= GPIO_PIN_COUNT) return false;
+  int8_t channel = digitalPinToAnalogChannel((uint8_t)pin);
+  return channel >= 0 && channel < SOC_ADC_MAX_CHANNEL_NUM;
+}
+
+bool startADCSampler(const int* pins, uint8_t count, uint32_t sampleRate, String& error) {
+  stopADCSampler();
+
+  if (count == 0 || count > ADC_SAMPLER_MAX_CHANNELS) {
+    error = "1 to 8 channels required";
+    return false;
+  }
+  if (!accumulators) {
+    size_t bytes = sizeof(ADCChannelAccumulator) * ADC_SAMPLER_MAX_CHANNELS;
+    accumulators = static_cast<ADCChannelAccumulator*>(heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+    if (!accumulators) {
+      accumulators = static_cast<ADCChannelAccumulator*>(heap_caps_malloc(bytes, MALLOC_CAP_8BIT));
+    }
+    if (!accumulators) {
+      error = "Buffer allocation failed";
+      return false;
+    }
+  }
+
+  for (uint8_t i = 0; i < count; i++) {
+    accumulators[i].pin = pins[i];
+    accumulators[i].windowHead = 0;
+    accumulators[i].windowFill = 0;
+    resetAccumulator(accumulators[i]);
+  }
+
+  adcSamplerStatus = ADCSamplerStatus();
+  adcSamplerStatus.channelCount = count;
+  adcSamplerOverruns = 0;
+  adcSamplerStopRequested = false;
+
+  bool started = false;
+#if ADC_SAMPLER_HAS_CONTINUOUS && ENABLE_ADC_DMA
+  started = startDMASampler(pins, count, sampleRate, error);
+  if (!started) {
+    adcSamplerStatus.error = error;
+    return false;
+  }
+  adcSamplerStatus.dma = true;
+#endif
+
+  if (!started) {
+    // Une conversion par canal et par tick FreeRTOS
+    for (uint8_t i = 0; i < count; i++) {
+      pinMode(pins[i], ANALOG);
+    }
+    sampleRate = (uint32_t)count * configTICK_RATE_HZ;
+    adcSamplerStatus.calibrated = true;
+    started = xTaskCreatePinnedToCore(adcSamplerPollTask, "ADCSampler", 3072, nullptr, 2,
+                                      &adcSamplerTaskHandle, tskNO_AFFINITY) == pdPASS;
+  }
+
+  if (!started) {
+    error = "Unable to start sampler task";
+    adcSamplerStatus.error = error;
+    return false;
+  }
+
+  adcSamplerStatus.running = true;
+  adcSamplerStatus.sampleRate = sampleRate;
+  adcSamplerStatus.perChannelRate = sampleRate / count;
+  Serial.printf("[ADC] Echantillonnage continu %s: %u canaux @ %lu S/s (%s)\r\n",
+                adcSamplerStatus.dma ? "DMA" : "polling", count, (unsigned long)sampleRate,
+                adcSamplerStatus.calibrated ? "calibré" : "non calibré");
+  return true;
+}
+
+void stopADCSampler() {
+  if (adcSamplerTaskHandle != nullptr) {
+    adcSamplerStopRequested = true;
+    unsigned long start = millis();
+    while (adcSamplerTaskHandle != nullptr && (millis() - start) < 500) {
+      vTaskDelay(pdMS_TO_TICKS(5));
+    }
+  }
+#if ADC_SAMPLER_HAS_CONTINUOUS
+  stopDMASampler();
+#endif
+  adcSamplerStatus.running = false;
+}
+
+uint8_t snapshotADCSamplerStats(ADCChannelStats* out, uint8_t maxCount) {
+  if (!accumulators) return 0;
+  uint8_t count = adcSamplerStatus.channelCount < maxCount ? adcSamplerStatus.channelCount : maxCount;
+  ADCChannelAccumulator interval[ADC_SAMPLER_MAX_CHANNELS];
+
+  // Copie puis remise à zéro de l'intervalle ; la fenêtre glissante est conservée
+  portENTER_CRITICAL(&adcSamplerMux);
+  for (uint8_t i = 0; i < count; i++) {
+    interval[i].count = accumulators[i].count;
+    interval[i].sum = accumulators[i].sum;
+    interval[i].sumSq = accumulators[i].sumSq;
+    interval[i].minMv = accumulators[i].minMv;
+    interval[i].maxMv = accumulators[i].maxMv;
+    resetAccumulator(accumulators[i]);
+  }
+  adcSamplerStatus.overruns = adcSamplerOverruns;
+  portEXIT_CRITICAL(&adcSamplerMux);
+
+  for (uint8_t i = 0; i < count; i++) {
+    ADCChannelStats& stats = out[i];
+    stats = ADCChannelStats();
+    stats.pin = accumulators[i].pin;
+    stats.count = interval[i].count;
+    if (stats.count == 0) continue;
+    double mean = (double)interval[i].sum / stats.count;
+    double meanSq = (double)interval[i].sumSq / stats.count;
+    double variance = meanSq - mean * mean;
+    stats.meanMv = (float)mean;
+    stats.rmsMv = (float)sqrt(meanSq);
+    stats.noiseMv = variance > 0.0 ? (float)sqrt(variance) : 0.0f;
+    stats.minMv = interval[i].minMv;
+    stats.maxMv = interval[i].maxMv;
+  }
+  return count;
+}
+
+// Copie chronologique des N derniers échantillons de la fenêtre
+static uint16_t copyWindow(uint8_t channel, uint16_t* out, uint16_t wanted) {
+  if (!accumulators || channel >= adcSamplerStatus.channelCount) return 0;
+  portENTER_CRITICAL(&adcSamplerMux);
+  const ADCChannelAccumulator& acc = accumulators[channel];
+  uint16_t available = acc.windowFill < wanted ? acc.windowFill : wanted;
+  uint16_t start = (acc.windowHead + ADC_SAMPLER_WINDOW - available) % ADC_SAMPLER_WINDOW;
+  for (uint16_t i = 0; i < available; i++) {
+    out[i] = acc.window[(start + i) % ADC_SAMPLER_WINDOW];
+  }
+  portEXIT_CRITICAL(&adcSamplerMux);
+  return available;
+}
+
+bool computeADCHistogram(uint8_t channel, ADCHistogram& histogram) {
+  static uint16_t samples[ADC_SAMPLER_WINDOW];
+  uint16_t count = copyWindow(channel, samples, ADC_SAMPLER_WINDOW);
+  histogram = ADCHistogram();
+  if (count == 0) return false;
+
+  uint16_t minMv = UINT16_MAX;
+  uint16_t maxMv = 0;
+  for (uint16_t i = 0; i < count; i++) {
+    if (samples[i] < minMv) minMv = samples[i];
+    if (samples[i] > maxMv) maxMv = samples[i];
+  }
+  uint16_t span = maxMv - minMv + 1;
+  histogram.startMv = minMv;
+  histogram.binMv = (span + ADC_SAMPLER_HISTOGRAM_BINS - 1) / ADC_SAMPLER_HISTOGRAM_BINS;
+  if (histogram.binMv == 0) histogram.binMv = 1;
+  for (uint16_t i = 0; i < count; i++) {
+    uint16_t bin = (samples[i] - minMv) / histogram.binMv;
+    if (bin >= ADC_SAMPLER_HISTOGRAM_BINS) bin = ADC_SAMPLER_HISTOGRAM_BINS - 1;
+    histogram.counts[bin]++;
+  }
+  return true;
+}
+
+// FFT radix-2 in-place (Cooley-Tukey itératif)
+static void fftRadix2(float* re, float* im, uint16_t n) {
+  for (uint16_t i = 1, j = 0; i < n; i++) {
+    uint16_t bit = n >> 1;
+    for (; j & bit; bit >>= 1) j ^= bit;
+    j ^= bit;
+    if (i < j) {
+      float t = re[i]; re[i] = re[j]; re[j] = t;
+      t = im[i]; im[i] = im[j]; im[j] = t;
+    }
+  }
+  for (uint16_t len = 2; len <= n; len <<= 1) {
+    float angle = -2.0f * (float)M_PI / len;
+    float wRe = cosf(angle);
+    float wIm = sinf(angle);
+    for (uint16_t i = 0; i < n; i += len) {
+      float curRe = 1.0f;
+      float curIm = 0.0f;
+      for (uint16_t k = 0; k < len / 2; k++) {
+        uint16_t a = i + k;
+        uint16_t b = i + k + len / 2;
+        float tRe = re[b] * curRe - im[b] * curIm;
+        float tIm = re[b] * curIm + im[b] * curRe;
+        re[b] = re[a] - tRe;
+        im[b] = im[a] - tIm;
+        re[a] += tRe;
+        im[a] += tIm;
+        float nextRe = curRe * wRe - curIm * wIm;
+        curIm = curRe * wIm + curIm * wRe;
+        curRe = nextRe;
+      }
+    }
+  }
+}
+
+uint16_t computeADCSpectrum(uint8_t channel, float* magnitudesMv, uint16_t maxBins, float& binHz) {
+  static uint16_t samples[ADC_SAMPLER_FFT_SIZE];
+  static float re[ADC_SAMPLER_FFT_SIZE];
+  static float im[ADC_SAMPLER_FFT_SIZE];
+  const uint16_t n = ADC_SAMPLER_FFT_SIZE;
+
+  binHz = 0.0f;
+  if (adcSamplerStatus.perChannelRate == 0 || copyWindow(channel, samples, n) < n) return 0;
+
+  double mean = 0.0;
+  for (uint16_t i = 0; i < n; i++) mean += samples[i];
+  mean /= n;
+
+  // Fenêtre de Hann, composante continue retirée
+  float windowSum = 0.0f;
+  for (uint16_t i = 0; i < n; i++) {
+    float w = 0.5f - 0.5f * cosf(2.0f * (float)M_PI * i / (n - 1));
+    re[i] = (float)(samples[i] - mean) * w;
+    im[i] = 0.0f;
+    windowSum += w;
+  }
+  fftRadix2(re, im, n);
+
+  uint16_t bins = n / 2 < maxBins ? n / 2 : maxBins;
+  for (uint16_t k = 0; k < bins; k++) {
+    magnitudesMv[k] = 2.0f * sqrtf(re[k] * re[k] + im[k] * im[k]) / windowSum;
+  }
+  binHz = (float)adcSamplerStatus.perChannelRate / n;
+  return bins;
+}
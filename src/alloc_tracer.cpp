@@ -0,0 +1,108 @@
+/*
+ * ALLOC_TRACER.CPP - Per-scope heap allocation counters
+ */
+
+#include "alloc_tracer.h"
+#include "config.h"
+
+#ifndef NATIVE_BUILD
+#include <esp_heap_caps.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
+// Scope active (une seule tâche à la fois, celle qui l'a ouvert)
+static AllocCounters* volatile activeCounters = nullptr;
+static void* volatile activeTask = nullptr;
+
+static inline void* currentTask() {
+#ifdef NATIVE_BUILD
+  return nullptr;
+#else
+  return xTaskGetCurrentTaskHandle();
+#endif
+}
+
+static inline AllocCounters* countersForCaller() {
+  AllocCounters* counters = activeCounters;
+  if (!counters || activeTask != currentTask()) {
+    return nullptr;
+  }
+  return counters;
+}
+
+AllocScope::AllocScope(AllocCounters& counters) : previous(activeCounters), previousTask(activeTask) {
+  activeCounters = nullptr;
+  activeTask = currentTask();
+  activeCounters = &counters;
+}
+
+AllocScope::~AllocScope() {
+  AllocCounters* inner = activeCounters;
+  activeCounters = nullptr;
+  // Report dans le scope englobant : le pic interne s'ajoute à son niveau courant
+  if (previous && inner) {
+    if (previous->live + inner->peak > previous->peak) {
+      previous->peak = previous->live + inner->peak;
+    }
+    previous->allocations += inner->allocations;
+    previous->frees += inner->frees;
+    previous->bytes += inner->bytes;
+    previous->live += inner->live;
+  }
+  activeTask = previousTask;
+  activeCounters = previous;
+}
+
+void allocTracerOnAlloc(size_t bytes) {
+  AllocCounters* counters = countersForCaller();
+  if (!counters) return;
+  counters->allocations++;
+  counters->bytes += bytes;
+  counters->live += (int32_t)bytes;
+  if (counters->live > counters->peak) counters->peak = counters->live;
+}
+
+void allocTracerOnFree(size_t bytes) {
+  AllocCounters* counters = countersForCaller();
+  if (!counters) return;
+  counters->frees++;
+  counters->live -= (int32_t)bytes;
+}
+
+#if ENABLE_ALLOC_TRACER && !defined(NATIVE_BUILD)
+// Linker : -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc,--wrap=free
+extern "C" {
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+void __real_free(void* ptr);
+
+void* __wrap_malloc(size_t size) {
+  void* ptr = __real_malloc(size);
+  if (ptr && activeCounters) allocTracerOnAlloc(heap_caps_get_allocated_size(ptr));
+  return ptr;
+}
+
+void* __wrap_calloc(size_t count, size_t size) {
+  void* ptr = __real_calloc(count, size);
+  if (ptr && activeCounters) allocTracerOnAlloc(heap_caps_get_allocated_size(ptr));
+  return ptr;
+}
+
+void* __wrap_realloc(void* ptr, size_t size) {
+  size_t oldSize = (ptr && activeCounters) ? heap_caps_get_allocated_size(ptr) : 0;
+  void* result = __real_realloc(ptr, size);
+  if (activeCounters && (result || size == 0)) {
+    if (ptr) allocTracerOnFree(oldSize);
+    if (result) allocTracerOnAlloc(heap_caps_get_allocated_size(result));
+  }
+  return result;
+}
+
+void __wrap_free(void* ptr) {
+  if (ptr && activeCounters) allocTracerOnFree(heap_caps_get_allocated_size(ptr));
+  __real_free(ptr);
+}
+}
+#endif
@@ -0,0 +1,484 @@
+/*
+ * API_ROUTES.CPP - Response bodies of the budgeted /api routes and /metrics
+ */
+
+#include "api_routes.h"
+#include "gps_time.h"
+#include "json_helpers.h"
+#include "languages.h"
+#include "request_arena.h"
+#include "trace.h"
+#include "metrics_writer.h"
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+
+void sendGPSData(DiagnosticWebServer& server, const GPSData& gps) {
+  ArenaText json(400);
+  json.printf("{\"valid\":%s,\"hasFix\":%s,\"latitude\":%.6f,\"longitude\":%.6f,\"altitude\":%.2f,",
+              gps.valid ? "true" : "false", gps.hasFix ? "true" : "false",
+              gps.latitude, gps.longitude, gps.altitude);
+  json.printf("\"satellites\":%u,\"satellites_used\":%u,\"hdop\":%.2f,\"speed\":%.2f,\"course\":%.2f,",
+              gps.satellites, gps.satellites_used, gps.hdop, gps.speed, gps.course);
+  json.printf("\"fix_type\":\"%s\",\"status\":\"%s\",\"time\":\"%u:%u:%u\",\"date\":\"%u/%u/%u\"}",
+              gps.fix_type.c_str(), gps.status_str.c_str(),
+              gps.hour, gps.minute, gps.second, gps.day, gps.month, gps.year);
+
+  server.send(200, "application/json", json);
+}
+
+void sendGPSSatellites(DiagnosticWebServer& server, const GPSData& gps, const GPSSkyView& sky, bool available) {
+  uint8_t inView[GPS_SYSTEM_COUNT] = {0};
+  uint8_t used[GPS_SYSTEM_COUNT] = {0};
+  for (uint8_t i = 0; i < sky.count; i++) {
+    inView[sky.satellites[i].system]++;
+    if (sky.satellites[i].usedInFix) used[sky.satellites[i].system]++;
+  }
+
+  ArenaText json(640 + sky.count * 80);
+  json.printf("{\"available\":%s,\"has_fix\":%s,\"fix_type\":\"%s\",\"in_view\":%u,\"used\":%u,\"tracked\":%u,",
+              available ? "true" : "false", gps.hasFix ? "true" : "false", gps.fix_type.c_str(),
+              sky.count, sky.used, sky.tracked);
+  json.printf("\"mean_snr\":%u,\"max_snr\":%u,\"pdop\":%.2f,\"hdop\":%.2f,\"vdop\":%.2f,",
+              sky.meanSnr, sky.maxSnr, gps.pdop, gps.hdop, gps.vdop);
+  json.printf("\"ttff_ms\":%lu,\"reacquire_ms\":%lu,\"fix_losses\":%lu,\"age_ms\":%lu,",
+              (unsigned long)sky.ttffMs, (unsigned long)sky.reacquireMs, (unsigned long)sky.fixLosses,
+              (unsigned long)(sky.updatedMs ? millis() - sky.updatedMs : 0));
+  json.printf("\"gsv_bursts\":%lu,\"gsv_errors\":%lu,\"gsa_sentences\":%lu,\"constellations\":{",
+              (unsigned long)sky.gsvBursts, (unsigned long)sky.gsvErrors, (unsigned long)sky.gsaSentences);
+  for (uint8_t s = GPS_SYSTEM_GPS; s < GPS_SYSTEM_COUNT; s++) {
+    json.printf("%s\"%s\":{\"in_view\":%u,\"used\":%u}", s > GPS_SYSTEM_GPS ? "," : "",
+                gpsConstellationName((GPSConstellation)s), inView[s], used[s]);
+  }
+  json += "},\"satellites\":[";
+  for (uint8_t i = 0; i < sky.count; i++) {
+    const GPSSatellite& sat = sky.satellites[i];
+    json.printf("%s{\"prn\":%u,\"system\":\"%s\",\"elevation\":%d,\"azimuth\":%d,\"snr\":%u,\"used\":%s}",
+                i ? "," : "", sat.prn, gpsConstellationName(sat.system), sat.elevation, sat.azimuth,
+                sat.snr, sat.usedInFix ? "true" : "false");
+  }
+  json += "]}";
+
+  server.send(200, "application/json", json);
+}
+
+void sendEnvironmentalSensors(DiagnosticWebServer& server, const EnvironmentalData& env) {
+  ArenaText json(400);
+  json.printf("{\"aht20_available\":%s,\"bmp280_available\":%s,",
+              env.aht20_available ? "true" : "false", env.bmp280_available ? "true" : "false");
+  json.printf("\"temperature_avg\":%.1f,\"humidity\":%.1f,\"pressure\":%.2f,\"altitude\":%.1f,",
+              env.temperature_avg, env.humidity, env.pressure, env.altitude);
+  json.printf("\"aht20_temp\":%.1f,\"bmp280_temp\":%.1f,\"bmp280_cycles\":%lu,", env.temperature_aht20,
+              env.temperature_bmp280, (unsigned long)env.bmp280_compensation_cycles);
+  json.printf("\"aht20_status\":\"%s\",\"bmp280_status\":\"%s\",\"combined_status\":\"%s\"}",
+              env.aht20_status.c_str(), env.bmp280_status.c_str(), env.combined_status.c_str());
+
+  server.send(200, "application/json", json);
+}
+
+void sendMemoryDetails(DiagnosticWebServer& server, const DetailedMemoryInfo& memory) {
+  ArenaText json(450);
+  json.printf("{\"flash\":{\"real\":%lu,\"chip\":%lu},", (unsigned long)memory.flashSizeReal,
+              (unsigned long)memory.flashSizeChip);
+  json.printf("\"psram\":{\"available\":%s,\"configured\":%s,\"supported\":%s,\"type\":\"%s\",\"total\":%lu,\"free\":%lu},",
+              memory.psramAvailable ? "true" : "false", memory.psramConfigured ? "true" : "false",
+              memory.psramBoardSupported ? "true" : "false",
+              memory.psramType ? memory.psramType : reinterpret_cast<const char*>(Texts::unknown.get()),
+              (unsigned long)memory.psramTotal, (unsigned long)memory.psramFree);
+  json.printf("\"sram\":{\"total\":%lu,\"free\":%lu},\"fragmentation\":%.1f,\"status\":\"%s\"}",
+              (unsigned long)memory.sramTotal, (unsigned long)memory.sramFree, memory.fragmentationPercent,
+              memoryStatusText(memory.memoryStatus));
+
+  server.send(200, "application/json", json);
+}
+
+void sendADCStream(DiagnosticWebServer& server, const ADCSamplerStatus& status, const ADCStreamSnapshot& snapshot) {
+  const uint8_t count = snapshot.count;
+  size_t capacity = 300 + (snapshot.spectrumChannel >= 0 ? ADC_SAMPLER_FFT_SIZE * 4 : 0);
+  for (uint8_t i = 0; i < count; i++) {
+    capacity += snapshot.hasHistogram[i] ? 260 : 160;
+  }
+
+  ArenaText json(capacity);
+  json.printf("{\"running\":%s,\"dma\":%s,\"calibrated\":%s,\"sample_rate\":%lu,\"per_channel_rate\":%lu,",
+              status.running ? "true" : "false", status.dma ? "true" : "false",
+              status.calibrated ? "true" : "false", (unsigned long)status.sampleRate,
+              (unsigned long)status.perChannelRate);
+  json.printf("\"total_samples\":%lu,\"overruns\":%lu,\"channels\":[", (unsigned long)status.totalSamples,
+              (unsigned long)status.overruns);
+  for (uint8_t i = 0; i < count; i++) {
+    const ADCChannelStats& stats = snapshot.stats[i];
+    json.printf("%s{\"pin\":%d,\"count\":%lu,\"mean_mv\":%.1f,\"rms_mv\":%.1f,\"noise_mv\":%.2f,\"min_mv\":%u,\"max_mv\":%u",
+                i ? "," : "", stats.pin, (unsigned long)stats.count, stats.meanMv, stats.rmsMv, stats.noiseMv,
+                stats.count ? stats.minMv : 0, stats.maxMv);
+    if (snapshot.hasHistogram[i]) {
+      const ADCHistogram& histogram = snapshot.histograms[i];
+      json.printf(",\"histogram\":{\"start_mv\":%u,\"bin_mv\":%u,\"counts\":[", histogram.startMv, histogram.binMv);
+      for (uint8_t b = 0; b < ADC_SAMPLER_HISTOGRAM_BINS; b++) {
+        json.printf(b ? ",%u" : "%u", histogram.counts[b]);
+      }
+      json += "]}";
+    }
+    json += '}';
+  }
+  json += ']';
+
+  if (snapshot.spectrumChannel >= 0) {
+    json.printf(",\"spectrum\":{\"channel\":%d,\"bin_hz\":%.2f,\"mags_mv\":[", snapshot.spectrumChannel,
+                snapshot.binHz);
+    for (uint16_t k = 0; k < snapshot.bins; k++) {
+      json.printf(k ? ",%.2f" : "%.2f", snapshot.magnitudes[k]);
+    }
+    json += "]}";
+  }
+  json += '}';
+
+  server.send(200, "application/json", json);
+}
+
+void sendBootProfile(DiagnosticWebServer& server, const BootProfile& profile, bool complete) {
+  ArenaText json(256 + profile.count * 140);
+  json.printf("{\"cpu_mhz\":%lu,\"complete\":%s,\"server_ready_ms\":%lu,\"first_response_ms\":%lu,\"boot_complete_ms\":%lu,\"stages\":[",
+              (unsigned long)profile.cpuMhz, complete ? "true" : "false",
+              (unsigned long)(profile.serverReadyUs / 1000), (unsigned long)(profile.firstResponseUs / 1000),
+              (unsigned long)(profile.bootCompleteUs / 1000));
+  for (uint8_t i = 0; i < profile.count; i++) {
+    const BootStageRecord& stage = profile.stages[i];
+    json.printf("%s{\"name\":\"%s\",\"core\":%u,\"background\":%s,\"done\":%s,\"start_us\":%lu,\"duration_us\":%lu,\"cycles\":%lu}",
+                i ? "," : "", stage.name, stage.core, stage.background ? "true" : "false",
+                stage.done ? "true" : "false", (unsigned long)(uint32_t)stage.startUs,
+                (unsigned long)stage.durationUs, (unsigned long)stage.cycles);
+  }
+  json += "]}";
+
+  server.send(200, "application/json", json);
+}
+
+#if ENABLE_HTTP_METRICS || ENABLE_TRACE
+// Corps trop longs pour l'arène d'une seule requête : envoyés par morceaux
+// d'environ un segment TCP, le même bloc de l'arène étant réutilisé
+#define API_STREAM_CHUNK 1400
+
+static void flushChunk(DiagnosticWebServer& server, ArenaText& chunk, bool force = false) {
+  if (chunk.length() > (force ? 0 : API_STREAM_CHUNK)) {
+    server.sendJsonFragment(chunk.c_str(), chunk.length());
+    chunk.clear();
+  }
+}
+
+// false (500 déjà envoyé) si le tampon du morceau n'a pas pu être réservé
+static bool beginStream(DiagnosticWebServer& server, const ArenaText& chunk) {
+  if (!chunk.ok()) {
+    server.send(500, "application/json", "{\"error\":\"Out of memory\"}");
+    return false;
+  }
+  server.beginJsonStream(200);
+  return true;
+}
+#endif
+
+#if ENABLE_HTTP_METRICS
+void sendHttpMetrics(DiagnosticWebServer& server) {
+  const uint16_t routeCount = getHttpRouteCount();
+  ArenaText chunk(API_STREAM_CHUNK + 400);
+  if (!beginStream(server, chunk)) return;
+
+  chunk.printf("{\"uptime_ms\":%lu,\"routes_registered\":%u,\"routes\":[", (unsigned long)millis(), routeCount);
+  bool first = true;
+  for (uint16_t i = 0; i < routeCount; i++) {
+    const HttpRouteMetrics* route = getHttpRouteMetrics(i);
+    if (!route || route->latency.count == 0) continue;
+    chunk.printf("%s{\"uri\":\"%s\",\"calls\":%lu,\"avg_us\":%lu,\"p50_us\":%lu,\"p95_us\":%lu,\"p99_us\":%lu,\"max_us\":%lu",
+                 first ? "" : ",", route->uri, (unsigned long)route->latency.count,
+                 (unsigned long)latencyAverage(route->latency),
+                 (unsigned long)latencyPercentile(route->latency, 50),
+                 (unsigned long)latencyPercentile(route->latency, 95),
+                 (unsigned long)latencyPercentile(route->latency, 99), (unsigned long)route->latency.maxUs);
+    first = false;
+    chunk.printf(",\"bytes_total\":%lu,\"bytes_max\":%lu,\"heap_delta_total\":%ld,\"heap_delta_min\":%ld,\"heap_delta_max\":%ld",
+                 (unsigned long)route->bytesTotal, (unsigned long)route->bytesMax, (long)route->heapDeltaTotal,
+                 (long)route->heapDeltaMin, (long)route->heapDeltaMax);
+#if ENABLE_ALLOC_TRACER
+    chunk.printf(",\"alloc_budget\":%u,\"alloc_avg\":%lu,\"alloc_max\":%lu,\"alloc_bytes_max\":%lu,\"alloc_peak_max\":%ld,\"over_budget\":%lu",
+                 route->allocBudget, (unsigned long)(route->allocTotal / route->latency.count),
+                 (unsigned long)route->allocMax, (unsigned long)route->allocBytesMax,
+                 (long)route->allocPeakMax, (unsigned long)route->overBudget);
+#endif
+    chunk += '}';
+    flushChunk(server, chunk);
+  }
+  RequestArenaStats arena;
+  requestArena.stats(arena);
+  chunk.printf("],\"alloc_tracer\":%s,\"arena\":{\"capacity\":%lu,\"psram\":%s,\"high_water\":%lu,\"requests\":%lu,",
+               ENABLE_ALLOC_TRACER ? "true" : "false", (unsigned long)arena.capacity,
+               arena.inPsram ? "true" : "false", (unsigned long)arena.highWater, (unsigned long)arena.requests);
+  chunk.printf("\"spills\":%lu,\"spill_bytes\":%lu,\"failures\":%lu}}", (unsigned long)arena.spills,
+               (unsigned long)arena.spillBytes, (unsigned long)arena.failures);
+  flushChunk(server, chunk, true);
+  server.endJsonStream();
+}
+#endif
+
+#if ENABLE_TASK_PROFILER
+void sendTasks(DiagnosticWebServer& server, const TaskProfilerData& data, uint8_t coreCount) {
+  ArenaText json(256 + data.taskCount * 170);
+  json.printf("{\"run_time_stats\":%s,\"interval_ms\":%lu,\"window_samples\":%u,\"samples\":%lu,\"live_tasks\":%u,",
+              data.runTimeStats ? "true" : "false", (unsigned long)TASK_PROFILER_INTERVAL_MS, data.windowFill,
+              (unsigned long)data.samples, data.liveTasks);
+  json.printf("\"overflows\":%u,\"stack_warn_bytes\":%lu,\"warnings\":%u,\"cores\":[", data.overflows,
+              (unsigned long)TASK_STACK_WARN_BYTES, data.warnings);
+  for (uint8_t c = 0; c < coreCount; c++) {
+    json.printf("%s{\"core\":%u,\"idle_pct\":%.1f,\"idle_window_pct\":%.1f,\"load_window_pct\":%.1f}",
+                c ? "," : "", c, data.cores[c].idleLast, data.cores[c].idleWindow,
+                100.0f - data.cores[c].idleWindow);
+  }
+  json += "],\"tasks\":[";
+  for (uint8_t i = 0; i < data.taskCount; i++) {
+    const TaskProfileEntry& task = data.tasks[i];
+    // Noms choisis par le code qui crée la tâche : échappés comme toute chaîne externe
+    json += i ? ",{\"name\":\"" : "{\"name\":\"";
+    jsonEscapeTo(json, task.name);
+    json.printf("\",\"core\":%d,\"priority\":%u,\"state\":\"%s\",\"cpu_pct\":%.1f,", task.core, task.priority,
+                task.alive ? taskStateName(task.state) : "exited", task.cpuLast);
+    json.printf("\"cpu_window_pct\":%.1f,\"stack_min_free\":%lu,\"stack_warning\":%s}", task.cpuWindow,
+                (unsigned long)task.stackMinBytes, task.stackWarning ? "true" : "false");
+  }
+  json += "]}";
+
+  server.send(200, "application/json", json);
+}
+#endif
+
+#if ENABLE_LOOP_MONITOR
+static void appendLatencyJson(ArenaText& json, const LatencyHistogram& histogram) {
+  json.printf("\"count\":%lu,\"avg_us\":%lu,\"p50_us\":%lu,\"p95_us\":%lu,\"p99_us\":%lu,\"max_us\":%lu",
+              (unsigned long)histogram.count, (unsigned long)latencyAverage(histogram),
+              (unsigned long)latencyPercentile(histogram, 50), (unsigned long)latencyPercentile(histogram, 95),
+              (unsigned long)latencyPercentile(histogram, 99), (unsigned long)histogram.maxUs);
+}
+
+void sendLoopMonitor(DiagnosticWebServer& server, const LoopMonitorData& data) {
+  ArenaText json(1024 + data.topCount * 120);
+  json.printf("{\"loops\":%lu,\"stall_threshold_ms\":%lu,\"stalls\":%lu,\"busy\":{", (unsigned long)data.loops,
+              (unsigned long)LOOP_STALL_THRESHOLD_MS, (unsigned long)data.stalls);
+  appendLatencyJson(json, data.busy);
+  json += "},\"period\":{";
+  appendLatencyJson(json, data.period);
+  json += "},\"phases\":[";
+  for (uint8_t i = 0; i < LOOP_PHASE_COUNT; i++) {
+    json.printf("%s{\"name\":\"%s\",", i ? "," : "", loopPhaseName(i));
+    appendLatencyJson(json, data.phases[i]);
+    json += '}';
+  }
+  json += "],\"top_stalls\":[";
+  for (uint8_t i = 0; i < data.topCount; i++) {
+    const LoopStall& stall = data.top[i];
+    json.printf("%s{\"at_ms\":%lu,\"duration_us\":%lu,\"phase\":\"%s\",\"phase_us\":%lu,\"culprit\":\"",
+                i ? "," : "", (unsigned long)stall.atMs, (unsigned long)stall.durationUs,
+                loopPhaseName(stall.phase), (unsigned long)stall.phaseUs);
+    jsonEscapeTo(json, stall.culprit);  // URI de la requête : texte fourni par le client
+    json += "\"}";
+  }
+  json += "]}";
+
+  server.send(200, "application/json", json);
+}
+#endif
+
+#if ENABLE_TRACE
+void sendTrace(DiagnosticWebServer& server) {
+  ArenaText chunk(API_STREAM_CHUNK + 200);
+  if (!beginStream(server, chunk)) return;
+
+  chunk.printf("{\"cpu_mhz\":%lu,\"ring_events\":%u,", (unsigned long)getCpuFrequencyMhz(), TRACE_RING_EVENTS);
+  // Ancre esp_timer -> UTC du service PPS : horodatage absolu des événements hors ligne
+  int64_t anchorEspUs = 0;
+  uint64_t anchorUtcUs = 0;
+  double driftPpm = 0.0;
+  if (gpsTimeAnchor(anchorEspUs, anchorUtcUs, driftPpm)) {
+    chunk.printf("\"utc_sync\":{\"esp_us\":%.0f,\"utc_us\":%.0f,\"drift_ppm\":%.3f},", (double)anchorEspUs,
+                 (double)anchorUtcUs, driftPpm);
+  } else {
+    chunk += "\"utc_sync\":null,";
+  }
+  chunk += "\"names\":[";
+  for (uint16_t i = 0; i < traceNameCount(); i++) {
+    chunk += i ? ",\"" : "\"";
+    jsonEscapeTo(chunk, traceName(i));
+    chunk += '"';
+    flushChunk(server, chunk);
+  }
+  chunk += "],\"tasks\":{";
+#if ENABLE_TASK_PROFILER
+  // Noms des tâches vues par le profileur, y compris celles déjà terminées
+  for (uint8_t i = 0; i < taskProfilerData.taskCount; i++) {
+    chunk.printf("%s\"%lu\":\"", i ? "," : "", (unsigned long)(uint32_t)(uintptr_t)taskProfilerData.tasks[i].handle);
+    jsonEscapeTo(chunk, taskProfilerData.tasks[i].name);
+    chunk += '"';
+  }
+#endif
+  chunk += "},\"cores\":[";
+  for (uint8_t core = 0; core < traceRingCount(); core++) {
+    const TraceRing& ring = traceRingForCore(core);
+    const uint32_t head = ring.head;
+    const uint32_t first = head > TRACE_RING_EVENTS ? head - TRACE_RING_EVENTS : 0;
+    chunk.printf("%s{\"core\":%u,\"recorded\":%lu,\"sync_cycles\":%lu,\"sync_us\":%.0f,\"events\":[",
+                 core ? "," : "", core, (unsigned long)head, (unsigned long)ring.syncCycles, (double)ring.syncUs);
+    for (uint32_t i = first; i < head; i++) {
+      const TraceEvent& event = ring.events[i & (TRACE_RING_EVENTS - 1)];
+      chunk.printf("%s[%lu,\"%c\",%u,%lu,%lu]", i > first ? "," : "", (unsigned long)event.cycles,
+                   (char)event.type, event.name, (unsigned long)event.task, (unsigned long)event.arg);
+      flushChunk(server, chunk);
+    }
+    chunk += "]}";
+  }
+  chunk += "]}";
+  flushChunk(server, chunk, true);
+  server.endJsonStream();
+}
+#endif
+
+#if ENABLE_OPENMETRICS
+static void writeLatencySummary(MetricsWriter& out, const char* name, const char* labels,
+                                const LatencyHistogram& histogram) {
+  static const uint8_t quantiles[] = {50, 95, 99};
+  const char* separator = labels[0] ? "," : "";
+  for (uint8_t q : quantiles) {
+    out.printf("%s{%s%squantile=\"0.%02u\"} %.6f\n", name, labels, separator, q,
+               latencyPercentile(histogram, q) / 1e6);
+  }
+  const char* open = labels[0] ? "{" : "";
+  const char* close = labels[0] ? "}" : "";
+  out.printf("%s_sum%s%s%s %.6f\n", name, open, labels, close, histogram.totalUs / 1e6);
+  out.printf("%s_count%s%s%s %lu\n", name, open, labels, close, (unsigned long)histogram.count);
+}
+
+void sendMetrics(DiagnosticWebServer& server, bool wifiConnected, long rssi, float chipTemperature,
+                 const EnvironmentalData& env, const GPSData& gps, bool gpsAvailable) {
+  MetricsWriter out(server);
+  out.begin();
+
+  out.family("esp32_uptime_seconds", "gauge", "Time since boot", "seconds");
+  out.printf("esp32_uptime_seconds %.3f\n", esp_timer_get_time() / 1e6);
+  out.family("esp32_cpu_frequency_hertz", "gauge", "CPU clock", "hertz");
+  out.printf("esp32_cpu_frequency_hertz %lu\n", (unsigned long)getCpuFrequencyMhz() * 1000000UL);
+
+  // --- Mémoire ---
+  const uint32_t freeHeap = ESP.getFreeHeap();
+  const uint32_t largestBlock = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT | MALLOC_CAP_INTERNAL);
+  out.family("esp32_heap_free_bytes", "gauge", "Free internal heap", "bytes");
+  out.printf("esp32_heap_free_bytes %lu\n", (unsigned long)freeHeap);
+  out.family("esp32_heap_min_free_bytes", "gauge", "Lowest free heap since boot", "bytes");
+  out.printf("esp32_heap_min_free_bytes %lu\n", (unsigned long)ESP.getMinFreeHeap());
+  out.family("esp32_heap_size_bytes", "gauge", "Internal heap size", "bytes");
+  out.printf("esp32_heap_size_bytes %lu\n", (unsigned long)ESP.getHeapSize());
+  out.family("esp32_heap_largest_free_block_bytes", "gauge", "Largest allocatable internal block", "bytes");
+  out.printf("esp32_heap_largest_free_block_bytes %lu\n", (unsigned long)largestBlock);
+  out.family("esp32_heap_fragmentation_ratio", "gauge", "1 - largest free block / free heap");
+  out.printf("esp32_heap_fragmentation_ratio %.4f\n",
+             freeHeap > 0 ? 1.0 - (double)largestBlock / freeHeap : 0.0);
+  if (ESP.getPsramSize() > 0) {
+    out.family("esp32_psram_free_bytes", "gauge", "Free PSRAM", "bytes");
+    out.printf("esp32_psram_free_bytes %lu\n", (unsigned long)ESP.getFreePsram());
+    out.family("esp32_psram_size_bytes", "gauge", "PSRAM size", "bytes");
+    out.printf("esp32_psram_size_bytes %lu\n", (unsigned long)ESP.getPsramSize());
+  }
+
+  // --- Réseau / capteurs (valeurs en cache) ---
+  out.family("esp32_wifi_connected", "gauge", "1 when associated");
+  out.printf("esp32_wifi_connected %d\n", wifiConnected ? 1 : 0);
+  if (wifiConnected) {
+    out.family("esp32_wifi_rssi_dbm", "gauge", "Received signal strength (dBm)");
+    out.printf("esp32_wifi_rssi_dbm %ld\n", rssi);
+  }
+  if (chipTemperature != -999) {
+    out.family("esp32_chip_temperature_celsius", "gauge", "Internal sensor, refreshed every 30 s", "celsius");
+    out.printf("esp32_chip_temperature_celsius %.1f\n", chipTemperature);
+  }
+  if (env.aht20_available || env.bmp280_available) {
+    out.family("esp32_env_temperature_celsius", "gauge", "Last environmental sensor reading", "celsius");
+    if (env.temperature_aht20 != -999.0) {
+      out.printf("esp32_env_temperature_celsius{sensor=\"aht20\"} %.2f\n", env.temperature_aht20);
+    }
+    if (env.temperature_bmp280 != -999.0) {
+      out.printf("esp32_env_temperature_celsius{sensor=\"bmp280\"} %.2f\n", env.temperature_bmp280);
+    }
+    if (env.humidity != -999.0) {
+      out.family("esp32_env_humidity_percent", "gauge", "AHT20 relative humidity (%RH)");
+      out.printf("esp32_env_humidity_percent %.2f\n", env.humidity);
+    }
+    if (env.pressure != -999.0) {
+      out.family("esp32_env_pressure_pascals", "gauge", "BMP280 pressure", "pascals");
+      out.printf("esp32_env_pressure_pascals %.0f\n", env.pressure * 100.0);
+    }
+  }
+  if (gpsAvailable) {
+    out.family("esp32_gps_fix", "gauge", "1 with a position fix");
+    out.printf("esp32_gps_fix %d\n", gps.hasFix ? 1 : 0);
+    out.family("esp32_gps_satellites", "gauge", "Satellites in view");
+    out.printf("esp32_gps_satellites %u\n", gps.satellites);
+    out.family("esp32_gps_hdop", "gauge", "Horizontal dilution of precision");
+    out.printf("esp32_gps_hdop %.2f\n", gps.hdop);
+  }
+
+  char label[48];
+#if ENABLE_TASK_PROFILER
+  // --- Tâches FreeRTOS (dernier échantillon du profileur) ---
+  const TaskProfilerData& tasks = taskProfilerData;
+  if (tasks.available && tasks.samples > 0) {
+#if CONFIG_FREERTOS_UNICORE
+    const uint8_t coreCount = 1;
+#else
+    const uint8_t coreCount = 2;
+#endif
+    out.family("esp32_core_idle_ratio", "gauge", "Idle task share, sliding window");
+    for (uint8_t c = 0; c < coreCount; c++) {
+      out.printf("esp32_core_idle_ratio{core=\"%u\"} %.4f\n", c, tasks.cores[c].idleWindow / 100.0);
+    }
+    out.family("esp32_task_cpu_ratio", "gauge", "Share of one core, sliding window");
+    for (uint8_t i = 0; i < tasks.taskCount; i++) {
+      if (!tasks.tasks[i].alive) continue;
+      out.printf("esp32_task_cpu_ratio{task=\"%s\",core=\"%d\"} %.4f\n",
+                 MetricsWriter::escapeLabel(label, sizeof(label), tasks.tasks[i].name),
+                 tasks.tasks[i].core, tasks.tasks[i].cpuWindow / 100.0);
+    }
+    out.family("esp32_task_stack_min_free_bytes", "gauge", "Lowest stack headroom seen", "bytes");
+    for (uint8_t i = 0; i < tasks.taskCount; i++) {
+      if (!tasks.tasks[i].alive) continue;
+      out.printf("esp32_task_stack_min_free_bytes{task=\"%s\"} %lu\n",
+                 MetricsWriter::escapeLabel(label, sizeof(label), tasks.tasks[i].name),
+                 (unsigned long)tasks.tasks[i].stackMinBytes);
+    }
+  }
+#endif
+
+#if ENABLE_HTTP_METRICS
+  // --- HTTP (routes appelées au moins une fois) ---
+  const uint16_t routeCount = getHttpRouteCount();
+  out.family("esp32_http_request_duration_seconds", "summary", "Handler latency per route", "seconds");
+  for (uint16_t i = 0; i < routeCount; i++) {
+    const HttpRouteMetrics* route = getHttpRouteMetrics(i);
+    if (!route || route->latency.count == 0) continue;
+    char labels[64];
+    snprintf(labels, sizeof(labels), "route=\"%s\"", MetricsWriter::escapeLabel(label, sizeof(label), route->uri));
+    writeLatencySummary(out, "esp32_http_request_duration_seconds", labels, route->latency);
+  }
+  out.family("esp32_http_response", "counter", "Response body bytes per route", "bytes");
+  for (uint16_t i = 0; i < routeCount; i++) {
+    const HttpRouteMetrics* route = getHttpRouteMetrics(i);
+    if (!route || route->latency.count == 0) continue;
+    out.printf("esp32_http_response_bytes_total{route=\"%s\"} %llu\n",
+               MetricsWriter::escapeLabel(label, sizeof(label), route->uri),
+               (unsigned long long)route->bytesTotal);
+  }
+#endif
+
+#if ENABLE_LOOP_MONITOR
+  out.family("esp32_loop_busy_seconds", "summary", "Work time of one loop() iteration", "seconds");
+  writeLatencySummary(out, "esp32_loop_busy_seconds", "", loopMonitorData.busy);
+  out.family("esp32_loop_stalls", "counter", "loop() iterations above the stall threshold");
+  out.printf("esp32_loop_stalls_total %lu\n", (unsigned long)loopMonitorData.stalls);
+#endif
+
+  out.finish();
+}
+#endif
@@ -0,0 +1,495 @@
+/*
+ * AUTO_EXPORT.CPP - Periodic diagnostic snapshot export
+ */
+
+#include "auto_export.h"
+#include "config.h"
+#include <SD.h>
+#include <FS.h>
+#include <LittleFS.h>
+#include <stdarg.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#define AUTO_EXPORT_WRITE_BUFFER 512
+#define AUTO_EXPORT_TASK_STACK 4096
+
+// Global export status
+AutoExportStatus autoExportStatus;
+
+const char* const snapshotTestNames[SNAPSHOT_TEST_COUNT] = {
+  "builtin_led", "neopixel", "oled", "adc", "pwm", "sd_card", "rotary_encoder"
+};
+
+static const char* const exportExtensions[] = {"txt", "json", "csv"};
+
+// Double buffer: loop() writes the back slot, readers pin the published one
+static DiagnosticSnapshot snapshotSlots[2];
+static volatile int8_t publishedSlot = -1;
+static volatile uint8_t slotPins[2] = {0, 0};
+static int8_t writingSlot = -1;
+static uint32_t snapshotSeq = 0;
+static portMUX_TYPE snapshotMux = portMUX_INITIALIZER_UNLOCKED;
+
+static TaskHandle_t exportTaskHandle = nullptr;
+static volatile bool exportToSD = false;
+static bool littleFsMounted = false;
+static fs::FS* scannedFs = nullptr;
+static uint32_t oldestIndex = 1;
+static uint32_t nextIndex = 1;
+
+DiagnosticSnapshot* snapshotBeginWrite() {
+  int8_t slot;
+  portENTER_CRITICAL(&snapshotMux);
+  slot = publishedSlot == 0 ? 1 : 0;
+  if (slotPins[slot] > 0) {
+    slot = -1;
+  }
+  writingSlot = slot;
+  portEXIT_CRITICAL(&snapshotMux);
+
+  if (slot < 0) {
+    // Export encore en cours sur l'ancien instantané : on garde le publié, capture suivante plus tard
+    autoExportStatus.captureSkips++;
+    return nullptr;
+  }
+  memset(&snapshotSlots[slot], 0, sizeof(DiagnosticSnapshot));
+  return &snapshotSlots[slot];
+}
+
+void snapshotPublish() {
+  if (writingSlot < 0) return;
+  snapshotSlots[writingSlot].seq = ++snapshotSeq;
+  portENTER_CRITICAL(&snapshotMux);
+  publishedSlot = writingSlot;
+  portEXIT_CRITICAL(&snapshotMux);
+  writingSlot = -1;
+  autoExportStatus.snapshots++;
+}
+
+const DiagnosticSnapshot* snapshotAcquire() {
+  int8_t slot;
+  portENTER_CRITICAL(&snapshotMux);
+  slot = publishedSlot;
+  if (slot >= 0) {
+    slotPins[slot]++;
+  }
+  portEXIT_CRITICAL(&snapshotMux);
+  return slot >= 0 ? &snapshotSlots[slot] : nullptr;
+}
+
+void snapshotRelease(const DiagnosticSnapshot* snapshot) {
+  if (!snapshot) return;
+  int slot = snapshot - snapshotSlots;
+  portENTER_CRITICAL(&snapshotMux);
+  if (slot >= 0 && slot < 2 && slotPins[slot] > 0) {
+    slotPins[slot]--;
+  }
+  portEXIT_CRITICAL(&snapshotMux);
+}
+
+const char* autoExportFormatName(uint8_t format) {
+  return format <= AUTO_EXPORT_FORMAT_CSV ? exportExtensions[format] : "?";
+}
+
+// Line-by-line serializer: one section/key/value model rendered as TXT, JSON or CSV
+class SnapshotWriter {
+public:
+  SnapshotWriter(File& file, uint8_t format) : file(file), format(format) {}
+
+  void begin(const DiagnosticSnapshot& snapshot) {
+    if (format == AUTO_EXPORT_FORMAT_JSON) {
+      printf("{\"snapshot\":{\"seq\":%lu,\"captured_ms\":%lu,\"version\":\"%s\"}",
+             (unsigned long)snapshot.seq, (unsigned long)snapshot.capturedMs, PROJECT_VERSION);
+    } else if (format == AUTO_EXPORT_FORMAT_CSV) {
+      printf("category,parameter,value\r\nsnapshot,seq,%lu\r\nsnapshot,captured_ms,%lu\r\n",
+             (unsigned long)snapshot.seq, (unsigned long)snapshot.capturedMs);
+    } else {
+      printf("========================================\r\n%s %s - snapshot #%lu @ %lu ms\r\n========================================\r\n",
+             PROJECT_NAME, PROJECT_VERSION, (unsigned long)snapshot.seq, (unsigned long)snapshot.capturedMs);
+    }
+  }
+
+  void section(const char* name) {
+    currentSection = name;
+    firstField = true;
+    if (format == AUTO_EXPORT_FORMAT_JSON) {
+      printf("%s,\"%s\":{", sectionOpen ? "}" : "", name);
+      sectionOpen = true;
+    } else if (format == AUTO_EXPORT_FORMAT_TXT) {
+      printf("\r\n=== %s ===\r\n", name);
+    }
+  }
+
+  void text(const char* key, const char* value) {
+    field(key, value, true);
+  }
+
+  void number(const char* key, unsigned long value) {
+    char raw[16];
+    snprintf(raw, sizeof(raw), "%lu", value);
+    field(key, raw, false);
+  }
+
+  void signedNumber(const char* key, long value) {
+    char raw[16];
+    snprintf(raw, sizeof(raw), "%ld", value);
+    field(key, raw, false);
+  }
+
+  void decimal(const char* key, double value, uint8_t decimals, bool valid = true) {
+    char raw[24];
+    snprintf(raw, sizeof(raw), "%.*f", decimals, value);
+    field(key, valid ? raw : nullptr, false);
+  }
+
+  void boolean(const char* key, bool value) {
+    field(key, value ? "true" : "false", false);
+  }
+
+  bool finish() {
+    if (format == AUTO_EXPORT_FORMAT_JSON) {
+      printf("%s}\r\n", sectionOpen ? "}" : "");
+    }
+    flush();
+    return !failed;
+  }
+
+  size_t bytesWritten() const {
+    return total;
+  }
+
+private:
+  // nullptr value = not available (null / N/A)
+  void field(const char* key, const char* value, bool quoted) {
+    if (format == AUTO_EXPORT_FORMAT_JSON) {
+      printf("%s\"%s\":", firstField ? "" : ",", key);
+      if (!value) {
+        write("null");
+      } else if (quoted) {
+        put('"');
+        escaped(value, '\\');
+        put('"');
+      } else {
+        write(value);
+      }
+    } else if (format == AUTO_EXPORT_FORMAT_CSV) {
+      printf("%s,%s,", currentSection, key);
+      if (!value) {
+        write("N/A");
+      } else if (quoted && strpbrk(value, ",\"\r\n")) {
+        put('"');
+        escaped(value, '"');
+        put('"');
+      } else {
+        write(value);
+      }
+      write("\r\n");
+    } else {
+      printf("%s: %s\r\n", key, value ? value : "N/A");
+    }
+    firstField = false;
+  }
+
+  // JSON : \" \\ et contrôles ; CSV : guillemets doublés
+  void escaped(const char* value, char escape) {
+    for (const char* p = value; *p; p++) {
+      if (*p == '"' || (escape == '\\' && *p == '\\')) {
+        put(escape);
+        put(*p);
+      } else if ((uint8_t)*p < 0x20) {
+        if (escape == '\\') printf("\\u%04x", (unsigned)*p);
+      } else {
+        put(*p);
+      }
+    }
+  }
+
+  void printf(const char* pattern, ...) __attribute__((format(printf, 2, 3))) {
+    char line[160];
+    va_list args;
+    va_start(args, pattern);
+    int length = vsnprintf(line, sizeof(line), pattern, args);
+    va_end(args);
+    if (length > 0) {
+      append(line, (size_t)length < sizeof(line) ? (size_t)length : sizeof(line) - 1);
+    }
+  }
+
+  void write(const char* text) {
+    append(text, strlen(text));
+  }
+
+  void put(char c) {
+    append(&c, 1);
+  }
+
+  void append(const char* data, size_t length) {
+    while (length > 0) {
+      size_t chunk = sizeof(buffer) - used;
+      if (chunk > length) chunk = length;
+      memcpy(buffer + used, data, chunk);
+      used += chunk;
+      data += chunk;
+      length -= chunk;
+      if (used == sizeof(buffer)) flush();
+    }
+  }
+
+  void flush() {
+    if (used == 0) return;
+    if (file.write(reinterpret_cast<const uint8_t*>(buffer), used) != used) {
+      failed = true;
+    }
+    total += used;
+    used = 0;
+  }
+
+  File& file;
+  uint8_t format;
+  const char* currentSection = "";
+  bool sectionOpen = false;
+  bool firstField = true;
+  bool failed = false;
+  char buffer[AUTO_EXPORT_WRITE_BUFFER];
+  size_t used = 0;
+  size_t total = 0;
+};
+
+static void serializeSnapshot(SnapshotWriter& out, const DiagnosticSnapshot& s) {
+  out.begin(s);
+
+  out.section("chip");
+  out.text("model", s.chipModel);
+  out.text("revision", s.chipRevision);
+  out.number("cores", s.cpuCores);
+  out.number("freq_mhz", s.cpuFreqMHz);
+  out.number("flash_bytes", s.flashSize);
+  out.text("mac", s.macAddress);
+  out.text("sdk", s.sdkVersion);
+  out.text("idf", s.idfVersion);
+  out.decimal("temperature", s.temperature, 1, s.temperature != -999);
+
+  out.section("memory");
+  out.number("heap_size", s.heapSize);
+  out.number("heap_free", s.freeHeap);
+  out.number("heap_min_free", s.minFreeHeap);
+  out.number("heap_max_alloc", s.maxAllocHeap);
+  out.number("psram_size", s.psramSize);
+  out.number("psram_free", s.psramFree);
+  out.number("psram_largest_block", s.psramLargestBlock);
+
+  out.section("wifi");
+  out.text("ssid", s.wifiSSID);
+  out.signedNumber("rssi", s.wifiRSSI);
+  out.text("ip", s.ipAddress);
+  out.boolean("mdns_ready", s.mdnsAvailable);
+
+  out.section("peripherals");
+  out.number("gpio_total", s.gpioCount);
+  out.number("i2c_count", s.i2cCount);
+  out.text("i2c_devices", s.i2cDevices);
+
+  out.section("hardware_tests");
+  for (uint8_t i = 0; i < SNAPSHOT_TEST_COUNT; i++) {
+    out.text(snapshotTestNames[i], s.testResults[i]);
+  }
+
+  out.section("performance");
+  out.decimal("cpu_us", s.cpuBenchmarkUs, 0, s.cpuBenchmarkUs > 0);
+  out.decimal("memory_us", s.memBenchmarkUs, 0, s.memBenchmarkUs > 0);
+
+  out.section("environment");
+  out.boolean("aht20_available", s.aht20Available);
+  out.decimal("temperature_aht20", s.temperatureAht20, 1, s.temperatureAht20 != -999.0f);
+  out.decimal("humidity", s.humidity, 1, s.humidity != -999.0f);
+  out.boolean("bmp280_available", s.bmp280Available);
+  out.decimal("temperature_bmp280", s.temperatureBmp280, 1, s.temperatureBmp280 != -999.0f);
+  out.decimal("pressure", s.pressure, 1, s.pressure != -999.0f);
+  out.decimal("altitude", s.altitude, 1, s.altitude != -999.0f);
+
+  out.section("gps");
+  out.boolean("available", s.gpsAvailable);
+  out.boolean("has_fix", s.gpsFix);
+  out.number("satellites", s.satellites);
+  out.decimal("latitude", s.latitude, 6, s.gpsFix);
+  out.decimal("longitude", s.longitude, 6, s.gpsFix);
+  out.decimal("altitude", s.gpsAltitude, 1, s.gpsFix);
+  out.decimal("speed", s.speed, 2, s.gpsFix);
+  out.decimal("hdop", s.hdop, 2, s.gpsFix);
+  char dateTime[24];
+  snprintf(dateTime, sizeof(dateTime), "%04u-%02u-%02uT%02u:%02u:%02uZ",
+           s.year, s.month, s.day, s.hour, s.minute, s.second);
+  out.text("date_time", s.gpsDateTime ? dateTime : "N/A");
+
+  out.section("system");
+  out.number("uptime_ms", s.capturedMs);
+  out.text("reset_reason", s.resetReason);
+}
+
+static bool parseSnapshotIndex(const char* name, uint32_t& index) {
+  // Nom de base seulement : File::name() renvoie le chemin complet sur certains cœurs
+  const char* base = strrchr(name, '/');
+  base = base ? base + 1 : name;
+  if (strncmp(base, "snap", 4) != 0) return false;
+  char* end = nullptr;
+  unsigned long value = strtoul(base + 4, &end, 10);
+  if (end == base + 4 || *end != '.') return false;
+  index = value;
+  return true;
+}
+
+static void scanExportDir(fs::FS& fs) {
+  if (!fs.exists(AUTO_EXPORT_DIR)) {
+    fs.mkdir(AUTO_EXPORT_DIR);
+  }
+  uint32_t oldest = UINT32_MAX;
+  uint32_t newest = 0;
+  autoExportStatus.files = 0;
+  autoExportStatus.keptBytes = 0;
+
+  File dir = fs.open(AUTO_EXPORT_DIR);
+  if (dir && dir.isDirectory()) {
+    for (File entry = dir.openNextFile(); entry; entry = dir.openNextFile()) {
+      uint32_t index;
+      if (!entry.isDirectory() && parseSnapshotIndex(entry.name(), index)) {
+        autoExportStatus.files++;
+        autoExportStatus.keptBytes += entry.size();
+        if (index < oldest) oldest = index;
+        if (index > newest) newest = index;
+      }
+      entry.close();
+    }
+    dir.close();
+  }
+  nextIndex = newest + 1;
+  oldestIndex = autoExportStatus.files > 0 ? oldest : nextIndex;
+  scannedFs = &fs;
+}
+
+static void snapshotPath(char* path, size_t size, uint32_t index, uint8_t format) {
+  snprintf(path, size, "%s/snap%05lu.%s", AUTO_EXPORT_DIR, (unsigned long)index, exportExtensions[format]);
+}
+
+// Supprime les plus anciens fichiers (toutes extensions) au-delà du nombre ou du volume retenu
+static void applyRetention(fs::FS& fs) {
+  while (autoExportStatus.files > 1 && oldestIndex < nextIndex &&
+         (autoExportStatus.files > AUTO_EXPORT_RETENTION_FILES ||
+          autoExportStatus.keptBytes > (uint32_t)AUTO_EXPORT_RETENTION_KB * 1024)) {
+    for (uint8_t format = 0; format <= AUTO_EXPORT_FORMAT_CSV; format++) {
+      char path[40];
+      snapshotPath(path, sizeof(path), oldestIndex, format);
+      if (!fs.exists(path)) continue;
+      File old = fs.open(path, FILE_READ);
+      uint32_t size = old ? old.size() : 0;
+      old.close();
+      if (fs.remove(path)) {
+        autoExportStatus.files--;
+        autoExportStatus.keptBytes = autoExportStatus.keptBytes > size ? autoExportStatus.keptBytes - size : 0;
+        autoExportStatus.deleted++;
+      }
+    }
+    oldestIndex++;
+  }
+}
+
+static fs::FS* exportStorage(bool sdReady) {
+#if AUTO_EXPORT_STORAGE != AUTO_EXPORT_STORAGE_LITTLEFS
+  if (sdReady) {
+    strncpy(autoExportStatus.storage, "sd", sizeof(autoExportStatus.storage) - 1);
+    return &SD;
+  }
+#endif
+#if AUTO_EXPORT_STORAGE != AUTO_EXPORT_STORAGE_SD
+  if (!littleFsMounted) {
+    // Partition "spiffs" de la table de partitions, formatée au premier montage
+    littleFsMounted = LittleFS.begin(true, "/littlefs", 5, "spiffs");
+  }
+  if (littleFsMounted) {
+    strncpy(autoExportStatus.storage, "littlefs", sizeof(autoExportStatus.storage) - 1);
+    return &LittleFS;
+  }
+#endif
+  (void)sdReady;
+  autoExportStatus.storage[0] = '\0';
+  return nullptr;
+}
+
+static void exportSnapshot(const DiagnosticSnapshot& snapshot) {
+  fs::FS* fs = exportStorage(exportToSD);
+  if (!fs) {
+    autoExportStatus.exportErrors++;
+    return;
+  }
+  if (scannedFs != fs) {
+    scanExportDir(*fs);
+  }
+
+  char path[40];
+  snapshotPath(path, sizeof(path), nextIndex, autoExportStatus.format);
+  uint32_t startMs = millis();
+  File file = fs->open(path, FILE_WRITE);
+  if (!file) {
+    autoExportStatus.exportErrors++;
+    scannedFs = nullptr;       // Carte retirée ou répertoire perdu : nouveau scan au prochain export
+    return;
+  }
+  SnapshotWriter writer(file, autoExportStatus.format);
+  serializeSnapshot(writer, snapshot);
+  bool ok = writer.finish();
+  file.close();
+  autoExportStatus.lastExportMs = millis() - startMs;
+
+  nextIndex++;
+  autoExportStatus.files++;
+  autoExportStatus.keptBytes += writer.bytesWritten();
+  autoExportStatus.lastBytes = writer.bytesWritten();
+  strncpy(autoExportStatus.lastFile, path, sizeof(autoExportStatus.lastFile) - 1);
+  if (ok) {
+    autoExportStatus.exports++;
+  } else {
+    autoExportStatus.exportErrors++;
+  }
+  applyRetention(*fs);
+}
+
+static void exportTask(void* parameters) {
+  (void)parameters;
+  while (true) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    const DiagnosticSnapshot* snapshot = snapshotAcquire();
+    if (snapshot) {
+      exportSnapshot(*snapshot);
+      snapshotRelease(snapshot);
+    }
+    autoExportStatus.busy = false;
+  }
+}
+
+bool startAutoExport() {
+  if (exportTaskHandle) return true;
+
+#if AUTO_EXPORT_FORMAT == AUTO_EXPORT_FORMAT_TXT && ENABLE_TXT_EXPORT
+  autoExportStatus.format = AUTO_EXPORT_FORMAT_TXT;
+#elif AUTO_EXPORT_FORMAT == AUTO_EXPORT_FORMAT_CSV && ENABLE_CSV_EXPORT
+  autoExportStatus.format = AUTO_EXPORT_FORMAT_CSV;
+#else
+  autoExportStatus.format = AUTO_EXPORT_FORMAT_JSON;
+#endif
+  // Coeur 0, priorité basse : les écritures flash/SD ne retardent ni loop() ni le serveur web
+  if (xTaskCreatePinnedToCore(exportTask, "AutoExport", AUTO_EXPORT_TASK_STACK, nullptr,
+                              1, &exportTaskHandle, 0) != pdPASS) {
+    exportTaskHandle = nullptr;
+    return false;
+  }
+  autoExportStatus.enabled = true;
+  return true;
+}
+
+bool requestAutoExport(bool sdReady) {
+  if (!exportTaskHandle || autoExportStatus.busy) return false;
+  exportToSD = sdReady;
+  autoExportStatus.busy = true;
+  xTaskNotifyGive(exportTaskHandle);
+  return true;
+}
@@ -0,0 +1,142 @@
+/*
+ * BOOT_PROFILER.CPP - Dependency-aware deferred boot and boot-time profiler
+ */
+
+#include "boot_profiler.h"
+#include "cycle_counter.h"
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+// Global boot profile
+BootProfile bootProfile;
+
+static portMUX_TYPE bootProfileMux = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t stageStartCycles[BOOT_PROFILE_MAX_STAGES];
+
+static const BootGraphStage* graphStages = nullptr;
+static uint8_t graphCount = 0;
+static volatile uint32_t graphDone = 0;
+static uint32_t graphStarted = 0;   // loop() only
+
+uint8_t bootStageBegin(const char* name, bool background) {
+  portENTER_CRITICAL(&bootProfileMux);
+  if (bootProfile.count >= BOOT_PROFILE_MAX_STAGES) {
+    portEXIT_CRITICAL(&bootProfileMux);
+    return BOOT_PROFILE_MAX_STAGES;
+  }
+  uint8_t record = bootProfile.count++;
+  portEXIT_CRITICAL(&bootProfileMux);
+
+  if (bootProfile.cpuMhz == 0) {
+    bootProfile.cpuMhz = getCpuFrequencyMhz();
+  }
+  BootStageRecord& stage = bootProfile.stages[record];
+  stage.name = name;
+  stage.background = background;
+  stage.core = (uint8_t)xPortGetCoreID();
+  stage.startUs = (uint64_t)esp_timer_get_time();
+  stageStartCycles[record] = diagCycleCount();
+  return record;
+}
+
+void bootStageEnd(uint8_t record) {
+  if (record >= BOOT_PROFILE_MAX_STAGES) return;
+
+  uint32_t cycles = diagCycleCount() - stageStartCycles[record];
+  BootStageRecord& stage = bootProfile.stages[record];
+  stage.durationUs = (uint32_t)((uint64_t)esp_timer_get_time() - stage.startUs);
+  // Compteur 32 bits : valide sur un seul tour (~17,9 s à 240 MHz)
+  uint64_t wrapUs = 4294967296ULL / (bootProfile.cpuMhz > 0 ? bootProfile.cpuMhz : 240);
+  stage.cycles = stage.durationUs < wrapUs ? cycles : 0;
+  stage.done = true;
+}
+
+void bootMarkServerReady() {
+  bootProfile.serverReadyUs = (uint64_t)esp_timer_get_time();
+}
+
+void bootMarkFirstResponse() {
+  if (bootProfile.firstResponseUs == 0) {
+    bootProfile.firstResponseUs = (uint64_t)esp_timer_get_time();
+  }
+}
+
+static void markGraphStageDone(uint8_t index) {
+  portENTER_CRITICAL(&bootProfileMux);
+  graphDone |= BOOT_DEP(index);
+  portEXIT_CRITICAL(&bootProfileMux);
+}
+
+static void runGraphStage(uint8_t index) {
+  uint8_t record = bootStageBegin(graphStages[index].name, graphStages[index].background);
+  graphStages[index].run();
+  bootStageEnd(record);
+  markGraphStageDone(index);
+}
+
+static void backgroundStageTask(void* parameters) {
+  runGraphStage((uint8_t)(uintptr_t)parameters);
+  vTaskDelete(nullptr);
+}
+
+void bootGraphStart(const BootGraphStage* stages, uint8_t count) {
+  graphStages = stages;
+  graphCount = count > 32 ? 32 : count;
+  graphDone = 0;
+  graphStarted = 0;
+}
+
+bool bootGraphStep() {
+  if (!graphStages) return false;
+
+  const uint32_t all = graphCount >= 32 ? 0xFFFFFFFFUL : (BOOT_DEP(graphCount) - 1);
+  const uint32_t done = graphDone;
+  if (done == all) {
+    if (bootProfile.bootCompleteUs == 0) {
+      bootProfile.bootCompleteUs = (uint64_t)esp_timer_get_time();
+      Serial.printf("[Boot] Initialisation terminee en %lu ms\r\n",
+                    (unsigned long)(bootProfile.bootCompleteUs / 1000));
+    }
+    return false;
+  }
+
+  // Étapes bloquantes : une tâche chacune sur le coeur 0 (pile Wi-Fi)
+  for (uint8_t i = 0; i < graphCount; i++) {
+    const BootGraphStage& stage = graphStages[i];
+    if (!stage.background || (graphStarted & BOOT_DEP(i))) continue;
+    if ((stage.dependsOn & done) != stage.dependsOn) continue;
+
+    graphStarted |= BOOT_DEP(i);
+#if CONFIG_FREERTOS_UNICORE
+    const BaseType_t core = tskNO_AFFINITY;
+#else
+    const BaseType_t core = 0;
+#endif
+    if (xTaskCreatePinnedToCore(backgroundStageTask, stage.name, 4096,
+                                (void*)(uintptr_t)i, 1, nullptr, core) != pdPASS) {
+      runGraphStage(i);
+    }
+  }
+
+  // Au plus une étape de premier plan par passage dans loop()
+  for (uint8_t i = 0; i < graphCount; i++) {
+    const BootGraphStage& stage = graphStages[i];
+    if (stage.background || (graphStarted & BOOT_DEP(i))) continue;
+    if ((stage.dependsOn & done) != stage.dependsOn) continue;
+
+    graphStarted |= BOOT_DEP(i);
+    runGraphStage(i);
+    break;
+  }
+  return true;
+}
+
+bool bootGraphStageDone(uint8_t index) {
+  if (!graphStages || index >= graphCount) return true;
+  return (graphDone & BOOT_DEP(index)) != 0;
+}
+
+bool bootGraphComplete() {
+  return bootProfile.bootCompleteUs != 0;
+}
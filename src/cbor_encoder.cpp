@@ -0,0 +1,457 @@
+/*
+ * CBOR_ENCODER.CPP - JSON text to CBOR transcoder
+ */
+
+#include "cbor_encoder.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace {
+
+struct CborWriter {
+  uint8_t* out;
+  size_t capacity;
+  size_t size;
+
+  void byte(uint8_t value) {
+    if (out && size < capacity) out[size] = value;
+    size++;
+  }
+
+  void head(uint8_t major, uint64_t value) {
+    major <<= 5;
+    if (value < 24) {
+      byte(major | (uint8_t)value);
+    } else if (value <= 0xFF) {
+      byte(major | 24);
+      byte((uint8_t)value);
+    } else if (value <= 0xFFFF) {
+      byte(major | 25);
+      bigEndian(value, 2);
+    } else if (value <= 0xFFFFFFFFULL) {
+      byte(major | 26);
+      bigEndian(value, 4);
+    } else {
+      byte(major | 27);
+      bigEndian(value, 8);
+    }
+  }
+
+  void bigEndian(uint64_t value, uint8_t bytes) {
+    while (bytes--) byte((uint8_t)(value >> (bytes * 8)));
+  }
+};
+
+struct JsonCursor {
+  const char* p;
+  const char* end;
+
+  void skipSpace() {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) p++;
+  }
+  bool literal(const char* word) {
+    size_t n = strlen(word);
+    if ((size_t)(end - p) < n || memcmp(p, word, n) != 0) return false;
+    p += n;
+    return true;
+  }
+};
+
+int hexValue(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+bool readHex4(const char*& p, const char* end, uint32_t& value) {
+  if (end - p < 4) return false;
+  value = 0;
+  for (int i = 0; i < 4; i++) {
+    int digit = hexValue(*p++);
+    if (digit < 0) return false;
+    value = (value << 4) | (uint32_t)digit;
+  }
+  return true;
+}
+
+void putUtf8(CborWriter* w, uint32_t cp, size_t& length) {
+  uint8_t bytes[4];
+  uint8_t n;
+  if (cp < 0x80) {
+    bytes[0] = (uint8_t)cp;
+    n = 1;
+  } else if (cp < 0x800) {
+    bytes[0] = 0xC0 | (cp >> 6);
+    bytes[1] = 0x80 | (cp & 0x3F);
+    n = 2;
+  } else if (cp < 0x10000) {
+    bytes[0] = 0xE0 | (cp >> 12);
+    bytes[1] = 0x80 | ((cp >> 6) & 0x3F);
+    bytes[2] = 0x80 | (cp & 0x3F);
+    n = 3;
+  } else {
+    bytes[0] = 0xF0 | (cp >> 18);
+    bytes[1] = 0x80 | ((cp >> 12) & 0x3F);
+    bytes[2] = 0x80 | ((cp >> 6) & 0x3F);
+    bytes[3] = 0x80 | (cp & 0x3F);
+    n = 4;
+  }
+  if (w) {
+    for (uint8_t i = 0; i < n; i++) w->byte(bytes[i]);
+  }
+  length += n;
+}
+
+// Décode la chaîne après le guillemet ouvrant ; w == nullptr : mesure seulement
+bool decodeString(const char*& p, const char* end, CborWriter* w, size_t& length) {
+  length = 0;
+  while (p < end) {
+    char c = *p++;
+    if (c == '"') return true;
+    if ((uint8_t)c < 0x20) return false;
+    if (c != '\\') {
+      if (w) w->byte((uint8_t)c);
+      length++;
+      continue;
+    }
+    if (p >= end) return false;
+    c = *p++;
+    uint32_t cp;
+    switch (c) {
+      case '"': case '\\': case '/': cp = (uint8_t)c; break;
+      case 'b': cp = '\b'; break;
+      case 'f': cp = '\f'; break;
+      case 'n': cp = '\n'; break;
+      case 'r': cp = '\r'; break;
+      case 't': cp = '\t'; break;
+      case 'u':
+        if (!readHex4(p, end, cp)) return false;
+        if (cp >= 0xD800 && cp <= 0xDBFF) {
+          uint32_t low;
+          if (end - p >= 6 && p[0] == '\\' && p[1] == 'u') {
+            const char* q = p + 2;
+            if (readHex4(q, end, low) && low >= 0xDC00 && low <= 0xDFFF) {
+              cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+              p = q;
+            } else {
+              cp = 0xFFFD;
+            }
+          } else {
+            cp = 0xFFFD;
+          }
+        } else if (cp >= 0xDC00 && cp <= 0xDFFF) {
+          cp = 0xFFFD;
+        }
+        break;
+      default:
+        return false;
+    }
+    putUtf8(w, cp, length);
+  }
+  return false;
+}
+
+bool encodeString(JsonCursor& in, CborWriter& w) {
+  const char* start = in.p;
+  size_t length;
+  if (!decodeString(in.p, in.end, nullptr, length)) return false;
+  w.head(3, length);
+  in.p = start;
+  return decodeString(in.p, in.end, &w, length);
+}
+
+// Demi-précision seulement si la valeur est exactement représentable (normale)
+bool toHalf(double value, uint16_t& half) {
+  float f = (float)value;
+  if ((double)f != value) return false;
+  uint32_t bits;
+  memcpy(&bits, &f, sizeof(bits));
+  uint16_t sign = (bits >> 16) & 0x8000;
+  if ((bits & 0x7FFFFFFF) == 0) {
+    half = sign;
+    return true;
+  }
+  int exponent = (int)((bits >> 23) & 0xFF) - 127;
+  uint32_t mantissa = bits & 0x7FFFFF;
+  if (exponent < -14 || exponent > 15 || (mantissa & 0x1FFF) != 0) return false;
+  half = sign | (uint16_t)((exponent + 15) << 10) | (uint16_t)(mantissa >> 13);
+  return true;
+}
+
+bool encodeNumber(JsonCursor& in, CborWriter& w) {
+  const char* start = in.p;
+  const char* p = in.p;
+  bool negative = false;
+  if (p < in.end && *p == '-') {
+    negative = true;
+    p++;
+  }
+  const char* digits = p;
+  while (p < in.end && *p >= '0' && *p <= '9') p++;
+  if (p == digits || (*digits == '0' && p - digits > 1)) return false;
+  bool integer = true;
+  if (p < in.end && *p == '.') {
+    integer = false;
+    const char* fraction = ++p;
+    while (p < in.end && *p >= '0' && *p <= '9') p++;
+    if (p == fraction) return false;
+  }
+  const char* mantissaEnd = p;
+  if (p < in.end && (*p == 'e' || *p == 'E')) {
+    integer = false;
+    p++;
+    if (p < in.end && (*p == '+' || *p == '-')) p++;
+    const char* exponent = p;
+    while (p < in.end && *p >= '0' && *p <= '9') p++;
+    if (p == exponent) return false;
+  }
+  in.p = p;
+
+  uint64_t value = 0;
+  for (const char* d = digits; integer && d < mantissaEnd; d++) {
+    uint64_t digit = (uint64_t)(*d - '0');
+    if (value > (UINT64_MAX - digit) / 10) {
+      integer = false;  // Hors uint64 : double
+    } else {
+      value = value * 10 + digit;
+    }
+  }
+  if (integer) {
+    if (!negative) {
+      w.head(0, value);
+      return true;
+    }
+    if (value == 0) {
+      w.head(0, 0);
+      return true;
+    }
+    w.head(1, value - 1);
+    return true;
+  }
+
+  char text[40];
+  size_t n = (size_t)(p - start);
+  if (n >= sizeof(text)) n = sizeof(text) - 1;
+  memcpy(text, start, n);
+  text[n] = '\0';
+  double number = strtod(text, nullptr);
+
+  uint16_t half;
+  if (toHalf(number, half)) {
+    w.byte(0xF9);
+    w.bigEndian(half, 2);
+    return true;
+  }
+  // Chiffres significatifs imprimés : <= 6 tient dans un float sans perte à l'affichage
+  uint8_t significant = 0;
+  bool leading = true;
+  for (const char* d = digits; d < mantissaEnd; d++) {
+    if (*d == '.') continue;
+    if (leading && *d == '0') continue;
+    leading = false;
+    significant++;
+  }
+  float single = (float)number;
+  if (isnormal(single) && (significant <= 6 || (double)single == number)) {
+    uint32_t bits;
+    memcpy(&bits, &single, sizeof(bits));
+    w.byte(0xFA);
+    w.bigEndian(bits, 4);
+    return true;
+  }
+  uint64_t bits;
+  memcpy(&bits, &number, sizeof(bits));
+  w.byte(0xFB);
+  w.bigEndian(bits, 8);
+  return true;
+}
+
+bool encodeValue(JsonCursor& in, CborWriter& w, uint8_t depth) {
+  in.skipSpace();
+  if (in.p >= in.end) return false;
+  char c = *in.p;
+  if (c == '{' || c == '[') {
+    if (depth >= CBOR_MAX_DEPTH) return false;
+    bool object = (c == '{');
+    char close = object ? '}' : ']';
+    in.p++;
+    w.byte(object ? 0xBF : 0x9F);
+    in.skipSpace();
+    if (in.p < in.end && *in.p == close) {
+      in.p++;
+      w.byte(0xFF);
+      return true;
+    }
+    while (true) {
+      if (object) {
+        in.skipSpace();
+        if (in.p >= in.end || *in.p != '"') return false;
+        in.p++;
+        if (!encodeString(in, w)) return false;
+        in.skipSpace();
+        if (in.p >= in.end || *in.p != ':') return false;
+        in.p++;
+      }
+      if (!encodeValue(in, w, depth + 1)) return false;
+      in.skipSpace();
+      if (in.p >= in.end) return false;
+      if (*in.p == ',') {
+        in.p++;
+        continue;
+      }
+      if (*in.p != close) return false;
+      in.p++;
+      w.byte(0xFF);
+      return true;
+    }
+  }
+  if (c == '"') {
+    in.p++;
+    return encodeString(in, w);
+  }
+  if (c == '-' || (c >= '0' && c <= '9')) return encodeNumber(in, w);
+  if (in.literal("true")) {
+    w.byte(0xF5);
+    return true;
+  }
+  if (in.literal("false")) {
+    w.byte(0xF4);
+    return true;
+  }
+  if (in.literal("null")) {
+    w.byte(0xF6);
+    return true;
+  }
+  return false;
+}
+
+enum CborExpect : uint8_t {
+  EXPECT_VALUE,
+  EXPECT_VALUE_OR_CLOSE,            // Just after '['
+  EXPECT_KEY,
+  EXPECT_KEY_OR_CLOSE,              // Just after '{'
+  EXPECT_COLON,
+  EXPECT_NEXT,                      // ',' or the closing bracket
+  EXPECT_DONE
+};
+
+void afterValue(CborStream& stream) {
+  stream.expect = stream.depth ? EXPECT_NEXT : EXPECT_DONE;
+}
+
+bool closeContainer(JsonCursor& in, CborWriter& w, CborStream& stream) {
+  bool map = (stream.maps >> (stream.depth - 1)) & 1;
+  if (*in.p != (map ? '}' : ']')) return false;
+  in.p++;
+  w.byte(0xFF);
+  stream.depth--;
+  afterValue(stream);
+  return true;
+}
+
+// Un seul jeton par appel : la pile des conteneurs ouverts vit dans stream
+bool encodeToken(JsonCursor& in, CborWriter& w, CborStream& stream) {
+  char c = *in.p;
+  switch (stream.expect) {
+    case EXPECT_VALUE_OR_CLOSE:
+      if (c == ']') return closeContainer(in, w, stream);
+      // fall through
+    case EXPECT_VALUE:
+      if (c == '{' || c == '[') {
+        if (stream.depth >= CBOR_MAX_DEPTH) return false;
+        bool map = (c == '{');
+        in.p++;
+        w.byte(map ? 0xBF : 0x9F);
+        if (map) {
+          stream.maps |= 1UL << stream.depth;
+        } else {
+          stream.maps &= ~(1UL << stream.depth);
+        }
+        stream.depth++;
+        stream.expect = map ? EXPECT_KEY_OR_CLOSE : EXPECT_VALUE_OR_CLOSE;
+        return true;
+      }
+      if (c == '"') {
+        in.p++;
+        if (!encodeString(in, w)) return false;
+      } else if (c == '-' || (c >= '0' && c <= '9')) {
+        if (!encodeNumber(in, w)) return false;
+      } else if (in.literal("true")) {
+        w.byte(0xF5);
+      } else if (in.literal("false")) {
+        w.byte(0xF4);
+      } else if (in.literal("null")) {
+        w.byte(0xF6);
+      } else {
+        return false;
+      }
+      afterValue(stream);
+      return true;
+    case EXPECT_KEY_OR_CLOSE:
+      if (c == '}') return closeContainer(in, w, stream);
+      // fall through
+    case EXPECT_KEY:
+      if (c != '"') return false;
+      in.p++;
+      if (!encodeString(in, w)) return false;
+      stream.expect = EXPECT_COLON;
+      return true;
+    case EXPECT_COLON:
+      if (c != ':') return false;
+      in.p++;
+      stream.expect = EXPECT_VALUE;
+      return true;
+    case EXPECT_NEXT:
+      if (c == ',') {
+        in.p++;
+        stream.expect = ((stream.maps >> (stream.depth - 1)) & 1) ? EXPECT_KEY : EXPECT_VALUE;
+        return true;
+      }
+      return closeContainer(in, w, stream);
+    default:
+      return false;
+  }
+}
+
+} // namespace
+
+size_t jsonToCbor(const char* json, size_t length, uint8_t* out, size_t capacity) {
+  JsonCursor in = { json, json + length };
+  CborWriter w = { out, capacity, 0 };
+  if (!encodeValue(in, w, 0)) return 0;
+  in.skipSpace();
+  if (in.p != in.end) return 0;
+  if (out && w.size > capacity) return 0;
+  return w.size;
+}
+
+void cborStreamBegin(CborStream& stream) {
+  stream.maps = 0;
+  stream.depth = 0;
+  stream.expect = EXPECT_VALUE;
+  stream.failed = false;
+}
+
+size_t jsonFragmentToCbor(CborStream& stream, const char* json, size_t length, uint8_t* out, size_t capacity) {
+  if (stream.failed) return 0;
+  CborStream next = stream;
+  JsonCursor in = { json, json + length };
+  CborWriter w = { out, capacity, 0 };
+  while (true) {
+    in.skipSpace();
+    if (in.p >= in.end) break;
+    if (!encodeToken(in, w, next)) {
+      if (out) stream.failed = true;
+      return 0;
+    }
+  }
+  if (out && w.size > capacity) return 0;
+  if (out) stream = next;
+  return w.size;
+}
+
+bool cborStreamComplete(const CborStream& stream) {
+  return !stream.failed && stream.expect == EXPECT_DONE;
+}
@@ -0,0 +1,249 @@
+/*
+ * DHT_SENSOR.CPP - Background DHT11/DHT22 reader
+ */
+
+#include "dht_sensor.h"
+#include "config.h"
+
+#if DHT_MEDIAN_WINDOW < 1 || DHT_MEDIAN_WINDOW > 15
+#error "DHT_MEDIAN_WINDOW must be between 1 and 15"
+#endif
+
+#define DHT11_START_MS 20                // DHT11 : >= 18 ms
+#define DHT22_START_US 1100              // DHT22 : 1 à 10 ms
+#define DHT_CAPTURE_MS 8                 // Trame complète : ~5 ms
+
+// Global DHT reader status (loop task only)
+DHTSensorStatus dhtSensorStatus;
+
+enum DHTPhase : uint8_t {
+  DHT_PHASE_IDLE = 0,
+  DHT_PHASE_START,                       // Ligne tenue à LOW par l'ESP32
+  DHT_PHASE_CAPTURE                      // Interruption armée, le capteur répond
+};
+
+static volatile uint32_t edgeTimes[DHT_MAX_EDGES];
+static volatile uint8_t edgeCount = 0;
+static DHTPhase phase = DHT_PHASE_IDLE;
+static uint32_t phaseStartMs = 0;
+static uint32_t lastStartMs = 0;
+static bool readRequested = false;
+
+static int16_t temperatureWindow[DHT_MEDIAN_WINDOW];
+static int16_t humidityWindow[DHT_MEDIAN_WINDOW];
+static uint8_t windowNext = 0;
+
+static void IRAM_ATTR dhtEdgeISR() {
+  uint8_t n = edgeCount;
+  if (n < DHT_MAX_EDGES) {
+    edgeTimes[n] = micros();
+    edgeCount = n + 1;
+  }
+}
+
+const char* dhtReadResultName(DHTReadResult result) {
+  switch (result) {
+    case DHT_READ_OK: return "ok";
+    case DHT_READ_TIMEOUT: return "timeout";
+    case DHT_READ_FRAME_ERROR: return "frame_error";
+    case DHT_READ_CHECKSUM_ERROR: return "checksum_error";
+    default: return "none";
+  }
+}
+
+// La trame se lit depuis la fin : le dernier front est la remontée qui suit
+// le bit 39, chaque bit est une impulsion haute (montant -> descendant).
+// Les fronts de réponse du capteur manqués au début ne gênent donc pas
+DHTReadResult decodeDHTFrame(const uint32_t* edgesUs, uint8_t count, uint8_t data[5]) {
+  memset(data, 0, 5);
+  if (count < DHT_FRAME_MIN_EDGES) {
+    return DHT_READ_TIMEOUT;
+  }
+  const uint32_t* frame = edgesUs + (count - DHT_FRAME_MIN_EDGES);
+  for (uint8_t bit = 0; bit < 40; bit++) {
+    uint32_t rise = frame[bit * 2];
+    uint32_t fall = frame[bit * 2 + 1];
+    uint32_t high = fall - rise;
+    uint32_t low = frame[bit * 2 + 2] - fall;
+    if (high > DHT_PULSE_MAX_US || low > DHT_PULSE_MAX_US) {
+      return DHT_READ_FRAME_ERROR;
+    }
+    data[bit / 8] = (uint8_t)((data[bit / 8] << 1) | (high > DHT_BIT_THRESHOLD_US ? 1 : 0));
+  }
+  if (data[4] != (uint8_t)(data[0] + data[1] + data[2] + data[3])) {
+    return DHT_READ_CHECKSUM_ERROR;
+  }
+  return DHT_READ_OK;
+}
+
+void convertDHTFrame(const uint8_t data[5], uint8_t type, int16_t& temperatureDeci, int16_t& humidityDeci) {
+  if (type == 22) {
+    humidityDeci = (int16_t)(((uint16_t)data[0] << 8) | data[1]);
+    int16_t magnitude = (int16_t)(((uint16_t)(data[2] & 0x7F) << 8) | data[3]);
+    temperatureDeci = (data[2] & 0x80) ? -magnitude : magnitude;
+  } else {
+    humidityDeci = (int16_t)(data[0] * 10 + data[1]);
+    temperatureDeci = (int16_t)(data[2] * 10 + data[3]);
+  }
+}
+
+// Médiane par tri par insertion : au plus DHT_MEDIAN_WINDOW valeurs
+int16_t medianDHTValue(const int16_t* values, uint8_t count) {
+  if (count == 0) {
+    return 0;
+  }
+  int16_t sorted[DHT_MEDIAN_WINDOW];
+  if (count > DHT_MEDIAN_WINDOW) {
+    count = DHT_MEDIAN_WINDOW;
+  }
+  for (uint8_t i = 0; i < count; i++) {
+    int16_t value = values[i];
+    uint8_t j = i;
+    while (j > 0 && sorted[j - 1] > value) {
+      sorted[j] = sorted[j - 1];
+      j--;
+    }
+    sorted[j] = value;
+  }
+  if (count % 2) {
+    return sorted[count / 2];
+  }
+  return (int16_t)((sorted[count / 2 - 1] + sorted[count / 2]) / 2);
+}
+
+static void releaseAndCapture() {
+  edgeCount = 0;
+  pinMode(dhtSensorStatus.pin, INPUT_PULLUP);
+  attachInterrupt(digitalPinToInterrupt(dhtSensorStatus.pin), dhtEdgeISR, CHANGE);
+  phase = DHT_PHASE_CAPTURE;
+  phaseStartMs = millis();
+}
+
+static void finishRead() {
+  detachInterrupt(digitalPinToInterrupt(dhtSensorStatus.pin));
+  phase = DHT_PHASE_IDLE;
+
+  uint32_t edges[DHT_MAX_EDGES];
+  uint8_t count = edgeCount;
+  for (uint8_t i = 0; i < count; i++) {
+    edges[i] = edgeTimes[i];
+  }
+
+  DHTSensorStatus& status = dhtSensorStatus;
+  uint8_t data[5];
+  DHTReadResult result = decodeDHTFrame(edges, count, data);
+  status.reads++;
+  status.lastEdges = count;
+  if (result != status.lastResult && result != DHT_READ_OK) {
+    Serial.printf("[DHT] DHT%u pin %d: %s (%u fronts)\r\n", status.type, status.pin,
+                  dhtReadResultName(result), (unsigned)count);
+  }
+  status.lastResult = result;
+
+  switch (result) {
+    case DHT_READ_TIMEOUT: status.timeouts++; break;
+    case DHT_READ_FRAME_ERROR: status.frameErrors++; break;
+    case DHT_READ_CHECKSUM_ERROR: status.checksumErrors++; break;
+    default: break;
+  }
+  if (result != DHT_READ_OK) {
+    status.consecutiveFailures++;
+    return;
+  }
+
+  int16_t temperatureDeci = 0;
+  int16_t humidityDeci = 0;
+  convertDHTFrame(data, status.type, temperatureDeci, humidityDeci);
+  temperatureWindow[windowNext] = temperatureDeci;
+  humidityWindow[windowNext] = humidityDeci;
+  windowNext = (windowNext + 1) % DHT_MEDIAN_WINDOW;
+  if (status.samples < DHT_MEDIAN_WINDOW) {
+    status.samples++;
+  }
+
+  status.okReads++;
+  status.consecutiveFailures = 0;
+  status.lastReadMs = millis();
+  status.lastTemperature = temperatureDeci * 0.1f;
+  status.lastHumidity = humidityDeci * 0.1f;
+  status.temperature = medianDHTValue(temperatureWindow, status.samples) * 0.1f;
+  status.humidity = medianDHTValue(humidityWindow, status.samples) * 0.1f;
+  status.valid = true;
+}
+
+void beginDHTSensor(int pin, uint8_t type) {
+  stopDHTSensor();
+  dhtSensorStatus = DHTSensorStatus();
+  dhtSensorStatus.type = (type == 11) ? 11 : 22;
+  windowNext = 0;
+  if (pin < 0) {
+    return;
+  }
+  dhtSensorStatus.pin = pin;
+  dhtSensorStatus.running = true;
+  pinMode(pin, INPUT_PULLUP);
+  phase = DHT_PHASE_IDLE;
+  // Première lecture après un intervalle complet : le capteur a besoin d'~1 s après la mise sous tension
+  lastStartMs = millis();
+  readRequested = false;
+}
+
+void stopDHTSensor() {
+  if (!dhtSensorStatus.running) {
+    return;
+  }
+  if (phase == DHT_PHASE_CAPTURE) {
+    detachInterrupt(digitalPinToInterrupt(dhtSensorStatus.pin));
+  }
+  if (phase != DHT_PHASE_IDLE) {
+    pinMode(dhtSensorStatus.pin, INPUT_PULLUP);
+  }
+  phase = DHT_PHASE_IDLE;
+  dhtSensorStatus.running = false;
+}
+
+void requestDHTRead() {
+  readRequested = true;
+}
+
+void maintainDHTSensor() {
+  if (!dhtSensorStatus.running) {
+    return;
+  }
+  uint32_t now = millis();
+
+  switch (phase) {
+    case DHT_PHASE_IDLE: {
+      // Capteur absent ou débranché : on espace les tentatives
+      uint32_t interval = dhtSensorStatus.consecutiveFailures >= DHT_FAILURE_BACKOFF
+                              ? DHT_READ_INTERVAL_MS * 10
+                              : DHT_READ_INTERVAL_MS;
+      if (!readRequested && now - lastStartMs < interval) {
+        return;
+      }
+      readRequested = false;
+      lastStartMs = now;
+      pinMode(dhtSensorStatus.pin, OUTPUT);
+      digitalWrite(dhtSensorStatus.pin, LOW);
+      if (dhtSensorStatus.type == 22) {
+        // Impulsion de départ courte : tenue ici plutôt que sur une itération de loop()
+        delayMicroseconds(DHT22_START_US);
+        releaseAndCapture();
+      } else {
+        phase = DHT_PHASE_START;
+        phaseStartMs = now;
+      }
+      break;
+    }
+    case DHT_PHASE_START:
+      if (now - phaseStartMs >= DHT11_START_MS) {
+        releaseAndCapture();
+      }
+      break;
+    case DHT_PHASE_CAPTURE:
+      if (now - phaseStartMs >= DHT_CAPTURE_MS) {
+        finishRead();
+      }
+      break;
+  }
+}
@@ -0,0 +1,58 @@
+/*
+ * DIAGNOSTIC_INFO.CPP - Render-time text for the packed DiagnosticInfo fields
+ */
+
+#include "diagnostic_info.h"
+#include "languages.h"
+#include <stdio.h>
+
+AddressText formatMacAddress(const uint8_t (&mac)[6]) {
+  AddressText out;
+  snprintf(out.text, sizeof(out.text), "%02X:%02X:%02X:%02X:%02X:%02X",
+           mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
+  return out;
+}
+
+AddressText formatIPv4(uint32_t address) {
+  AddressText out;
+  if (address == 0) {
+    out.text[0] = '\0';
+    return out;
+  }
+  // Même ordre qu'IPAddress : premier octet dans l'octet de poids faible
+  snprintf(out.text, sizeof(out.text), "%u.%u.%u.%u",
+           (unsigned)(address & 0xFF), (unsigned)((address >> 8) & 0xFF),
+           (unsigned)((address >> 16) & 0xFF), (unsigned)(address >> 24));
+  return out;
+}
+
+I2CDevicesText formatI2CDevices(const DiagnosticInfo& info) {
+  I2CDevicesText out;
+  if (info.i2cCount == 0) {
+    snprintf(out.text, sizeof(out.text), "Aucun");
+    return out;
+  }
+  size_t used = 0;
+  uint8_t kept = info.i2cCount < DIAG_I2C_MAX_DEVICES ? info.i2cCount : DIAG_I2C_MAX_DEVICES;
+  for (uint8_t i = 0; i < kept; i++) {
+    used += snprintf(out.text + used, sizeof(out.text) - used, i ? ", 0x%02X" : "0x%02X", info.i2cAddresses[i]);
+  }
+  if (info.i2cCount > kept) {
+    snprintf(out.text + used, sizeof(out.text) - used, ", ...");
+  }
+  return out;
+}
+
+// Traduction au moment du rendu, dans la langue courante (flash adressable directement sur ESP32)
+const char* memoryStatusText(MemoryStatus status) {
+  switch (status) {
+    case MEMORY_STATUS_EXCELLENT:
+      return reinterpret_cast<const char*>(Texts::excellent.get());
+    case MEMORY_STATUS_GOOD:
+      return reinterpret_cast<const char*>(Texts::good.get());
+    case MEMORY_STATUS_AVERAGE:
+      return "Moyen"; // Pas traduit (statut technique)
+    default:
+      return reinterpret_cast<const char*>(Texts::critical.get());
+  }
+}
@@ -0,0 +1,233 @@
+/*
+ * DISTANCE_SENSOR.CPP - Background HC-SR04 ranging engine
+ */
+
+#include "distance_sensor.h"
+#include "config.h"
+#include "environmental_sensors.h"
+#include <math.h>
+
+#if DISTANCE_MEDIAN_WINDOW < 1 || DISTANCE_MEDIAN_WINDOW > 15
+#error "DISTANCE_MEDIAN_WINDOW must be between 1 and 15"
+#endif
+
+// Global ranging status (loop task only)
+DistanceSensorStatus distanceSensorStatus;
+
+static volatile uint32_t echoEdges[2];
+static volatile uint8_t echoEdgeCount = 0;
+static bool armed = false;
+static bool readingRequested = false;
+static uint32_t triggerMs = 0;
+static uint32_t lastEnvRefreshMs = 0;
+
+static float medianWindow[DISTANCE_MEDIAN_WINDOW];
+static uint8_t medianCount = 0;
+static uint8_t medianNext = 0;
+static DistanceKalman kalman;
+static DistanceSample sampleRing[DISTANCE_STREAM_SAMPLES];
+
+// Montant puis descendant : seuls les deux premiers fronts après le déclenchement comptent
+static void IRAM_ATTR distanceEchoISR() {
+  uint8_t n = echoEdgeCount;
+  if (n < 2) {
+    echoEdges[n] = micros();
+    echoEdgeCount = n + 1;
+  }
+}
+
+float speedOfSound(float temperatureC) {
+  return 331.3f * sqrtf(1.0f + temperatureC / 273.15f);
+}
+
+float echoToDistanceCm(uint32_t echoUs, float temperatureC) {
+  // Aller-retour : moitié du trajet, m/s -> cm/µs = x 1e-4
+  return (float)echoUs * speedOfSound(temperatureC) * 1e-4f / 2.0f;
+}
+
+float medianDistanceValue(const float* values, uint8_t count) {
+  if (count == 0) {
+    return 0.0f;
+  }
+  float sorted[DISTANCE_MEDIAN_WINDOW];
+  if (count > DISTANCE_MEDIAN_WINDOW) {
+    count = DISTANCE_MEDIAN_WINDOW;
+  }
+  for (uint8_t i = 0; i < count; i++) {
+    float value = values[i];
+    uint8_t j = i;
+    while (j > 0 && sorted[j - 1] > value) {
+      sorted[j] = sorted[j - 1];
+      j--;
+    }
+    sorted[j] = value;
+  }
+  if (count % 2) {
+    return sorted[count / 2];
+  }
+  return (sorted[count / 2 - 1] + sorted[count / 2]) / 2.0f;
+}
+
+// Cible fixe (modèle à position constante) : le bruit de processus Q laisse suivre un objet qui bouge
+float DistanceKalman::update(float measurement) {
+  if (!initialized || fabsf(measurement - estimate) > DISTANCE_KALMAN_RESET_CM) {
+    estimate = measurement;
+    variance = DISTANCE_KALMAN_R;
+    initialized = true;
+    return estimate;
+  }
+  variance += DISTANCE_KALMAN_Q;
+  float gain = variance / (variance + DISTANCE_KALMAN_R);
+  estimate += gain * (measurement - estimate);
+  variance *= (1.0f - gain);
+  return estimate;
+}
+
+static float currentTemperature(bool& fromSensor) {
+  float temperature = envData.temperature_avg;
+  fromSensor = temperature > -40.0f && temperature < 85.0f;
+  return fromSensor ? temperature : DISTANCE_DEFAULT_TEMPERATURE;
+}
+
+static void processEcho(uint32_t echoUs) {
+  DistanceSensorStatus& status = distanceSensorStatus;
+  status.lastEchoUs = echoUs;
+  if (echoUs < DISTANCE_MIN_ECHO_US || echoUs > DISTANCE_MAX_ECHO_US) {
+    status.outOfRange++;
+    return;
+  }
+
+  status.temperatureC = currentTemperature(status.temperatureFromSensor);
+  status.soundSpeed = speedOfSound(status.temperatureC);
+  float raw = echoToDistanceCm(echoUs, status.temperatureC);
+
+  medianWindow[medianNext] = raw;
+  medianNext = (medianNext + 1) % DISTANCE_MEDIAN_WINDOW;
+  if (medianCount < DISTANCE_MEDIAN_WINDOW) {
+    medianCount++;
+  }
+
+  status.rawCm = raw;
+  status.medianCm = medianDistanceValue(medianWindow, medianCount);
+  status.filteredCm = kalman.update(status.medianCm);
+  status.lastReadMs = triggerMs;
+  status.readings++;
+  status.valid = true;
+
+  DistanceSample& sample = sampleRing[status.sampleSeq % DISTANCE_STREAM_SAMPLES];
+  sample.timestampMs = triggerMs;
+  sample.rawCm = raw;
+  sample.filteredCm = status.filteredCm;
+  status.sampleSeq++;
+}
+
+uint8_t readDistanceSamples(uint32_t& cursor, DistanceSample* out, uint8_t maxCount, uint32_t& dropped) {
+  uint32_t newest = distanceSensorStatus.sampleSeq;
+  dropped = 0;
+  if (cursor > newest) {
+    cursor = newest;  // Moteur redémarré : séquence remise à zéro
+  }
+  if (newest - cursor > DISTANCE_STREAM_SAMPLES) {
+    dropped = newest - cursor - DISTANCE_STREAM_SAMPLES;
+    cursor = newest - DISTANCE_STREAM_SAMPLES;
+  }
+  uint8_t count = 0;
+  while (cursor < newest && count < maxCount) {
+    out[count++] = sampleRing[cursor % DISTANCE_STREAM_SAMPLES];
+    cursor++;
+  }
+  return count;
+}
+
+void beginDistanceSensor(int trigPin, int echoPin, uint16_t rateHz) {
+  stopDistanceSensor();
+  distanceSensorStatus = DistanceSensorStatus();
+  medianCount = 0;
+  medianNext = 0;
+  kalman.reset();
+  if (trigPin < 0 || echoPin < 0) {
+    return;
+  }
+  if (rateHz == 0) {
+    rateHz = 1;
+  } else if (rateHz > DISTANCE_MAX_RATE_HZ) {
+    rateHz = DISTANCE_MAX_RATE_HZ;
+  }
+
+  DistanceSensorStatus& status = distanceSensorStatus;
+  status.trigPin = trigPin;
+  status.echoPin = echoPin;
+  status.rateHz = rateHz;
+  status.temperatureC = currentTemperature(status.temperatureFromSensor);
+  status.soundSpeed = speedOfSound(status.temperatureC);
+
+  pinMode(trigPin, OUTPUT);
+  digitalWrite(trigPin, LOW);
+  pinMode(echoPin, INPUT);
+  echoEdgeCount = 2;  // Pas de capture avant le premier déclenchement
+  attachInterrupt(digitalPinToInterrupt(echoPin), distanceEchoISR, CHANGE);
+  armed = false;
+  readingRequested = true;
+  lastEnvRefreshMs = millis();
+  status.running = true;
+}
+
+void stopDistanceSensor() {
+  if (!distanceSensorStatus.running) {
+    return;
+  }
+  detachInterrupt(digitalPinToInterrupt(distanceSensorStatus.echoPin));
+  armed = false;
+  distanceSensorStatus.running = false;
+}
+
+void requestDistanceReading() {
+  readingRequested = true;
+}
+
+void maintainDistanceSensor() {
+  DistanceSensorStatus& status = distanceSensorStatus;
+  if (!status.running) {
+    return;
+  }
+  uint32_t now = millis();
+
+  if (armed) {
+    if (echoEdgeCount >= 2) {
+      processEcho(echoEdges[1] - echoEdges[0]);
+    } else if (now - triggerMs >= DISTANCE_ECHO_TIMEOUT_MS) {
+      status.timeouts++;
+    } else {
+      return;
+    }
+    armed = false;
+  }
+
+  // Température pour la vitesse du son : la boucle principale reste propriétaire du bus I2C
+  if (now - lastEnvRefreshMs >= DISTANCE_TEMP_REFRESH_MS) {
+    lastEnvRefreshMs = now;
+    updateEnvironmentalSensors();
+  }
+
+  uint32_t period = 1000UL / status.rateHz;
+  if (period < DISTANCE_MIN_PERIOD_MS) {
+    period = DISTANCE_MIN_PERIOD_MS;
+  }
+  if (!readingRequested && now - triggerMs < period) {
+    return;
+  }
+  if (digitalRead(status.echoPin) == HIGH) {
+    // Écho précédent (ou parasite) encore en cours : on attend la prochaine itération
+    status.busySkips++;
+    return;
+  }
+
+  readingRequested = false;
+  echoEdgeCount = 0;
+  digitalWrite(status.trigPin, HIGH);
+  delayMicroseconds(10);
+  digitalWrite(status.trigPin, LOW);
+  triggerMs = now;
+  armed = true;
+  status.triggers++;
+}
@@ -3,7 +3,9 @@
  */
 
 #include "environmental_sensors.h"
+#include "bmp280_compensation.h"
 #include "config.h"
+#include "cycle_counter.h"
 #include <cmath>
 
 // Global environmental variables
@@ -32,22 +34,9 @@ bool envSensorAvailable = false;
 #define BMP280_REG_PRESSURE 0xF7
 #define BMP280_REG_TEMP 0xFA
 
-// BMP280 Calibration data
-struct BMP280_Cal {
-  uint16_t T1 = 0;
-  int16_t T2 = 0;
-  int16_t T3 = 0;
-  uint16_t P1 = 0;
-  int16_t P2 = 0;
-  int16_t P3 = 0;
-  int16_t P4 = 0;
-  int16_t P5 = 0;
-  int16_t P6 = 0;
-  int16_t P7 = 0;
-  int16_t P8 = 0;
-  int16_t P9 = 0;
-  int32_t t_fine = 0;
-} bmp280_cal;
+// BMP280 calibration, read once at init
+BMP280Calibration bmp280_cal;
+bool bmp280_cal_valid = false;
 
 uint8_t bmp280_addr = 0;  // Will be set during init
 
@@ -130,34 +119,42 @@ void initEnvironmentalSensors() {
   
   if (envData.bmp280_available) {
     // Configure BMP280
-    // Set normal mode with oversampling x16 for all measurements
+    // config (standby, IIR filter) is only guaranteed to be taken in sleep mode:
+    // sleep first, then config, then oversampling + normal mode
     Wire.beginTransmission(bmp280_addr);
     Wire.write(BMP280_REG_CTRL_MEAS);
-    Wire.write(0xFF);  // Osrs_t=101 (x16), Osrs_p=101 (x16), Mode=11 (Normal)
+    Wire.write(0x00);
     Wire.endTransmission();
     
-    // Read calibration data
+    Wire.beginTransmission(bmp280_addr);
+    Wire.write(BMP280_REG_CONFIG);
+    Wire.write((bmp280StandbyCode(BMP280_STANDBY_MS) << 5) | (bmp280FilterCode(BMP280_IIR_FILTER) << 2));
+    Wire.endTransmission();
+    
+    Wire.beginTransmission(bmp280_addr);
+    Wire.write(BMP280_REG_CTRL_MEAS);
+    Wire.write((bmp280OversamplingCode(BMP280_OVERSAMPLING_T) << 5) |
+               (bmp280OversamplingCode(BMP280_OVERSAMPLING_P) << 2) | 0x03);  // Mode=11 (Normal)
+    Wire.endTransmission();
+    
+    // Read calibration data (one burst, parsed from the buffer: the order of
+    // two Wire.read() calls in one expression is unspecified)
+    uint8_t calibration[BMP280_CALIB_SIZE];
+    bmp280_cal_valid = false;
     Wire.beginTransmission(bmp280_addr);
     Wire.write(BMP280_REG_CALIB_T1);
     Wire.endTransmission();
-    Wire.requestFrom((uint8_t)bmp280_addr, (uint8_t)26);
+    Wire.requestFrom((uint8_t)bmp280_addr, (uint8_t)BMP280_CALIB_SIZE);
     
-    if (Wire.available() >= 26) {
-      bmp280_cal.T1 = Wire.read() | (Wire.read() << 8);
-      bmp280_cal.T2 = Wire.read() | (Wire.read() << 8);
-      bmp280_cal.T3 = Wire.read() | (Wire.read() << 8);
-      bmp280_cal.P1 = Wire.read() | (Wire.read() << 8);
-      bmp280_cal.P2 = Wire.read() | (Wire.read() << 8);
-      bmp280_cal.P3 = Wire.read() | (Wire.read() << 8);
-      bmp280_cal.P4 = Wire.read() | (Wire.read() << 8);
-      bmp280_cal.P5 = Wire.read() | (Wire.read() << 8);
-      bmp280_cal.P6 = Wire.read() | (Wire.read() << 8);
-      bmp280_cal.P7 = Wire.read() | (Wire.read() << 8);
-      bmp280_cal.P8 = Wire.read() | (Wire.read() << 8);
-      bmp280_cal.P9 = Wire.read() | (Wire.read() << 8);
+    if (Wire.available() >= BMP280_CALIB_SIZE) {
+      for (uint8_t i = 0; i < BMP280_CALIB_SIZE; i++) {
+        calibration[i] = Wire.read();
+      }
+      bmp280ParseCalibration(calibration, bmp280_cal);
+      bmp280_cal_valid = bmp280_cal.T1 != 0 && bmp280_cal.P1 != 0;
     }
     
-    envData.bmp280_status = "Ready";
+    envData.bmp280_status = bmp280_cal_valid ? "Ready" : "Calibration error";
   } else {
     envData.bmp280_status = "Not detected";
   }
@@ -214,46 +211,38 @@ bool readAHT20Data() {
 
 // Read BMP280 temperature and pressure
 bool readBMP280Data() {
-  if (!envData.bmp280_available || bmp280_addr == 0) return false;
+  if (!envData.bmp280_available || bmp280_addr == 0 || !bmp280_cal_valid) return false;
   
-  // Read pressure and temperature data
+  // Read pressure and temperature data in one burst (same conversion for both)
   Wire.beginTransmission(bmp280_addr);
   Wire.write(BMP280_REG_PRESSURE);
   Wire.endTransmission();
   
-  Wire.requestFrom((uint8_t)bmp280_addr, (uint8_t)6);
+  Wire.requestFrom((uint8_t)bmp280_addr, (uint8_t)BMP280_DATA_SIZE);
   
-  if (Wire.available() >= 6) {
-    uint32_t adc_P = ((uint32_t)Wire.read() << 12) | ((uint32_t)Wire.read() << 4);
-    adc_P |= Wire.read() >> 4;
-    
-    uint32_t adc_T = ((uint32_t)Wire.read() << 12) | ((uint32_t)Wire.read() << 4);
-    adc_T |= Wire.read() >> 4;
+  if (Wire.available() >= BMP280_DATA_SIZE) {
+    uint8_t data[BMP280_DATA_SIZE];
+    for (uint8_t i = 0; i < BMP280_DATA_SIZE; i++) {
+      data[i] = Wire.read();
+    }
+    int32_t adc_P = 0;
+    int32_t adc_T = 0;
+    bmp280ParseData(data, adc_P, adc_T);
     
-    // Temperature compensation (simplified)
-    int32_t var1 = (((adc_T >> 3) - ((int32_t)bmp280_cal.T1 << 1))) * ((int32_t)bmp280_cal.T2) >> 11;
-    int32_t var2 = (((((adc_T >> 4) - ((int32_t)bmp280_cal.T1)) * ((adc_T >> 4) - ((int32_t)bmp280_cal.T1))) >> 12) * ((int32_t)bmp280_cal.T3)) >> 14;
-    bmp280_cal.t_fine = var1 + var2;
+    // First conversion not finished yet (reset values), or measurement skipped
+    if (adc_T == BMP280_ADC_SKIPPED || adc_P == BMP280_ADC_SKIPPED) return false;
     
-    envData.temperature_bmp280 = (bmp280_cal.t_fine * 5 + 128) >> 8;
-    envData.temperature_bmp280 /= 100.0;
+    // Full-precision Bosch integer compensation (datasheet 8.2)
+    uint32_t start = diagCycleCount();
+    int32_t t_fine = bmp280TemperatureFine(adc_T, bmp280_cal);
+    int32_t temperature_centi = bmp280TemperatureCenti(t_fine);
+    uint32_t pressure_q8 = bmp280PressureQ8(adc_P, t_fine, bmp280_cal);
+    envData.bmp280_compensation_cycles = diagCycleCount() - start;
     
-    // Pressure compensation (simplified)
-    int64_t var1_p = ((int64_t)bmp280_cal.t_fine) - 128000;
-    int64_t var2_p = var1_p * var1_p * (int64_t)bmp280_cal.P6;
-    var2_p = var2_p + ((var1_p * (int64_t)bmp280_cal.P5) << 17);
-    var2_p = var2_p + (((int64_t)bmp280_cal.P4) << 35);
-    var1_p = ((var1_p * var1_p * (int64_t)bmp280_cal.P3) >> 8) + ((var1_p * (int64_t)bmp280_cal.P2) << 12);
-    var1_p = (((1LL << 47) + var1_p) * ((int64_t)bmp280_cal.P1)) >> 33;
+    if (pressure_q8 == 0) return false;
     
-    if (var1_p != 0) {
-      int64_t pressure = 1048576 - adc_P;
-      pressure = (((pressure << 31) - var2_p) * 3125) / var1_p;
-      var1_p = (((int64_t)bmp280_cal.P9) * (pressure >> 13) * (pressure >> 13)) >> 25;
-      var2_p = (((int64_t)bmp280_cal.P8) * pressure) >> 19;
-      pressure = ((pressure + var1_p + var2_p) >> 8) + (((int64_t)bmp280_cal.P7) << 4);
-      envData.pressure = pressure / 256.0 / 100.0;  // Convert to hPa
-    }
+    envData.temperature_bmp280 = temperature_centi / 100.0f;
+    envData.pressure = pressure_q8 / 25600.0f;  // Pa x256 -> hPa
     
     return true;
   }
@@ -264,8 +253,8 @@ bool readBMP280Data() {
 // Calculate altitude from pressure
 void calculateAltitude(float pressure_sea_level_hpa) {
   if (envData.pressure > 0) {
-    // Using barometric formula
-    envData.altitude = 44330.0 * (1.0 - pow(envData.pressure / pressure_sea_level_hpa, 1.0 / 5.255));
+    // Barometric formula, table instead of pow() (see bmp280_compensation.h for the error bound)
+    envData.altitude = bmp280AltitudeM(envData.pressure, pressure_sea_level_hpa);
   }
 }
 
@@ -0,0 +1,636 @@
+/*
+ * EXPORT_BUILDERS.CPP - Diagnostic report bodies (TXT, JSON, CSV, print HTML)
+ */
+
+#include "export_builders.h"
+#include "json_helpers.h"
+#include "languages.h"
+#include <stdio.h>
+
+String formatUptime(unsigned long days, unsigned long hours, unsigned long minutes) {
+  // [OPT-002] Optimize uptime formatting: use direct buffer instead of String concatenations
+  char uptimeBuf[64] = "";
+  char *p = uptimeBuf;
+  size_t remaining = sizeof(uptimeBuf) - 1;
+  
+  if (days > 0) {
+    // [OPT-008]: Direct .c_str() call avoids String() allocation
+    int written = snprintf(p, remaining, "%lu %s", days, Texts::days.str().c_str());
+    if (written > 0) {
+      p += written;
+      remaining -= written;
+    }
+  }
+  
+  if (hours > 0 || (days > 0 && remaining > 1)) {
+    if (p != uptimeBuf && remaining > 1) {
+      *p++ = ' ';
+      remaining--;
+    }
+    // [OPT-008]: Direct .c_str() call avoids String() allocation
+    int written = snprintf(p, remaining, "%lu %s", hours, Texts::hours.str().c_str());
+    if (written > 0) {
+      p += written;
+      remaining -= written;
+    }
+  }
+  
+  if (minutes > 0 || uptimeBuf[0] == '\0') {
+    if (p != uptimeBuf && remaining > 1) {
+      *p++ = ' ';
+      remaining--;
+    }
+    // [OPT-008]: Direct .c_str() call avoids String() allocation
+    snprintf(p, remaining, "%lu %s", minutes, Texts::minutes.str().c_str());
+  }
+  
+  return String(uptimeBuf);
+}
+
+String buildExportTXT(const ExportContext& ctx) {
+  String txt;
+  txt.reserve(4500);  // Reserve memory to avoid reallocations during export
+  txt = "========================================\r\n";
+  txt += String(Texts::title) + " " + String(Texts::version) + String(PROJECT_VERSION) + "\r\n";
+  txt += "========================================\r\n\r\n";
+  
+  txt += "=== CHIP ===\r\n";
+  txt += String(Texts::model) + ": " + ctx.diag.chipModel + " " + String(Texts::revision) + String(ctx.diag.chipRevision) + "\r\n";
+  txt += "CPU: " + String(ctx.diag.cpuCores) + " " + String(Texts::cores) + " @ " + String(ctx.diag.cpuFreqMHz) + " MHz\r\n";
+  txt += "MAC WiFi: " + String(formatMacAddress(ctx.diag.mac).text) + "\r\n";
+  txt += "SDK: " + String(ctx.diag.sdkVersion) + "\r\n";
+  txt += "ESP-IDF: " + String(ctx.diag.idfVersion) + "\r\n";
+  if (ctx.diag.temperature != -999) {
+    txt += String(Texts::cpu_temp) + ": " + String(ctx.diag.temperature, 1) + " °C\r\n";
+  }
+  txt += "\r\n";
+  
+  txt += "=== " + String(Texts::memory_details) + " ===\r\n";
+  txt += "Flash (" + String(Texts::board) + "): " + String(ctx.memory.flashSizeReal / 1048576.0, 2) + " MB\r\n";
+  txt += "Flash (IDE): " + String(ctx.memory.flashSizeChip / 1048576.0, 2) + " MB\r\n";
+  txt += String(Texts::flash_type) + ": " + ctx.flashType + " @ " + ctx.flashSpeed + "\r\n";
+  txt += "PSRAM: " + String(ctx.memory.psramTotal / 1048576.0, 2) + " MB";
+  if (ctx.memory.psramAvailable) {
+    txt += " (" + String(Texts::free) + ": " + String(ctx.memory.psramFree / 1048576.0, 2) + " MB)\r\n";
+  } else if (ctx.memory.psramBoardSupported) {
+    String psramHint = String(Texts::enable_psram_hint);
+    psramHint.replace("%TYPE%", ctx.memory.psramType ? ctx.memory.psramType : "PSRAM");
+    txt += " (" + String(Texts::supported_not_enabled) + " - " + psramHint + ")\r\n";
+  } else {
+    txt += " (" + String(Texts::not_detected) + ")\r\n";
+  }
+  txt += "SRAM: " + String(ctx.memory.sramTotal / 1024.0, 2) + " KB";
+  txt += " (" + String(Texts::free) + ": " + String(ctx.memory.sramFree / 1024.0, 2) + " KB)\r\n";
+  txt += String(Texts::memory_fragmentation) + ": " + String(ctx.memory.fragmentationPercent, 1) + "%\r\n";
+  txt += String(Texts::memory_status) + ": " + memoryStatusText(ctx.memory.memoryStatus) + "\r\n";
+  txt += "\r\n";
+  
+  txt += "=== WIFI ===\r\n";
+  txt += "SSID: " + String(ctx.diag.wifiSSID) + "\r\n";
+  txt += "RSSI: " + String(ctx.diag.wifiRSSI) + " dBm (" + ctx.wifiQuality + ")\r\n";
+  txt += "IP: " + String(formatIPv4(ctx.diag.ipAddress).text) + "\r\n";
+  txt += "Lien constant: " + ctx.stableUrl + " (" + String(ctx.diag.mdnsAvailable ? "actif" : "en attente") + ")\r\n";
+  txt += String(Texts::subnet_mask) + ": " + ctx.subnetMask + "\r\n";
+  txt += String(Texts::gateway) + ": " + ctx.gateway + "\r\n";
+  txt += "DNS: " + ctx.dns + "\r\n";
+  txt += "\r\n";
+
+  txt += "=== GPIO ===\r\n";
+  txt += String(Texts::total_gpio) + ": " + String(ctx.diag.totalGPIO) + " " + String(Texts::pins) + "\r\n";
+  txt += String(Texts::gpio_list) + ": " + ctx.diag.gpioList + "\r\n";
+  txt += "\r\n";
+  
+  txt += "=== " + String(Texts::i2c_peripherals) + " ===\r\n";
+  txt += String(Texts::device_count) + ": " + String(ctx.diag.i2cCount) + " - " + formatI2CDevices(ctx.diag).text + "\r\n";
+  txt += "SPI: " + ctx.spiInfo + "\r\n";
+  txt += "\r\n";
+  
+  txt += "=== " + String(Texts::test) + " ===\r\n";
+  txt += String(Texts::builtin_led) + ": " + ctx.tests.builtinLed + "\r\n";
+  txt += String(Texts::neopixel) + ": " + ctx.tests.neopixel + "\r\n";
+  txt += "OLED: " + ctx.tests.oled + "\r\n";
+  txt += "ADC: " + ctx.tests.adc + "\r\n";
+  txt += "PWM: " + ctx.tests.pwm + "\r\n";
+  txt += "SD Card: " + ctx.tests.sd + "\r\n";
+  txt += "Rotary Encoder: " + ctx.tests.rotary + "\r\n";
+  txt += "\r\n";
+  
+  txt += "=== " + String(Texts::performance_bench) + " ===\r\n";
+  if (ctx.diag.cpuBenchmark > 0) {
+    txt += "CPU: " + String(ctx.diag.cpuBenchmark) + " us (" + String(100000.0 / ctx.diag.cpuBenchmark, 2) + " MFLOPS)\r\n";
+    txt += String(Texts::memory_benchmark) + ": " + String(ctx.diag.memBenchmark) + " us\r\n";
+  } else {
+    txt += String(Texts::not_tested) + "\r\n";
+  }
+  txt += "Stress test: " + ctx.tests.stress + "\r\n";
+  txt += "\r\n";
+  
+  unsigned long seconds = ctx.diag.uptime / 1000;
+  unsigned long minutes = seconds / 60;
+  unsigned long hours = minutes / 60;
+  unsigned long days = hours / 24;
+  // === ENVIRONNEMENT ===
+  txt += "=== ENVIRONNEMENT ===\r\n";
+  txt += "AHT20: ";
+  txt += ctx.env.aht20_available ? "OK" : "Non détecté";
+  txt += "\r\n";
+  txt += "  Température (AHT20): ";
+  txt += (ctx.env.temperature_aht20 != -999.0 ? String(ctx.env.temperature_aht20, 1) + " °C" : "N/A");
+  txt += "\r\n";
+  txt += "  Humidité: ";
+  txt += (ctx.env.humidity != -999.0 ? String(ctx.env.humidity, 1) + " %" : "N/A");
+  txt += "\r\n";
+  txt += "  Statut: " + ctx.env.aht20_status + "\r\n";
+  txt += "BMP280: ";
+  txt += ctx.env.bmp280_available ? "OK" : "Non détecté";
+  txt += "\r\n";
+  txt += "  Température (BMP280): ";
+  txt += (ctx.env.temperature_bmp280 != -999.0 ? String(ctx.env.temperature_bmp280, 1) + " °C" : "N/A");
+  txt += "\r\n";
+  txt += "  Pression: ";
+  txt += (ctx.env.pressure != -999.0 ? String(ctx.env.pressure, 1) + " hPa" : "N/A");
+  txt += "\r\n";
+  txt += "  Altitude: ";
+  txt += (ctx.env.altitude != -999.0 ? String(ctx.env.altitude, 1) + " m" : "N/A");
+  txt += "\r\n";
+  txt += "  Statut: " + ctx.env.bmp280_status + "\r\n";
+  txt += "Moyenne température: ";
+  txt += (ctx.env.temperature_avg != -999.0 ? String(ctx.env.temperature_avg, 1) + " °C" : "N/A");
+  txt += "\r\n";
+  txt += "Statut global: " + ctx.env.combined_status + "\r\n";
+  txt += "\r\n";
+
+  // === GPS ===
+  txt += "=== GPS ===\r\n";
+  txt += "Module: ";
+  txt += ctx.gpsAvailable ? "OK" : "Non détecté";
+  txt += "\r\n";
+  txt += "  Statut: " + ctx.gps.status_str + "\r\n";
+  txt += "  Fix: ";
+  txt += ctx.gps.hasFix ? "Oui" : "Non";
+  txt += "\r\n";
+  txt += "  Satellites: ";
+  txt += String(ctx.gps.satellites);
+  txt += "\r\n";
+  txt += "  Latitude: ";
+  txt += (ctx.gps.hasFix ? String(ctx.gps.latitude, 6) : "N/A");
+  txt += "\r\n";
+  txt += "  Longitude: ";
+  txt += (ctx.gps.hasFix ? String(ctx.gps.longitude, 6) : "N/A");
+  txt += "\r\n";
+  txt += "  Altitude: ";
+  txt += (ctx.gps.hasFix ? String(ctx.gps.altitude, 1) + " m" : "N/A");
+  txt += "\r\n";
+  txt += "  Vitesse: ";
+  txt += (ctx.gps.hasFix ? String(ctx.gps.speed, 2) + " noeuds" : "N/A");
+  txt += "\r\n";
+  txt += "  HDOP: ";
+  txt += (ctx.gps.hasFix ? String(ctx.gps.hdop, 2) : "N/A");
+  txt += "\r\n";
+  txt += "  Date/Heure: ";
+  if (ctx.gps.hasTime && ctx.gps.hasDate) {
+    txt += String(ctx.gps.day) + "/" + String(ctx.gps.month) + "/" + String(ctx.gps.year) + " ";
+    txt += (ctx.gps.hour < 10 ? "0" : "") + String(ctx.gps.hour) + ":";
+    txt += (ctx.gps.minute < 10 ? "0" : "") + String(ctx.gps.minute) + ":";
+    txt += (ctx.gps.second < 10 ? "0" : "") + String(ctx.gps.second);
+  } else {
+    txt += "N/A";
+  }
+  txt += "\r\n\r\n";
+
+  // === SYSTEME ===
+  txt += "=== SYSTEM ===\r\n";
+  txt += String(Texts::uptime) + ": " + String(days) + "d " + String(hours % 24) + "h " + String(minutes % 60) + "m\r\n";
+  txt += String(Texts::last_reset) + ": " + ctx.resetReason + "\r\n";
+  txt += "\r\n";
+  txt += "========================================\r\n";
+  txt += String(Texts::export_generated) + " " + String(millis()/1000) + "s " + String(Texts::export_after_boot) + "\r\n";
+  txt += "========================================\r\n";
+
+  return txt;
+}
+
+String buildExportJSON(const ExportContext& ctx) {
+  String json;
+  json.reserve(3500);  // Reserve memory to avoid reallocations during export
+  json = "{";
+  json += "\"chip\":{";
+  json += "\"model\":\"" + String(ctx.diag.chipModel) + "\",";
+  json += "\"revision\":\"" + String(ctx.diag.chipRevision) + "\",";
+  json += "\"cores\":" + String(ctx.diag.cpuCores) + ",";
+  json += "\"freq_mhz\":" + String(ctx.diag.cpuFreqMHz) + ",";
+  json += "\"mac\":\"" + String(formatMacAddress(ctx.diag.mac).text) + "\",";
+  json += "\"sdk\":\"" + String(ctx.diag.sdkVersion) + "\",";
+  json += "\"idf\":\"" + String(ctx.diag.idfVersion) + "\"";
+  if (ctx.diag.temperature != -999) {
+    json += ",\"temperature\":" + String(ctx.diag.temperature, 1);
+  }
+  json += "},";
+  
+  json += "\"memory\":{";
+  json += "\"flash_real_mb\":" + String(ctx.memory.flashSizeReal / 1048576.0, 2) + ",";
+  json += "\"flash_config_mb\":" + String(ctx.memory.flashSizeChip / 1048576.0, 2) + ",";
+  json += "\"flash_type\":\"" + ctx.flashType + "\",";
+  json += "\"flash_speed\":\"" + ctx.flashSpeed + "\",";
+  json += "\"psram_mb\":" + String(ctx.memory.psramTotal / 1048576.0, 2) + ",";
+  json += "\"psram_free_mb\":" + String(ctx.memory.psramFree / 1048576.0, 2) + ",";
+  json += "\"psram_available\":" + String(ctx.memory.psramAvailable ? "true" : "false") + ",";
+  json += "\"psram_supported\":" + String(ctx.memory.psramBoardSupported ? "true" : "false") + ",";
+  json += "\"psram_type\":\"" + String(ctx.memory.psramType ? ctx.memory.psramType : Texts::unknown.str()) + "\",";
+  json += "\"sram_kb\":" + String(ctx.memory.sramTotal / 1024.0, 2) + ",";
+  json += "\"sram_free_kb\":" + String(ctx.memory.sramFree / 1024.0, 2) + ",";
+  json += "\"fragmentation\":" + String(ctx.memory.fragmentationPercent, 1) + ",";
+  json += "\"status\":\"" + String(memoryStatusText(ctx.memory.memoryStatus)) + "\"";
+  json += "},";
+  
+  json += "\"wifi\":{";
+  json += "\"ssid\":\"" + String(ctx.diag.wifiSSID) + "\",";
+  json += "\"rssi\":" + String(ctx.diag.wifiRSSI) + ",";
+  json += "\"quality\":\"" + ctx.wifiQuality + "\",";
+  json += "\"ip\":\"" + String(formatIPv4(ctx.diag.ipAddress).text) + "\",";
+  json += "\"mdns_ready\":" + String(ctx.diag.mdnsAvailable ? "true" : "false") + ",";
+  json += "\"stable_url\":\"" + jsonEscape(ctx.stableUrl.c_str()) + "\",";
+  json += "\"subnet\":\"" + ctx.subnetMask + "\",";
+  json += "\"gateway\":\"" + ctx.gateway + "\",";
+  json += "\"dns\":\"" + ctx.dns + "\"";
+  json += "},";
+
+  json += "\"gpio\":{";
+  json += "\"total\":" + String(ctx.diag.totalGPIO) + ",";
+  json += "\"list\":\"" + String(ctx.diag.gpioList) + "\"";
+  json += "},";
+  
+  json += "\"peripherals\":{";
+  json += "\"i2c_count\":" + String(ctx.diag.i2cCount) + ",";
+  json += "\"i2c_devices\":\"" + String(formatI2CDevices(ctx.diag).text) + "\",";
+  json += "\"spi\":\"" + ctx.spiInfo + "\"";
+  json += "},";
+  
+  json += "\"hardware_tests\":{";
+  json += "\"builtin_led\":\"" + ctx.tests.builtinLed + "\",";
+  json += "\"neopixel\":\"" + ctx.tests.neopixel + "\",";
+  json += "\"oled\":\"" + ctx.tests.oled + "\",";
+  json += "\"adc\":\"" + ctx.tests.adc + "\",";
+  json += "\"pwm\":\"" + ctx.tests.pwm + "\",";
+  json += "\"sd_card\":\"" + ctx.tests.sd + "\",";
+  json += "\"rotary_encoder\":\"" + ctx.tests.rotary + "\"";
+  json += "},";
+  
+  json += "\"performance\":{";
+  if (ctx.diag.cpuBenchmark > 0) {
+    json += "\"cpu_us\":" + String(ctx.diag.cpuBenchmark) + ",";
+    json += "\"cpu_mflops\":" + String(100000.0 / ctx.diag.cpuBenchmark, 2) + ",";
+    json += "\"memory_us\":" + String(ctx.diag.memBenchmark);
+  } else {
+    json += "\"benchmarks\":\"not_run\"";
+  }
+  json += ",\"stress_test\":\"" + ctx.tests.stress + "\"";
+  json += "},";
+  
+  // === ENVIRONNEMENT ===
+  json += "\"environment\":{";
+  json += "\"aht20_available\":" + String(ctx.env.aht20_available ? "true" : "false") + ",";
+  json += "\"temperature_aht20\":" + (ctx.env.temperature_aht20 != -999.0 ? String(ctx.env.temperature_aht20, 1) : "null") + ",";
+  json += "\"humidity\":" + (ctx.env.humidity != -999.0 ? String(ctx.env.humidity, 1) : "null") + ",";
+  json += "\"aht20_status\":\"" + jsonEscape(ctx.env.aht20_status.c_str()) + "\",";
+  json += "\"bmp280_available\":" + String(ctx.env.bmp280_available ? "true" : "false") + ",";
+  json += "\"temperature_bmp280\":" + (ctx.env.temperature_bmp280 != -999.0 ? String(ctx.env.temperature_bmp280, 1) : "null") + ",";
+  json += "\"pressure\":" + (ctx.env.pressure != -999.0 ? String(ctx.env.pressure, 1) : "null") + ",";
+  json += "\"altitude\":" + (ctx.env.altitude != -999.0 ? String(ctx.env.altitude, 1) : "null") + ",";
+  json += "\"bmp280_status\":\"" + jsonEscape(ctx.env.bmp280_status.c_str()) + "\",";
+  json += "\"temperature_avg\":" + (ctx.env.temperature_avg != -999.0 ? String(ctx.env.temperature_avg, 1) : "null") + ",";
+  json += "\"combined_status\":\"" + jsonEscape(ctx.env.combined_status.c_str()) + "\"";
+  json += "},";
+
+  // === GPS ===
+  json += "\"gps\":{";
+  json += "\"available\":" + String(ctx.gpsAvailable ? "true" : "false") + ",";
+  json += "\"status\":\"" + jsonEscape(ctx.gps.status_str.c_str()) + "\",";
+  json += "\"has_fix\":" + String(ctx.gps.hasFix ? "true" : "false") + ",";
+  json += "\"satellites\":" + String(ctx.gps.satellites) + ",";
+  json += "\"latitude\":" + (ctx.gps.hasFix ? String(ctx.gps.latitude, 6) : "null") + ",";
+  json += "\"longitude\":" + (ctx.gps.hasFix ? String(ctx.gps.longitude, 6) : "null") + ",";
+  json += "\"altitude\":" + (ctx.gps.hasFix ? String(ctx.gps.altitude, 1) : "null") + ",";
+  json += "\"speed\":" + (ctx.gps.hasFix ? String(ctx.gps.speed, 2) : "null") + ",";
+  json += "\"hdop\":" + (ctx.gps.hasFix ? String(ctx.gps.hdop, 2) : "null") + ",";
+  json += "\"date_time\":\"";
+  if (ctx.gps.hasTime && ctx.gps.hasDate) {
+    json += String(ctx.gps.day) + "/" + String(ctx.gps.month) + "/" + String(ctx.gps.year) + " ";
+    if (ctx.gps.hour < 10) json += "0";
+    json += String(ctx.gps.hour) + ":";
+    if (ctx.gps.minute < 10) json += "0";
+    json += String(ctx.gps.minute) + ":";
+    if (ctx.gps.second < 10) json += "0";
+    json += String(ctx.gps.second);
+  } else {
+    json += "N/A";
+  }
+  json += "\"";
+  json += "},";
+
+  // === SYSTEME ===
+  json += "\"system\":{";
+  json += "\"uptime_ms\":" + String(ctx.diag.uptime) + ",";
+  json += "\"reset_reason\":\"" + ctx.resetReason + "\",";
+  json += "\"language\":\"en\"";
+  json += "}";
+
+  json += "}";
+
+  return json;
+}
+
+String buildExportCSV(const ExportContext& ctx) {
+  String csv;
+  csv.reserve(4000);  // Reserve memory to avoid reallocations during export
+  csv = String(Texts::category) + "," + String(Texts::parameter) + "," + String(Texts::value) + "\r\n";
+  
+  csv += "Chip," + String(Texts::model) + "," + ctx.diag.chipModel + "\r\n";
+  csv += "Chip," + String(Texts::revision) + "," + String(ctx.diag.chipRevision) + "\r\n";
+  csv += "Chip,CPU " + String(Texts::cores) + "," + String(ctx.diag.cpuCores) + "\r\n";
+  csv += "Chip," + String(Texts::frequency) + " MHz," + String(ctx.diag.cpuFreqMHz) + "\r\n";
+  csv += "Chip,MAC," + String(formatMacAddress(ctx.diag.mac).text) + "\r\n";
+  if (ctx.diag.temperature != -999) {
+    csv += "Chip," + String(Texts::cpu_temp) + " C," + String(ctx.diag.temperature, 1) + "\r\n";
+  }
+  
+  csv += String(Texts::memory_details) + ",Flash MB (" + String(Texts::board) + ")," + String(ctx.memory.flashSizeReal / 1048576.0, 2) + "\r\n";
+  csv += String(Texts::memory_details) + ",Flash MB (config)," + String(ctx.memory.flashSizeChip / 1048576.0, 2) + "\r\n";
+  csv += String(Texts::memory_details) + "," + String(Texts::flash_type) + "," + ctx.flashType + "\r\n";
+  csv += String(Texts::memory_details) + ",PSRAM MB," + String(ctx.memory.psramTotal / 1048576.0, 2) + "\r\n";
+  csv += String(Texts::memory_details) + ",PSRAM " + String(Texts::free) + " MB," + String(ctx.memory.psramFree / 1048576.0, 2) + "\r\n";
+  String psramStatus = ctx.memory.psramAvailable ? String(Texts::detected_active)
+                                                    : (ctx.memory.psramBoardSupported ? String(Texts::supported_not_enabled)
+                                                                                        : String(Texts::not_detected));
+  csv += String(Texts::memory_details) + ",PSRAM Statut,\"" + psramStatus + "\"\r\n";
+  if (!ctx.memory.psramAvailable && ctx.memory.psramBoardSupported) {
+    String psramHint = String(Texts::enable_psram_hint);
+    psramHint.replace("%TYPE%", ctx.memory.psramType ? ctx.memory.psramType : "PSRAM");
+    psramHint.replace("\"", "'");
+    csv += String(Texts::memory_details) + ",PSRAM Conseils,\"" + psramHint + "\"\r\n";
+  }
+  csv += String(Texts::memory_details) + ",SRAM KB," + String(ctx.memory.sramTotal / 1024.0, 2) + "\r\n";
+  csv += String(Texts::memory_details) + ",SRAM " + String(Texts::free) + " KB," + String(ctx.memory.sramFree / 1024.0, 2) + "\r\n";
+  csv += String(Texts::memory_details) + "," + String(Texts::memory_fragmentation) + " %," + String(ctx.memory.fragmentationPercent, 1) + "\r\n";
+  
+  csv += "WiFi,SSID," + String(ctx.diag.wifiSSID) + "\r\n";
+  csv += "WiFi,RSSI dBm," + String(ctx.diag.wifiRSSI) + "\r\n";
+  csv += "WiFi,IP," + String(formatIPv4(ctx.diag.ipAddress).text) + "\r\n";
+  csv += "WiFi," + String(Texts::gateway) + "," + ctx.gateway + "\r\n";
+
+  csv += "GPIO," + String(Texts::total_gpio) + "," + String(ctx.diag.totalGPIO) + "\r\n";
+  
+  csv += String(Texts::i2c_peripherals) + "," + String(Texts::device_count) + "," + String(ctx.diag.i2cCount) + "\r\n";
+  csv += String(Texts::i2c_peripherals) + "," + String(Texts::devices) + "," + formatI2CDevices(ctx.diag).text + "\r\n";
+  
+  csv += String(Texts::test) + "," + String(Texts::builtin_led) + "," + ctx.tests.builtinLed + "\r\n";
+  csv += String(Texts::test) + "," + String(Texts::neopixel) + "," + ctx.tests.neopixel + "\r\n";
+  csv += String(Texts::test) + ",OLED," + ctx.tests.oled + "\r\n";
+  csv += String(Texts::test) + ",ADC," + ctx.tests.adc + "\r\n";
+  csv += String(Texts::test) + ",PWM," + ctx.tests.pwm + "\r\n";
+  csv += String(Texts::test) + ",SD Card," + ctx.tests.sd + "\r\n";
+  csv += String(Texts::test) + ",Rotary Encoder," + ctx.tests.rotary + "\r\n";
+
+  if (ctx.diag.cpuBenchmark > 0) {
+    csv += String(Texts::performance_bench) + ",CPU us," + String(ctx.diag.cpuBenchmark) + "\r\n";
+    csv += String(Texts::performance_bench) + "," + String(Texts::memory_benchmark) + " us," + String(ctx.diag.memBenchmark) + "\r\n";
+  }
+
+  // === ENVIRONNEMENT ===
+  csv += "Environnement,AHT20 disponible," + String(ctx.env.aht20_available ? "Oui" : "Non") + "\r\n";
+  csv += "Environnement,Température (AHT20)," + (ctx.env.temperature_aht20 != -999.0 ? String(ctx.env.temperature_aht20, 1) : "N/A") + "\r\n";
+  csv += "Environnement,Humidité," + (ctx.env.humidity != -999.0 ? String(ctx.env.humidity, 1) : "N/A") + "\r\n";
+  csv += "Environnement,Statut AHT20," + ctx.env.aht20_status + "\r\n";
+  csv += "Environnement,BMP280 disponible," + String(ctx.env.bmp280_available ? "Oui" : "Non") + "\r\n";
+  csv += "Environnement,Température (BMP280)," + (ctx.env.temperature_bmp280 != -999.0 ? String(ctx.env.temperature_bmp280, 1) : "N/A") + "\r\n";
+  csv += "Environnement,Pression," + (ctx.env.pressure != -999.0 ? String(ctx.env.pressure, 1) : "N/A") + "\r\n";
+  csv += "Environnement,Altitude," + (ctx.env.altitude != -999.0 ? String(ctx.env.altitude, 1) : "N/A") + "\r\n";
+  csv += "Environnement,Statut BMP280," + ctx.env.bmp280_status + "\r\n";
+  csv += "Environnement,Température moyenne," + (ctx.env.temperature_avg != -999.0 ? String(ctx.env.temperature_avg, 1) : "N/A") + "\r\n";
+  csv += "Environnement,Statut global," + ctx.env.combined_status + "\r\n";
+
+  // === GPS ===
+  csv += "GPS,Module disponible," + String(ctx.gpsAvailable ? "Oui" : "Non") + "\r\n";
+  csv += "GPS,Statut," + ctx.gps.status_str + "\r\n";
+  csv += "GPS,Fix," + String(ctx.gps.hasFix ? "Oui" : "Non") + "\r\n";
+  csv += "GPS,Satellites," + String(ctx.gps.satellites) + "\r\n";
+  csv += "GPS,Latitude," + (ctx.gps.hasFix ? String(ctx.gps.latitude, 6) : "N/A") + "\r\n";
+  csv += "GPS,Longitude," + (ctx.gps.hasFix ? String(ctx.gps.longitude, 6) : "N/A") + "\r\n";
+  csv += "GPS,Altitude," + (ctx.gps.hasFix ? String(ctx.gps.altitude, 1) : "N/A") + "\r\n";
+  csv += "GPS,Vitesse," + (ctx.gps.hasFix ? String(ctx.gps.speed, 2) : "N/A") + "\r\n";
+  csv += "GPS,HDOP," + (ctx.gps.hasFix ? String(ctx.gps.hdop, 2) : "N/A") + "\r\n";
+  csv += "GPS,Date/Heure,";
+  if (ctx.gps.hasTime && ctx.gps.hasDate) {
+    csv += String(ctx.gps.day) + "/" + String(ctx.gps.month) + "/" + String(ctx.gps.year) + " ";
+    if (ctx.gps.hour < 10) csv += "0";
+    csv += String(ctx.gps.hour) + ":";
+    if (ctx.gps.minute < 10) csv += "0";
+    csv += String(ctx.gps.minute) + ":";
+    if (ctx.gps.second < 10) csv += "0";
+    csv += String(ctx.gps.second);
+  } else {
+    csv += "N/A";
+  }
+  csv += "\r\n";
+
+  csv += "System," + String(Texts::uptime) + " ms," + String(ctx.diag.uptime) + "\r\n";
+  csv += "System," + String(Texts::last_reset) + "," + ctx.resetReason + "\r\n";
+
+  return csv;
+}
+
+String buildPrintHTML(const ExportContext& ctx) {
+  // [OPT-007]: Buffer-based HTML title (1 vs 4 allocations)
+  char titleBuf[256];
+  snprintf(titleBuf, sizeof(titleBuf), "<!DOCTYPE html><html><head><meta charset='UTF-8'><title>%s %s%s</title>",
+           Texts::title.str().c_str(), Texts::version.str().c_str(), PROJECT_VERSION);
+  String html = String(titleBuf);
+  html += "<style>";
+  html += "@page{size:A4;margin:10mm}";
+  html += "body{font:11px Arial;margin:10px;color:#333}";
+  html += "h1{font-size:18px;margin:0 0 5px;border-bottom:3px solid #667eea;color:#667eea;padding-bottom:5px}";
+  html += "h2{font-size:14px;margin:15px 0 8px;color:#667eea;border-bottom:1px solid #ddd;padding-bottom:3px}";
+  html += ".section{margin-bottom:20px}";
+  html += ".grid{display:grid;grid-template-columns:1fr 1fr;gap:10px;margin:10px 0}";
+  html += ".row{display:flex;margin:3px 0;padding:5px;background:#f8f9fa;border-radius:3px}";
+  html += ".row b{min-width:150px;color:#667eea}";
+  html += ".badge{display:inline-block;padding:2px 8px;border-radius:10px;font-size:10px;font-weight:bold}";
+  html += ".badge-success{background:#d4edda;color:#155724}";
+  html += ".badge-warning{background:#fff3cd;color:#856404}";
+  html += ".badge-danger{background:#f8d7da;color:#721c24}";
+  html += "table{width:100%;border-collapse:collapse;margin:10px 0;font-size:10px}";
+  html += "th{background:#667eea;color:#fff;padding:5px;text-align:left}";
+  html += "td{border:1px solid #ddd;padding:4px}";
+  html += ".footer{margin-top:20px;padding-top:10px;border-top:1px solid #ddd;font-size:9px;color:#666;text-align:center}";
+  html += "</style></head>";
+  html += "<body onload='window.print()'>";
+  
+  // Header traduit
+  html += "<h1>" + String(Texts::title) + " " + String(Texts::version) + String(PROJECT_VERSION) + "</h1>";
+  html += "<div style='margin:10px 0;font-size:12px;color:#666'>";
+  html += String(Texts::export_generated) + " " + String(millis()/1000) + "s " + String(Texts::export_after_boot) + " | IP: " + formatIPv4(ctx.diag.ipAddress).text;
+  html += "</div>";
+  
+  // Chip
+  html += "<div class='section'>";
+  html += "<h2>" + String(Texts::chip_info) + "</h2>";
+  html += "<div class='grid'>";
+  html += "<div class='row'><b>" + String(Texts::full_model) + ":</b><span>" + ctx.diag.chipModel + " Rev" + String(ctx.diag.chipRevision) + "</span></div>";
+  html += "<div class='row'><b>" + String(Texts::cpu_cores) + ":</b><span>" + String(ctx.diag.cpuCores) + " " + String(Texts::cores) + " @ " + String(ctx.diag.cpuFreqMHz) + " MHz</span></div>";
+  html += "<div class='row'><b>" + String(Texts::mac_wifi) + ":</b><span>" + formatMacAddress(ctx.diag.mac).text + "</span></div>";
+  html += "<div class='row'><b>" + String(Texts::sdk_version) + ":</b><span>" + ctx.diag.sdkVersion + "</span></div>";
+  html += "<div class='row'><b>" + String(Texts::idf_version) + ":</b><span>" + ctx.diag.idfVersion + "</span></div>";
+  if (ctx.diag.temperature != -999) {
+    html += "<div class='row'><b>" + String(Texts::cpu_temp) + ":</b><span>" + String(ctx.diag.temperature, 1) + " °C</span></div>";
+  }
+
+  unsigned long seconds = ctx.diag.uptime / 1000;
+  unsigned long minutes = seconds / 60;
+  unsigned long hours = minutes / 60;
+  unsigned long days = hours / 24;
+  html += "<div class='row'><b>" + String(Texts::uptime) + ":</b><span>" + formatUptime(days, hours % 24, minutes % 60) + "</span></div>";
+  html += "<div class='row'><b>" + String(Texts::last_reset) + ":</b><span>" + ctx.resetReason + "</span></div>";
+  html += "</div></div>";
+
+
+  // Mémoire
+  html += "<div class='section'>";
+  html += "<h2>" + String(Texts::memory_details) + "</h2>";
+  html += "<table>";
+  html += "<tr><th>" + String(Texts::category) + "</th><th>" + String(Texts::total_size) + "</th><th>" + String(Texts::free) + "</th><th>" + String(Texts::used) + "</th><th>" + String(Texts::status) + "</th></tr>";
+  // ...existing code for memory table...
+  bool flashMatch = (ctx.memory.flashSizeReal == ctx.memory.flashSizeChip);
+  html += "<tr><td><b>" + String(Texts::flash_memory) + "</b></td>";
+  html += "<td>" + String(ctx.memory.flashSizeReal / 1048576.0, 1) + " MB</td>";
+  html += "<td>-</td><td>-</td>";
+  html += "<td><span class='badge " + String(flashMatch ? "badge-success'>" + String(Texts::ok) : "badge-warning'>" + String(Texts::ide_config)) + "</span></td></tr>";
+  // ...existing code for PSRAM and SRAM...
+  if (ctx.memory.psramAvailable) {
+    html += "<tr><td><b>" + String(Texts::psram_external) + "</b></td>";
+    html += "<td>" + String(ctx.memory.psramTotal / 1048576.0, 1) + " MB</td>";
+    html += "<td>" + String(ctx.memory.psramFree / 1048576.0, 1) + " MB</td>";
+    html += "<td>" + String(ctx.memory.psramUsed / 1048576.0, 1) + " MB</td>";
+    html += "<td><span class='badge badge-success'>" + String(Texts::detected_active) + "</span></td></tr>";
+  } else if (ctx.memory.psramBoardSupported) {
+    html += "<tr><td><b>" + String(Texts::psram_external) + "</b></td>";
+    html += "<td>" + String(ctx.memory.psramTotal / 1048576.0, 1) + " MB</td>";
+    html += "<td>-</td><td>-</td>";
+    String psramHint = String(Texts::enable_psram_hint);
+    psramHint.replace("%TYPE%", ctx.memory.psramType ? ctx.memory.psramType : "PSRAM");
+    html += "<td><span class='badge badge-warning'>" + String(Texts::supported_not_enabled) + "</span><br><small>" + psramHint + "</small></td></tr>";
+  } else {
+    html += "<tr><td><b>" + String(Texts::psram_external) + "</b></td>";
+    html += "<td>" + String(ctx.memory.psramTotal / 1048576.0, 1) + " MB</td>";
+    html += "<td>-</td><td>-</td>";
+    html += "<td><span class='badge badge-danger'>" + String(Texts::not_detected) + "</span></td></tr>";
+  }
+  html += "<tr><td><b>" + String(Texts::internal_sram) + "</b></td>";
+  html += "<td>" + String(ctx.memory.sramTotal / 1024.0, 1) + " KB</td>";
+  html += "<td>" + String(ctx.memory.sramFree / 1024.0, 1) + " KB</td>";
+  html += "<td>" + String(ctx.memory.sramUsed / 1024.0, 1) + " KB</td>";
+  html += "<td><span class='badge badge-success'>" + String(memoryStatusText(ctx.memory.memoryStatus)) + "</span></td></tr>";
+  html += "</table>";
+  html += "<div class='row'><b>" + String(Texts::memory_fragmentation) + ":</b><span>" + String(ctx.memory.fragmentationPercent, 1) + "% - " + memoryStatusText(ctx.memory.memoryStatus) + "</span></div>";
+  html += "</div>";
+
+  // === ENVIRONNEMENT ===
+  html += "<div class='section'>";
+  html += "<h2>Environnement</h2>";
+  html += "<table>";
+  html += "<tr><th>Capteur</th><th>Paramètre</th><th>Valeur</th></tr>";
+  html += "<tr><td>AHT20</td><td>Disponible</td><td>" + String(ctx.env.aht20_available ? "Oui" : "Non") + "</td></tr>";
+  html += "<tr><td>AHT20</td><td>Température</td><td>" + (ctx.env.temperature_aht20 != -999.0 ? String(ctx.env.temperature_aht20, 1) + " °C" : "N/A") + "</td></tr>";
+  html += "<tr><td>AHT20</td><td>Humidité</td><td>" + (ctx.env.humidity != -999.0 ? String(ctx.env.humidity, 1) + " %" : "N/A") + "</td></tr>";
+  html += "<tr><td>AHT20</td><td>Statut</td><td>" + ctx.env.aht20_status + "</td></tr>";
+  html += "<tr><td>BMP280</td><td>Disponible</td><td>" + String(ctx.env.bmp280_available ? "Oui" : "Non") + "</td></tr>";
+  html += "<tr><td>BMP280</td><td>Température</td><td>" + (ctx.env.temperature_bmp280 != -999.0 ? String(ctx.env.temperature_bmp280, 1) + " °C" : "N/A") + "</td></tr>";
+  html += "<tr><td>BMP280</td><td>Pression</td><td>" + (ctx.env.pressure != -999.0 ? String(ctx.env.pressure, 1) + " hPa" : "N/A") + "</td></tr>";
+  html += "<tr><td>BMP280</td><td>Altitude</td><td>" + (ctx.env.altitude != -999.0 ? String(ctx.env.altitude, 1) + " m" : "N/A") + "</td></tr>";
+  html += "<tr><td>BMP280</td><td>Statut</td><td>" + ctx.env.bmp280_status + "</td></tr>";
+  html += "<tr><td colspan='2'>Température moyenne</td><td>" + (ctx.env.temperature_avg != -999.0 ? String(ctx.env.temperature_avg, 1) + " °C" : "N/A") + "</td></tr>";
+  html += "<tr><td colspan='2'>Statut global</td><td>" + ctx.env.combined_status + "</td></tr>";
+  html += "</table></div>";
+
+  // === GPS ===
+  html += "<div class='section'>";
+  html += "<h2>GPS</h2>";
+  html += "<table>";
+  html += "<tr><th>Paramètre</th><th>Valeur</th></tr>";
+  html += "<tr><td>Module disponible</td><td>" + String(ctx.gpsAvailable ? "Oui" : "Non") + "</td></tr>";
+  html += "<tr><td>Statut</td><td>" + ctx.gps.status_str + "</td></tr>";
+  html += "<tr><td>Fix</td><td>" + String(ctx.gps.hasFix ? "Oui" : "Non") + "</td></tr>";
+  html += "<tr><td>Satellites</td><td>" + String(ctx.gps.satellites) + "</td></tr>";
+  html += "<tr><td>Latitude</td><td>" + (ctx.gps.hasFix ? String(ctx.gps.latitude, 6) : "N/A") + "</td></tr>";
+  html += "<tr><td>Longitude</td><td>" + (ctx.gps.hasFix ? String(ctx.gps.longitude, 6) : "N/A") + "</td></tr>";
+  html += "<tr><td>Altitude</td><td>" + (ctx.gps.hasFix ? String(ctx.gps.altitude, 1) + " m" : "N/A") + "</td></tr>";
+  html += "<tr><td>Vitesse</td><td>" + (ctx.gps.hasFix ? String(ctx.gps.speed, 2) + " noeuds" : "N/A") + "</td></tr>";
+  html += "<tr><td>HDOP</td><td>" + (ctx.gps.hasFix ? String(ctx.gps.hdop, 2) : "N/A") + "</td></tr>";
+  html += "<tr><td>Date/Heure</td><td>";
+  if (ctx.gps.hasTime && ctx.gps.hasDate) {
+    html += String(ctx.gps.day) + "/" + String(ctx.gps.month) + "/" + String(ctx.gps.year) + " ";
+    if (ctx.gps.hour < 10) html += "0";
+    html += String(ctx.gps.hour) + ":";
+    if (ctx.gps.minute < 10) html += "0";
+    html += String(ctx.gps.minute) + ":";
+    if (ctx.gps.second < 10) html += "0";
+    html += String(ctx.gps.second);
+  } else {
+    html += "N/A";
+  }
+  html += "</td></tr>";
+  html += "</table></div>";
+
+  // WiFi
+  html += "<div class='section'>";
+  html += "<h2>" + String(Texts::wifi_connection) + "</h2>";
+  html += "<div class='grid'>";
+  html += "<div class='row'><b>" + String(Texts::connected_ssid) + ":</b><span>" + ctx.diag.wifiSSID + "</span></div>";
+  html += "<div class='row'><b>" + String(Texts::signal_power) + ":</b><span>" + String(ctx.diag.wifiRSSI) + " dBm</span></div>";
+  html += "<div class='row'><b>" + String(Texts::signal_quality) + ":</b><span>" + ctx.wifiQuality + "</span></div>";
+  html += "<div class='row'><b>" + String(Texts::ip_address) + ":</b><span>" + formatIPv4(ctx.diag.ipAddress).text + "</span></div>";
+  html += "<div class='row'><b>" + String(Texts::subnet_mask) + ":</b><span>" + ctx.subnetMask + "</span></div>";
+  html += "<div class='row'><b>" + String(Texts::dns) + ":</b><span>" + ctx.dns + "</span></div>";
+  html += "<div class='row'><b>" + String(Texts::gateway) + ":</b><span>" + ctx.gateway + "</span></div>";
+  html += "</div></div>";
+
+  // GPIO et Périphériques
+  html += "<div class='section'>";
+  html += "<h2>" + String(Texts::gpio_interfaces) + "</h2>";
+  html += "<div class='grid'>";
+  html += "<div class='row'><b>" + String(Texts::total_gpio) + ":</b><span>" + String(ctx.diag.totalGPIO) + " " + String(Texts::pins) + "</span></div>";
+  html += "<div class='row'><b>" + String(Texts::i2c_peripherals) + ":</b><span>" + String(ctx.diag.i2cCount) + " " + String(Texts::devices) + " - " + formatI2CDevices(ctx.diag).text + "</span></div>";
+  html += "<div class='row'><b>" + String(Texts::spi_bus) + ":</b><span>" + ctx.spiInfo + "</span></div>";
+  html += "</div></div>";
+
+  // Tests Matériels
+  html += "<div class='section'>";
+  html += "<h2>" + String(Texts::nav_tests) + "</h2>";
+  html += "<table>";
+  html += "<tr><th>" + String(Texts::parameter) + "</th><th>" + String(Texts::status) + "</th></tr>";
+  html += "<tr><td>" + String(Texts::builtin_led) + "</td><td>" + ctx.tests.builtinLed + "</td></tr>";
+  html += "<tr><td>" + String(Texts::neopixel) + "</td><td>" + ctx.tests.neopixel + "</td></tr>";
+  html += "<tr><td>" + String(Texts::oled_screen) + "</td><td>" + ctx.tests.oled + "</td></tr>";
+  html += "<tr><td>" + String(Texts::adc_test) + "</td><td>" + ctx.tests.adc + "</td></tr>";
+  html += "<tr><td>" + String(Texts::pwm_test) + "</td><td>" + ctx.tests.pwm + "</td></tr>";
+  html += "</table></div>";
+
+  // Performance
+  if (ctx.diag.cpuBenchmark > 0) {
+    html += "<div class='section'>";
+    html += "<h2>" + String(Texts::performance_bench) + "</h2>";
+    html += "<div class='grid'>";
+    html += "<div class='row'><b>" + String(Texts::cpu_benchmark) + ":</b><span>" + String(ctx.diag.cpuBenchmark) + " µs (" + String(100000.0 / ctx.diag.cpuBenchmark, 2) + " MFLOPS)</span></div>";
+    html += "<div class='row'><b>" + String(Texts::memory_benchmark) + ":</b><span>" + String(ctx.diag.memBenchmark) + " µs</span></div>";
+    html += "<div class='row'><b>" + String(Texts::memory_stress) + ":</b><span>" + ctx.tests.stress + "</span></div>";
+    html += "</div></div>";
+  }
+  
+  // Footer
+  html += "<div class='footer'>";
+  html += String(PROJECT_NAME) + " v"+ String(PROJECT_VERSION) + " | " + ctx.diag.chipModel + " | MAC: " + formatMacAddress(ctx.diag.mac).text;
+  html += "</div>";
+  
+  html += "</body></html>";
+  
+  return html;
+}
@@ -0,0 +1,254 @@
+/*
+ * GPIO_BENCHMARK.CPP - GPIO toggle-rate and interrupt-latency benchmark
+ */
+
+#include "gpio_benchmark.h"
+#include "config.h"
+#include "cycle_counter.h"
+#include <WiFi.h>
+#include <WiFiUdp.h>
+#include <driver/gpio.h>
+#include <soc/soc.h>
+#include <soc/gpio_reg.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <algorithm>
+
+// Global benchmark variables
+GPIOBenchmarkData gpioBenchmarkData;
+String gpioBenchmarkTestResult = "Not tested";
+
+// ISR shared state (single outstanding edge at a time)
+static volatile uint32_t isrStartCycles = 0;
+static volatile uint32_t isrLatencyCycles = 0;
+static volatile bool isrFired = false;
+static uint32_t latencySamples[GPIO_BENCH_ISR_SAMPLES];
+
+// Background UDP load (Wi-Fi busy pass)
+static volatile bool udpLoadRunning = false;
+static volatile uint32_t udpLoadPackets = 0;
+static TaskHandle_t udpLoadTaskHandle = nullptr;
+
+static void IRAM_ATTR gpioBenchISR() {
+  uint32_t now = diagCycleCount();
+  if (!isrFired) {
+    isrLatencyCycles = now - isrStartCycles;
+    isrFired = true;
+  }
+}
+
+// Direct W1TS/W1TC register access: no bounds checks, no lock
+static inline void IRAM_ATTR gpioBenchWrite(int pin, bool high) {
+  if (pin < 32) {
+    REG_WRITE(high ? GPIO_OUT_W1TS_REG : GPIO_OUT_W1TC_REG, 1UL << pin);
+  } else {
+    REG_WRITE(high ? GPIO_OUT1_W1TS_REG : GPIO_OUT1_W1TC_REG, 1UL << (pin - 32));
+  }
+}
+
+// Best of 3 passes to filter out preemption by other tasks
+template <typename ToggleFn>
+static uint32_t measureToggleCycles(uint32_t iterations, ToggleFn toggle) {
+  uint32_t best = UINT32_MAX;
+  for (int pass = 0; pass < 3; pass++) {
+    uint32_t start = diagCycleCount();
+    for (uint32_t i = 0; i < iterations; i++) {
+      toggle(true);
+      toggle(false);
+    }
+    uint32_t elapsed = diagCycleCount() - start;
+    if (elapsed < best) best = elapsed;
+    vTaskDelay(1);
+  }
+  return best;
+}
+
+static float cyclesToToggleKHz(uint32_t cycles, uint32_t iterations, uint32_t cpuMhz) {
+  if (cycles == 0) return 0.0;
+  // One iteration = one full period (HIGH + LOW)
+  return (float)((double)iterations * cpuMhz * 1000.0 / cycles);
+}
+
+static void measureISRLatency(int outPin, GPIOLatencyStats& stats) {
+  uint16_t count = 0;
+  uint16_t missed = 0;
+
+  for (uint16_t i = 0; i < GPIO_BENCH_ISR_SAMPLES; i++) {
+    gpioBenchWrite(outPin, false);
+    delayMicroseconds(50);
+
+    isrFired = false;
+    isrStartCycles = diagCycleCount();
+    gpioBenchWrite(outPin, true);
+
+    unsigned long waitStart = micros();
+    while (!isrFired && (micros() - waitStart) < 1000) {
+      // busy wait: the ISR runs on this core
+    }
+
+    if (isrFired) {
+      latencySamples[count++] = isrLatencyCycles;
+    } else {
+      missed++;
+    }
+
+    if ((i & 0x1F) == 0x1F) {
+      vTaskDelay(1);  // Laisse respirer le watchdog et la pile réseau
+    }
+  }
+  gpioBenchWrite(outPin, false);
+
+  stats = GPIOLatencyStats();
+  stats.samples = count;
+  stats.missed = missed;
+  if (count == 0) return;
+
+  std::sort(latencySamples, latencySamples + count);
+  uint64_t sum = 0;
+  for (uint16_t i = 0; i < count; i++) {
+    sum += latencySamples[i];
+  }
+  uint16_t p99Index = (uint16_t)(((uint32_t)count * 99 + 99) / 100) - 1;
+  stats.minCycles = latencySamples[0];
+  stats.maxCycles = latencySamples[count - 1];
+  stats.avgCycles = (uint32_t)(sum / count);
+  stats.p99Cycles = latencySamples[p99Index];
+}
+
+static void udpLoadTask(void* parameters) {
+  (void)parameters;
+  WiFiUDP udp;
+  uint8_t payload[GPIO_BENCH_UDP_PAYLOAD];
+  memset(payload, 0xA5, sizeof(payload));
+  IPAddress target = WiFi.gatewayIP();
+
+  while (udpLoadRunning) {
+    // UDP discard port: the gateway drops the datagrams, the radio stays busy
+    if (udp.beginPacket(target, 9) && udp.write(payload, sizeof(payload)) == sizeof(payload) && udp.endPacket()) {
+      udpLoadPackets++;
+    } else {
+      vTaskDelay(1);
+    }
+  }
+
+  udp.stop();
+  udpLoadTaskHandle = nullptr;
+  vTaskDelete(nullptr);
+}
+
+static bool startUDPLoad() {
+  if (WiFi.status() != WL_CONNECTED) return false;
+  udpLoadPackets = 0;
+  udpLoadRunning = true;
+  if (xTaskCreatePinnedToCore(udpLoadTask, "GPIOBenchLoad", 4096, nullptr, 1,
+                              &udpLoadTaskHandle, tskNO_AFFINITY) != pdPASS) {
+    udpLoadRunning = false;
+    udpLoadTaskHandle = nullptr;
+    return false;
+  }
+  vTaskDelay(pdMS_TO_TICKS(200));  // Laisse la charge s'établir
+  return true;
+}
+
+static void stopUDPLoad() {
+  udpLoadRunning = false;
+  unsigned long start = millis();
+  while (udpLoadTaskHandle != nullptr && (millis() - start) < 1000) {
+    vTaskDelay(pdMS_TO_TICKS(10));
+  }
+}
+
+void runGPIOBenchmark() {
+  GPIOBenchmarkData result;
+  result.outPin = GPIO_BENCH_OUT_PIN;
+  result.inPin = GPIO_BENCH_IN_PIN;
+  result.cpuMhz = getCpuFrequencyMhz();
+  result.iterations = GPIO_BENCH_TOGGLE_ITERATIONS;
+
+  if (result.outPin < 0) {
+    gpioBenchmarkTestResult = "Output pin not configured";
+    gpioBenchmarkData = result;
+    return;
+  }
+
+  gpioBenchmarkTestResult = "Running...";
+  unsigned long startMs = millis();
+  const int outPin = result.outPin;
+  const uint32_t iterations = result.iterations;
+
+  Serial.printf("[GPIO Bench] Toggle GPIO %d x%lu\r\n", outPin, (unsigned long)iterations);
+  pinMode(outPin, OUTPUT);
+
+  uint32_t cycles = measureToggleCycles(iterations, [outPin](bool high) {
+    digitalWrite(outPin, high ? HIGH : LOW);
+  });
+  result.digitalWriteKHz = cyclesToToggleKHz(cycles, iterations, result.cpuMhz);
+
+  cycles = measureToggleCycles(iterations, [outPin](bool high) {
+    gpio_set_level((gpio_num_t)outPin, high ? 1 : 0);
+  });
+  result.gpioSetLevelKHz = cyclesToToggleKHz(cycles, iterations, result.cpuMhz);
+
+  cycles = measureToggleCycles(iterations, [outPin](bool high) {
+    gpioBenchWrite(outPin, high);
+  });
+  result.registerKHz = cyclesToToggleKHz(cycles, iterations, result.cpuMhz);
+
+  Serial.printf("[GPIO Bench] digitalWrite %.1f kHz | gpio_set_level %.1f kHz | registre %.1f kHz\r\n",
+                result.digitalWriteKHz, result.gpioSetLevelKHz, result.registerKHz);
+
+  if (result.inPin >= 0) {
+    pinMode(result.inPin, INPUT);
+    digitalWrite(outPin, HIGH);
+    delayMicroseconds(10);
+    bool highSeen = digitalRead(result.inPin) == HIGH;
+    digitalWrite(outPin, LOW);
+    delayMicroseconds(10);
+    bool lowSeen = digitalRead(result.inPin) == LOW;
+    result.loopbackDetected = highSeen && lowSeen;
+  }
+
+  if (result.loopbackDetected) {
+    // attachInterrupt depuis cette tâche : l'ISR est allouée sur le même coeur,
+    // donc les compteurs de cycles de départ et d'arrivée sont comparables
+    attachInterrupt(digitalPinToInterrupt(result.inPin), gpioBenchISR, RISING);
+
+    measureISRLatency(outPin, result.idle);
+
+    result.loadActive = startUDPLoad();
+    if (result.loadActive) {
+      measureISRLatency(outPin, result.loaded);
+      stopUDPLoad();
+      result.loadPackets = udpLoadPackets;
+    }
+
+    detachInterrupt(digitalPinToInterrupt(result.inPin));
+    Serial.printf("[GPIO Bench] ISR idle min/avg/p99 = %lu/%lu/%lu cycles\r\n",
+                  (unsigned long)result.idle.minCycles,
+                  (unsigned long)result.idle.avgCycles,
+                  (unsigned long)result.idle.p99Cycles);
+    if (result.loadActive) {
+      Serial.printf("[GPIO Bench] ISR load min/avg/p99 = %lu/%lu/%lu cycles (%lu UDP packets)\r\n",
+                    (unsigned long)result.loaded.minCycles,
+                    (unsigned long)result.loaded.avgCycles,
+                    (unsigned long)result.loaded.p99Cycles,
+                    (unsigned long)result.loadPackets);
+    }
+  }
+
+  pinMode(outPin, INPUT);
+
+  result.durationMs = millis() - startMs;
+  result.completed = true;
+  gpioBenchmarkData = result;
+
+  if (result.inPin < 0) {
+    gpioBenchmarkTestResult = "OK (toggle only, no loopback pin)";
+  } else if (!result.loopbackDetected) {
+    gpioBenchmarkTestResult = "OK (toggle only, loopback not wired)";
+  } else if (!result.loadActive) {
+    gpioBenchmarkTestResult = "OK (Wi-Fi offline, no load pass)";
+  } else {
+    gpioBenchmarkTestResult = "OK";
+  }
+}
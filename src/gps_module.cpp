@@ -4,31 +4,47 @@
 
 #include "gps_module.h"
 #include "config.h"
+#include "gps_time.h"
+#include "ubx_protocol.h"
 #include <cmath>
+#include <stdlib.h>
+#include <string.h>
+
+#define GPS_GSV_MAX_FIELDS 24   // 4 header fields, 4 satellites x 4, signal ID
+#define GPS_GSA_MAX_FIELDS 20   // 3 header fields, 12 PRNs, PDOP/HDOP/VDOP, system ID
 
 // Global GPS variables
 GPSData gpsData;
+GPSSkyView gpsSkyView;
+GPSProtocolStatus gpsProtocolStatus;
 HardwareSerial& gpsSerial = Serial1;
 String gpsTestResult = "Not tested";
 bool gpsAvailable = false;
 
+static UBXDecoder ubxDecoder;
+static void handleUBXFrame();
+
 // GPS UART Configuration
 void initGPS() {
-  #if defined(PIN_GPS_RXD) && defined(PIN_GPS_TXD) && PIN_GPS_RXD >= 0 && PIN_GPS_TXD >= 0
-    Serial.printf("Initializing GPS on RX=%d TX=%d\r\n", PIN_GPS_RXD, PIN_GPS_TXD);
+  #if defined(GPS_RXD_PIN) && defined(GPS_TXD_PIN) && GPS_RXD_PIN >= 0 && GPS_TXD_PIN >= 0
+    Serial.printf("Initializing GPS on RX=%d TX=%d\r\n", GPS_RXD_PIN, GPS_TXD_PIN);
     
     // Initialize UART1 for GPS
-    gpsSerial.begin(9600, SERIAL_8N1, PIN_GPS_RXD, PIN_GPS_TXD);
+    gpsSerial.begin(GPS_NMEA_BAUD, SERIAL_8N1, GPS_RXD_PIN, GPS_TXD_PIN);
     gpsSerial.setRxBufferSize(2048);  // Increased buffer for NMEA sentences
     
-    // Setup PPS interrupt if available
-    #if defined(PIN_GPS_PPS) && PIN_GPS_PPS >= 0
-      pinMode(PIN_GPS_PPS, INPUT);
-      Serial.printf("GPS PPS signal on GPIO %d\r\n", PIN_GPS_PPS);
+    // PPS timing service if the receiver's PPS output is wired
+    #if ENABLE_GPS_PPS && defined(GPS_PPS_PIN) && GPS_PPS_PIN >= 0
+      beginGPSTime(GPS_PPS_PIN);
+      Serial.printf("GPS PPS signal on GPIO %d\r\n", GPS_PPS_PIN);
     #endif
     
     gpsAvailable = true;
+    resetGPSSkyView();
     delay(100);
+    #if ENABLE_GPS_UBX
+      startGPSUbx(GPS_UBX_BAUD, GPS_UBX_RATE_HZ);
+    #endif
   #else
     Serial.println("GPS: Pins not configured correctly");
     gpsAvailable = false;
@@ -42,6 +58,15 @@ void updateGPS() {
   while (gpsSerial.available()) {
     char c = gpsSerial.read();
     
+    // Trames UBX binaires : le décodeur garde leurs octets, le reste est du texte NMEA
+    UBXPushResult ubx = ubxDecoder.push((uint8_t)c);
+    if (ubx == UBX_PUSH_FRAME) {
+      handleUBXFrame();
+      continue;
+    } else if (ubx != UBX_PUSH_IDLE) {
+      continue;
+    }
+    
     // Very simple line buffer (no external library used)
     static String nmea_line;
     
@@ -49,15 +74,16 @@ void updateGPS() {
       nmea_line.trim();
       
       if (nmea_line.length() > 0 && nmea_line[0] == '$') {
+        gpsProtocolStatus.nmeaSentences++;
         // Parse different NMEA sentence types
         if (nmea_line.startsWith("$GPRMC") || nmea_line.startsWith("$GNRMC")) {
           parseGPRMC(nmea_line);
         } else if (nmea_line.startsWith("$GPGGA") || nmea_line.startsWith("$GNGGA")) {
           parseGPGGA(nmea_line);
-        } else if (nmea_line.startsWith("$GPGSA") || nmea_line.startsWith("$GNGSA")) {
-          parseGPGSA(nmea_line);
-        } else if (nmea_line.startsWith("$GPGSV") || nmea_line.startsWith("$GNGSV")) {
-          parseGPGSV(nmea_line);
+        } else if (nmea_line.length() >= 6 && strncmp(nmea_line.c_str() + 3, "GSA", 3) == 0) {
+          parseGPGSA(nmea_line.c_str());
+        } else if (nmea_line.length() >= 6 && strncmp(nmea_line.c_str() + 3, "GSV", 3) == 0) {
+          parseGPGSV(nmea_line.c_str());
         }
       }
       
@@ -69,6 +95,31 @@ void updateGPS() {
       nmea_line += c;
     }
   }
+  
+  gpsProtocolStatus.ubxFrames = ubxDecoder.frames;
+  gpsProtocolStatus.ubxChecksumErrors = ubxDecoder.checksumErrors;
+  gpsProtocolStatus.ubxOversize = ubxDecoder.oversizeFrames;
+}
+
+static bool fixHeld = false;
+static uint32_t fixLostMs = 0;
+static uint32_t dopUpdatedMs = 0;               // Dernier HDOP reçu (GGA, GSA ou NAV-DOP)
+
+// Temps jusqu'au premier fix (depuis initGPS) puis durée de chaque réacquisition
+static void updateFixState() {
+  uint32_t now = millis();
+  if (gpsData.hasFix && !fixHeld) {
+    if (gpsSkyView.ttffMs == 0) {
+      gpsSkyView.ttffMs = now - gpsSkyView.startMs;
+      if (gpsSkyView.ttffMs == 0) gpsSkyView.ttffMs = 1;  // 0 réservé à « pas encore de fix »
+    } else {
+      gpsSkyView.reacquireMs = now - fixLostMs;
+    }
+  } else if (!gpsData.hasFix && fixHeld) {
+    gpsSkyView.fixLosses++;
+    fixLostMs = now;
+  }
+  fixHeld = gpsData.hasFix;
 }
 
 // Parse RMC sentence: $GPRMC,time,status,lat,N/S,lon,E/W,speed,course,date...
@@ -96,11 +147,13 @@ void parseGPRMC(const String& sentence) {
   if (!active) {
     gpsData.hasFix = false;
     gpsData.status_str = "No Fix";
+    updateFixState();
     return;
   }
   
   gpsData.hasFix = true;
   gpsData.status_str = "Fix";
+  updateFixState();
   
   // Parse time HHMMSS.SS
   if (fields[1].length() >= 6) {
@@ -140,6 +193,12 @@ void parseGPRMC(const String& sentence) {
     gpsData.month = fields[9].substring(2, 4).toInt();
     gpsData.year = 2000 + fields[9].substring(4, 6).toInt();
     gpsData.hasDate = true;
+    
+    // Seconde ronde (hhmmss.00) : étiquette UTC du dernier front PPS
+    if (fields[1].length() >= 6 && fields[1].substring(6).toFloat() == 0.0f) {
+      gpsTimeOnUtc(gpsUnixTime(gpsData.year, gpsData.month, gpsData.day,
+                               gpsData.hour, gpsData.minute, gpsData.second), millis());
+    }
   }
 }
 
@@ -164,6 +223,7 @@ void parseGPGGA(const String& sentence) {
   // Quality: 0=invalid, 1=GPS, 2=DGPS, 3=PPS, 4=RTK, 5=Float RTK, 6=Estimated, 7=Manual, 8=Simulation
   int quality = fields[6].toInt();
   gpsData.hasFix = (quality > 0);
+  updateFixState();
   
   // Number of satellites
   if (fields[7].length() > 0) {
@@ -173,6 +233,7 @@ void parseGPGGA(const String& sentence) {
   // HDOP (Horizontal Dilution of Precision)
   if (fields[8].length() > 0) {
     gpsData.hdop = fields[8].toFloat();
+    dopUpdatedMs = millis();
   }
   
   // Altitude above sea level
@@ -194,26 +255,123 @@ void parseGPGGA(const String& sentence) {
   }
 }
 
-// Parse GSA sentence: $GPGSA,mode,fix_type,sat_ids...,pdop,hdop,vdop
-void parseGPGSA(const String& sentence) {
-  int start = 0;
-  int field = 0;
-  String fields[20];
-  
-  // Split by comma
-  for (int i = 0; i < sentence.length(); i++) {
-    if (sentence[i] == ',' || sentence[i] == '*') {
-      fields[field] = sentence.substring(start, i);
-      start = i + 1;
-      field++;
-      if (field >= 20) break;
+// Début de chaque champ, sans copie : les conversions (atoi, strtod) s'arrêtent à la virgule
+static uint8_t splitNMEAFields(const char* sentence, const char** fields, uint8_t maxFields) {
+  uint8_t count = 0;
+  fields[count++] = sentence;
+  for (const char* p = sentence; *p && *p != '*' && count < maxFields; p++) {
+    if (*p == ',') {
+      fields[count++] = p + 1;
+    }
+  }
+  return count;
+}
+
+static bool nmeaFieldEmpty(const char* field) {
+  return *field == ',' || *field == '*' || *field == '\0';
+}
+
+GPSConstellation gpsConstellationFromTalker(const char* sentence) {
+  if (sentence[0] != '$' || sentence[1] == '\0') {
+    return GPS_SYSTEM_UNKNOWN;
+  }
+  char a = sentence[1];
+  char b = sentence[2];
+  if (a == 'G' && b == 'P') return GPS_SYSTEM_GPS;
+  if (a == 'G' && b == 'L') return GPS_SYSTEM_GLONASS;
+  if (a == 'G' && b == 'A') return GPS_SYSTEM_GALILEO;
+  if ((a == 'G' && b == 'B') || (a == 'B' && b == 'D')) return GPS_SYSTEM_BEIDOU;
+  if ((a == 'G' && b == 'Q') || (a == 'Q' && b == 'Z')) return GPS_SYSTEM_QZSS;
+  return GPS_SYSTEM_UNKNOWN;
+}
+
+// Numérotation u-blox NMEA 4.0 (talker GN sans ID de système)
+GPSConstellation gpsConstellationFromPRN(uint16_t prn) {
+  if (prn >= 1 && prn <= 64) return GPS_SYSTEM_GPS;
+  if (prn >= 65 && prn <= 96) return GPS_SYSTEM_GLONASS;
+  if (prn >= 193 && prn <= 200) return GPS_SYSTEM_QZSS;
+  if ((prn >= 201 && prn <= 263) || (prn >= 401 && prn <= 463)) return GPS_SYSTEM_BEIDOU;
+  if (prn >= 301 && prn <= 336) return GPS_SYSTEM_GALILEO;
+  return GPS_SYSTEM_UNKNOWN;
+}
+
+const char* gpsConstellationName(GPSConstellation system) {
+  switch (system) {
+    case GPS_SYSTEM_GPS: return "gps";
+    case GPS_SYSTEM_GLONASS: return "glonass";
+    case GPS_SYSTEM_GALILEO: return "galileo";
+    case GPS_SYSTEM_BEIDOU: return "beidou";
+    case GPS_SYSTEM_QZSS: return "qzss";
+    default: return "unknown";
+  }
+}
+
+// Satellites listés par le dernier GSA de chaque constellation
+struct GPSUsedSatellite {
+  uint16_t prn;
+  GPSConstellation system;
+};
+static GPSUsedSatellite usedSatellites[GPS_MAX_SATELLITES];
+static uint8_t usedCount = 0;
+
+static void removeUsedSatellites(GPSConstellation system) {
+  uint8_t kept = 0;
+  for (uint8_t i = 0; i < usedCount; i++) {
+    if (usedSatellites[i].system != system) usedSatellites[kept++] = usedSatellites[i];
+  }
+  usedCount = kept;
+}
+
+static bool satelliteUsed(const GPSSatellite& sat) {
+  for (uint8_t i = 0; i < usedCount; i++) {
+    if (usedSatellites[i].prn == sat.prn && usedSatellites[i].system == sat.system) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static void refreshSkyViewStats() {
+  GPSSkyView& sky = gpsSkyView;
+  uint16_t snrSum = 0;
+  sky.tracked = 0;
+  sky.maxSnr = 0;
+  for (uint8_t i = 0; i < sky.count; i++) {
+    GPSSatellite& sat = sky.satellites[i];
+    sat.usedInFix = satelliteUsed(sat);
+    if (sat.snr > 0) {
+      sky.tracked++;
+      snrSum += sat.snr;
+      if (sat.snr > sky.maxSnr) sky.maxSnr = sat.snr;
+    }
+  }
+  sky.meanSnr = sky.tracked ? (uint8_t)((snrSum + sky.tracked / 2) / sky.tracked) : 0;
+  sky.used = usedCount;
+  gpsData.satellites_used = usedCount;
+  gpsData.satellites_in_view = sky.count;
+}
+
+// Retire d'une table les satellites d'une constellation (toutes si UNKNOWN)
+static void removeSatellites(GPSSatellite* table, uint8_t& count, GPSConstellation system) {
+  uint8_t kept = 0;
+  for (uint8_t i = 0; i < count; i++) {
+    if (system != GPS_SYSTEM_UNKNOWN && table[i].system != system) {
+      table[kept++] = table[i];
     }
   }
+  count = kept;
+}
+
+// Parse GSA sentence: $GPGSA,mode,fix_type,sat_ids(12),pdop,hdop,vdop[,system_id]
+void parseGPGSA(const char* sentence) {
+  const char* fields[GPS_GSA_MAX_FIELDS];
+  uint8_t field = splitNMEAFields(sentence, fields, GPS_GSA_MAX_FIELDS);
   
   if (field < 3) return;
+  gpsSkyView.gsaSentences++;
   
   // Fix type: 1=no fix, 2=2D, 3=3D
-  int fix_type = fields[2].toInt();
+  int fix_type = atoi(fields[2]);
   if (fix_type == 1) {
     gpsData.fix_type = "No Fix";
   } else if (fix_type == 2) {
@@ -222,47 +380,412 @@ void parseGPGSA(const String& sentence) {
     gpsData.fix_type = "3D";
   }
   
-  // Count satellites used (fields 3-14)
-  gpsData.satellites_used = 0;
-  for (int i = 3; i < 15 && i < field; i++) {
-    if (fields[i].length() > 0) {
-      gpsData.satellites_used++;
-    }
+  // Constellation : ID de système NMEA 4.10, sinon talker, sinon premier PRN (GNGSA NMEA 4.0)
+  GPSConstellation system = GPS_SYSTEM_UNKNOWN;
+  if (field > 18 && !nmeaFieldEmpty(fields[18])) {
+    int id = atoi(fields[18]);
+    if (id > 0 && id < GPS_SYSTEM_COUNT) system = (GPSConstellation)id;
+  }
+  if (system == GPS_SYSTEM_UNKNOWN) {
+    system = gpsConstellationFromTalker(sentence);
+  }
+  if (system == GPS_SYSTEM_UNKNOWN && field > 3 && !nmeaFieldEmpty(fields[3])) {
+    system = gpsConstellationFromPRN(atoi(fields[3]));
   }
   
-  // PDOP, HDOP, VDOP (usually last 3 fields)
-  if (field >= 17) {
-    if (fields[field - 3].length() > 0) gpsData.pdop = fields[field - 3].toFloat();
-    if (fields[field - 2].length() > 0) gpsData.hdop = fields[field - 2].toFloat();
-    if (fields[field - 1].length() > 0) gpsData.vdop = fields[field - 1].toFloat();
+  // Un GSA par constellation et par époque : il remplace la liste de cette constellation
+  if (fix_type == 1) {
+    usedCount = 0;
+  } else if (system != GPS_SYSTEM_UNKNOWN) {
+    removeUsedSatellites(system);
+  }
+  
+  // Satellites used (fields 3-14)
+  for (int i = 3; i < 15 && i < field && usedCount < GPS_MAX_SATELLITES; i++) {
+    if (nmeaFieldEmpty(fields[i])) continue;
+    uint16_t prn = atoi(fields[i]);
+    usedSatellites[usedCount].prn = prn;
+    usedSatellites[usedCount].system = system != GPS_SYSTEM_UNKNOWN ? system : gpsConstellationFromPRN(prn);
+    usedCount++;
+  }
+  refreshSkyViewStats();
+  
+  // PDOP, HDOP, VDOP (fields 15-17, before the optional system ID)
+  if (field >= 18) {
+    if (!nmeaFieldEmpty(fields[15])) gpsData.pdop = strtod(fields[15], nullptr);
+    if (!nmeaFieldEmpty(fields[16])) {
+      gpsData.hdop = strtod(fields[16], nullptr);
+      dopUpdatedMs = millis();
+    }
+    if (!nmeaFieldEmpty(fields[17])) gpsData.vdop = strtod(fields[17], nullptr);
   }
 }
 
-// Parse GSV sentence: $GPGSV,total_msgs,msg_num,satellites_visible,sat_id,elevation,azimuth,snr...
-void parseGPGSV(const String& sentence) {
-  int start = 0;
-  int field = 0;
-  String fields[25];
-  
-  // Split by comma
-  for (int i = 0; i < sentence.length(); i++) {
-    if (sentence[i] == ',' || sentence[i] == '*') {
-      fields[field] = sentence.substring(start, i);
-      start = i + 1;
-      field++;
-      if (field >= 25) break;
+// Rafale GSV en cours d'assemblage (une constellation, jusqu'à 9 phrases)
+static GPSSatellite burstSatellites[GPS_MAX_SATELLITES];
+static uint8_t burstCount = 0;
+static uint8_t burstTotal = 0;
+static uint8_t burstNext = 0;                  // 0 = pas de rafale en cours
+static GPSConstellation burstSystem = GPS_SYSTEM_UNKNOWN;
+static uint32_t systemUpdatedMs[GPS_SYSTEM_COUNT];
+
+// Signal principal par constellation (NMEA 4.10) : L1 C/A, G1, E1, B1I, L1 C/A
+static const uint8_t primarySignal[GPS_SYSTEM_COUNT] = {0, 1, 1, 7, 1, 1};
+
+static void commitGSVBurst() {
+  GPSSkyView& sky = gpsSkyView;
+  uint32_t now = millis();
+  // GN : rafale toutes constellations, elle remplace la table entière
+  removeSatellites(sky.satellites, sky.count, burstSystem);
+  for (uint8_t s = GPS_SYSTEM_GPS; s < GPS_SYSTEM_COUNT; s++) {
+    if (systemUpdatedMs[s] && now - systemUpdatedMs[s] > GPS_SKYVIEW_TIMEOUT_MS) {
+      removeSatellites(sky.satellites, sky.count, (GPSConstellation)s);
+      removeUsedSatellites((GPSConstellation)s);
+      systemUpdatedMs[s] = 0;
     }
   }
+  for (uint8_t i = 0; i < burstCount && sky.count < GPS_MAX_SATELLITES; i++) {
+    sky.satellites[sky.count++] = burstSatellites[i];
+  }
+  if (burstSystem != GPS_SYSTEM_UNKNOWN) {
+    systemUpdatedMs[burstSystem] = now;
+  }
+  sky.updatedMs = now ? now : 1;
+  sky.gsvBursts++;
+  refreshSkyViewStats();
+}
+
+// Parse GSV sentence: $GPGSV,total_msgs,msg_num,satellites_visible,{sat_id,elevation,azimuth,snr}x4[,signal_id]
+void parseGPGSV(const char* sentence) {
+  const char* fields[GPS_GSV_MAX_FIELDS];
+  uint8_t field = splitNMEAFields(sentence, fields, GPS_GSV_MAX_FIELDS);
   
   if (field < 4) return;
   
-  // Satellites in view (field 3)
-  if (fields[3].length() > 0) {
-    // Store if this is the first GSV message (more accurate for visible satellites)
-    if (fields[2] == "1") {
-      // This is first message, we can use this count as total visible
+  int total = atoi(fields[1]);
+  int number = atoi(fields[2]);
+  if (total < 1 || number < 1 || number > total) return;
+  
+  // Champ final isolé après les groupes de 4 : ID de signal (NMEA 4.10)
+  uint8_t groups = (field - 4) / 4;
+  GPSConstellation system = gpsConstellationFromTalker(sentence);
+  if ((field - 4) % 4 == 1 && system != GPS_SYSTEM_UNKNOWN) {
+    const char* signal = fields[field - 1];
+    int id = nmeaFieldEmpty(signal) ? 0 : (int)strtol(signal, nullptr, 16);
+    // Signal secondaire (L5, E5b...) : mêmes satellites, on garde le principal
+    if (id != 0 && id != primarySignal[system]) return;
+  }
+  
+  if (number == 1) {
+    burstSystem = system;
+    burstTotal = total;
+    burstCount = 0;
+  } else if (number != burstNext || total != burstTotal || system != burstSystem) {
+    // Phrase perdue ou rafales entrelacées : la rafale incomplète est abandonnée
+    if (burstNext != 0) gpsSkyView.gsvErrors++;
+    burstNext = 0;
+    return;
+  }
+  
+  for (uint8_t g = 0; g < groups && burstCount < GPS_MAX_SATELLITES; g++) {
+    const char* const* sat = fields + 4 + g * 4;
+    if (nmeaFieldEmpty(sat[0])) continue;
+    GPSSatellite& entry = burstSatellites[burstCount++];
+    entry.prn = atoi(sat[0]);
+    entry.system = system != GPS_SYSTEM_UNKNOWN ? system : gpsConstellationFromPRN(entry.prn);
+    entry.elevation = nmeaFieldEmpty(sat[1]) ? -1 : atoi(sat[1]);
+    entry.azimuth = nmeaFieldEmpty(sat[2]) ? -1 : atoi(sat[2]);
+    entry.snr = nmeaFieldEmpty(sat[3]) ? 0 : atoi(sat[3]);
+    entry.usedInFix = false;
+  }
+  
+  if (number == total) {
+    commitGSVBurst();
+    burstNext = 0;
+  } else {
+    burstNext = number + 1;
+  }
+}
+
+// ========== UBX MODE ==========
+#define UBX_PROTO_UBX 0x01
+#define UBX_PROTO_NMEA 0x02
+
+static uint32_t ubxTargetBaud = GPS_UBX_BAUD;
+static uint8_t ubxConfigStep = 0;      // 0 = CFG-PRT envoyé à l'ancien débit, 1 = configuration envoyée
+
+const char* gpsProtocolName(GPSProtocol protocol) {
+  switch (protocol) {
+    case GPS_PROTOCOL_UBX_CONFIG: return "ubx_config";
+    case GPS_PROTOCOL_UBX: return "ubx";
+    default: return "nmea";
+  }
+}
+
+static void sendUBX(uint8_t cls, uint8_t id, const uint8_t* payload, uint16_t length) {
+  uint8_t frame[UBX_FRAME_OVERHEAD + 20];
+  size_t size = ubxBuildFrame(cls, id, payload, length, frame);
+  gpsSerial.write(frame, size);
+}
+
+// CFG-PRT : UART1 du récepteur en 8N1, entrées UBX + NMEA, sorties au choix
+static void sendCfgPrt(uint32_t baud, uint8_t outProto) {
+  uint8_t payload[20] = {0};
+  payload[0] = 1;
+  payload[4] = 0xD0;
+  payload[5] = 0x08;
+  for (uint8_t i = 0; i < 4; i++) {
+    payload[8 + i] = (baud >> (8 * i)) & 0xFF;
+  }
+  payload[12] = UBX_PROTO_UBX | UBX_PROTO_NMEA;
+  payload[14] = outProto;
+  sendUBX(UBX_CLASS_CFG, UBX_CFG_PRT, payload, sizeof(payload));
+}
+
+// CFG-RATE : une solution par mesure, temps GPS
+static void sendCfgRate(uint16_t measureMs) {
+  uint8_t payload[6] = {(uint8_t)(measureMs & 0xFF), (uint8_t)(measureMs >> 8), 1, 0, 1, 0};
+  sendUBX(UBX_CLASS_CFG, UBX_CFG_RATE, payload, sizeof(payload));
+}
+
+// CFG-MSG : un message toutes les `rate` solutions sur le port courant
+static void sendCfgMsg(uint8_t cls, uint8_t id, uint8_t rate) {
+  uint8_t payload[3] = {cls, id, rate};
+  sendUBX(UBX_CLASS_CFG, UBX_CFG_MSG, payload, sizeof(payload));
+}
+
+static void setGPSBaud(uint32_t baud) {
+  gpsSerial.flush();
+  gpsSerial.updateBaudRate(baud);
+  gpsProtocolStatus.baud = baud;
+  ubxDecoder.reset();
+}
+
+static void fallbackToNMEA(const char* reason) {
+  GPSProtocolStatus& link = gpsProtocolStatus;
+  // Comme stopGPSUbx() : CFG-PRT au débit courant avant de changer celui de l'ESP32, sinon un
+  // récepteur encore vivant reste en UBX seul à l'ancien débit. Trames NAV coupées : un NAV-PVT
+  // reçu en mode NMEA ferait repasser le lien en UBX
+  sendCfgMsg(UBX_CLASS_NAV, UBX_NAV_PVT, 0);
+  sendCfgMsg(UBX_CLASS_NAV, UBX_NAV_SAT, 0);
+  sendCfgMsg(UBX_CLASS_NAV, UBX_NAV_DOP, 0);
+  sendCfgPrt(GPS_NMEA_BAUD, UBX_PROTO_UBX | UBX_PROTO_NMEA);
+  if (link.baud != GPS_NMEA_BAUD) {
+    setGPSBaud(GPS_NMEA_BAUD);
+  }
+  link.protocol = GPS_PROTOCOL_NMEA;
+  link.fallbacks++;
+  snprintf(link.fallbackReason, sizeof(link.fallbackReason), "%s", reason);
+  Serial.printf("[GPS] UBX indisponible (%s) : retour en NMEA à %d bauds\r\n", reason, GPS_NMEA_BAUD);
+}
+
+bool startGPSUbx(uint32_t baud, uint8_t rateHz) {
+  if (!gpsAvailable) {
+    return false;
+  }
+  GPSProtocolStatus& link = gpsProtocolStatus;
+  link.rateHz = rateHz < 1 ? 1 : (rateHz > GPS_UBX_MAX_RATE_HZ ? GPS_UBX_MAX_RATE_HZ : rateHz);
+  link.configAcks = 0;
+  link.configNaks = 0;
+  ubxTargetBaud = baud;
+  // Sorties UBX seules : le NMEA s'arrête avant même le changement de débit
+  sendCfgPrt(baud, UBX_PROTO_UBX);
+  gpsSerial.flush();
+  link.protocol = GPS_PROTOCOL_UBX_CONFIG;
+  link.configStartMs = millis();
+  ubxConfigStep = 0;
+  return true;
+}
+
+void stopGPSUbx() {
+  GPSProtocolStatus& link = gpsProtocolStatus;
+  if (!gpsAvailable || (link.protocol == GPS_PROTOCOL_NMEA && link.baud == GPS_NMEA_BAUD)) {
+    return;
+  }
+  sendCfgRate(1000);
+  sendCfgPrt(GPS_NMEA_BAUD, UBX_PROTO_NMEA);
+  setGPSBaud(GPS_NMEA_BAUD);
+  link.protocol = GPS_PROTOCOL_NMEA;
+}
+
+void maintainGPS() {
+  GPSProtocolStatus& link = gpsProtocolStatus;
+  if (!gpsAvailable) {
+    return;
+  }
+  maintainGPSTime();
+  gpsData.hasPPS = gpsTimeStatus.state == GPS_TIME_PPS || gpsTimeStatus.state == GPS_TIME_LOCKED;
+  // NMEA à 9600 bauds : lu à la demande (handlers, journaux), le tampon RX couvre ~2 s,
+  // sauf avec le PPS : l'heure RMC doit être lue dans la seconde qu'elle étiquette
+  if (link.protocol == GPS_PROTOCOL_NMEA) {
+    if (gpsTimeStatus.running) {
+      updateGPS();
+    }
+    return;
+  }
+  updateGPS();
+  uint32_t now = millis();
+  if (link.protocol == GPS_PROTOCOL_UBX_CONFIG) {
+    if (ubxConfigStep == 0) {
+      if (now - link.configStartMs < GPS_UBX_SWITCH_MS) {
+        return;
+      }
+      setGPSBaud(ubxTargetBaud);
+      // CFG-PRT répété au nouveau débit : récepteur déjà configuré (redémarrage de l'ESP32 seul)
+      sendCfgPrt(ubxTargetBaud, UBX_PROTO_UBX);
+      sendCfgRate(1000 / link.rateHz);
+      sendCfgMsg(UBX_CLASS_NAV, UBX_NAV_PVT, 1);
+      sendCfgMsg(UBX_CLASS_NAV, UBX_NAV_SAT, link.rateHz);   // Une table des satellites par seconde
+      sendCfgMsg(UBX_CLASS_NAV, UBX_NAV_DOP, link.rateHz);   // HDOP/VDOP : NAV-PVT ne donne que le PDOP
+      ubxConfigStep = 1;
+      link.configStartMs = now;
+    } else if (now - link.configStartMs > GPS_UBX_TIMEOUT_MS) {
+      fallbackToNMEA(link.configAcks ? "no_nav" : "no_ack");
+    }
+  } else if (now - link.lastNavMs > GPS_UBX_TIMEOUT_MS) {
+    fallbackToNMEA("timeout");
+  }
+}
+
+// Numérotation NMEA 4.10 pour rester cohérent avec les rafales GSV (GLONASS 65-96, SBAS 33-64)
+static bool ubxSatelliteId(uint8_t gnssId, uint8_t svId, GPSConstellation& system, uint16_t& prn) {
+  prn = svId;
+  switch (gnssId) {
+    case 0: system = GPS_SYSTEM_GPS; return true;
+    case 1: system = GPS_SYSTEM_GPS; prn = svId >= 120 ? svId - 87 : svId; return true;
+    case 2: system = GPS_SYSTEM_GALILEO; return true;
+    case 3: system = GPS_SYSTEM_BEIDOU; return true;
+    case 5: system = GPS_SYSTEM_QZSS; return true;
+    case 6: system = GPS_SYSTEM_GLONASS; prn = svId + 64; return svId != 255;
+    default: return false;
+  }
+}
+
+// NAV-PVT : position, vitesse, heure et qualité du fix en une trame par solution
+static void applyNavPvt(const uint8_t* p) {
+  GPSProtocolStatus& link = gpsProtocolStatus;
+  uint32_t now = millis();
+  if (link.lastNavMs) {
+    link.navIntervalMs = now - link.lastNavMs;
+  }
+  link.lastNavMs = now;
+  link.navPvt++;
+  // Récepteur déjà en UBX (configuration sauvegardée) : mode détecté sans configuration
+  if (link.protocol == GPS_PROTOCOL_NMEA || (link.protocol == GPS_PROTOCOL_UBX_CONFIG && ubxConfigStep == 1)) {
+    link.protocol = GPS_PROTOCOL_UBX;
+  }
+  
+  uint8_t valid = p[11];
+  uint8_t fixType = p[20];
+  bool fixOk = (p[21] & 0x01) && fixType >= 2 && fixType <= 4;
+  gpsData.valid = fixOk;
+  gpsData.hasFix = fixOk;
+  gpsData.status_str = fixOk ? "GPS Fix" : "No Fix";
+  gpsData.fix_type = fixType == 2 ? "2D" : (fixType == 3 || fixType == 4) ? "3D" : "No Fix";
+  gpsData.satellites = p[23];
+  
+  if (valid & 0x02) {
+    gpsData.hour = p[8];
+    gpsData.minute = p[9];
+    gpsData.second = p[10];
+    gpsData.hasTime = true;
+  }
+  if (valid & 0x01) {
+    gpsData.year = ubxU2(p + 4);
+    gpsData.month = p[6];
+    gpsData.day = p[7];
+    gpsData.hasDate = true;
+  }
+  // Solution calée sur la seconde (nano ~0), date et heure résolues : étiquette du front PPS
+  int32_t nano = ubxI4(p + 16);
+  if ((valid & 0x07) == 0x07 && nano > -50000000 && nano < 50000000) {
+    gpsTimeOnUtc(gpsUnixTime(ubxU2(p + 4), p[6], p[7], p[8], p[9], p[10]), millis());
+  }
+  if (fixOk) {
+    gpsData.longitude = (float)(ubxI4(p + 24) * 1e-7);
+    gpsData.latitude = (float)(ubxI4(p + 28) * 1e-7);
+    gpsData.altitude = ubxI4(p + 36) / 1000.0f;           // hMSL, mm
+    gpsData.speed = ubxI4(p + 60) * 0.00194384f;          // mm/s -> nœuds
+    gpsData.course = ubxI4(p + 64) * 1e-5f;
+  }
+  gpsData.pdop = ubxU2(p + 76) * 0.01f;
+  link.hAccMm = ubxU4(p + 40);
+  // Sans NAV-DOP (récepteur configuré ailleurs) ni NMEA : HDOP/VDOP marqués invalides plutôt que figés
+  if (now - dopUpdatedMs > GPS_UBX_TIMEOUT_MS) {
+    gpsData.hdop = 999.0f;
+    gpsData.vdop = 999.0f;
+  }
+  updateFixState();
+}
+
+// NAV-DOP : dilutions de précision, échelle 0,01
+static void applyNavDop(const uint8_t* p) {
+  gpsData.pdop = ubxU2(p + 6) * 0.01f;
+  gpsData.vdop = ubxU2(p + 10) * 0.01f;
+  gpsData.hdop = ubxU2(p + 12) * 0.01f;
+  dopUpdatedMs = millis();
+  gpsProtocolStatus.navDop++;
+}
+
+// NAV-SAT : table complète toutes constellations, drapeau svUsed par satellite
+static void applyNavSat(const uint8_t* p, uint16_t length) {
+  GPSSkyView& sky = gpsSkyView;
+  uint32_t now = millis();
+  uint8_t blocks = p[5];
+  if (blocks > (length - UBX_NAV_SAT_HEADER) / UBX_NAV_SAT_BLOCK) {
+    blocks = (length - UBX_NAV_SAT_HEADER) / UBX_NAV_SAT_BLOCK;
+  }
+  sky.count = 0;
+  usedCount = 0;
+  for (uint8_t i = 0; i < blocks && sky.count < GPS_MAX_SATELLITES; i++) {
+    const uint8_t* block = p + UBX_NAV_SAT_HEADER + i * UBX_NAV_SAT_BLOCK;
+    GPSConstellation system = GPS_SYSTEM_UNKNOWN;
+    uint16_t prn = 0;
+    if (!ubxSatelliteId(block[0], block[1], system, prn)) continue;
+    GPSSatellite& sat = sky.satellites[sky.count++];
+    sat.prn = prn;
+    sat.system = system;
+    sat.snr = block[2];
+    sat.elevation = (int8_t)block[3];
+    sat.azimuth = ubxI2(block + 4);
+    if ((ubxU4(block + 8) & 0x08) && usedCount < GPS_MAX_SATELLITES) {
+      usedSatellites[usedCount].prn = prn;
+      usedSatellites[usedCount].system = system;
+      usedCount++;
     }
+    systemUpdatedMs[system] = now;
   }
+  sky.updatedMs = now ? now : 1;
+  gpsProtocolStatus.navSat++;
+  refreshSkyViewStats();
+}
+
+static void handleUBXFrame() {
+  const UBXDecoder& frame = ubxDecoder;
+  if (frame.cls == UBX_CLASS_NAV && frame.id == UBX_NAV_PVT && frame.length >= UBX_NAV_PVT_LENGTH) {
+    applyNavPvt(frame.payload);
+  } else if (frame.cls == UBX_CLASS_NAV && frame.id == UBX_NAV_SAT && frame.length >= UBX_NAV_SAT_HEADER) {
+    applyNavSat(frame.payload, frame.length);
+  } else if (frame.cls == UBX_CLASS_NAV && frame.id == UBX_NAV_DOP && frame.length >= UBX_NAV_DOP_LENGTH) {
+    applyNavDop(frame.payload);
+  } else if (frame.cls == UBX_CLASS_ACK && frame.length >= 2 && frame.payload[0] == UBX_CLASS_CFG) {
+    if (frame.id == UBX_ACK_ACK) {
+      gpsProtocolStatus.configAcks++;
+    } else {
+      gpsProtocolStatus.configNaks++;
+    }
+  }
+}
+
+void resetGPSSkyView() {
+  gpsSkyView = GPSSkyView();
+  gpsSkyView.startMs = millis();
+  usedCount = 0;
+  burstNext = 0;
+  fixHeld = false;
+  memset(systemUpdatedMs, 0, sizeof(systemUpdatedMs));
+  gpsData.satellites_used = 0;
+  gpsData.satellites_in_view = 0;
 }
 
 // Test GPS module
@@ -302,9 +825,3 @@ void testGPS() {
     Serial.println("GPS: Timeout - no NMEA data received. Check connections and baud rate.");
   }
 }
-
-// Handle PPS interrupt (optional, for high precision timing)
-void handlePPSInterrupt() {
-  // This would be called via GPIO interrupt on PPS pin
-  gpsData.hasPPS = true;
-}
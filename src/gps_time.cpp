@@ -0,0 +1,370 @@
+/*
+ * GPS_TIME.CPP - PPS-disciplined timekeeping
+ */
+
+#include "gps_time.h"
+#include "cycle_counter.h"
+#include <esp_timer.h>
+#include <math.h>
+#include <stdlib.h>
+
+#ifndef NATIVE_BUILD
+#include <sys/time.h>
+#endif
+
+// Global timing status (loop task only)
+GPSTimeStatus gpsTimeStatus;
+
+struct PPSEdge {
+  int64_t us;                              // esp_timer_get_time() in the ISR
+  uint32_t second;                         // GPS seconds since the fit started
+  uint32_t cycleDelta;                     // CPU cycles since the previous second, 0 = not consecutive
+};
+
+// Conversion publiée pour toutes les tâches (échantillonneur SD, serveur web)
+struct TimeAnchor {
+  bool valid;
+  int64_t localUs;                         // Fitted esp_timer time of the last labelled edge
+  uint32_t utcSeconds;
+  double slope;                            // Local microseconds per GPS second
+};
+
+#define GPS_TIME_READ_RETRIES 8
+
+// Front capturé par l'ISR : compteur de séquence impair pendant l'écriture
+static volatile uint32_t isrSeq = 0;
+static volatile uint32_t isrEdges = 0;
+static volatile int64_t isrEdgeUs = 0;
+static volatile uint32_t isrEdgeCycles = 0;
+
+static volatile uint32_t anchorSeq = 0;
+static TimeAnchor anchor = {};
+
+static PPSEdge history[GPS_PPS_HISTORY];
+static uint8_t historyCount = 0;
+static uint8_t historyNext = 0;
+static uint32_t processedEdges = 0;
+static bool haveEdge = false;
+static int64_t lastEdgeUs = 0;
+static uint32_t lastEdgeCycles = 0;
+static uint32_t lastSecond = 0;
+static uint8_t glitchRun = 0;
+static double fitSlope = 1e6;
+static int64_t fitLastUs = 0;              // Fitted time of the last edge
+static bool haveUtc = false;
+static uint32_t utcBase = 0;               // Unix time of second 0 of the fit
+static uint32_t pendingBase = 0;
+static uint8_t mismatchRun = 0;
+
+static void IRAM_ATTR gpsPPSISR() {
+  uint32_t cycles = diagCycleCount();
+  int64_t us = esp_timer_get_time();
+  uint32_t seq = isrSeq + 1;
+  isrSeq = seq;
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  isrEdgeUs = us;
+  isrEdgeCycles = cycles;
+  isrEdges = isrEdges + 1;
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  isrSeq = seq + 1;
+}
+
+const char* gpsTimeStateName(GPSTimeState state) {
+  switch (state) {
+    case GPS_TIME_PPS: return "pps";
+    case GPS_TIME_LOCKED: return "locked";
+    case GPS_TIME_HOLDOVER: return "holdover";
+    default: return "none";
+  }
+}
+
+// Jours depuis 1970 (algorithme "days from civil", calendrier grégorien proleptique)
+uint32_t gpsUnixTime(uint16_t year, uint8_t month, uint8_t day, uint8_t hour, uint8_t minute, uint8_t second) {
+  int32_t y = (int32_t)year - (month <= 2 ? 1 : 0);
+  int32_t era = y / 400;
+  int32_t yearOfEra = y - era * 400;
+  int32_t dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+  int32_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+  int32_t days = era * 146097 + dayOfEra - 719468;
+  return (uint32_t)days * 86400UL + hour * 3600UL + minute * 60UL + second;
+}
+
+static bool readAnchor(TimeAnchor& out) {
+  for (uint8_t i = 0; i < GPS_TIME_READ_RETRIES; i++) {
+    uint32_t seq = anchorSeq;
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    if (seq & 1) continue;
+    out = anchor;
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    if (anchorSeq == seq) return out.valid;
+  }
+  return false;
+}
+
+static void writeAnchor(const TimeAnchor& value) {
+  uint32_t seq = anchorSeq + 1;
+  anchorSeq = seq;
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  anchor = value;
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+  anchorSeq = seq + 1;
+}
+
+bool gpsTimeFromLocal(int64_t espTimerUs, uint64_t& utcUs) {
+  TimeAnchor a;
+  if (!readAnchor(a)) return false;
+  // Durée locale ramenée en secondes GPS par la pente : la dérive de l'oscillateur est corrigée
+  double elapsed = (double)(espTimerUs - a.localUs) * 1e6 / a.slope;
+  utcUs = (uint64_t)a.utcSeconds * 1000000ULL + (int64_t)llround(elapsed);
+  return true;
+}
+
+bool gpsTimeNow(uint64_t& utcUs) {
+  return gpsTimeFromLocal(esp_timer_get_time(), utcUs);
+}
+
+bool gpsTimeAnchor(int64_t& espTimerUs, uint64_t& utcUs, double& driftPpm) {
+  TimeAnchor a;
+  if (!readAnchor(a)) return false;
+  espTimerUs = a.localUs;
+  utcUs = (uint64_t)a.utcSeconds * 1000000ULL;
+  driftPpm = a.slope - 1e6;
+  return true;
+}
+
+static void restartFit(int64_t us, uint32_t cycles) {
+  historyCount = 0;
+  historyNext = 0;
+  lastSecond = 0;
+  glitchRun = 0;
+  haveUtc = false;
+  mismatchRun = 0;
+  history[historyNext] = {us, 0, 0};
+  historyNext = (historyNext + 1) % GPS_PPS_HISTORY;
+  historyCount = 1;
+  lastEdgeUs = us;
+  lastEdgeCycles = cycles;
+  haveEdge = true;
+  gpsTimeStatus.fitEdges = 1;
+}
+
+// Droite des moindres carrés t = a + b * seconde, en relatif au plus ancien front
+// (valeurs < 2^26 µs : la précision du double suffit)
+static void fitHistory() {
+  GPSTimeStatus& status = gpsTimeStatus;
+  const uint8_t first = (historyNext + GPS_PPS_HISTORY - historyCount) % GPS_PPS_HISTORY;
+  const PPSEdge& origin = history[first];
+  double sumX = 0.0, sumY = 0.0, sumXX = 0.0, sumXY = 0.0;
+  double cycleSum = 0.0;
+  uint8_t cycleCount = 0;
+  for (uint8_t i = 0; i < historyCount; i++) {
+    const PPSEdge& edge = history[(first + i) % GPS_PPS_HISTORY];
+    double x = (double)(edge.second - origin.second);
+    double y = (double)(edge.us - origin.us);
+    sumX += x;
+    sumY += y;
+    sumXX += x * x;
+    sumXY += x * y;
+    if (edge.cycleDelta) {
+      cycleSum += edge.cycleDelta;
+      cycleCount++;
+    }
+  }
+  const double n = historyCount;
+  const double denominator = n * sumXX - sumX * sumX;
+  if (historyCount < 2 || denominator <= 0.0) return;
+  double slope = (n * sumXY - sumX * sumY) / denominator;
+  double intercept = (sumY - slope * sumX) / n;
+
+  double sumSquares = 0.0;
+  double peak = 0.0;
+  for (uint8_t i = 0; i < historyCount; i++) {
+    const PPSEdge& edge = history[(first + i) % GPS_PPS_HISTORY];
+    double residual = (double)(edge.us - origin.us) - (intercept + slope * (edge.second - origin.second));
+    sumSquares += residual * residual;
+    if (fabs(residual) > peak) peak = fabs(residual);
+  }
+
+  fitSlope = slope;
+  fitLastUs = origin.us + (int64_t)llround(intercept + slope * (lastSecond - origin.second));
+  status.fitEdges = historyCount;
+  status.driftPpm = slope - 1e6;             // µs d'écart par seconde = ppm
+  status.jitterRmsUs = (float)sqrt(sumSquares / n);
+  status.jitterPeakUs = (float)peak;
+  if (cycleCount) {
+    double cpuHz = cycleSum / cycleCount;
+    double nominal = getCpuFrequencyMhz() * 1e6;
+    status.cpuHz = (uint32_t)lround(cpuHz);
+    status.cpuDriftPpm = nominal > 0.0 ? (float)((cpuHz / nominal - 1.0) * 1e6) : 0.0f;
+  }
+}
+
+// Horloge newlib (time(), gettimeofday()) : saut au-delà de GPS_TIME_STEP_US, rattrapage progressif en dessous
+static void disciplineSystemClock() {
+#ifndef NATIVE_BUILD
+  GPSTimeStatus& status = gpsTimeStatus;
+  struct timeval now;
+  gettimeofday(&now, nullptr);
+  uint64_t utcUs = 0;
+  if (!gpsTimeNow(utcUs)) return;
+  int64_t offset = (int64_t)now.tv_sec * 1000000LL + now.tv_usec - (int64_t)utcUs;
+  status.systemOffsetUs = offset > INT32_MAX ? INT32_MAX : offset < INT32_MIN ? INT32_MIN : (int32_t)offset;
+  if (llabs(offset) >= GPS_TIME_STEP_US) {
+    struct timeval utc;
+    utc.tv_sec = (time_t)(utcUs / 1000000ULL);
+    utc.tv_usec = (suseconds_t)(utcUs % 1000000ULL);
+    settimeofday(&utc, nullptr);
+    status.systemSteps++;
+  } else if (llabs(offset) >= GPS_TIME_SLEW_US) {
+    struct timeval delta;
+    delta.tv_sec = 0;
+    delta.tv_usec = (suseconds_t)-offset;
+    adjtime(&delta, nullptr);
+    status.systemSlews++;
+  }
+#endif
+}
+
+static void publishAnchor() {
+  GPSTimeStatus& status = gpsTimeStatus;
+  if (!haveUtc || historyCount < GPS_PPS_MIN_EDGES) return;
+  TimeAnchor value;
+  value.valid = true;
+  value.localUs = fitLastUs;
+  value.utcSeconds = utcBase + lastSecond;
+  value.slope = fitSlope;
+  writeAnchor(value);
+  status.utcSeconds = value.utcSeconds;
+  if (status.state != GPS_TIME_LOCKED) {
+    status.state = GPS_TIME_LOCKED;
+    status.locks++;
+    status.lockedSinceMs = millis();
+  }
+  disciplineSystemClock();
+}
+
+static void processEdges() {
+  GPSTimeStatus& status = gpsTimeStatus;
+  uint32_t count = 0;
+  int64_t us = 0;
+  uint32_t cycles = 0;
+  bool consistent = false;
+  for (uint8_t i = 0; i < GPS_TIME_READ_RETRIES && !consistent; i++) {
+    uint32_t seq = isrSeq;
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    if (seq & 1) continue;
+    count = isrEdges;
+    us = isrEdgeUs;
+    cycles = isrEdgeCycles;
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    consistent = isrSeq == seq;
+  }
+  if (!consistent || count == processedEdges) return;
+  // Fronts intermédiaires non lus (boucle bloquée > 1 s) : comptés comme secondes sautées
+  processedEdges = count;
+  status.edges = count;
+  status.lastEdgeMs = (uint32_t)(us / 1000);
+
+  if (!haveEdge || us - lastEdgeUs > (int64_t)GPS_PPS_MAX_GAP_S * 1000000) {
+    // Reprise après une longue coupure : nouvelle droite, la seconde UTC sera réétiquetée
+    if (status.state == GPS_TIME_NONE) status.state = GPS_TIME_PPS;
+    restartFit(us, cycles);
+    return;
+  }
+
+  int64_t interval = us - lastEdgeUs;
+  int64_t seconds = llround((double)interval / fitSlope);
+  double error = (double)interval - seconds * fitSlope;
+  if (seconds < 1 || fabs(error) > GPS_PPS_MAX_ERROR_US) {
+    status.glitches++;
+    if (++glitchRun >= GPS_PPS_RESYNC_GLITCHES) {
+      // Phase du PPS déplacée (récepteur redémarré) : les fronts parasites ne se répètent pas
+      status.resyncs++;
+      if (status.state == GPS_TIME_LOCKED) status.state = GPS_TIME_HOLDOVER;
+      restartFit(us, cycles);
+    }
+    return;
+  }
+
+  glitchRun = 0;
+  lastSecond += (uint32_t)seconds;
+  status.skipped += (uint32_t)seconds - 1;
+  status.accepted++;
+  status.lastIntervalUs = (uint32_t)interval;
+  history[historyNext] = {us, lastSecond, seconds == 1 ? cycles - lastEdgeCycles : 0};
+  historyNext = (historyNext + 1) % GPS_PPS_HISTORY;
+  if (historyCount < GPS_PPS_HISTORY) historyCount++;
+  lastEdgeUs = us;
+  lastEdgeCycles = cycles;
+  if (status.state == GPS_TIME_NONE) status.state = GPS_TIME_PPS;
+  fitHistory();
+  publishAnchor();
+}
+
+void gpsTimeOnUtc(uint32_t unixSeconds, uint32_t receivedMs) {
+  GPSTimeStatus& status = gpsTimeStatus;
+  if (!status.running) return;
+  processEdges();
+  if (!haveEdge || status.state == GPS_TIME_NONE || receivedMs - status.lastEdgeMs > GPS_TIME_UTC_WINDOW_MS) {
+    return;
+  }
+  uint32_t base = unixSeconds - lastSecond;
+  if (!haveUtc) {
+    utcBase = base;
+    haveUtc = true;
+  } else if (base != utcBase) {
+    // Phrase lue après le front suivant (boucle en retard) : une étiquette isolée est ignorée
+    mismatchRun = base == pendingBase ? mismatchRun + 1 : 1;
+    pendingBase = base;
+    if (mismatchRun < GPS_TIME_RELABEL_COUNT) return;
+    utcBase = base;
+    status.relabels++;
+  }
+  mismatchRun = 0;
+  status.labels++;
+  publishAnchor();
+}
+
+void maintainGPSTime() {
+  GPSTimeStatus& status = gpsTimeStatus;
+  if (!status.running) return;
+  processEdges();
+  if (!haveEdge) return;
+
+  uint32_t silentMs = millis() - status.lastEdgeMs;
+  if (silentMs <= GPS_PPS_TIMEOUT_MS) return;
+  if (status.state == GPS_TIME_LOCKED) {
+    status.state = GPS_TIME_HOLDOVER;
+  } else if (status.state == GPS_TIME_PPS ||
+             (status.state == GPS_TIME_HOLDOVER && silentMs > GPS_TIME_HOLDOVER_S * 1000UL)) {
+    TimeAnchor invalid = {};
+    writeAnchor(invalid);
+    status.state = GPS_TIME_NONE;
+  }
+}
+
+void beginGPSTime(int ppsPin) {
+  stopGPSTime();
+  gpsTimeStatus = GPSTimeStatus();
+  TimeAnchor invalid = {};
+  writeAnchor(invalid);
+  haveEdge = false;
+  haveUtc = false;
+  fitSlope = 1e6;
+  processedEdges = isrEdges;
+  if (ppsPin < 0) {
+    return;
+  }
+  gpsTimeStatus.pin = ppsPin;
+  pinMode(ppsPin, INPUT);
+  attachInterrupt(digitalPinToInterrupt(ppsPin), gpsPPSISR, RISING);
+  gpsTimeStatus.running = true;
+}
+
+void stopGPSTime() {
+  if (!gpsTimeStatus.running) {
+    return;
+  }
+  detachInterrupt(digitalPinToInterrupt(gpsTimeStatus.pin));
+  gpsTimeStatus.running = false;
+}
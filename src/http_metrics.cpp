@@ -0,0 +1,241 @@
+/*
+ * HTTP_METRICS.CPP - Per-route request latency, response size and heap delta
+ */
+
+#include "http_metrics.h"
+#include "config.h"
+#include "alloc_tracer.h"
+#include "cbor_encoder.h"
+#include "trace.h"
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+
+// Global metrics table (loop task only: handlers and /api/metrics/http)
+static HttpRouteMetrics* httpRoutes = nullptr;
+static uint16_t httpRouteCount = 0;
+
+static int16_t allocateRoute(const char* uri, uint16_t allocBudget) {
+  if (!httpRoutes) {
+    size_t bytes = sizeof(HttpRouteMetrics) * HTTP_METRICS_MAX_ROUTES;
+    httpRoutes = static_cast<HttpRouteMetrics*>(heap_caps_calloc(1, bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+    if (!httpRoutes) {
+      httpRoutes = static_cast<HttpRouteMetrics*>(heap_caps_calloc(1, bytes, MALLOC_CAP_8BIT));
+    }
+    if (!httpRoutes) {
+      Serial.println("[HTTP] Metrics table allocation failed");
+      return -1;
+    }
+  }
+  if (httpRouteCount >= HTTP_METRICS_MAX_ROUTES) {
+    Serial.printf("[HTTP] Metrics table full, %s not instrumented\r\n", uri);
+    return -1;
+  }
+  httpRoutes[httpRouteCount].uri = uri;
+  httpRoutes[httpRouteCount].allocBudget = allocBudget;
+  httpRoutes[httpRouteCount].heapDeltaMin = INT32_MAX;
+  httpRoutes[httpRouteCount].heapDeltaMax = INT32_MIN;
+  return httpRouteCount++;
+}
+
+static void recordRequest(HttpRouteMetrics& route, uint32_t us, uint32_t bytes, int32_t heapDelta) {
+  latencyRecord(route.latency, us);
+  route.bytesTotal += bytes;
+  if (bytes > route.bytesMax) route.bytesMax = bytes;
+  route.heapDeltaTotal += heapDelta;
+  if (heapDelta < route.heapDeltaMin) route.heapDeltaMin = heapDelta;
+  if (heapDelta > route.heapDeltaMax) route.heapDeltaMax = heapDelta;
+}
+
+#if ENABLE_ALLOC_TRACER
+static void recordAllocations(HttpRouteMetrics& route, const AllocCounters& allocs) {
+  route.allocTotal += allocs.allocations;
+  if (allocs.allocations > route.allocMax) route.allocMax = allocs.allocations;
+  if (allocs.bytes > route.allocBytesMax) route.allocBytesMax = allocs.bytes;
+  if (allocs.peak > route.allocPeakMax) route.allocPeakMax = allocs.peak;
+  if (route.allocBudget != 0 && allocs.allocations > route.allocBudget) {
+    // Premier dépassement seulement, le compteur suit les suivants
+    if (route.overBudget++ == 0) {
+      Serial.printf("[HTTP] %s: %u allocations, budget %u\r\n", route.uri, (unsigned)allocs.allocations, (unsigned)route.allocBudget);
+    }
+  }
+}
+#endif
+
+void DiagnosticWebServer::on(const char* uri, THandlerFunction handler, uint16_t allocBudget) {
+#if ENABLE_HTTP_METRICS || ENABLE_TRACE || ENABLE_CBOR_API
+#if ENABLE_HTTP_METRICS
+  int16_t slot = allocateRoute(uri, allocBudget);
+#else
+  (void)allocBudget;
+  int16_t slot = -1;
+#endif
+  uint16_t traceId = traceIntern(uri);
+  WebServer::on(uri, [this, slot, traceId, handler]() {
+    responseBytes = 0;
+#if ENABLE_CBOR_API
+    // strstr() : indexOf() construirait une String pour le motif à chaque requête
+    cborRequested = (hasArg("fmt") && arg("fmt") == "cbor") || strstr(header("Accept").c_str(), "application/cbor");
+#endif
+    traceRecord(TRACE_EVENT_BEGIN, traceId, 0);
+    uint32_t heapBefore = ESP.getFreeHeap();
+    int64_t start = esp_timer_get_time();
+    requestStartUs = start;
+#if ENABLE_ALLOC_TRACER
+    AllocCounters allocs = {};
+    {
+      AllocScope scope(allocs);
+      handler();
+    }
+#else
+    handler();
+#endif
+    requestArena.reset();
+    requestStartUs = 0;
+    cborRequested = false;
+    streamCbor = false;
+    uint32_t us = (uint32_t)(esp_timer_get_time() - start);
+    int32_t heapDelta = (int32_t)ESP.getFreeHeap() - (int32_t)heapBefore;
+    traceRecord(TRACE_EVENT_END, traceId, responseBytes);
+    if (slot >= 0) {
+      recordRequest(httpRoutes[slot], us, responseBytes, heapDelta);
+#if ENABLE_ALLOC_TRACER
+      recordAllocations(httpRoutes[slot], allocs);
+#endif
+    }
+  });
+#else
+  (void)allocBudget;
+  WebServer::on(uri, [handler]() {
+    handler();
+    requestArena.reset();
+  });
+#endif
+}
+
+void DiagnosticWebServer::begin() {
+#if ENABLE_CBOR_API
+  static const char* headerKeys[] = { "Accept" };
+  collectHeaders(headerKeys, 1);
+#endif
+  WebServer::begin();
+}
+
+void DiagnosticWebServer::send(int code, const char* contentType, const String& content) {
+#if ENABLE_CBOR_API
+  if (requestStartUs != 0 && content.length() > 0 && contentType && strcmp(contentType, "application/json") == 0) {
+    int64_t now = esp_timer_get_time();
+    if (cborRequested && sendCbor(code, content.c_str(), content.length(), now)) {
+      return;
+    }
+    sendHeader("X-Gen-Us", String((uint32_t)(now - requestStartUs)));
+  }
+#endif
+  responseBytes += content.length();
+  WebServer::send(code, contentType, content);
+}
+
+void DiagnosticWebServer::send(int code, const char* contentType, const ArenaText& content) {
+  if (!content.ok()) {
+    send(500, "application/json", "{\"success\":false,\"message\":\"Response too large\"}");
+    return;
+  }
+#if ENABLE_CBOR_API
+  if (requestStartUs != 0 && content.length() > 0 && contentType && strcmp(contentType, "application/json") == 0) {
+    int64_t now = esp_timer_get_time();
+    if (cborRequested && sendCbor(code, content.c_str(), content.length(), now)) {
+      return;
+    }
+    sendHeader("X-Gen-Us", String((uint32_t)(now - requestStartUs)));
+  }
+#endif
+  responseBytes += content.length();
+  send_P(code, contentType, content.c_str(), content.length());
+}
+
+// Taille d'abord, puis buffer exact dans l'arène de la requête ; JSON inchangé si invalide ou mémoire insuffisante
+bool DiagnosticWebServer::sendCbor(int code, const char* json, size_t length, int64_t encodeStart) {
+  size_t size = jsonToCbor(json, length, nullptr, 0);
+  if (size == 0) {
+    return false;
+  }
+  uint8_t* buffer = static_cast<uint8_t*>(requestArena.allocate(size));
+  if (!buffer) {
+    return false;
+  }
+  jsonToCbor(json, length, buffer, size);
+  int64_t encodeEnd = esp_timer_get_time();
+
+  sendHeader("X-Gen-Us", String((uint32_t)(encodeStart - requestStartUs)));
+  sendHeader("X-Encode-Us", String((uint32_t)(encodeEnd - encodeStart)));
+  responseBytes += size;
+  send_P(code, "application/cbor", reinterpret_cast<const char*>(buffer), size);
+  return true;
+}
+
+void DiagnosticWebServer::beginJsonStream(int code) {
+  setContentLength(CONTENT_LENGTH_UNKNOWN);
+#if ENABLE_CBOR_API
+  streamCbor = requestStartUs != 0 && cborRequested;
+  if (streamCbor) {
+    cborStreamBegin(cborStream);
+    cborChunk = nullptr;
+    cborChunkSize = 0;
+    WebServer::send(code, "application/cbor", "");
+    return;
+  }
+#endif
+  WebServer::send(code, "application/json", "");
+}
+
+void DiagnosticWebServer::sendJsonFragment(const char* json, size_t length) {
+  if (length == 0) {
+    return;
+  }
+#if ENABLE_CBOR_API
+  if (streamCbor) {
+    size_t size = jsonFragmentToCbor(cborStream, json, length, nullptr, 0);
+    if (size > cborChunkSize) {
+      // Croissance en place si possible, sinon nouveau bloc dans l'arène
+      if (cborChunk && requestArena.extend(cborChunk, cborChunkSize, size)) {
+        cborChunkSize = size;
+      } else {
+        cborChunk = static_cast<uint8_t*>(requestArena.allocate(size));
+        cborChunkSize = cborChunk ? size : 0;
+      }
+    }
+    // En-têtes déjà partis : un fragment impossible à encoder tronque le document CBOR
+    if (size == 0 || size > cborChunkSize || jsonFragmentToCbor(cborStream, json, length, cborChunk, size) == 0) {
+      cborStream.failed = true;
+      return;
+    }
+    sendContent(reinterpret_cast<const char*>(cborChunk), size);
+    return;
+  }
+#endif
+  sendContent(json, length);
+}
+
+void DiagnosticWebServer::endJsonStream() {
+  sendContent("", 0);
+  streamCbor = false;
+}
+
+uint16_t getHttpRouteCount() {
+  return httpRouteCount;
+}
+
+const HttpRouteMetrics* getHttpRouteMetrics(uint16_t index) {
+  return index < httpRouteCount ? &httpRoutes[index] : nullptr;
+}
+
+void resetHttpMetrics() {
+  for (uint16_t i = 0; i < httpRouteCount; i++) {
+    const char* uri = httpRoutes[i].uri;
+    uint16_t allocBudget = httpRoutes[i].allocBudget;
+    memset(&httpRoutes[i], 0, sizeof(HttpRouteMetrics));
+    httpRoutes[i].uri = uri;
+    httpRoutes[i].allocBudget = allocBudget;
+    httpRoutes[i].heapDeltaMin = INT32_MAX;
+    httpRoutes[i].heapDeltaMax = INT32_MIN;
+  }
+}
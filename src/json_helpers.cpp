@@ -0,0 +1,108 @@
+/*
+ * JSON_HELPERS.CPP - Escaping and flat object builders shared by the API handlers
+ */
+
+#include "json_helpers.h"
+
+// Séquence d'échappement JSON de c, nullptr si le caractère passe tel quel
+static const char* jsonEscapeSequence(char c) {
+  switch (c) {
+    case '\\':
+      return "\\\\";
+    case '"':
+      return "\\\"";
+    case '\n':
+      return "\\n";
+    case '\r':
+      return "\\r";
+    case '\t':
+      return "\\t";
+    default:
+      return nullptr;
+  }
+}
+
+// Copie les segments sans échappement d'un bloc, String ou ArenaText
+template <typename Out>
+static void appendEscaped(Out& out, const char* raw) {
+  const char* run = raw;
+  for (const char* p = raw; *p; p++) {
+    const char* sequence = jsonEscapeSequence(*p);
+    if (sequence) {
+      out.concat(run, (unsigned int)(p - run));
+      out.concat(sequence, 2);
+      run = p + 1;
+    }
+  }
+  out.concat(run, (unsigned int)strlen(run));
+}
+
+// ArenaText n'a pas concat() : adaptateur pour le modèle ci-dessus
+struct ArenaTextSink {
+  ArenaText& text;
+  void concat(const char* data, unsigned int length) { text.append(data, length); }
+};
+
+String jsonEscape(const char* raw) {
+  if (raw == nullptr) {
+    return "";
+  }
+
+  String escaped;
+  escaped.reserve(strlen(raw) * 2);
+  appendEscaped(escaped, raw);
+  return escaped;
+}
+
+void jsonEscapeTo(ArenaText& out, const char* raw) {
+  if (raw == nullptr) {
+    return;
+  }
+  ArenaTextSink sink = {out};
+  appendEscaped(sink, raw);
+}
+
+void appendJsonField(String& json, bool& first, const JsonFieldSpec& field) {
+  if (!first) {
+    json += ',';
+  }
+  first = false;
+  json += '"';
+  json += field.key;
+  json += '"';
+  json += ':';
+  if (field.raw) {
+    json += field.value;
+  } else {
+    // Échappement directement dans json, sans String intermédiaire
+    json += '"';
+    appendEscaped(json, field.value.c_str());
+    json += '"';
+  }
+}
+
+void appendJsonField(ArenaText& json, bool& first, const JsonFieldSpec& field) {
+  json += first ? "\"" : ",\"";
+  first = false;
+  json += field.key;
+  json += "\":";
+  if (field.raw) {
+    json += field.value;
+  } else {
+    json += '"';
+    jsonEscapeTo(json, field.value.c_str());
+    json += '"';
+  }
+}
+
+String buildJsonObject(std::initializer_list<JsonFieldSpec> fields) {
+  String json;
+  json.reserve(fields.size() * 50 + 10);  // Estimate size based on field count
+  json = "{";
+  bool first = true;
+  for (const auto& field : fields) {
+    appendJsonField(json, first, field);
+  }
+  json += '}';
+  return json;
+}
@@ -0,0 +1,9 @@
+/*
+ * LANGUAGES.CPP - Current interface language, read by every Texts:: lookup
+ */
+
+#include "config.h"
+#include "languages.h"
+
+// Set default language from config.h
+Language currentLanguage = DEFAULT_LANGUAGE;
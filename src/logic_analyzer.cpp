@@ -0,0 +1,378 @@
+/*
+ * LOGIC_ANALYZER.CPP - Software logic analyzer implementation
+ */
+
+#include "logic_analyzer.h"
+#include "config.h"
+#include "cycle_counter.h"
+#include <driver/gpio.h>
+#include <esp_heap_caps.h>
+#include <soc/soc.h>
+#include <soc/gpio_reg.h>
+#include <soc/io_mux_reg.h>
+#include <soc/gpio_periph.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <algorithm>
+#include <cstring>
+
+// Global capture state
+LogicAnalyzerCapture laCapture;
+
+struct LAChannelMap {
+  uint8_t bank;  // 0 = GPIO_IN_REG, 1 = GPIO_IN1_REG
+  uint8_t bit;
+};
+
+static inline uint8_t IRAM_ATTR laPackSample(uint32_t in0, uint32_t in1,
+                                             const LAChannelMap* map, uint8_t count) {
+  uint8_t value = 0;
+  for (uint8_t ch = 0; ch < count; ch++) {
+    uint32_t word = map[ch].bank ? in1 : in0;
+    value |= (uint8_t)(((word >> map[ch].bit) & 1U) << ch);
+  }
+  return value;
+}
+
+static inline bool laTriggerHit(LogicAnalyzerTrigger trigger, uint8_t mask,
+                                uint8_t previous, uint8_t current) {
+  switch (trigger) {
+    case LA_TRIGGER_RISING:  return (current & mask) && !(previous & mask);
+    case LA_TRIGGER_FALLING: return !(current & mask) && (previous & mask);
+    case LA_TRIGGER_HIGH:    return (current & mask) != 0;
+    case LA_TRIGGER_LOW:     return (current & mask) == 0;
+    default:                 return true;
+  }
+}
+
+const char* logicAnalyzerStateName(LogicAnalyzerState state) {
+  switch (state) {
+    case LA_STATE_ARMED:     return "armed";
+    case LA_STATE_CAPTURING: return "capturing";
+    case LA_STATE_DONE:      return "done";
+    case LA_STATE_TIMEOUT:   return "timeout";
+    case LA_STATE_ERROR:     return "error";
+    default:                 return "idle";
+  }
+}
+
+const char* logicAnalyzerTriggerName(LogicAnalyzerTrigger trigger) {
+  switch (trigger) {
+    case LA_TRIGGER_RISING:  return "rising";
+    case LA_TRIGGER_FALLING: return "falling";
+    case LA_TRIGGER_HIGH:    return "high";
+    case LA_TRIGGER_LOW:     return "low";
+    default:                 return "none";
+  }
+}
+
+LogicAnalyzerTrigger parseLogicAnalyzerTrigger(const String& name) {
+  if (name == "rising") return LA_TRIGGER_RISING;
+  if (name == "falling") return LA_TRIGGER_FALLING;
+  if (name == "high") return LA_TRIGGER_HIGH;
+  if (name == "low") return LA_TRIGGER_LOW;
+  return LA_TRIGGER_NONE;
+}
+
+bool configureLogicAnalyzer(const LogicAnalyzerConfig& config, String& error) {
+  if (config.channelCount == 0 || config.channelCount > LA_MAX_CHANNELS) {
+    error = "1 to 8 channels required";
+    return false;
+  }
+  for (uint8_t ch = 0; ch < config.channelCount; ch++) {
+    if (config.pins[ch] < 0 || config.pins[ch] >= GPIO_PIN_COUNT || !GPIO_IS_VALID_GPIO(config.pins[ch])) {
+      error = "Invalid GPIO " + String(config.pins[ch]);
+      return false;
+    }
+  }
+  if (config.sampleRate < 1000 || config.sampleRate > LA_MAX_SAMPLE_RATE) {
+    error = "Sample rate out of range";
+    return false;
+  }
+  if (config.sampleCount < 16 || config.sampleCount > LA_MAX_SAMPLES) {
+    error = "Sample count out of range";
+    return false;
+  }
+  if ((uint64_t)config.sampleCount * 1000ULL / config.sampleRate > LA_MAX_CAPTURE_MS) {
+    error = "Capture longer than " + String(LA_MAX_CAPTURE_MS) + " ms";
+    return false;
+  }
+  if (config.triggerChannel >= config.channelCount || config.pretriggerPercent > 90) {
+    error = "Invalid trigger settings";
+    return false;
+  }
+
+  // Réutilise le buffer si la taille convient, sinon réallocation PSRAM
+  if (laCapture.samples == nullptr || laCapture.capacity < config.sampleCount) {
+    if (laCapture.samples) {
+      heap_caps_free(laCapture.samples);
+      laCapture.samples = nullptr;
+      laCapture.capacity = 0;
+    }
+    uint8_t* buffer = static_cast<uint8_t*>(heap_caps_malloc(config.sampleCount, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+    bool inPSRAM = buffer != nullptr;
+    if (!buffer && config.sampleCount <= LA_MAX_INTERNAL_SAMPLES) {
+      buffer = static_cast<uint8_t*>(heap_caps_malloc(config.sampleCount, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT));
+    }
+    if (!buffer) {
+      error = "Capture buffer allocation failed";
+      return false;
+    }
+    laCapture.samples = buffer;
+    laCapture.capacity = config.sampleCount;
+    laCapture.inPSRAM = inPSRAM;
+  }
+
+  laCapture.config = config;
+  laCapture.length = 0;
+  laCapture.triggerIndex = 0;
+  laCapture.lateSamples = 0;
+  laCapture.actualRate = 0;
+  laCapture.error = "";
+  laCapture.state = LA_STATE_ARMED;
+  return true;
+}
+
+void runLogicAnalyzerCapture() {
+  LogicAnalyzerCapture& cap = laCapture;
+  const LogicAnalyzerConfig cfg = cap.config;
+  uint8_t* buffer = cap.samples;
+
+  if (!buffer || cap.state != LA_STATE_ARMED) {
+    cap.state = LA_STATE_ERROR;
+    cap.error = "Not armed";
+    return;
+  }
+
+  // Laisse partir la réponse HTTP 202 avant de monopoliser le coeur
+  vTaskDelay(pdMS_TO_TICKS(20));
+
+  LAChannelMap map[LA_MAX_CHANNELS];
+  bool needBank1 = false;
+  for (uint8_t ch = 0; ch < cfg.channelCount; ch++) {
+    int pin = cfg.pins[ch];
+    // Active le buffer d'entrée sans toucher à la matrice GPIO (bus SPI/I2C actifs)
+    PIN_INPUT_ENABLE(GPIO_PIN_MUX_REG[pin]);
+    map[ch].bank = pin >= 32 ? 1 : 0;
+    map[ch].bit = (uint8_t)(pin & 31);
+    needBank1 |= map[ch].bank != 0;
+  }
+
+  const uint32_t cpuHz = getCpuFrequencyMhz() * 1000000UL;
+  const uint64_t periodQ16 = ((uint64_t)cpuHz << 16) / cfg.sampleRate;
+  const uint32_t periodCycles = (uint32_t)(periodQ16 >> 16);
+  const uint32_t burstCycles = (cpuHz / 1000UL) * LA_ARMED_BURST_MS;
+  const uint32_t total = cfg.sampleCount;
+  const uint32_t pretrigger = (uint32_t)((uint64_t)total * cfg.pretriggerPercent / 100);
+  const uint8_t triggerMask = (uint8_t)(1U << cfg.triggerChannel);
+  const uint8_t channelCount = cfg.channelCount;
+
+  uint32_t writeIndex = 0;
+  uint32_t contiguous = 0;
+  uint32_t late = 0;
+  uint32_t triggerPos = 0;
+  uint32_t preAvailable = 0;
+  bool triggered = false;
+
+  uint32_t in1 = 0;
+  uint8_t previous = laPackSample(REG_READ(GPIO_IN_REG), needBank1 ? REG_READ(GPIO_IN1_REG) : 0, map, channelCount);
+  unsigned long armStart = millis();
+  uint32_t origin = diagCycleCount();
+  uint32_t burstStart = origin;
+  uint64_t elapsedQ16 = 0;
+
+  // Phase armée : échantillonnage en anneau jusqu'au déclenchement
+  while (!triggered) {
+    elapsedQ16 += periodQ16;
+    uint32_t target = origin + (uint32_t)(elapsedQ16 >> 16);
+    uint32_t now;
+    while ((int32_t)((now = diagCycleCount()) - target) < 0) {
+    }
+    if ((now - target) > periodCycles) late++;
+
+    if (needBank1) in1 = REG_READ(GPIO_IN1_REG);
+    uint8_t value = laPackSample(REG_READ(GPIO_IN_REG), in1, map, channelCount);
+    buffer[writeIndex] = value;
+    if (contiguous < total) contiguous++;
+
+    if (laTriggerHit(cfg.trigger, triggerMask, previous, value)) {
+      triggered = true;
+      triggerPos = writeIndex;
+      preAvailable = std::min(contiguous - 1, pretrigger);
+    }
+    previous = value;
+    writeIndex = (writeIndex + 1 == total) ? 0 : writeIndex + 1;
+
+    if (!triggered && (now - burstStart) > burstCycles) {
+      if ((millis() - armStart) > cfg.timeoutMs) {
+        cap.state = LA_STATE_TIMEOUT;
+        cap.lateSamples = late;
+        Serial.println("[LA] Timeout: trigger condition not met");
+        return;
+      }
+      // Cède le coeur 1 tick : l'anneau pré-déclenchement repart de zéro
+      vTaskDelay(1);
+      contiguous = 0;
+      origin = diagCycleCount();
+      burstStart = origin;
+      elapsedQ16 = 0;
+    }
+  }
+
+  // Phase capture : échantillons post-déclenchement sans interruption volontaire
+  cap.state = LA_STATE_CAPTURING;
+  uint32_t remaining = total - preAvailable - 1;
+  const uint32_t postCount = remaining;
+  const uint32_t captureStart = diagCycleCount();
+  while (remaining > 0) {
+    elapsedQ16 += periodQ16;
+    uint32_t target = origin + (uint32_t)(elapsedQ16 >> 16);
+    uint32_t now;
+    while ((int32_t)((now = diagCycleCount()) - target) < 0) {
+    }
+    if ((now - target) > periodCycles) late++;
+
+    if (needBank1) in1 = REG_READ(GPIO_IN1_REG);
+    buffer[writeIndex] = laPackSample(REG_READ(GPIO_IN_REG), in1, map, channelCount);
+    writeIndex = (writeIndex + 1 == total) ? 0 : writeIndex + 1;
+    remaining--;
+  }
+  const uint32_t captureCycles = diagCycleCount() - captureStart;
+
+  // Linéarise l'anneau : le premier échantillon pré-déclenchement passe en tête
+  uint32_t start = (triggerPos + total - preAvailable) % total;
+  std::rotate(buffer, buffer + start, buffer + total);
+
+  cap.length = total;
+  cap.triggerIndex = preAvailable;
+  cap.lateSamples = late;
+  cap.actualRate = (captureCycles > 0 && postCount > 0)
+                     ? (uint32_t)((uint64_t)postCount * cpuHz / captureCycles)
+                     : cfg.sampleRate;
+  cap.state = LA_STATE_DONE;
+
+  Serial.printf("[LA] Capture OK: %lu samples @ %lu Hz (mesuré %lu Hz), trigger @ %lu, %lu en retard\r\n",
+                (unsigned long)cap.length, (unsigned long)cfg.sampleRate,
+                (unsigned long)cap.actualRate, (unsigned long)cap.triggerIndex,
+                (unsigned long)cap.lateSamples);
+}
+
+// ========== EXPORT RLE ==========
+// Header (32 bytes, little endian):
+//   "LARL" | version u8 | channels u8 | pins i8[8] | reserved u16 |
+//   sample_rate u32 | actual_rate u32 | length u32 | trigger_index u32
+// Body: runs of (value u8, run length LEB128 varint)
+
+static void laPutU32(uint8_t* out, uint32_t value) {
+  out[0] = (uint8_t)(value);
+  out[1] = (uint8_t)(value >> 8);
+  out[2] = (uint8_t)(value >> 16);
+  out[3] = (uint8_t)(value >> 24);
+}
+
+size_t writeLogicAnalyzerRLEHeader(uint8_t* out, size_t outSize) {
+  if (outSize < LA_RLE_HEADER_SIZE) return 0;
+  memset(out, 0, LA_RLE_HEADER_SIZE);
+  memcpy(out, LA_RLE_MAGIC, 4);
+  out[4] = LA_RLE_VERSION;
+  out[5] = laCapture.config.channelCount;
+  for (uint8_t ch = 0; ch < LA_MAX_CHANNELS; ch++) {
+    out[6 + ch] = (uint8_t)laCapture.config.pins[ch];
+  }
+  laPutU32(out + 16, laCapture.config.sampleRate);
+  laPutU32(out + 20, laCapture.actualRate);
+  laPutU32(out + 24, laCapture.length);
+  laPutU32(out + 28, laCapture.triggerIndex);
+  return LA_RLE_HEADER_SIZE;
+}
+
+size_t encodeLogicAnalyzerRLE(uint32_t& cursor, uint8_t* out, size_t outSize) {
+  const uint8_t* samples = laCapture.samples;
+  const uint32_t length = laCapture.length;
+  size_t used = 0;
+
+  // 1 octet valeur + 5 octets varint max par run
+  while (cursor < length && (outSize - used) >= 6) {
+    uint8_t value = samples[cursor];
+    uint32_t run = 1;
+    while (cursor + run < length && samples[cursor + run] == value) {
+      run++;
+    }
+    cursor += run;
+
+    out[used++] = value;
+    while (run >= 0x80) {
+      out[used++] = (uint8_t)(run | 0x80);
+      run >>= 7;
+    }
+    out[used++] = (uint8_t)run;
+  }
+  return used;
+}
+
+// ========== EXPORT VCD ==========
+static uint64_t laSampleTimeNs(uint32_t index) {
+  return (uint64_t)index * 1000000000ULL / laCapture.config.sampleRate;
+}
+
+size_t writeLogicAnalyzerVCDHeader(char* out, size_t outSize) {
+  const LogicAnalyzerConfig& cfg = laCapture.config;
+  int used = snprintf(out, outSize,
+                      "$comment ESP32 Diagnostic logic analyzer, %lu Hz, trigger %s ch%u @ sample %lu $end\n"
+                      "$timescale 1ns $end\n$scope module esp32 $end\n",
+                      (unsigned long)cfg.sampleRate, logicAnalyzerTriggerName(cfg.trigger),
+                      cfg.triggerChannel, (unsigned long)laCapture.triggerIndex);
+  for (uint8_t ch = 0; ch < cfg.channelCount && used > 0 && (size_t)used < outSize; ch++) {
+    used += snprintf(out + used, outSize - used, "$var wire 1 %c gpio%d $end\n", '!' + ch, cfg.pins[ch]);
+  }
+  if (used > 0 && (size_t)used < outSize) {
+    used += snprintf(out + used, outSize - used, "$upscope $end\n$enddefinitions $end\n");
+  }
+  return (used > 0 && (size_t)used < outSize) ? (size_t)used : 0;
+}
+
+size_t encodeLogicAnalyzerVCD(uint32_t& cursor, char* out, size_t outSize) {
+  const uint8_t* samples = laCapture.samples;
+  const uint32_t length = laCapture.length;
+  const uint8_t channels = laCapture.config.channelCount;
+  const size_t worstCase = 24 + (size_t)channels * 3 + 16;
+  size_t used = 0;
+
+  if (length == 0 || cursor > length) return 0;
+
+  while (cursor <= length && (outSize - used) >= worstCase) {
+    if (cursor == length) {
+      // Horodatage final pour fixer la durée totale
+      used += snprintf(out + used, outSize - used, "#%llu\n",
+                       (unsigned long long)laSampleTimeNs(length));
+      cursor++;
+      break;
+    }
+
+    uint8_t value = samples[cursor];
+    if (cursor == 0) {
+      used += snprintf(out + used, outSize - used, "#0\n$dumpvars\n");
+      for (uint8_t ch = 0; ch < channels; ch++) {
+        out[used++] = (value >> ch) & 1 ? '1' : '0';
+        out[used++] = (char)('!' + ch);
+        out[used++] = '\n';
+      }
+      used += snprintf(out + used, outSize - used, "$end\n");
+    } else {
+      uint8_t changed = value ^ samples[cursor - 1];
+      if (changed) {
+        used += snprintf(out + used, outSize - used, "#%llu\n",
+                         (unsigned long long)laSampleTimeNs(cursor));
+        for (uint8_t ch = 0; ch < channels; ch++) {
+          if (changed & (1U << ch)) {
+            out[used++] = (value >> ch) & 1 ? '1' : '0';
+            out[used++] = (char)('!' + ch);
+            out[used++] = '\n';
+          }
+        }
+      }
+    }
+    cursor++;
+  }
+  return used;
+}
@@ -0,0 +1,155 @@
+/*
+ * LOOP_MONITOR.CPP - Main loop phase timing, jitter and stall recorder
+ */
+
+#include "loop_monitor.h"
+#include "config.h"
+#include "cycle_counter.h"
+#include <cstring>
+
+// Global loop monitor variables (loop task only)
+LoopMonitorData loopMonitorData;
+
+static const char* const loopPhaseNames[LOOP_PHASE_COUNT] = {
+  "heartbeat", "http", "boot", "network", "wifi_status",
+  "buttons", "sd_logger", "task_profiler", "sensors", "periodic"
+};
+
+#if ENABLE_LOOP_MONITOR
+static bool loopStarted = false;
+static uint32_t cpuMhz = 240;
+static uint32_t beginCycles = 0;
+static uint32_t beginMs = 0;
+static uint32_t markCycles = 0;
+static uint32_t markMs = 0;
+static uint8_t slowPhase = LOOP_PHASE_COUNT;
+static uint32_t slowPhaseUs = 0;
+static char slowDetail[LOOP_STALL_CULPRIT_LEN] = "";
+
+static uint32_t elapsedUs(uint32_t fromCycles, uint32_t fromMs, uint32_t nowCycles, uint32_t nowMs) {
+  // Compteur 32 bits : un tour en ~17,9 s à 240 MHz, au-delà de 10 s on passe sur millis()
+  uint32_t ms = nowMs - fromMs;
+  if (ms >= 10000) {
+    return ms * 1000;
+  }
+  return (nowCycles - fromCycles) / cpuMhz;
+}
+
+static void recordStall(uint32_t durationUs) {
+  LoopMonitorData& data = loopMonitorData;
+  uint8_t position = 0;
+  while (position < data.topCount && data.top[position].durationUs >= durationUs) {
+    position++;
+  }
+  if (position >= LOOP_STALL_TOP) {
+    return;
+  }
+  if (data.topCount < LOOP_STALL_TOP) {
+    data.topCount++;
+  }
+  for (uint8_t i = data.topCount - 1; i > position; i--) {
+    data.top[i] = data.top[i - 1];
+  }
+
+  LoopStall& stall = data.top[position];
+  stall.atMs = millis();
+  stall.durationUs = durationUs;
+  stall.phaseUs = slowPhaseUs;
+  stall.phase = slowPhase;
+  snprintf(stall.culprit, sizeof(stall.culprit), "%s", slowDetail[0] ? slowDetail : loopPhaseName(slowPhase));
+}
+#endif
+
+void loopMonitorBegin() {
+#if ENABLE_LOOP_MONITOR
+  uint32_t nowCycles = diagCycleCount();
+  uint32_t nowMs = millis();
+  if (loopStarted) {
+    latencyRecord(loopMonitorData.period, elapsedUs(beginCycles, beginMs, nowCycles, nowMs));
+  }
+  uint32_t mhz = getCpuFrequencyMhz();
+  cpuMhz = mhz > 0 ? mhz : 240;
+  beginCycles = markCycles = nowCycles;
+  beginMs = markMs = nowMs;
+  loopStarted = true;
+  slowPhase = LOOP_PHASE_COUNT;
+  slowPhaseUs = 0;
+  slowDetail[0] = '\0';
+#endif
+}
+
+void loopMonitorMark(LoopPhase phase, const char* detail) {
+#if ENABLE_LOOP_MONITOR
+  uint32_t nowCycles = diagCycleCount();
+  uint32_t nowMs = millis();
+  uint32_t us = elapsedUs(markCycles, markMs, nowCycles, nowMs);
+  markCycles = nowCycles;
+  markMs = nowMs;
+  if (phase >= LOOP_PHASE_COUNT) {
+    return;
+  }
+  latencyRecord(loopMonitorData.phases[phase], us);
+
+  if (us > slowPhaseUs) {
+    slowPhaseUs = us;
+    slowPhase = phase;
+    // Copie du détail seulement si la phase dépasse à elle seule le seuil
+    if (detail && us >= LOOP_STALL_THRESHOLD_MS * 1000UL) {
+      strncpy(slowDetail, detail, LOOP_STALL_CULPRIT_LEN - 1);
+      slowDetail[LOOP_STALL_CULPRIT_LEN - 1] = '\0';
+    } else {
+      slowDetail[0] = '\0';
+    }
+  }
+#endif
+}
+
+void loopMonitorEnd() {
+#if ENABLE_LOOP_MONITOR
+  if (!loopStarted) {
+    return;
+  }
+  LoopMonitorData& data = loopMonitorData;
+  uint32_t busyUs = elapsedUs(beginCycles, beginMs, diagCycleCount(), millis());
+  latencyRecord(data.busy, busyUs);
+  data.loops++;
+
+  if (busyUs >= LOOP_STALL_THRESHOLD_MS * 1000UL) {
+    data.stalls++;
+    recordStall(busyUs);
+    Serial.printf("[Loop] Blocage de %lu ms (phase %s: %lu ms%s%s)\r\n",
+                  (unsigned long)(busyUs / 1000), loopPhaseName(slowPhase),
+                  (unsigned long)(slowPhaseUs / 1000),
+                  slowDetail[0] ? ", " : "", slowDetail);
+  }
+#endif
+}
+
+void resetLoopMonitor() {
+  memset(&loopMonitorData, 0, sizeof(loopMonitorData));
+#if ENABLE_LOOP_MONITOR
+  loopStarted = false;
+#endif
+}
+
+const char* loopPhaseName(uint8_t phase) {
+  return phase < LOOP_PHASE_COUNT ? loopPhaseNames[phase] : "unknown";
+}
+
+void printLoopMonitorSummary() {
+#if ENABLE_LOOP_MONITOR
+  const LoopMonitorData& data = loopMonitorData;
+  Serial.printf("Loop: %lu iterations | busy p50 %lu us, p99 %lu us, max %lu ms | %lu blocage(s)\r\n",
+                (unsigned long)data.loops,
+                (unsigned long)latencyPercentile(data.busy, 50),
+                (unsigned long)latencyPercentile(data.busy, 99),
+                (unsigned long)(data.busy.maxUs / 1000),
+                (unsigned long)data.stalls);
+  if (data.topCount > 0) {
+    Serial.printf("Loop: pire blocage %lu ms (%s, %s) a %lu s\r\n",
+                  (unsigned long)(data.top[0].durationUs / 1000),
+                  loopPhaseName(data.top[0].phase), data.top[0].culprit,
+                  (unsigned long)(data.top[0].atMs / 1000));
+  }
+#endif
+}
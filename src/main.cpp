@@ -70,6 +70,7 @@
 #if !defined(DIAGNOSTIC_HAS_SDKCONFIG)
   #define DIAGNOSTIC_HAS_SDKCONFIG 0
 #endif
+#include <driver/gpio.h>
 #include <soc/soc.h>
 #include <soc/rtc.h>
 #if defined(__has_include)
@@ -87,9 +88,14 @@
 #include <FS.h>
 #include <vector>
 #include <cstring>
+#include <time.h>
 #include <string>
 #include <initializer_list>
 #include "json_helpers.h"
+#include "diagnostic_info.h"
+#include "export_builders.h"
+#include "api_routes.h"
+#include "http_alloc_budgets.h"
 
 // Configuration file - customize your setup
 // Copy include/config-example.h to include/config.h and customize your settings
@@ -108,17 +114,67 @@
 
 // GPS module
 #include "gps_module.h"
+#include "gps_time.h"
 
 // Environmental sensors (AHT20 + BMP280)
 #include "environmental_sensors.h"
 
-// Set default language from config.h
-Language currentLanguage = DEFAULT_LANGUAGE;
+// GPIO toggle-rate / interrupt-latency benchmark
+#include "gpio_benchmark.h"
+#include "cycle_counter.h"
+
+// Software logic analyzer
+#include "logic_analyzer.h"
+
+// Continuous ADC sampling (DMA)
+#include "adc_sampler.h"
+
+// SD card throughput benchmark
+#include "sd_benchmark.h"
+
+// Background SD data logger
+#include "sd_logger.h"
+
+// Background DHT11/DHT22 reader (edge-timestamp interrupt)
+#include "dht_sensor.h"
+
+// Background HC-SR04 ranging engine (echo edge timestamps, median + Kalman)
+#include "distance_sensor.h"
+
+// Deferred boot graph and boot-time profiler
+#include "boot_profiler.h"
+
+// Per-route HTTP latency / response size / heap delta (DiagnosticWebServer)
+#include "http_metrics.h"
+
+// FreeRTOS task CPU / stack profiler
+#include "task_profiler.h"
+
+// Main loop phase timing and stall recorder
+#include "loop_monitor.h"
+
+// Per-core binary trace rings + DIAG_DEBUGF() serial logs
+#include "trace.h"
+
+// OpenMetrics /metrics rendering (fixed chunk buffer)
+#include "metrics_writer.h"
+
+// Batched MQTT telemetry bridge (esp-mqtt, PSRAM backlog)
+#include "mqtt_bridge.h"
+
+// Periodic double-buffered diagnostic snapshots to SD / LittleFS
+#include "auto_export.h"
 
 // --- Prototypes pour fonctions de réponse JSON/API ---
 void sendJsonResponse(int statusCode, std::initializer_list<JsonFieldSpec> fields);
 void sendOperationSuccess(const String& message, std::initializer_list<JsonFieldSpec> extraFields = {});
 void sendOperationError(int statusCode, const String& message, std::initializer_list<JsonFieldSpec> extraFields = {});
+bool wifiConnectStageDone();
+// Faux tant que wifi_connect tourne : wifiMulti.run() associe sur le coeur 0 et l'objet
+// WiFi ne doit pas être lu en parallèle (SSID, RSSI, IP restent vides jusque-là)
+static bool wifiLinkUp() {
+  return wifiConnectStageDone() && WiFi.status() == WL_CONNECTED;
+}
 void sendActionResponse(int statusCode, bool success, const String& message, std::initializer_list<JsonFieldSpec> extraFields = {});
 void tftStepBoot();
 
@@ -126,7 +182,6 @@ static String buildActionResponseJson(bool success,
                                       const String& message,
                                       std::initializer_list<JsonFieldSpec> extraFields = {});
 String htmlEscape(const String& raw);
-String jsonEscape(const char* raw);
 String buildTranslationsJSON();
 String buildTranslationsJSON(Language lang);
 
@@ -235,7 +290,7 @@ int oledHeight = SCREEN_HEIGHT;
 uint8_t DHT_SENSOR_TYPE = DEFAULT_DHT_SENSOR_TYPE;
 
 // ========== OBJETS GLOBAUX ==========
-WebServer server(WEB_SERVER_PORT);
+DiagnosticWebServer server(WEB_SERVER_PORT);
 WiFiMulti wifiMulti;
 #if DIAGNOSTIC_HAS_MDNS
 bool mdnsServiceActive = false;
@@ -336,7 +391,14 @@ struct AsyncTestTaskArgs {
 static void asyncTestTask(void* parameters) {
   AsyncTestTaskArgs* args = static_cast<AsyncTestTaskArgs*>(parameters);
   if (args && args->routine) {
+#if ENABLE_TRACE
+    uint16_t traceId = traceIntern(args->runner ? args->runner->taskName : "async_test");
+    traceRecord(TRACE_EVENT_BEGIN, traceId, 0);
+    args->routine();
+    traceRecord(TRACE_EVENT_END, traceId, 0);
+#else
     args->routine();
+#endif
   }
   if (args) {
     if (args->runner) {
@@ -394,6 +456,9 @@ static AsyncTestRunner rgbLedTestRunner = {"RgbLedTest", nullptr, false};
 static AsyncTestRunner buzzerTestRunner = {"BuzzerTest", nullptr, false};
 static AsyncTestRunner sdTestRunner = {"SDTest", nullptr, false};
 static AsyncTestRunner rotaryTestRunner = {"RotaryTest", nullptr, false};
+static AsyncTestRunner gpioBenchmarkRunner = {"GPIOBenchmark", nullptr, false};
+static AsyncTestRunner logicAnalyzerRunner = {"LogicAnalyzer", nullptr, false};
+static AsyncTestRunner sdBenchmarkRunner = {"SDBenchmark", nullptr, false};
 
 bool runtimeBLE = false;
 
@@ -704,7 +769,7 @@ static void maintainButtons() {
 #if ENABLE_TFT_DISPLAY
         if (tftAvailable) {
           displayBootSplash();
-          if (WiFi.status() == WL_CONNECTED) {
+          if (wifiLinkUp()) {
             displayWiFiConnected(WiFi.SSID().c_str(), WiFi.localIP().toString().c_str());
           } else {
             displayWiFiStatus("WiFi not connected", TFT_ORANGE);
@@ -765,82 +830,11 @@ static void maintainButtons() {
 #endif
 
 // ========== STRUCTURES ==========
-struct DiagnosticInfo {
-  String chipModel;
-  String chipRevision;
-  int cpuCores;
-  uint32_t cpuFreqMHz;
-  uint32_t flashSize;
-  uint32_t psramSize;
-  String macAddress;
-  
-  uint32_t heapSize;
-  uint32_t freeHeap;
-  uint32_t minFreeHeap;
-  uint32_t maxAllocHeap;
-  
-  bool hasWiFi;
-  bool hasBT;
-  bool hasBLE;
-  String wifiSSID;
-  int wifiRSSI;
-  String ipAddress;
-  bool mdnsAvailable;
-  bool bluetoothEnabled;
-  bool bluetoothAdvertising;
-  String bluetoothName;
-  String bluetoothAddress;
-
-  String gpioList;
-  int totalGPIO;
-  
-  String sdkVersion;
-  String idfVersion;
-  unsigned long uptime;
-  float temperature;
-  
-  bool neopixelTested;
-  bool neopixelAvailable;
-  String neopixelResult;
-  
-  unsigned long cpuBenchmark;
-  unsigned long memBenchmark;
-  
-  String i2cDevices;
-  int i2cCount;
-  
-  bool oledTested;
-  bool oledAvailable;
-  String oledResult;
-} diagnosticData;
+DiagnosticInfo diagnosticData;
 
 // Include web interface after DiagnosticInfo definition
 #include "web_interface.h"
 
-struct DetailedMemoryInfo {
-  uint32_t flashSizeReal;
-  uint32_t flashSizeChip;
-  
-  uint32_t psramTotal;
-  uint32_t psramFree;
-  uint32_t psramUsed;
-  uint32_t psramLargestBlock;
-  bool psramAvailable;
-  bool psramConfigured;
-  bool psramBoardSupported;
-  const char* psramType;
-
-  uint32_t sramTotal;
-  uint32_t sramFree;
-  uint32_t sramUsed;
-  uint32_t sramLargestBlock;
-  
-  bool sramTestPassed;
-  bool psramTestPassed;
-  float fragmentationPercent;
-  String memoryStatus;
-};
-
 DetailedMemoryInfo detailedMemory;
 
 struct GPIOTestResult {
@@ -1007,7 +1001,7 @@ bool startMDNSService(bool verbose) {
 
 void maintainNetworkServices() {
 #if DIAGNOSTIC_HAS_MDNS
-  bool wifiConnectedNow = (WiFi.status() == WL_CONNECTED);
+  bool wifiConnectedNow = wifiLinkUp();
   if (wifiConnectedNow) {
     if (!wifiPreviouslyConnected) {
       startMDNSService(true);
@@ -1022,7 +1016,7 @@ void maintainNetworkServices() {
 }
 
 // ========== DÉTECTION MODÈLE ==========
-String detectChipModel() {
+const char* detectChipModel() {
   #ifdef CONFIG_IDF_TARGET_ESP32
     return "ESP32";
   #elif defined(CONFIG_IDF_TARGET_ESP32S2)
@@ -1075,7 +1069,7 @@ String getChipFeatures() {
   return String(featureBuf);
 }
 
-String getFlashType() {
+const char* getFlashType() {
   #ifdef CONFIG_ESPTOOLPY_FLASHMODE_QIO
     return "QIO";
   #elif defined(CONFIG_ESPTOOLPY_FLASHMODE_QOUT)
@@ -1085,11 +1079,11 @@ String getFlashType() {
   #elif defined(CONFIG_ESPTOOLPY_FLASHMODE_DOUT)
     return "DOUT";
   #else
-    return Texts::unknown.str();
+    return reinterpret_cast<const char*>(Texts::unknown.get());
   #endif
 }
 
-String getFlashSpeed() {
+const char* getFlashSpeed() {
   #ifdef CONFIG_ESPTOOLPY_FLASHFREQ_80M
     return "80 MHz";
   #elif defined(CONFIG_ESPTOOLPY_FLASHFREQ_40M)
@@ -1099,7 +1093,7 @@ String getFlashSpeed() {
   #elif defined(CONFIG_ESPTOOLPY_FLASHFREQ_20M)
     return "20 MHz";
   #else
-    return Texts::unknown.str();
+    return reinterpret_cast<const char*>(Texts::unknown.get());
   #endif
 }
 
@@ -1125,46 +1119,6 @@ String getResetReason() {
   }
 }
 
-String formatUptime(unsigned long days, unsigned long hours, unsigned long minutes) {
-  // [OPT-002] Optimize uptime formatting: use direct buffer instead of String concatenations
-  char uptimeBuf[64];
-  char *p = uptimeBuf;
-  size_t remaining = sizeof(uptimeBuf) - 1;
-  
-  if (days > 0) {
-    // [OPT-008]: Direct .c_str() call avoids String() allocation
-    int written = snprintf(p, remaining, "%lu %s", days, Texts::days.str().c_str());
-    if (written > 0) {
-      p += written;
-      remaining -= written;
-    }
-  }
-  
-  if (hours > 0 || (days > 0 && remaining > 1)) {
-    if (p != uptimeBuf && remaining > 1) {
-      *p++ = ' ';
-      remaining--;
-    }
-    // [OPT-008]: Direct .c_str() call avoids String() allocation
-    int written = snprintf(p, remaining, "%lu %s", hours, Texts::hours.str().c_str());
-    if (written > 0) {
-      p += written;
-      remaining -= written;
-    }
-  }
-  
-  if (minutes > 0 || uptimeBuf[0] == '\0') {
-    if (p != uptimeBuf && remaining > 1) {
-      *p++ = ' ';
-      remaining--;
-    }
-    // [OPT-008]: Direct .c_str() call avoids String() allocation
-    snprintf(p, remaining, "%lu %s", minutes, Texts::minutes.str().c_str());
-  }
-  
-  return String(uptimeBuf);
-}
-
 String getMemoryStatus() {
   float heapUsagePercent = ((float)(diagnosticData.heapSize - diagnosticData.freeHeap) / diagnosticData.heapSize) * 100;
   if (heapUsagePercent < 50) return Texts::excellent.str();
@@ -1181,17 +1135,17 @@ const char* getWiFiSignalQualityKey() {
   else return "very_weak";
 }
 
-String getWiFiSignalQuality() {
+const char* getWiFiSignalQuality() {
   const char* key = getWiFiSignalQualityKey();
   if (key == nullptr) {
-    return Texts::unknown.str();
+    return reinterpret_cast<const char*>(Texts::unknown.get());
   }
-  if (strcmp(key, "excellent") == 0) return Texts::excellent.str();
-  if (strcmp(key, "very_good") == 0) return Texts::very_good.str();
-  if (strcmp(key, "good") == 0) return Texts::good.str();
-  if (strcmp(key, "weak") == 0) return Texts::weak.str();
-  if (strcmp(key, "very_weak") == 0) return Texts::very_weak.str();
-  return Texts::unknown.str();
+  if (strcmp(key, "excellent") == 0) return reinterpret_cast<const char*>(Texts::excellent.get());
+  if (strcmp(key, "very_good") == 0) return reinterpret_cast<const char*>(Texts::very_good.get());
+  if (strcmp(key, "good") == 0) return reinterpret_cast<const char*>(Texts::good.get());
+  if (strcmp(key, "weak") == 0) return reinterpret_cast<const char*>(Texts::weak.get());
+  if (strcmp(key, "very_weak") == 0) return reinterpret_cast<const char*>(Texts::very_weak.get());
+  return reinterpret_cast<const char*>(Texts::unknown.get());
 }
 
 // Use translation keys for WiFi auth modes
@@ -1314,9 +1268,13 @@ String wifiPhyModesToString(const wifi_ap_record_t& record) {
   return modes;
 }
 
-String getGPIOList() {
+// Liste fixe pour la cible : construite une fois, pointeur stable pour DiagnosticInfo::gpioList
+const char* getGPIOList() {
   // [OPT-005] Optimize GPIO list building: use buffer with snprintf instead of String concatenation
-  char gpioListBuf[256] = {0};
+  static char gpioListBuf[256] = {0};
+  if (gpioListBuf[0] != '\0') {
+    return gpioListBuf;
+  }
   int gpios_array[22];
   int numGPIO = 0;
 
@@ -1351,7 +1309,7 @@ String getGPIOList() {
     p += snprintf(p, sizeof(gpioListBuf) - (p - gpioListBuf), "%d", gpios_array[i]);
   }
   
-  return String(gpioListBuf);
+  return gpioListBuf;
 }
 
 int countGPIO() {
@@ -1466,13 +1424,13 @@ void collectDetailedMemory() {
   detailedMemory.psramTestPassed = testPSRAMQuick();
   
   if (detailedMemory.fragmentationPercent < 20) {
-    detailedMemory.memoryStatus = Texts::excellent.str();
+    detailedMemory.memoryStatus = MEMORY_STATUS_EXCELLENT;
   } else if (detailedMemory.fragmentationPercent < 40) {
-    detailedMemory.memoryStatus = Texts::good.str();
+    detailedMemory.memoryStatus = MEMORY_STATUS_GOOD;
   } else if (detailedMemory.fragmentationPercent < 60) {
-    detailedMemory.memoryStatus = "Moyen"; // Pas traduit (statut technique)
+    detailedMemory.memoryStatus = MEMORY_STATUS_AVERAGE;
   } else {
-    detailedMemory.memoryStatus = Texts::critical.str();
+    detailedMemory.memoryStatus = MEMORY_STATUS_CRITICAL;
   }
 }
 
@@ -1581,23 +1539,18 @@ void scanI2C() {
   ensureI2CBusConfigured();
   Serial.printf("I2C: SDA=%d, SCL=%d\r\n", i2c_sda, i2c_scl);
   
-  diagnosticData.i2cDevices = "";
   diagnosticData.i2cCount = 0;
   
   for (byte address = 1; address < 127; address++) {
     Wire.beginTransmission(address);
     if (Wire.endTransmission() == 0) {
-      char addr[6];
-      sprintf(addr, "0x%02X", address);
-      if (diagnosticData.i2cCount > 0) diagnosticData.i2cDevices += ", ";
-      diagnosticData.i2cDevices += String(addr);
+      // Adresses brutes : le texte est formaté au rendu (formatI2CDevices)
+      if (diagnosticData.i2cCount < DIAG_I2C_MAX_DEVICES) {
+        diagnosticData.i2cAddresses[diagnosticData.i2cCount] = address;
+      }
       diagnosticData.i2cCount++;
     }
   }
-  
-  if (diagnosticData.i2cCount == 0) {
-    diagnosticData.i2cDevices = "Aucun";
-  }
   Serial.printf("I2C: %d peripherique(s)\r\n", diagnosticData.i2cCount);
 }
 
@@ -1691,6 +1644,7 @@ void IRAM_ATTR rotaryISR() {
     } else {
       rotaryPosition--;
     }
+    TRACE_INSTANT("rotary_step", rotaryPosition);
   }
   lastRotaryState = clkState;
 }
@@ -1930,7 +1884,7 @@ void updateNeoPixelWifiStatus() {
   if (!neopixelReady() || neopixelStatusPaused) return;
   if (neopixelConnecting) return; // Couleur fixe tant que la connexion est en cours
 
-  bool connected = (WiFi.status() == WL_CONNECTED);
+  bool connected = wifiLinkUp();
 
   if (!neopixelStatusKnown || connected != neopixelLastWifiConnected) {
     neopixelSetWifiState(connected);
@@ -2627,7 +2581,8 @@ void testADC() {
     ADCReading reading;
     reading.pin = adcPins[i];
     reading.rawValue = analogRead(adcPins[i]);
-    reading.voltage = (reading.rawValue / 4095.0) * 3.3;
+    // Tension calibrée eFuse (courbe/ligne) au lieu de raw/4095*3.3
+    reading.voltage = analogReadMilliVolts(adcPins[i]) / 1000.0;
     adcReadings.push_back(reading);
 
     Serial.printf("GPIO%d: %d (%.2fV)\r\n", reading.pin, reading.rawValue, reading.voltage);
@@ -2811,9 +2766,10 @@ static inline const char* getDhtSensorName() {
 }
 
 // TEST DHT SENSOR
+// Lecture en cache : maintainDHTSensor() lit le capteur en fond depuis loop(),
+// le handler n'attend jamais le bus
 void testDHTSensor() {
   const char* sensorName = getDhtSensorName();
-  Serial.printf("\r\n=== TEST %s ===\r\n", sensorName);
 
   if (dht_pin < 0) {
     dhtTestResult = String(Texts::configuration_invalid);
@@ -2822,98 +2778,29 @@ void testDHTSensor() {
     return;
   }
 
-  Serial.printf("Lecture %s - Pin:%d\r\n", sensorName, dht_pin);
-
-  pinMode(dht_pin, OUTPUT);
-  digitalWrite(dht_pin, LOW);
-  delay(20);
-  digitalWrite(dht_pin, HIGH);
-  delayMicroseconds(40);
-  pinMode(dht_pin, INPUT_PULLUP);
-
-  uint8_t data[5] = {0};
-  uint8_t bits[40] = {0};
-
-  unsigned long timeout = millis();
-  while (digitalRead(dht_pin) == HIGH) {
-    if (millis() - timeout > 100) {
-      dhtTestResult = String(Texts::error_label);
-      dhtAvailable = false;
-      Serial.printf("%s: Timeout\r\n", sensorName);
-      return;
-    }
-  }
-
-  timeout = millis();
-  while (digitalRead(dht_pin) == LOW) {
-    if (millis() - timeout > 100) {
-      dhtTestResult = String(Texts::error_label);
-      dhtAvailable = false;
-      Serial.printf("%s: Timeout\r\n", sensorName);
-      return;
-    }
-  }
-
-  timeout = millis();
-  while (digitalRead(dht_pin) == HIGH) {
-    if (millis() - timeout > 100) {
-      dhtTestResult = String(Texts::error_label);
-      dhtAvailable = false;
-      Serial.printf("%s: Timeout\r\n", sensorName);
-      return;
-    }
-  }
-
-  for (int i = 0; i < 40; i++) {
-    timeout = micros();
-    while (digitalRead(dht_pin) == LOW) {
-      if (micros() - timeout > 100) break;
-    }
-
-    unsigned long t = micros();
-    timeout = micros();
-    while (digitalRead(dht_pin) == HIGH) {
-      if (micros() - timeout > 100) break;
-    }
-
-    if ((micros() - t) > 40) {
-      bits[i] = 1;
-    }
-  }
-
-  for (int i = 0; i < 5; i++) {
-    data[i] = 0;
-    for (int j = 0; j < 8; j++) {
-      data[i] <<= 1;
-      data[i] |= bits[i * 8 + j];
-    }
+  const DHTSensorStatus& status = dhtSensorStatus;
+  if (!status.running || status.pin != dht_pin || status.type != DHT_SENSOR_TYPE) {
+    // Lecteur arrêté ou reconfiguré : première lecture à la prochaine itération de loop()
+    beginDHTSensor(dht_pin, DHT_SENSOR_TYPE);
+    requestDHTRead();
   }
 
-  if (data[4] == ((data[0] + data[1] + data[2] + data[3]) & 0xFF)) {
-    if (DHT_SENSOR_TYPE == 22) {
-      uint16_t rawHumidity = (static_cast<uint16_t>(data[0]) << 8) | data[1];
-      uint16_t rawTemperature = (static_cast<uint16_t>(data[2]) << 8) | data[3];
-      bool negative = rawTemperature & 0x8000;
-      if (negative) {
-        rawTemperature &= 0x7FFF;
-      }
-      dhtHumidity = rawHumidity * 0.1f;
-      dhtTemperature = rawTemperature * 0.1f;
-      if (negative) {
-        dhtTemperature = -dhtTemperature;
-      }
-    } else {
-      dhtHumidity = static_cast<float>(data[0]) + static_cast<float>(data[1]) * 0.1f;
-      dhtTemperature = static_cast<float>(data[2]) + static_cast<float>(data[3]) * 0.1f;
-    }
+  if (status.valid && millis() - status.lastReadMs < 3UL * DHT_READ_INTERVAL_MS) {
+    dhtTemperature = status.temperature;
+    dhtHumidity = status.humidity;
     dhtTestResult = OK_STR;
     dhtAvailable = true;
-    Serial.printf("%s: T=%.1f°C H=%.1f%%\r\n", sensorName, dhtTemperature, dhtHumidity);
+  } else if (status.lastResult == DHT_READ_NONE) {
+    dhtTestResult = String(Texts::test_in_progress);
+    dhtAvailable = false;
   } else {
     dhtTestResult = String(Texts::error_label);
     dhtAvailable = false;
-    Serial.printf("%s: Checksum error\r\n", sensorName);
   }
+  Serial.printf("%s: T=%.1f°C H=%.1f%% (filtre %u, %lu ok, %lu timeout, %lu trame, %lu checksum)\r\n",
+                sensorName, dhtTemperature, dhtHumidity, (unsigned)status.samples,
+                (unsigned long)status.okReads, (unsigned long)status.timeouts,
+                (unsigned long)status.frameErrors, (unsigned long)status.checksumErrors);
 }
 
 // TEST LIGHT SENSOR
@@ -2944,64 +2831,51 @@ void testLightSensor() {
   Serial.printf("Light Sensor: %d\r\n", lightSensorValue);
 }
 
-// TEST DISTANCE SENSOR
-void testDistanceSensor() {
-  Serial.println("\r\n=== TEST DISTANCE SENSOR (HC-SR04) ===");
-
+// ESP32-S3 (OPI Flash/PSRAM): GPIO 35..48 sont généralement réservées
+// Si utilisées pour TRIG/ECHO, la mesure échouera systématiquement
+static bool distancePinsUsable() {
   if (distance_trig_pin < 0 || distance_echo_pin < 0) {
-    distanceSensorTestResult = String(Texts::configuration_invalid);
-    distanceSensorAvailable = false;
     Serial.println("Distance Sensor: Configuration invalide");
-    return;
+    return false;
   }
-
-  // ESP32-S3 (OPI Flash/PSRAM): GPIO 35..48 sont généralement réservées
-  // Si utilisées pour TRIG/ECHO, la mesure échouera systématiquement
   if ((distance_trig_pin >= 35 && distance_trig_pin <= 48) ||
       (distance_echo_pin >= 35 && distance_echo_pin <= 48)) {
-    distanceSensorTestResult = String(Texts::configuration_invalid);
-    distanceSensorAvailable = false;
     Serial.printf("Distance Sensor: Pins invalides sur ESP32-S3 OPI (TRIG=%d, ECHO=%d). Evitez GPIO 35..48.\r\n",
                   distance_trig_pin, distance_echo_pin);
     Serial.println("Suggestion: TRIG=26 (sortie), ECHO=25 (entrée) si le bus I2C secondaire est inactif.");
-    return;
+    return false;
   }
+  return true;
+}
 
-  pinMode(distance_trig_pin, OUTPUT);
-  pinMode(distance_echo_pin, INPUT);
-
-  Serial.printf("Distance Sensor - Trig:%d Echo:%d\r\n", distance_trig_pin, distance_echo_pin);
+// TEST DISTANCE SENSOR
+// Lecture en cache : maintainDistanceSensor() mesure en fond depuis loop(),
+// plus d'attente de l'écho dans le handler
+void testDistanceSensor() {
+  Serial.println("\r\n=== TEST DISTANCE SENSOR (HC-SR04) ===");
 
-  // Assurer ECHO à LOW avant de déclencher (éviter faux négatifs)
-  {
-    unsigned long waitStart = micros();
-    while (digitalRead(distance_echo_pin) == HIGH && (micros() - waitStart) < 200000UL) {
-      yield();
-    }
+  if (!distancePinsUsable()) {
+    distanceSensorTestResult = String(Texts::configuration_invalid);
+    distanceSensorAvailable = false;
+    return;
   }
 
-  // Séquence TRIG: 10 µs HIGH après stabilisation LOW
-  digitalWrite(distance_trig_pin, LOW);
-  delayMicroseconds(4);
-  digitalWrite(distance_trig_pin, HIGH);
-  delayMicroseconds(10);
-  digitalWrite(distance_trig_pin, LOW);
-
-  // Mesure de l'impulsion ECHO (timeout élargi)
-  unsigned long timeoutUs = 60000UL; // 60 ms
-  unsigned long duration = 0UL;
-#if defined(ARDUINO_ARCH_ESP32)
-  duration = pulseInLong(distance_echo_pin, HIGH, timeoutUs);
-#else
-  duration = pulseIn(distance_echo_pin, HIGH, timeoutUs);
-#endif
+  const DistanceSensorStatus& status = distanceSensorStatus;
+  if (!status.running || status.trigPin != distance_trig_pin || status.echoPin != distance_echo_pin) {
+    // Moteur arrêté ou broches changées : première mesure à la prochaine itération de loop()
+    beginDistanceSensor(distance_trig_pin, distance_echo_pin, DISTANCE_SAMPLE_RATE_HZ);
+  }
+  Serial.printf("Distance Sensor - Trig:%d Echo:%d @ %u Hz\r\n", distance_trig_pin, distance_echo_pin, status.rateHz);
 
-  if (duration > 0UL) {
-    // Vitesse du son ~0.034 cm/µs ; aller-retour => /2
-    distanceValue = (double)duration * 0.034 / 2.0;
+  if (status.valid && millis() - status.lastReadMs < 2000UL) {
+    distanceValue = status.filteredCm;
     distanceSensorTestResult = OK_STR;
     distanceSensorAvailable = true;
-    Serial.printf("Distance: %.2f cm\r\n", distanceValue);
+    Serial.printf("Distance: %.2f cm (brut %.2f cm, son %.1f m/s a %.1f°C)\r\n",
+                  status.filteredCm, status.rawCm, status.soundSpeed, status.temperatureC);
+  } else if (status.readings + status.timeouts + status.outOfRange == 0) {
+    distanceSensorTestResult = String(Texts::test_in_progress);
+    distanceSensorAvailable = false;
   } else {
     distanceSensorTestResult = String(Texts::error_label);
     distanceSensorAvailable = false;
@@ -3347,7 +3221,7 @@ void collectDiagnosticInfo() {
   esp_chip_info(&chip_info);
   
   diagnosticData.chipModel = detectChipModel();
-  diagnosticData.chipRevision = String(chip_info.revision);
+  diagnosticData.chipRevision = chip_info.revision;
   diagnosticData.cpuCores = chip_info.cores;
   diagnosticData.cpuFreqMHz = ESP.getCpuFreqMHz();
   
@@ -3356,12 +3230,7 @@ void collectDiagnosticInfo() {
   diagnosticData.flashSize = flash_size;
   diagnosticData.psramSize = ESP.getPsramSize();
   
-  uint8_t mac[6];
-  esp_read_mac(mac, ESP_MAC_WIFI_STA);
-  char macStr[18];
-  sprintf(macStr, "%02X:%02X:%02X:%02X:%02X:%02X", 
-          mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
-  diagnosticData.macAddress = String(macStr);
+  esp_read_mac(diagnosticData.mac, ESP_MAC_WIFI_STA);
   
   diagnosticData.heapSize = ESP.getHeapSize();
   diagnosticData.freeHeap = ESP.getFreeHeap();
@@ -3398,19 +3267,26 @@ void collectDiagnosticInfo() {
   }
 #endif
 
-  if (WiFi.status() == WL_CONNECTED) {
-    diagnosticData.wifiSSID = WiFi.SSID();
-    diagnosticData.wifiRSSI = WiFi.RSSI();
-    diagnosticData.ipAddress = WiFi.localIP().toString();
+  if (wifiLinkUp()) {
+    // Lecture directe du driver : WiFi.SSID() construit une String à chaque appel
+    wifi_ap_record_t apInfo;
+    if (esp_wifi_sta_get_ap_info(&apInfo) == ESP_OK) {
+      snprintf(diagnosticData.wifiSSID, sizeof(diagnosticData.wifiSSID), "%s", reinterpret_cast<const char*>(apInfo.ssid));
+      diagnosticData.wifiRSSI = apInfo.rssi;
+    } else {
+      diagnosticData.wifiSSID[0] = '\0';
+      diagnosticData.wifiRSSI = WiFi.RSSI();
+    }
+    diagnosticData.ipAddress = (uint32_t)WiFi.localIP();
 #if DIAGNOSTIC_HAS_MDNS
     diagnosticData.mdnsAvailable = mdnsServiceActive;
 #else
     diagnosticData.mdnsAvailable = false;
 #endif
   } else {
-    diagnosticData.wifiSSID = "";
+    diagnosticData.wifiSSID[0] = '\0';
     diagnosticData.wifiRSSI = -127;
-    diagnosticData.ipAddress = "";
+    diagnosticData.ipAddress = 0;
     diagnosticData.mdnsAvailable = false;
   }
   
@@ -3427,14 +3303,6 @@ void collectDiagnosticInfo() {
     diagnosticData.temperature = -999;
   #endif
   
-  diagnosticData.neopixelTested = neopixelTested;
-  diagnosticData.neopixelAvailable = neopixelAvailable;
-  diagnosticData.neopixelResult = neopixelTestResult;
-  
-  diagnosticData.oledTested = oledTested;
-  diagnosticData.oledAvailable = oledAvailable;
-  diagnosticData.oledResult = oledTestResult;
-
   heapHistory[historyIndex] = (float)diagnosticData.freeHeap / 1024.0;
   if (diagnosticData.temperature != -999) {
     tempHistory[historyIndex] = diagnosticData.temperature;
@@ -3492,7 +3360,17 @@ void handleTestGPIO() {
   server.send(200, "application/json", json);
 }
 
+// Tant que wifiMulti.run() associe sur le coeur 0, l'objet WiFi ne doit pas être
+// sollicité en parallèle depuis le serveur (coeur 1)
+static bool rejectWiFiDuringBoot() {
+  if (wifiConnectStageDone()) return false;
+  server.sendHeader("Retry-After", "2");
+  sendOperationError(503, "WiFi connection in progress", {});
+  return true;
+}
+
 void handleWiFiScan() {
+  if (rejectWiFiDuringBoot()) return;
   scanWiFiNetworks();
   String json;
   json.reserve(wifiNetworks.size() * 150 + 20);  // Estimate size to avoid reallocations
@@ -3513,7 +3391,7 @@ void handleI2CScan() {
   scanI2C();
   sendJsonResponse(200, {
     jsonNumberField("count", diagnosticData.i2cCount),
-    jsonStringField("devices", diagnosticData.i2cDevices)
+    jsonStringField("devices", formatI2CDevices(diagnosticData).text)
   });
 }
 
@@ -3858,7 +3736,7 @@ void handleOLEDBoot() {
     return;
   }
 
-  oledShowWiFiStatus(PROJECT_NAME, "System Ready", WiFi.localIP().toString(), 100);
+  oledShowWiFiStatus(PROJECT_NAME, "System Ready", wifiLinkUp() ? WiFi.localIP().toString() : getStableAccessURL(), 100);
   sendOperationSuccess("Boot screen displayed", {});
 }
 
@@ -3920,7 +3798,7 @@ void handleTFTBoot() {
   displayBootSplash();
   
   // Display WiFi info if connected
-  if (WiFi.status() == WL_CONNECTED) {
+  if (wifiLinkUp()) {
     displayWiFiConnected(WiFi.SSID().c_str(), WiFi.localIP().toString().c_str());
   } else {
     displayWiFiStatus("WiFi not connected", TFT_ORANGE);
@@ -4098,6 +3976,74 @@ void handleADCTest() {
   server.send(200, "application/json", json);
 }
 
+// Continuous ADC Handlers
+void handleADCContinuous() {
+  String action = server.hasArg("action") ? server.arg("action") : String("start");
+
+  if (action == "stop") {
+    stopADCSampler();
+  } else {
+    int pins[ADC_SAMPLER_MAX_CHANNELS];
+    uint8_t count = 0;
+    if (server.hasArg("pins")) {
+      String list = server.arg("pins");
+      int start = 0;
+      while (start < (int)list.length() && count < ADC_SAMPLER_MAX_CHANNELS) {
+        int comma = list.indexOf(',', start);
+        if (comma < 0) comma = list.length();
+        String token = list.substring(start, comma);
+        token.trim();
+        if (token.length() > 0) {
+          int pin = token.toInt();
+          if (!isADC1Pin(pin)) {
+            sendOperationError(400, "GPIO " + token + " is not an ADC1 pin", {});
+            return;
+          }
+          pins[count++] = pin;
+        }
+        start = comma + 1;
+      }
+    } else {
+      pins[count++] = LIGHT_SENSOR_PIN;
+    }
+    uint32_t rate = server.hasArg("rate") ? (uint32_t)server.arg("rate").toInt() : ADC_CONTINUOUS_DEFAULT_RATE;
+
+    String error;
+    if (!startADCSampler(pins, count, rate, error)) {
+      sendOperationError(400, error, {});
+      return;
+    }
+  }
+
+  sendJsonResponse(200, {
+    jsonBoolField("running", adcSamplerStatus.running),
+    jsonBoolField("dma", adcSamplerStatus.dma),
+    jsonBoolField("calibrated", adcSamplerStatus.calibrated),
+    jsonNumberField("channels", (uint32_t)adcSamplerStatus.channelCount),
+    jsonNumberField("sample_rate", adcSamplerStatus.sampleRate),
+    jsonNumberField("per_channel_rate", adcSamplerStatus.perChannelRate),
+    jsonStringField("error", adcSamplerStatus.error)
+  });
+}
+
+void handleADCStream() {
+  static ADCStreamSnapshot snapshot;  // ~1.3 KB, off the loop task stack
+  snapshot.count = snapshotADCSamplerStats(snapshot.stats, ADC_SAMPLER_MAX_CHANNELS);
+  bool withHistogram = !server.hasArg("hist") || server.arg("hist") != "0";
+  int fftChannel = server.hasArg("fft") ? server.arg("fft").toInt() : -1;
+
+  for (uint8_t i = 0; i < snapshot.count; i++) {
+    snapshot.hasHistogram[i] = withHistogram && computeADCHistogram(i, snapshot.histograms[i]);
+  }
+  snapshot.spectrumChannel = -1;
+  snapshot.bins = 0;
+  if (fftChannel >= 0 && fftChannel < snapshot.count) {
+    snapshot.spectrumChannel = fftChannel;
+    snapshot.bins = computeADCSpectrum((uint8_t)fftChannel, snapshot.magnitudes, ADC_SAMPLER_FFT_SIZE / 2, snapshot.binHz);
+  }
+  sendADCStream(server, adcSamplerStatus, snapshot);
+}
+
 void handlePWMTest() {
   testPWM();
   sendJsonResponse(200, { jsonStringField("result", pwmTestResult) });
@@ -4259,6 +4205,11 @@ void handleDHTConfig() {
   }
 
   if (updated) {
+    // Le lecteur de fond reprend sur la nouvelle broche / le nouveau type
+    if (dhtSensorStatus.running || ENABLE_DHT_BACKGROUND) {
+      beginDHTSensor(dht_pin, DHT_SENSOR_TYPE);
+      requestDHTRead();
+    }
     sendActionResponse(200,
                        true,
                        String(Texts::ok),
@@ -4272,10 +4223,21 @@ void handleDHTTest() {
   testDHTSensor();
   sendJsonResponse(200, {
     jsonBoolField("success", dhtAvailable),
+    jsonBoolField("pending", dhtSensorStatus.running && dhtSensorStatus.lastResult == DHT_READ_NONE),
     jsonStringField("result", dhtTestResult),
     jsonFloatField("temperature", dhtTemperature, 1),
     jsonFloatField("humidity", dhtHumidity, 1),
-    jsonNumberField("type", static_cast<int>(DHT_SENSOR_TYPE))
+    jsonNumberField("type", static_cast<int>(DHT_SENSOR_TYPE)),
+    jsonFloatField("last_temperature", dhtSensorStatus.lastTemperature, 1),
+    jsonFloatField("last_humidity", dhtSensorStatus.lastHumidity, 1),
+    jsonNumberField("samples", dhtSensorStatus.samples),
+    jsonNumberField("age_ms", dhtSensorStatus.valid ? millis() - dhtSensorStatus.lastReadMs : 0),
+    jsonStringField("last_read", dhtReadResultName(dhtSensorStatus.lastResult)),
+    jsonNumberField("reads", dhtSensorStatus.reads),
+    jsonNumberField("ok_reads", dhtSensorStatus.okReads),
+    jsonNumberField("timeouts", dhtSensorStatus.timeouts),
+    jsonNumberField("frame_errors", dhtSensorStatus.frameErrors),
+    jsonNumberField("checksum_errors", dhtSensorStatus.checksumErrors)
   });
 }
 
@@ -4302,6 +4264,13 @@ void handleDistanceSensorConfig() {
   if (server.hasArg("trig") && server.hasArg("echo")) {
     distance_trig_pin = server.arg("trig").toInt();
     distance_echo_pin = server.arg("echo").toInt();
+    if (distanceSensorStatus.running) {
+      uint16_t rate = distanceSensorStatus.rateHz;
+      stopDistanceSensor();
+      if (distancePinsUsable()) {
+        beginDistanceSensor(distance_trig_pin, distance_echo_pin, rate);
+      }
+    }
     // [OPT-009]: Use OK_STR constant instead of String(Texts::ok)
     sendActionResponse(200, true, OK_STR, {});
   } else {
@@ -4311,13 +4280,66 @@ void handleDistanceSensorConfig() {
 
 void handleDistanceSensorTest() {
   testDistanceSensor();
+  const DistanceSensorStatus& status = distanceSensorStatus;
   sendJsonResponse(200, {
     jsonBoolField("success", distanceSensorAvailable),
+    jsonBoolField("pending", status.running && status.readings + status.timeouts + status.outOfRange == 0),
     jsonStringField("result", distanceSensorTestResult),
-    jsonFloatField("distance", distanceValue, 2)
+    jsonFloatField("distance", distanceValue, 2),
+    jsonFloatField("raw", status.rawCm, 2),
+    jsonFloatField("sound_speed", status.soundSpeed, 1)
   });
 }
 
+// Flux continu : les mesures prises depuis ?since=<seq>, le client renvoie le "next" reçu.
+// Curseur porté par le client : deux onglets ou un script ne se volent plus les échantillons.
+void handleDistanceStream() {
+  uint32_t streamCursor = 0;
+  if (server.hasArg("since")) {
+    streamCursor = strtoul(server.arg("since").c_str(), nullptr, 10);
+  } else if (distanceSensorStatus.sampleSeq > DISTANCE_STREAM_SAMPLES) {
+    streamCursor = distanceSensorStatus.sampleSeq - DISTANCE_STREAM_SAMPLES;  // Sans curseur : l'anneau entier, rien de perdu
+  }
+  String action = server.arg("action");
+  if (action == "start") {
+    if (!distancePinsUsable()) {
+      sendActionResponse(400, false, String(Texts::configuration_invalid), {});
+      return;
+    }
+    long rate = server.hasArg("rate_hz") ? server.arg("rate_hz").toInt() : DISTANCE_SAMPLE_RATE_HZ;
+    beginDistanceSensor(distance_trig_pin, distance_echo_pin, (uint16_t)constrain(rate, 1L, (long)DISTANCE_MAX_RATE_HZ));
+    streamCursor = 0;
+  } else if (action == "stop") {
+    stopDistanceSensor();
+  }
+
+  const DistanceSensorStatus& status = distanceSensorStatus;
+  DistanceSample samples[DISTANCE_STREAM_SAMPLES];
+  uint32_t dropped = 0;
+  uint8_t count = readDistanceSamples(streamCursor, samples, DISTANCE_STREAM_SAMPLES, dropped);
+
+  ArenaText json(512 + count * 32);
+  json.printf("{\"running\":%s,\"trig\":%d,\"echo\":%d,\"rate_hz\":%u,\"valid\":%s,",
+              status.running ? "true" : "false", status.trigPin, status.echoPin, status.rateHz,
+              status.valid ? "true" : "false");
+  json.printf("\"distance_cm\":%.2f,\"median_cm\":%.2f,\"raw_cm\":%.2f,\"echo_us\":%u,",
+              status.filteredCm, status.medianCm, status.rawCm, (unsigned)status.lastEchoUs);
+  json.printf("\"temperature_c\":%.1f,\"temperature_source\":\"%s\",\"sound_speed\":%.1f,",
+              status.temperatureC, status.temperatureFromSensor ? "env" : "default", status.soundSpeed);
+  json.printf("\"triggers\":%lu,\"readings\":%lu,\"timeouts\":%lu,\"out_of_range\":%lu,\"busy_skips\":%lu,\"dropped\":%lu,",
+              (unsigned long)status.triggers, (unsigned long)status.readings, (unsigned long)status.timeouts,
+              (unsigned long)status.outOfRange, (unsigned long)status.busySkips, (unsigned long)dropped);
+  json.printf("\"next\":%lu,", (unsigned long)streamCursor);
+  json += "\"samples\":[";
+  for (uint8_t i = 0; i < count; i++) {
+    json.printf("%s[%lu,%.2f,%.2f]", i ? "," : "", (unsigned long)samples[i].timestampMs,
+                samples[i].rawCm, samples[i].filteredCm);
+  }
+  json += "]}";
+
+  server.send(200, "application/json", json);
+}
+
 void handleMotionSensorConfig() {
   if (server.hasArg("pin")) {
     motion_sensor_pin = server.arg("pin").toInt();
@@ -4338,7 +4360,20 @@ void handleMotionSensorTest() {
 }
 
 // ========== SD CARD HANDLERS ==========
+// La tâche AutoExport (coeur 0) peut avoir un fichier ouvert sur la carte : pas de SD.end()/SD.begin()
+static bool rejectSDDuringAutoExport() {
+  if (!autoExportStatus.busy) return false;
+  sendOperationError(409, "Auto export in progress", {});
+  return true;
+}
+
 void handleSDConfig() {
+  // resetSDTest() appelle SD.end() : jamais sous un fichier ouvert par l'enregistreur ou un test en cours
+  if (sdLoggerStatus.running || sdBenchmarkRunner.running || sdTestRunner.running) {
+    sendOperationError(409, sdLoggerStatus.running ? "SD logger running" : "SD test running", {});
+    return;
+  }
+  if (rejectSDDuringAutoExport()) return;
   if (server.hasArg("miso") && server.hasArg("mosi") &&
       server.hasArg("sclk") && server.hasArg("cs")) {
     sd_miso_pin = server.arg("miso").toInt();
@@ -4354,6 +4389,16 @@ void handleSDConfig() {
 }
 
 void handleSDTest() {
+  if (sdBenchmarkRunner.running) {
+    sendOperationError(409, "SD benchmark running", {});
+    return;
+  }
+  if (sdLoggerStatus.running) {
+    sendOperationError(409, "SD logger running", {});
+    return;
+  }
+  if (!sdTestRunner.running && rejectSDDuringAutoExport()) return;
+
   bool alreadyRunning = false;
   bool started = startAsyncTest(sdTestRunner, runSDTestTask, alreadyRunning, 6144, 1);
 
@@ -4630,25 +4675,81 @@ void handleButtonState() {
 // GPS Handlers
 void handleGPSData() {
   updateGPS();
-  String json;
-  json.reserve(400);
-  json = "{";
-  json += "\"valid\":" + String(gpsData.valid ? "true" : "false") + ",";
-  json += "\"hasFix\":" + String(gpsData.hasFix ? "true" : "false") + ",";
-  json += "\"latitude\":" + String(gpsData.latitude, 6) + ",";
-  json += "\"longitude\":" + String(gpsData.longitude, 6) + ",";
-  json += "\"altitude\":" + String(gpsData.altitude, 2) + ",";
-  json += "\"satellites\":" + String(gpsData.satellites) + ",";
-  json += "\"satellites_used\":" + String(gpsData.satellites_used) + ",";
-  json += "\"hdop\":" + String(gpsData.hdop, 2) + ",";
-  json += "\"speed\":" + String(gpsData.speed, 2) + ",";
-  json += "\"course\":" + String(gpsData.course, 2) + ",";
-  json += "\"fix_type\":\"" + gpsData.fix_type + "\",";
-  json += "\"status\":\"" + gpsData.status_str + "\",";
-  json += "\"time\":\"" + String(gpsData.hour) + ":" + String(gpsData.minute) + ":" + String(gpsData.second) + "\",";
-  json += "\"date\":\"" + String(gpsData.day) + "/" + String(gpsData.month) + "/" + String(gpsData.year) + "\"";
-  json += "}";
-  
+  sendGPSData(server, gpsData);
+}
+
+void handleGPSSatellites() {
+  updateGPS();
+  sendGPSSatellites(server, gpsData, gpsSkyView, gpsAvailable);
+}
+
+void handleGPSProtocol() {
+  String mode = server.arg("mode");
+  if (mode == "ubx") {
+    long baud = server.hasArg("baud") ? server.arg("baud").toInt() : GPS_UBX_BAUD;
+    long rate = server.hasArg("rate_hz") ? server.arg("rate_hz").toInt() : GPS_UBX_RATE_HZ;
+    if (baud < GPS_NMEA_BAUD || baud > 921600 || !startGPSUbx((uint32_t)baud, (uint8_t)constrain(rate, 1L, (long)GPS_UBX_MAX_RATE_HZ))) {
+      sendActionResponse(400, false, String(Texts::configuration_invalid), {});
+      return;
+    }
+  } else if (mode == "nmea") {
+    stopGPSUbx();
+  }
+
+  const GPSProtocolStatus& link = gpsProtocolStatus;
+  ArenaText json(512);
+  json.printf("{\"available\":%s,\"protocol\":\"%s\",\"baud\":%lu,\"rate_hz\":%u,",
+              gpsAvailable ? "true" : "false", gpsProtocolName(link.protocol), (unsigned long)link.baud, link.rateHz);
+  json.printf("\"nav_pvt\":%lu,\"nav_sat\":%lu,\"nav_dop\":%lu,\"nav_interval_ms\":%lu,\"h_acc_m\":%.2f,\"nmea_sentences\":%lu,",
+              (unsigned long)link.navPvt, (unsigned long)link.navSat, (unsigned long)link.navDop, (unsigned long)link.navIntervalMs,
+              link.hAccMm / 1000.0f, (unsigned long)link.nmeaSentences);
+  json.printf("\"ubx_frames\":%lu,\"checksum_errors\":%lu,\"oversize_frames\":%lu,\"config_acks\":%lu,\"config_naks\":%lu,",
+              (unsigned long)link.ubxFrames, (unsigned long)link.ubxChecksumErrors, (unsigned long)link.ubxOversize,
+              (unsigned long)link.configAcks, (unsigned long)link.configNaks);
+  json.printf("\"fallbacks\":%lu,\"fallback_reason\":\"%s\"}", (unsigned long)link.fallbacks, link.fallbackReason);
+
+  server.send(200, "application/json", json);
+}
+
+// PPS timing: ?reset=1 restarts the fit (new drift and jitter window)
+void handleGPSPPS() {
+  if (server.arg("reset") == "1" && gpsTimeStatus.running) {
+    beginGPSTime(gpsTimeStatus.pin);
+  }
+
+  const GPSTimeStatus& pps = gpsTimeStatus;
+  uint64_t utcUs = 0;
+  char utc[32] = "";
+  if (gpsTimeNow(utcUs)) {
+    time_t seconds = (time_t)(utcUs / 1000000ULL);
+    struct tm parts;
+    gmtime_r(&seconds, &parts);
+    snprintf(utc, sizeof(utc), "%04d-%02d-%02dT%02d:%02d:%02d.%06luZ", parts.tm_year + 1900, parts.tm_mon + 1,
+             parts.tm_mday, parts.tm_hour, parts.tm_min, parts.tm_sec, (unsigned long)(utcUs % 1000000ULL));
+  }
+
+  ArenaText json(768);
+  json.printf("{\"available\":%s,\"running\":%s,\"pin\":%d,\"state\":\"%s\",",
+              gpsAvailable ? "true" : "false", pps.running ? "true" : "false", pps.pin, gpsTimeStateName(pps.state));
+  if (utc[0]) {
+    json.printf("\"utc\":\"%s\",\"utc_us\":%llu,", utc, (unsigned long long)utcUs);
+  } else {
+    json += "\"utc\":null,\"utc_us\":null,";
+  }
+  json.printf("\"drift_ppm\":%.3f,\"jitter_rms_us\":%.2f,\"jitter_peak_us\":%.2f,\"fit_edges\":%u,",
+              pps.driftPpm, pps.jitterRmsUs, pps.jitterPeakUs, pps.fitEdges);
+  json.printf("\"cpu_hz\":%lu,\"cpu_drift_ppm\":%.3f,\"last_interval_us\":%lu,\"last_edge_age_ms\":%lu,",
+              (unsigned long)pps.cpuHz, pps.cpuDriftPpm, (unsigned long)pps.lastIntervalUs,
+              (unsigned long)(pps.edges ? millis() - pps.lastEdgeMs : 0));
+  json.printf("\"edges\":%lu,\"accepted\":%lu,\"glitches\":%lu,\"skipped\":%lu,\"resyncs\":%lu,",
+              (unsigned long)pps.edges, (unsigned long)pps.accepted, (unsigned long)pps.glitches,
+              (unsigned long)pps.skipped, (unsigned long)pps.resyncs);
+  json.printf("\"labels\":%lu,\"relabels\":%lu,\"locks\":%lu,\"locked_s\":%lu,",
+              (unsigned long)pps.labels, (unsigned long)pps.relabels, (unsigned long)pps.locks,
+              (unsigned long)(pps.state == GPS_TIME_LOCKED ? (millis() - pps.lockedSinceMs) / 1000 : 0));
+  json.printf("\"system_offset_us\":%ld,\"system_steps\":%lu,\"system_slews\":%lu}",
+              (long)pps.systemOffsetUs, (unsigned long)pps.systemSteps, (unsigned long)pps.systemSlews);
+
   server.send(200, "application/json", json);
 }
 
@@ -4668,23 +4769,7 @@ void handleGPSTest() {
 // Environmental Sensors Handlers
 void handleEnvironmentalSensors() {
   updateEnvironmentalSensors();
-  String json;
-  json.reserve(400);
-  json = "{";
-  json += "\"aht20_available\":" + String(envData.aht20_available ? "true" : "false") + ",";
-  json += "\"bmp280_available\":" + String(envData.bmp280_available ? "true" : "false") + ",";
-  json += "\"temperature_avg\":" + String(envData.temperature_avg, 1) + ",";
-  json += "\"humidity\":" + String(envData.humidity, 1) + ",";
-  json += "\"pressure\":" + String(envData.pressure, 2) + ",";
-  json += "\"altitude\":" + String(envData.altitude, 1) + ",";
-  json += "\"aht20_temp\":" + String(envData.temperature_aht20, 1) + ",";
-  json += "\"bmp280_temp\":" + String(envData.temperature_bmp280, 1) + ",";
-  json += "\"aht20_status\":\"" + envData.aht20_status + "\",";
-  json += "\"bmp280_status\":\"" + envData.bmp280_status + "\",";
-  json += "\"combined_status\":\"" + envData.combined_status + "\"";
-  json += "}";
-  
-  server.send(200, "application/json", json);
+  sendEnvironmentalSensors(server, envData);
 }
 
 void handleEnvironmentalTest() {
@@ -4700,400 +4785,991 @@ void handleEnvironmentalTest() {
   server.send(200, "application/json", json);
 }
 
-void handleBenchmark() {
-  unsigned long cpuTime = benchmarkCPU();
-  unsigned long memTime = benchmarkMemory();
-
-  diagnosticData.cpuBenchmark = cpuTime;
-  diagnosticData.memBenchmark = memTime;
+// GPIO Benchmark Handlers
+static void appendGPIOLatencyJson(String& json, const char* key, const GPIOLatencyStats& stats) {
+  json += "\"";
+  json += key;
+  json += "\":{";
+  json += "\"samples\":" + String(stats.samples) + ",";
+  json += "\"missed\":" + String(stats.missed) + ",";
+  json += "\"min_cycles\":" + String(stats.minCycles) + ",";
+  json += "\"avg_cycles\":" + String(stats.avgCycles) + ",";
+  json += "\"p99_cycles\":" + String(stats.p99Cycles) + ",";
+  json += "\"max_cycles\":" + String(stats.maxCycles) + ",";
+  json += "\"min_ns\":" + String(diagCyclesToNs(stats.minCycles)) + ",";
+  json += "\"avg_ns\":" + String(diagCyclesToNs(stats.avgCycles)) + ",";
+  json += "\"p99_ns\":" + String(diagCyclesToNs(stats.p99Cycles));
+  json += "}";
+}
 
-  // Provide derived benchmark metrics for richer telemetry
-  // Combined memory stress metrics for the benchmark API
-  memoryStressTest();
+static void sendGPIOBenchmarkJson(int statusCode, bool running) {
+  const GPIOBenchmarkData& data = gpioBenchmarkData;
+  String json;
+  json.reserve(900);
+  json = "{";
+  json += "\"running\":" + String(running ? "true" : "false") + ",";
+  json += "\"completed\":" + String(data.completed ? "true" : "false") + ",";
+  json += "\"result\":\"" + jsonEscape(gpioBenchmarkTestResult.c_str()) + "\",";
+  json += "\"out_pin\":" + String(data.outPin) + ",";
+  json += "\"in_pin\":" + String(data.inPin) + ",";
+  json += "\"cpu_mhz\":" + String(data.cpuMhz) + ",";
+  json += "\"iterations\":" + String(data.iterations) + ",";
+  json += "\"toggle_khz\":{";
+  json += "\"digital_write\":" + String(data.digitalWriteKHz, 1) + ",";
+  json += "\"gpio_set_level\":" + String(data.gpioSetLevelKHz, 1) + ",";
+  json += "\"register\":" + String(data.registerKHz, 1);
+  json += "},";
+  json += "\"loopback\":" + String(data.loopbackDetected ? "true" : "false") + ",";
+  appendGPIOLatencyJson(json, "isr_idle", data.idle);
+  json += ",";
+  appendGPIOLatencyJson(json, "isr_wifi_load", data.loaded);
+  json += ",";
+  json += "\"wifi_load_active\":" + String(data.loadActive ? "true" : "false") + ",";
+  json += "\"wifi_load_packets\":" + String(data.loadPackets) + ",";
+  json += "\"duration_ms\":" + String(data.durationMs);
+  json += "}";
 
-  double cpuPerf = 100000.0 / static_cast<double>(cpuTime);
-  double memSpeed = (10000.0 * sizeof(int) * 2.0) / static_cast<double>(memTime);
-  sendJsonResponse(200, {
-    jsonNumberField("cpu", cpuTime),
-    jsonNumberField("memory", memTime),
-    jsonFloatField("cpuPerf", cpuPerf, 2),
-    jsonFloatField("memSpeed", memSpeed, 2),
-    jsonNumberField("allocations", static_cast<unsigned long>(stressAllocationCount)),
-    jsonNumberField("stressDuration", stressDurationMs),
-    jsonStringField("stress", stressTestResult),
-    jsonStringField("allocationsLabel", stressTestResult)
-  });
+  server.send(statusCode, "application/json", json);
 }
 
-void handleStatus() {
-  collectDiagnosticInfo();
-  collectDetailedMemory();
+void handleGPIOBenchmark() {
+  if (rejectWiFiDuringBoot()) return;  // Charge UDP vers la passerelle
+  bool alreadyRunning = false;
+  bool started = startAsyncTest(gpioBenchmarkRunner, runGPIOBenchmark, alreadyRunning, 6144, 1);
 
-  bool wifiConnected = (WiFi.status() == WL_CONNECTED);
-  unsigned long currentUptime = millis();
+  if (started) {
+    sendGPIOBenchmarkJson(202, true);
+    return;
+  }
 
-  String json;
-  json.reserve(400);
-  json = "{";
-  json += "\"connected\":" + String(wifiConnected ? "true" : "false") + ",";
-  json += "\"uptime\":" + String(currentUptime) + ",";
-  json += "\"temperature\":" + String(diagnosticData.temperature) + ",";
-  json += "\"sram\":{\"total\":" + String(detailedMemory.sramTotal) +
-          ",\"free\":" + String(detailedMemory.sramFree) +
-          ",\"used\":" + String(detailedMemory.sramUsed) + "},";
-  json += "\"psram\":{\"total\":" + String(detailedMemory.psramTotal) +
-          ",\"free\":" + String(detailedMemory.psramFree) +
-          ",\"used\":" + String(detailedMemory.psramUsed) + "},";
-  json += "\"fragmentation\":" + String(detailedMemory.fragmentationPercent, 1) + "";
-  json += "}";
+  if (alreadyRunning) {
+    sendGPIOBenchmarkJson(200, true);
+    return;
+  }
 
-  server.send(200, "application/json", json);
+  runGPIOBenchmark();
+  sendGPIOBenchmarkJson(200, false);
 }
 
-void handleSystemInfo() {
-  collectDiagnosticInfo();
-  String json;
-  json.reserve(600);
-  json = "{";
-  json += "\"chipModel\":\"" + diagnosticData.chipModel + "\",";
-  json += "\"chipRevision\":\"" + diagnosticData.chipRevision + "\",";
-  json += "\"cpuCores\":" + String(diagnosticData.cpuCores) + ",";
-  json += "\"cpuFreq\":" + String(diagnosticData.cpuFreqMHz) + ",";
-  json += "\"macAddress\":\"" + diagnosticData.macAddress + "\",";
-  json += "\"ipAddress\":\"" + diagnosticData.ipAddress + "\",";
-  json += "\"mdnsReady\":" + String(diagnosticData.mdnsAvailable ? "true" : "false") + ",";
-  json += "\"uptime\":" + String(diagnosticData.uptime);
-  if (diagnosticData.temperature != -999) {
-    json += ",\"temperature\":" + String(diagnosticData.temperature, 1);
+void handleGPIOBenchmarkResults() {
+  sendGPIOBenchmarkJson(200, gpioBenchmarkRunner.running);
+}
+
+// Logic Analyzer Handlers
+static void sendLogicAnalyzerStatus(int statusCode) {
+  const LogicAnalyzerCapture& cap = laCapture;
+  String pins;
+  for (uint8_t ch = 0; ch < cap.config.channelCount; ch++) {
+    if (ch > 0) pins += ",";
+    pins += String(cap.config.pins[ch]);
   }
-  json += "}";
-  server.send(200, "application/json", json);
+
+  sendJsonResponse(statusCode, {
+    jsonBoolField("running", logicAnalyzerRunner.running),
+    jsonStringField("state", logicAnalyzerStateName(cap.state)),
+    jsonStringField("pins", pins),
+    jsonNumberField("sample_rate", cap.config.sampleRate),
+    jsonNumberField("actual_rate", cap.actualRate),
+    jsonNumberField("samples", cap.length),
+    jsonNumberField("requested_samples", cap.config.sampleCount),
+    jsonStringField("trigger", logicAnalyzerTriggerName(cap.config.trigger)),
+    jsonNumberField("trigger_channel", (uint32_t)cap.config.triggerChannel),
+    jsonNumberField("trigger_index", cap.triggerIndex),
+    jsonNumberField("late_samples", cap.lateSamples),
+    jsonBoolField("psram", cap.inPSRAM),
+    jsonStringField("error", cap.error)
+  });
 }
 
-void handleMemory() {
-  collectDetailedMemory();
+void handleLogicAnalyzerArm() {
+  if (logicAnalyzerRunner.running) {
+    sendOperationError(409, "Capture already running", {});
+    return;
+  }
+
+  LogicAnalyzerConfig config;
+  if (server.hasArg("pins")) {
+    String list = server.arg("pins");
+    int start = 0;
+    while (start < (int)list.length()) {
+      int comma = list.indexOf(',', start);
+      if (comma < 0) comma = list.length();
+      String token = list.substring(start, comma);
+      token.trim();
+      if (token.length() > 0) {
+        if (config.channelCount == LA_MAX_CHANNELS) {
+          sendOperationError(400, "Too many channels (max " + String(LA_MAX_CHANNELS) + ")", {});
+          return;
+        }
+        // toInt() rend 0 pour "abc" : chiffres seuls, puis borné avant la conversion en int8_t
+        // (GPIO_IS_VALID_GPIO ne rejette pas les négatifs sur IDF 4.4)
+        bool numeric = token.length() <= 3;
+        for (unsigned int i = 0; numeric && i < token.length(); i++) {
+          numeric = isdigit((unsigned char)token[i]);
+        }
+        int pin = numeric ? token.toInt() : -1;
+        if (pin < 0 || pin >= GPIO_PIN_COUNT) {
+          sendOperationError(400, "Invalid GPIO " + token, {});
+          return;
+        }
+        config.pins[config.channelCount++] = (int8_t)pin;
+      }
+      start = comma + 1;
+    }
+  } else {
+    // Par défaut : bus I2C puis bus SPI partagé TFT/SD
+    const int8_t defaults[] = {I2C_SDA_PIN, I2C_SCL_PIN, SD_SCLK_PIN, SD_MOSI_PIN, SD_MISO_PIN, SD_CS_PIN};
+    for (int8_t pin : defaults) {
+      config.pins[config.channelCount++] = pin;
+    }
+  }
+  if (server.hasArg("rate")) config.sampleRate = (uint32_t)server.arg("rate").toInt();
+  if (server.hasArg("samples")) config.sampleCount = (uint32_t)server.arg("samples").toInt();
+  if (server.hasArg("trigger")) config.trigger = parseLogicAnalyzerTrigger(server.arg("trigger"));
+  if (server.hasArg("trigger_ch")) config.triggerChannel = (uint8_t)server.arg("trigger_ch").toInt();
+  if (server.hasArg("pretrigger")) config.pretriggerPercent = (uint8_t)server.arg("pretrigger").toInt();
+  if (server.hasArg("timeout")) config.timeoutMs = (uint32_t)server.arg("timeout").toInt();
+
+  String error;
+  if (!configureLogicAnalyzer(config, error)) {
+    sendOperationError(400, error, {});
+    return;
+  }
+
+  bool alreadyRunning = false;
+  if (!startAsyncTest(logicAnalyzerRunner, runLogicAnalyzerCapture, alreadyRunning, 4096, LA_TASK_PRIORITY)) {
+    sendOperationError(alreadyRunning ? 409 : 500, "Unable to start capture task", {});
+    return;
+  }
+  sendLogicAnalyzerStatus(202);
+}
+
+void handleLogicAnalyzerStatus() {
+  sendLogicAnalyzerStatus(200);
+}
+
+void handleLogicAnalyzerCapture() {
+  if (logicAnalyzerRunner.running || laCapture.state != LA_STATE_DONE) {
+    sendOperationError(409, "No completed capture", {
+      jsonStringField("state", logicAnalyzerStateName(laCapture.state))
+    });
+    return;
+  }
+
+  bool vcd = server.hasArg("format") && server.arg("format") == "vcd";
+  static char chunk[1024];
+  uint32_t cursor = 0;
+  size_t len;
+
+  server.sendHeader("Content-Disposition", String("attachment; filename=esp32_la_capture.") + (vcd ? "vcd" : "larl"));
+  server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+  server.send(200, vcd ? "text/plain" : "application/octet-stream", "");
+
+  if (vcd) {
+    len = writeLogicAnalyzerVCDHeader(chunk, sizeof(chunk));
+    server.sendContent(chunk, len);
+    while ((len = encodeLogicAnalyzerVCD(cursor, chunk, sizeof(chunk))) > 0) {
+      server.sendContent(chunk, len);
+    }
+  } else {
+    uint8_t* bytes = reinterpret_cast<uint8_t*>(chunk);
+    len = writeLogicAnalyzerRLEHeader(bytes, sizeof(chunk));
+    server.sendContent(chunk, len);
+    while ((len = encodeLogicAnalyzerRLE(cursor, bytes, sizeof(chunk))) > 0) {
+      server.sendContent(chunk, len);
+    }
+  }
+  server.sendContent("");
+}
+
+// SD Benchmark Handlers
+static void runSDBenchmarkTask() {
+  if (!sdAvailable) {
+    initSD();
+  }
+  if (!sdAvailable || sdSPI == nullptr) {
+    sdBenchmarkData = SDBenchmarkData();
+    sdBenchmarkTestResult = String(Texts::not_detected);
+    return;
+  }
+  runSDBenchmark(*sdSPI, sd_cs_pin);
+  sdAvailable = sdBenchmarkData.remounted;
+}
+
+static void appendSDLatencyJson(String& json, const char* name, const SDLatencyStats& stats) {
+  json += "\"";
+  json += name;
+  json += "\":{\"ops\":" + String(stats.ops);
+  json += ",\"p50\":" + String(stats.p50Us);
+  json += ",\"p95\":" + String(stats.p95Us);
+  json += ",\"p99\":" + String(stats.p99Us);
+  json += ",\"max\":" + String(stats.maxUs) + "}";
+}
+
+static void sendSDBenchmarkJson(int statusCode, bool running) {
+  const SDBenchmarkData& data = sdBenchmarkData;
   String json;
-  json.reserve(500);
+  json.reserve(700 + data.config.clockCount * 2200);
   json = "{";
-  json += "\"heap\":{\"total\":" + String(diagnosticData.heapSize) +
-          ",\"free\":" + String(diagnosticData.freeHeap) +
-          ",\"used\":" + String(diagnosticData.heapSize - diagnosticData.freeHeap) + "},";
+  json += "\"running\":" + String(running ? "true" : "false") + ",";
+  json += "\"completed\":" + String(data.completed ? "true" : "false") + ",";
+  json += "\"result\":\"" + jsonEscape(sdBenchmarkTestResult.c_str()) + "\",";
+  json += "\"card_type\":\"" + sdCardTypeStr + "\",";
+  json += "\"file_kb\":" + String(data.config.fileSizeKB) + ",";
+  json += "\"buffer_bytes\":" + String(data.bufferBytes) + ",";
+  json += "\"remounted\":" + String(data.remounted ? "true" : "false") + ",";
+  json += "\"duration_ms\":" + String(data.durationMs) + ",";
+  json += "\"clocks\":[";
+  for (uint8_t c = 0; c < data.config.clockCount; c++) {
+    const SDClockResult& clock = data.clocks[c];
+    if (c > 0) json += ",";
+    json += "{\"khz\":" + String(clock.clockKHz);
+    json += ",\"mounted\":" + String(clock.mounted ? "true" : "false");
+    json += ",\"sequential\":[";
+    bool first = true;
+    for (uint8_t b = 0; b < SD_BENCH_BLOCK_SIZES; b++) {
+      const SDSequentialResult& seq = clock.sequential[b];
+      if (!seq.tested) continue;
+      if (!first) json += ",";
+      first = false;
+      json += "{\"block\":" + String(seq.blockSize);
+      json += ",\"write_mbps\":" + String(seq.writeMBps, 3);
+      json += ",\"read_mbps\":" + String(seq.readMBps, 3) + ",";
+      appendSDLatencyJson(json, "write_us", seq.writeLatency);
+      json += ",";
+      appendSDLatencyJson(json, "read_us", seq.readLatency);
+      json += "}";
+    }
+    json += "],\"random_4k\":{";
+    json += "\"read_iops\":" + String(clock.randomReadIops, 1);
+    json += ",\"write_iops\":" + String(clock.randomWriteIops, 1) + ",";
+    appendSDLatencyJson(json, "read_us", clock.randomReadLatency);
+    json += ",";
+    appendSDLatencyJson(json, "write_us", clock.randomWriteLatency);
+    json += "}}";
+  }
+  json += "]}";
+
+  server.send(statusCode, "application/json", json);
+}
+
+void handleSDBenchmark() {
+  if (sdTestRunner.running) {
+    sendOperationError(409, "SD test running", {});
+    return;
+  }
+  if (sdLoggerStatus.running) {
+    sendOperationError(409, "SD logger running", {});
+    return;
+  }
+
+  if (!sdBenchmarkRunner.running) {
+    if (rejectSDDuringAutoExport()) return;
+    resetSDBenchmarkConfig();
+    if (server.hasArg("clocks")) {
+      String list = server.arg("clocks");
+      uint8_t count = 0;
+      int start = 0;
+      while (start < (int)list.length() && count < SD_BENCH_MAX_CLOCKS) {
+        int comma = list.indexOf(',', start);
+        if (comma < 0) comma = list.length();
+        long khz = list.substring(start, comma).toInt();
+        if (khz >= 400 && khz <= 80000) {
+          sdBenchmarkConfig.clocksKHz[count++] = (uint32_t)khz;
+        }
+        start = comma + 1;
+      }
+      if (count == 0) {
+        sendOperationError(400, "clocks: 400-80000 kHz", {});
+        return;
+      }
+      sdBenchmarkConfig.clockCount = count;
+    }
+    if (server.hasArg("size_kb")) {
+      long sizeKB = server.arg("size_kb").toInt();
+      sdBenchmarkConfig.fileSizeKB = (uint32_t)(sizeKB < 64 ? 64 : (sizeKB > SD_BENCH_MAX_FILE_SIZE_KB ? SD_BENCH_MAX_FILE_SIZE_KB : sizeKB));
+    }
+    if (server.hasArg("random_ops")) {
+      long ops = server.arg("random_ops").toInt();
+      sdBenchmarkConfig.randomOps = (uint32_t)(ops < 1 ? 1 : (ops > 1000 ? 1000 : ops));
+    }
+  }
+
+  bool alreadyRunning = false;
+  bool started = startAsyncTest(sdBenchmarkRunner, runSDBenchmarkTask, alreadyRunning, 8192, 1);
+
+  if (started) {
+    sendSDBenchmarkJson(202, true);
+    return;
+  }
+
+  if (alreadyRunning) {
+    sendSDBenchmarkJson(200, true);
+    return;
+  }
+
+  runSDBenchmarkTask();
+  sendSDBenchmarkJson(200, false);
+}
+
+void handleSDBenchmarkResults() {
+  sendSDBenchmarkJson(200, sdBenchmarkRunner.running);
+}
+
+// SD Logger Handlers
+static void sendSDLoggerStatus(int statusCode) {
+  const SDLoggerStatus& status = sdLoggerStatus;
+  sendJsonResponse(statusCode, {
+    jsonBoolField("running", status.running),
+    jsonNumberField("interval_ms", status.intervalMs),
+    jsonStringField("file", String(status.fileName)),
+    jsonNumberField("file_bytes", status.fileBytes),
+    jsonNumberField("records_logged", status.recordsLogged),
+    jsonNumberField("records_dropped", status.recordsDropped),
+    jsonNumberField("late_ticks", status.lateTicks),
+    jsonNumberField("buffers_written", status.buffersWritten),
+    jsonNumberField("bytes_written", status.bytesWritten),
+    jsonNumberField("write_errors", status.writeErrors),
+    jsonNumberField("rotations", status.rotations),
+    jsonNumberField("time_syncs", status.timeSyncs),
+    jsonNumberField("last_write_ms", status.lastWriteMs),
+    jsonNumberField("max_write_ms", status.maxWriteMs),
+    jsonStringField("error", status.error)
+  });
+}
+
+void handleSDLogger() {
+  String action = server.hasArg("action") ? server.arg("action") : String("status");
+
+  if (action == "start") {
+    if (rejectWiFiDuringBoot()) return;  // Chaque enregistrement lit le RSSI
+    if (sdTestRunner.running || sdBenchmarkRunner.running) {
+      sendOperationError(409, "SD test running", {});
+      return;
+    }
+    if (rejectSDDuringAutoExport()) return;
+    if (!sdAvailable) {
+      initSD();
+    }
+    uint32_t interval = server.hasArg("interval_ms") ? (uint32_t)server.arg("interval_ms").toInt() : SD_LOG_DEFAULT_INTERVAL_MS;
+    String error;
+    if (!sdAvailable || !startSDLogger(interval, error)) {
+      sendOperationError(sdAvailable ? 409 : 503, sdAvailable ? error : String(Texts::not_detected), {});
+      return;
+    }
+  } else if (action == "stop") {
+    if (!stopSDLogger()) {
+      sendSDLoggerStatus(503);
+      return;
+    }
+  }
+
+  sendSDLoggerStatus(200);
+}
+
+#if ENABLE_MQTT_BRIDGE
+// MQTT Bridge Handlers
+static void sendMqttBridgeStatus(int statusCode) {
+  const MqttBridgeStatus& status = mqttBridgeStatus;
+  uint32_t uptimeMs = getMqttBridgeUptimeMs();
+  sendJsonResponse(statusCode, {
+    jsonBoolField("running", status.running),
+    jsonBoolField("connected", status.connected),
+    jsonStringField("broker", String(MQTT_BROKER) + ":" + String(MQTT_PORT)),
+    jsonStringField("device_id", getMqttDeviceId()),
+    jsonNumberField("qos", status.qos),
+    jsonNumberField("sample_ms", status.sampleIntervalMs),
+    jsonNumberField("publish_ms", status.publishIntervalMs),
+    jsonNumberField("backlog", status.backlogRecords),
+    jsonNumberField("backlog_capacity", status.backlogCapacity),
+    jsonBoolField("backlog_psram", status.backlogInPsram),
+    jsonNumberField("records_sampled", status.recordsSampled),
+    jsonNumberField("records_published", status.recordsPublished),
+    jsonNumberField("records_dropped", status.recordsDropped),
+    jsonNumberField("batches", status.batchesPublished),
+    jsonNumberField("seq", status.batchSeq),
+    jsonNumberField("publish_errors", status.publishErrors),
+    jsonNumberField("retransmits", status.retransmits),
+    jsonNumberField("connects", status.connects),
+    jsonNumberField("disconnects", status.disconnects),
+    jsonNumberField("bytes_published", status.bytesPublished),
+    jsonNumberField("last_payload_bytes", status.lastPayloadBytes),
+    jsonNumberField("publish_p50_us", latencyPercentile(status.publishUs, 50)),
+    jsonNumberField("publish_p99_us", latencyPercentile(status.publishUs, 99)),
+    jsonNumberField("publish_max_us", status.publishUs.maxUs),
+    // Part du temps CPU d'un coeur passée à encoder/publier, en millièmes
+    jsonNumberField("cpu_permille", uptimeMs > 0 ? (uint32_t)(status.busyUs / uptimeMs) : 0),
+    jsonNumberField("client_heap_bytes", status.clientHeapBytes),
+    jsonNumberField("backlog_bytes", status.backlogHeapBytes),
+    jsonNumberField("stack_free_bytes", status.stackFreeBytes),
+    jsonStringField("error", status.error)
+  });
+}
+
+void handleMqttBridge() {
+  String action = server.hasArg("action") ? server.arg("action") : String("status");
+
+  if (action == "start") {
+    uint32_t sampleMs = server.hasArg("sample_ms") ? (uint32_t)server.arg("sample_ms").toInt() : MQTT_SAMPLE_INTERVAL_MS;
+    uint32_t publishMs = server.hasArg("publish_ms") ? (uint32_t)server.arg("publish_ms").toInt() : MQTT_PUBLISH_INTERVAL_MS;
+    uint8_t qos = server.hasArg("qos") ? (uint8_t)server.arg("qos").toInt() : MQTT_QOS;
+    String error;
+    if (!startMqttBridge(sampleMs, publishMs, qos, error)) {
+      sendOperationError(409, error, {});
+      return;
+    }
+  } else if (action == "stop") {
+    stopMqttBridge();
+  }
+
+  sendMqttBridgeStatus(200);
+}
+#endif
+
+#if ENABLE_AUTO_EXPORT
+// Auto Export
+template <size_t N>
+static void copySnapshotText(char (&target)[N], const char* value) {
+  strncpy(target, value ? value : "", N - 1);
+  target[N - 1] = '\0';
+}
+
+template <size_t N>
+static void copySnapshotText(char (&target)[N], const String& value) {
+  copySnapshotText(target, value.c_str());
+}
+
+// loop() uniquement : copie des valeurs en cache (collectDiagnosticInfo toutes les 30 s), aucun accès bus
+static bool captureDiagnosticSnapshot() {
+  uint32_t startUs = micros();
+  DiagnosticSnapshot* snapshot = snapshotBeginWrite();
+  if (!snapshot) {
+    return false;
+  }
+  DiagnosticSnapshot& s = *snapshot;
+  s.capturedMs = millis();
+  copySnapshotText(s.chipModel, diagnosticData.chipModel);
+  snprintf(s.chipRevision, sizeof(s.chipRevision), "%u", (unsigned)diagnosticData.chipRevision);
+  s.cpuCores = diagnosticData.cpuCores;
+  s.cpuFreqMHz = diagnosticData.cpuFreqMHz;
+  s.flashSize = diagnosticData.flashSize;
+  copySnapshotText(s.macAddress, formatMacAddress(diagnosticData.mac).text);
+  copySnapshotText(s.sdkVersion, diagnosticData.sdkVersion);
+  copySnapshotText(s.idfVersion, diagnosticData.idfVersion);
+  s.temperature = diagnosticData.temperature;
+  copySnapshotText(s.resetReason, getResetReason());
+
+  s.heapSize = ESP.getHeapSize();
+  s.freeHeap = ESP.getFreeHeap();
+  s.minFreeHeap = ESP.getMinFreeHeap();
+  s.maxAllocHeap = ESP.getMaxAllocHeap();
+  s.psramSize = ESP.getPsramSize();
+  s.psramFree = ESP.getFreePsram();
+  s.psramLargestBlock = s.psramSize > 0 ? heap_caps_get_largest_free_block(MALLOC_CAP_SPIRAM) : 0;
+
+  copySnapshotText(s.wifiSSID, diagnosticData.wifiSSID);
+  s.wifiRSSI = diagnosticData.wifiRSSI;
+  copySnapshotText(s.ipAddress, formatIPv4(diagnosticData.ipAddress).text);
+  s.mdnsAvailable = diagnosticData.mdnsAvailable;
+
+  s.gpioCount = diagnosticData.totalGPIO;
+  s.i2cCount = diagnosticData.i2cCount;
+  copySnapshotText(s.i2cDevices, formatI2CDevices(diagnosticData).text);
+  const String* results[SNAPSHOT_TEST_COUNT] = {
+    &builtinLedTestResult, &neopixelTestResult, &oledTestResult, &adcTestResult,
+    &pwmTestResult, &sdTestResult, &rotaryTestResult
+  };
+  for (uint8_t i = 0; i < SNAPSHOT_TEST_COUNT; i++) {
+    copySnapshotText(s.testResults[i], *results[i]);
+  }
+  s.cpuBenchmarkUs = diagnosticData.cpuBenchmark;
+  s.memBenchmarkUs = diagnosticData.memBenchmark;
+
+  s.aht20Available = envData.aht20_available;
+  s.bmp280Available = envData.bmp280_available;
+  s.temperatureAht20 = envData.temperature_aht20;
+  s.temperatureBmp280 = envData.temperature_bmp280;
+  s.humidity = envData.humidity;
+  s.pressure = envData.pressure;
+  s.altitude = envData.altitude;
+
+  s.gpsAvailable = gpsAvailable;
+  s.gpsFix = gpsData.hasFix;
+  s.satellites = gpsData.satellites;
+  s.latitude = gpsData.latitude;
+  s.longitude = gpsData.longitude;
+  s.gpsAltitude = gpsData.altitude;
+  s.speed = gpsData.speed;
+  s.hdop = gpsData.hdop;
+  s.gpsDateTime = gpsData.hasTime && gpsData.hasDate;
+  s.year = gpsData.year;
+  s.month = gpsData.month;
+  s.day = gpsData.day;
+  s.hour = gpsData.hour;
+  s.minute = gpsData.minute;
+  s.second = gpsData.second;
+
+  snapshotPublish();
+  autoExportStatus.lastCaptureUs = micros() - startUs;
+  return true;
+}
+
+// Choisi à la demande (tâche loop) : tant que l'export est busy, tests et benchmark SD répondent 409,
+// et l'export part sur LittleFS si l'un d'eux ou l'enregistreur tient déjà la carte
+static bool autoExportSDReady() {
+  return sdAvailable && !sdTestRunner.running && !sdBenchmarkRunner.running && !sdLoggerStatus.running;
+}
+
+static void maintainAutoExport() {
+  static unsigned long nextExportMs = AUTO_EXPORT_DELAY_SECONDS * 1000UL;
+  if ((long)(millis() - nextExportMs) < 0) {
+    return;
+  }
+  nextExportMs = millis() + AUTO_EXPORT_INTERVAL_SECONDS * 1000UL;
+  // Export précédent pas terminé : on le laisse finir, l'instantané publié reste cohérent
+  if (!autoExportStatus.busy && captureDiagnosticSnapshot()) {
+    requestAutoExport(autoExportSDReady());
+  }
+}
+
+void handleAutoExport() {
+  String action = server.hasArg("action") ? server.arg("action") : String("status");
+  if (action == "now") {
+    if (autoExportStatus.busy || !captureDiagnosticSnapshot() || !requestAutoExport(autoExportSDReady())) {
+      sendOperationError(409, "Export in progress", {});
+      return;
+    }
+  }
+
+  const AutoExportStatus& status = autoExportStatus;
+  const DiagnosticSnapshot* snapshot = snapshotAcquire();
+  uint32_t snapshotSeq = snapshot ? snapshot->seq : 0;
+  uint32_t snapshotMs = snapshot ? snapshot->capturedMs : 0;
+  snapshotRelease(snapshot);
+  sendJsonResponse(200, {
+    jsonBoolField("enabled", status.enabled),
+    jsonBoolField("busy", status.busy),
+    jsonStringField("format", autoExportFormatName(status.format)),
+    jsonStringField("storage", status.storage),
+    jsonNumberField("interval_s", (uint32_t)AUTO_EXPORT_INTERVAL_SECONDS),
+    jsonNumberField("snapshot_seq", snapshotSeq),
+    jsonNumberField("snapshot_ms", snapshotMs),
+    jsonNumberField("snapshots", status.snapshots),
+    jsonNumberField("capture_skips", status.captureSkips),
+    jsonNumberField("last_capture_us", status.lastCaptureUs),
+    jsonNumberField("exports", status.exports),
+    jsonNumberField("export_errors", status.exportErrors),
+    jsonNumberField("last_export_ms", status.lastExportMs),
+    jsonNumberField("last_bytes", status.lastBytes),
+    jsonStringField("last_file", status.lastFile),
+    jsonNumberField("files", status.files),
+    jsonNumberField("kept_bytes", status.keptBytes),
+    jsonNumberField("deleted", status.deleted),
+    jsonNumberField("retention_files", (uint32_t)AUTO_EXPORT_RETENTION_FILES)
+  });
+}
+#endif
+
+// Boot Profile Handler
+void handleBootProfile() {
+  sendBootProfile(server, bootProfile, bootGraphComplete());
+}
+
+#if ENABLE_HTTP_METRICS
+// HTTP Metrics Handler - ?reset=1 clears the counters after this report
+void handleHttpMetrics() {
+  sendHttpMetrics(server);
+
+  if (server.hasArg("reset") && server.arg("reset") == "1") {
+    resetHttpMetrics();
+    requestArena.clearStats();
+  }
+}
+#endif
+
+#if ENABLE_TASK_PROFILER
+// Task Profiler Handler - ?reset=1 clears the table (stack minima included)
+void handleTasks() {
+  if (server.hasArg("reset") && server.arg("reset") == "1") {
+    resetTaskProfiler();
+    maintainTaskProfiler();
+  }
+
+  const TaskProfilerData& data = taskProfilerData;
+  if (!data.available) {
+    sendOperationError(503, "uxTaskGetSystemState unavailable (configUSE_TRACE_FACILITY)", {});
+    return;
+  }
+
+#if CONFIG_FREERTOS_UNICORE
+  const uint8_t coreCount = 1;
+#else
+  const uint8_t coreCount = 2;
+#endif
+
+  sendTasks(server, data, coreCount);
+}
+#endif
+
+#if ENABLE_LOOP_MONITOR
+// Loop Monitor Handler - ?reset=1 clears histograms and stalls after this report
+void handleLoopMonitor() {
+  sendLoopMonitor(server, loopMonitorData);
+
+  if (server.hasArg("reset") && server.arg("reset") == "1") {
+    resetLoopMonitor();
+  }
+}
+#endif
+
+#if ENABLE_TRACE
+// Trace Dump Handler - recording paused while streaming; ?clear=1 empties the
+// rings afterwards, ?active=0|1 stops/resumes recording
+void handleTrace() {
+  bool resumeActive = traceIsActive();
+  if (server.hasArg("active")) {
+    resumeActive = server.arg("active") != "0";
+  }
+  traceSetActive(false);
+
+  sendTrace(server);
+
+  if (server.hasArg("clear") && server.arg("clear") == "1") {
+    traceClear();
+  }
+  traceSetActive(resumeActive);
+}
+#endif
+
+#if ENABLE_OPENMETRICS
+// OpenMetrics scrape endpoint: cached values only (no sensor I/O, no
+// collectDiagnosticInfo()), rendered into a fixed chunk buffer
+void handleMetrics() {
+  const bool wifiConnected = wifiLinkUp();
+  sendMetrics(server, wifiConnected, wifiConnected ? (long)WiFi.RSSI() : 0, diagnosticData.temperature,
+              envData, gpsData, gpsAvailable);
+}
+#endif
+
+void handleBenchmark() {
+  unsigned long cpuTime = benchmarkCPU();
+  unsigned long memTime = benchmarkMemory();
+
+  diagnosticData.cpuBenchmark = cpuTime;
+  diagnosticData.memBenchmark = memTime;
+
+  // Provide derived benchmark metrics for richer telemetry
+  // Combined memory stress metrics for the benchmark API
+  memoryStressTest();
+
+  double cpuPerf = 100000.0 / static_cast<double>(cpuTime);
+  double memSpeed = (10000.0 * sizeof(int) * 2.0) / static_cast<double>(memTime);
+  sendJsonResponse(200, {
+    jsonNumberField("cpu", cpuTime),
+    jsonNumberField("memory", memTime),
+    jsonFloatField("cpuPerf", cpuPerf, 2),
+    jsonFloatField("memSpeed", memSpeed, 2),
+    jsonNumberField("allocations", static_cast<unsigned long>(stressAllocationCount)),
+    jsonNumberField("stressDuration", stressDurationMs),
+    jsonStringField("stress", stressTestResult),
+    jsonStringField("allocationsLabel", stressTestResult)
+  });
+}
+
+void handleStatus() {
+  collectDiagnosticInfo();
+  collectDetailedMemory();
+
+  bool wifiConnected = wifiLinkUp();
+  unsigned long currentUptime = millis();
+
+  String json;
+  json.reserve(400);
+  json = "{";
+  json += "\"connected\":" + String(wifiConnected ? "true" : "false") + ",";
+  json += "\"uptime\":" + String(currentUptime) + ",";
+  json += "\"temperature\":" + String(diagnosticData.temperature) + ",";
+  json += "\"sram\":{\"total\":" + String(detailedMemory.sramTotal) +
+          ",\"free\":" + String(detailedMemory.sramFree) +
+          ",\"used\":" + String(detailedMemory.sramUsed) + "},";
   json += "\"psram\":{\"total\":" + String(detailedMemory.psramTotal) +
           ",\"free\":" + String(detailedMemory.psramFree) +
           ",\"used\":" + String(detailedMemory.psramUsed) + "},";
-  json += "\"fragmentation\":" + String(detailedMemory.fragmentationPercent, 1);
+  json += "\"fragmentation\":" + String(detailedMemory.fragmentationPercent, 1) + "";
+  json += "}";
+
+  server.send(200, "application/json", json);
+}
+
+static void appendSystemInfoJson(ArenaText& json) {
+  json.printf("{\"chipModel\":\"%s\",\"chipRevision\":\"%u\",\"cpuCores\":%d,\"cpuFreq\":%u,",
+              diagnosticData.chipModel, (unsigned)diagnosticData.chipRevision,
+              diagnosticData.cpuCores, (unsigned)diagnosticData.cpuFreqMHz);
+  json.printf("\"macAddress\":\"%s\",\"ipAddress\":\"%s\",\"mdnsReady\":%s,\"uptime\":%lu",
+              formatMacAddress(diagnosticData.mac).text, formatIPv4(diagnosticData.ipAddress).text,
+              diagnosticData.mdnsAvailable ? "true" : "false", diagnosticData.uptime);
+  if (diagnosticData.temperature != -999) {
+    json.printf(",\"temperature\":%.1f", diagnosticData.temperature);
+  }
   json += "}";
+}
+
+void handleSystemInfo() {
+  collectDiagnosticInfo();
+  ArenaText json(600);
+  appendSystemInfoJson(json);
+  server.send(200, "application/json", json);
+}
+
+void handleMemory() {
+  collectDetailedMemory();
+  ArenaText json(500);
+  json.printf("{\"heap\":{\"total\":%u,\"free\":%u,\"used\":%u},",
+              (unsigned)diagnosticData.heapSize, (unsigned)diagnosticData.freeHeap,
+              (unsigned)(diagnosticData.heapSize - diagnosticData.freeHeap));
+  json.printf("\"psram\":{\"total\":%u,\"free\":%u,\"used\":%u},",
+              (unsigned)detailedMemory.psramTotal, (unsigned)detailedMemory.psramFree,
+              (unsigned)detailedMemory.psramUsed);
+  json.printf("\"fragmentation\":%.1f}", detailedMemory.fragmentationPercent);
   server.send(200, "application/json", json);
 }
 
 void handleWiFiInfo() {
+  if (rejectWiFiDuringBoot()) return;
   collectDiagnosticInfo();
-  String json;
-  json.reserve(400);
-  json = "{";
-  json += "\"connected\":" + String(WiFi.status() == WL_CONNECTED ? "true" : "false") + ",";
-  json += "\"ssid\":\"" + diagnosticData.wifiSSID + "\",";
-  json += "\"rssi\":" + String(diagnosticData.wifiRSSI) + ",";
-  json += "\"quality_key\":\"" + String(getWiFiSignalQualityKey()) + "\",";
-  json += "\"quality\":\"" + getWiFiSignalQuality() + "\",";
-  json += "\"ip\":\"" + diagnosticData.ipAddress + "\",";
-  json += "\"gateway\":\"" + WiFi.gatewayIP().toString() + "\",";
-  json += "\"dns\":\"" + WiFi.dnsIP().toString() + "\"";
-  json += "}";
+  ArenaText json(400);
+  json.printf("{\"connected\":%s,\"ssid\":\"%s\",\"rssi\":%d,",
+              wifiLinkUp() ? "true" : "false",
+              diagnosticData.wifiSSID, diagnosticData.wifiRSSI);
+  json.printf("\"quality_key\":\"%s\",\"quality\":\"%s\",\"ip\":\"%s\",",
+              getWiFiSignalQualityKey(), getWiFiSignalQuality(), formatIPv4(diagnosticData.ipAddress).text);
+  json.printf("\"gateway\":\"%s\",\"dns\":\"%s\"}",
+              WiFi.gatewayIP().toString().c_str(), WiFi.dnsIP().toString().c_str());
   server.send(200, "application/json", json);
 }
 
 void handlePeripherals() {
   scanI2C();
-  String json;
-  json.reserve(300);
-  json = "{";
-  json += "\"i2c\":{\"count\":" + String(diagnosticData.i2cCount) +
-          ",\"devices\":\"" + diagnosticData.i2cDevices + "\"},";
-  json += "\"gpio\":{\"total\":" + String(diagnosticData.totalGPIO) +
-          ",\"list\":\"" + diagnosticData.gpioList + "\"}";
-  json += "}";
+  ArenaText json(300);
+  json.printf("{\"i2c\":{\"count\":%d,\"devices\":\"%s\"},",
+              diagnosticData.i2cCount, formatI2CDevices(diagnosticData).text);
+  json.printf("\"gpio\":{\"total\":%d,\"list\":\"%s\"}}",
+              diagnosticData.totalGPIO, diagnosticData.gpioList);
   server.send(200, "application/json", json);
 }
 
+static void appendLedsInfoJson(ArenaText& json) {
+  json.printf("{\"builtin\":{\"pin\":%d,\"status\":\"%s\"},",
+              (int)BUILTIN_LED_PIN, builtinLedTestResult.c_str());
+  json.printf("\"neopixel\":{\"pin\":%d,\"count\":%d,\"status\":\"%s\"}}",
+              (int)LED_PIN, (int)LED_COUNT, neopixelTestResult.c_str());
+}
+
 void handleLedsInfo() {
-  String json;
-  json.reserve(400);
-  json = "{";
-  json += "\"builtin\":{\"pin\":" + String(BUILTIN_LED_PIN) +
-          ",\"status\":\"" + builtinLedTestResult + "\"},";
-  json += "\"neopixel\":{\"pin\":" + String(LED_PIN) +
-          ",\"count\":" + String(LED_COUNT) +
-          ",\"status\":\"" + neopixelTestResult + "\"}";
-  json += "}";
+  ArenaText json(400);
+  appendLedsInfoJson(json);
   server.send(200, "application/json", json);
 }
 
-void handleScreensInfo() {
-  String json;
-  json.reserve(900);  // Increased for driver field
-  json = "{";
-  json += "\"oled\":{\"available\":" + String(oledAvailable ? "true" : "false") +
-          ",\"status\":\"" + oledTestResult + "\",";
-  json += "\"pins\":{\"sda\":" + String(i2c_sda) + ",\"scl\":" + String(i2c_scl) + "},";
-  json += "\"rotation\":" + String(oledRotation) + ",";
-  json += "\"width\":" + String(oledWidth) + ",\"height\":" + String(oledHeight) + "}";
+static void appendScreensInfoJson(ArenaText& json) {
+  json.printf("{\"oled\":{\"available\":%s,\"status\":\"%s\",",
+              oledAvailable ? "true" : "false", oledTestResult.c_str());
+  json.printf("\"pins\":{\"sda\":%d,\"scl\":%d},\"rotation\":%u,\"width\":%d,\"height\":%d}",
+              i2c_sda, i2c_scl, (unsigned)oledRotation, oledWidth, oledHeight);
 
   #if ENABLE_TFT_DISPLAY
-  json += ",\"tft\":{\"available\":true,";
-  json += "\"status\":\"" + String(tftTestResult.length() > 0 ? tftTestResult : "Ready") + "\",";
-  json += "\"driver\":\"" + tftDriver + "\",";  // v3.30.0: Current TFT driver
-  json += "\"width\":" + String(tftWidth) + ",\"height\":" + String(tftHeight) + ",";
-  json += "\"rotation\":" + String(tftRotation) + ",";
-  json += "\"pins\":{\"miso\":" + String(tftMISO) + ",\"mosi\":" + String(tftMOSI) + ",\"sclk\":" + String(tftSCLK) +
-          ",\"cs\":" + String(tftCS) + ",\"dc\":" + String(tftDC) + ",\"rst\":" + String(tftRST) +
-          ",\"bl\":" + String(tftBL) + "}}";
+  json.printf(",\"tft\":{\"available\":true,\"status\":\"%s\",\"driver\":\"%s\",",
+              tftTestResult.length() > 0 ? tftTestResult.c_str() : "Ready",
+              tftDriver.c_str());  // v3.30.0: Current TFT driver
+  json.printf("\"width\":%d,\"height\":%d,\"rotation\":%d,", tftWidth, tftHeight, tftRotation);
+  json.printf("\"pins\":{\"miso\":%d,\"mosi\":%d,\"sclk\":%d,\"cs\":%d,\"dc\":%d,\"rst\":%d,\"bl\":%d}}",
+              tftMISO, tftMOSI, tftSCLK, tftCS, tftDC, tftRST, tftBL);
   #else
   json += ",\"tft\":{\"available\":false,\"status\":\"Not enabled\"}";
   #endif
 
   json += "}";
-  server.send(200, "application/json", json);
 }
 
-void handleOverview() {
-  collectDiagnosticInfo();
-  collectDetailedMemory();
-  scanI2C();
-
-  String json;
-  json.reserve(2500);  // Reserve memory for the complete overview response
-  json = "{";
+void handleScreensInfo() {
+  ArenaText json(900);  // Increased for driver field
+  appendScreensInfoJson(json);
+  server.send(200, "application/json", json);
+}
 
-  // Chip info
-  json += "\"chip\":{";
-  json += "\"model\":\"" + diagnosticData.chipModel + "\",";
-  json += "\"revision\":\"" + diagnosticData.chipRevision + "\",";
-  json += "\"cores\":" + String(diagnosticData.cpuCores) + ",";
-  json += "\"freq\":" + String(diagnosticData.cpuFreqMHz) + ",";
-  json += "\"mac\":\"" + diagnosticData.macAddress + "\",";
-  json += "\"uptime\":" + String(diagnosticData.uptime);
+static void appendOverviewChipJson(ArenaText& json) {
+  json.printf("{\"model\":\"%s\",\"revision\":\"%u\",\"cores\":%d,\"freq\":%u,",
+              diagnosticData.chipModel, (unsigned)diagnosticData.chipRevision,
+              diagnosticData.cpuCores, (unsigned)diagnosticData.cpuFreqMHz);
+  json.printf("\"mac\":\"%s\",\"uptime\":%lu", formatMacAddress(diagnosticData.mac).text, diagnosticData.uptime);
   if (diagnosticData.temperature != -999) {
-    json += ",\"temperature\":" + String(diagnosticData.temperature, 1);
+    json.printf(",\"temperature\":%.1f", diagnosticData.temperature);
   } else {
     json += ",\"temperature\":-999";
   }
-  json += "},";
+  json += "}";
+}
 
-  // Memory info
-  json += "\"memory\":{";
-  json += "\"flash\":{\"real\":" + String(detailedMemory.flashSizeReal) +
-          ",\"type\":\"" + getFlashType() + "\",\"speed\":\"" + getFlashSpeed() + "\"},";
-  json += "\"sram\":{\"total\":" + String(detailedMemory.sramTotal) +
-          ",\"free\":" + String(detailedMemory.sramFree) +
-          ",\"used\":" + String(detailedMemory.sramUsed) + "},";
-  json += "\"psram\":{\"total\":" + String(detailedMemory.psramTotal) +
-          ",\"free\":" + String(detailedMemory.psramFree) +
-          ",\"used\":" + String(detailedMemory.psramUsed) + "},";
-  json += "\"fragmentation\":" + String(detailedMemory.fragmentationPercent, 1);
-  json += "},";
+static void appendOverviewMemoryJson(ArenaText& json) {
+  json.printf("{\"flash\":{\"real\":%u,\"type\":\"%s\",\"speed\":\"%s\"},",
+              (unsigned)detailedMemory.flashSizeReal, getFlashType(), getFlashSpeed());
+  json.printf("\"sram\":{\"total\":%u,\"free\":%u,\"used\":%u},",
+              (unsigned)detailedMemory.sramTotal, (unsigned)detailedMemory.sramFree,
+              (unsigned)detailedMemory.sramUsed);
+  json.printf("\"psram\":{\"total\":%u,\"free\":%u,\"used\":%u},",
+              (unsigned)detailedMemory.psramTotal, (unsigned)detailedMemory.psramFree,
+              (unsigned)detailedMemory.psramUsed);
+  json.printf("\"fragmentation\":%.1f}", detailedMemory.fragmentationPercent);
+}
+
+// WiFi info - Use translation key instead of translated string
+static void appendOverviewWiFiJson(ArenaText& json) {
+  json.printf("{\"ssid\":\"%s\",\"rssi\":%d,", diagnosticData.wifiSSID, diagnosticData.wifiRSSI);
+  json.printf("\"quality_key\":\"%s\",", getWiFiSignalQualityKey());  // Return key, not translated string
+  json.printf("\"quality\":\"%s\",", getWiFiSignalQuality());  // Keep for backward compatibility
+  json.printf("\"ip\":\"%s\"}", formatIPv4(diagnosticData.ipAddress).text);
+}
+
+static void appendOverviewGPIOJson(ArenaText& json) {
+  json.printf("{\"total\":%d,\"i2c_count\":%d,\"i2c_devices\":\"%s\"}",
+              diagnosticData.totalGPIO, diagnosticData.i2cCount, formatI2CDevices(diagnosticData).text);
+}
+
+// Dashboard sections: one bit per ?fields= name, collected once per request
+enum DashboardField : uint8_t {
+  DASHBOARD_SYSTEM = 1 << 0,
+  DASHBOARD_CHIP = 1 << 1,
+  DASHBOARD_MEMORY = 1 << 2,
+  DASHBOARD_WIFI = 1 << 3,
+  DASHBOARD_GPIO = 1 << 4,
+  DASHBOARD_LEDS = 1 << 5,
+  DASHBOARD_SCREENS = 1 << 6
+};
 
-  // WiFi info - Use translation key instead of translated string
-  json += "\"wifi\":{";
-  json += "\"ssid\":\"" + diagnosticData.wifiSSID + "\",";
-  json += "\"rssi\":" + String(diagnosticData.wifiRSSI) + ",";
-  json += "\"quality_key\":\"" + String(getWiFiSignalQualityKey()) + "\",";  // Return key, not translated string
-  json += "\"quality\":\"" + getWiFiSignalQuality() + "\",";  // Keep for backward compatibility
-  json += "\"ip\":\"" + diagnosticData.ipAddress + "\"";
-  json += "},";
+struct DashboardSection {
+  const char* name;
+  uint8_t bit;
+  void (*append)(ArenaText& json);
+};
 
-  // GPIO info
-  json += "\"gpio\":{";
-  json += "\"total\":" + String(diagnosticData.totalGPIO) + ",";
-  json += "\"i2c_count\":" + String(diagnosticData.i2cCount) + ",";
-  json += "\"i2c_devices\":\"" + diagnosticData.i2cDevices + "\"";
-  json += "}";
+static const DashboardSection dashboardSections[] = {
+  {"system", DASHBOARD_SYSTEM, appendSystemInfoJson},
+  {"chip", DASHBOARD_CHIP, appendOverviewChipJson},
+  {"memory", DASHBOARD_MEMORY, appendOverviewMemoryJson},
+  {"wifi", DASHBOARD_WIFI, appendOverviewWiFiJson},
+  {"gpio", DASHBOARD_GPIO, appendOverviewGPIOJson},
+  {"leds", DASHBOARD_LEDS, appendLedsInfoJson},
+  {"screens", DASHBOARD_SCREENS, appendScreensInfoJson},
+};
+
+static const uint8_t DASHBOARD_ALL = DASHBOARD_SYSTEM | DASHBOARD_CHIP | DASHBOARD_MEMORY | DASHBOARD_WIFI |
+                                     DASHBOARD_GPIO | DASHBOARD_LEDS | DASHBOARD_SCREENS;
 
+static void sendDashboard(uint8_t fields) {
+  // Chaque source n'est collectée qu'une fois, quel que soit le nombre de sections qui la lisent
+  if (fields & (DASHBOARD_SYSTEM | DASHBOARD_CHIP | DASHBOARD_WIFI | DASHBOARD_GPIO)) {
+    collectDiagnosticInfo();
+  }
+  if (fields & DASHBOARD_MEMORY) {
+    collectDetailedMemory();
+  }
+  if (fields & DASHBOARD_GPIO) {
+    scanI2C();
+  }
+
+  // Texte dans l'arène de la requête : aucune allocation sur le tas à chaque rafraîchissement
+  ArenaText json(3500);  // Reserve memory for all sections (overview ~2 KB, screens ~0.5 KB)
+  json += "{";
+  bool first = true;
+  for (const DashboardSection& section : dashboardSections) {
+    if (!(fields & section.bit)) {
+      continue;
+    }
+    if (!first) {
+      json += ",";
+    }
+    first = false;
+    json += "\"";
+    json += section.name;
+    json += "\":";
+    section.append(json);
+  }
   json += "}";
   server.send(200, "application/json", json);
 }
 
+void handleOverview() {
+  sendDashboard(DASHBOARD_CHIP | DASHBOARD_MEMORY | DASHBOARD_WIFI | DASHBOARD_GPIO);
+}
+
+// /api/dashboard?fields=chip,memory,wifi,gpio - toutes les sections si fields est absent
+void handleDashboard() {
+  uint8_t fields = DASHBOARD_ALL;
+  // Une seule copie de l'argument ; les noms sont comparés en place, sans substring()
+  const String list = server.arg("fields");
+  if (list.length() > 0) {
+    fields = 0;
+    const char* cursor = list.c_str();
+    while (*cursor) {
+      const char* comma = strchr(cursor, ',');
+      const char* end = comma ? comma : cursor + strlen(cursor);
+      const char* start = cursor;
+      while (start < end && isspace((unsigned char)*start)) start++;
+      const char* stop = end;
+      while (stop > start && isspace((unsigned char)stop[-1])) stop--;
+      const size_t nameLen = (size_t)(stop - start);
+      if (nameLen > 0) {
+        uint8_t bit = 0;
+        for (const DashboardSection& section : dashboardSections) {
+          if (strlen(section.name) == nameLen && strncmp(start, section.name, nameLen) == 0) {
+            bit = section.bit;
+            break;
+          }
+        }
+        if (bit == 0) {
+          sendOperationError(400, "Unknown field: " + String(start).substring(0, nameLen),
+                             {jsonStringField("fields", "system,chip,memory,wifi,gpio,leds,screens")});
+          return;
+        }
+        fields |= bit;
+      }
+      if (!comma) break;
+      cursor = comma + 1;
+    }
+    if (fields == 0) {
+      sendOperationError(400, "No field requested");
+      return;
+    }
+  }
+  sendDashboard(fields);
+}
+
 void handleMemoryDetails() {
   collectDetailedMemory();
-
-  String json;
-  json.reserve(450);  // Reserve memory to avoid reallocations
-  json = "{\"flash\":{\"real\":" + String(detailedMemory.flashSizeReal) + ",\"chip\":" + String(detailedMemory.flashSizeChip) + "},";
-  json += "\"psram\":{\"available\":" + String(detailedMemory.psramAvailable ? "true" : "false") +
-          ",\"configured\":" + String(detailedMemory.psramConfigured ? "true" : "false") +
-          ",\"supported\":" + String(detailedMemory.psramBoardSupported ? "true" : "false") +
-          ",\"type\":\"" + String(detailedMemory.psramType ? detailedMemory.psramType : Texts::unknown.str()) + "\"" +
-          ",\"total\":" + String(detailedMemory.psramTotal) + ",\"free\":" + String(detailedMemory.psramFree) + "},";
-  json += "\"sram\":{\"total\":" + String(detailedMemory.sramTotal) + ",\"free\":" + String(detailedMemory.sramFree) + "},";
-  json += "\"fragmentation\":" + String(detailedMemory.fragmentationPercent, 1) + ",\"status\":\"" + detailedMemory.memoryStatus + "\"}";
-
-  server.send(200, "application/json", json);
+  sendMemoryDetails(server, detailedMemory);
 }
 
 // ========== EXPORTS ==========
+// Valeurs Wi-Fi / ESP-IDF résolues ici, les builders restent testables sur l'hôte
+static ExportContext exportContext() {
+  const bool linkUp = wifiLinkUp();
+  return {
+    diagnosticData, detailedMemory, envData, gpsData, gpsAvailable,
+    {builtinLedTestResult, neopixelTestResult, oledTestResult, adcTestResult,
+     pwmTestResult, sdTestResult, rotaryTestResult, stressTestResult},
+    spiInfo,
+    getFlashType(), getFlashSpeed(), getWiFiSignalQuality(), getStableAccessURL(),
+    linkUp ? WiFi.subnetMask().toString() : String("0.0.0.0"),
+    linkUp ? WiFi.gatewayIP().toString() : String("0.0.0.0"),
+    linkUp ? WiFi.dnsIP().toString() : String("0.0.0.0"),
+    getResetReason()
+  };
+}
+
 void handleExportTXT() {
   collectDiagnosticInfo();
   collectDetailedMemory();
-
-  String txt;
-  txt.reserve(4500);  // Reserve memory to avoid reallocations during export
-  txt = "========================================\r\n";
-  txt += String(Texts::title) + " " + String(Texts::version) + String(PROJECT_VERSION) + "\r\n";
-  txt += "========================================\r\n\r\n";
-  
-  txt += "=== CHIP ===\r\n";
-  txt += String(Texts::model) + ": " + diagnosticData.chipModel + " " + String(Texts::revision) + diagnosticData.chipRevision + "\r\n";
-  txt += "CPU: " + String(diagnosticData.cpuCores) + " " + String(Texts::cores) + " @ " + String(diagnosticData.cpuFreqMHz) + " MHz\r\n";
-  txt += "MAC WiFi: " + diagnosticData.macAddress + "\r\n";
-  txt += "SDK: " + diagnosticData.sdkVersion + "\r\n";
-  txt += "ESP-IDF: " + diagnosticData.idfVersion + "\r\n";
-  if (diagnosticData.temperature != -999) {
-    txt += String(Texts::cpu_temp) + ": " + String(diagnosticData.temperature, 1) + " °C\r\n";
-  }
-  txt += "\r\n";
-  
-  txt += "=== " + String(Texts::memory_details) + " ===\r\n";
-  txt += "Flash (" + String(Texts::board) + "): " + String(detailedMemory.flashSizeReal / 1048576.0, 2) + " MB\r\n";
-  txt += "Flash (IDE): " + String(detailedMemory.flashSizeChip / 1048576.0, 2) + " MB\r\n";
-  txt += String(Texts::flash_type) + ": " + getFlashType() + " @ " + getFlashSpeed() + "\r\n";
-  txt += "PSRAM: " + String(detailedMemory.psramTotal / 1048576.0, 2) + " MB";
-  if (detailedMemory.psramAvailable) {
-    txt += " (" + String(Texts::free) + ": " + String(detailedMemory.psramFree / 1048576.0, 2) + " MB)\r\n";
-  } else if (detailedMemory.psramBoardSupported) {
-    String psramHint = String(Texts::enable_psram_hint);
-    psramHint.replace("%TYPE%", detailedMemory.psramType ? detailedMemory.psramType : "PSRAM");
-    txt += " (" + String(Texts::supported_not_enabled) + " - " + psramHint + ")\r\n";
-  } else {
-    txt += " (" + String(Texts::not_detected) + ")\r\n";
-  }
-  txt += "SRAM: " + String(detailedMemory.sramTotal / 1024.0, 2) + " KB";
-  txt += " (" + String(Texts::free) + ": " + String(detailedMemory.sramFree / 1024.0, 2) + " KB)\r\n";
-  txt += String(Texts::memory_fragmentation) + ": " + String(detailedMemory.fragmentationPercent, 1) + "%\r\n";
-  txt += String(Texts::memory_status) + ": " + detailedMemory.memoryStatus + "\r\n";
-  txt += "\r\n";
-  
-  txt += "=== WIFI ===\r\n";
-  txt += "SSID: " + diagnosticData.wifiSSID + "\r\n";
-  txt += "RSSI: " + String(diagnosticData.wifiRSSI) + " dBm (" + getWiFiSignalQuality() + ")\r\n";
-  txt += "IP: " + diagnosticData.ipAddress + "\r\n";
-  txt += "Lien constant: " + getStableAccessURL() + " (" + String(diagnosticData.mdnsAvailable ? "actif" : "en attente") + ")\r\n";
-  txt += String(Texts::subnet_mask) + ": " + WiFi.subnetMask().toString() + "\r\n";
-  txt += String(Texts::gateway) + ": " + WiFi.gatewayIP().toString() + "\r\n";
-  txt += "DNS: " + WiFi.dnsIP().toString() + "\r\n";
-  txt += "\r\n";
-
-  txt += "=== GPIO ===\r\n";
-  txt += String(Texts::total_gpio) + ": " + String(diagnosticData.totalGPIO) + " " + String(Texts::pins) + "\r\n";
-  txt += String(Texts::gpio_list) + ": " + diagnosticData.gpioList + "\r\n";
-  txt += "\r\n";
-  
-  txt += "=== " + String(Texts::i2c_peripherals) + " ===\r\n";
-  txt += String(Texts::device_count) + ": " + String(diagnosticData.i2cCount) + " - " + diagnosticData.i2cDevices + "\r\n";
-  txt += "SPI: " + spiInfo + "\r\n";
-  txt += "\r\n";
-  
-  txt += "=== " + String(Texts::test) + " ===\r\n";
-  txt += String(Texts::builtin_led) + ": " + builtinLedTestResult + "\r\n";
-  txt += String(Texts::neopixel) + ": " + neopixelTestResult + "\r\n";
-  txt += "OLED: " + oledTestResult + "\r\n";
-  txt += "ADC: " + adcTestResult + "\r\n";
-  txt += "PWM: " + pwmTestResult + "\r\n";
-  txt += "SD Card: " + sdTestResult + "\r\n";
-  txt += "Rotary Encoder: " + rotaryTestResult + "\r\n";
-  txt += "\r\n";
-  
-  txt += "=== " + String(Texts::performance_bench) + " ===\r\n";
-  if (diagnosticData.cpuBenchmark > 0) {
-    txt += "CPU: " + String(diagnosticData.cpuBenchmark) + " us (" + String(100000.0 / diagnosticData.cpuBenchmark, 2) + " MFLOPS)\r\n";
-    txt += String(Texts::memory_benchmark) + ": " + String(diagnosticData.memBenchmark) + " us\r\n";
-  } else {
-    txt += String(Texts::not_tested) + "\r\n";
-  }
-  txt += "Stress test: " + stressTestResult + "\r\n";
-  txt += "\r\n";
-  
-  unsigned long seconds = diagnosticData.uptime / 1000;
-  unsigned long minutes = seconds / 60;
-  unsigned long hours = minutes / 60;
-  unsigned long days = hours / 24;
-  // === ENVIRONNEMENT ===
-  txt += "=== ENVIRONNEMENT ===\r\n";
-  txt += "AHT20: ";
-  txt += envData.aht20_available ? "OK" : "Non détecté";
-  txt += "\r\n";
-  txt += "  Température (AHT20): ";
-  txt += (envData.temperature_aht20 != -999.0 ? String(envData.temperature_aht20, 1) + " °C" : "N/A");
-  txt += "\r\n";
-  txt += "  Humidité: ";
-  txt += (envData.humidity != -999.0 ? String(envData.humidity, 1) + " %" : "N/A");
-  txt += "\r\n";
-  txt += "  Statut: " + envData.aht20_status + "\r\n";
-  txt += "BMP280: ";
-  txt += envData.bmp280_available ? "OK" : "Non détecté";
-  txt += "\r\n";
-  txt += "  Température (BMP280): ";
-  txt += (envData.temperature_bmp280 != -999.0 ? String(envData.temperature_bmp280, 1) + " °C" : "N/A");
-  txt += "\r\n";
-  txt += "  Pression: ";
-  txt += (envData.pressure != -999.0 ? String(envData.pressure, 1) + " hPa" : "N/A");
-  txt += "\r\n";
-  txt += "  Altitude: ";
-  txt += (envData.altitude != -999.0 ? String(envData.altitude, 1) + " m" : "N/A");
-  txt += "\r\n";
-  txt += "  Statut: " + envData.bmp280_status + "\r\n";
-  txt += "Moyenne température: ";
-  txt += (envData.temperature_avg != -999.0 ? String(envData.temperature_avg, 1) + " °C" : "N/A");
-  txt += "\r\n";
-  txt += "Statut global: " + envData.combined_status + "\r\n";
-  txt += "\r\n";
-
-  // === GPS ===
-  txt += "=== GPS ===\r\n";
-  txt += "Module: ";
-  txt += gpsAvailable ? "OK" : "Non détecté";
-  txt += "\r\n";
-  txt += "  Statut: " + gpsData.status_str + "\r\n";
-  txt += "  Fix: ";
-  txt += gpsData.hasFix ? "Oui" : "Non";
-  txt += "\r\n";
-  txt += "  Satellites: ";
-  txt += String(gpsData.satellites);
-  txt += "\r\n";
-  txt += "  Latitude: ";
-  txt += (gpsData.hasFix ? String(gpsData.latitude, 6) : "N/A");
-  txt += "\r\n";
-  txt += "  Longitude: ";
-  txt += (gpsData.hasFix ? String(gpsData.longitude, 6) : "N/A");
-  txt += "\r\n";
-  txt += "  Altitude: ";
-  txt += (gpsData.hasFix ? String(gpsData.altitude, 1) + " m" : "N/A");
-  txt += "\r\n";
-  txt += "  Vitesse: ";
-  txt += (gpsData.hasFix ? String(gpsData.speed, 2) + " noeuds" : "N/A");
-  txt += "\r\n";
-  txt += "  HDOP: ";
-  txt += (gpsData.hasFix ? String(gpsData.hdop, 2) : "N/A");
-  txt += "\r\n";
-  txt += "  Date/Heure: ";
-  if (gpsData.hasTime && gpsData.hasDate) {
-    txt += String(gpsData.day) + "/" + String(gpsData.month) + "/" + String(gpsData.year) + " ";
-    txt += (gpsData.hour < 10 ? "0" : "") + String(gpsData.hour) + ":";
-    txt += (gpsData.minute < 10 ? "0" : "") + String(gpsData.minute) + ":";
-    txt += (gpsData.second < 10 ? "0" : "") + String(gpsData.second);
-  } else {
-    txt += "N/A";
-  }
-  txt += "\r\n\r\n";
-
-  // === SYSTEME ===
-  txt += "=== SYSTEM ===\r\n";
-  txt += String(Texts::uptime) + ": " + String(days) + "d " + String(hours % 24) + "h " + String(minutes % 60) + "m\r\n";
-  txt += String(Texts::last_reset) + ": " + getResetReason() + "\r\n";
-  txt += "\r\n";
-  txt += "========================================\r\n";
-  txt += String(Texts::export_generated) + " " + String(millis()/1000) + "s " + String(Texts::export_after_boot) + "\r\n";
-  txt += "========================================\r\n";
-
+  String txt = buildExportTXT(exportContext());
   server.sendHeader("Content-Disposition", "attachment; filename=esp32_diagnostic_v"+ String(PROJECT_VERSION) +".txt");
   server.send(200, "text/plain; charset=utf-8", txt);
 }
@@ -5101,134 +5777,7 @@ void handleExportTXT() {
 void handleExportJSON() {
   collectDiagnosticInfo();
   collectDetailedMemory();
-  String stableUrl = getStableAccessURL();
-
-  String json;
-  json.reserve(3500);  // Reserve memory to avoid reallocations during export
-  json = "{";
-  json += "\"chip\":{";
-  json += "\"model\":\"" + diagnosticData.chipModel + "\",";
-  json += "\"revision\":\"" + diagnosticData.chipRevision + "\",";
-  json += "\"cores\":" + String(diagnosticData.cpuCores) + ",";
-  json += "\"freq_mhz\":" + String(diagnosticData.cpuFreqMHz) + ",";
-  json += "\"mac\":\"" + diagnosticData.macAddress + "\",";
-  json += "\"sdk\":\"" + diagnosticData.sdkVersion + "\",";
-  json += "\"idf\":\"" + diagnosticData.idfVersion + "\"";
-  if (diagnosticData.temperature != -999) {
-    json += ",\"temperature\":" + String(diagnosticData.temperature, 1);
-  }
-  json += "},";
-  
-  json += "\"memory\":{";
-  json += "\"flash_real_mb\":" + String(detailedMemory.flashSizeReal / 1048576.0, 2) + ",";
-  json += "\"flash_config_mb\":" + String(detailedMemory.flashSizeChip / 1048576.0, 2) + ",";
-  json += "\"flash_type\":\"" + getFlashType() + "\",";
-  json += "\"flash_speed\":\"" + getFlashSpeed() + "\",";
-  json += "\"psram_mb\":" + String(detailedMemory.psramTotal / 1048576.0, 2) + ",";
-  json += "\"psram_free_mb\":" + String(detailedMemory.psramFree / 1048576.0, 2) + ",";
-  json += "\"psram_available\":" + String(detailedMemory.psramAvailable ? "true" : "false") + ",";
-  json += "\"psram_supported\":" + String(detailedMemory.psramBoardSupported ? "true" : "false") + ",";
-  json += "\"psram_type\":\"" + String(detailedMemory.psramType ? detailedMemory.psramType : Texts::unknown.str()) + "\",";
-  json += "\"sram_kb\":" + String(detailedMemory.sramTotal / 1024.0, 2) + ",";
-  json += "\"sram_free_kb\":" + String(detailedMemory.sramFree / 1024.0, 2) + ",";
-  json += "\"fragmentation\":" + String(detailedMemory.fragmentationPercent, 1) + ",";
-  json += "\"status\":\"" + detailedMemory.memoryStatus + "\"";
-  json += "},";
-  
-  json += "\"wifi\":{";
-  json += "\"ssid\":\"" + diagnosticData.wifiSSID + "\",";
-  json += "\"rssi\":" + String(diagnosticData.wifiRSSI) + ",";
-  json += "\"quality\":\"" + getWiFiSignalQuality() + "\",";
-  json += "\"ip\":\"" + diagnosticData.ipAddress + "\",";
-  json += "\"mdns_ready\":" + String(diagnosticData.mdnsAvailable ? "true" : "false") + ",";
-  json += "\"stable_url\":\"" + jsonEscape(stableUrl.c_str()) + "\",";
-  json += "\"subnet\":\"" + WiFi.subnetMask().toString() + "\",";
-  json += "\"gateway\":\"" + WiFi.gatewayIP().toString() + "\",";
-  json += "\"dns\":\"" + WiFi.dnsIP().toString() + "\"";
-  json += "},";
-
-  json += "\"gpio\":{";
-  json += "\"total\":" + String(diagnosticData.totalGPIO) + ",";
-  json += "\"list\":\"" + diagnosticData.gpioList + "\"";
-  json += "},";
-  
-  json += "\"peripherals\":{";
-  json += "\"i2c_count\":" + String(diagnosticData.i2cCount) + ",";
-  json += "\"i2c_devices\":\"" + diagnosticData.i2cDevices + "\",";
-  json += "\"spi\":\"" + spiInfo + "\"";
-  json += "},";
-  
-  json += "\"hardware_tests\":{";
-  json += "\"builtin_led\":\"" + builtinLedTestResult + "\",";
-  json += "\"neopixel\":\"" + neopixelTestResult + "\",";
-  json += "\"oled\":\"" + oledTestResult + "\",";
-  json += "\"adc\":\"" + adcTestResult + "\",";
-  json += "\"pwm\":\"" + pwmTestResult + "\",";
-  json += "\"sd_card\":\"" + sdTestResult + "\",";
-  json += "\"rotary_encoder\":\"" + rotaryTestResult + "\"";
-  json += "},";
-  
-  json += "\"performance\":{";
-  if (diagnosticData.cpuBenchmark > 0) {
-    json += "\"cpu_us\":" + String(diagnosticData.cpuBenchmark) + ",";
-    json += "\"cpu_mflops\":" + String(100000.0 / diagnosticData.cpuBenchmark, 2) + ",";
-    json += "\"memory_us\":" + String(diagnosticData.memBenchmark);
-  } else {
-    json += "\"benchmarks\":\"not_run\"";
-  }
-  json += ",\"stress_test\":\"" + stressTestResult + "\"";
-  json += "},";
-  
-  // === ENVIRONNEMENT ===
-  json += ",\"environment\":{";
-  json += "\"aht20_available\":" + String(envData.aht20_available ? "true" : "false") + ",";
-  json += "\"temperature_aht20\":" + (envData.temperature_aht20 != -999.0 ? String(envData.temperature_aht20, 1) : "null") + ",";
-  json += "\"humidity\":" + (envData.humidity != -999.0 ? String(envData.humidity, 1) : "null") + ",";
-  json += "\"aht20_status\":\"" + jsonEscape(envData.aht20_status.c_str()) + "\",";
-  json += "\"bmp280_available\":" + String(envData.bmp280_available ? "true" : "false") + ",";
-  json += "\"temperature_bmp280\":" + (envData.temperature_bmp280 != -999.0 ? String(envData.temperature_bmp280, 1) : "null") + ",";
-  json += "\"pressure\":" + (envData.pressure != -999.0 ? String(envData.pressure, 1) : "null") + ",";
-  json += "\"altitude\":" + (envData.altitude != -999.0 ? String(envData.altitude, 1) : "null") + ",";
-  json += "\"bmp280_status\":\"" + jsonEscape(envData.bmp280_status.c_str()) + "\",";
-  json += "\"temperature_avg\":" + (envData.temperature_avg != -999.0 ? String(envData.temperature_avg, 1) : "null") + ",";
-  json += "\"combined_status\":\"" + jsonEscape(envData.combined_status.c_str()) + "\"";
-  json += "},";
-
-  // === GPS ===
-  json += "\"gps\":{";
-  json += "\"available\":" + String(gpsAvailable ? "true" : "false") + ",";
-  json += "\"status\":\"" + jsonEscape(gpsData.status_str.c_str()) + "\",";
-  json += "\"has_fix\":" + String(gpsData.hasFix ? "true" : "false") + ",";
-  json += "\"satellites\":" + String(gpsData.satellites) + ",";
-  json += "\"latitude\":" + (gpsData.hasFix ? String(gpsData.latitude, 6) : "null") + ",";
-  json += "\"longitude\":" + (gpsData.hasFix ? String(gpsData.longitude, 6) : "null") + ",";
-  json += "\"altitude\":" + (gpsData.hasFix ? String(gpsData.altitude, 1) : "null") + ",";
-  json += "\"speed\":" + (gpsData.hasFix ? String(gpsData.speed, 2) : "null") + ",";
-  json += "\"hdop\":" + (gpsData.hasFix ? String(gpsData.hdop, 2) : "null") + ",";
-  json += "\"date_time\":\"";
-  if (gpsData.hasTime && gpsData.hasDate) {
-    json += String(gpsData.day) + "/" + String(gpsData.month) + "/" + String(gpsData.year) + " ";
-    if (gpsData.hour < 10) json += "0";
-    json += String(gpsData.hour) + ":";
-    if (gpsData.minute < 10) json += "0";
-    json += String(gpsData.minute) + ":";
-    if (gpsData.second < 10) json += "0";
-    json += String(gpsData.second);
-  } else {
-    json += "N/A";
-  }
-  json += "\"";
-  json += "},";
-
-  // === SYSTEME ===
-  json += "\"system\":{";
-  json += "\"uptime_ms\":" + String(diagnosticData.uptime) + ",";
-  json += "\"reset_reason\":\"" + getResetReason() + "\",";
-  json += "\"language\":\"en\"";
-  json += "}";
-
-  json += "}";
-
+  String json = buildExportJSON(exportContext());
   server.sendHeader("Content-Disposition", "attachment; filename=esp32_diagnostic_v" + String(PROJECT_VERSION) + ".json");
   server.send(200, "application/json", json);
 }
@@ -5236,102 +5785,7 @@ void handleExportJSON() {
 void handleExportCSV() {
   collectDiagnosticInfo();
   collectDetailedMemory();
-
-  String csv;
-  csv.reserve(4000);  // Reserve memory to avoid reallocations during export
-  csv = String(Texts::category) + "," + String(Texts::parameter) + "," + String(Texts::value) + "\r\n";
-  
-  csv += "Chip," + String(Texts::model) + "," + diagnosticData.chipModel + "\r\n";
-  csv += "Chip," + String(Texts::revision) + "," + diagnosticData.chipRevision + "\r\n";
-  csv += "Chip,CPU " + String(Texts::cores) + "," + String(diagnosticData.cpuCores) + "\r\n";
-  csv += "Chip," + String(Texts::frequency) + " MHz," + String(diagnosticData.cpuFreqMHz) + "\r\n";
-  csv += "Chip,MAC," + diagnosticData.macAddress + "\r\n";
-  if (diagnosticData.temperature != -999) {
-    csv += "Chip," + String(Texts::cpu_temp) + " C," + String(diagnosticData.temperature, 1) + "\r\n";
-  }
-  
-  csv += String(Texts::memory_details) + ",Flash MB (" + String(Texts::board) + ")," + String(detailedMemory.flashSizeReal / 1048576.0, 2) + "\r\n";
-  csv += String(Texts::memory_details) + ",Flash MB (config)," + String(detailedMemory.flashSizeChip / 1048576.0, 2) + "\r\n";
-  csv += String(Texts::memory_details) + "," + String(Texts::flash_type) + "," + getFlashType() + "\r\n";
-  csv += String(Texts::memory_details) + ",PSRAM MB," + String(detailedMemory.psramTotal / 1048576.0, 2) + "\r\n";
-  csv += String(Texts::memory_details) + ",PSRAM " + String(Texts::free) + " MB," + String(detailedMemory.psramFree / 1048576.0, 2) + "\r\n";
-  String psramStatus = detailedMemory.psramAvailable ? String(Texts::detected_active)
-                                                    : (detailedMemory.psramBoardSupported ? String(Texts::supported_not_enabled)
-                                                                                        : String(Texts::not_detected));
-  csv += String(Texts::memory_details) + ",PSRAM Statut,\"" + psramStatus + "\"\r\n";
-  if (!detailedMemory.psramAvailable && detailedMemory.psramBoardSupported) {
-    String psramHint = String(Texts::enable_psram_hint);
-    psramHint.replace("%TYPE%", detailedMemory.psramType ? detailedMemory.psramType : "PSRAM");
-    psramHint.replace("\"", "'");
-    csv += String(Texts::memory_details) + ",PSRAM Conseils,\"" + psramHint + "\"\r\n";
-  }
-  csv += String(Texts::memory_details) + ",SRAM KB," + String(detailedMemory.sramTotal / 1024.0, 2) + "\r\n";
-  csv += String(Texts::memory_details) + ",SRAM " + String(Texts::free) + " KB," + String(detailedMemory.sramFree / 1024.0, 2) + "\r\n";
-  csv += String(Texts::memory_details) + "," + String(Texts::memory_fragmentation) + " %," + String(detailedMemory.fragmentationPercent, 1) + "\r\n";
-  
-  csv += "WiFi,SSID," + diagnosticData.wifiSSID + "\r\n";
-  csv += "WiFi,RSSI dBm," + String(diagnosticData.wifiRSSI) + "\r\n";
-  csv += "WiFi,IP," + diagnosticData.ipAddress + "\r\n";
-  csv += "WiFi," + String(Texts::gateway) + "," + WiFi.gatewayIP().toString() + "\r\n";
-
-  csv += "GPIO," + String(Texts::total_gpio) + "," + String(diagnosticData.totalGPIO) + "\r\n";
-  
-  csv += String(Texts::i2c_peripherals) + "," + String(Texts::device_count) + "," + String(diagnosticData.i2cCount) + "\r\n";
-  csv += String(Texts::i2c_peripherals) + "," + String(Texts::devices) + "," + diagnosticData.i2cDevices + "\r\n";
-  
-  csv += String(Texts::test) + "," + String(Texts::builtin_led) + "," + builtinLedTestResult + "\r\n";
-  csv += String(Texts::test) + "," + String(Texts::neopixel) + "," + neopixelTestResult + "\r\n";
-  csv += String(Texts::test) + ",OLED," + oledTestResult + "\r\n";
-  csv += String(Texts::test) + ",ADC," + adcTestResult + "\r\n";
-  csv += String(Texts::test) + ",PWM," + pwmTestResult + "\r\n";
-  csv += String(Texts::test) + ",SD Card," + sdTestResult + "\r\n";
-  csv += String(Texts::test) + ",Rotary Encoder," + rotaryTestResult + "\r\n";
-
-  if (diagnosticData.cpuBenchmark > 0) {
-    csv += String(Texts::performance_bench) + ",CPU us," + String(diagnosticData.cpuBenchmark) + "\r\n";
-    csv += String(Texts::performance_bench) + "," + String(Texts::memory_benchmark) + " us," + String(diagnosticData.memBenchmark) + "\r\n";
-  }
-
-  // === ENVIRONNEMENT ===
-  csv += "Environnement,AHT20 disponible," + String(envData.aht20_available ? "Oui" : "Non") + "\r\n";
-  csv += "Environnement,Température (AHT20)," + (envData.temperature_aht20 != -999.0 ? String(envData.temperature_aht20, 1) : "N/A") + "\r\n";
-  csv += "Environnement,Humidité," + (envData.humidity != -999.0 ? String(envData.humidity, 1) : "N/A") + "\r\n";
-  csv += "Environnement,Statut AHT20," + envData.aht20_status + "\r\n";
-  csv += "Environnement,BMP280 disponible," + String(envData.bmp280_available ? "Oui" : "Non") + "\r\n";
-  csv += "Environnement,Température (BMP280)," + (envData.temperature_bmp280 != -999.0 ? String(envData.temperature_bmp280, 1) : "N/A") + "\r\n";
-  csv += "Environnement,Pression," + (envData.pressure != -999.0 ? String(envData.pressure, 1) : "N/A") + "\r\n";
-  csv += "Environnement,Altitude," + (envData.altitude != -999.0 ? String(envData.altitude, 1) : "N/A") + "\r\n";
-  csv += "Environnement,Statut BMP280," + envData.bmp280_status + "\r\n";
-  csv += "Environnement,Température moyenne," + (envData.temperature_avg != -999.0 ? String(envData.temperature_avg, 1) : "N/A") + "\r\n";
-  csv += "Environnement,Statut global," + envData.combined_status + "\r\n";
-
-  // === GPS ===
-  csv += "GPS,Module disponible," + String(gpsAvailable ? "Oui" : "Non") + "\r\n";
-  csv += "GPS,Statut," + gpsData.status_str + "\r\n";
-  csv += "GPS,Fix," + String(gpsData.hasFix ? "Oui" : "Non") + "\r\n";
-  csv += "GPS,Satellites," + String(gpsData.satellites) + "\r\n";
-  csv += "GPS,Latitude," + (gpsData.hasFix ? String(gpsData.latitude, 6) : "N/A") + "\r\n";
-  csv += "GPS,Longitude," + (gpsData.hasFix ? String(gpsData.longitude, 6) : "N/A") + "\r\n";
-  csv += "GPS,Altitude," + (gpsData.hasFix ? String(gpsData.altitude, 1) : "N/A") + "\r\n";
-  csv += "GPS,Vitesse," + (gpsData.hasFix ? String(gpsData.speed, 2) : "N/A") + "\r\n";
-  csv += "GPS,HDOP," + (gpsData.hasFix ? String(gpsData.hdop, 2) : "N/A") + "\r\n";
-  csv += "GPS,Date/Heure,";
-  if (gpsData.hasTime && gpsData.hasDate) {
-    csv += String(gpsData.day) + "/" + String(gpsData.month) + "/" + String(gpsData.year) + " ";
-    if (gpsData.hour < 10) csv += "0";
-    csv += String(gpsData.hour) + ":";
-    if (gpsData.minute < 10) csv += "0";
-    csv += String(gpsData.minute) + ":";
-    if (gpsData.second < 10) csv += "0";
-    csv += String(gpsData.second);
-  } else {
-    csv += "N/A";
-  }
-  csv += "\r\n";
-
-  csv += "System," + String(Texts::uptime) + " ms," + String(diagnosticData.uptime) + "\r\n";
-  csv += "System," + String(Texts::last_reset) + "," + getResetReason() + "\r\n";
-
+  String csv = buildExportCSV(exportContext());
   server.sendHeader("Content-Disposition", "attachment; filename=esp32_diagnostic_v" + String(PROJECT_VERSION) + ".csv");
   server.send(200, "text/csv; charset=utf-8", csv);
 }
@@ -5339,200 +5793,7 @@ void handleExportCSV() {
 void handlePrintVersion() {
   collectDiagnosticInfo();
   collectDetailedMemory();
-  
-  // [OPT-007]: Buffer-based HTML title (1 vs 4 allocations)
-  char titleBuf[256];
-  snprintf(titleBuf, sizeof(titleBuf), "<!DOCTYPE html><html><head><meta charset='UTF-8'><title>%s %s%s</title>",
-           Texts::title.str().c_str(), Texts::version.str().c_str(), PROJECT_VERSION);
-  String html = String(titleBuf);
-  html += "<style>";
-  html += "@page{size:A4;margin:10mm}";
-  html += "body{font:11px Arial;margin:10px;color:#333}";
-  html += "h1{font-size:18px;margin:0 0 5px;border-bottom:3px solid #667eea;color:#667eea;padding-bottom:5px}";
-  html += "h2{font-size:14px;margin:15px 0 8px;color:#667eea;border-bottom:1px solid #ddd;padding-bottom:3px}";
-  html += ".section{margin-bottom:20px}";
-  html += ".grid{display:grid;grid-template-columns:1fr 1fr;gap:10px;margin:10px 0}";
-  html += ".row{display:flex;margin:3px 0;padding:5px;background:#f8f9fa;border-radius:3px}";
-  html += ".row b{min-width:150px;color:#667eea}";
-  html += ".badge{display:inline-block;padding:2px 8px;border-radius:10px;font-size:10px;font-weight:bold}";
-  html += ".badge-success{background:#d4edda;color:#155724}";
-  html += ".badge-warning{background:#fff3cd;color:#856404}";
-  html += ".badge-danger{background:#f8d7da;color:#721c24}";
-  html += "table{width:100%;border-collapse:collapse;margin:10px 0;font-size:10px}";
-  html += "th{background:#667eea;color:#fff;padding:5px;text-align:left}";
-  html += "td{border:1px solid #ddd;padding:4px}";
-  html += ".footer{margin-top:20px;padding-top:10px;border-top:1px solid #ddd;font-size:9px;color:#666;text-align:center}";
-  html += "</style></head>";
-  html += "<body onload='window.print()'>";
-  
-  // Header traduit
-  html += "<h1>" + String(Texts::title) + " " + String(Texts::version) + String(PROJECT_VERSION) + "</h1>";
-  html += "<div style='margin:10px 0;font-size:12px;color:#666'>";
-  html += String(Texts::export_generated) + " " + String(millis()/1000) + "s " + String(Texts::export_after_boot) + " | IP: " + diagnosticData.ipAddress;
-  html += "</div>";
-  
-  // Chip
-  html += "<div class='section'>";
-  html += "<h2>" + String(Texts::chip_info) + "</h2>";
-  html += "<div class='grid'>";
-  html += "<div class='row'><b>" + String(Texts::full_model) + ":</b><span>" + diagnosticData.chipModel + " Rev" + diagnosticData.chipRevision + "</span></div>";
-  html += "<div class='row'><b>" + String(Texts::cpu_cores) + ":</b><span>" + String(diagnosticData.cpuCores) + " " + String(Texts::cores) + " @ " + String(diagnosticData.cpuFreqMHz) + " MHz</span></div>";
-  html += "<div class='row'><b>" + String(Texts::mac_wifi) + ":</b><span>" + diagnosticData.macAddress + "</span></div>";
-  html += "<div class='row'><b>" + String(Texts::sdk_version) + ":</b><span>" + diagnosticData.sdkVersion + "</span></div>";
-  html += "<div class='row'><b>" + String(Texts::idf_version) + ":</b><span>" + diagnosticData.idfVersion + "</span></div>";
-  if (diagnosticData.temperature != -999) {
-    html += "<div class='row'><b>" + String(Texts::cpu_temp) + ":</b><span>" + String(diagnosticData.temperature, 1) + " °C</span></div>";
-  }
-
-  unsigned long seconds = diagnosticData.uptime / 1000;
-  unsigned long minutes = seconds / 60;
-  unsigned long hours = minutes / 60;
-  unsigned long days = hours / 24;
-  html += "<div class='row'><b>" + String(Texts::uptime) + ":</b><span>" + formatUptime(days, hours % 24, minutes % 60) + "</span></div>";
-  html += "<div class='row'><b>" + String(Texts::last_reset) + ":</b><span>" + getResetReason() + "</span></div>";
-  html += "</div></div>";
-
-
-  // Mémoire
-  html += "<div class='section'>";
-  html += "<h2>" + String(Texts::memory_details) + "</h2>";
-  html += "<table>";
-  html += "<tr><th>" + String(Texts::category) + "</th><th>" + String(Texts::total_size) + "</th><th>" + String(Texts::free) + "</th><th>" + String(Texts::used) + "</th><th>" + String(Texts::status) + "</th></tr>";
-  // ...existing code for memory table...
-  bool flashMatch = (detailedMemory.flashSizeReal == detailedMemory.flashSizeChip);
-  html += "<tr><td><b>" + String(Texts::flash_memory) + "</b></td>";
-  html += "<td>" + String(detailedMemory.flashSizeReal / 1048576.0, 1) + " MB</td>";
-  html += "<td>-</td><td>-</td>";
-  html += "<td><span class='badge " + String(flashMatch ? "badge-success'>" + String(Texts::ok) : "badge-warning'>" + String(Texts::ide_config)) + "</span></td></tr>";
-  // ...existing code for PSRAM and SRAM...
-  if (detailedMemory.psramAvailable) {
-    html += "<tr><td><b>" + String(Texts::psram_external) + "</b></td>";
-    html += "<td>" + String(detailedMemory.psramTotal / 1048576.0, 1) + " MB</td>";
-    html += "<td>" + String(detailedMemory.psramFree / 1048576.0, 1) + " MB</td>";
-    html += "<td>" + String(detailedMemory.psramUsed / 1048576.0, 1) + " MB</td>";
-    html += "<td><span class='badge badge-success'>" + String(Texts::detected_active) + "</span></td></tr>";
-  } else if (detailedMemory.psramBoardSupported) {
-    html += "<tr><td><b>" + String(Texts::psram_external) + "</b></td>";
-    html += "<td>" + String(detailedMemory.psramTotal / 1048576.0, 1) + " MB</td>";
-    html += "<td>-</td><td>-</td>";
-    String psramHint = String(Texts::enable_psram_hint);
-    psramHint.replace("%TYPE%", detailedMemory.psramType ? detailedMemory.psramType : "PSRAM");
-    html += "<td><span class='badge badge-warning'>" + String(Texts::supported_not_enabled) + "</span><br><small>" + psramHint + "</small></td></tr>";
-  } else {
-    html += "<tr><td><b>" + String(Texts::psram_external) + "</b></td>";
-    html += "<td>" + String(detailedMemory.psramTotal / 1048576.0, 1) + " MB</td>";
-    html += "<td>-</td><td>-</td>";
-    html += "<td><span class='badge badge-danger'>" + String(Texts::not_detected) + "</span></td></tr>";
-  }
-  html += "<tr><td><b>" + String(Texts::internal_sram) + "</b></td>";
-  html += "<td>" + String(detailedMemory.sramTotal / 1024.0, 1) + " KB</td>";
-  html += "<td>" + String(detailedMemory.sramFree / 1024.0, 1) + " KB</td>";
-  html += "<td>" + String(detailedMemory.sramUsed / 1024.0, 1) + " KB</td>";
-  html += "<td><span class='badge badge-success'>" + detailedMemory.memoryStatus + "</span></td></tr>";
-  html += "</table>";
-  html += "<div class='row'><b>" + String(Texts::memory_fragmentation) + ":</b><span>" + String(detailedMemory.fragmentationPercent, 1) + "% - " + detailedMemory.memoryStatus + "</span></div>";
-  html += "</div>";
-
-  // === ENVIRONNEMENT ===
-  html += "<div class='section'>";
-  html += "<h2>Environnement</h2>";
-  html += "<table>";
-  html += "<tr><th>Capteur</th><th>Paramètre</th><th>Valeur</th></tr>";
-  html += "<tr><td>AHT20</td><td>Disponible</td><td>" + String(envData.aht20_available ? "Oui" : "Non") + "</td></tr>";
-  html += "<tr><td>AHT20</td><td>Température</td><td>" + (envData.temperature_aht20 != -999.0 ? String(envData.temperature_aht20, 1) + " °C" : "N/A") + "</td></tr>";
-  html += "<tr><td>AHT20</td><td>Humidité</td><td>" + (envData.humidity != -999.0 ? String(envData.humidity, 1) + " %" : "N/A") + "</td></tr>";
-  html += "<tr><td>AHT20</td><td>Statut</td><td>" + envData.aht20_status + "</td></tr>";
-  html += "<tr><td>BMP280</td><td>Disponible</td><td>" + String(envData.bmp280_available ? "Oui" : "Non") + "</td></tr>";
-  html += "<tr><td>BMP280</td><td>Température</td><td>" + (envData.temperature_bmp280 != -999.0 ? String(envData.temperature_bmp280, 1) + " °C" : "N/A") + "</td></tr>";
-  html += "<tr><td>BMP280</td><td>Pression</td><td>" + (envData.pressure != -999.0 ? String(envData.pressure, 1) + " hPa" : "N/A") + "</td></tr>";
-  html += "<tr><td>BMP280</td><td>Altitude</td><td>" + (envData.altitude != -999.0 ? String(envData.altitude, 1) + " m" : "N/A") + "</td></tr>";
-  html += "<tr><td>BMP280</td><td>Statut</td><td>" + envData.bmp280_status + "</td></tr>";
-  html += "<tr><td colspan='2'>Température moyenne</td><td>" + (envData.temperature_avg != -999.0 ? String(envData.temperature_avg, 1) + " °C" : "N/A") + "</td></tr>";
-  html += "<tr><td colspan='2'>Statut global</td><td>" + envData.combined_status + "</td></tr>";
-  html += "</table></div>";
-
-  // === GPS ===
-  html += "<div class='section'>";
-  html += "<h2>GPS</h2>";
-  html += "<table>";
-  html += "<tr><th>Paramètre</th><th>Valeur</th></tr>";
-  html += "<tr><td>Module disponible</td><td>" + String(gpsAvailable ? "Oui" : "Non") + "</td></tr>";
-  html += "<tr><td>Statut</td><td>" + gpsData.status_str + "</td></tr>";
-  html += "<tr><td>Fix</td><td>" + String(gpsData.hasFix ? "Oui" : "Non") + "</td></tr>";
-  html += "<tr><td>Satellites</td><td>" + String(gpsData.satellites) + "</td></tr>";
-  html += "<tr><td>Latitude</td><td>" + (gpsData.hasFix ? String(gpsData.latitude, 6) : "N/A") + "</td></tr>";
-  html += "<tr><td>Longitude</td><td>" + (gpsData.hasFix ? String(gpsData.longitude, 6) : "N/A") + "</td></tr>";
-  html += "<tr><td>Altitude</td><td>" + (gpsData.hasFix ? String(gpsData.altitude, 1) + " m" : "N/A") + "</td></tr>";
-  html += "<tr><td>Vitesse</td><td>" + (gpsData.hasFix ? String(gpsData.speed, 2) + " noeuds" : "N/A") + "</td></tr>";
-  html += "<tr><td>HDOP</td><td>" + (gpsData.hasFix ? String(gpsData.hdop, 2) : "N/A") + "</td></tr>";
-  html += "<tr><td>Date/Heure</td><td>";
-  if (gpsData.hasTime && gpsData.hasDate) {
-    html += String(gpsData.day) + "/" + String(gpsData.month) + "/" + String(gpsData.year) + " ";
-    if (gpsData.hour < 10) html += "0";
-    html += String(gpsData.hour) + ":";
-    if (gpsData.minute < 10) html += "0";
-    html += String(gpsData.minute) + ":";
-    if (gpsData.second < 10) html += "0";
-    html += String(gpsData.second);
-  } else {
-    html += "N/A";
-  }
-  html += "</td></tr>";
-  html += "</table></div>";
-
-  // WiFi
-  html += "<div class='section'>";
-  html += "<h2>" + String(Texts::wifi_connection) + "</h2>";
-  html += "<div class='grid'>";
-  html += "<div class='row'><b>" + String(Texts::connected_ssid) + ":</b><span>" + diagnosticData.wifiSSID + "</span></div>";
-  html += "<div class='row'><b>" + String(Texts::signal_power) + ":</b><span>" + String(diagnosticData.wifiRSSI) + " dBm</span></div>";
-  html += "<div class='row'><b>" + String(Texts::signal_quality) + ":</b><span>" + getWiFiSignalQuality() + "</span></div>";
-  html += "<div class='row'><b>" + String(Texts::ip_address) + ":</b><span>" + diagnosticData.ipAddress + "</span></div>";
-  html += "<div class='row'><b>" + String(Texts::subnet_mask) + ":</b><span>" + WiFi.subnetMask().toString() + "</span></div>";
-  html += "<div class='row'><b>" + String(Texts::dns) + ":</b><span>" + WiFi.dnsIP().toString() + "</span></div>";
-  html += "<div class='row'><b>" + String(Texts::gateway) + ":</b><span>" + WiFi.gatewayIP().toString() + "</span></div>";
-  html += "</div></div>";
-
-  // GPIO et Périphériques
-  html += "<div class='section'>";
-  html += "<h2>" + String(Texts::gpio_interfaces) + "</h2>";
-  html += "<div class='grid'>";
-  html += "<div class='row'><b>" + String(Texts::total_gpio) + ":</b><span>" + String(diagnosticData.totalGPIO) + " " + String(Texts::pins) + "</span></div>";
-  html += "<div class='row'><b>" + String(Texts::i2c_peripherals) + ":</b><span>" + String(diagnosticData.i2cCount) + " " + String(Texts::devices) + " - " + diagnosticData.i2cDevices + "</span></div>";
-  html += "<div class='row'><b>" + String(Texts::spi_bus) + ":</b><span>" + spiInfo + "</span></div>";
-  html += "</div></div>";
-
-  // Tests Matériels
-  html += "<div class='section'>";
-  html += "<h2>" + String(Texts::nav_tests) + "</h2>";
-  html += "<table>";
-  html += "<tr><th>" + String(Texts::parameter) + "</th><th>" + String(Texts::status) + "</th></tr>";
-  html += "<tr><td>" + String(Texts::builtin_led) + "</td><td>" + builtinLedTestResult + "</td></tr>";
-  html += "<tr><td>" + String(Texts::neopixel) + "</td><td>" + neopixelTestResult + "</td></tr>";
-  html += "<tr><td>" + String(Texts::oled_screen) + "</td><td>" + oledTestResult + "</td></tr>";
-  html += "<tr><td>" + String(Texts::adc_test) + "</td><td>" + adcTestResult + "</td></tr>";
-  html += "<tr><td>" + String(Texts::pwm_test) + "</td><td>" + pwmTestResult + "</td></tr>";
-  html += "</table></div>";
-
-  // Performance
-  if (diagnosticData.cpuBenchmark > 0) {
-    html += "<div class='section'>";
-    html += "<h2>" + String(Texts::performance_bench) + "</h2>";
-    html += "<div class='grid'>";
-    html += "<div class='row'><b>" + String(Texts::cpu_benchmark) + ":</b><span>" + String(diagnosticData.cpuBenchmark) + " µs (" + String(100000.0 / diagnosticData.cpuBenchmark, 2) + " MFLOPS)</span></div>";
-    html += "<div class='row'><b>" + String(Texts::memory_benchmark) + ":</b><span>" + String(diagnosticData.memBenchmark) + " µs</span></div>";
-    html += "<div class='row'><b>" + String(Texts::memory_stress) + ":</b><span>" + stressTestResult + "</span></div>";
-    html += "</div></div>";
-  }
-  
-  // Footer
-  html += "<div class='footer'>";
-  html += String(PROJECT_NAME) + " v"+ String(PROJECT_VERSION) + " | " + diagnosticData.chipModel + " | MAC: " + diagnosticData.macAddress;
-  html += "</div>";
-  
-  html += "</body></html>";
-  
-  server.send(200, "text/html; charset=utf-8", html);
+  server.send(200, "text/html; charset=utf-8", buildPrintHTML(exportContext()));
 }
 
 String htmlEscape(const String& raw) {
@@ -5564,70 +5825,6 @@ String htmlEscape(const String& raw) {
   return escaped;
 }
 
-String jsonEscape(const char* raw) {
-  if (raw == nullptr) {
-    return "";
-  }
-
-  const size_t rawLength = strlen(raw);
-  String escaped;
-  escaped.reserve(rawLength * 2);
-  while (*raw) {
-    char c = *raw++;
-    switch (c) {
-      case '\\':
-        escaped += "\\\\";
-        break;
-      case '"':
-        escaped += "\\\"";
-        break;
-      case '\n':
-        escaped += "\\n";
-        break;
-      case '\r':
-        escaped += "\\r";
-        break;
-      case '\t':
-        escaped += "\\t";
-        break;
-      default:
-        escaped += c;
-        break;
-    }
-  }
-  return escaped;
-}
-
-static inline void appendJsonField(String& json, bool& first, const JsonFieldSpec& field) {
-  if (!first) {
-    json += ',';
-  }
-  first = false;
-  json += '"';
-  json += field.key;
-  json += '"';
-  json += ':';
-  if (field.raw) {
-    json += field.value;
-  } else {
-    json += '"';
-    json += jsonEscape(field.value.c_str());
-    json += '"';
-  }
-}
-
-String buildJsonObject(std::initializer_list<JsonFieldSpec> fields) {
-  String json;
-  json.reserve(fields.size() * 50 + 10);  // Estimate size based on field count
-  json = "{";
-  bool first = true;
-  for (const auto& field : fields) {
-    appendJsonField(json, first, field);
-  }
-  json += '}';
-  return json;
-}
-
 inline void sendJsonResponse(int statusCode, std::initializer_list<JsonFieldSpec> fields) {
   server.send(statusCode, "application/json", buildJsonObject(fields));
 }
@@ -5811,9 +6008,9 @@ void handleJavaScriptRoute() {
   server.setContentLength(CONTENT_LENGTH_UNKNOWN);
   server.send(200, "application/javascript; charset=utf-8", "");
 
-  // ===== LOGS DE DÉBOGAGE =====
-  Serial.println("\n========== JAVASCRIPT DEBUG (CHUNKED) ==========");
-  Serial.printf("Free heap at start: %d bytes\n", ESP.getFreeHeap());
+  // ===== LOGS DE DÉBOGAGE (DIAGNOSTIC_DEBUG) =====
+  DIAG_DEBUGLN("\n========== JAVASCRIPT DEBUG (CHUNKED) ==========");
+  DIAG_DEBUGF("Free heap at start: %d bytes\n", ESP.getFreeHeap());
 
   // Send preamble
   String preamble = "console.log('";
@@ -5823,7 +6020,7 @@ void handleJavaScriptRoute() {
   preamble += (currentLanguage == LANG_FR) ? "fr" : "en";
   preamble += "';let updateTimer=null;let isConnected=true;";
 
-  Serial.printf("Sending preamble: %d bytes\n", preamble.length());
+  DIAG_DEBUGF("Sending preamble: %d bytes\n", preamble.length());
   server.sendContent(preamble);
 
   // Send pin constants from board_config.h (BEFORE translations and static code)
@@ -5873,14 +6070,14 @@ void handleJavaScriptRoute() {
   pinVars += String(TFT_MISO_PIN);
   pinVars += ";console.log('GPIO Pins from board_config:',{SD_MISO:SD_MISO_PIN,SD_MOSI:SD_MOSI_PIN,SD_SCLK:SD_SCLK_PIN,SD_CS:SD_CS_PIN,ROTARY_CLK:ROTARY_CLK_PIN,ROTARY_DT:ROTARY_DT_PIN,ROTARY_SW:ROTARY_SW_PIN,BUTTON_BOOT:BUTTON_BOOT,BUTTON_1:BUTTON_1,BUTTON_2:BUTTON_2,TFT_MISO:TFT_MISO_PIN});";
 
-  Serial.printf("Sending pin variables: %d bytes\n", pinVars.length());
-  Serial.printf("  RGB_R=%d, RGB_G=%d, RGB_B=%d\n", rgb_led_pin_r, rgb_led_pin_g, rgb_led_pin_b);
-  Serial.printf("  DHT=%d, LIGHT=%d, MOTION=%d, PWM=%d\n", dht_pin, light_sensor_pin, motion_sensor_pin, buzzer_pin);
-  Serial.printf("  DIST_TRIG=%d, DIST_ECHO=%d\n", distance_trig_pin, distance_echo_pin);
-  Serial.printf("  SD_MISO=%d, SD_MOSI=%d, SD_SCLK=%d, SD_CS=%d\n", sd_miso_pin, sd_mosi_pin, sd_sclk_pin, sd_cs_pin);
-  Serial.printf("  ROTARY_CLK=%d, ROTARY_DT=%d, ROTARY_SW=%d\n", rotary_clk_pin, rotary_dt_pin, rotary_sw_pin);
-  Serial.printf("  BUTTON_BOOT=%d, BUTTON_1=%d, BUTTON_2=%d\n", BUTTON_BOOT_PIN, BUTTON_1_PIN, BUTTON_2_PIN);
-  Serial.printf("  TFT_MISO=%d\n", TFT_MISO_PIN);
+  DIAG_DEBUGF("Sending pin variables: %d bytes\n", pinVars.length());
+  DIAG_DEBUGF("  RGB_R=%d, RGB_G=%d, RGB_B=%d\n", rgb_led_pin_r, rgb_led_pin_g, rgb_led_pin_b);
+  DIAG_DEBUGF("  DHT=%d, LIGHT=%d, MOTION=%d, PWM=%d\n", dht_pin, light_sensor_pin, motion_sensor_pin, buzzer_pin);
+  DIAG_DEBUGF("  DIST_TRIG=%d, DIST_ECHO=%d\n", distance_trig_pin, distance_echo_pin);
+  DIAG_DEBUGF("  SD_MISO=%d, SD_MOSI=%d, SD_SCLK=%d, SD_CS=%d\n", sd_miso_pin, sd_mosi_pin, sd_sclk_pin, sd_cs_pin);
+  DIAG_DEBUGF("  ROTARY_CLK=%d, ROTARY_DT=%d, ROTARY_SW=%d\n", rotary_clk_pin, rotary_dt_pin, rotary_sw_pin);
+  DIAG_DEBUGF("  BUTTON_BOOT=%d, BUTTON_1=%d, BUTTON_2=%d\n", BUTTON_BOOT_PIN, BUTTON_1_PIN, BUTTON_2_PIN);
+  DIAG_DEBUGF("  TFT_MISO=%d\n", TFT_MISO_PIN);
   server.sendContent(pinVars);
 
   // Send translations
@@ -5888,7 +6085,7 @@ void handleJavaScriptRoute() {
   translations += buildTranslationsJSON();
   translations += ";let translationsCache=DEFAULT_TRANSLATIONS;";
 
-  Serial.printf("Sending translations: %d bytes\n", translations.length());
+  DIAG_DEBUGF("Sending translations: %d bytes\n", translations.length());
   server.sendContent(translations);
 
   // Send main JavaScript from PROGMEM without allocating a giant String
@@ -5896,7 +6093,7 @@ void handleJavaScriptRoute() {
   const char* staticJsPtr = DIAGNOSTIC_JS_STATIC;
   size_t staticJsLen = strlen_P(staticJsPtr);
 
-  Serial.printf("Sending static JS (chunked): %d bytes\n", staticJsLen);
+  DIAG_DEBUGF("Sending static JS (chunked): %d bytes\n", staticJsLen);
   const size_t CHUNK_SIZE = 1024;
   char chunkBuf[CHUNK_SIZE + 1];
   size_t sent = 0;
@@ -5912,8 +6109,8 @@ void handleJavaScriptRoute() {
   bool hasShowTab = (strstr(staticJsPtr, "function showTab") != NULL);
   bool hasChangeLang = (strstr(staticJsPtr, "function changeLang") != NULL);
 
-  Serial.printf("Function showTab: %s\n", hasShowTab ? "YES" : "NO [ERROR]");
-  Serial.printf("Function changeLang: %s\n", hasChangeLang ? "YES" : "NO [ERROR]");
+  DIAG_DEBUGF("Function showTab: %s\n", hasShowTab ? "YES" : "NO [ERROR]");
+  DIAG_DEBUGF("Function changeLang: %s\n", hasChangeLang ? "YES" : "NO [ERROR]");
 
   if (!hasShowTab || !hasChangeLang) {
     Serial.println("CRITICAL ERROR: JS functions missing in PROGMEM!");
@@ -5924,9 +6121,9 @@ void handleJavaScriptRoute() {
   server.sendContent("");
 
   unsigned long generateTime = millis() - startTime;
-  Serial.printf("Total generation time: %lu ms\n", generateTime);
-  Serial.printf("Free heap at end: %d bytes\n", ESP.getFreeHeap());
-  Serial.println("======================================\n");
+  DIAG_DEBUGF("Total generation time: %lu ms\n", generateTime);
+  DIAG_DEBUGF("Free heap at end: %d bytes\n", ESP.getFreeHeap());
+  DIAG_DEBUGLN("======================================\n");
 }
 
 // Modern web interface with dynamic tabs
@@ -5959,36 +6156,49 @@ void setupDebugRoutes() {
   Serial.println("[DEBUG] Debug routes installed: /js/test.js, /debug/status");
 }
 
-// ========== SETUP COMPLET ==========
-void setup() {
-  Serial.begin(115200);
-  delay(1000);
-
-  Serial.println("\r\n===============================================");
-  Serial.println("     DIAGNOSTIC ESP32 MULTILINGUE");
-  Serial.printf("     Version %s - FR/EN\r\n", DIAGNOSTIC_VERSION_STR);
-  Serial.printf("     Arduino Core %s\r\n", getArduinoCoreVersionString().c_str());
-#if defined(TARGET_ESP32_S3)
-  Serial.println("     TARGET: ESP32-S3 (N16R8/N8R8)");
-#elif defined(TARGET_ESP32_CLASSIC)
-  Serial.println("     TARGET: ESP32 CLASSIC (DevKitC)");
-#else
-  Serial.println("     TARGET: UNKNOWN - CHECK platformio.ini!");
+#if ENABLE_TRACE
+// Wi-Fi events (connect, got IP, disconnect...) on the trace timeline
+static void traceWiFiEvent(arduino_event_id_t event) {
+  TRACE_INSTANT("wifi_event", event);
+}
 #endif
-  Serial.printf("     RGB LED Pins: R=%d G=%d B=%d\r\n", rgb_led_pin_r, rgb_led_pin_g, rgb_led_pin_b);
-  Serial.println("===============================================\r\n");
 
-  printPSRAMDiagnostic();
+// ========== SETUP COMPLET ==========
+// ========== DÉMARRAGE DIFFÉRÉ ==========
+// Ordre du tableau bootStages[] ci-dessous
+enum BootStageId : uint8_t {
+  BOOT_STAGE_OLED = 0,
+  BOOT_STAGE_TFT,
+  BOOT_STAGE_NEOPIXEL,
+  BOOT_STAGE_WIFI,
+  BOOT_STAGE_PARTITIONS,
+  BOOT_STAGE_SPI,
+  BOOT_STAGE_GPS,
+  BOOT_STAGE_ENVIRONMENT,
+  BOOT_STAGE_SENSOR_READERS,
+  BOOT_STAGE_WIFI_REPORT,
+  BOOT_STAGE_DIAGNOSTICS,
+  BOOT_STAGE_SD_LOGGER
+};
 
-  // Early OLED detection for WiFi status feedback
+static void bootStageOLED() {
   detectOLED();
+  if (oledAvailable && !wifiLinkUp()) {
+    oledShowWiFiStatus(String(Texts::wifi_connection),
+                       String(Texts::loading),
+                       "",
+                       0);
+  }
+}
 
-  // TFT Display initialization
+static void bootStageTFT() {
   if (initTFT()) {
     displayBootSplash();
-    delay(1000);
+    displayWiFiStatus("Connecting to WiFi...");
   }
+}
 
+static void bootStageNeoPixel() {
   // NeoPixel (WiFi feedback heartbeat)
   detectNeoPixelSupport();
   if (strip != nullptr) {
@@ -5996,57 +6206,25 @@ void setup() {
     strip->setBrightness(60);
     strip->clear();
     strip->show();
+    if (!wifiLinkUp()) {
+      neopixelShowConnecting();
+    }
   }
+}
 
-  // WiFi
-  WiFi.mode(WIFI_STA);
-  WiFi.persistent(false);
-
-  WiFi.setSleep(false);
-  configureNetworkHostname();
-#if ESP_ARDUINO_VERSION >= ESP_ARDUINO_VERSION_VAL(3, 3, 0)
-  WiFi.setScanMethod(WIFI_ALL_CHANNEL_SCAN);
-#ifdef WIFI_CONNECT_AP_BY_SIGNAL
-  WiFi.setSortMethod(WIFI_CONNECT_AP_BY_SIGNAL);
-#endif
-#endif
-  wifiMulti.addAP(WIFI_SSID_1, WIFI_PASS_1);
-  wifiMulti.addAP(WIFI_SSID_2, WIFI_PASS_2);
-
+// Tâche de fond (coeur 0) : aucun accès écran/bus ici, loop() continue de servir
+static void bootStageWiFiConnect() {
   Serial.println("Connexion WiFi...");
   const int maxWiFiAttempts = 40;
   int attempt = 0;
-  neopixelShowConnecting();
-  if (oledAvailable) {
-    oledShowWiFiStatus(String(Texts::wifi_connection),
-                       String(Texts::loading),
-                       "",
-                       0);
-  }
-  displayWiFiStatus("Connecting to WiFi...");
   while (wifiMulti.run() != WL_CONNECTED && attempt < maxWiFiAttempts) {
     delay(500);
-    Serial.print(".");
     attempt++;
-    if (oledAvailable) {
-      int progress = (attempt * 100) / maxWiFiAttempts;
-      if (progress > 100) {
-        progress = 100;
-      }
-      // [OPT-007]: Buffer-based progress text (1 vs 3 allocations)
-      char detailBuf[64];
-      snprintf(detailBuf, sizeof(detailBuf), "%s %d%%", Texts::loading.str().c_str(), progress);
-      oledShowWiFiStatus(String(Texts::wifi_connection),
-                         String(detailBuf),
-                         "",
-                         progress);
-    }
   }
+}
 
+static void bootStageWiFiReport() {
   bool wifiConnected = (WiFi.status() == WL_CONNECTED);
-#if DIAGNOSTIC_HAS_MDNS
-  wifiPreviouslyConnected = wifiConnected;
-#endif
 
   if (wifiConnected) {
     Serial.println("\r\n\r\nWiFi OK!");
@@ -6066,6 +6244,7 @@ void setup() {
     } else {
       Serial.println("[mDNS] Initialisation différée - nouvel essai automatique");
     }
+    collectDiagnosticInfo();  // IP / SSID pour la page d'accueil
   } else {
     Serial.println("\r\n\r\nPas de WiFi\r\n");
     Serial.printf("[Accès] Lien constant disponible après connexion : %s\r\n", getStableAccessURL().c_str());
@@ -6076,22 +6255,108 @@ void setup() {
                          -1);
     }
   }
-  
-  scanSPI();
+}
 
+static void bootStageSensorReaders() {
+#if ENABLE_DHT_BACKGROUND
+  beginDHTSensor(dht_pin, DHT_SENSOR_TYPE);
+#endif
+#if DISTANCE_AUTOSTART
+  if (distancePinsUsable()) {
+    beginDistanceSensor(distance_trig_pin, distance_echo_pin, DISTANCE_SAMPLE_RATE_HZ);
+  }
+#endif
+}
 
-  listPartitions();
-  
+static void bootStageDiagnostics() {
   collectDiagnosticInfo();
   collectDetailedMemory();
+}
 
-  // Initialize GPS module
-  initGPS();
-  
-  // Initialize environmental sensors (AHT20 + BMP280)
-  initEnvironmentalSensors();
+#if ENABLE_SD_LOGGER && SD_LOG_AUTOSTART
+static void bootStageSDLogger() {
+  if (initSD()) {
+    String logError;
+    if (!startSDLogger(SD_LOG_DEFAULT_INTERVAL_MS, logError)) {
+      Serial.printf("SD Logger: %s\r\n", logError.c_str());
+    }
+  }
+}
+#endif
+
+static const BootGraphStage bootStages[] = {
+  {"oled_detect", bootStageOLED, 0, false},
+  {"tft_init", bootStageTFT, 0, false},
+  {"neopixel_detect", bootStageNeoPixel, 0, false},
+  {"wifi_connect", bootStageWiFiConnect, 0, true},
+  {"partitions", listPartitions, 0, false},
+  {"spi_scan", scanSPI, BOOT_DEP(BOOT_STAGE_TFT), false},
+  {"gps_init", initGPS, 0, false},
+  {"environment_init", initEnvironmentalSensors, BOOT_DEP(BOOT_STAGE_OLED), false},
+  {"sensor_readers", bootStageSensorReaders, 0, false},
+  {"wifi_report", bootStageWiFiReport,
+   BOOT_DEP(BOOT_STAGE_WIFI) | BOOT_DEP(BOOT_STAGE_OLED) | BOOT_DEP(BOOT_STAGE_TFT) | BOOT_DEP(BOOT_STAGE_NEOPIXEL), false},
+  {"diagnostics", bootStageDiagnostics, BOOT_DEP(BOOT_STAGE_WIFI), false},
+#if ENABLE_SD_LOGGER && SD_LOG_AUTOSTART
+  {"sd_logger", bootStageSDLogger,
+   BOOT_DEP(BOOT_STAGE_TFT) | BOOT_DEP(BOOT_STAGE_WIFI) | BOOT_DEP(BOOT_STAGE_GPS) | BOOT_DEP(BOOT_STAGE_ENVIRONMENT), false},
+#endif
+};
+
+bool wifiConnectStageDone() {
+  return bootGraphStageDone(BOOT_STAGE_WIFI);
+}
+
+void setup() {
+  Serial.begin(115200);
+  traceBegin();
+
+  uint8_t bootRecord = bootStageBegin("serial_banner");
+  Serial.println("\r\n===============================================");
+  Serial.println("     DIAGNOSTIC ESP32 MULTILINGUE");
+  Serial.printf("     Version %s - FR/EN\r\n", DIAGNOSTIC_VERSION_STR);
+  Serial.printf("     Arduino Core %s\r\n", getArduinoCoreVersionString().c_str());
+#if defined(TARGET_ESP32_S3)
+  Serial.println("     TARGET: ESP32-S3 (N16R8/N8R8)");
+#elif defined(TARGET_ESP32_CLASSIC)
+  Serial.println("     TARGET: ESP32 CLASSIC (DevKitC)");
+#else
+  Serial.println("     TARGET: UNKNOWN - CHECK platformio.ini!");
+#endif
+  Serial.printf("     RGB LED Pins: R=%d G=%d B=%d\r\n", rgb_led_pin_r, rgb_led_pin_g, rgb_led_pin_b);
+  Serial.println("===============================================\r\n");
+  bootStageEnd(bootRecord);
+
+  bootRecord = bootStageBegin("psram_diagnostic");
+  printPSRAMDiagnostic();
+  bootStageEnd(bootRecord);
+
+  // WiFi : configuration seulement, l'association se fait en tâche de fond
+  bootRecord = bootStageBegin("wifi_config");
+#if ENABLE_TRACE
+  WiFi.onEvent(traceWiFiEvent);
+#endif
+  WiFi.mode(WIFI_STA);
+  WiFi.persistent(false);
 
+  WiFi.setSleep(false);
+  configureNetworkHostname();
+#if ESP_ARDUINO_VERSION >= ESP_ARDUINO_VERSION_VAL(3, 3, 0)
+  WiFi.setScanMethod(WIFI_ALL_CHANNEL_SCAN);
+#ifdef WIFI_CONNECT_AP_BY_SIGNAL
+  WiFi.setSortMethod(WIFI_CONNECT_AP_BY_SIGNAL);
+#endif
+#endif
+  wifiMulti.addAP(WIFI_SSID_1, WIFI_PASS_1);
+  wifiMulti.addAP(WIFI_SSID_2, WIFI_PASS_2);
+  bootStageEnd(bootRecord);
+
+  bootRecord = bootStageBegin("web_server");
+  // Arène des réponses réservée une fois, avant que le tas ne se fragmente
+  requestArena.begin(REQUEST_ARENA_SIZE);
   // ========== ROUTES SERVEUR ==========
+  // 3e argument : budget d'allocations par appel (ENABLE_ALLOC_TRACER), mesuré dans http_alloc_budgets.h ;
+  // HTTP_ALLOC_BUDGET_DEFAULT sinon
   server.on("/", handleRoot);
   server.on("/js/app.js", handleJavaScriptRoute);
 
@@ -6101,7 +6366,8 @@ void setup() {
 
   // Data endpoints
   server.on("/api/status", handleStatus);
-  server.on("/api/overview", handleOverview);
+  server.on("/api/overview", handleOverview, HTTP_ALLOC_BUDGET_OVERVIEW);
+  server.on("/api/dashboard", handleDashboard, HTTP_ALLOC_BUDGET_DASHBOARD);
   server.on("/api/system-info", handleSystemInfo);
   server.on("/api/memory", handleMemory);
   server.on("/api/wifi-info", handleWiFiInfo);
@@ -6111,7 +6377,7 @@ void setup() {
 
   // GPIO & WiFi
   server.on("/api/test-gpio", handleTestGPIO);
-  server.on("/api/wifi-scan", handleWiFiScan);
+  server.on("/api/wifi-scan", handleWiFiScan, HTTP_ALLOC_BUDGET_WIFI_SCAN);
   server.on("/api/i2c-scan", handleI2CScan);
 
   // LED intégrée
@@ -6141,6 +6407,10 @@ void setup() {
 
   // Tests avancés
   server.on("/api/adc-test", handleADCTest);
+#if ENABLE_ADC_CONTINUOUS
+  server.on("/api/adc-continuous", handleADCContinuous);
+  server.on("/api/adc-stream", handleADCStream, HTTP_ALLOC_BUDGET_ADC_STREAM);
+#endif
   server.on("/api/pwm-test", handlePWMTest);
   server.on("/api/spi-scan", handleSPIScan);
   server.on("/api/partitions-list", handlePartitionsList);
@@ -6163,6 +6433,7 @@ void setup() {
 
   server.on("/api/distance-sensor-config", handleDistanceSensorConfig);
   server.on("/api/distance-sensor-test", handleDistanceSensorTest);
+  server.on("/api/distance-stream", handleDistanceStream);
 
   server.on("/api/motion-sensor-config", handleMotionSensorConfig);
   server.on("/api/motion-sensor-test", handleMotionSensorTest);
@@ -6186,27 +6457,70 @@ void setup() {
   server.on("/api/button-state", handleButtonState);  // v3.28.4 - individual button query
 
   // GPS Module
-  server.on("/api/gps", handleGPSData);
+  server.on("/api/gps", handleGPSData, HTTP_ALLOC_BUDGET_GPS);
+  server.on("/api/gps/satellites", handleGPSSatellites, HTTP_ALLOC_BUDGET_GPS_SATELLITES);
+  server.on("/api/gps/protocol", handleGPSProtocol);
+  server.on("/api/gps/pps", handleGPSPPS);
   server.on("/api/gps-test", handleGPSTest);
 
   // Environmental Sensors (AHT20 + BMP280)
-  server.on("/api/environmental-sensors", handleEnvironmentalSensors);
+  server.on("/api/environmental-sensors", handleEnvironmentalSensors, HTTP_ALLOC_BUDGET_ENVIRONMENTAL);
   server.on("/api/environmental-test", handleEnvironmentalTest);
 
   // Performance & Mémoire
   server.on("/api/benchmark", handleBenchmark);
-  server.on("/api/memory-details", handleMemoryDetails);
+#if ENABLE_GPIO_BENCHMARK
+  server.on("/api/gpio-benchmark", handleGPIOBenchmark);
+  server.on("/api/gpio-benchmark-results", handleGPIOBenchmarkResults);
+#endif
+#if ENABLE_LOGIC_ANALYZER
+  server.on("/api/la/arm", handleLogicAnalyzerArm);
+  server.on("/api/la/status", handleLogicAnalyzerStatus);
+  server.on("/api/la/capture", handleLogicAnalyzerCapture);
+#endif
+#if ENABLE_SD_BENCHMARK
+  server.on("/api/sd-benchmark", handleSDBenchmark);
+  server.on("/api/sd-benchmark-results", handleSDBenchmarkResults);
+#endif
+#if ENABLE_SD_LOGGER
+  server.on("/api/sd-logger", handleSDLogger);
+#endif
+  server.on("/api/memory-details", handleMemoryDetails, HTTP_ALLOC_BUDGET_MEMORY_DETAILS);
+  server.on("/api/boot-profile", handleBootProfile, HTTP_ALLOC_BUDGET_BOOT_PROFILE);
+#if ENABLE_HTTP_METRICS
+  server.on("/api/metrics/http", handleHttpMetrics, HTTP_ALLOC_BUDGET_HTTP_METRICS);
+#endif
+#if ENABLE_TASK_PROFILER
+  server.on("/api/tasks", handleTasks, HTTP_ALLOC_BUDGET_TASKS);
+#endif
+#if ENABLE_LOOP_MONITOR
+  server.on("/api/loop-monitor", handleLoopMonitor, HTTP_ALLOC_BUDGET_LOOP_MONITOR);
+#endif
+#if ENABLE_TRACE
+  server.on("/api/trace", handleTrace, HTTP_ALLOC_BUDGET_TRACE);
+#endif
+#if ENABLE_OPENMETRICS
+  server.on("/metrics", handleMetrics, HTTP_ALLOC_BUDGET_METRICS);
+#endif
+#if ENABLE_MQTT_BRIDGE
+  server.on("/api/mqtt", handleMqttBridge);
+#endif
+#if ENABLE_AUTO_EXPORT
+  server.on("/api/auto-export", handleAutoExport);
+#endif
   
   // Exports
-  server.on("/export/txt", handleExportTXT);
-  server.on("/export/json", handleExportJSON);
-  server.on("/export/csv", handleExportCSV);
-  server.on("/print", handlePrintVersion);
+  server.on("/export/txt", handleExportTXT, HTTP_ALLOC_BUDGET_EXPORT_TXT);
+  server.on("/export/json", handleExportJSON, HTTP_ALLOC_BUDGET_EXPORT_JSON);
+  server.on("/export/csv", handleExportCSV, HTTP_ALLOC_BUDGET_EXPORT_CSV);
+  server.on("/print", handlePrintVersion, HTTP_ALLOC_BUDGET_PRINT);
 
   server.begin();
 
   // Install debug routes for troubleshooting
   setupDebugRoutes();
+  bootStageEnd(bootRecord);
+  bootMarkServerReady();
 
   Serial.println("Serveur Web OK!");
   Serial.println("\r\n===============================================");
@@ -6215,6 +6529,7 @@ void setup() {
   Serial.println("   Changement dynamique via interface web");
   Serial.println("===============================================\r\n");
 
+  bootRecord = bootStageBegin("inputs");
 #if ENABLE_BUTTONS
   initButtons();
   Serial.printf("Boutons actifs: BTN1=%d, BTN2=%d\r\n", button1Pin, button2Pin);
@@ -6229,10 +6544,22 @@ void setup() {
   } else {
     Serial.println("Encodeur rotatif: non disponible ou configuration invalide");
   }
+  bootStageEnd(bootRecord);
+
+#if ENABLE_AUTO_EXPORT
+  if (!startAutoExport()) {
+    Serial.println("[Export] Tache d'export automatique impossible");
+  }
+#endif
+
+  // Écrans, capteurs et association Wi-Fi en parallèle, pilotés depuis loop()
+  bootGraphStart(bootStages, sizeof(bootStages) / sizeof(bootStages[0]));
 }
 
 // ========== LOOP ==========
 void loop() {
+  loopMonitorBegin();
+  maintainTrace();
     // --- Earthbeat NeoPixel fade (animation continue) ---
     if (strip != nullptr) {
       static unsigned long neopixelHeartbeatPreviousMillis = 0;
@@ -6252,19 +6579,44 @@ void loop() {
         if (phase <= 0.0f) { phase = 0.0f; fadeUp = true; }
       }
       uint8_t brightness = (uint8_t)(NEOPIXEL_HEARTBEAT_BRIGHTNESS_MIN + (NEOPIXEL_HEARTBEAT_BRIGHTNESS_MAX - NEOPIXEL_HEARTBEAT_BRIGHTNESS_MIN) * phase);
-      bool connected = (WiFi.status() == WL_CONNECTED);
+      bool connected = wifiLinkUp();
       uint32_t color = connected ? strip->Color(0, brightness, 0) : strip->Color(brightness, 0, 0);
       strip->setBrightness(brightness);
       strip->setPixelColor(0, color);
       strip->show();
     }
+  loopMonitorMark(LOOP_PHASE_HEARTBEAT);
   server.handleClient();
+  loopMonitorMark(LOOP_PHASE_HTTP, server.currentUri().c_str());
+  if (bootProfile.firstResponseUs == 0 && server.currentUri().length() > 0) {
+    bootMarkFirstResponse();
+  }
+  bootGraphStep();
+  loopMonitorMark(LOOP_PHASE_BOOT);
   maintainNetworkServices();
+#if ENABLE_MQTT_BRIDGE
+  if (wifiConnectStageDone()) maintainMqttBridge();
+#endif
+  loopMonitorMark(LOOP_PHASE_NETWORK);
   updateNeoPixelWifiStatus();
+  loopMonitorMark(LOOP_PHASE_WIFI_STATUS);
 
 #if ENABLE_BUTTONS
   maintainButtons();
+  loopMonitorMark(LOOP_PHASE_BUTTONS);
+#endif
+#if ENABLE_SD_LOGGER
+  maintainSDLogger();
+  loopMonitorMark(LOOP_PHASE_SD_LOGGER);
 #endif
+#if ENABLE_TASK_PROFILER
+  maintainTaskProfiler();
+  loopMonitorMark(LOOP_PHASE_TASK_PROFILER);
+#endif
+  maintainDHTSensor();
+  maintainDistanceSensor();
+  maintainGPS();
+  loopMonitorMark(LOOP_PHASE_SENSORS);
 
   static unsigned long lastUpdate = 0;
   if (millis() - lastUpdate > 30000) {
@@ -6278,7 +6630,13 @@ void loop() {
     if (diagnosticData.temperature != -999) {
       Serial.printf("Temp: %.1f°C\r\n", diagnosticData.temperature);
     }
+    printLoopMonitorSummary();
   }
+#if ENABLE_AUTO_EXPORT
+  maintainAutoExport();
+#endif
+  loopMonitorMark(LOOP_PHASE_PERIODIC);
+  loopMonitorEnd();
 
   delay(10);
 }
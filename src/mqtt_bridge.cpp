@@ -0,0 +1,445 @@
+/*
+ * MQTT_BRIDGE.CPP - Batched MQTT telemetry publisher
+ */
+
+#include "mqtt_bridge.h"
+#include "config.h"
+#include "sd_logger.h"
+#include "environmental_sensors.h"
+#include "gps_module.h"
+#include <WiFi.h>
+#include <mqtt_client.h>
+#include <esp_idf_version.h>
+#include <esp_heap_caps.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#define MQTT_BRIDGE_TASK_STACK 4096
+#define MQTT_TOPIC_LENGTH 72
+#define MQTT_COLUMNS "t,tc,hc,pa,lat,lon,alt,sat,fl,heap,rssi,used,snr,snrmax"
+
+// Global bridge status
+MqttBridgeStatus mqttBridgeStatus;
+
+static esp_mqtt_client_handle_t mqttClient = nullptr;
+static TaskHandle_t bridgeTaskHandle = nullptr;
+static volatile bool stopRequested = false;
+static volatile bool brokerConnected = false;
+static volatile int lastAckMsgId = -1;
+static uint32_t startedMs = 0;
+
+// Backlog ring, owned by the bridge task (sampling and publishing)
+static SDLogRecord* backlog = nullptr;
+static uint32_t backlogCapacity = 0;
+static uint32_t backlogHead = 0;         // Records ever sampled
+static uint32_t backlogTail = 0;         // Oldest record not yet acknowledged
+static uint32_t inflightCount = 0;       // QoS 1: records covered by the batch in flight
+static int inflightMsgId = -1;
+static uint32_t inflightSentMs = 0;
+
+static char deviceId[13] = "";
+static char telemetryTopic[MQTT_TOPIC_LENGTH] = "";
+static char statusTopic[MQTT_TOPIC_LENGTH] = "";
+static char payload[MQTT_PAYLOAD_BYTES];
+
+static BaseType_t bridgeCore() {
+#if CONFIG_FREERTOS_UNICORE
+  return tskNO_AFFINITY;
+#else
+  return 1;
+#endif
+}
+
+const char* getMqttDeviceId() {
+  if (deviceId[0] == '\0') {
+    uint8_t mac[6];
+    WiFi.macAddress(mac);
+    snprintf(deviceId, sizeof(deviceId), "%02x%02x%02x%02x%02x%02x",
+             mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
+  }
+  return deviceId;
+}
+
+// Tâche esp-mqtt : on ne fait que lever des drapeaux et réveiller la tâche du pont
+static void mqttEventHandler(void* handlerArgs, esp_event_base_t base, int32_t eventId, void* eventData) {
+  (void)handlerArgs;
+  (void)base;
+  esp_mqtt_event_handle_t event = static_cast<esp_mqtt_event_handle_t>(eventData);
+  switch ((esp_mqtt_event_id_t)eventId) {
+    case MQTT_EVENT_CONNECTED:
+      brokerConnected = true;
+      mqttBridgeStatus.connects++;
+      break;
+    case MQTT_EVENT_DISCONNECTED:
+      if (brokerConnected) {
+        mqttBridgeStatus.disconnects++;
+      }
+      brokerConnected = false;
+      break;
+    case MQTT_EVENT_PUBLISHED:
+      lastAckMsgId = event->msg_id;
+      break;
+    default:
+      return;
+  }
+  mqttBridgeStatus.connected = brokerConnected;
+  if (bridgeTaskHandle) {
+    xTaskNotifyGive(bridgeTaskHandle);
+  }
+}
+
+static void sampleRecord() {
+  if (backlogHead - backlogTail >= backlogCapacity) {
+    // Backlog plein : on sacrifie le plus ancien, y compris s'il fait partie du lot en vol
+    backlogTail++;
+    if (inflightCount > 0) {
+      inflightCount--;
+    }
+    mqttBridgeStatus.recordsDropped++;
+  }
+  fillSDLogRecord(backlog[backlogHead % backlogCapacity]);
+  backlogHead++;
+  mqttBridgeStatus.recordsSampled++;
+}
+
+// Columnar JSON, one integer row per record; stops at the first row that does not fit
+static int encodeBatch(uint32_t seq, uint32_t& count) {
+  int length = snprintf(payload, sizeof(payload),
+                        "{\"v\":%d,\"id\":\"%s\",\"seq\":%lu,\"up\":%lu,\"dropped\":%lu,\"cols\":\"" MQTT_COLUMNS "\",\"rows\":[",
+                        MQTT_PAYLOAD_VERSION, deviceId, (unsigned long)seq, (unsigned long)millis(),
+                        (unsigned long)mqttBridgeStatus.recordsDropped);
+  uint32_t available = backlogHead - backlogTail;
+  uint32_t limit = available < MQTT_BATCH_RECORDS ? available : MQTT_BATCH_RECORDS;
+  count = 0;
+  while (count < limit && length > 0) {
+    const SDLogRecord& record = backlog[(backlogTail + count) % backlogCapacity];
+    int row = snprintf(payload + length, sizeof(payload) - length,
+                       "%s[%lu,%d,%u,%lu,%ld,%ld,%d,%u,%u,%lu,%d,%u,%u,%u]",
+                       count > 0 ? "," : "",
+                       (unsigned long)record.timestampMs, record.temperatureCenti, record.humidityCenti,
+                       (unsigned long)record.pressurePa, (long)record.latitudeE7, (long)record.longitudeE7,
+                       record.altitudeDm, record.satellites, record.flags,
+                       (unsigned long)record.freeHeap, record.rssi,
+                       record.satellitesUsed, record.snrMean, record.snrMax);
+    // Place réservée pour "]}" et le zéro final
+    if (row < 0 || length + row + 3 > (int)sizeof(payload)) {
+      break;
+    }
+    length += row;
+    count++;
+  }
+  if (length <= 0 || count == 0) {
+    return -1;
+  }
+  payload[length++] = ']';
+  payload[length++] = '}';
+  payload[length] = '\0';
+  return length;
+}
+
+static bool publishBatch(uint32_t seq) {
+  uint32_t startUs = micros();
+  uint32_t count = 0;
+  int length = encodeBatch(seq, count);
+  int msgId = length > 0
+    ? esp_mqtt_client_publish(mqttClient, telemetryTopic, payload, length, mqttBridgeStatus.qos, 0)
+    : -1;
+  uint32_t elapsedUs = micros() - startUs;
+  latencyRecord(mqttBridgeStatus.publishUs, elapsedUs);
+  mqttBridgeStatus.busyUs += elapsedUs;
+
+  if (msgId < 0) {
+    mqttBridgeStatus.publishErrors++;
+    return false;
+  }
+  mqttBridgeStatus.batchSeq = seq;
+  mqttBridgeStatus.batchesPublished++;
+  mqttBridgeStatus.lastPayloadBytes = length;
+  mqttBridgeStatus.bytesPublished += length;
+
+  if (mqttBridgeStatus.qos == 0) {
+    backlogTail += count;
+    mqttBridgeStatus.recordsPublished += count;
+  } else {
+    inflightMsgId = msgId;
+    inflightCount = count;
+    inflightSentMs = millis();
+  }
+  return true;
+}
+
+static void publishStatus(bool online) {
+  char message[96];
+  int length = snprintf(message, sizeof(message), "{\"state\":\"%s\",\"fw\":\"%s\",\"ip\":\"%s\"}",
+                        online ? "online" : "offline", PROJECT_VERSION, WiFi.localIP().toString().c_str());
+  esp_mqtt_client_publish(mqttClient, statusTopic, message, length, 1, 1);
+}
+
+static void publishPending(uint32_t& lastPublishMs) {
+  // QoS 1 : un seul lot en vol, la file avance à l'accusé de réception
+  if (inflightCount > 0 || inflightMsgId >= 0) {
+    if (lastAckMsgId == inflightMsgId) {
+      backlogTail += inflightCount;
+      mqttBridgeStatus.recordsPublished += inflightCount;
+      inflightCount = 0;
+      inflightMsgId = -1;
+    } else if (millis() - inflightSentMs < MQTT_ACK_TIMEOUT_MS) {
+      return;
+    } else {
+      // Pas d'accusé (session perdue, boîte d'envoi purgée) : on renvoie depuis la queue,
+      // le décodeur dédoublonne les lignes sur leur horodatage
+      mqttBridgeStatus.retransmits++;
+      inflightMsgId = -1;
+      inflightCount = 0;
+      if (publishBatch(mqttBridgeStatus.batchSeq + 1)) {
+        lastPublishMs = millis();
+      }
+      return;
+    }
+  }
+
+  uint32_t pending = backlogHead - backlogTail;
+  if (pending == 0) return;
+  if (pending < MQTT_BATCH_RECORDS && millis() - lastPublishMs < mqttBridgeStatus.publishIntervalMs) return;
+
+  // Rattrapage borné : QoS 0 envoie quelques lots complets par réveil, QoS 1 attend chaque accusé
+  uint8_t burst = mqttBridgeStatus.qos == 0 ? MQTT_DRAIN_BURST : 1;
+  for (uint8_t i = 0; i < burst && backlogHead != backlogTail; i++) {
+    if (i > 0 && backlogHead - backlogTail < MQTT_BATCH_RECORDS) break;
+    if (!publishBatch(mqttBridgeStatus.batchSeq + 1)) break;
+  }
+  lastPublishMs = millis();
+}
+
+static void bridgeTask(void* parameters) {
+  (void)parameters;
+  const TickType_t period = pdMS_TO_TICKS(mqttBridgeStatus.sampleIntervalMs) > 0 ? pdMS_TO_TICKS(mqttBridgeStatus.sampleIntervalMs) : 1;
+  TickType_t nextSample = xTaskGetTickCount();
+  uint32_t lastPublishMs = millis();
+  bool wasConnected = false;
+
+  while (!stopRequested) {
+    TickType_t now = xTaskGetTickCount();
+    if ((int32_t)(now - nextSample) >= 0) {
+      sampleRecord();
+      nextSample += period;
+      if ((int32_t)(now - nextSample) >= 0) {
+        nextSample = now + period;
+      }
+    }
+
+    bool connected = brokerConnected;
+    if (connected && !wasConnected) {
+      publishStatus(true);
+      // esp-mqtt renvoie lui-même sa boîte d'envoi : on lui laisse le délai complet
+      inflightSentMs = millis();
+    }
+    wasConnected = connected;
+    if (connected) {
+      publishPending(lastPublishMs);
+    }
+    mqttBridgeStatus.backlogRecords = backlogHead - backlogTail;
+    mqttBridgeStatus.stackFreeBytes = uxTaskGetStackHighWaterMark(nullptr);
+
+    // Réveil au prochain échantillon, ou plus tôt sur connexion / accusé de réception
+    int32_t wait = (int32_t)(nextSample - xTaskGetTickCount());
+    ulTaskNotifyTake(pdTRUE, wait > 0 ? (TickType_t)wait : 0);
+  }
+
+  if (brokerConnected) {
+    publishStatus(false);
+  }
+  bridgeTaskHandle = nullptr;
+  vTaskDelete(nullptr);
+}
+
+// bridgeTask() remet bridgeTaskHandle à nullptr juste avant vTaskDelete(), après son dernier accès au client
+static bool waitBridgeTaskExit(uint32_t timeoutMs) {
+  for (uint32_t waited = 0; bridgeTaskHandle && waited < timeoutMs; waited += 10) {
+    vTaskDelay(pdMS_TO_TICKS(10));
+  }
+  return bridgeTaskHandle == nullptr;
+}
+
+static bool allocateBacklog() {
+  if (backlog) return true;
+
+  // PSRAM : plusieurs heures de mesures sans toucher au tas interne
+  size_t bytes = (size_t)MQTT_BACKLOG_RECORDS * sizeof(SDLogRecord);
+  void* memory = heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+  mqttBridgeStatus.backlogInPsram = memory != nullptr;
+  if (!memory) {
+    bytes = (size_t)MQTT_BACKLOG_RECORDS_INTERNAL * sizeof(SDLogRecord);
+    memory = heap_caps_malloc(bytes, MALLOC_CAP_8BIT);
+  }
+  if (!memory) return false;
+
+  backlog = static_cast<SDLogRecord*>(memory);
+  backlogCapacity = bytes / sizeof(SDLogRecord);
+  return true;
+}
+
+bool startMqttBridge(uint32_t sampleIntervalMs, uint32_t publishIntervalMs, uint8_t qos, String& error) {
+  if (mqttBridgeStatus.running) {
+    error = "Bridge already running";
+    return false;
+  }
+
+  bool wasInPsram = mqttBridgeStatus.backlogInPsram;
+  mqttBridgeStatus = MqttBridgeStatus();
+  mqttBridgeStatus.backlogInPsram = wasInPsram;
+  if (!allocateBacklog()) {
+    error = "Backlog allocation failed";
+    mqttBridgeStatus.error = error;
+    return false;
+  }
+  mqttBridgeStatus.backlogCapacity = backlogCapacity;
+  mqttBridgeStatus.backlogHeapBytes = backlogCapacity * sizeof(SDLogRecord);
+  mqttBridgeStatus.qos = qos > 0 ? 1 : 0;
+  mqttBridgeStatus.sampleIntervalMs = sampleIntervalMs < MQTT_MIN_INTERVAL_MS ? MQTT_MIN_INTERVAL_MS : sampleIntervalMs;
+  mqttBridgeStatus.publishIntervalMs = publishIntervalMs < mqttBridgeStatus.sampleIntervalMs ? mqttBridgeStatus.sampleIntervalMs : publishIntervalMs;
+  backlogHead = backlogTail = 0;
+  inflightCount = 0;
+  inflightMsgId = -1;
+  lastAckMsgId = -1;
+  brokerConnected = false;
+  stopRequested = false;
+
+  snprintf(telemetryTopic, sizeof(telemetryTopic), "%s/%s/telemetry", MQTT_TOPIC_PREFIX, getMqttDeviceId());
+  snprintf(statusTopic, sizeof(statusTopic), "%s/%s/status", MQTT_TOPIC_PREFIX, getMqttDeviceId());
+  static char clientId[24];
+  snprintf(clientId, sizeof(clientId), "esp32diag-%s", getMqttDeviceId());
+
+  esp_mqtt_client_config_t config = {};
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+  config.broker.address.hostname = MQTT_BROKER;
+  config.broker.address.port = MQTT_PORT;
+  config.broker.address.transport = MQTT_TRANSPORT_OVER_TCP;
+  config.credentials.client_id = clientId;
+  config.credentials.username = MQTT_USER[0] ? MQTT_USER : nullptr;
+  config.credentials.authentication.password = MQTT_PASSWORD[0] ? MQTT_PASSWORD : nullptr;
+  config.session.last_will.topic = statusTopic;
+  config.session.last_will.msg = "{\"state\":\"offline\"}";
+  config.session.last_will.qos = 1;
+  config.session.last_will.retain = 1;
+  config.buffer.size = 512;
+  config.buffer.out_size = MQTT_PAYLOAD_BYTES + 128;
+  config.network.reconnect_timeout_ms = MQTT_RECONNECT_MS;
+#else
+  config.host = MQTT_BROKER;
+  config.port = MQTT_PORT;
+  config.transport = MQTT_TRANSPORT_OVER_TCP;
+  config.client_id = clientId;
+  config.username = MQTT_USER[0] ? MQTT_USER : nullptr;
+  config.password = MQTT_PASSWORD[0] ? MQTT_PASSWORD : nullptr;
+  config.lwt_topic = statusTopic;
+  config.lwt_msg = "{\"state\":\"offline\"}";
+  config.lwt_qos = 1;
+  config.lwt_retain = 1;
+  config.buffer_size = 512;
+  config.out_buffer_size = MQTT_PAYLOAD_BYTES + 128;
+  config.reconnect_timeout_ms = MQTT_RECONNECT_MS;
+#endif
+
+  // Coût mémoire du client mesuré autour de l'init + démarrage (tampons, tâche mqtt_task)
+  uint32_t heapBefore = ESP.getFreeHeap();
+  if (!mqttClient) {
+    mqttClient = esp_mqtt_client_init(&config);
+    if (!mqttClient) {
+      error = "MQTT client init failed";
+      mqttBridgeStatus.error = error;
+      return false;
+    }
+    esp_mqtt_client_register_event(mqttClient, MQTT_EVENT_ANY, mqttEventHandler, nullptr);
+  }
+
+  if (xTaskCreatePinnedToCore(bridgeTask, "MQTTBridge", MQTT_BRIDGE_TASK_STACK, nullptr,
+                              MQTT_TASK_PRIORITY, &bridgeTaskHandle, bridgeCore()) != pdPASS) {
+    bridgeTaskHandle = nullptr;
+    esp_mqtt_client_destroy(mqttClient);
+    mqttClient = nullptr;
+    error = "Bridge task creation failed";
+    mqttBridgeStatus.error = error;
+    return false;
+  }
+  if (esp_mqtt_client_start(mqttClient) != ESP_OK) {
+    stopRequested = true;
+    xTaskNotifyGive(bridgeTaskHandle);
+    error = "MQTT client start failed";
+    if (!waitBridgeTaskExit(1000)) {
+      // Client conservé : stopMqttBridge() le libérera une fois la tâche sortie
+      Serial.println("[MQTT] Tache sans reponse, client conserve");
+      mqttBridgeStatus.running = true;
+      mqttBridgeStatus.error = error;
+      return false;
+    }
+    esp_mqtt_client_destroy(mqttClient);
+    mqttClient = nullptr;
+    mqttBridgeStatus.error = error;
+    return false;
+  }
+  uint32_t heapAfter = ESP.getFreeHeap();
+  mqttBridgeStatus.clientHeapBytes = heapBefore > heapAfter ? heapBefore - heapAfter : 0;
+
+  startedMs = millis();
+  mqttBridgeStatus.running = true;
+  Serial.printf("[MQTT] Demarre : %s:%d, %s, QoS %u, echantillon %lu ms, lot %lu ms, backlog %lu (%s)\r\n",
+                MQTT_BROKER, MQTT_PORT, telemetryTopic, (unsigned)mqttBridgeStatus.qos,
+                (unsigned long)mqttBridgeStatus.sampleIntervalMs,
+                (unsigned long)mqttBridgeStatus.publishIntervalMs,
+                (unsigned long)backlogCapacity, mqttBridgeStatus.backlogInPsram ? "PSRAM" : "RAM");
+  return true;
+}
+
+void stopMqttBridge() {
+  if (!mqttBridgeStatus.running) return;
+
+  stopRequested = true;
+  if (bridgeTaskHandle) {
+    xTaskNotifyGive(bridgeTaskHandle);
+  }
+  if (!waitBridgeTaskExit(3000)) {
+    // La tâche peut encore publier : on garde le client, un nouvel arrêt réessaiera
+    Serial.println("[MQTT] Tache sans reponse, client conserve");
+    mqttBridgeStatus.error = "Bridge task did not exit";
+    return;
+  }
+  // Laisse partir le statut "offline" avant de fermer la session
+  vTaskDelay(pdMS_TO_TICKS(100));
+  esp_mqtt_client_destroy(mqttClient);
+  mqttClient = nullptr;
+  brokerConnected = false;
+  mqttBridgeStatus.connected = false;
+  mqttBridgeStatus.running = false;
+  Serial.printf("[MQTT] Arrete : %lu enregistrements publies, %lu perdus, %lu en attente\r\n",
+                (unsigned long)mqttBridgeStatus.recordsPublished,
+                (unsigned long)mqttBridgeStatus.recordsDropped,
+                (unsigned long)(backlogHead - backlogTail));
+}
+
+uint32_t getMqttBridgeUptimeMs() {
+  return mqttBridgeStatus.running ? millis() - startedMs : 0;
+}
+
+void maintainMqttBridge() {
+#if ENABLE_MQTT_BRIDGE && MQTT_AUTOSTART
+  static bool autostartDone = false;
+  if (!autostartDone && WiFi.status() == WL_CONNECTED) {
+    autostartDone = true;
+    String error;
+    if (!startMqttBridge(MQTT_SAMPLE_INTERVAL_MS, MQTT_PUBLISH_INTERVAL_MS, MQTT_QOS, error)) {
+      Serial.printf("[MQTT] Demarrage impossible : %s\r\n", error.c_str());
+    }
+  }
+#endif
+  // Le logger SD rafraîchit déjà les mêmes capteurs s'il tourne
+  if (!mqttBridgeStatus.running || sdLoggerStatus.running) return;
+
+  // La boucle principale reste propriétaire des bus capteurs
+  updateGPS();
+  static unsigned long lastSensorRefresh = 0;
+  if (millis() - lastSensorRefresh >= MQTT_SENSOR_REFRESH_MS) {
+    lastSensorRefresh = millis();
+    updateEnvironmentalSensors();
+  }
+}
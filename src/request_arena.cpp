@@ -0,0 +1,179 @@
+/*
+ * REQUEST_ARENA.CPP - Per-request bump arena for HTTP handler temporaries
+ */
+
+#include "request_arena.h"
+#include <esp_heap_caps.h>
+
+RequestArena requestArena;
+
+static inline size_t alignBlock(size_t size) {
+  return (size + 3) & ~(size_t)3;
+}
+
+bool RequestArena::begin(size_t bytes) {
+  if (base || bytes == 0) {
+    return base != nullptr;
+  }
+  bytes = alignBlock(bytes);
+  base = static_cast<uint8_t*>(heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+  inPsram = base != nullptr;
+  if (!base) {
+    base = static_cast<uint8_t*>(heap_caps_malloc(bytes, MALLOC_CAP_8BIT));
+  }
+  if (!base) {
+    Serial.printf("[HTTP] Request arena allocation failed (%u bytes), heap only\r\n", (unsigned)bytes);
+    return false;
+  }
+  capacity = bytes;
+  used = 0;
+  return true;
+}
+
+void* RequestArena::allocate(size_t size) {
+  size = alignBlock(size == 0 ? 1 : size);
+  if (size <= capacity - used) {
+    void* block = base + used;
+    used += size;
+    if (used > highWater) highWater = used;
+    return block;
+  }
+  // Arène pleine : bloc sur le tas, libéré au reset() comme le reste
+  if (spillCount >= REQUEST_ARENA_MAX_SPILLS) {
+    failures++;
+    return nullptr;
+  }
+  void* block = heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+  if (!block) {
+    block = heap_caps_malloc(size, MALLOC_CAP_8BIT);
+  }
+  if (!block) {
+    failures++;
+    return nullptr;
+  }
+  spill[spillCount++] = block;
+  spills++;
+  spillBytes += size;
+  spillUsed += size;
+  if (capacity + spillUsed > highWater) highWater = capacity + spillUsed;
+  return block;
+}
+
+bool RequestArena::extend(void* block, size_t oldSize, size_t newSize) {
+  uint8_t* start = static_cast<uint8_t*>(block);
+  if (!base || start < base || start >= base + capacity) {
+    return false;
+  }
+  size_t offset = (size_t)(start - base);
+  if (offset + alignBlock(oldSize) != used || alignBlock(newSize) > capacity - offset) {
+    return false;
+  }
+  used = offset + alignBlock(newSize);
+  if (used > highWater) highWater = used;
+  return true;
+}
+
+void RequestArena::reset() {
+  if (used == 0 && spillCount == 0) {
+    return;
+  }
+  for (uint8_t i = 0; i < spillCount; i++) {
+    heap_caps_free(spill[i]);
+    spill[i] = nullptr;
+  }
+  spillCount = 0;
+  spillUsed = 0;
+  used = 0;
+  requests++;
+}
+
+void RequestArena::stats(RequestArenaStats& out) const {
+  out.capacity = capacity;
+  out.inPsram = inPsram;
+  out.used = used;
+  out.highWater = highWater;
+  out.requests = requests;
+  out.spills = spills;
+  out.spillBytes = spillBytes;
+  out.failures = failures;
+}
+
+void RequestArena::clearStats() {
+  highWater = used;
+  requests = 0;
+  spills = 0;
+  spillBytes = 0;
+  failures = 0;
+}
+
+ArenaText::ArenaText(size_t reserveSize, RequestArena& owner) : arena(owner) {
+  reserve(reserveSize);
+}
+
+bool ArenaText::reserve(size_t needed) {
+  if (failed) {
+    return false;
+  }
+  if (needed <= size) {
+    return true;
+  }
+  // Croissance en place si le texte est le dernier bloc, sinon copie dans un bloc deux fois plus grand
+  size_t grown = size * 2 > needed ? size * 2 : needed;
+  if (buffer && arena.extend(buffer, size, grown)) {
+    size = grown;
+    return true;
+  }
+  char* block = static_cast<char*>(arena.allocate(grown));
+  if (!block) {
+    failed = true;
+    return false;
+  }
+  if (buffer) {
+    memcpy(block, buffer, used);
+  }
+  block[used] = '\0';
+  buffer = block;
+  size = grown;
+  return true;
+}
+
+void ArenaText::append(const char* text, size_t length) {
+  if (!reserve(used + length + 1)) {
+    return;
+  }
+  memcpy(buffer + used, text, length);
+  used += length;
+  buffer[used] = '\0';
+}
+
+void ArenaText::clear() {
+  used = 0;
+  if (buffer) {
+    buffer[0] = '\0';
+  }
+}
+
+void ArenaText::printf(const char* format, ...) {
+  if (!reserve(used + 1)) {
+    return;
+  }
+  va_list args;
+  va_start(args, format);
+  int length = vsnprintf(buffer + used, size - used, format, args);
+  va_end(args);
+  if (length < 0) {
+    buffer[used] = '\0';
+    return;
+  }
+  if (used + length >= size) {
+    // Pas assez de place : on agrandit puis on formate une seconde fois
+    if (!reserve(used + length + 1)) {
+      buffer[used] = '\0';
+      return;
+    }
+    va_start(args, format);
+    vsnprintf(buffer + used, size - used, format, args);
+    va_end(args);
+  }
+  used += length;
+}
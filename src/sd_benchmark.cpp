@@ -0,0 +1,256 @@
+/*
+ * SD_BENCHMARK.CPP - SD card throughput benchmark over sdSPI
+ */
+
+#include "sd_benchmark.h"
+#include "config.h"
+#include <SD.h>
+#include <FS.h>
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+#include <algorithm>
+
+// Global benchmark variables
+SDBenchmarkData sdBenchmarkData;
+SDBenchmarkConfig sdBenchmarkConfig;
+String sdBenchmarkTestResult = "Not tested";
+
+static const uint32_t sdBenchBlockSizes[SD_BENCH_BLOCK_SIZES] = {
+  512, 1024, 2048, 4096, 8192, 16384, 32768, 65536
+};
+static const uint32_t sdBenchDefaultClocksKHz[] = SD_BENCH_SPI_CLOCKS_KHZ;
+
+void resetSDBenchmarkConfig() {
+  sdBenchmarkConfig = SDBenchmarkConfig();
+  const uint8_t count = sizeof(sdBenchDefaultClocksKHz) / sizeof(sdBenchDefaultClocksKHz[0]);
+  for (uint8_t i = 0; i < count && i < SD_BENCH_MAX_CLOCKS; i++) {
+    sdBenchmarkConfig.clocksKHz[i] = sdBenchDefaultClocksKHz[i];
+    sdBenchmarkConfig.clockCount++;
+  }
+  sdBenchmarkConfig.fileSizeKB = SD_BENCH_FILE_SIZE_KB;
+  sdBenchmarkConfig.randomOps = SD_BENCH_RANDOM_OPS;
+}
+
+// Internal DMA-capable RAM, cache-line aligned: FATFS hands sector-aligned
+// multi-sector requests straight to the SPI driver without a bounce copy
+static uint8_t* allocBenchBuffer(uint32_t& size) {
+  for (size = sdBenchBlockSizes[SD_BENCH_BLOCK_SIZES - 1]; size >= sdBenchBlockSizes[0]; size >>= 1) {
+    void* buffer = heap_caps_aligned_alloc(32, size, MALLOC_CAP_DMA | MALLOC_CAP_8BIT);
+    if (buffer) {
+      return static_cast<uint8_t*>(buffer);
+    }
+  }
+  size = 0;
+  return nullptr;
+}
+
+// Nearest-rank percentiles, sorts the samples in place
+static void computeLatency(uint32_t* samples, uint32_t count, SDLatencyStats& stats) {
+  stats = SDLatencyStats();
+  stats.ops = count;
+  if (count == 0) return;
+
+  std::sort(samples, samples + count);
+  auto rank = [samples, count](uint32_t percent) {
+    uint32_t index = (count * percent + 99) / 100;
+    return samples[index > 0 ? std::min(index, count) - 1 : 0];
+  };
+  stats.p50Us = rank(50);
+  stats.p95Us = rank(95);
+  stats.p99Us = rank(99);
+  stats.maxUs = samples[count - 1];
+}
+
+static float bytesPerMicrosToMBps(uint64_t bytes, int64_t elapsedUs) {
+  return elapsedUs > 0 ? (float)((double)bytes / (double)elapsedUs) : 0.0;
+}
+
+static bool runSequentialPass(uint8_t* buffer, uint32_t blockSize, uint32_t fileBytes,
+                              uint32_t* latencies, SDSequentialResult& result) {
+  const uint32_t ops = fileBytes / blockSize;
+  for (uint32_t i = 0; i < blockSize; i++) {
+    buffer[i] = (uint8_t)(i * 31 + blockSize);
+  }
+
+  File file = SD.open(SD_BENCH_FILE, FILE_WRITE);
+  if (!file) return false;
+
+  int64_t start = esp_timer_get_time();
+  for (uint32_t i = 0; i < ops; i++) {
+    int64_t t0 = esp_timer_get_time();
+    size_t written = file.write(buffer, blockSize);
+    latencies[i] = (uint32_t)(esp_timer_get_time() - t0);
+    if (written != blockSize) {
+      file.close();
+      return false;
+    }
+  }
+  file.close();  // Inclut la mise à jour FAT / répertoire dans le débit
+  result.writeMBps = bytesPerMicrosToMBps((uint64_t)ops * blockSize, esp_timer_get_time() - start);
+  computeLatency(latencies, ops, result.writeLatency);
+
+  file = SD.open(SD_BENCH_FILE, FILE_READ);
+  if (!file) return false;
+
+  start = esp_timer_get_time();
+  for (uint32_t i = 0; i < ops; i++) {
+    int64_t t0 = esp_timer_get_time();
+    size_t read = file.read(buffer, blockSize);
+    latencies[i] = (uint32_t)(esp_timer_get_time() - t0);
+    if (read != blockSize) {
+      file.close();
+      return false;
+    }
+  }
+  result.readMBps = bytesPerMicrosToMBps((uint64_t)ops * blockSize, esp_timer_get_time() - start);
+  file.close();
+  computeLatency(latencies, ops, result.readLatency);
+
+  result.tested = true;
+  return true;
+}
+
+// Random 4 KB accesses inside the file left by the last sequential pass
+static bool runRandomPass(uint8_t* buffer, uint32_t fileBytes, uint32_t ops,
+                          uint32_t* latencies, SDClockResult& result) {
+  const uint32_t slots = fileBytes / SD_BENCH_RANDOM_BLOCK;
+  if (slots == 0 || ops == 0) return false;
+
+  File file = SD.open(SD_BENCH_FILE, FILE_READ);
+  if (!file) return false;
+
+  int64_t start = esp_timer_get_time();
+  for (uint32_t i = 0; i < ops; i++) {
+    uint32_t offset = (uint32_t)random(slots) * SD_BENCH_RANDOM_BLOCK;
+    int64_t t0 = esp_timer_get_time();
+    bool ok = file.seek(offset) && file.read(buffer, SD_BENCH_RANDOM_BLOCK) == SD_BENCH_RANDOM_BLOCK;
+    latencies[i] = (uint32_t)(esp_timer_get_time() - t0);
+    if (!ok) {
+      file.close();
+      return false;
+    }
+  }
+  int64_t elapsed = esp_timer_get_time() - start;
+  file.close();
+  result.randomReadIops = elapsed > 0 ? (float)(ops * 1000000.0 / elapsed) : 0.0;
+  computeLatency(latencies, ops, result.randomReadLatency);
+
+  // Écriture en place ("r+") + flush : chaque opération atteint la carte
+  file = SD.open(SD_BENCH_FILE, "r+");
+  if (!file) return false;
+
+  start = esp_timer_get_time();
+  for (uint32_t i = 0; i < ops; i++) {
+    uint32_t offset = (uint32_t)random(slots) * SD_BENCH_RANDOM_BLOCK;
+    int64_t t0 = esp_timer_get_time();
+    bool ok = file.seek(offset) && file.write(buffer, SD_BENCH_RANDOM_BLOCK) == SD_BENCH_RANDOM_BLOCK;
+    file.flush();
+    latencies[i] = (uint32_t)(esp_timer_get_time() - t0);
+    if (!ok) {
+      file.close();
+      return false;
+    }
+  }
+  elapsed = esp_timer_get_time() - start;
+  file.close();
+  result.randomWriteIops = elapsed > 0 ? (float)(ops * 1000000.0 / elapsed) : 0.0;
+  computeLatency(latencies, ops, result.randomWriteLatency);
+  return true;
+}
+
+void runSDBenchmark(SPIClass& spi, int csPin) {
+  SDBenchmarkData result;
+  result.config = sdBenchmarkConfig;
+  sdBenchmarkTestResult = "Running...";
+  unsigned long startMs = millis();
+
+  const uint32_t fileBytes = result.config.fileSizeKB * 1024;
+  uint8_t* buffer = allocBenchBuffer(result.bufferBytes);
+  const uint32_t maxOps = std::max(fileBytes / sdBenchBlockSizes[0], result.config.randomOps);
+  uint32_t* latencies = static_cast<uint32_t*>(
+      heap_caps_malloc(maxOps * sizeof(uint32_t), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+  if (!latencies) {
+    latencies = static_cast<uint32_t*>(heap_caps_malloc(maxOps * sizeof(uint32_t), MALLOC_CAP_8BIT));
+  }
+
+  if (!buffer || !latencies) {
+    if (buffer) heap_caps_free(buffer);
+    if (latencies) heap_caps_free(latencies);
+    sdBenchmarkTestResult = "DMA buffer allocation failed";
+    result.remounted = SD.cardType() != CARD_NONE;
+    sdBenchmarkData = result;
+    return;
+  }
+
+  float bestWrite = 0.0;
+  float bestRead = 0.0;
+  uint32_t bestClock = 0;
+  uint8_t mountedClocks = 0;
+  bool ioError = false;
+
+  for (uint8_t c = 0; c < result.config.clockCount; c++) {
+    SDClockResult& clock = result.clocks[c];
+    clock.clockKHz = result.config.clocksKHz[c];
+
+    SD.end();
+    clock.mounted = SD.begin(csPin, spi, clock.clockKHz * 1000);
+    if (!clock.mounted) {
+      Serial.printf("[SD Bench] Montage impossible a %lu kHz\r\n", (unsigned long)clock.clockKHz);
+      continue;
+    }
+    mountedClocks++;
+
+    for (uint8_t b = 0; b < SD_BENCH_BLOCK_SIZES; b++) {
+      SDSequentialResult& seq = clock.sequential[b];
+      seq.blockSize = sdBenchBlockSizes[b];
+      if (seq.blockSize > result.bufferBytes || seq.blockSize > fileBytes) continue;
+
+      if (!runSequentialPass(buffer, seq.blockSize, fileBytes, latencies, seq)) {
+        ioError = true;
+        break;
+      }
+      if (seq.writeMBps > bestWrite) {
+        bestWrite = seq.writeMBps;
+        bestClock = clock.clockKHz;
+      }
+      bestRead = std::max(bestRead, seq.readMBps);
+      vTaskDelay(1);
+    }
+
+    if (!ioError && result.bufferBytes >= SD_BENCH_RANDOM_BLOCK) {
+      ioError = !runRandomPass(buffer, fileBytes, result.config.randomOps, latencies, clock);
+    }
+
+    SD.remove(SD_BENCH_FILE);
+    Serial.printf("[SD Bench] %lu kHz : random 4K %.0f / %.0f IOPS (lecture / ecriture)\r\n",
+                  (unsigned long)clock.clockKHz, clock.randomReadIops, clock.randomWriteIops);
+    if (ioError) break;
+  }
+
+  heap_caps_free(latencies);
+  heap_caps_free(buffer);
+
+  // Retour à l'horloge par défaut utilisée par initSD()
+  SD.end();
+  result.remounted = SD.begin(csPin, spi);
+  if (result.remounted) {
+    SD.remove(SD_BENCH_FILE);
+  }
+
+  result.durationMs = millis() - startMs;
+  result.completed = mountedClocks > 0 && !ioError;
+
+  if (mountedClocks == 0) {
+    sdBenchmarkTestResult = "Card not mounted at any clock";
+  } else if (ioError) {
+    sdBenchmarkTestResult = "I/O error during benchmark";
+  } else {
+    char buf[96];
+    snprintf(buf, sizeof(buf), "OK - %.2f MB/s write @ %lu kHz, %.2f MB/s read",
+             bestWrite, (unsigned long)bestClock, bestRead);
+    sdBenchmarkTestResult = String(buf);
+  }
+  Serial.printf("[SD Bench] %s (%lu ms)\r\n", sdBenchmarkTestResult.c_str(), result.durationMs);
+
+  sdBenchmarkData = result;
+}
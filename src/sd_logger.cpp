@@ -0,0 +1,383 @@
+/*
+ * SD_LOGGER.CPP - Double-buffered background SD data logger
+ */
+
+#include "sd_logger.h"
+#include "config.h"
+#include "environmental_sensors.h"
+#include "gps_module.h"
+#include "gps_time.h"
+#include <SD.h>
+#include <FS.h>
+#include <WiFi.h>
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
+#include <math.h>
+
+#define SD_LOG_RECORDS_PER_SECTOR (SD_LOG_SECTOR_SIZE / sizeof(SDLogRecord))
+#define SD_LOG_RECORDS_PER_BUFFER (SD_LOG_BUFFER_BYTES / sizeof(SDLogRecord))
+#define SD_LOG_STOP_TOKEN 0xFF
+
+static_assert(SD_LOG_BUFFER_BYTES % SD_LOG_SECTOR_SIZE == 0, "SD_LOG_BUFFER_BYTES must be a multiple of 512");
+
+// Global logger status
+SDLoggerStatus sdLoggerStatus;
+
+struct SDLogBuffer {
+  SDLogRecord* records;
+  volatile uint32_t count;
+  volatile bool busy;         // Owned by the writer until written
+};
+
+static SDLogBuffer logBuffers[2] = {};
+static uint8_t activeBuffer = 0;
+static QueueHandle_t writerQueue = nullptr;
+static TaskHandle_t samplerTaskHandle = nullptr;
+static TaskHandle_t writerTaskHandle = nullptr;
+static volatile bool stopRequested = false;
+static File logFile;
+static uint32_t fileOpenedMs = 0;
+
+static BaseType_t loggerCore() {
+#if CONFIG_FREERTOS_UNICORE
+  return tskNO_AFFINITY;
+#else
+  return 1;
+#endif
+}
+
+// Dernières valeurs connues uniquement : aucun accès I2C/UART depuis l'échantillonneur
+void fillSDLogRecord(SDLogRecord& record) {
+  memset(&record, 0, sizeof(record));
+  record.timestampMs = millis();
+
+  float temperature = envData.temperature_avg;
+  record.temperatureCenti = temperature > -100.0 ? (int16_t)lroundf(temperature * 100.0f) : INT16_MIN;
+  float humidity = envData.humidity;
+  record.humidityCenti = humidity >= 0.0 ? (uint16_t)lroundf(humidity * 100.0f) : 0xFFFF;
+  float pressure = envData.pressure;
+  record.pressurePa = pressure > 0.0 ? (uint32_t)lroundf(pressure * 100.0f) : 0;
+
+  if (gpsData.hasFix) {
+    record.latitudeE7 = (int32_t)lround(gpsData.latitude * 1e7);
+    record.longitudeE7 = (int32_t)lround(gpsData.longitude * 1e7);
+    record.altitudeDm = (int16_t)lroundf(gpsData.altitude * 10.0f);
+    record.flags |= SD_LOG_FLAG_GPS_FIX;
+  }
+  record.satellites = gpsData.satellites;
+  record.satellitesUsed = gpsSkyView.used;
+  record.snrMean = gpsSkyView.meanSnr;
+  record.snrMax = gpsSkyView.maxSnr;
+
+  if (envData.aht20_available) record.flags |= SD_LOG_FLAG_AHT20;
+  if (envData.bmp280_available) record.flags |= SD_LOG_FLAG_BMP280;
+  if (WiFi.status() == WL_CONNECTED) {
+    record.flags |= SD_LOG_FLAG_WIFI;
+    record.rssi = (int8_t)WiFi.RSSI();
+  }
+  record.freeHeap = ESP.getFreeHeap();
+}
+
+// Ancre millis() -> UTC : même instant esp_timer pour les deux horloges
+bool fillSDLogTimeSync(SDLogRecord& slot) {
+  int64_t localUs = esp_timer_get_time();
+  uint64_t utcUs = 0;
+  if (!gpsTimeFromLocal(localUs, utcUs)) return false;
+  const GPSTimeStatus& pps = gpsTimeStatus;
+  SDLogTimeSync sync;
+  memset(&sync, 0, sizeof(sync));
+  sync.timestampMs = (uint32_t)(localUs / 1000);
+  sync.timestampSubUs = (uint16_t)(localUs % 1000);
+  sync.utcSeconds = (uint32_t)(utcUs / 1000000ULL);
+  sync.utcMicros = (uint32_t)(utcUs % 1000000ULL);
+  sync.driftPpb = (int32_t)llround(pps.driftPpm * 1000.0);
+  sync.jitterRmsNs = (uint32_t)lroundf(pps.jitterRmsUs * 1000.0f);
+  sync.state = pps.state;
+  sync.flags = SD_LOG_FLAG_TIME_SYNC;
+  memcpy(&slot, &sync, sizeof(sync));
+  return true;
+}
+
+// Hands the first `count` records of the active buffer to the writer and
+// carries the remainder into the other buffer. Fails if the writer still owns it
+static bool handOffActiveBuffer(uint32_t count) {
+  const uint8_t next = activeBuffer ^ 1;
+  if (logBuffers[next].busy) return false;
+
+  SDLogBuffer& current = logBuffers[activeBuffer];
+  SDLogBuffer& other = logBuffers[next];
+  uint32_t carry = current.count - count;
+  if (carry > 0) {
+    memcpy(other.records, current.records + count, carry * sizeof(SDLogRecord));
+  }
+  other.count = carry;
+  current.count = count;
+  current.busy = true;
+
+  uint8_t index = activeBuffer;
+  activeBuffer = next;
+  xQueueSend(writerQueue, &index, portMAX_DELAY);
+  return true;
+}
+
+static void samplerTask(void* parameters) {
+  (void)parameters;
+  const TickType_t period = pdMS_TO_TICKS(sdLoggerStatus.intervalMs) > 0 ? pdMS_TO_TICKS(sdLoggerStatus.intervalMs) : 1;
+  TickType_t lastWake = xTaskGetTickCount();
+  uint32_t lastHandOffMs = millis();
+  uint32_t lastTimeSyncMs = 0;
+  bool timeSynced = false;
+
+  while (!stopRequested) {
+    vTaskDelayUntil(&lastWake, period);
+    if (xTaskGetTickCount() - lastWake >= period) {
+      sdLoggerStatus.lateTicks++;
+    }
+
+    SDLogBuffer* buffer = &logBuffers[activeBuffer];
+    if (buffer->count >= SD_LOG_RECORDS_PER_BUFFER && !handOffActiveBuffer(buffer->count)) {
+      // Les deux tampons sont pleins : l'écrivain est bloqué par la carte
+      sdLoggerStatus.recordsDropped++;
+      continue;
+    }
+    buffer = &logBuffers[activeBuffer];
+    // Enregistrement de synchro avant l'échantillon, si la place reste dans le tampon
+    if ((!timeSynced || millis() - lastTimeSyncMs >= SD_LOG_TIME_SYNC_MS) &&
+        buffer->count + 1 < SD_LOG_RECORDS_PER_BUFFER && fillSDLogTimeSync(buffer->records[buffer->count])) {
+      buffer->count++;
+      sdLoggerStatus.timeSyncs++;
+      lastTimeSyncMs = millis();
+      timeSynced = true;
+    }
+    fillSDLogRecord(buffer->records[buffer->count++]);
+    sdLoggerStatus.recordsLogged++;
+
+    // Periodic flush: only whole sectors leave, the tail waits for the next one
+    if (buffer->count >= SD_LOG_RECORDS_PER_BUFFER) {
+      if (handOffActiveBuffer(buffer->count)) lastHandOffMs = millis();
+    } else if (millis() - lastHandOffMs >= SD_LOG_FLUSH_MS && buffer->count >= SD_LOG_RECORDS_PER_SECTOR) {
+      if (handOffActiveBuffer(buffer->count - buffer->count % SD_LOG_RECORDS_PER_SECTOR)) lastHandOffMs = millis();
+    }
+  }
+
+  // Arrêt : dernier tampon partiel, puis jeton de fin pour l'écrivain
+  for (int retry = 0; retry < 200 && logBuffers[activeBuffer].count > 0; retry++) {
+    if (handOffActiveBuffer(logBuffers[activeBuffer].count)) break;
+    vTaskDelay(pdMS_TO_TICKS(10));
+  }
+  uint8_t stopToken = SD_LOG_STOP_TOKEN;
+  xQueueSend(writerQueue, &stopToken, portMAX_DELAY);
+
+  samplerTaskHandle = nullptr;
+  vTaskDelete(nullptr);
+}
+
+static bool openNextLogFile() {
+  if (logFile) {
+    logFile.close();
+  }
+  if (!SD.exists(SD_LOG_DIR)) {
+    SD.mkdir(SD_LOG_DIR);
+  }
+
+  char name[sizeof(sdLoggerStatus.fileName)];
+  do {
+    sdLoggerStatus.fileIndex++;
+    snprintf(name, sizeof(name), "%s/LOG%05lu.BIN", SD_LOG_DIR, (unsigned long)sdLoggerStatus.fileIndex);
+  } while (SD.exists(name) && sdLoggerStatus.fileIndex < 99999);
+
+  logFile = SD.open(name, FILE_WRITE);
+  if (!logFile) {
+    return false;
+  }
+
+  // En-tête d'un secteur complet : les enregistrements restent alignés
+  uint8_t header[SD_LOG_HEADER_SIZE];
+  memset(header, 0, sizeof(header));
+  memcpy(header, SD_LOG_MAGIC, 4);
+  header[4] = SD_LOG_VERSION;
+  header[5] = sizeof(SDLogRecord);
+  uint32_t interval = sdLoggerStatus.intervalMs;
+  uint32_t index = sdLoggerStatus.fileIndex;
+  uint32_t startMs = millis();
+  memcpy(header + 8, &interval, 4);
+  memcpy(header + 12, &index, 4);
+  memcpy(header + 16, &startMs, 4);
+  WiFi.macAddress(header + 20);
+
+  if (logFile.write(header, sizeof(header)) != sizeof(header)) {
+    logFile.close();
+    return false;
+  }
+  logFile.flush();
+
+  strncpy(sdLoggerStatus.fileName, name, sizeof(sdLoggerStatus.fileName) - 1);
+  sdLoggerStatus.fileBytes = sizeof(header);
+  fileOpenedMs = millis();
+  Serial.printf("[SD Log] Fichier %s\r\n", name);
+  return true;
+}
+
+static bool rotationDue(size_t nextBytes) {
+  if (sdLoggerStatus.fileBytes + nextBytes > (uint32_t)SD_LOG_ROTATE_KB * 1024) return true;
+#if SD_LOG_ROTATE_MINUTES > 0
+  if (millis() - fileOpenedMs >= (uint32_t)SD_LOG_ROTATE_MINUTES * 60000UL) return true;
+#endif
+  return false;
+}
+
+static void writerTask(void* parameters) {
+  (void)parameters;
+  uint8_t index = 0;
+
+  while (xQueueReceive(writerQueue, &index, portMAX_DELAY) == pdTRUE) {
+    if (index == SD_LOG_STOP_TOKEN) break;
+
+    SDLogBuffer& buffer = logBuffers[index];
+    const size_t bytes = buffer.count * sizeof(SDLogRecord);
+
+    if (logFile && rotationDue(bytes)) {
+      if (openNextLogFile()) {
+        sdLoggerStatus.rotations++;
+      }
+    }
+
+    if (logFile) {
+      uint32_t startMs = millis();
+      size_t written = logFile.write(reinterpret_cast<const uint8_t*>(buffer.records), bytes);
+      logFile.flush();
+      sdLoggerStatus.lastWriteMs = millis() - startMs;
+      if (sdLoggerStatus.lastWriteMs > sdLoggerStatus.maxWriteMs) {
+        sdLoggerStatus.maxWriteMs = sdLoggerStatus.lastWriteMs;
+      }
+      if (written == bytes) {
+        sdLoggerStatus.buffersWritten++;
+        sdLoggerStatus.bytesWritten += bytes;
+        sdLoggerStatus.fileBytes += bytes;
+      } else {
+        sdLoggerStatus.writeErrors++;
+      }
+    } else {
+      sdLoggerStatus.writeErrors++;
+    }
+
+    buffer.count = 0;
+    buffer.busy = false;
+  }
+
+  if (logFile) {
+    logFile.close();
+  }
+  writerTaskHandle = nullptr;
+  vTaskDelete(nullptr);
+}
+
+bool startSDLogger(uint32_t intervalMs, String& error) {
+  if (sdLoggerStatus.running) {
+    error = "Logger already running";
+    return false;
+  }
+  if (SD.cardType() == CARD_NONE) {
+    error = "SD card not mounted";
+    return false;
+  }
+
+  for (SDLogBuffer& buffer : logBuffers) {
+    if (!buffer.records) {
+      // RAM interne DMA : les secteurs complets partent sans copie intermédiaire
+      void* memory = heap_caps_aligned_alloc(32, SD_LOG_BUFFER_BYTES, MALLOC_CAP_DMA | MALLOC_CAP_8BIT);
+      if (!memory) memory = heap_caps_malloc(SD_LOG_BUFFER_BYTES, MALLOC_CAP_8BIT);
+      if (!memory) {
+        error = "Buffer allocation failed";
+        return false;
+      }
+      buffer.records = static_cast<SDLogRecord*>(memory);
+    }
+    buffer.count = 0;
+    buffer.busy = false;
+  }
+  if (!writerQueue) {
+    writerQueue = xQueueCreate(3, sizeof(uint8_t));
+    if (!writerQueue) {
+      error = "Queue creation failed";
+      return false;
+    }
+  }
+  xQueueReset(writerQueue);
+
+  sdLoggerStatus = SDLoggerStatus();
+  sdLoggerStatus.intervalMs = intervalMs < SD_LOG_MIN_INTERVAL_MS ? SD_LOG_MIN_INTERVAL_MS : intervalMs;
+  activeBuffer = 0;
+  stopRequested = false;
+
+  if (!openNextLogFile()) {
+    error = "Cannot create log file";
+    sdLoggerStatus.error = error;
+    return false;
+  }
+
+  if (xTaskCreatePinnedToCore(writerTask, "SDLogWriter", 4096, nullptr,
+                              SD_LOG_WRITER_PRIORITY, &writerTaskHandle, loggerCore()) != pdPASS) {
+    writerTaskHandle = nullptr;
+    logFile.close();
+    error = "Writer task creation failed";
+    sdLoggerStatus.error = error;
+    return false;
+  }
+  if (xTaskCreatePinnedToCore(samplerTask, "SDLogSampler", 3072, nullptr,
+                              SD_LOG_SAMPLER_PRIORITY, &samplerTaskHandle, loggerCore()) != pdPASS) {
+    samplerTaskHandle = nullptr;
+    uint8_t stopToken = SD_LOG_STOP_TOKEN;
+    xQueueSend(writerQueue, &stopToken, portMAX_DELAY);
+    error = "Sampler task creation failed";
+    sdLoggerStatus.error = error;
+    return false;
+  }
+
+  sdLoggerStatus.running = true;
+  Serial.printf("[SD Log] Demarre : %lu ms, tampons 2 x %u octets\r\n",
+                (unsigned long)sdLoggerStatus.intervalMs, (unsigned)SD_LOG_BUFFER_BYTES);
+  return true;
+}
+
+bool stopSDLogger() {
+  if (!sdLoggerStatus.running) return true;
+
+  stopRequested = true;
+  // L'échantillonneur remet le dernier tampon puis le jeton de fin à l'écrivain
+  for (int wait = 0; wait < 300 && (samplerTaskHandle || writerTaskHandle); wait++) {
+    vTaskDelay(pdMS_TO_TICKS(10));
+  }
+  if (samplerTaskHandle || writerTaskHandle) {
+    // Écrivain bloqué sur la carte : toujours propriétaire des tampons et du fichier,
+    // maintainSDLogger() libère l'état quand les deux tâches ont fini
+    sdLoggerStatus.error = "Stop timed out (SD write stalled)";
+    Serial.println("[SD Log] Arret en attente : ecriture SD bloquee");
+    return false;
+  }
+  sdLoggerStatus.running = false;
+  Serial.printf("[SD Log] Arrete : %lu enregistrements, %lu perdus\r\n",
+                (unsigned long)sdLoggerStatus.recordsLogged,
+                (unsigned long)sdLoggerStatus.recordsDropped);
+  return true;
+}
+
+void maintainSDLogger() {
+  if (!sdLoggerStatus.running) return;
+  if (stopRequested) {
+    // Arrêt différé par stopSDLogger()
+    if (!samplerTaskHandle && !writerTaskHandle) sdLoggerStatus.running = false;
+    return;
+  }
+
+  // La boucle principale reste propriétaire des bus capteurs
+  updateGPS();
+  static unsigned long lastSensorRefresh = 0;
+  if (millis() - lastSensorRefresh >= SD_LOG_SENSOR_REFRESH_MS) {
+    lastSensorRefresh = millis();
+    updateEnvironmentalSensors();
+  }
+}
@@ -0,0 +1,172 @@
+/*
+ * TASK_PROFILER.CPP - FreeRTOS task CPU share and stack headroom sampler
+ */
+
+#include "task_profiler.h"
+#include "config.h"
+#include <cstring>
+
+// Global task profiler variables (loop task only)
+TaskProfilerData taskProfilerData;
+
+#if configUSE_TRACE_FACILITY
+typedef decltype(TaskStatus_t::ulRunTimeCounter) TaskRunTime;
+
+static TaskStatus_t taskStatusBuffer[TASK_PROFILER_MAX_TASKS];
+static uint32_t elapsedRing[TASK_PROFILER_WINDOW];
+static uint32_t lastTotalRunTime = 0;
+
+static TaskProfileEntry* findTaskEntry(const TaskStatus_t& status) {
+  TaskProfilerData& data = taskProfilerData;
+  for (uint8_t i = 0; i < data.taskCount; i++) {
+    // Un TCB libéré peut être réutilisé par une nouvelle tâche : on compare aussi le nom
+    if (data.tasks[i].handle == status.xHandle &&
+        strncmp(data.tasks[i].name, status.pcTaskName, TASK_PROFILER_NAME_LEN - 1) == 0) {
+      return &data.tasks[i];
+    }
+  }
+  return nullptr;
+}
+
+static TaskProfileEntry* allocateTaskEntry(const TaskStatus_t& status) {
+  TaskProfilerData& data = taskProfilerData;
+  TaskProfileEntry* entry = nullptr;
+  if (data.taskCount < TASK_PROFILER_MAX_TASKS) {
+    entry = &data.tasks[data.taskCount++];
+  } else {
+    // Table pleine : on recycle une tâche terminée
+    for (uint8_t i = 0; i < data.taskCount && !entry; i++) {
+      if (!data.tasks[i].alive) entry = &data.tasks[i];
+    }
+    if (!entry) return nullptr;
+  }
+  *entry = TaskProfileEntry();
+  entry->handle = status.xHandle;
+  strncpy(entry->name, status.pcTaskName, TASK_PROFILER_NAME_LEN - 1);
+  entry->name[TASK_PROFILER_NAME_LEN - 1] = '\0';
+  entry->idle = strncmp(entry->name, "IDLE", 4) == 0;
+  return entry;
+}
+
+static float percentOf(uint32_t part, uint32_t whole) {
+  return whole > 0 ? (100.0f * part) / whole : 0.0f;
+}
+
+static void sampleTasks() {
+  TaskProfilerData& data = taskProfilerData;
+  TaskRunTime totalRunTime = 0;
+  UBaseType_t count = uxTaskGetSystemState(taskStatusBuffer, TASK_PROFILER_MAX_TASKS, &totalRunTime);
+  if (count == 0) {
+    data.overflows++;
+    return;
+  }
+
+  const bool first = data.samples == 0;
+  const uint8_t slot = data.samples % TASK_PROFILER_WINDOW;
+  const uint32_t elapsed = first ? 0 : (uint32_t)totalRunTime - lastTotalRunTime;
+  lastTotalRunTime = (uint32_t)totalRunTime;
+  elapsedRing[slot] = elapsed;
+
+  for (uint8_t i = 0; i < data.taskCount; i++) {
+    data.tasks[i].alive = false;
+    data.tasks[i].windowRunTime[slot] = 0;
+  }
+
+  for (UBaseType_t i = 0; i < count; i++) {
+    const TaskStatus_t& status = taskStatusBuffer[i];
+    TaskProfileEntry* entry = findTaskEntry(status);
+    bool created = false;
+    if (!entry) {
+      entry = allocateTaskEntry(status);
+      if (!entry) continue;
+      created = true;
+    }
+
+    const uint32_t runTime = (uint32_t)status.ulRunTimeCounter;
+    // Tâche apparue pendant l'intervalle : tout son temps d'exécution en fait partie
+    uint32_t delta = created ? (first ? 0 : runTime) : runTime - entry->lastRunTime;
+    entry->lastRunTime = runTime;
+    entry->windowRunTime[slot] = delta;
+    entry->alive = true;
+    entry->priority = (uint8_t)status.uxCurrentPriority;
+    entry->state = (uint8_t)status.eCurrentState;
+#if configTASKLIST_INCLUDE_COREID
+    entry->core = (status.xCoreID >= 0 && status.xCoreID < 2) ? (int8_t)status.xCoreID : TASK_PROFILER_ANY_CORE;
+#endif
+
+    // ESP-IDF : StackType_t = uint8_t, high-water mark en octets
+    uint32_t headroom = status.usStackHighWaterMark;
+    if (headroom < entry->stackMinBytes) {
+      entry->stackMinBytes = headroom;
+    }
+    if (!entry->stackWarning && entry->stackMinBytes < TASK_STACK_WARN_BYTES) {
+      entry->stackWarning = true;
+      Serial.printf("[Tasks] ATTENTION pile faible: %s, %lu octets libres\r\n",
+                    entry->name, (unsigned long)entry->stackMinBytes);
+    }
+  }
+
+  data.samples++;
+  data.lastSampleMs = millis();
+  data.liveTasks = count;
+  data.windowFill = data.samples < TASK_PROFILER_WINDOW ? data.samples : TASK_PROFILER_WINDOW;
+  data.windowElapsed = 0;
+  for (uint8_t i = 0; i < data.windowFill; i++) {
+    data.windowElapsed += elapsedRing[i];
+  }
+
+  data.warnings = 0;
+  for (uint8_t c = 0; c < 2; c++) {
+    data.cores[c] = TaskProfilerCore();
+  }
+  for (uint8_t i = 0; i < data.taskCount; i++) {
+    TaskProfileEntry& entry = data.tasks[i];
+    uint32_t windowRunTime = 0;
+    for (uint8_t w = 0; w < data.windowFill; w++) {
+      windowRunTime += entry.windowRunTime[w];
+    }
+    entry.cpuLast = percentOf(entry.windowRunTime[slot], elapsed);
+    entry.cpuWindow = percentOf(windowRunTime, data.windowElapsed);
+    if (entry.stackWarning) data.warnings++;
+
+    if (entry.idle && entry.core >= 0) {
+      data.cores[entry.core].idleLast = entry.cpuLast;
+      data.cores[entry.core].idleWindow = entry.cpuWindow;
+    }
+  }
+}
+#endif
+
+void maintainTaskProfiler() {
+#if configUSE_TRACE_FACILITY
+  taskProfilerData.available = true;
+#if configGENERATE_RUN_TIME_STATS
+  taskProfilerData.runTimeStats = true;
+#endif
+  if (taskProfilerData.samples > 0 && millis() - taskProfilerData.lastSampleMs < TASK_PROFILER_INTERVAL_MS) {
+    return;
+  }
+  sampleTasks();
+#endif
+}
+
+void resetTaskProfiler() {
+  TaskProfilerData& data = taskProfilerData;
+  data.samples = 0;
+  data.windowFill = 0;
+  data.windowElapsed = 0;
+  data.overflows = 0;
+  data.warnings = 0;
+  data.taskCount = 0;
+}
+
+const char* taskStateName(uint8_t state) {
+  switch (state) {
+    case eRunning:   return "running";
+    case eReady:     return "ready";
+    case eBlocked:   return "blocked";
+    case eSuspended: return "suspended";
+    case eDeleted:   return "deleted";
+    default:         return "unknown";
+  }
+}
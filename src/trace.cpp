@@ -0,0 +1,141 @@
+/*
+ * TRACE.CPP - Per-core binary trace rings
+ */
+
+#include "trace.h"
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "cycle_counter.h"
+
+#if CONFIG_FREERTOS_UNICORE
+  #define TRACE_CORES 1
+#else
+  #define TRACE_CORES 2
+#endif
+
+// Global trace rings (DRAM: written from IRAM interrupt handlers)
+static DRAM_ATTR TraceRing traceRings[TRACE_CORES];
+static DRAM_ATTR const char* traceNames[TRACE_MAX_NAMES] = {"(none)", "(overflow)"};
+static DRAM_ATTR volatile uint16_t traceNameTotal = 2;
+static DRAM_ATTR volatile bool traceActive = ENABLE_TRACE;
+static portMUX_TYPE traceNameMux = portMUX_INITIALIZER_UNLOCKED;
+static esp_timer_handle_t traceSyncTimer = nullptr;
+
+static void traceSyncTimerCallback(void*) {
+  traceSync();
+}
+
+void traceBegin() {
+#if ENABLE_TRACE
+  // Le loop() ancre son coeur ; le timer (tâche esp_timer, coeur 0) ancre l'autre
+  if (!traceSyncTimer) {
+    esp_timer_create_args_t args = {};
+    args.callback = traceSyncTimerCallback;
+    args.name = "trace_sync";
+    if (esp_timer_create(&args, &traceSyncTimer) == ESP_OK) {
+      esp_timer_start_periodic(traceSyncTimer, TRACE_SYNC_INTERVAL_MS * 1000ULL);
+    }
+  }
+  traceSync();
+#endif
+}
+
+// Pointer identity only: no string compare, so safe with the flash cache disabled
+uint16_t IRAM_ATTR traceIntern(const char* name) {
+  uint16_t id = TRACE_NAME_OVERFLOW;
+  portENTER_CRITICAL_SAFE(&traceNameMux);
+  for (uint16_t i = 2; i < traceNameTotal; i++) {
+    if (traceNames[i] == name) {
+      id = i;
+      break;
+    }
+  }
+  if (id == TRACE_NAME_OVERFLOW && traceNameTotal < TRACE_MAX_NAMES) {
+    id = traceNameTotal;
+    traceNames[traceNameTotal] = name;
+    traceNameTotal = id + 1;
+  }
+  portEXIT_CRITICAL_SAFE(&traceNameMux);
+  return id;
+}
+
+void IRAM_ATTR traceRecord(uint8_t type, uint16_t name, uint32_t arg) {
+  if (!traceActive) return;
+
+#if TRACE_CORES > 1
+  TraceRing& ring = traceRings[xPortGetCoreID()];
+#else
+  TraceRing& ring = traceRings[0];
+#endif
+  // Réservation atomique du slot : tâches et ISR du même coeur ne se marchent pas dessus
+  uint32_t slot = __atomic_fetch_add(&ring.head, 1, __ATOMIC_RELAXED);
+  TraceEvent& event = ring.events[slot & (TRACE_RING_EVENTS - 1)];
+  event.cycles = diagCycleCount();
+  event.task = xPortInIsrContext() ? 0 : (uint32_t)(uintptr_t)xTaskGetCurrentTaskHandle();
+  event.arg = arg;
+  event.name = name;
+  event.type = type;
+}
+
+void traceSync() {
+#if ENABLE_TRACE
+  // Ancre figée pendant une pause : elle doit rester cohérente avec le contenu de l'anneau
+  if (!traceActive) return;
+  uint8_t core = TRACE_CORES > 1 ? xPortGetCoreID() : 0;
+  TraceRing& ring = traceRings[core];
+  portDISABLE_INTERRUPTS();
+  uint32_t cycles = diagCycleCount();
+  uint64_t us = (uint64_t)esp_timer_get_time();
+  portENABLE_INTERRUPTS();
+  ring.syncCycles = cycles;
+  ring.syncUs = us;
+  // Événement de synchro : borne l'écart entre deux événements sous un tour du compteur
+  static uint16_t syncName = TRACE_NAME_NONE;
+  if (syncName == TRACE_NAME_NONE) syncName = traceIntern("trace_sync");
+  traceRecord(TRACE_EVENT_SYNC, syncName, (uint32_t)us);
+#endif
+}
+
+void maintainTrace() {
+#if ENABLE_TRACE
+  static unsigned long lastSync = 0;
+  if (millis() - lastSync >= TRACE_SYNC_INTERVAL_MS) {
+    lastSync = millis();
+    traceSync();
+  }
+#endif
+}
+
+void traceSetActive(bool active) {
+  traceActive = active && ENABLE_TRACE;
+}
+
+bool traceIsActive() {
+  return traceActive;
+}
+
+void traceClear() {
+  bool wasActive = traceActive;
+  traceActive = false;
+  for (uint8_t i = 0; i < TRACE_CORES; i++) {
+    traceRings[i].head = 0;
+  }
+  traceActive = wasActive;
+}
+
+uint8_t traceRingCount() {
+  return TRACE_CORES;
+}
+
+const TraceRing& traceRingForCore(uint8_t core) {
+  return traceRings[core < TRACE_CORES ? core : 0];
+}
+
+uint16_t traceNameCount() {
+  return traceNameTotal;
+}
+
+const char* traceName(uint16_t id) {
+  return id < traceNameTotal ? traceNames[id] : "?";
+}
@@ -0,0 +1,128 @@
+/*
+ * UBX_PROTOCOL.CPP - u-blox UBX streaming decoder and frame builder
+ */
+
+#include "ubx_protocol.h"
+#include <string.h>
+
+enum UBXDecoderState : uint8_t {
+  UBX_STATE_SYNC1 = 0,
+  UBX_STATE_SYNC2,
+  UBX_STATE_CLASS,
+  UBX_STATE_ID,
+  UBX_STATE_LENGTH1,
+  UBX_STATE_LENGTH2,
+  UBX_STATE_PAYLOAD,
+  UBX_STATE_CK_A,
+  UBX_STATE_CK_B,
+  UBX_STATE_SKIP                            // Oversize frame: payload and checksum discarded
+};
+
+void ubxChecksum(const uint8_t* data, size_t length, uint8_t& ckA, uint8_t& ckB) {
+  ckA = 0;
+  ckB = 0;
+  for (size_t i = 0; i < length; i++) {
+    ckA += data[i];
+    ckB += ckA;
+  }
+}
+
+size_t ubxBuildFrame(uint8_t cls, uint8_t id, const uint8_t* payload, uint16_t length, uint8_t* out) {
+  out[0] = UBX_SYNC_CHAR_1;
+  out[1] = UBX_SYNC_CHAR_2;
+  out[2] = cls;
+  out[3] = id;
+  out[4] = length & 0xFF;
+  out[5] = length >> 8;
+  if (length > 0) {
+    memcpy(out + 6, payload, length);
+  }
+  ubxChecksum(out + 2, length + 4, out[6 + length], out[7 + length]);
+  return length + UBX_FRAME_OVERHEAD;
+}
+
+// Fletcher 8 bits calculé au fil de l'eau : aucune seconde passe sur la charge utile
+UBXPushResult UBXDecoder::push(uint8_t byte) {
+  switch (state) {
+    case UBX_STATE_SYNC1:
+      if (byte != UBX_SYNC_CHAR_1) {
+        return UBX_PUSH_IDLE;
+      }
+      state = UBX_STATE_SYNC2;
+      return UBX_PUSH_BUSY;
+
+    case UBX_STATE_SYNC2:
+      if (byte != UBX_SYNC_CHAR_2) {
+        state = UBX_STATE_SYNC1;
+        return byte == UBX_SYNC_CHAR_1 ? push(byte) : UBX_PUSH_IDLE;
+      }
+      state = UBX_STATE_CLASS;
+      ckA = 0;
+      ckB = 0;
+      return UBX_PUSH_BUSY;
+
+    case UBX_STATE_CLASS:
+    case UBX_STATE_ID:
+    case UBX_STATE_LENGTH1:
+    case UBX_STATE_LENGTH2:
+      ckA += byte;
+      ckB += ckA;
+      if (state == UBX_STATE_CLASS) {
+        cls = byte;
+      } else if (state == UBX_STATE_ID) {
+        id = byte;
+      } else if (state == UBX_STATE_LENGTH1) {
+        length = byte;
+      } else {
+        length |= (uint16_t)byte << 8;
+        index = 0;
+        if (length > UBX_MAX_PAYLOAD) {
+          oversizeFrames++;
+          state = UBX_STATE_SKIP;
+          return UBX_PUSH_BUSY;
+        }
+        state = length > 0 ? UBX_STATE_PAYLOAD : UBX_STATE_CK_A;
+        return UBX_PUSH_BUSY;
+      }
+      state++;
+      return UBX_PUSH_BUSY;
+
+    case UBX_STATE_PAYLOAD:
+      payload[index++] = byte;
+      ckA += byte;
+      ckB += ckA;
+      if (index >= length) {
+        state = UBX_STATE_CK_A;
+      }
+      return UBX_PUSH_BUSY;
+
+    case UBX_STATE_CK_A:
+      if (byte != ckA) {
+        checksumErrors++;
+        state = UBX_STATE_SYNC1;
+        return UBX_PUSH_ERROR;
+      }
+      state = UBX_STATE_CK_B;
+      return UBX_PUSH_BUSY;
+
+    case UBX_STATE_CK_B:
+      state = UBX_STATE_SYNC1;
+      if (byte != ckB) {
+        checksumErrors++;
+        return UBX_PUSH_ERROR;
+      }
+      frames++;
+      return UBX_PUSH_FRAME;
+
+    case UBX_STATE_SKIP:
+      // Longueur annoncée + 2 octets de checksum
+      if (++index >= (uint32_t)length + 2) {
+        state = UBX_STATE_SYNC1;
+      }
+      return UBX_PUSH_BUSY;
+
+    default:
+      state = UBX_STATE_SYNC1;
+      return UBX_PUSH_IDLE;
+  }
+}
@@ -0,0 +1,1277 @@
+/*
+ * TEST_MAIN.CPP - Host unit tests (pio test -e native)
+ * NMEA and UBX decoding (gps_module.cpp, ubx_protocol.cpp), UTC and PPS
+ * timekeeping (gps_time.cpp), BMP280 compensation (bmp280_compensation.h),
+ * DHT and HC-SR04 decoding (dht_sensor.cpp, distance_sensor.cpp), JSON
+ * helpers (json_helpers.cpp), the diagnostic export builders
+ * (export_builders.cpp), the CBOR transcoder (cbor_encoder.cpp) and the
+ * per-route heap allocation budgets (http_alloc_budgets.h), on the native
+ * shims
+ */
+
+#include <Arduino.h>
+#include <unity.h>
+#include "api_routes.h"
+#include "bmp280_compensation.h"
+#include "cbor_encoder.h"
+#include "config.h"
+#include "dht_sensor.h"
+#include "distance_sensor.h"
+#include "export_builders.h"
+#include "gps_module.h"
+#include "gps_time.h"
+#include "http_alloc_budgets.h"
+#include "http_metrics.h"
+#include "json_helpers.h"
+#include "languages.h"
+#include "request_arena.h"
+#include "trace.h"
+#include "ubx_protocol.h"
+
+// ========== NMEA ==========
+
+// Une seconde de sortie d'un récepteur NEO-6M (RMC, GGA, GSA, 3 GSV)
+static const char NMEA_BURST[] =
+    "$GPRMC,123519.00,A,4807.03812,N,01131.00046,E,0.224,84.40,230326,,,A*6A\r\n"
+    "$GPGGA,123519.00,4807.03812,N,01131.00046,E,1,08,0.94,545.4,M,46.9,M,,*47\r\n"
+    "$GPGSA,A,3,04,05,09,12,24,25,29,31,,,,,1.61,0.94,1.31*0D\r\n"
+    "$GPGSV,3,1,11,04,47,283,38,05,10,043,29,09,31,116,41,12,65,201,44*7B\r\n"
+    "$GPGSV,3,2,11,24,22,312,33,25,76,059,45,29,41,147,40,31,08,246,26*72\r\n"
+    "$GPGSV,3,3,11,02,03,030,,14,05,332,,20,12,161,18*4C\r\n";
+
+static void feedGPS(const char* text) {
+  Serial1.shimFeed(text, strlen(text));
+  updateGPS();
+}
+
+static const GPSSatellite* findSatellite(GPSConstellation system, uint16_t prn) {
+  for (uint8_t i = 0; i < gpsSkyView.count; i++) {
+    if (gpsSkyView.satellites[i].system == system && gpsSkyView.satellites[i].prn == prn) {
+      return &gpsSkyView.satellites[i];
+    }
+  }
+  return nullptr;
+}
+
+void setUp() {
+  Serial1.begin(9600);
+  gpsAvailable = true;
+  gpsData = GPSData();
+  resetGPSSkyView();
+  currentLanguage = LANG_EN;
+}
+
+void tearDown() {}
+
+void test_nmea_burst_fix() {
+  feedGPS(NMEA_BURST);
+  TEST_ASSERT_TRUE(gpsData.hasFix);
+  TEST_ASSERT_EQUAL_UINT8(8, gpsData.satellites);
+  TEST_ASSERT_EQUAL_UINT8(8, gpsData.satellites_used);
+  TEST_ASSERT_EQUAL_STRING("3D", gpsData.fix_type.c_str());
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, 48.11730f, gpsData.latitude);
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, 11.51667f, gpsData.longitude);
+  TEST_ASSERT_FLOAT_WITHIN(0.05f, 545.4f, gpsData.altitude);
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, 0.94f, gpsData.hdop);
+  TEST_ASSERT_EQUAL_UINT16(2026, gpsData.year);
+  TEST_ASSERT_EQUAL_UINT8(3, gpsData.month);
+  TEST_ASSERT_EQUAL_UINT8(23, gpsData.day);
+  TEST_ASSERT_EQUAL_UINT8(12, gpsData.hour);
+  TEST_ASSERT_EQUAL_UINT8(35, gpsData.minute);
+  TEST_ASSERT_EQUAL_UINT8(19, gpsData.second);
+}
+
+void test_nmea_burst_skyview() {
+  feedGPS(NMEA_BURST);
+  TEST_ASSERT_EQUAL_UINT8(11, gpsData.satellites_in_view);
+  TEST_ASSERT_EQUAL_UINT8(9, gpsSkyView.tracked);       // SNR vide pour 02 et 14
+  TEST_ASSERT_EQUAL_UINT8(45, gpsSkyView.maxSnr);
+  TEST_ASSERT_EQUAL_UINT32(0, gpsSkyView.gsvErrors);
+  const GPSSatellite* sat = findSatellite(GPS_SYSTEM_GPS, 25);
+  TEST_ASSERT_NOT_NULL(sat);
+  TEST_ASSERT_EQUAL_INT(76, sat->elevation);
+  TEST_ASSERT_EQUAL_INT(59, sat->azimuth);
+  TEST_ASSERT_TRUE(sat->usedInFix);
+  sat = findSatellite(GPS_SYSTEM_GPS, 20);
+  TEST_ASSERT_NOT_NULL(sat);
+  TEST_ASSERT_FALSE(sat->usedInFix);
+}
+
+void test_nmea_rmc_void_clears_fix() {
+  feedGPS(NMEA_BURST);
+  feedGPS("$GPRMC,123520.00,V,,,,,,,230326,,,N*7C\r\n");
+  TEST_ASSERT_FALSE(gpsData.valid);
+  TEST_ASSERT_FALSE(gpsData.hasFix);
+  TEST_ASSERT_EQUAL_STRING("No Fix", gpsData.status_str.c_str());
+}
+
+void test_nmea_south_west() {
+  parseGPRMC(String("$GPRMC,081836.00,A,3751.65000,S,14507.36000,W,0.0,0.0,010126,,,A*4F"));
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, -37.86083f, gpsData.latitude);
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, -145.12267f, gpsData.longitude);
+}
+
+void test_nmea_lost_gsv_sentence() {
+  feedGPS(NMEA_BURST);
+  // Phrase 2/3 perdue : rafale abandonnée, la table précédente reste servie
+  feedGPS("$GPGSV,3,1,11,04,47,283,10,05,10,043,10,09,31,116,10,12,65,201,10*7B\r\n"
+          "$GPGSV,3,3,11,02,03,030,,14,05,332,,20,12,161,18*4C\r\n");
+  TEST_ASSERT_EQUAL_UINT32(1, gpsSkyView.gsvErrors);
+  const GPSSatellite* sat = findSatellite(GPS_SYSTEM_GPS, 4);
+  TEST_ASSERT_NOT_NULL(sat);
+  TEST_ASSERT_EQUAL_UINT8(38, sat->snr);
+}
+
+void test_nmea_constellations() {
+  TEST_ASSERT_EQUAL(GPS_SYSTEM_GLONASS, gpsConstellationFromTalker("$GLGSV,2,1,06"));
+  TEST_ASSERT_EQUAL(GPS_SYSTEM_GALILEO, gpsConstellationFromTalker("$GAGSV,1,1,04"));
+  TEST_ASSERT_EQUAL(GPS_SYSTEM_UNKNOWN, gpsConstellationFromTalker("$GNGSA,A,3"));
+  TEST_ASSERT_EQUAL(GPS_SYSTEM_GPS, gpsConstellationFromPRN(12));
+  TEST_ASSERT_EQUAL(GPS_SYSTEM_GLONASS, gpsConstellationFromPRN(70));
+}
+
+// ========== JSON HELPERS ==========
+
+void test_json_escape() {
+  String escaped = jsonEscape("SSID \"Atelier\"\tcanal 6\r\nC:\\esp32");
+  TEST_ASSERT_EQUAL_STRING("SSID \\\"Atelier\\\"\\tcanal 6\\r\\nC:\\\\esp32", escaped.c_str());
+  TEST_ASSERT_EQUAL_STRING("", jsonEscape("").c_str());
+}
+
+void test_json_escape_to_arena() {
+  ArenaText out(64);
+  out += "\"";
+  jsonEscapeTo(out, "a\"b\\c");
+  out += "\"";
+  TEST_ASSERT_TRUE(out.ok());
+  TEST_ASSERT_EQUAL_STRING("\"a\\\"b\\\\c\"", out.c_str());
+}
+
+void test_json_build_object() {
+  String json = buildJsonObject({
+      jsonBoolField("success", true),
+      jsonStringField("model", "ESP32-S3"),
+      jsonNumberField("cores", 2),
+      jsonFloatField("temperature", 41.53, 1),
+      jsonStringField("ssid", "Atelier \"lab\""),
+      jsonStringField("empty", (const char*)nullptr),
+  });
+  TEST_ASSERT_EQUAL_STRING(
+      "{\"success\":true,\"model\":\"ESP32-S3\",\"cores\":2,\"temperature\":41.5,"
+      "\"ssid\":\"Atelier \\\"lab\\\"\",\"empty\":\"\"}",
+      json.c_str());
+  TEST_ASSERT_EQUAL_STRING("{}", buildJsonObject({}).c_str());
+}
+
+void test_json_append_field_arena() {
+  ArenaText json(64);
+  bool first = true;
+  json += '{';
+  appendJsonField(json, first, jsonNumberField("rssi", -61));
+  appendJsonField(json, first, jsonStringField("ip", "192.168.1.20"));
+  json += '}';
+  TEST_ASSERT_FALSE(first);
+  TEST_ASSERT_EQUAL_STRING("{\"rssi\":-61,\"ip\":\"192.168.1.20\"}", json.c_str());
+}
+
+// ========== CBOR ==========
+
+// Un document coupé entre deux jetons, comme les morceaux de /api/trace
+static const char* const CBOR_FRAGMENTS[] = {
+    "{\"cores\":[1,", "2.5,\"a\\\"b\"]", ",\"sync\":{\"ok\":true,", " \"at\":null},\"events\":[", "]}"};
+
+static size_t streamFragments(uint8_t* out, size_t capacity, CborStream& stream) {
+  size_t total = 0;
+  cborStreamBegin(stream);
+  for (const char* fragment : CBOR_FRAGMENTS) {
+    size_t size = jsonFragmentToCbor(stream, fragment, strlen(fragment), nullptr, 0);
+    TEST_ASSERT_TRUE(size > 0 && total + size <= capacity);
+    TEST_ASSERT_EQUAL_UINT32(size, jsonFragmentToCbor(stream, fragment, strlen(fragment), out + total, size));
+    total += size;
+  }
+  return total;
+}
+
+void test_cbor_stream_matches_document() {
+  char json[128] = "";
+  for (const char* fragment : CBOR_FRAGMENTS) strcat(json, fragment);
+  uint8_t whole[96];
+  size_t wholeSize = jsonToCbor(json, strlen(json), whole, sizeof(whole));
+  TEST_ASSERT_TRUE(wholeSize > 0);
+
+  uint8_t streamed[96];
+  CborStream stream;
+  size_t streamedSize = streamFragments(streamed, sizeof(streamed), stream);
+  TEST_ASSERT_TRUE(cborStreamComplete(stream));
+  TEST_ASSERT_EQUAL_UINT32(wholeSize, streamedSize);
+  TEST_ASSERT_TRUE(memcmp(whole, streamed, wholeSize) == 0);
+}
+
+void test_cbor_stream_rejects_invalid() {
+  CborStream stream;
+  uint8_t out[16];
+  cborStreamBegin(stream);
+  TEST_ASSERT_EQUAL_UINT32(2, jsonFragmentToCbor(stream, "[1", 2, out, sizeof(out)));
+  TEST_ASSERT_FALSE(cborStreamComplete(stream));
+  TEST_ASSERT_EQUAL_UINT32(0, jsonFragmentToCbor(stream, "}", 1, nullptr, 0));
+  TEST_ASSERT_FALSE(stream.failed);  // Mesure seule : l'état n'avance pas
+  TEST_ASSERT_EQUAL_UINT32(0, jsonFragmentToCbor(stream, "}", 1, out, sizeof(out)));
+  TEST_ASSERT_TRUE(stream.failed);
+  TEST_ASSERT_EQUAL_UINT32(0, jsonFragmentToCbor(stream, "]", 1, out, sizeof(out)));
+}
+
+// Toutes les formes de valeur : entier, négatif, booléens, null, texte UTF-8, demi, simple et double précision
+void test_cbor_document_bytes() {
+  static const char json[] = "{\"a\":1,\"b\":[true,null],\"c\":\"\\u00e9\",\"d\":-2,\"e\":1.5,\"f\":0.1,\"g\":1e300}";
+  static const uint8_t expected[] = {
+      0xBF,
+      0x61, 'a', 0x01,
+      0x61, 'b', 0x9F, 0xF5, 0xF6, 0xFF,
+      0x61, 'c', 0x62, 0xC3, 0xA9,
+      0x61, 'd', 0x21,
+      0x61, 'e', 0xF9, 0x3E, 0x00,
+      0x61, 'f', 0xFA, 0x3D, 0xCC, 0xCC, 0xCD,
+      0x61, 'g', 0xFB, 0x7E, 0x37, 0xE4, 0x3C, 0x88, 0x00, 0x75, 0x9C,
+      0xFF};
+  uint8_t out[64];
+  size_t size = jsonToCbor(json, sizeof(json) - 1, out, sizeof(out));
+  TEST_ASSERT_EQUAL_UINT32(sizeof(expected), size);
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, out, sizeof(expected));
+  TEST_ASSERT_EQUAL_UINT32(size, jsonToCbor(json, sizeof(json) - 1, nullptr, 0));
+  TEST_ASSERT_EQUAL_UINT32(0, jsonToCbor(json, sizeof(json) - 1, out, size - 1));
+  TEST_ASSERT_EQUAL_UINT32(0, jsonToCbor("{\"a\":}", 6, out, sizeof(out)));
+}
+
+// ========== BMP280 ==========
+
+// Calibration de l'exemple de la datasheet Bosch (section 3.12)
+static const int32_t BMP280_DATASHEET_CALIBRATION[12] = {27504, 26435, -1000, 36477, -10685, 3024,
+                                                         2855, 140, -7, 15500, -14600, 6000};
+
+static BMP280Calibration datasheetCalibration() {
+  uint8_t raw[BMP280_CALIB_SIZE];
+  for (int i = 0; i < 12; i++) {
+    raw[i * 2] = (uint8_t)(BMP280_DATASHEET_CALIBRATION[i] & 0xFF);
+    raw[i * 2 + 1] = (uint8_t)((BMP280_DATASHEET_CALIBRATION[i] >> 8) & 0xFF);
+  }
+  BMP280Calibration cal;
+  bmp280ParseCalibration(raw, cal);
+  return cal;
+}
+
+// Formules en double de la datasheet (section 8.1), référence des versions entières
+static double referenceTemperatureFine(int32_t adcT, const BMP280Calibration& cal) {
+  double var1 = (adcT / 16384.0 - cal.T1 / 1024.0) * cal.T2;
+  double delta = adcT / 131072.0 - cal.T1 / 8192.0;
+  return var1 + delta * delta * cal.T3;
+}
+
+static double referencePressurePa(int32_t adcP, double tFine, const BMP280Calibration& cal) {
+  double var1 = tFine / 2.0 - 64000.0;
+  double var2 = var1 * var1 * cal.P6 / 32768.0;
+  var2 = var2 + var1 * cal.P5 * 2.0;
+  var2 = var2 / 4.0 + cal.P4 * 65536.0;
+  var1 = (cal.P3 * var1 * var1 / 524288.0 + cal.P2 * var1) / 524288.0;
+  var1 = (1.0 + var1 / 32768.0) * cal.P1;
+  double p = 1048576.0 - adcP;
+  p = (p - var2 / 4096.0) * 6250.0 / var1;
+  return p + (cal.P9 * p * p / 2147483648.0 + p * cal.P8 / 32768.0 + cal.P7) / 16.0;
+}
+
+void test_bmp280_datasheet_example() {
+  const BMP280Calibration cal = datasheetCalibration();
+  TEST_ASSERT_EQUAL_UINT16(27504, cal.T1);
+  TEST_ASSERT_EQUAL_INT16(-10685, cal.P2);
+  int32_t tFine = bmp280TemperatureFine(519888, cal);
+  TEST_ASSERT_EQUAL_INT32(128422, tFine);
+  TEST_ASSERT_EQUAL_INT32(2508, bmp280TemperatureCenti(tFine));              // 25,08 °C
+  TEST_ASSERT_FLOAT_WITHIN(0.05, 100653.27, bmp280PressureQ8(415148, tFine, cal) / 256.0);
+  TEST_ASSERT_EQUAL_UINT32(0, bmp280PressureQ8(415148, tFine, BMP280Calibration()));  // P1 = 0 : pas de division par zéro
+}
+
+// Balayage -19..61 °C, 700..1200 hPa : inclut adc_T / 8 < 2 * T1 (sous ~0 °C)
+void test_bmp280_matches_double_formulas() {
+  const BMP280Calibration cal = datasheetCalibration();
+  double worstT = 0.0;
+  double worstP = 0.0;
+  for (int i = 0; i < 256; i++) {
+    int32_t adcT = 380000 + i * 800;
+    int32_t adcP = 250000 + i * 1400;
+    double reference = referenceTemperatureFine(adcT, cal);
+    int32_t fine = bmp280TemperatureFine(adcT, cal);
+    worstT = fmax(worstT, fabs(bmp280TemperatureCenti(fine) / 100.0 - reference / 5120.0));
+    worstP = fmax(worstP, fabs(bmp280PressureQ8(adcP, fine, cal) / 256.0 - referencePressurePa(adcP, reference, cal)));
+  }
+  TEST_ASSERT_TRUE(worstT <= 0.01);
+  TEST_ASSERT_TRUE(worstP < 0.25);
+}
+
+// Bornes annoncées dans bmp280_compensation.h, contre pow() en double
+void test_bmp280_altitude_bounds() {
+  double worst = 0.0;
+  double worstLow = 0.0;
+  for (int i = 0; i <= 20000; i++) {
+    double ratio = 0.27 + (1.2 - 0.27) * i / 20000.0;
+    double error = fabs(bmp280AltitudeM((float)(ratio * 1013.25), 1013.25f) - 44330.0 * (1.0 - pow(ratio, 1.0 / 5.255)));
+    worst = fmax(worst, error);
+    if (ratio >= 0.75) worstLow = fmax(worstLow, error);
+  }
+  TEST_ASSERT_TRUE(worst < 0.6);
+  TEST_ASSERT_TRUE(worstLow < 0.1);
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.0f, bmp280AltitudeM(1013.25f, 1013.25f));
+}
+
+// ========== UBX ==========
+
+static UBXDecoder testDecoder;
+
+static void putU2(uint8_t* p, uint16_t value) {
+  p[0] = value & 0xFF;
+  p[1] = value >> 8;
+}
+
+static void putU4(uint8_t* p, uint32_t value) {
+  for (uint8_t i = 0; i < 4; i++) p[i] = (value >> (8 * i)) & 0xFF;
+}
+
+// Trame complète ou erreur de checksum, sinon le résultat du dernier octet
+static UBXPushResult pushFrame(const uint8_t* frame, size_t size) {
+  UBXPushResult result = UBX_PUSH_IDLE;
+  for (size_t i = 0; i < size; i++) {
+    UBXPushResult pushed = testDecoder.push(frame[i]);
+    if (result != UBX_PUSH_FRAME && result != UBX_PUSH_ERROR) result = pushed;
+  }
+  return result;
+}
+
+// Solution 3D à Munich, 12:35:10 UTC le 23/03/2026
+static size_t buildNavPvt(uint8_t* frame) {
+  uint8_t pvt[UBX_NAV_PVT_LENGTH] = {0};
+  putU2(pvt + 4, 2026);
+  pvt[6] = 3;
+  pvt[7] = 23;
+  pvt[8] = 12;
+  pvt[9] = 35;
+  pvt[10] = 10;
+  pvt[11] = 0x07;                           // validDate | validTime | fullyResolved
+  pvt[20] = 3;
+  pvt[21] = 0x01;                           // gnssFixOK
+  pvt[23] = 8;
+  putU4(pvt + 24, 115166674);               // 11.5166674°
+  putU4(pvt + 28, 481173020);               // 48.1173020°
+  putU4(pvt + 36, 545400);                  // hMSL, mm
+  putU4(pvt + 40, 1800);                    // hAcc, mm
+  putU4(pvt + 60, 115);                     // mm/s
+  putU4(pvt + 64, 8440000);
+  putU2(pvt + 76, 161);
+  return ubxBuildFrame(UBX_CLASS_NAV, UBX_NAV_PVT, pvt, sizeof(pvt), frame);
+}
+
+static size_t buildNavDop(uint8_t* frame) {
+  uint8_t dop[UBX_NAV_DOP_LENGTH] = {0};
+  putU2(dop + 6, 161);                      // pDOP
+  putU2(dop + 10, 131);                     // vDOP
+  putU2(dop + 12, 94);                      // hDOP
+  return ubxBuildFrame(UBX_CLASS_NAV, UBX_NAV_DOP, dop, sizeof(dop), frame);
+}
+
+void test_ubx_frame_checksum() {
+  static const uint8_t payload[3] = {1, 2, 3};
+  uint8_t frame[UBX_FRAME_OVERHEAD + 3];
+  TEST_ASSERT_EQUAL_UINT32(sizeof(frame), ubxBuildFrame(UBX_CLASS_CFG, UBX_CFG_MSG, payload, 3, frame));
+  // Fletcher 8 bits sur 06 01 03 00 01 02 03
+  static const uint8_t expected[] = {0xB5, 0x62, 0x06, 0x01, 0x03, 0x00, 0x01, 0x02, 0x03, 0x10, 0x49};
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, frame, sizeof(expected));
+
+  testDecoder.reset();
+  TEST_ASSERT_EQUAL_UINT8(UBX_PUSH_FRAME, pushFrame(frame, sizeof(frame)));
+  TEST_ASSERT_EQUAL_UINT8(UBX_CLASS_CFG, testDecoder.cls);
+  TEST_ASSERT_EQUAL_UINT8(UBX_CFG_MSG, testDecoder.id);
+  TEST_ASSERT_EQUAL_UINT16(3, testDecoder.length);
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(payload, testDecoder.payload, 3);
+}
+
+void test_ubx_decoder_resync() {
+  uint8_t frame[UBX_FRAME_OVERHEAD + UBX_NAV_DOP_LENGTH];
+  size_t size = buildNavDop(frame);
+  testDecoder = UBXDecoder();
+  TEST_ASSERT_EQUAL_UINT8(UBX_PUSH_IDLE, testDecoder.push('$'));   // Texte NMEA entre deux trames
+  frame[10] ^= 0x10;
+  TEST_ASSERT_EQUAL_UINT8(UBX_PUSH_ERROR, pushFrame(frame, size));
+  frame[10] ^= 0x10;
+  // B5 B5 62 : la seconde synchro relance la trame
+  TEST_ASSERT_EQUAL_UINT8(UBX_PUSH_BUSY, testDecoder.push(UBX_SYNC_CHAR_1));
+  TEST_ASSERT_EQUAL_UINT8(UBX_PUSH_FRAME, pushFrame(frame, size));
+  TEST_ASSERT_EQUAL_UINT32(1, testDecoder.checksumErrors);
+  TEST_ASSERT_EQUAL_UINT32(1, testDecoder.frames);
+
+  // Longueur annoncée au-delà de UBX_MAX_PAYLOAD : sautée sans décodage, puis resynchronisation
+  static const uint8_t oversize[] = {0xB5, 0x62, 0x01, 0x35, 0xFF, 0x7F};
+  pushFrame(oversize, sizeof(oversize));
+  for (uint32_t i = 0; i < 0x7FFF + 2; i++) testDecoder.push(0);
+  TEST_ASSERT_EQUAL_UINT32(1, testDecoder.oversizeFrames);
+  TEST_ASSERT_EQUAL_UINT8(UBX_PUSH_FRAME, pushFrame(frame, size));
+}
+
+void test_ubx_nav_pvt_and_dop() {
+  uint8_t frames[2 * UBX_FRAME_OVERHEAD + UBX_NAV_PVT_LENGTH + UBX_NAV_DOP_LENGTH];
+  size_t pvtSize = buildNavPvt(frames);
+  size_t size = pvtSize + buildNavDop(frames + pvtSize);
+  shimFreezeClock(true);
+  Serial1.shimFeed((const char*)frames, size);
+  updateGPS();
+  TEST_ASSERT_EQUAL_UINT8(GPS_PROTOCOL_UBX, gpsProtocolStatus.protocol);   // NAV-PVT reçu : mode détecté
+  TEST_ASSERT_TRUE(gpsData.hasFix);
+  TEST_ASSERT_EQUAL_STRING("3D", gpsData.fix_type.c_str());
+  TEST_ASSERT_EQUAL_UINT8(8, gpsData.satellites);
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, 48.1173020f, gpsData.latitude);
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, 11.5166674f, gpsData.longitude);
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 545.4f, gpsData.altitude);
+  TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.224f, gpsData.speed);
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, 84.4f, gpsData.course);
+  TEST_ASSERT_TRUE(gpsData.year == 2026 && gpsData.month == 3 && gpsData.day == 23);
+  TEST_ASSERT_TRUE(gpsData.hour == 12 && gpsData.minute == 35 && gpsData.second == 10);
+  TEST_ASSERT_EQUAL_UINT32(1800, gpsProtocolStatus.hAccMm);
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, 1.61f, gpsData.pdop);
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, 0.94f, gpsData.hdop);
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, 1.31f, gpsData.vdop);
+
+  // NAV-DOP arrêté (récepteur configuré ailleurs) : HDOP/VDOP invalides, pas figés
+  shimAdvanceMicros((GPS_UBX_TIMEOUT_MS + 1) * 1000ULL);
+  Serial1.shimFeed((const char*)frames, pvtSize);
+  updateGPS();
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 999.0f, gpsData.hdop);
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 999.0f, gpsData.vdop);
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, 1.61f, gpsData.pdop);
+  stopGPSUbx();
+  shimFreezeClock(false);
+}
+
+// ========== GPS TIME ==========
+
+#define TEST_PPS_PIN 41
+#define TEST_PPS_DRIFT_PPM 20       // Oscillateur local rapide : 1 000 020 µs par seconde GPS
+
+void test_gps_unix_time() {
+  TEST_ASSERT_EQUAL_UINT32(0UL, gpsUnixTime(1970, 1, 1, 0, 0, 0));
+  TEST_ASSERT_EQUAL_UINT32(1774269319UL, gpsUnixTime(2026, 3, 23, 12, 35, 19));
+  TEST_ASSERT_EQUAL_UINT32(951782400UL, gpsUnixTime(2000, 2, 29, 0, 0, 0));      // 2000 bissextile
+  TEST_ASSERT_EQUAL_UINT32(4102444799UL, gpsUnixTime(2099, 12, 31, 23, 59, 59));
+}
+
+// Fronts PPS exacts sur une horloge locale qui avance de 20 ppm : la droite retrouve la dérive
+void test_gps_pps_discipline() {
+  shimFreezeClock(true);
+  beginGPSTime(TEST_PPS_PIN);
+  uint32_t unixSeconds = 1774269319UL;
+  for (uint8_t i = 0; i < 8; i++) {
+    shimAdvanceMicros(1000000 + TEST_PPS_DRIFT_PPM - 100000);
+    shimSetPinLevel(TEST_PPS_PIN, HIGH);
+    maintainGPSTime();
+    gpsTimeOnUtc(unixSeconds++, millis());
+    shimAdvanceMicros(100000);
+    shimSetPinLevel(TEST_PPS_PIN, LOW);
+  }
+  const GPSTimeStatus& status = gpsTimeStatus;
+  TEST_ASSERT_EQUAL_UINT8(GPS_TIME_LOCKED, status.state);
+  TEST_ASSERT_EQUAL_UINT32(0, status.glitches);
+  TEST_ASSERT_FLOAT_WITHIN(0.5, TEST_PPS_DRIFT_PPM, status.driftPpm);
+  // 100 ms locaux après le dernier front = 99 998 µs GPS
+  uint64_t utcUs = 0;
+  TEST_ASSERT_TRUE(gpsTimeNow(utcUs));
+  int64_t error = (int64_t)(utcUs - ((uint64_t)(unixSeconds - 1) * 1000000ULL + 99998ULL));
+  TEST_ASSERT_TRUE(error > -5 && error < 5);
+
+  // Impulsion parasite juste après le front : rejetée, le verrouillage tient
+  shimSetPinLevel(TEST_PPS_PIN, HIGH);
+  shimSetPinLevel(TEST_PPS_PIN, LOW);
+  maintainGPSTime();
+  TEST_ASSERT_EQUAL_UINT32(1, status.glitches);
+  TEST_ASSERT_EQUAL_UINT8(GPS_TIME_LOCKED, status.state);
+  stopGPSTime();
+  shimFreezeClock(false);
+}
+
+// ========== DHT ==========
+
+// DHT22 : 48.2 %RH, 21.4 °C
+static const uint8_t DHT_FRAME[5] = {0x01, 0xE2, 0x00, 0xD6, 0xB9};
+
+// Fronts d'une réponse complète, avec une gigue de quelques µs (ISR retardée par le Wi-Fi)
+static uint8_t buildDHTEdges(const uint8_t data[5], uint32_t* edges) {
+  uint32_t t = 1000;
+  uint8_t count = 0;
+  edges[count++] = t;        // Relâchement de la ligne
+  t += 30;
+  edges[count++] = t;        // Réponse : 80 µs bas, 80 µs haut
+  t += 80;
+  edges[count++] = t;
+  t += 80;
+  for (uint8_t bit = 0; bit < 40; bit++) {
+    bool one = (data[bit / 8] >> (7 - bit % 8)) & 1;
+    edges[count++] = t;      // Début du bit : 50 µs bas
+    t += 50 + bit % 3;
+    edges[count++] = t;      // Impulsion haute : la durée code le bit
+    t += (one ? 70 : 27) + bit % 5;
+  }
+  edges[count++] = t;        // 50 µs bas, puis la ligne est relâchée
+  t += 50;
+  edges[count++] = t;
+  return count;
+}
+
+void test_dht_decode_frame() {
+  uint32_t edges[DHT_MAX_EDGES];
+  uint8_t count = buildDHTEdges(DHT_FRAME, edges);
+  uint8_t data[5];
+  TEST_ASSERT_EQUAL_UINT8(85, count);
+  TEST_ASSERT_EQUAL_UINT8(DHT_READ_OK, decodeDHTFrame(edges, count, data));
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(DHT_FRAME, data, 5);
+  // Fronts de réponse manqués (ISR armée en retard) : le décodage part de la fin
+  TEST_ASSERT_EQUAL_UINT8(DHT_READ_OK, decodeDHTFrame(edges + 3, count - 3, data));
+  TEST_ASSERT_EQUAL_UINT8(DHT_READ_TIMEOUT, decodeDHTFrame(edges, 40, data));
+  edges[60] += 200;          // Front perdu : impulsion hors plage
+  TEST_ASSERT_EQUAL_UINT8(DHT_READ_FRAME_ERROR, decodeDHTFrame(edges, count, data));
+
+  uint8_t corrupted[5];
+  memcpy(corrupted, DHT_FRAME, sizeof(corrupted));
+  corrupted[1] ^= 0x04;      // Bit inversé : checksum faux
+  count = buildDHTEdges(corrupted, edges);
+  TEST_ASSERT_EQUAL_UINT8(DHT_READ_CHECKSUM_ERROR, decodeDHTFrame(edges, count, data));
+}
+
+void test_dht_convert_and_median() {
+  int16_t temperature = 0;
+  int16_t humidity = 0;
+  convertDHTFrame(DHT_FRAME, 22, temperature, humidity);
+  TEST_ASSERT_EQUAL_INT16(214, temperature);
+  TEST_ASSERT_EQUAL_INT16(482, humidity);
+  static const uint8_t negative[5] = {0x02, 0x8C, 0x80, 0x65, 0x73};   // DHT22 : 65.2 %RH, -10.1 °C
+  convertDHTFrame(negative, 22, temperature, humidity);
+  TEST_ASSERT_EQUAL_INT16(-101, temperature);
+  TEST_ASSERT_EQUAL_INT16(652, humidity);
+  static const uint8_t dht11[5] = {45, 0, 23, 4, 72};                  // DHT11 : octets entier + dixième
+  convertDHTFrame(dht11, 11, temperature, humidity);
+  TEST_ASSERT_EQUAL_INT16(234, temperature);
+  TEST_ASSERT_EQUAL_INT16(450, humidity);
+
+  // 85.0 °C avec un checksum correct : valeur aberrante que seule la médiane écarte
+  static const int16_t readings[5] = {214, 850, 213, 215, 214};
+  TEST_ASSERT_EQUAL_INT16(214, medianDHTValue(readings, 5));
+  TEST_ASSERT_EQUAL_INT16(532, medianDHTValue(readings, 2));
+  TEST_ASSERT_EQUAL_INT16(0, medianDHTValue(readings, 0));
+}
+
+// ========== DISTANCE ==========
+
+#define TEST_TRIG_PIN 12
+#define TEST_ECHO_PIN 13
+
+// Un cycle complet : déclenchement, écho simulé sur la broche ECHO, décodage
+static void runDistanceCycle(uint32_t echoUs) {
+  requestDistanceReading();
+  maintainDistanceSensor();
+  shimAdvanceMicros(450);    // Salve de 8 impulsions à 40 kHz avant la montée d'ECHO
+  shimSetPinLevel(TEST_ECHO_PIN, HIGH);
+  shimAdvanceMicros(echoUs);
+  shimSetPinLevel(TEST_ECHO_PIN, LOW);
+  shimAdvanceMicros(1000);
+  maintainDistanceSensor();
+}
+
+void test_distance_conversion() {
+  TEST_ASSERT_FLOAT_WITHIN(0.01f, 331.3f, speedOfSound(0.0f));
+  TEST_ASSERT_FLOAT_WITHIN(0.1f, 343.2f, speedOfSound(20.0f));
+  TEST_ASSERT_FLOAT_WITHIN(0.1f, 100.0f, echoToDistanceCm(5831, 20.0f));
+  // Même écho à 20 °C et à 35 °C : ~2,5 cm d'écart sur 1 m sans compensation
+  TEST_ASSERT_TRUE(echoToDistanceCm(5831, 35.0f) - echoToDistanceCm(5831, 20.0f) > 2.5f);
+}
+
+void test_distance_median_kalman() {
+  static const float readings[8] = {100.2f, 99.8f, 250.0f, 100.1f, 99.9f, 100.3f, 3.0f, 100.0f};
+  float window[DISTANCE_MEDIAN_WINDOW];
+  DistanceKalman kalman;
+  uint8_t count = 0;
+  float worst = 0.0f;
+  for (uint8_t i = 0; i < 8; i++) {
+    window[i % DISTANCE_MEDIAN_WINDOW] = readings[i];
+    if (count < DISTANCE_MEDIAN_WINDOW) count++;
+    float filtered = kalman.update(medianDistanceValue(window, count));
+    if (i >= 2 && fabsf(filtered - 100.0f) > worst) worst = fabsf(filtered - 100.0f);
+  }
+  // Échos parasites isolés (250 cm, 3 cm) : écartés par la médiane avant le Kalman
+  TEST_ASSERT_TRUE(worst < 0.5f);
+  TEST_ASSERT_FLOAT_WITHIN(1e-4f, 100.0f, medianDistanceValue(readings, 2));
+}
+
+// Curseur porté par le client (/api/distance-stream?since=) : anneau, pertes et redémarrage
+void test_distance_sample_cursor() {
+  shimFreezeClock(true);
+  beginDistanceSensor(TEST_TRIG_PIN, TEST_ECHO_PIN, 10);
+  for (uint8_t i = 0; i < DISTANCE_STREAM_SAMPLES + 6; i++) runDistanceCycle(5831);
+  const DistanceSensorStatus& status = distanceSensorStatus;
+  TEST_ASSERT_EQUAL_UINT32(DISTANCE_STREAM_SAMPLES + 6, status.readings);
+  TEST_ASSERT_EQUAL_UINT32(0, status.timeouts + status.outOfRange + status.busySkips);
+  TEST_ASSERT_FLOAT_WITHIN(0.1f, echoToDistanceCm(5831, status.temperatureC), status.filteredCm);
+
+  DistanceSample samples[DISTANCE_STREAM_SAMPLES];
+  uint32_t cursor = 0;
+  uint32_t dropped = 0;
+  TEST_ASSERT_EQUAL_UINT8(DISTANCE_STREAM_SAMPLES, readDistanceSamples(cursor, samples, DISTANCE_STREAM_SAMPLES, dropped));
+  TEST_ASSERT_EQUAL_UINT32(6, dropped);
+  TEST_ASSERT_EQUAL_UINT32(status.sampleSeq, cursor);
+  TEST_ASSERT_EQUAL_UINT8(0, readDistanceSamples(cursor, samples, DISTANCE_STREAM_SAMPLES, dropped));
+
+  // Deux clients : chacun son curseur, chacun reçoit la nouvelle mesure
+  uint32_t other = cursor;
+  runDistanceCycle(5831);
+  TEST_ASSERT_EQUAL_UINT8(1, readDistanceSamples(cursor, samples, DISTANCE_STREAM_SAMPLES, dropped));
+  TEST_ASSERT_EQUAL_UINT8(1, readDistanceSamples(other, samples, DISTANCE_STREAM_SAMPLES, dropped));
+  TEST_ASSERT_EQUAL_UINT32(0, dropped);
+
+  // Moteur redémarré : curseur au-delà de la séquence ramené à sa fin
+  beginDistanceSensor(TEST_TRIG_PIN, TEST_ECHO_PIN, 10);
+  TEST_ASSERT_EQUAL_UINT8(0, readDistanceSamples(cursor, samples, DISTANCE_STREAM_SAMPLES, dropped));
+  TEST_ASSERT_EQUAL_UINT32(0, cursor);
+  stopDistanceSensor();
+  shimFreezeClock(false);
+}
+
+// ========== EXPORTS ==========
+
+// Analyse syntaxique JSON minimale : fin de la valeur, nullptr si elle est invalide
+static const char* skipJsonValue(const char* p);
+
+static const char* skipJsonSpace(const char* p) {
+  while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') p++;
+  return p;
+}
+
+static const char* skipJsonString(const char* p) {
+  if (*p++ != '"') return nullptr;
+  while (*p && *p != '"') {
+    if ((unsigned char)*p < 0x20) return nullptr;
+    if (*p == '\\' && !*++p) return nullptr;
+    p++;
+  }
+  return *p == '"' ? p + 1 : nullptr;
+}
+
+static const char* skipJsonValue(const char* p) {
+  p = skipJsonSpace(p);
+  if (*p == '"') return skipJsonString(p);
+  if (*p == '{' || *p == '[') {
+    char close = (*p == '{') ? '}' : ']';
+    p = skipJsonSpace(p + 1);
+    if (*p == close) return p + 1;
+    while (p) {
+      if (close == '}') {
+        p = skipJsonString(skipJsonSpace(p));
+        if (!p || *(p = skipJsonSpace(p)) != ':') return nullptr;
+        p++;
+      }
+      p = skipJsonValue(p);
+      if (!p) return nullptr;
+      p = skipJsonSpace(p);
+      if (*p == close) return p + 1;
+      if (*p++ != ',') return nullptr;
+    }
+    return nullptr;
+  }
+  for (const char* literal : {"true", "false", "null"}) {
+    size_t n = strlen(literal);
+    if (strncmp(p, literal, n) == 0) return p + n;
+  }
+  const char* start = p;
+  if (*p == '-') p++;
+  while ((*p >= '0' && *p <= '9') || *p == '.' || *p == 'e' || *p == 'E' || *p == '+' || *p == '-') p++;
+  return p > start ? p : nullptr;
+}
+
+static bool isJsonDocument(const String& text) {
+  const char* end = skipJsonValue(text.c_str());
+  return end && *skipJsonSpace(end) == '\0';
+}
+
+static DiagnosticInfo exportDiag;
+static DetailedMemoryInfo exportMemory;
+static EnvironmentalData exportEnv;
+static GPSData exportGps;
+static String exportTests[8];
+static String exportSpi;
+
+static void resetExportFixture() {
+  exportDiag = DiagnosticInfo();
+  exportDiag.uptime = 93784000UL;                  // 1 j 2 h 3 min 4 s
+  exportDiag.chipModel = "ESP32-S3";
+  exportDiag.sdkVersion = "v5.5.1";
+  exportDiag.idfVersion = "v5.5.1-710";
+  exportDiag.gpioList = "1,2,4,5";
+  exportDiag.chipRevision = 2;
+  exportDiag.cpuCores = 2;
+  exportDiag.cpuFreqMHz = 240;
+  exportDiag.totalGPIO = 4;
+  exportDiag.temperature = 41.5f;
+  exportDiag.wifiRSSI = -61;
+  exportDiag.ipAddress = 0x1401A8C0;               // 192.168.1.20
+  const uint8_t mac[6] = {0xF4, 0x12, 0xFA, 0x5C, 0x38, 0xA0};
+  memcpy(exportDiag.mac, mac, sizeof(mac));
+  strcpy(exportDiag.wifiSSID, "Atelier");
+
+  exportMemory = DetailedMemoryInfo();
+  exportMemory.flashSizeReal = 16777216;
+  exportMemory.flashSizeChip = 16777216;
+  exportMemory.psramTotal = 8388608;
+  exportMemory.psramFree = 8180224;
+  exportMemory.psramAvailable = true;
+  exportMemory.psramType = "OPI";
+  exportMemory.sramTotal = 327680;
+  exportMemory.sramFree = 198432;
+  exportMemory.fragmentationPercent = 12.4f;
+  exportMemory.memoryStatus = MEMORY_STATUS_EXCELLENT;
+
+  exportEnv = EnvironmentalData();
+  exportEnv.aht20_available = true;
+  exportEnv.temperature_aht20 = 22.4f;
+  exportEnv.humidity = 48.0f;
+  exportEnv.aht20_status = "OK \"AHT20\"";         // Guillemets : échappés dans l'export JSON
+  exportGps = GPSData();
+  for (String& test : exportTests) test = "Not tested";
+  exportSpi = "MOSI 11, MISO 13";
+}
+
+static ExportContext exportContext(bool gpsAvailable = false) {
+  return {
+    exportDiag, exportMemory, exportEnv, exportGps, gpsAvailable,
+    {exportTests[0], exportTests[1], exportTests[2], exportTests[3],
+     exportTests[4], exportTests[5], exportTests[6], exportTests[7]},
+    exportSpi,
+    "QIO", "80 MHz", "Good", "http://esp32-diagnostic.local",
+    "255.255.255.0", "192.168.1.1", "192.168.1.1",
+    "Power on"
+  };
+}
+
+void test_export_json_is_valid() {
+  resetExportFixture();
+  String json = buildExportJSON(exportContext());
+  TEST_ASSERT_TRUE_MESSAGE(isJsonDocument(json), json.c_str());
+  TEST_ASSERT_TRUE(json.indexOf("\"model\":\"ESP32-S3\"") > 0);
+  TEST_ASSERT_TRUE(json.indexOf("\"mac\":\"F4:12:FA:5C:38:A0\"") > 0);
+  TEST_ASSERT_TRUE(json.indexOf("\"ip\":\"192.168.1.20\"") > 0);
+  TEST_ASSERT_TRUE(json.indexOf("\"aht20_status\":\"OK \\\"AHT20\\\"\"") > 0);
+  // Capteur absent, pas de fix, benchmarks non lancés
+  TEST_ASSERT_TRUE(json.indexOf("\"pressure\":null") > 0);
+  TEST_ASSERT_TRUE(json.indexOf("\"latitude\":null") > 0);
+  TEST_ASSERT_TRUE(json.indexOf("\"date_time\":\"N/A\"") > 0);
+  TEST_ASSERT_TRUE(json.indexOf("\"benchmarks\":\"not_run\"") > 0);
+  TEST_ASSERT_FALSE(isJsonDocument(json + ","));
+  TEST_ASSERT_FALSE(isJsonDocument(json.substring(0, json.length() - 1)));
+}
+
+void test_export_json_with_fix_and_benchmarks() {
+  resetExportFixture();
+  feedGPS(NMEA_BURST);
+  exportGps = gpsData;
+  exportDiag.cpuBenchmark = 50000;
+  exportDiag.memBenchmark = 1200;
+  String json = buildExportJSON(exportContext(true));
+  TEST_ASSERT_TRUE_MESSAGE(isJsonDocument(json), json.c_str());
+  TEST_ASSERT_TRUE(json.indexOf("\"has_fix\":true") > 0);
+  TEST_ASSERT_TRUE(json.indexOf("\"latitude\":48.117") > 0);
+  TEST_ASSERT_TRUE(json.indexOf("\"date_time\":\"23/3/2026 12:35:19\"") > 0);
+  TEST_ASSERT_TRUE(json.indexOf("\"cpu_mflops\":2.00") > 0);
+}
+
+void test_export_txt() {
+  resetExportFixture();
+  String txt = buildExportTXT(exportContext());
+  TEST_ASSERT_TRUE(txt.startsWith("========================================\r\n"));
+  TEST_ASSERT_TRUE(txt.indexOf(String(PROJECT_NAME) + " v" + PROJECT_VERSION + "\r\n") > 0);
+  TEST_ASSERT_TRUE(txt.indexOf("=== CHIP ===\r\n") > 0);
+  TEST_ASSERT_TRUE(txt.indexOf("IP: 192.168.1.20\r\n") > 0);
+  TEST_ASSERT_TRUE(txt.indexOf("  Pression: N/A\r\n") > 0);
+  TEST_ASSERT_TRUE(txt.indexOf("Uptime: 1d 2h 3m\r\n") > 0);
+  TEST_ASSERT_TRUE(txt.endsWith("========================================\r\n"));
+}
+
+void test_export_csv_rows() {
+  resetExportFixture();
+  String csv = buildExportCSV(exportContext());
+  TEST_ASSERT_TRUE(csv.startsWith("Category,Parameter,Value\r\n"));
+  TEST_ASSERT_TRUE(csv.endsWith("\r\n"));
+  // Chaque ligne : catégorie, paramètre, valeur
+  int rows = 0;
+  int start = 0;
+  while (start < (int)csv.length()) {
+    int end = csv.indexOf("\r\n", start);
+    TEST_ASSERT_TRUE(end > start);
+    String row = csv.substring(start, end);
+    int first = row.indexOf(',');
+    TEST_ASSERT_TRUE_MESSAGE(first > 0 && row.indexOf(',', first + 1) > first + 1, row.c_str());
+    rows++;
+    start = end + 2;
+  }
+  TEST_ASSERT_TRUE(rows > 40);
+  TEST_ASSERT_TRUE(csv.indexOf("WiFi,IP,192.168.1.20\r\n") > 0);
+  TEST_ASSERT_TRUE(csv.indexOf("GPS,Latitude,N/A\r\n") > 0);
+}
+
+void test_export_print_html() {
+  resetExportFixture();
+  String html = buildPrintHTML(exportContext());
+  TEST_ASSERT_TRUE(html.startsWith("<!DOCTYPE html><html><head><meta charset='UTF-8'>"));
+  TEST_ASSERT_TRUE(html.endsWith("</body></html>"));
+  TEST_ASSERT_TRUE(html.indexOf("<span>1 days 2 hours 3 minutes</span>") > 0);
+  TEST_ASSERT_TRUE(html.indexOf("MAC: F4:12:FA:5C:38:A0") > 0);
+  // Section performance seulement après un benchmark
+  TEST_ASSERT_TRUE(html.indexOf("MFLOPS") < 0);
+  exportDiag.cpuBenchmark = 50000;
+  html = buildPrintHTML(exportContext());
+  TEST_ASSERT_TRUE(html.indexOf("(2.00 MFLOPS)") > 0);
+}
+
+void test_format_uptime() {
+  TEST_ASSERT_EQUAL_STRING("0 minutes", formatUptime(0, 0, 0).c_str());
+  TEST_ASSERT_EQUAL_STRING("5 minutes", formatUptime(0, 0, 5).c_str());
+  TEST_ASSERT_EQUAL_STRING("2 hours", formatUptime(0, 2, 0).c_str());
+  TEST_ASSERT_EQUAL_STRING("3 days 0 hours", formatUptime(3, 0, 0).c_str());
+}
+
+void test_export_follows_language() {
+  resetExportFixture();
+  currentLanguage = LANG_FR;
+  String csv = buildExportCSV(exportContext());
+  TEST_ASSERT_TRUE(csv.startsWith("Catégorie,Paramètre,Valeur\r\n"));
+}
+
+// ========== ALLOCATION BUDGETS ==========
+// Same bodies and budgets as setupWebServer() (main.cpp); DiagnosticWebServer
+// counts each call like on the device. Measurement conditions: see
+// http_alloc_budgets.h
+
+#define BUDGET_PPS_PIN 4
+
+static DiagnosticWebServer budgetServer(80);
+static char budgetFillerUris[HTTP_METRICS_MAX_ROUTES][24];
+static char budgetTraceNames[TRACE_MAX_NAMES][16];
+static BootProfile budgetBoot;
+static ADCSamplerStatus budgetAdcStatus;
+static ADCStreamSnapshot budgetAdc;
+
+// Fixtures des capteurs du banc (native/bench/bench_sensors.cpp)
+void benchAttachEnvironmentalSensors();
+
+static void sendBudgetExport(const char* extension, const char* contentType, const String& body) {
+  budgetServer.sendHeader("Content-Disposition", "attachment; filename=esp32_diagnostic_v" + String(PROJECT_VERSION) + extension);
+  budgetServer.send(200, contentType, body);
+}
+
+// Enregistrées une fois (table des routes globale), complétée jusqu'à HTTP_METRICS_MAX_ROUTES
+static void registerBudgetRoutes() {
+  static bool registered = false;
+  if (registered) return;
+  registered = true;
+  requestArena.begin(REQUEST_ARENA_SIZE);
+
+  budgetServer.on("/api/gps", []() {
+    updateGPS();
+    sendGPSData(budgetServer, gpsData);
+  }, HTTP_ALLOC_BUDGET_GPS);
+  budgetServer.on("/api/gps/satellites", []() {
+    updateGPS();
+    sendGPSSatellites(budgetServer, gpsData, gpsSkyView, gpsAvailable);
+  }, HTTP_ALLOC_BUDGET_GPS_SATELLITES);
+  budgetServer.on("/api/environmental-sensors", []() {
+    updateEnvironmentalSensors();
+    sendEnvironmentalSensors(budgetServer, envData);
+  }, HTTP_ALLOC_BUDGET_ENVIRONMENTAL);
+  budgetServer.on("/api/memory-details", []() {
+    sendMemoryDetails(budgetServer, exportMemory);
+  }, HTTP_ALLOC_BUDGET_MEMORY_DETAILS);
+  budgetServer.on("/api/adc-stream", []() {
+    sendADCStream(budgetServer, budgetAdcStatus, budgetAdc);
+  }, HTTP_ALLOC_BUDGET_ADC_STREAM);
+  budgetServer.on("/api/boot-profile", []() {
+    sendBootProfile(budgetServer, budgetBoot, true);
+  }, HTTP_ALLOC_BUDGET_BOOT_PROFILE);
+  budgetServer.on("/api/metrics/http", []() {
+    sendHttpMetrics(budgetServer);
+  }, HTTP_ALLOC_BUDGET_HTTP_METRICS);
+  budgetServer.on("/api/tasks", []() {
+    sendTasks(budgetServer, taskProfilerData, 2);
+  }, HTTP_ALLOC_BUDGET_TASKS);
+  budgetServer.on("/api/loop-monitor", []() {
+    sendLoopMonitor(budgetServer, loopMonitorData);
+  }, HTTP_ALLOC_BUDGET_LOOP_MONITOR);
+  budgetServer.on("/api/trace", []() {
+    traceSetActive(false);
+    sendTrace(budgetServer);
+    traceSetActive(true);
+  }, HTTP_ALLOC_BUDGET_TRACE);
+  budgetServer.on("/metrics", []() {
+    sendMetrics(budgetServer, true, -61, exportDiag.temperature, exportEnv, gpsData, gpsAvailable);
+  }, HTTP_ALLOC_BUDGET_METRICS);
+  budgetServer.on("/export/txt", []() {
+    sendBudgetExport(".txt", "text/plain; charset=utf-8", buildExportTXT(exportContext(true)));
+  }, HTTP_ALLOC_BUDGET_EXPORT_TXT);
+  budgetServer.on("/export/json", []() {
+    sendBudgetExport(".json", "application/json", buildExportJSON(exportContext(true)));
+  }, HTTP_ALLOC_BUDGET_EXPORT_JSON);
+  budgetServer.on("/export/csv", []() {
+    sendBudgetExport(".csv", "text/csv; charset=utf-8", buildExportCSV(exportContext(true)));
+  }, HTTP_ALLOC_BUDGET_EXPORT_CSV);
+  budgetServer.on("/print", []() {
+    budgetServer.send(200, "text/html; charset=utf-8", buildPrintHTML(exportContext(true)));
+  }, HTTP_ALLOC_BUDGET_PRINT);
+
+  budgetServer.on("/test/json-stream", []() {
+    budgetServer.beginJsonStream(200);
+    for (const char* fragment : CBOR_FRAGMENTS) budgetServer.sendJsonFragment(fragment, strlen(fragment));
+    budgetServer.endJsonStream();
+  });
+
+  for (uint16_t i = getHttpRouteCount(); i < HTTP_METRICS_MAX_ROUTES; i++) {
+    snprintf(budgetFillerUris[i], sizeof(budgetFillerUris[i]), "/api/route-%03u", i);
+    budgetServer.on(budgetFillerUris[i], []() {
+      budgetServer.send(200, "application/json", "{\"success\":true}");
+    });
+  }
+}
+
+static const HttpRouteMetrics* findBudgetRoute(const char* uri) {
+  for (uint16_t i = 0; i < getHttpRouteCount(); i++) {
+    const HttpRouteMetrics* route = getHttpRouteMetrics(i);
+    if (strcmp(route->uri, uri) == 0) return route;
+  }
+  return nullptr;
+}
+
+// Chaque route une fois, sauf `except` : toutes apparaissent dans les rapports
+static void callAllRoutes(const char* except) {
+  for (uint16_t i = 0; i < getHttpRouteCount(); i++) {
+    const char* uri = getHttpRouteMetrics(i)->uri;
+    if (strcmp(uri, except) != 0) budgetServer.shimRequest(uri);
+  }
+}
+
+// Premier appel : dimensionne les tampons d'en-têtes ; compteurs remis à zéro, puis appel mesuré
+// Horloge figée : latences et horodatages (donc longueurs des nombres) reproductibles
+static const HttpRouteMetrics* measureRoute(const char* uri, bool allRoutesCalled = false) {
+  registerBudgetRoutes();
+  shimFreezeClock(true);
+  budgetServer.shimRequest(uri);
+  resetHttpMetrics();
+  if (allRoutesCalled) callAllRoutes(uri);
+  budgetServer.shimRequest(uri);
+  shimFreezeClock(false);
+  TEST_ASSERT_EQUAL_INT(200, budgetServer.shimCode);
+  const HttpRouteMetrics* route = findBudgetRoute(uri);
+  TEST_ASSERT_NOT_NULL(route);
+  TEST_ASSERT_EQUAL_UINT32(1, route->latency.count);
+  printf("%s: %u allocations, budget %u\n", uri, (unsigned)route->allocMax, (unsigned)route->allocBudget);
+  return route;
+}
+
+// Pas de lwIP sur l'hôte : la route doit tenir dans la réponse plus la part de son handler
+static void assertWithinBudget(const HttpRouteMetrics* route, uint16_t handler, uint16_t budget) {
+  TEST_ASSERT_EQUAL_UINT16(budget, route->allocBudget);
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32_MESSAGE(HTTP_ALLOC_RESPONSE + handler, route->allocMax,
+                                           "Over budget: fix the route, not HTTP_ALLOC_HANDLER_*");
+  TEST_ASSERT_EQUAL_UINT32(0, route->overBudget);
+}
+
+static void lockGPSTime() {
+  shimFreezeClock(true);
+  beginGPSTime(BUDGET_PPS_PIN);
+  uint32_t unixSeconds = 1774269319UL;
+  for (uint8_t i = 0; i < GPS_PPS_MIN_EDGES + 2; i++) {
+    shimAdvanceMicros(900000);
+    shimSetPinLevel(BUDGET_PPS_PIN, HIGH);
+    maintainGPSTime();
+    gpsTimeOnUtc(unixSeconds++, millis());
+    shimAdvanceMicros(100000);
+    shimSetPinLevel(BUDGET_PPS_PIN, LOW);
+  }
+  shimFreezeClock(false);
+}
+
+static void fillTaskProfiler() {
+  TaskProfilerData& data = taskProfilerData;
+  data = TaskProfilerData();
+  data.available = true;
+  data.runTimeStats = true;
+  data.samples = 86400;
+  data.windowFill = TASK_PROFILER_WINDOW;
+  data.liveTasks = TASK_PROFILER_MAX_TASKS;
+  data.cores[0] = {97.5f, 96.2f};
+  data.cores[1] = {88.1f, 90.4f};
+  for (uint8_t i = 0; i < TASK_PROFILER_MAX_TASKS; i++) {
+    TaskProfileEntry& task = data.tasks[i];
+    task.handle = (TaskHandle_t)(uintptr_t)(0x3FCA0000UL + i * 0x160);
+    snprintf(task.name, sizeof(task.name), "sensor_task_%02u", i);
+    task.core = i % 3 == 2 ? TASK_PROFILER_ANY_CORE : i % 2;
+    task.priority = 1 + i % 24;
+    task.state = eBlocked;
+    task.alive = i % 8 != 7;
+    task.stackMinBytes = 1536 + i * 64;
+    task.stackWarning = i % 5 == 0;
+    task.cpuLast = 12.5f;
+    task.cpuWindow = 11.25f;
+  }
+  snprintf(data.tasks[0].name, sizeof(data.tasks[0].name), "ui\"q\\1");  // Quote and backslash in a task name
+  data.taskCount = TASK_PROFILER_MAX_TASKS;
+}
+
+void test_alloc_budget_gps() {
+  feedGPS(NMEA_BURST);
+  Serial1.shimFeed(NMEA_BURST, strlen(NMEA_BURST));
+  const HttpRouteMetrics* route = measureRoute("/api/gps");
+  TEST_ASSERT_TRUE(strstr(budgetServer.shimBody, "\"fix_type\":\"") != nullptr);
+  assertWithinBudget(route, HTTP_ALLOC_HANDLER_ARENA, HTTP_ALLOC_BUDGET_GPS);
+}
+
+void test_alloc_budget_gps_satellites() {
+  feedGPS(NMEA_BURST);
+  GPSSkyView& sky = gpsSkyView;
+  for (uint8_t i = sky.count; i < GPS_MAX_SATELLITES; i++) {
+    GPSSatellite& sat = sky.satellites[i];
+    sat.system = (GPSConstellation)(GPS_SYSTEM_GPS + i % (GPS_SYSTEM_COUNT - GPS_SYSTEM_GPS));
+    sat.prn = 101 + i;
+    sat.elevation = 45;
+    sat.azimuth = 270;
+    sat.snr = 38;
+    sat.usedInFix = i % 2 == 0;
+  }
+  sky.count = GPS_MAX_SATELLITES;
+  const HttpRouteMetrics* route = measureRoute("/api/gps/satellites");
+  TEST_ASSERT_TRUE(strstr(budgetServer.shimBody, "\"in_view\":48") != nullptr);
+  assertWithinBudget(route, HTTP_ALLOC_HANDLER_ARENA, HTTP_ALLOC_BUDGET_GPS_SATELLITES);
+}
+
+void test_alloc_budget_environmental_sensors() {
+  benchAttachEnvironmentalSensors();
+  const HttpRouteMetrics* route = measureRoute("/api/environmental-sensors");
+  TEST_ASSERT_TRUE(strstr(budgetServer.shimBody, "\"combined_status\":\"Both sensors OK\"") != nullptr);
+  assertWithinBudget(route, HTTP_ALLOC_HANDLER_ARENA, HTTP_ALLOC_BUDGET_ENVIRONMENTAL);
+}
+
+void test_alloc_budget_memory_details() {
+  resetExportFixture();
+  const HttpRouteMetrics* route = measureRoute("/api/memory-details");
+  TEST_ASSERT_TRUE(isJsonDocument(budgetServer.shimBody));
+  assertWithinBudget(route, HTTP_ALLOC_HANDLER_ARENA, HTTP_ALLOC_BUDGET_MEMORY_DETAILS);
+}
+
+void test_alloc_budget_adc_stream() {
+  budgetAdcStatus = ADCSamplerStatus();
+  budgetAdcStatus.running = true;
+  budgetAdcStatus.dma = true;
+  budgetAdcStatus.calibrated = true;
+  budgetAdcStatus.channelCount = ADC_SAMPLER_MAX_CHANNELS;
+  budgetAdcStatus.sampleRate = 80000;
+  budgetAdcStatus.perChannelRate = 10000;
+  budgetAdcStatus.totalSamples = 4000000000UL;
+  budgetAdc.count = ADC_SAMPLER_MAX_CHANNELS;
+  for (uint8_t i = 0; i < ADC_SAMPLER_MAX_CHANNELS; i++) {
+    budgetAdc.stats[i] = {1 + i, 10000, 1650.4f, 1650.9f, 12.37f, 1601, 1702};
+    budgetAdc.histograms[i].startMv = 1600;
+    budgetAdc.histograms[i].binMv = 7;
+    for (uint8_t b = 0; b < ADC_SAMPLER_HISTOGRAM_BINS; b++) {
+      budgetAdc.histograms[i].counts[b] = 120 + b * 37;
+    }
+    budgetAdc.hasHistogram[i] = true;
+  }
+  budgetAdc.spectrumChannel = 0;
+  budgetAdc.bins = ADC_SAMPLER_FFT_SIZE / 2;
+  budgetAdc.binHz = 39.06f;
+  for (uint16_t k = 0; k < budgetAdc.bins; k++) {
+    budgetAdc.magnitudes[k] = 0.25f + k * 0.5f;
+  }
+  const HttpRouteMetrics* route = measureRoute("/api/adc-stream");
+  TEST_ASSERT_TRUE(isJsonDocument(budgetServer.shimBody));
+  assertWithinBudget(route, HTTP_ALLOC_HANDLER_ARENA, HTTP_ALLOC_BUDGET_ADC_STREAM);
+}
+
+void test_alloc_budget_boot_profile() {
+  static const char* const names[] = {"nvs", "i2c", "oled", "tft", "neopixel", "wifi_connect", "mdns", "sd_card"};
+  budgetBoot = BootProfile();
+  budgetBoot.cpuMhz = 240;
+  budgetBoot.serverReadyUs = 412000;
+  budgetBoot.firstResponseUs = 1830000;
+  budgetBoot.bootCompleteUs = 6240000;
+  for (uint8_t i = 0; i < BOOT_PROFILE_MAX_STAGES; i++) {
+    BootStageRecord& stage = budgetBoot.stages[i];
+    stage.name = names[i % 8];
+    stage.core = i % 2;
+    stage.background = i % 4 == 0;
+    stage.done = true;
+    stage.startUs = 420000 + i * 250000ULL;
+    stage.durationUs = 183000 + i * 1000;
+    stage.cycles = 43920000 + i;
+  }
+  budgetBoot.count = BOOT_PROFILE_MAX_STAGES;
+  const HttpRouteMetrics* route = measureRoute("/api/boot-profile");
+  TEST_ASSERT_TRUE(isJsonDocument(budgetServer.shimBody));
+  assertWithinBudget(route, HTTP_ALLOC_HANDLER_ARENA, HTTP_ALLOC_BUDGET_BOOT_PROFILE);
+}
+
+void test_alloc_budget_http_metrics() {
+  const HttpRouteMetrics* route = measureRoute("/api/metrics/http", true);
+  TEST_ASSERT_EQUAL_UINT16(HTTP_METRICS_MAX_ROUTES, getHttpRouteCount());
+  TEST_ASSERT_TRUE(budgetServer.shimBodyLength > NATIVE_HTTP_BODY_SIZE || isJsonDocument(budgetServer.shimBody));
+  assertWithinBudget(route, HTTP_ALLOC_HANDLER_ARENA, HTTP_ALLOC_BUDGET_HTTP_METRICS);
+}
+
+void test_alloc_budget_tasks() {
+  fillTaskProfiler();
+  const HttpRouteMetrics* route = measureRoute("/api/tasks");
+  TEST_ASSERT_TRUE(isJsonDocument(budgetServer.shimBody));
+  TEST_ASSERT_TRUE(strstr(budgetServer.shimBody, "{\"name\":\"ui\\\"q\\\\1\"") != nullptr);
+  assertWithinBudget(route, HTTP_ALLOC_HANDLER_ARENA, HTTP_ALLOC_BUDGET_TASKS);
+}
+
+void test_alloc_budget_loop_monitor() {
+  LoopMonitorData& data = loopMonitorData;
+  resetLoopMonitor();
+  data.loops = 8640000;
+  data.stalls = 1234;
+  for (uint32_t us = 50; us < 2000000; us = us * 3 / 2) {
+    latencyRecord(data.busy, us);
+    latencyRecord(data.period, us + 10000);
+    for (LatencyHistogram& phase : data.phases) latencyRecord(phase, us);
+  }
+  for (uint8_t i = 0; i < LOOP_STALL_TOP; i++) {
+    data.top[i] = {(uint32_t)(86400000UL + i), (uint32_t)(1250000UL - i), (uint32_t)(1200000UL - i),
+                   (uint8_t)(i % LOOP_PHASE_COUNT), ""};
+    memset(data.top[i].culprit, 'x', LOOP_STALL_CULPRIT_LEN - 1);
+  }
+  data.topCount = LOOP_STALL_TOP;
+  const HttpRouteMetrics* route = measureRoute("/api/loop-monitor");
+  TEST_ASSERT_TRUE(isJsonDocument(budgetServer.shimBody));
+  assertWithinBudget(route, HTTP_ALLOC_HANDLER_ARENA, HTTP_ALLOC_BUDGET_LOOP_MONITOR);
+}
+
+void test_alloc_budget_trace() {
+  registerBudgetRoutes();
+  fillTaskProfiler();
+  lockGPSTime();
+  for (uint16_t i = traceNameCount(); i < TRACE_MAX_NAMES; i++) {
+    snprintf(budgetTraceNames[i], sizeof(budgetTraceNames[i]), "sd_log_flush%03u", i);
+    if (i == TRACE_MAX_NAMES - 1) budgetTraceNames[i][6] = '"';
+    traceIntern(budgetTraceNames[i]);
+  }
+  for (uint8_t core = 0; core < traceRingCount(); core++) {
+    shimSetCoreID(core);
+    traceSync();
+    for (uint16_t i = 0; i < TRACE_RING_EVENTS; i++) {
+      traceRecord(i % 2 ? TRACE_EVENT_END : TRACE_EVENT_BEGIN, TRACE_MAX_NAMES - 1 - i % 64, 4000000000UL - i);
+    }
+  }
+  shimSetCoreID(0);
+  const HttpRouteMetrics* route = measureRoute("/api/trace");
+  stopGPSTime();
+  TEST_ASSERT_EQUAL_UINT16(TRACE_MAX_NAMES, traceNameCount());
+  TEST_ASSERT_TRUE(strstr(budgetServer.shimBody, "\"utc_sync\":{") != nullptr);
+  TEST_ASSERT_TRUE(strstr(budgetServer.shimBody, "\"sd_log\\\"flush") != nullptr);
+  TEST_ASSERT_TRUE(strstr(budgetServer.shimBody, ":\"ui\\\"q\\\\1\"") != nullptr);
+  TEST_ASSERT_TRUE(budgetServer.shimBodyLength > NATIVE_HTTP_BODY_SIZE || isJsonDocument(budgetServer.shimBody));
+  assertWithinBudget(route, HTTP_ALLOC_HANDLER_ARENA, HTTP_ALLOC_BUDGET_TRACE);
+}
+
+void test_cbor_streamed_route() {
+  registerBudgetRoutes();
+  budgetServer.shimRequest("/test/json-stream");
+  TEST_ASSERT_EQUAL_STRING("application/json", budgetServer.shimContentType);
+  TEST_ASSERT_TRUE(isJsonDocument(budgetServer.shimBody));
+
+  uint8_t whole[96];
+  size_t wholeSize = jsonToCbor(budgetServer.shimBody, budgetServer.shimBodyLength, whole, sizeof(whole));
+  TEST_ASSERT_TRUE(wholeSize > 0);
+  budgetServer.shimRequest("/test/json-stream", "fmt=cbor");
+  TEST_ASSERT_EQUAL_STRING("application/cbor", budgetServer.shimContentType);
+  TEST_ASSERT_EQUAL_UINT32(wholeSize, budgetServer.shimBodyLength);
+  TEST_ASSERT_TRUE(memcmp(whole, budgetServer.shimBody, wholeSize) == 0);
+
+  budgetServer.shimRequest("/api/trace", "", "application/cbor");
+  TEST_ASSERT_EQUAL_STRING("application/cbor", budgetServer.shimContentType);
+  TEST_ASSERT_EQUAL_UINT8(0xBF, (uint8_t)budgetServer.shimBody[0]);
+}
+
+void test_alloc_budget_openmetrics() {
+  resetExportFixture();
+  exportEnv.bmp280_available = true;
+  exportEnv.temperature_bmp280 = 22.1f;
+  exportEnv.pressure = 1013.25f;
+  fillTaskProfiler();
+  feedGPS(NMEA_BURST);
+  const HttpRouteMetrics* route = measureRoute("/metrics", true);
+  TEST_ASSERT_TRUE(strncmp(budgetServer.shimBody, "# TYPE esp32_uptime_seconds gauge", 33) == 0);
+  assertWithinBudget(route, HTTP_ALLOC_HANDLER_ARENA, HTTP_ALLOC_BUDGET_METRICS);
+}
+
+void test_alloc_budget_exports() {
+  resetExportFixture();
+  feedGPS(NMEA_BURST);
+  exportGps = gpsData;
+  exportDiag.cpuBenchmark = 50000;
+  exportDiag.memBenchmark = 1200;
+  for (String& test : exportTests) test = "OK - 8 patterns, 255 levels, no error";
+
+  assertWithinBudget(measureRoute("/export/txt"), HTTP_ALLOC_HANDLER_EXPORT_TXT, HTTP_ALLOC_BUDGET_EXPORT_TXT);
+  assertWithinBudget(measureRoute("/export/json"), HTTP_ALLOC_HANDLER_EXPORT_JSON, HTTP_ALLOC_BUDGET_EXPORT_JSON);
+  TEST_ASSERT_TRUE(isJsonDocument(budgetServer.shimBody));
+  assertWithinBudget(measureRoute("/export/csv"), HTTP_ALLOC_HANDLER_EXPORT_CSV, HTTP_ALLOC_BUDGET_EXPORT_CSV);
+  assertWithinBudget(measureRoute("/print"), HTTP_ALLOC_HANDLER_PRINT, HTTP_ALLOC_BUDGET_PRINT);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_nmea_burst_fix);
+  RUN_TEST(test_nmea_burst_skyview);
+  RUN_TEST(test_nmea_rmc_void_clears_fix);
+  RUN_TEST(test_nmea_south_west);
+  RUN_TEST(test_nmea_lost_gsv_sentence);
+  RUN_TEST(test_nmea_constellations);
+  RUN_TEST(test_json_escape);
+  RUN_TEST(test_json_escape_to_arena);
+  RUN_TEST(test_json_build_object);
+  RUN_TEST(test_json_append_field_arena);
+  RUN_TEST(test_cbor_stream_matches_document);
+  RUN_TEST(test_cbor_stream_rejects_invalid);
+  RUN_TEST(test_cbor_document_bytes);
+  RUN_TEST(test_bmp280_datasheet_example);
+  RUN_TEST(test_bmp280_matches_double_formulas);
+  RUN_TEST(test_bmp280_altitude_bounds);
+  RUN_TEST(test_ubx_frame_checksum);
+  RUN_TEST(test_ubx_decoder_resync);
+  RUN_TEST(test_ubx_nav_pvt_and_dop);
+  RUN_TEST(test_gps_unix_time);
+  RUN_TEST(test_gps_pps_discipline);
+  RUN_TEST(test_dht_decode_frame);
+  RUN_TEST(test_dht_convert_and_median);
+  RUN_TEST(test_distance_conversion);
+  RUN_TEST(test_distance_median_kalman);
+  RUN_TEST(test_distance_sample_cursor);
+  RUN_TEST(test_export_json_is_valid);
+  RUN_TEST(test_export_json_with_fix_and_benchmarks);
+  RUN_TEST(test_export_txt);
+  RUN_TEST(test_export_csv_rows);
+  RUN_TEST(test_export_print_html);
+  RUN_TEST(test_format_uptime);
+  RUN_TEST(test_export_follows_language);
+  RUN_TEST(test_alloc_budget_gps);
+  RUN_TEST(test_alloc_budget_gps_satellites);
+  RUN_TEST(test_alloc_budget_environmental_sensors);
+  RUN_TEST(test_alloc_budget_memory_details);
+  RUN_TEST(test_alloc_budget_adc_stream);
+  RUN_TEST(test_alloc_budget_boot_profile);
+  RUN_TEST(test_alloc_budget_http_metrics);
+  RUN_TEST(test_alloc_budget_tasks);
+  RUN_TEST(test_alloc_budget_loop_monitor);
+  RUN_TEST(test_alloc_budget_trace);
+  RUN_TEST(test_cbor_streamed_route);
+  RUN_TEST(test_alloc_budget_openmetrics);
+  RUN_TEST(test_alloc_budget_exports);
+  return UNITY_END();
+}
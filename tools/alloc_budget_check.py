@@ -0,0 +1,140 @@
+#!/usr/bin/env python3
+"""
+ESP32 Diagnostic - Per-route Heap Allocation Budget Check
+Version: 3.33.5
+
+Calls the read-only API routes and exporters on a firmware built with
+ENABLE_ALLOC_TRACER (env esp32s3_n16r8_alloctrace), then reads
+/api/metrics/http and compares each route's worst call (alloc_max) with its
+allocation budget (third argument of server.on(), HTTP_ALLOC_BUDGET_DEFAULT
+otherwise). Exits with 1 when a route is over budget, so it can gate a
+release on a bench board. The budgets are targets set in
+include/http_alloc_budgets.h (WebServer response + lwIP share + handler
+share), not measurements: a route over budget is fixed in the route, never
+by raising its number. The host suite (pio test -e native) checks the
+response + handler part; this run checks the whole budget on the device,
+including /api/overview and /api/dashboard, which the host cannot run.
+
+Usage:
+    python tools/alloc_budget_check.py --url http://esp32-diagnostic.local
+    python tools/alloc_budget_check.py --url http://192.168.1.20 -n 5
+    python tools/alloc_budget_check.py --self-test                            # report logic checks
+
+The headroom column is budget - alloc_max: negative means over budget.
+"""
+
+import argparse
+import json
+import sys
+import urllib.request
+
+# GET routes without side effects (no hardware test, no SD write)
+SAFE_ROUTES = [
+    "/api/status", "/api/overview", "/api/dashboard", "/api/system-info", "/api/memory",
+    "/api/wifi-info", "/api/peripherals", "/api/leds-info", "/api/screens-info",
+    "/api/gps", "/api/gps/satellites", "/api/environmental-sensors", "/api/memory-details", "/api/boot-profile",
+    "/api/tasks", "/api/loop-monitor", "/metrics",
+    "/export/txt", "/export/json", "/export/csv", "/print",
+]
+METRICS_URI = "/api/metrics/http"
+
+
+def fetch(url):
+    with urllib.request.urlopen(url, timeout=30) as response:
+        return response.read()
+
+
+def evaluate(metrics):
+    """Rows (uri, calls, avg, max, budget, headroom, peak, status) and the violation count"""
+    rows = []
+    violations = 0
+    for route in sorted(metrics.get("routes", []), key=lambda r: r["uri"]):
+        budget = route.get("alloc_budget", 0)
+        worst = route.get("alloc_max", 0)
+        over = budget != 0 and (worst > budget or route.get("over_budget", 0) > 0)
+        status = "unchecked" if budget == 0 else ("OVER" if over else "ok")
+        violations += 1 if over else 0
+        headroom = budget - worst if budget else None
+        rows.append((route["uri"], route["calls"], route.get("alloc_avg", 0), worst, budget, headroom,
+                     route.get("alloc_peak_max", 0), status))
+    return rows, violations
+
+
+def print_report(rows):
+    print(f"{'URI':<28} {'calls':>5} {'avg':>6} {'max':>6} {'budget':>6} {'room':>6} {'peak B':>8}  status")
+    for uri, calls, avg, worst, budget, headroom, peak, status in rows:
+        room = "-" if headroom is None else headroom
+        print(f"{uri:<28} {calls:>5} {avg:>6} {worst:>6} {budget:>6} {room:>6} {peak:>8}  {status}")
+
+
+def run(base, count):
+    fetch(base + METRICS_URI + "?reset=1")
+    for uri in SAFE_ROUTES:
+        for _ in range(count):
+            try:
+                fetch(base + uri)
+            except OSError as error:
+                print(f"{uri}: {error}")
+                break
+    metrics = json.loads(fetch(base + METRICS_URI))
+    if not metrics.get("alloc_tracer"):
+        print("Firmware built without ENABLE_ALLOC_TRACER (use env esp32s3_n16r8_alloctrace)")
+        return 2
+    rows, violations = evaluate(metrics)
+    print_report(rows)
+    print(f"\n{'✅ All routes within budget' if violations == 0 else f'❌ {violations} route(s) over budget'}")
+    return 0 if violations == 0 else 1
+
+
+def self_test():
+    """Budget evaluation on a synthetic /api/metrics/http document"""
+    metrics = {
+        "alloc_tracer": True,
+        "routes": [
+            {"uri": "/api/gps", "calls": 3, "alloc_budget": 24, "alloc_avg": 17, "alloc_max": 18,
+             "alloc_peak_max": 720, "over_budget": 0},
+            {"uri": "/export/json", "calls": 3, "alloc_budget": 384, "alloc_avg": 390, "alloc_max": 402,
+             "alloc_peak_max": 9100, "over_budget": 2},
+            {"uri": "/api/adc-stream", "calls": 1, "alloc_budget": 0, "alloc_avg": 900, "alloc_max": 900,
+             "alloc_peak_max": 4000, "over_budget": 0},
+            {"uri": "/api/status", "calls": 2, "alloc_budget": 64, "alloc_avg": 40, "alloc_max": 40,
+             "alloc_peak_max": 2100, "over_budget": 1},
+        ],
+    }
+    rows, violations = evaluate(metrics)
+    status = {row[0]: row[7] for row in rows}
+    headroom = {row[0]: row[5] for row in rows}
+    checks = [
+        ("within budget", status["/api/gps"] == "ok"),
+        ("over budget", status["/export/json"] == "OVER"),
+        ("budget 0 unchecked", status["/api/adc-stream"] == "unchecked"),
+        ("earlier call over budget", status["/api/status"] == "OVER"),
+        ("violation count", violations == 2),
+        ("headroom", headroom["/api/gps"] == 6 and headroom["/export/json"] == -18),
+        ("no headroom when unchecked", headroom["/api/adc-stream"] is None),
+    ]
+    failures = 0
+    for label, ok in checks:
+        print(f"  {label}: {'OK' if ok else 'FAIL'}")
+        failures += 0 if ok else 1
+    print("\n✅ Self-test passed" if failures == 0 else f"\n❌ {failures} self-test failure(s)")
+    return failures == 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Check per-route heap allocation budgets of ESP32 Diagnostic")
+    parser.add_argument("--url", help="device base URL, e.g. http://esp32-diagnostic.local")
+    parser.add_argument("-n", "--count", type=int, default=3, help="calls per route")
+    parser.add_argument("--self-test", action="store_true", help="run report logic checks")
+    args = parser.parse_args()
+
+    if args.self_test:
+        return 0 if self_test() else 1
+    if not args.url:
+        parser.print_help()
+        return 1
+    return run(args.url.rstrip("/"), max(1, args.count))
+
+
+if __name__ == "__main__":
+    sys.exit(main())
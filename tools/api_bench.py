@@ -0,0 +1,275 @@
+#!/usr/bin/env python3
+"""
+ESP32 Diagnostic - JSON vs CBOR API Benchmark
+Version: 3.33.5
+
+Fetches API endpoints in both encodings (Accept: application/json, then
+Accept: application/cbor), checks that both decode to the same document and
+reports body size, device-side generation/encode time and client round trip.
+
+Usage:
+    python tools/api_bench.py --url http://esp32-diagnostic.local                 # /api/overview + /export/json
+    python tools/api_bench.py --url http://192.168.1.20 -n 50 --uri /api/status
+    python tools/api_bench.py --self-test                                          # CBOR decoder checks
+
+Device timing headers (ENABLE_CBOR_API):
+    X-Gen-Us     handler start -> send() (collection + JSON text building)
+    X-Encode-Us  JSON -> CBOR transcoding, CBOR responses only
+
+CBOR produced by the firmware (src/cbor_encoder.cpp): indefinite-length maps
+and arrays, integers as major types 0/1, decimals as half/single/double floats.
+Singles are printed back with the shortest precision that round-trips, which
+matches the JSON text for values printed with <= 6 significant digits.
+"""
+
+import argparse
+import json
+import statistics
+import struct
+import sys
+import time
+import urllib.request
+
+DEFAULT_URIS = ["/api/overview", "/export/json"]
+BREAK = object()
+
+
+class Float32(float):
+    """Decoded single-precision value (shortest decimal that round-trips)"""
+
+
+def shortest_single(value):
+    for digits in range(1, 10):
+        candidate = float(f"{value:.{digits}g}")
+        if struct.unpack(">f", struct.pack(">f", candidate))[0] == value:
+            return candidate
+    return value
+
+
+def decode_cbor(data):
+    """Decode one CBOR item (the subset used by the firmware plus definite lengths)"""
+    position = 0
+
+    def take(count):
+        nonlocal position
+        if position + count > len(data):
+            raise ValueError("truncated CBOR")
+        chunk = data[position:position + count]
+        position += count
+        return chunk
+
+    def argument(info):
+        if info < 24:
+            return info
+        if info == 31:
+            return None
+        sizes = {24: 1, 25: 2, 26: 4, 27: 8}
+        if info not in sizes:
+            raise ValueError(f"reserved additional info {info}")
+        return int.from_bytes(take(sizes[info]), "big")
+
+    def item():
+        initial = take(1)[0]
+        major, info = initial >> 5, initial & 0x1F
+        if initial == 0xFF:
+            return BREAK
+        if major == 7:
+            if info == 20:
+                return False
+            if info == 21:
+                return True
+            if info in (22, 23):
+                return None
+            if info == 25:
+                return struct.unpack(">e", take(2))[0]
+            if info == 26:
+                return Float32(shortest_single(struct.unpack(">f", take(4))[0]))
+            if info == 27:
+                return struct.unpack(">d", take(8))[0]
+            raise ValueError(f"unsupported simple value {info}")
+        value = argument(info)
+        if major == 0:
+            return value
+        if major == 1:
+            return -1 - value
+        if major in (2, 3):
+            raw = take(value) if value is not None else b"".join(iter_items())
+            return raw.decode("utf-8") if major == 3 else raw
+        if major == 4:
+            return list(iter_items()) if value is None else [item() for _ in range(value)]
+        if major == 5:
+            if value is None:
+                flat = list(iter_items())
+                return dict(zip(flat[0::2], flat[1::2]))
+            return {item(): item() for _ in range(value)}
+        raise ValueError(f"unsupported major type {major}")
+
+    def iter_items():
+        while True:
+            value = item()
+            if value is BREAK:
+                return
+            yield value
+
+    result = item()
+    if result is BREAK or position != len(data):
+        raise ValueError("trailing bytes or stray break")
+    return result
+
+
+def same_shape(a, b, path=""):
+    """Structural comparison: keys, value types; values differ between two requests"""
+    if isinstance(a, dict) and isinstance(b, dict):
+        if set(a) != set(b):
+            return f"{path}: keys {sorted(set(a) ^ set(b))}"
+        for key in a:
+            problem = same_shape(a[key], b[key], f"{path}.{key}")
+            if problem:
+                return problem
+        return None
+    if isinstance(a, list) and isinstance(b, list):
+        return None
+    numbers = (int, float)
+    if isinstance(a, bool) != isinstance(b, bool):
+        return f"{path}: bool/non-bool"
+    if isinstance(a, numbers) and isinstance(b, numbers) or a is None or b is None:
+        return None
+    if type(a) is not type(b):
+        return f"{path}: {type(a).__name__} vs {type(b).__name__}"
+    return None
+
+
+def fetch(url, accept):
+    request = urllib.request.Request(url, headers={"Accept": accept})
+    start = time.perf_counter()
+    with urllib.request.urlopen(request, timeout=30) as response:
+        body = response.read()
+        headers = response.headers
+    elapsed_ms = (time.perf_counter() - start) * 1000.0
+    return body, headers, elapsed_ms
+
+
+def header_us(headers, name):
+    value = headers.get(name)
+    return int(value) if value and value.isdigit() else None
+
+
+def median(values):
+    values = [v for v in values if v is not None]
+    return statistics.median(values) if values else None
+
+
+def run(base, uris, count):
+    print(f"{'URI':<18} {'enc':<5} {'bytes':>7} {'gen us':>8} {'enc us':>8} {'client ms':>10}")
+    for uri in uris:
+        results = {}
+        for label, accept in (("json", "application/json"), ("cbor", "application/cbor")):
+            sizes, gen, enc, client = [], [], [], []
+            document = None
+            for _ in range(count):
+                body, headers, elapsed = fetch(base + uri, accept)
+                content_type = headers.get("Content-Type", "")
+                if label == "cbor" and "cbor" not in content_type:
+                    print(f"{uri}: CBOR not negotiated (Content-Type {content_type})")
+                    break
+                document = decode_cbor(body) if label == "cbor" else json.loads(body)
+                sizes.append(len(body))
+                gen.append(header_us(headers, "X-Gen-Us"))
+                enc.append(header_us(headers, "X-Encode-Us"))
+                client.append(elapsed)
+            if not sizes:
+                continue
+            results[label] = (document, median(sizes))
+            fmt = lambda v, spec: "-" if v is None else format(v, spec)
+            print(f"{uri:<18} {label:<5} {fmt(median(sizes), '7.0f')} {fmt(median(gen), '8.0f')} "
+                  f"{fmt(median(enc), '8.0f')} {fmt(median(client), '10.1f')}")
+        if "json" in results and "cbor" in results:
+            problem = same_shape(results["json"][0], results["cbor"][0])
+            saved = 100.0 * (1 - results["cbor"][1] / results["json"][1])
+            print(f"{'':<18} cbor {saved:.1f}% smaller, documents {'match' if not problem else 'DIFFER ' + problem}")
+
+
+# jsonToCbor() output for FIRMWARE_JSON (regenerate when the encoder changes)
+FIRMWARE_JSON = (
+    '{"chip":{"model":"ESP32-S3","cores":2,"freq":240,"uptime":86400123,"temperature":41.5},'
+    '"memory":{"free":312456,"frag":-3,"psram":8386295,"ratio":0.0},'
+    '"env":{"t":21.37,"h":45.2,"p":1013.25,"alt":-12.5,"avg":null},'
+    '"gps":{"fix":true,"lat":48.858370,"lon":2.294481,"hdop":0.95,"sats":[3,7,12]},'
+    '"wifi":{"ssid":"Café \\"lab\\"\\n","rssi":-61,"tags":[],"extra":{}},'
+    '"big":18446744073709551615,"tiny":1.5e-9}'
+)
+FIRMWARE_CBOR = (
+    "bf6463686970bf656d6f64656c6845535033322d533365636f72657302646672657118f066757074696d651a05265c7b"
+    "6b74656d7065726174757265f95130ff666d656d6f7279bf64667265651a0004c48864667261672265707372616d1a00"
+    "7ff6f765726174696ff90000ff63656e76bf6174fa41aaf5c36168fa4234cccd6170fa447d500063616c74f9ca406361"
+    "7667f6ff63677073bf63666978f5636c6174fb40486ddf1172ef0b636c6f6efb40025b18dac258d66468646f70fa3f73"
+    "333364736174739f03070cffff6477696669bf64737369646c436166c3a920226c6162220a6472737369383c64746167"
+    "739fff656578747261bfffff636269671bffffffffffffffff6474696e79fa30ce288fff"
+)
+
+
+def self_test():
+    """RFC 8949 appendix A vectors and the firmware encoder's own output"""
+    vectors = [
+        ("00", 0), ("17", 23), ("1818", 24), ("1903e8", 1000), ("1a000f4240", 1000000),
+        ("1b000000e8d4a51000", 1000000000000), ("20", -1), ("3863", -100), ("3903e7", -1000),
+        ("f90000", 0.0), ("f93c00", 1.0), ("f93e00", 1.5), ("f97bff", 65504.0),
+        ("fb3ff199999999999a", 1.1), ("f4", False), ("f5", True), ("f6", None),
+        ("6161", "a"), ("62c3bc", "ü"), ("64f0908591", "\U00010151"),
+        ("83010203", [1, 2, 3]), ("9f018202039f0405ffff", [1, [2, 3], [4, 5]]),
+        ("a26161016162820203", {"a": 1, "b": [2, 3]}),
+        ("bf6346756ef563416d7421ff", {"Fun": True, "Amt": -2}),
+    ]
+    failures = 0
+    for hex_value, expected in vectors:
+        decoded = decode_cbor(bytes.fromhex(hex_value))
+        ok = decoded == expected and type(decoded) is type(expected) or (
+            isinstance(expected, float) and decoded == expected)
+        if not ok:
+            print(f"  {hex_value}: FAIL ({decoded!r} != {expected!r})")
+            failures += 1
+
+    document = decode_cbor(bytes.fromhex(FIRMWARE_CBOR))
+    expected = json.loads(FIRMWARE_JSON)
+    checks = [
+        ("vectors", failures == 0),
+        ("firmware document", document == expected),
+        ("float widths", isinstance(document["env"]["t"], Float32) and document["gps"]["lat"] == 48.858370),
+        ("size", len(bytes.fromhex(FIRMWARE_CBOR)) < len(FIRMWARE_JSON)),
+    ]
+    try:
+        decode_cbor(bytes.fromhex("9f01"))
+        checks.append(("truncated rejected", False))
+    except ValueError:
+        checks.append(("truncated rejected", True))
+
+    failures = 0
+    for label, ok in checks:
+        print(f"  {label}: {'OK' if ok else 'FAIL'}")
+        failures += 0 if ok else 1
+
+    print("\n✅ Self-test passed" if failures == 0 else f"\n❌ {failures} self-test failure(s)")
+    return failures == 0
+
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare JSON and CBOR responses of the ESP32 Diagnostic API")
+    parser.add_argument("--url", help="device base URL, e.g. http://esp32-diagnostic.local")
+    parser.add_argument("--uri", action="append", help="endpoint to measure (repeatable)")
+    parser.add_argument("-n", "--count", type=int, default=20, help="requests per endpoint and encoding")
+    parser.add_argument("--self-test", action="store_true", help="run CBOR decoder checks")
+    args = parser.parse_args()
+
+    if args.self_test:
+        return 0 if self_test() else 1
+    if not args.url:
+        parser.print_help()
+        return 1
+
+    run(args.url.rstrip("/"), args.uri or DEFAULT_URIS, max(1, args.count))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
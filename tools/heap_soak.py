@@ -0,0 +1,197 @@
+#!/usr/bin/env python3
+"""
+ESP32 Diagnostic - Heap Fragmentation Soak
+Version: 3.33.5
+
+Polls the API the way the web UI does for hours and samples /api/memory at a
+fixed interval, writing free heap, largest free block and the
+"fragmentation" figure collectDetailedMemory() computes
+(100 - 100 * largest block / free heap) to a CSV. Two runs (firmware before
+and after a change, e.g. REQUEST_ARENA_SIZE 0 vs the default) are compared
+with --compare.
+
+Usage:
+    python tools/heap_soak.py --url http://esp32-diagnostic.local --hours 24 --out after.csv
+    python tools/heap_soak.py --url http://192.168.1.20 --hours 1 --rate 10 --uri /api/gps
+    python tools/heap_soak.py --compare before.csv after.csv
+    python tools/heap_soak.py --self-test
+
+The request arena counters (/api/metrics/http "arena") are printed at the end
+of a run: spills > 0 means some responses did not fit REQUEST_ARENA_SIZE.
+"""
+
+import argparse
+import csv
+import json
+import statistics
+import sys
+import time
+import urllib.request
+
+# Ce que l'interface web interroge en boucle
+DEFAULT_URIS = ["/api/dashboard", "/api/overview", "/api/gps", "/api/environmental-sensors"]
+FIELDS = ["elapsed_s", "requests", "errors", "heap_free", "largest_block", "fragmentation"]
+
+
+def get_json(url, timeout=10):
+    with urllib.request.urlopen(url, timeout=timeout) as response:
+        return json.loads(response.read())
+
+
+def sample_memory(base):
+    memory = get_json(base + "/api/memory")
+    free = memory["heap"]["free"]
+    fragmentation = float(memory["fragmentation"])
+    largest = int(round(free * (100.0 - fragmentation) / 100.0))
+    return free, largest, fragmentation
+
+
+def soak(base, uris, hours, rate, interval, out_path):
+    deadline = time.monotonic() + hours * 3600.0
+    start = time.monotonic()
+    next_sample = start
+    requests = errors = index = 0
+    with open(out_path, "w", newline="") as handle:
+        writer = csv.writer(handle)
+        writer.writerow(FIELDS)
+        while time.monotonic() < deadline:
+            now = time.monotonic()
+            if now >= next_sample:
+                try:
+                    free, largest, fragmentation = sample_memory(base)
+                    writer.writerow([int(now - start), requests, errors, free, largest, f"{fragmentation:.1f}"])
+                    handle.flush()
+                    print(f"{(now - start) / 3600.0:6.2f} h  free {free:>7}  largest {largest:>7}  "
+                          f"frag {fragmentation:5.1f} %  requests {requests}  errors {errors}")
+                except (OSError, ValueError, KeyError) as exc:
+                    print(f"sample failed: {exc}")
+                next_sample += interval
+            try:
+                with urllib.request.urlopen(base + uris[index % len(uris)], timeout=10) as response:
+                    response.read()
+            except OSError:
+                errors += 1
+            requests += 1
+            index += 1
+            time.sleep(max(0.0, 1.0 / rate - (time.monotonic() - now)))
+    try:
+        arena = get_json(base + "/api/metrics/http").get("arena")
+        if arena:
+            print(f"arena: {arena}")
+    except (OSError, ValueError):
+        pass
+
+
+def load(path):
+    with open(path, newline="") as handle:
+        return [{key: float(value) for key, value in row.items()} for row in csv.DictReader(handle)]
+
+
+def slope_per_hour(xs, ys):
+    if len(xs) < 2:
+        return 0.0
+    mean_x, mean_y = statistics.fmean(xs), statistics.fmean(ys)
+    var = sum((x - mean_x) ** 2 for x in xs)
+    if var == 0:
+        return 0.0
+    return 3600.0 * sum((x - mean_x) * (y - mean_y) for x, y in zip(xs, ys)) / var
+
+
+def summarize(rows):
+    fragmentation = [row["fragmentation"] for row in rows]
+    ordered = sorted(fragmentation)
+    return {
+        "samples": len(rows),
+        "hours": rows[-1]["elapsed_s"] / 3600.0 if rows else 0.0,
+        "requests": int(rows[-1]["requests"]) if rows else 0,
+        "frag_median": statistics.median(fragmentation) if rows else 0.0,
+        "frag_p95": ordered[min(len(ordered) - 1, int(0.95 * len(ordered)))] if rows else 0.0,
+        "frag_max": ordered[-1] if rows else 0.0,
+        "frag_last": fragmentation[-1] if rows else 0.0,
+        "frag_per_hour": slope_per_hour([row["elapsed_s"] for row in rows], fragmentation),
+        "free_min": int(min(row["heap_free"] for row in rows)) if rows else 0,
+        "largest_min": int(min(row["largest_block"] for row in rows)) if rows else 0,
+    }
+
+
+def compare(paths):
+    summaries = [summarize(load(path)) for path in paths]
+    print(f"{'':<16}" + "".join(f"{path[-20:]:>22}" for path in paths))
+    for key in summaries[0]:
+        values = [summary[key] for summary in summaries]
+        print(f"{key:<16}" + "".join(f"{value:>22.2f}" if isinstance(value, float) else f"{value:>22}"
+                                     for value in values))
+
+
+def self_test():
+    """Summary maths on synthetic runs, CSV round trip"""
+    import os
+    import tempfile
+
+    def run(drift):
+        rows = []
+        for i in range(25):
+            free = 200000 - i * 10
+            fragmentation = 5.0 + drift * i
+            rows.append({"elapsed_s": i * 3600.0, "requests": i * 18000.0, "errors": 0.0, "heap_free": free,
+                         "largest_block": round(free * (100 - fragmentation) / 100), "fragmentation": fragmentation})
+        return rows
+
+    before, after = summarize(run(0.5)), summarize(run(0.0))
+    checks = [
+        ("duration", before["hours"] == 24.0 and before["samples"] == 25),
+        ("drift measured", abs(before["frag_per_hour"] - 0.5) < 1e-9 and before["frag_max"] == 17.0),
+        ("flat run", after["frag_per_hour"] == 0.0 and after["frag_median"] == 5.0),
+        ("p95", before["frag_p95"] == 16.5),
+        ("free minimum", after["free_min"] == 199760),
+    ]
+
+    handle, path = tempfile.mkstemp(suffix=".csv")
+    os.close(handle)
+    try:
+        with open(path, "w", newline="") as out:
+            writer = csv.writer(out)
+            writer.writerow(FIELDS)
+            for row in run(0.5):
+                writer.writerow([row[field] for field in FIELDS])
+        checks.append(("csv round trip", summarize(load(path)) == before))
+    finally:
+        os.remove(path)
+
+    failures = 0
+    for label, ok in checks:
+        print(f"  {label}: {'OK' if ok else 'FAIL'}")
+        failures += 0 if ok else 1
+
+    print("\n✅ Self-test passed" if failures == 0 else f"\n❌ {failures} self-test failure(s)")
+    return failures == 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Long-running heap fragmentation soak for ESP32 Diagnostic")
+    parser.add_argument("--url", help="device base URL, e.g. http://esp32-diagnostic.local")
+    parser.add_argument("--uri", action="append", help="endpoint polled in rotation (repeatable)")
+    parser.add_argument("--hours", type=float, default=24.0, help="soak duration")
+    parser.add_argument("--rate", type=float, default=5.0, help="requests per second")
+    parser.add_argument("--interval", type=float, default=60.0, help="seconds between /api/memory samples")
+    parser.add_argument("--out", default="heap_soak.csv", help="CSV written during the run")
+    parser.add_argument("--compare", nargs="+", metavar="CSV", help="summarize and compare finished runs")
+    parser.add_argument("--self-test", action="store_true", help="run summary checks")
+    args = parser.parse_args()
+
+    if args.self_test:
+        return 0 if self_test() else 1
+    if args.compare:
+        compare(args.compare)
+        return 0
+    if not args.url:
+        parser.print_help()
+        return 1
+
+    soak(args.url.rstrip("/"), args.uri or DEFAULT_URIS, args.hours, max(0.1, args.rate),
+         max(1.0, args.interval), args.out)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,241 @@
+#!/usr/bin/env python3
+"""
+ESP32 Diagnostic - Logic Analyzer Capture Decoder
+Version: 3.33.5
+
+Decodes the run-length-encoded capture (.larl) downloaded from
+/api/la/capture and converts it to VCD for PulseView / GTKWave.
+
+Usage:
+    python tools/la_decode.py capture.larl              # summary
+    python tools/la_decode.py capture.larl -o out.vcd   # convert to VCD
+    python tools/la_decode.py --self-test               # round trip + device encoder fixture
+
+File format (little endian):
+    Header, 32 bytes:
+        "LARL" | version u8 | channels u8 | pins i8[8] | reserved u16 |
+        sample_rate u32 | actual_rate u32 | length u32 | trigger_index u32
+    Body: runs of (value u8, run length LEB128 varint)
+"""
+
+import argparse
+import random
+import struct
+import sys
+from pathlib import Path
+
+MAGIC = b"LARL"
+VERSION = 1
+HEADER = struct.Struct("<4sBB8bHIIII")
+
+# Written by writeLogicAnalyzerRLEHeader() + encodeLogicAnalyzerRLE() (src/logic_analyzer.cpp)
+# on the native build, body in 8-byte chunks like /api/la/capture: 3 channels on GPIO 21/20/12,
+# 100 x 0x07, then values 0..5 for 50 samples each, then 20000 x 0x05 (3-byte varint run)
+CPP_FIXTURE = bytes.fromhex(
+    "4c41524c010315140cffffffffff000040420f00603d0f00b04f000064000000"
+    "07640032013202320332043205d29c01")
+
+
+class Capture:
+    """Decoded logic analyzer capture"""
+
+    def __init__(self, channels, pins, sample_rate, actual_rate, trigger_index, samples):
+        self.channels = channels
+        self.pins = pins
+        self.sample_rate = sample_rate
+        self.actual_rate = actual_rate
+        self.trigger_index = trigger_index
+        self.samples = samples
+
+
+def encode(capture):
+    """Mirror of encodeLogicAnalyzerRLE() in src/logic_analyzer.cpp"""
+    pins = list(capture.pins) + [-1] * (8 - len(capture.pins))
+    out = bytearray(HEADER.pack(MAGIC, VERSION, capture.channels, *pins, 0,
+                                capture.sample_rate, capture.actual_rate,
+                                len(capture.samples), capture.trigger_index))
+    samples = capture.samples
+    i = 0
+    while i < len(samples):
+        value = samples[i]
+        run = 1
+        while i + run < len(samples) and samples[i + run] == value:
+            run += 1
+        i += run
+        out.append(value)
+        while run >= 0x80:
+            out.append((run & 0x7F) | 0x80)
+            run >>= 7
+        out.append(run)
+    return bytes(out)
+
+
+def decode(data):
+    """Parse a .larl buffer into a Capture"""
+    if len(data) < HEADER.size:
+        raise ValueError("file too short for header")
+    fields = HEADER.unpack_from(data, 0)
+    magic, version, channels = fields[0], fields[1], fields[2]
+    pins = list(fields[3:11])[:channels]
+    sample_rate, actual_rate, length, trigger_index = fields[12:16]
+    if magic != MAGIC:
+        raise ValueError(f"bad magic {magic!r}")
+    if version != VERSION:
+        raise ValueError(f"unsupported version {version}")
+
+    samples = bytearray()
+    pos = HEADER.size
+    while pos < len(data):
+        value = data[pos]
+        pos += 1
+        run = 0
+        shift = 0
+        while True:
+            if pos >= len(data):
+                raise ValueError("truncated run length")
+            byte = data[pos]
+            pos += 1
+            run |= (byte & 0x7F) << shift
+            shift += 7
+            if not byte & 0x80:
+                break
+        samples.extend(bytes([value]) * run)
+
+    if len(samples) != length:
+        raise ValueError(f"decoded {len(samples)} samples, header says {length}")
+    return Capture(channels, pins, sample_rate, actual_rate, trigger_index, bytes(samples))
+
+
+def to_vcd(capture):
+    """Same value-change layout as encodeLogicAnalyzerVCD() on the device"""
+    lines = [
+        f"$comment ESP32 Diagnostic logic analyzer, {capture.sample_rate} Hz, "
+        f"trigger @ sample {capture.trigger_index} $end",
+        "$timescale 1ns $end",
+        "$scope module esp32 $end",
+    ]
+    for ch, pin in enumerate(capture.pins):
+        lines.append(f"$var wire 1 {chr(33 + ch)} gpio{pin} $end")
+    lines += ["$upscope $end", "$enddefinitions $end"]
+
+    def time_ns(index):
+        return index * 1_000_000_000 // capture.sample_rate
+
+    previous = None
+    for index, value in enumerate(capture.samples):
+        if previous is None:
+            lines += ["#0", "$dumpvars"]
+            lines += [f"{(value >> ch) & 1}{chr(33 + ch)}" for ch in range(capture.channels)]
+            lines.append("$end")
+        elif value != previous:
+            changed = value ^ previous
+            lines.append(f"#{time_ns(index)}")
+            lines += [f"{(value >> ch) & 1}{chr(33 + ch)}"
+                      for ch in range(capture.channels) if changed & (1 << ch)]
+        previous = value
+    lines.append(f"#{time_ns(len(capture.samples))}")
+    return "\n".join(lines) + "\n"
+
+
+def summary(capture):
+    """Edge count and duty cycle per channel"""
+    n = len(capture.samples)
+    print(f"Channels: {capture.channels}  pins: {capture.pins}")
+    print(f"Samples: {n} @ {capture.sample_rate} Hz (measured {capture.actual_rate} Hz)")
+    print(f"Duration: {n / capture.sample_rate * 1000:.3f} ms, trigger @ sample {capture.trigger_index}")
+    for ch, pin in enumerate(capture.pins):
+        bits = [(s >> ch) & 1 for s in capture.samples]
+        edges = sum(1 for a, b in zip(bits, bits[1:]) if a != b)
+        high = sum(bits) * 100.0 / n if n else 0.0
+        print(f"  ch{ch} (GPIO {pin:2d}): {edges:7d} edges, {high:5.1f}% high")
+
+
+def self_test():
+    """Round-trip synthetic captures through encode/decode/VCD"""
+    rng = random.Random(0xE532)
+    cases = []
+
+    # I2C-like pattern: slow SCL on ch1, data on ch0
+    i2c = bytearray()
+    for bit in range(400):
+        sda = rng.randint(0, 1)
+        i2c.extend(bytes([sda | 0x02]) * 5)
+        i2c.extend(bytes([sda]) * 5)
+    cases.append(Capture(2, [15, 16], 1_000_000, 998_500, 40, bytes(i2c)))
+
+    # Long runs (varint > 1 byte) and all 8 channels
+    long_runs = bytes([0x00]) * 70000 + bytes([0xFF]) * 200 + bytes([0xA5]) * 129
+    cases.append(Capture(8, [1, 2, 3, 4, 5, 6, 7, 8], 2_000_000, 2_000_000, 0, long_runs))
+
+    # Random noise: worst case for RLE
+    noise = bytes(rng.randint(0, 15) for _ in range(5000))
+    cases.append(Capture(4, [10, 11, 12, 13], 500_000, 499_000, 2500, noise))
+
+    failures = 0
+    for index, capture in enumerate(cases):
+        blob = encode(capture)
+        decoded = decode(blob)
+        ok = (decoded.samples == capture.samples
+              and decoded.pins == capture.pins
+              and decoded.trigger_index == capture.trigger_index
+              and decoded.sample_rate == capture.sample_rate)
+        vcd = to_vcd(decoded)
+        ok = ok and vcd.startswith("$comment") and vcd.rstrip().endswith(
+            f"#{len(capture.samples) * 1_000_000_000 // capture.sample_rate}")
+        ratio = len(blob) / (len(capture.samples) + HEADER.size)
+        print(f"  case {index}: {len(capture.samples)} samples -> {len(blob)} bytes "
+              f"({ratio * 100:.1f}%) {'OK' if ok else 'FAIL'}")
+        failures += 0 if ok else 1
+
+    # Device encoder output: same bytes as the Python mirror, same samples once decoded
+    expected = Capture(3, [21, 20, 12], 1_000_000, 998_752, 100,
+                       bytes([0x07]) * 100 + b"".join(bytes([v]) * 50 for v in range(6))
+                       + bytes([0x05]) * 20000)
+    try:
+        decoded = decode(CPP_FIXTURE)
+        ok = (decoded.samples == expected.samples and decoded.pins == expected.pins
+              and decoded.actual_rate == expected.actual_rate
+              and decoded.trigger_index == expected.trigger_index
+              and encode(expected) == CPP_FIXTURE)
+    except ValueError:
+        ok = False
+    print(f"  C++ encoder fixture: {'OK' if ok else 'FAIL'}")
+    failures += 0 if ok else 1
+
+    # Corrupted inputs must be rejected
+    for label, blob in (("bad magic", b"XXXX" + encode(cases[0])[4:]),
+                        ("truncated", encode(cases[1])[:-1])):
+        try:
+            decode(blob)
+            print(f"  {label}: accepted FAIL")
+            failures += 1
+        except ValueError:
+            print(f"  {label}: rejected OK")
+
+    print("\n✅ Self-test passed" if failures == 0 else f"\n❌ {failures} self-test failure(s)")
+    return failures == 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode ESP32 Diagnostic logic analyzer captures")
+    parser.add_argument("capture", nargs="?", type=Path, help=".larl file from /api/la/capture")
+    parser.add_argument("-o", "--output", type=Path, help="write VCD to this file")
+    parser.add_argument("--self-test", action="store_true", help="run encoder/decoder round trip")
+    args = parser.parse_args()
+
+    if args.self_test:
+        return 0 if self_test() else 1
+    if not args.capture:
+        parser.print_help()
+        return 1
+
+    capture = decode(args.capture.read_bytes())
+    summary(capture)
+    if args.output:
+        args.output.write_text(to_vcd(capture))
+        print(f"VCD written to {args.output}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,245 @@
+#!/usr/bin/env python3
+"""
+ESP32 Diagnostic - MQTT Telemetry Decoder
+Version: 3.33.5
+
+Decodes the batched telemetry published by the MQTT bridge (/api/mqtt),
+checks delivery (sequence gaps, duplicates, backlog drops) and writes CSV.
+
+Usage (local broker, e.g. mosquitto -v):
+    mosquitto_sub -h localhost -v -t 'esp32-diagnostic/#' | python tools/mqtt_telemetry.py -
+    mosquitto_sub -h localhost -v -t 'esp32-diagnostic/#' > capture.txt
+    python tools/mqtt_telemetry.py capture.txt -o telemetry.csv
+    python tools/mqtt_telemetry.py --self-test
+
+Input lines: "<topic> <payload>" (mosquitto_sub -v) or a bare JSON payload.
+
+Telemetry payload (MQTT_TOPIC_PREFIX/<mac>/telemetry, version 1):
+    {"v":1, "id":mac, "seq":n, "up":millis, "dropped":total, "cols":"t,tc,...", "rows":[[...], ...]}
+    Rows are SDLogRecord fields as integers (same scaling as tools/sd_log_convert.py):
+        t ms | tc c°C | hc c%RH | pa Pa | lat/lon 1e-7 deg | alt dm | sat | fl flags | heap | rssi dBm |
+        used satellites in fix | snr/snrmax dB-Hz (columns absent from older firmware)
+Status payload (.../status, retained): {"state":"online"|"offline", "fw", "ip"}
+
+QoS 1 re-sends after an ack timeout start again from the oldest unacknowledged
+record, so rows are de-duplicated on their timestamp.
+"""
+
+import argparse
+import csv
+import json
+import sys
+from pathlib import Path
+
+FLAG_AHT20 = 0x01
+FLAG_BMP280 = 0x02
+FLAG_GPS_FIX = 0x04
+FLAG_WIFI = 0x08
+
+CSV_FIELDS = ["device", "timestamp_ms", "temperature_c", "humidity_pct", "pressure_hpa",
+              "latitude", "longitude", "altitude_m", "satellites", "gps_fix",
+              "satellites_used", "snr_mean_dbhz", "snr_max_dbhz",
+              "free_heap", "rssi_dbm", "flags"]
+
+
+def decode_row(device, columns, values):
+    """Scale one telemetry row to engineering units"""
+    raw = dict(zip(columns, values))
+    flags = raw.get("fl", 0)
+    fix = bool(flags & FLAG_GPS_FIX)
+    return {
+        "device": device,
+        "timestamp_ms": raw["t"],
+        "temperature_c": "" if raw["tc"] == -32768 else raw["tc"] / 100.0,
+        "humidity_pct": "" if raw["hc"] == 0xFFFF else raw["hc"] / 100.0,
+        "pressure_hpa": "" if raw["pa"] == 0 else raw["pa"] / 100.0,
+        "latitude": raw["lat"] / 1e7 if fix else "",
+        "longitude": raw["lon"] / 1e7 if fix else "",
+        "altitude_m": raw["alt"] / 10.0 if fix else "",
+        "satellites": raw["sat"],
+        "gps_fix": int(fix),
+        "satellites_used": raw.get("used", ""),
+        "snr_mean_dbhz": raw.get("snr") or "",
+        "snr_max_dbhz": raw.get("snrmax") or "",
+        "free_heap": raw["heap"],
+        "rssi_dbm": raw["rssi"] if flags & FLAG_WIFI else "",
+        "flags": flags,
+    }
+
+
+class Session:
+    """Per-device delivery bookkeeping"""
+
+    def __init__(self):
+        self.rows = {}
+        self.seqs = []
+        self.duplicates = 0
+        self.dropped = 0
+        self.lag_ms = []
+        self.states = []
+        self.payload_bytes = 0
+
+    def add_batch(self, device, batch, size):
+        if batch.get("v") != 1:
+            raise ValueError(f"unsupported payload version {batch.get('v')}")
+        columns = batch["cols"].split(",")
+        self.seqs.append(batch["seq"])
+        self.dropped = max(self.dropped, batch.get("dropped", 0))
+        self.payload_bytes += size
+        for values in batch["rows"]:
+            if len(values) != len(columns):
+                raise ValueError(f"row of {len(values)} values for {len(columns)} columns")
+            row = decode_row(device, columns, values)
+            if row["timestamp_ms"] in self.rows:
+                self.duplicates += 1
+                continue
+            self.rows[row["timestamp_ms"]] = row
+        if batch["rows"]:
+            # Âge du plus récent enregistrement au moment de l'envoi
+            self.lag_ms.append(batch["up"] - batch["rows"][-1][0])
+
+    def sequence_gaps(self):
+        ordered = sorted(set(self.seqs))
+        return sum(b - a - 1 for a, b in zip(ordered, ordered[1:]) if b > a + 1)
+
+    def ordered_rows(self):
+        return [self.rows[t] for t in sorted(self.rows)]
+
+
+def parse_line(line):
+    """Return (topic or None, payload dict) for one mosquitto_sub line"""
+    line = line.strip()
+    if not line:
+        return None, None
+    if line.startswith("{"):
+        return None, json.loads(line)
+    topic, _, payload = line.partition(" ")
+    return topic, json.loads(payload) if payload.startswith("{") else None
+
+
+def process(lines):
+    sessions = {}
+    for line in lines:
+        topic, payload = parse_line(line)
+        if payload is None:
+            continue
+        if topic and topic.endswith("/status"):
+            device = topic.split("/")[-2]
+            sessions.setdefault(device, Session()).states.append(payload.get("state"))
+        elif "rows" in payload:
+            device = payload.get("id") or (topic.split("/")[-2] if topic else "?")
+            sessions.setdefault(device, Session()).add_batch(device, payload, len(line))
+    return sessions
+
+
+def summary(device, session):
+    rows = session.ordered_rows()
+    print(f"{device}: {len(session.seqs)} batch(es), {len(rows)} record(s), "
+          f"{session.payload_bytes} payload bytes, states {session.states or '-'}")
+    print(f"  seq gaps {session.sequence_gaps()}, duplicate rows {session.duplicates}, "
+          f"dropped on device {session.dropped}")
+    if len(rows) > 1:
+        gaps = [b["timestamp_ms"] - a["timestamp_ms"] for a, b in zip(rows, rows[1:])]
+        print(f"  span {(rows[-1]['timestamp_ms'] - rows[0]['timestamp_ms']) / 1000.0:.1f} s, "
+              f"record period min/max {min(gaps)}/{max(gaps)} ms")
+    if session.lag_ms:
+        print(f"  newest record age at send: avg {sum(session.lag_ms) / len(session.lag_ms):.0f} ms, "
+              f"max {max(session.lag_ms)} ms")
+
+
+def synthetic_lines():
+    """Two devices; a retransmitted batch, a lost batch and a backlog drain"""
+    columns = "t,tc,hc,pa,lat,lon,alt,sat,fl,heap,rssi,used,snr,snrmax"
+
+    def row(t, fix=True):
+        flags = FLAG_AHT20 | FLAG_BMP280 | FLAG_WIFI | (FLAG_GPS_FIX if fix else 0)
+        return [t, 2150, 4520, 101325, 488583701 if fix else 0, 22944813 if fix else 0, 352, 9, flags, 180000, -61,
+                8 if fix else 0, 38, 45]
+
+    def batch(device, seq, times, up, dropped=0, cols=columns):
+        width = len(cols.split(","))
+        payload = {"v": 1, "id": device, "seq": seq, "up": up, "dropped": dropped, "cols": cols,
+                   "rows": [row(t, t >= 3000)[:width] for t in times]}
+        return f"esp32-diagnostic/{device}/telemetry {json.dumps(payload, separators=(',', ':'))}"
+
+    a, b = "246f28010203", "246f28aabbcc"
+    return [
+        f"esp32-diagnostic/{a}/status " + json.dumps({"state": "online", "fw": "3.33.5", "ip": "192.168.1.20"}),
+        batch(a, 1, range(1000, 6000, 1000), 6010),
+        batch(a, 2, range(6000, 11000, 1000), 11005),
+        batch(a, 3, range(6000, 12000, 1000), 26000),       # re-send after ack timeout
+        batch(a, 5, range(40000, 60000, 1000), 60020, 3),   # seq 4 lost, drained backlog
+        "",
+        "esp32-diagnostic/other/topic not-json",
+        batch(b, 1, [1000], 1002, cols="t,tc,hc,pa,lat,lon,alt,sat,fl,heap,rssi"),  # older firmware
+        f"esp32-diagnostic/{a}/status " + json.dumps({"state": "offline"}),
+    ]
+
+
+def self_test():
+    """Decode synthetic mosquitto_sub output and check the delivery counters"""
+    sessions = process(synthetic_lines())
+    a = sessions["246f28010203"]
+    rows = a.ordered_rows()
+    checks = [
+        ("devices", sorted(sessions) == ["246f28010203", "246f28aabbcc"]),
+        ("dedup", a.duplicates == 5 and len(rows) == 11 + 20),
+        ("seq gap", a.sequence_gaps() == 1),
+        ("dropped", a.dropped == 3),
+        ("states", a.states == ["online", "offline"]),
+        ("scaling", rows[5]["latitude"] == 48.8583701 and rows[5]["altitude_m"] == 35.2
+         and rows[5]["pressure_hpa"] == 1013.25 and rows[0]["latitude"] == ""),
+        ("lag", a.lag_ms[0] == 1010 and max(a.lag_ms) == 15000),
+        ("signal", rows[5]["satellites_used"] == 8 and rows[5]["snr_mean_dbhz"] == 38
+         and sessions["246f28aabbcc"].ordered_rows()[0]["snr_mean_dbhz"] == ""),
+    ]
+    try:
+        Session().add_batch("x", {"v": 2, "cols": "", "rows": [], "seq": 0, "up": 0}, 0)
+        checks.append(("version rejected", False))
+    except ValueError:
+        checks.append(("version rejected", True))
+
+    failures = 0
+    for label, ok in checks:
+        print(f"  {label}: {'OK' if ok else 'FAIL'}")
+        failures += 0 if ok else 1
+
+    print("\n✅ Self-test passed" if failures == 0 else f"\n❌ {failures} self-test failure(s)")
+    return failures == 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode ESP32 Diagnostic MQTT telemetry (mosquitto_sub -v output)")
+    parser.add_argument("capture", nargs="?", help="capture file, or - for stdin")
+    parser.add_argument("-o", "--output", type=Path, help="write merged CSV to this file")
+    parser.add_argument("--self-test", action="store_true", help="run synthetic decode checks")
+    args = parser.parse_args()
+
+    if args.self_test:
+        return 0 if self_test() else 1
+    if not args.capture:
+        parser.print_help()
+        return 1
+
+    if args.capture == "-":
+        sessions = process(sys.stdin)
+    else:
+        with open(args.capture, encoding="utf-8") as handle:
+            sessions = process(handle)
+
+    all_rows = []
+    for device, session in sorted(sessions.items()):
+        summary(device, session)
+        all_rows.extend(session.ordered_rows())
+
+    if args.output:
+        with args.output.open("w", newline="") as handle:
+            writer = csv.DictWriter(handle, fieldnames=CSV_FIELDS)
+            writer.writeheader()
+            writer.writerows(all_rows)
+        print(f"CSV written to {args.output} ({len(all_rows)} records)")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,279 @@
+#!/usr/bin/env python3
+"""
+ESP32 Diagnostic - SD Logger Converter
+Version: 3.33.5
+
+Converts the binary log files written by the background SD logger
+(/api/sd-logger, SD_LOG_DIR/LOGnnnnn.BIN) to CSV.
+
+Usage:
+    python tools/sd_log_convert.py LOG00001.BIN                 # summary
+    python tools/sd_log_convert.py LOG0000*.BIN -o session.csv  # merge to CSV
+    python tools/sd_log_convert.py --self-test                  # writer/reader round trip
+
+File format (little endian):
+    Header, 512 bytes (one sector, keeps records sector-aligned):
+        "ESDL" | version u8 | record_size u8 | reserved u16 |
+        interval_ms u32 | file_index u32 | start_millis u32 | mac u8[6] | zero padding
+    Records, 32 bytes each (SDLogRecord in include/sd_logger.h):
+        timestamp_ms u32 | temperature i16 (c°C) | humidity u16 (c%RH) |
+        pressure u32 (Pa) | latitude i32 (1e-7 deg) | longitude i32 (1e-7 deg) |
+        altitude i16 (dm) | satellites u8 | flags u8 | free_heap u32 |
+        rssi i8 | satellites_used u8 | snr_mean u8 (dB-Hz) | snr_max u8 (dB-Hz)
+    The last three bytes were reserved (zero) in older files: read as "no data".
+    Version 2 interleaves time sync records (flags bit 0x80, SDLogTimeSync)
+    while the GPS PPS is locked:
+        timestamp_ms u32 | timestamp_sub_us u16 | reserved u16 | utc_seconds u32 |
+        utc_micros u32 | drift_ppb i32 | reserved u16 | state u8 | flags u8 | jitter_rms_ns u32 | reserved u8[4]
+    Each sample then gets a UTC time from the nearest preceding sync (the
+    first one for samples before it), carried across files, drift corrected.
+"""
+
+import argparse
+import csv
+import io
+import random
+import struct
+import sys
+from datetime import datetime, timedelta, timezone
+from pathlib import Path
+
+MAGIC = b"ESDL"
+VERSION = 2
+HEADER_SIZE = 512
+HEADER = struct.Struct("<4sBBHIII6s")
+RECORD = struct.Struct("<IhHIiihBBIbBBB")
+TIME_SYNC = struct.Struct("<IHHIIiHBBI4s")
+FLAGS_OFFSET = 23
+
+FLAG_AHT20 = 0x01
+FLAG_BMP280 = 0x02
+FLAG_GPS_FIX = 0x04
+FLAG_WIFI = 0x08
+FLAG_TIME_SYNC = 0x80
+
+CSV_FIELDS = ["file_index", "timestamp_ms", "utc", "temperature_c", "humidity_pct", "pressure_hpa",
+              "latitude", "longitude", "altitude_m", "satellites", "gps_fix",
+              "satellites_used", "snr_mean_dbhz", "snr_max_dbhz",
+              "free_heap", "rssi_dbm", "flags"]
+
+
+def parse_header(data):
+    """Return the header fields of a log file as a dict"""
+    if len(data) < HEADER_SIZE:
+        raise ValueError("file too short for header")
+    magic, version, record_size, _, interval_ms, file_index, start_ms, mac = HEADER.unpack_from(data, 0)
+    if magic != MAGIC:
+        raise ValueError(f"bad magic {magic!r}")
+    if version not in (1, VERSION):
+        raise ValueError(f"unsupported version {version}")
+    if record_size != RECORD.size:
+        raise ValueError(f"record size {record_size}, expected {RECORD.size}")
+    return {
+        "version": version,
+        "interval_ms": interval_ms,
+        "file_index": file_index,
+        "start_ms": start_ms,
+        "mac": ":".join(f"{b:02X}" for b in mac),
+    }
+
+
+def decode_time_sync(raw):
+    """millis() -> UTC anchor of one time sync record"""
+    (timestamp, sub_us, _, utc_seconds, utc_micros, drift_ppb, _, state, _, jitter_ns, _) = raw
+    return {
+        "local_us": timestamp * 1000 + sub_us,
+        "utc_us": utc_seconds * 1_000_000 + utc_micros,
+        "drift_ppm": drift_ppb / 1000.0,
+        "jitter_us": jitter_ns / 1000.0,
+        "state": state,
+    }
+
+
+def utc_time(sync, timestamp_ms):
+    """ISO 8601 UTC of a millis() timestamp through a sync anchor"""
+    if sync is None:
+        return ""
+    # Microsecondes locales ramenées en microsecondes GPS par la dérive mesurée
+    utc_us = sync["utc_us"] + (timestamp_ms * 1000 - sync["local_us"]) / (1 + sync["drift_ppm"] * 1e-6)
+    moment = datetime(1970, 1, 1, tzinfo=timezone.utc) + timedelta(microseconds=round(utc_us))
+    return moment.strftime("%Y-%m-%dT%H:%M:%S.%fZ")
+
+
+def decode_record(file_index, raw, sync=None):
+    """Scale one packed record to engineering units"""
+    (timestamp, temp, hum, pressure, lat, lon, alt, sats, flags, heap, rssi, used, snr_mean, snr_max) = raw
+    fix = bool(flags & FLAG_GPS_FIX)
+    return {
+        "file_index": file_index,
+        "timestamp_ms": timestamp,
+        "utc": utc_time(sync, timestamp),
+        "temperature_c": "" if temp == -32768 else temp / 100.0,
+        "humidity_pct": "" if hum == 0xFFFF else hum / 100.0,
+        "pressure_hpa": "" if pressure == 0 else pressure / 100.0,
+        "latitude": lat / 1e7 if fix else "",
+        "longitude": lon / 1e7 if fix else "",
+        "altitude_m": alt / 10.0 if fix else "",
+        "satellites": sats,
+        "gps_fix": int(fix),
+        "satellites_used": used,
+        "snr_mean_dbhz": snr_mean or "",
+        "snr_max_dbhz": snr_max or "",
+        "free_heap": heap,
+        "rssi_dbm": rssi if flags & FLAG_WIFI else "",
+        "flags": flags,
+    }
+
+
+def read_log(data, sync=None):
+    """Decode a whole log file; a torn last record (power loss) is ignored.
+    `sync` is the last time sync of the previous file; returns this file's last one"""
+    header = parse_header(data)
+    body = data[HEADER_SIZE:]
+    count = len(body) // RECORD.size
+    offsets = [i * RECORD.size for i in range(count)]
+    is_sync = [header["version"] >= 2 and body[o + FLAGS_OFFSET] & FLAG_TIME_SYNC for o in offsets]
+    syncs = [decode_time_sync(TIME_SYNC.unpack_from(body, o)) for o, flag in zip(offsets, is_sync) if flag]
+    current = sync if sync is not None else (syncs[0] if syncs else None)
+    rows = []
+    for offset, flag in zip(offsets, is_sync):
+        if flag:
+            current = decode_time_sync(TIME_SYNC.unpack_from(body, offset))
+            continue
+        rows.append(decode_record(header["file_index"], RECORD.unpack_from(body, offset), current))
+    header["time_syncs"] = syncs
+    return header, rows, len(body) % RECORD.size, current
+
+
+def summary(path, header, rows, torn):
+    print(f"{path}: file #{header['file_index']} from {header['mac']}, "
+          f"interval {header['interval_ms']} ms, {len(rows)} records")
+    if len(rows) > 1:
+        gaps = [b["timestamp_ms"] - a["timestamp_ms"] for a, b in zip(rows, rows[1:])]
+        span = (rows[-1]["timestamp_ms"] - rows[0]["timestamp_ms"]) / 1000.0
+        late = sum(1 for g in gaps if g > header["interval_ms"] * 3 // 2)
+        print(f"  span {span:.1f} s, period min/max {min(gaps)}/{max(gaps)} ms, {late} gap(s) > 1.5x interval")
+    fixes = [r for r in rows if r["gps_fix"]]
+    if fixes:
+        # Horloge millis() : un premier fix dans le premier fichier donne le TTFF depuis le démarrage
+        snr = [r["snr_mean_dbhz"] for r in rows if r["snr_mean_dbhz"] != ""]
+        print(f"  first fix at {fixes[0]['timestamp_ms'] / 1000.0:.1f} s uptime, "
+              f"{len(fixes)}/{len(rows)} records with fix"
+              + (f", mean SNR {sum(snr) / len(snr):.1f} dB-Hz" if snr else ""))
+    syncs = header["time_syncs"]
+    if syncs:
+        print(f"  {len(syncs)} GPS time sync(s), UTC {rows[0]['utc'] if rows else ''} .. {rows[-1]['utc'] if rows else ''}, "
+              f"clock drift {syncs[-1]['drift_ppm']:+.3f} ppm, PPS jitter {syncs[-1]['jitter_us']:.1f} us RMS")
+    if torn:
+        print(f"  {torn} trailing byte(s) ignored")
+
+
+def encode(file_index, interval_ms, records, version=VERSION):
+    """Mirror of the device writer, used by the self-test; bytes entries are written as is"""
+    header = HEADER.pack(MAGIC, version, RECORD.size, 0, interval_ms, file_index, 1234,
+                         bytes([0x24, 0x6F, 0x28, 0x01, 0x02, 0x03]))
+    out = bytearray(header.ljust(HEADER_SIZE, b"\0"))
+    for record in records:
+        out += record if isinstance(record, bytes) else RECORD.pack(*record)
+    return bytes(out)
+
+
+def self_test():
+    """Round-trip synthetic records through encode/read_log/CSV"""
+    rng = random.Random(0xE5D1)
+    records = []
+    for i in range(100):
+        fix = i >= 10
+        flags = FLAG_AHT20 | FLAG_BMP280 | (FLAG_GPS_FIX if fix else 0) | (FLAG_WIFI if i % 7 else 0)
+        records.append((1000 + i * 100, 2150 + rng.randint(-50, 50), 4520, 101325,
+                        int(48.8583701e7) if fix else 0, int(2.2944813e7) if fix else 0,
+                        352 if fix else 0, 9, flags, 180000 - i, -61 if i % 7 else 0,
+                        8 if fix else 0, 38, 45))
+    records.append((99999, -32768, 0xFFFF, 0, 0, 0, 0, 0, 0, 150000, 0, 0, 0, 0))
+
+    blob = encode(3, 100, records)
+    failures = 0
+
+    header, rows, torn, _ = read_log(blob + b"\x01\x02")
+    checks = [
+        ("header", header["file_index"] == 3 and header["interval_ms"] == 100),
+        ("count", len(rows) == len(records) and torn == 2),
+        ("alignment", (len(blob) - HEADER_SIZE) % RECORD.size == 0 and 512 % RECORD.size == 0),
+        ("scaling", rows[20]["latitude"] == 48.8583701 and rows[20]["altitude_m"] == 35.2
+         and rows[20]["pressure_hpa"] == 1013.25 and rows[20]["humidity_pct"] == 45.2),
+        ("no fix", rows[0]["latitude"] == "" and rows[0]["gps_fix"] == 0),
+        ("signal", rows[20]["satellites_used"] == 8 and rows[20]["snr_mean_dbhz"] == 38
+         and rows[20]["snr_max_dbhz"] == 45),
+        ("n/a", rows[-1]["temperature_c"] == "" and rows[-1]["humidity_pct"] == ""
+         and rows[-1]["pressure_hpa"] == "" and rows[-1]["rssi_dbm"] == ""
+         and rows[-1]["snr_mean_dbhz"] == ""),
+    ]
+    # Version 2 : ancre à 1 500,250 ms locaux = 12:35:19 UTC, horloge locale rapide de 20 ppm,
+    # échantillon 10 s locaux plus loin = 9,999800 s GPS
+    sync = TIME_SYNC.pack(1500, 250, 0, 1774269319, 0, 20000, 0, 2, FLAG_TIME_SYNC, 2300, bytes(4))
+    synced = encode(4, 100, [records[0], sync, (11500,) + records[1][1:]])
+    v2_header, v2_rows, _, carried = read_log(synced)
+    _, next_rows, _, _ = read_log(encode(5, 100, [(21500,) + records[2][1:]]), carried)
+    _, v1_rows, _, _ = read_log(encode(4, 100, records[:2], version=1))
+    checks += [
+        ("time sync", len(v2_rows) == 2 and len(v2_header["time_syncs"]) == 1),
+        ("utc", v2_rows[1]["utc"] == "2026-03-23T12:35:28.999550Z"),
+        ("utc before sync", v2_rows[0]["utc"] == "2026-03-23T12:35:18.499760Z"),
+        ("utc next file", next_rows[0]["utc"] == "2026-03-23T12:35:38.999350Z"),
+        ("version 1", len(v1_rows) == 2 and v1_rows[0]["utc"] == ""),
+    ]
+
+    buffer = io.StringIO()
+    writer = csv.DictWriter(buffer, fieldnames=CSV_FIELDS)
+    writer.writeheader()
+    writer.writerows(rows)
+    checks.append(("csv", buffer.getvalue().count("\n") == len(records) + 1))
+
+    for label, blob_bad in (("bad magic", b"XXXX" + blob[4:]),
+                            ("short", blob[:100]),
+                            ("record size", blob[:5] + b"\x10" + blob[6:])):
+        try:
+            read_log(blob_bad)
+            checks.append((label + " rejected", False))
+        except ValueError:
+            checks.append((label + " rejected", True))
+
+    for label, ok in checks:
+        print(f"  {label}: {'OK' if ok else 'FAIL'}")
+        failures += 0 if ok else 1
+
+    print("\n✅ Self-test passed" if failures == 0 else f"\n❌ {failures} self-test failure(s)")
+    return failures == 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert ESP32 Diagnostic SD logger files to CSV")
+    parser.add_argument("logs", nargs="*", type=Path, help="LOGnnnnn.BIN files, in order")
+    parser.add_argument("-o", "--output", type=Path, help="write merged CSV to this file")
+    parser.add_argument("--self-test", action="store_true", help="run writer/reader round trip")
+    args = parser.parse_args()
+
+    if args.self_test:
+        return 0 if self_test() else 1
+    if not args.logs:
+        parser.print_help()
+        return 1
+
+    all_rows = []
+    sync = None
+    for path in sorted(args.logs):
+        header, rows, torn, sync = read_log(path.read_bytes(), sync)
+        summary(path, header, rows, torn)
+        all_rows.extend(rows)
+
+    if args.output:
+        with args.output.open("w", newline="") as handle:
+            writer = csv.DictWriter(handle, fieldnames=CSV_FIELDS)
+            writer.writeheader()
+            writer.writerows(all_rows)
+        print(f"CSV written to {args.output} ({len(all_rows)} records)")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,238 @@
+#!/usr/bin/env python3
+"""
+ESP32 Diagnostic - Trace Dump to Chrome trace_event JSON
+Version: 3.33.5
+
+Converts the per-core trace rings dumped by /api/trace into the Chrome
+trace_event format (open in chrome://tracing or https://ui.perfetto.dev).
+
+Usage:
+    python tools/trace_to_chrome.py dump.json -o trace.json           # from a saved dump
+    python tools/trace_to_chrome.py --url http://esp32-diagnostic.local -o trace.json
+    python tools/trace_to_chrome.py --self-test                       # synthetic rings
+
+Dump format (/api/trace):
+    cpu_mhz, names[id], tasks{handle: name}, utc_sync{esp_us, utc_us, drift_ppm} or null,
+    cores[]: core, recorded, sync_cycles, sync_us,
+             events[]: [cycles u32, type "B"|"E"|"i"|"s", name id, task handle (0 = ISR), arg u32]
+
+Timestamps: events hold the 32-bit cycle counter of their core. Consecutive
+events are unwrapped with a signed 32-bit difference (trace_sync events every
+second keep gaps far below the 2^31-cycle limit), then placed on the esp_timer
+timeline through the ring's last (sync_cycles, sync_us) anchor. With a GPS
+PPS lock, utc_sync maps that timeline to UTC (drift corrected): the UTC time
+of the trace origin goes to otherData.utc_origin.
+"""
+
+import argparse
+import json
+import sys
+import urllib.request
+from datetime import datetime, timedelta, timezone
+from pathlib import Path
+
+SYNC = "s"
+
+
+def signed32(value):
+    value &= 0xFFFFFFFF
+    return value - (1 << 32) if value & 0x80000000 else value
+
+
+def unwrap(cycles):
+    """32-bit counter values in ring order -> monotonic 64-bit values"""
+    result = []
+    for value in cycles:
+        result.append(value if not result else result[-1] + signed32(value - result[-1]))
+    return result
+
+
+def utc_iso(utc_us):
+    """Unix microseconds -> ISO 8601 UTC with microseconds"""
+    moment = datetime(1970, 1, 1, tzinfo=timezone.utc) + timedelta(microseconds=round(utc_us))
+    return moment.strftime("%Y-%m-%dT%H:%M:%S.%fZ")
+
+
+def convert(dump, keep_sync=False):
+    """Return the Chrome trace_event document for one /api/trace dump"""
+    mhz = dump.get("cpu_mhz") or 240
+    names = dump.get("names", [])
+    tasks = dump.get("tasks", {})
+    events = []
+    threads = {}
+
+    def thread_id(core, task):
+        key = f"isr{core}" if task == 0 else str(task)
+        if key not in threads:
+            label = f"ISR core {core}" if task == 0 else tasks.get(str(task), f"task 0x{task:08x}")
+            threads[key] = (len(threads) + 1, label)
+        return threads[key][0]
+
+    for ring in dump.get("cores", []):
+        raw = ring.get("events", [])
+        if not raw:
+            continue
+        absolute = unwrap([e[0] for e in raw])
+        anchor = absolute[-1] + signed32(ring["sync_cycles"] - raw[-1][0])
+        open_spans = {}
+        for (cycles, kind, name_id, task, arg), abs_cycles in zip(raw, absolute):
+            if kind == SYNC and not keep_sync:
+                continue
+            tid = thread_id(ring["core"], task)
+            name = names[name_id] if name_id < len(names) else f"#{name_id}"
+            stack = open_spans.setdefault(tid, [])
+            if kind == "B":
+                stack.append(name)
+            elif kind == "E":
+                # Début tombé hors de l'anneau : on ignore la fin orpheline
+                if name not in stack:
+                    continue
+                while stack and stack.pop() != name:
+                    pass
+            event = {
+                "name": name,
+                "ph": "i" if kind == SYNC else kind,
+                "ts": ring["sync_us"] + (abs_cycles - anchor) / mhz,
+                "pid": 0,
+                "tid": tid,
+                "args": {"core": ring["core"], "arg": arg},
+            }
+            if event["ph"] == "i":
+                event["s"] = "t"
+            events.append(event)
+
+    events.sort(key=lambda e: e["ts"])
+    origin = events[0]["ts"] if events else 0
+    for event in events:
+        event["ts"] = round(event["ts"] - origin, 3)
+    metadata = [{"name": "process_name", "ph": "M", "pid": 0, "args": {"name": "ESP32 Diagnostic"}}]
+    for tid, label in sorted(threads.values()):
+        metadata.append({"name": "thread_name", "ph": "M", "pid": 0, "tid": tid, "args": {"name": label}})
+    document = {"traceEvents": metadata + events, "displayTimeUnit": "ms"}
+    sync = dump.get("utc_sync")
+    if sync and events:
+        # Microsecondes locales ramenées en microsecondes GPS par la dérive mesurée
+        utc_origin = sync["utc_us"] + (origin - sync["esp_us"]) / (1 + sync["drift_ppm"] * 1e-6)
+        document["otherData"] = {"utc_origin": utc_iso(utc_origin), "drift_ppm": sync["drift_ppm"]}
+    return document
+
+
+def summary(document):
+    spans = {}
+    opened = {}
+    for event in document["traceEvents"]:
+        key = (event.get("tid"), event["name"])
+        if event["ph"] == "B":
+            opened.setdefault(key, []).append(event["ts"])
+        elif event["ph"] == "E" and opened.get(key):
+            duration = event["ts"] - opened[key].pop()
+            total, count, worst = spans.get(event["name"], (0.0, 0, 0.0))
+            spans[event["name"]] = (total + duration, count + 1, max(worst, duration))
+    for name, (total, count, worst) in sorted(spans.items(), key=lambda item: -item[1][0])[:15]:
+        print(f"  {name:32s} {count:5d} x  avg {total / count / 1000:8.2f} ms  max {worst / 1000:8.2f} ms")
+
+
+def synthetic_dump():
+    """Two rings whose cycle counters wrap, with an orphan end and an ISR instant"""
+    mhz = 240
+    names = ["(none)", "(overflow)", "trace_sync", "/api/overview", "GPSTest", "rotary_step"]
+    start0 = 0xFFFFFFFF - 240 * 1500      # core 0 wraps 1.5 ms after its first event
+    start1 = 0x7FFFFF00
+
+    def cyc(base, us):
+        return (base + us * mhz) & 0xFFFFFFFF
+
+    core0 = [
+        [cyc(start0, 0), "E", 3, 0x3FFB0001, 0],       # orphan end (start overwritten)
+        [cyc(start0, 100), "s", 2, 0x3FFB0002, 0],
+        [cyc(start0, 1000), "B", 4, 0x3FFB0001, 0],
+        [cyc(start0, 1200), "i", 5, 0, 7],             # ISR
+        [cyc(start0, 1001000), "s", 2, 0x3FFB0002, 0],
+        [cyc(start0, 1801000), "E", 4, 0x3FFB0001, 0],
+    ]
+    core1 = [
+        [cyc(start1, 500), "B", 3, 0x3FFB1000, 0],
+        [cyc(start1, 48500), "E", 3, 0x3FFB1000, 1390],
+    ]
+    return {
+        "cpu_mhz": mhz,
+        "names": names,
+        "tasks": {str(0x3FFB0001): "GPSTest", str(0x3FFB1000): "loopTask"},
+        "cores": [
+            {"core": 0, "recorded": 6, "sync_cycles": cyc(start0, 2001000), "sync_us": 5_002_000, "events": core0},
+            {"core": 1, "recorded": 2, "sync_cycles": cyc(start1, 1000500), "sync_us": 5_000_000 + 1500, "events": core1},
+        ],
+    }
+
+
+def self_test():
+    """Convert a synthetic dump and check timestamps, pairing and threads"""
+    document = convert(synthetic_dump())
+    dump = synthetic_dump()
+    dump["utc_sync"] = {"esp_us": 5_000_000, "utc_us": 1_774_269_319_000_000, "drift_ppm": 20.0}
+    located = convert(dump)
+    events = [e for e in document["traceEvents"] if e["ph"] != "M"]
+    threads = {e["tid"]: e["args"]["name"] for e in document["traceEvents"] if e["name"] == "thread_name"}
+    by_name = {}
+    for event in events:
+        by_name.setdefault((event["name"], event["ph"]), []).append(event)
+
+    gps = by_name[("GPSTest", "B")][0], by_name[("GPSTest", "E")][0]
+    overview = by_name[("/api/overview", "B")][0], by_name[("/api/overview", "E")]
+    isr = by_name[("rotary_step", "i")][0]
+    checks = [
+        ("sorted", all(a["ts"] <= b["ts"] for a, b in zip(events, events[1:]))),
+        ("wrap", abs(gps[1]["ts"] - gps[0]["ts"] - 1_800_000) < 0.01),
+        ("orphan end dropped", len(overview[1]) == 1 and overview[1][0]["args"]["arg"] == 1390),
+        ("cross-core", abs(overview[0]["ts"] - gps[0]["ts"] - 999_500) < 0.01),
+        ("isr thread", threads[isr["tid"]] == "ISR core 0" and isr["s"] == "t"),
+        ("task names", threads[gps[0]["tid"]] == "GPSTest" and threads[overview[0]["tid"]] == "loopTask"),
+        ("sync hidden", not any(e["name"] == "trace_sync" for e in events)),
+        # Origine 1 997 960 µs locaux avant l'ancre, à +20 ppm
+        ("utc origin", located["otherData"]["utc_origin"] == "2026-03-23T12:35:17.002040Z"
+         and "otherData" not in document),
+        ("json", json.loads(json.dumps(document)) == document),
+    ]
+    failures = 0
+    for label, ok in checks:
+        print(f"  {label}: {'OK' if ok else 'FAIL'}")
+        failures += 0 if ok else 1
+
+    print("\n✅ Self-test passed" if failures == 0 else f"\n❌ {failures} self-test failure(s)")
+    return failures == 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert an ESP32 Diagnostic /api/trace dump to Chrome trace JSON")
+    parser.add_argument("dump", nargs="?", type=Path, help="saved /api/trace response")
+    parser.add_argument("--url", help="device base URL, fetches /api/trace directly")
+    parser.add_argument("-o", "--output", type=Path, help="write Chrome trace JSON to this file")
+    parser.add_argument("--keep-sync", action="store_true", help="keep trace_sync anchor events")
+    parser.add_argument("--self-test", action="store_true", help="run synthetic conversion checks")
+    args = parser.parse_args()
+
+    if args.self_test:
+        return 0 if self_test() else 1
+    if args.url:
+        with urllib.request.urlopen(args.url.rstrip("/") + "/api/trace", timeout=30) as response:
+            dump = json.load(response)
+    elif args.dump:
+        dump = json.loads(args.dump.read_text())
+    else:
+        parser.print_help()
+        return 1
+
+    document = convert(dump, args.keep_sync)
+    count = sum(1 for e in document["traceEvents"] if e["ph"] != "M")
+    print(f"{count} events, {sum(len(c.get('events', [])) for c in dump.get('cores', []))} recorded in the rings")
+    if "otherData" in document:
+        print(f"UTC origin {document['otherData']['utc_origin']}, clock drift {document['otherData']['drift_ppm']:+.3f} ppm")
+    summary(document)
+    if args.output:
+        args.output.write_text(json.dumps(document))
+        print(f"Chrome trace written to {args.output}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -343,10 +343,34 @@ function startAutoUpdate() {
         if (isConnected) updateLiveData();
     }, UPDATE_INTERVAL);
 }
+// Sections lues au chargement : un seul aller-retour /api/dashboard pour l'en-tête et les onglets
+const DASHBOARD_FIELDS = 'system,chip,memory,wifi,gpio,leds,screens';
+const DASHBOARD_REUSE_MS = 5000;
+let dashboardRequest = null;
+let dashboardRequestTime = 0;
+
+function loadDashboard(fields) {
+    const now = Date.now();
+    if (dashboardRequest && now - dashboardRequestTime < DASHBOARD_REUSE_MS) {
+        return dashboardRequest;
+    }
+    const request = fetchApi('/api/dashboard?fields=' + fields).then(r => {
+        if (!r.ok) throw new Error('dashboard fetch failed');
+        return readApiResponse(r);
+    });
+    if (fields === DASHBOARD_FIELDS) {
+        dashboardRequest = request;
+        dashboardRequestTime = now;
+        request.catch(() => { dashboardRequest = null; });
+    }
+    return request;
+}
+
 async function loadAllData() {
     showUpdateIndicator();
     try {
-        await Promise.all([updateSystemInfo(), updateMemoryInfo(), updateWiFiInfo(), updatePeripheralsInfo()]);
+        const d = await loadDashboard(DASHBOARD_FIELDS);
+        updateSystemInfo(d.system);
         isConnected = true;
         updateStatusIndicator(true);
     } catch (error) {
@@ -356,10 +380,101 @@ async function loadAllData() {
     }
     hideUpdateIndicator();
 }
+// CBOR (RFC 8949) decoder for the firmware's ENABLE_CBOR_API responses
+function decodeCbor(buffer) {
+    const view = new DataView(buffer);
+    const bytes = new Uint8Array(buffer);
+    const utf8 = new TextDecoder();
+    let pos = 0;
+    const BREAK = {};
+    function length(info) {
+        if (info < 24) return info;
+        if (info === 24) return view.getUint8(pos++);
+        if (info === 25) { pos += 2; return view.getUint16(pos - 2); }
+        if (info === 26) { pos += 4; return view.getUint32(pos - 4); }
+        if (info === 27) { pos += 8; return view.getUint32(pos - 8) * 4294967296 + view.getUint32(pos - 4); }
+        if (info === 31) return -1;
+        throw new Error('CBOR: invalid length');
+    }
+    function single(value) {
+        // Plus courte écriture décimale qui redonne le même float (valeur affichée par le JSON)
+        for (let p = 1; p < 10; p++) {
+            const candidate = parseFloat(value.toPrecision(p));
+            if (Math.fround(candidate) === value) return candidate;
+        }
+        return value;
+    }
+    function half(bits) {
+        const exponent = (bits >> 10) & 0x1f;
+        const mantissa = bits & 0x3ff;
+        const value = exponent === 0 ? mantissa * Math.pow(2, -24)
+            : exponent === 31 ? (mantissa ? NaN : Infinity)
+            : (1024 + mantissa) * Math.pow(2, exponent - 25);
+        return bits & 0x8000 ? -value : value;
+    }
+    function item() {
+        const initial = bytes[pos++];
+        if (initial === undefined) throw new Error('CBOR: truncated');
+        if (initial === 0xff) return BREAK;
+        const major = initial >> 5;
+        const info = initial & 0x1f;
+        if (major === 7) {
+            if (info === 20) return false;
+            if (info === 21) return true;
+            if (info === 22 || info === 23) return null;
+            if (info === 25) { pos += 2; return half(view.getUint16(pos - 2)); }
+            if (info === 26) { pos += 4; return single(view.getFloat32(pos - 4)); }
+            if (info === 27) { pos += 8; return view.getFloat64(pos - 8); }
+            throw new Error('CBOR: unsupported simple value');
+        }
+        const n = length(info);
+        if (major === 0) return n;
+        if (major === 1) return -1 - n;
+        if (major === 2 || major === 3) {
+            const slice = bytes.subarray(pos, pos + n);
+            pos += n;
+            return major === 3 ? utf8.decode(slice) : slice;
+        }
+        if (major === 4) {
+            const list = [];
+            while (n < 0 || list.length < n) {
+                const v = item();
+                if (v === BREAK) break;
+                list.push(v);
+            }
+            return list;
+        }
+        if (major === 5) {
+            const obj = {};
+            for (let i = 0; n < 0 || i < n; i++) {
+                const key = item();
+                if (key === BREAK) break;
+                obj[key] = item();
+            }
+            return obj;
+        }
+        throw new Error('CBOR: unsupported major type ' + major);
+    }
+    return item();
+}
+
+// JSON ou CBOR selon le Content-Type renvoyé (le firmware peut avoir ENABLE_CBOR_API désactivé)
+async function readApiResponse(r) {
+    const type = r.headers.get('Content-Type') || '';
+    if (type.indexOf('application/cbor') === 0) {
+        return decodeCbor(await r.arrayBuffer());
+    }
+    return r.json();
+}
+
+function fetchApi(url) {
+    return fetch(url, { headers: { 'Accept': 'application/cbor, application/json' } });
+}
+
 async function updateLiveData() {
     try {
-        const response = await fetch('/api/status');
-        const data = await response.json();
+        const response = await fetchApi('/api/status');
+        const data = await readApiResponse(response);
         updateRealtimeValues(data);
         isConnected = true;
         updateStatusIndicator(true);
@@ -369,9 +484,7 @@ async function updateLiveData() {
         updateStatusIndicator(false);
     }
 }
-async function updateSystemInfo() {
-    const r = await fetch('/api/system-info');
-    const d = await r.json();
+function updateSystemInfo(d) {
     const chipModelEl = document.getElementById('chipModel');
     if (chipModelEl) {
         chipModelEl.textContent = d.chipModel || '';
@@ -409,15 +522,6 @@ async function updateSystemInfo() {
     }
     applyAccessLinkScheme();
 }
-async function updateMemoryInfo() {
-    await fetch('/api/memory');
-}
-async function updateWiFiInfo() {
-    await fetch('/api/wifi-info');
-}
-async function updatePeripheralsInfo() {
-    await fetch('/api/peripherals');
-}
 
 function showTab(tabName, btn) {
     var contents = document.querySelectorAll('.tab-content');
@@ -504,15 +608,11 @@ async function loadTab(tabName) {
     tab.classList.add('active');
     try {
         if (tabName === 'overview') {
-            const r = await fetch('/api/overview');
-            const d = await r.json();
+            const d = await loadDashboard(DASHBOARD_FIELDS);
             tab.innerHTML = buildOverview(d);
         } else if (tabName === 'display-signal') {
-            const leds = await fetch('/api/leds-info');
-            const screens = await fetch('/api/screens-info');
-            const ld = await leds.json();
-            const sd = await screens.json();
-            tab.innerHTML = buildDisplaySignal(ld, sd);
+            const d = await loadDashboard('leds,screens');
+            tab.innerHTML = buildDisplaySignal(d.leds, d.screens);
         } else if (tabName === 'sensors') {
             tab.innerHTML = buildSensors();
             loadEnvironmentalData();
@@ -731,6 +831,15 @@ function buildTests() {
     h += '<div style="text-align:center;margin:20px 0"><button class="btn btn-primary" data-i18n="start_adc_test" data-i18n-prefix="▶️" onclick="testADC()">' + tr('start_adc_test') + '</button></div>';
     h += '<div id="adc-status" class="status-live" data-i18n="click_to_test">' + tr('click_to_test') + '</div>';
     h += '<div id="adc-results" class="info-grid"></div></div>';
+    h += '<div class="section"><h2 data-i18n="adc_continuous" data-i18n-prefix="📈">' + tr('adc_continuous') + '</h2>';
+    h += '<p data-i18n="adc_continuous_desc">' + tr('adc_continuous_desc') + '</p>';
+    h += '<div style="text-align:center;margin:20px 0">';
+    h += '<span data-i18n="adc_pins">' + tr('adc_pins') + '</span>: <input type="text" id="adc-stream-pins" value="" placeholder="4,5" style="width:100px;padding:5px;margin:5px;border:1px solid #ccc;border-radius:5px"> ';
+    h += '<span data-i18n="adc_rate">' + tr('adc_rate') + '</span>: <input type="number" id="adc-stream-rate" value="20000" min="1000" max="80000" step="1000" style="width:100px;padding:5px;margin:5px;border:1px solid #ccc;border-radius:5px"> ';
+    h += '<button id="adc-stream-btn" class="btn btn-primary" data-i18n="start_stream" data-i18n-prefix="▶️" onclick="toggleADCStream()">' + tr('start_stream') + '</button></div>';
+    h += '<div id="adc-stream-status" class="status-live" data-i18n="click_to_test">' + tr('click_to_test') + '</div>';
+    h += '<div id="adc-stream-results" class="info-grid"></div>';
+    h += '<canvas id="adc-spectrum" width="512" height="120" style="width:100%;max-width:640px;display:block;margin:10px auto;background:#f8f9fa;border-radius:5px"></canvas></div>';
     h += '<div class="section"><h2 data-i18n="pwm_test" data-i18n-prefix="🎚️">' + tr('pwm_test') + '</h2>';
     h += '<p data-i18n="pwm_test_desc">' + tr('pwm_test_desc') + '</p>';
     h += '<div style="text-align:center;margin:20px 0"><button class="btn btn-primary" data-i18n="start_pwm_test" data-i18n-prefix="🎛️" onclick="runPWMTest()">' + tr('start_pwm_test') + '</button></div>';
@@ -934,9 +1043,14 @@ function buildMemory() {
     h += '<button class="btn btn-success" onclick="testSDRead()" data-i18n="sd_test_read" data-i18n-prefix="📖">' + tr('sd_test_read') + '</button> ';
     h += '<button class="btn btn-warning" onclick="testSDWrite()" data-i18n="sd_test_write" data-i18n-prefix="✍️">' + tr('sd_test_write') + '</button> ';
     h += '<button class="btn btn-danger" onclick="formatSD()" data-i18n="sd_format" data-i18n-prefix="⚠️">' + tr('sd_format') + '</button> ';
-    h += '<button class="btn btn-info" onclick="loadSDInfo()" data-i18n="refresh" data-i18n-prefix="🔄">' + tr('refresh') + '</button>';
+    h += '<button class="btn btn-info" onclick="loadSDInfo()" data-i18n="refresh" data-i18n-prefix="🔄">' + tr('refresh') + '</button> ';
+    h += '<button class="btn btn-secondary" onclick="benchmarkSD()" data-i18n="sd_benchmark" data-i18n-prefix="⏱️">' + tr('sd_benchmark') + '</button>';
     h += '</div><div id="sd-status" class="status-live" data-i18n="click_to_test">' + tr('click_to_test') + '</div>';
-    h += '<div id="sd-results" class="info-grid"></div></div>';
+    h += '<div id="sd-results" class="info-grid"></div>';
+    h += '<div style="text-align:center;margin:15px 0"><strong data-i18n="sd_logger">' + tr('sd_logger') + '</strong> ';
+    h += '<span data-i18n="sd_log_interval">' + tr('sd_log_interval') + '</span>: <input type="number" id="sdLogInterval" value="1000" min="10" max="600000" style="width:90px"/> ';
+    h += '<button id="sd-log-btn" class="btn btn-success" onclick="toggleSDLogger()" data-i18n="sd_log_start" data-i18n-prefix="⏺️">' + tr('sd_log_start') + '</button></div>';
+    h += '<div id="sd-log-results" class="info-grid"></div></div>';
     h += '</div>';
     return h;
 }
@@ -992,9 +1106,11 @@ function buildSensors() {
     h += '<input type="number" id="distEcho" value="' + DISTANCE_ECHO_PIN + '" style="width:60px" data-i18n-placeholder="label_echo" placeholder="' + tr('label_echo') + '"/>';
     h += '<button class="btn btn-info" onclick="applyDistanceConfig()" data-i18n="apply_config">' + tr('apply_config') + '</button></div></div></div>';
     h += '<div style="text-align:center;margin:15px 0">';
-    h += '<button class="btn btn-primary" onclick="testDistanceSensor()" data-i18n="test_distance_sensor" data-i18n-prefix="▶️">' + tr('test_distance_sensor') + '</button>';
+    h += '<button class="btn btn-primary" onclick="testDistanceSensor()" data-i18n="test_distance_sensor" data-i18n-prefix="▶️">' + tr('test_distance_sensor') + '</button> ';
+    h += '<button id="distance-stream-btn" class="btn btn-info" onclick="toggleDistanceStream()" data-i18n="start_stream" data-i18n-prefix="📈">' + tr('start_stream') + '</button>';
     h += '</div><div id="distance-status" class="status-live" data-i18n="click_to_test">' + tr('click_to_test') + '</div>';
-    h += '<div id="distance-results" class="info-grid"></div></div>';
+    h += '<div id="distance-results" class="info-grid"></div>';
+    h += '<canvas id="distance-chart" width="512" height="100" style="width:100%;max-width:640px;display:none;margin:10px auto;background:#f8f9fa;border-radius:5px"></canvas></div>';
     h += '<h3 data-i18n="motion_sensor" data-i18n-prefix="👁️">' + tr('motion_sensor') + '</h3>';
     h += '<p data-i18n="motion_sensor_desc">' + tr('motion_sensor_desc') + '</p>';
     h += '<div class="card"><div class="info-grid">';
@@ -1362,6 +1478,70 @@ async function testADC() {
     document.getElementById('adc-results').innerHTML = h;
     setStatus('adc-status', d.result, null);
 }
+let adcStreamInterval = null;
+async function toggleADCStream() {
+    const btn = document.getElementById('adc-stream-btn');
+    if (adcStreamInterval) {
+        clearInterval(adcStreamInterval);
+        adcStreamInterval = null;
+        await fetch('/api/adc-continuous?action=stop');
+        btn.textContent = '▶️ ' + tr('start_stream');
+        btn.className = 'btn btn-primary';
+        setStatus('adc-stream-status', tr('stop_monitoring'), null);
+        return;
+    }
+    const pins = document.getElementById('adc-stream-pins').value.trim();
+    const rate = document.getElementById('adc-stream-rate').value;
+    let url = '/api/adc-continuous?action=start&rate=' + encodeURIComponent(rate);
+    if (pins) url += '&pins=' + encodeURIComponent(pins);
+    const r = await fetch(url);
+    const d = await r.json();
+    if (!d.running) {
+        setStatus('adc-stream-status', d.message || d.error, 'error');
+        return;
+    }
+    btn.textContent = '⏸️ ' + tr('stop_stream');
+    btn.className = 'btn btn-danger';
+    setStatus('adc-stream-status', (d.dma ? 'DMA' : 'polling') + ' @ ' + d.per_channel_rate + ' S/s/ch' + (d.calibrated ? '' : ' (' + tr('adc_uncalibrated') + ')'), 'success');
+    adcStreamInterval = setInterval(updateADCStream, 500);
+}
+async function updateADCStream() {
+    const r = await fetch('/api/adc-stream?fft=0');
+    const d = await r.json();
+    let h = '';
+    d.channels.forEach(ch => {
+        h += '<div class="info-item"><div class="info-label">GPIO ' + ch.pin + '</div><div class="info-value">';
+        h += ch.mean_mv.toFixed(1) + ' mV (RMS ' + ch.rms_mv.toFixed(1) + ', σ ' + ch.noise_mv.toFixed(2) + ')<br>';
+        h += ch.min_mv + ' … ' + ch.max_mv + ' mV, ' + ch.count + ' ' + tr('samples');
+        if (ch.histogram) {
+            const peak = Math.max(1, ...ch.histogram.counts);
+            h += '<div style="display:flex;align-items:flex-end;height:30px;gap:1px;margin-top:5px">';
+            ch.histogram.counts.forEach(c => {
+                h += '<div style="flex:1;background:#667eea;height:' + Math.round(c * 100 / peak) + '%"></div>';
+            });
+            h += '</div>';
+        }
+        h += '</div></div>';
+    });
+    h += '<div class="info-item"><div class="info-label">' + tr('overruns') + '</div><div class="info-value">' + d.overruns + '</div></div>';
+    document.getElementById('adc-stream-results').innerHTML = h;
+    const cv = document.getElementById('adc-spectrum');
+    if (cv && d.spectrum && d.spectrum.mags_mv.length > 1) {
+        const ctx = cv.getContext('2d');
+        const mags = d.spectrum.mags_mv.slice(1);
+        const peak = Math.max(0.01, ...mags);
+        ctx.clearRect(0, 0, cv.width, cv.height);
+        ctx.fillStyle = '#667eea';
+        const w = cv.width / mags.length;
+        mags.forEach((m, i) => {
+            const bh = m / peak * (cv.height - 14);
+            ctx.fillRect(i * w, cv.height - bh, Math.max(1, w - 1), bh);
+        });
+        const top = mags.indexOf(peak) + 1;
+        ctx.fillStyle = '#333';
+        ctx.fillText((top * d.spectrum.bin_hz).toFixed(0) + ' Hz: ' + peak.toFixed(2) + ' mV', 4, 11);
+    }
+}
 async function testAllGPIO() {
     setStatus('gpio-status', {
         key: 'test_in_progress'
@@ -1443,8 +1623,8 @@ async function loadWirelessInfo() {
 }
 async function loadGPSData() {
     try {
-        const r = await fetch('/api/gps');
-        const d = await r.json();
+        const r = await fetchApi('/api/gps');
+        const d = await readApiResponse(r);
         const statusNode = document.getElementById('gps-status-value');
         const latNode = document.getElementById('gps-latitude');
         const lonNode = document.getElementById('gps-longitude');
@@ -1499,8 +1679,8 @@ async function testGPS() {
 }
 async function loadEnvironmentalData() {
     try {
-        const r = await fetch('/api/environmental-sensors');
-        const d = await r.json();
+        const r = await fetchApi('/api/environmental-sensors');
+        const d = await readApiResponse(r);
         const aht20Node = document.getElementById('env-aht20-status');
         const bmp280Node = document.getElementById('env-bmp280-status');
         const tempNode = document.getElementById('env-temp-avg');
@@ -1859,6 +2039,10 @@ async function testDHTSensor() {
     document.getElementById('dht-results').innerHTML = '';
     const r = await fetch('/api/dht-test');
     const d = await r.json();
+    if (d.pending) {
+        setTimeout(testDHTSensor, 500);
+        return;
+    }
     if (d.type !== undefined) {
         document.getElementById('dhtSensorType').value = String(d.type);
     }
@@ -1907,6 +2091,10 @@ async function testDistanceSensor() {
     document.getElementById('distance-results').innerHTML = '';
     const r = await fetch('/api/distance-sensor-test');
     const d = await r.json();
+    if (d.pending) {
+        setTimeout(testDistanceSensor, 300);
+        return;
+    }
     if (d.success) {
         let h = '';
         h += '<div class="info-item"><div class="info-label" data-i18n="distance">' + tr('distance') + '</div><div class="info-value">' + d.distance.toFixed(2) + ' cm</div></div>';
@@ -1914,6 +2102,73 @@ async function testDistanceSensor() {
     }
     setStatus('distance-status', d.result, d.success ? 'success' : 'error');
 }
+let distanceStreamInterval = null;
+let distanceHistory = [];
+let distanceStreamNext = 0;
+async function toggleDistanceStream() {
+    const btn = document.getElementById('distance-stream-btn');
+    const cv = document.getElementById('distance-chart');
+    if (distanceStreamInterval) {
+        clearInterval(distanceStreamInterval);
+        distanceStreamInterval = null;
+        await fetch('/api/distance-stream?action=stop');
+        btn.textContent = '📈 ' + tr('start_stream');
+        btn.className = 'btn btn-info';
+        setStatus('distance-status', tr('stop_monitoring'), null);
+        return;
+    }
+    const r = await fetch('/api/distance-stream?action=start');
+    const d = await r.json();
+    if (!d.running) {
+        setStatus('distance-status', d.message || tr('configuration_invalid'), 'error');
+        return;
+    }
+    distanceHistory = [];
+    distanceStreamNext = d.next;
+    if (cv) cv.style.display = 'block';
+    btn.textContent = '⏸️ ' + tr('stop_stream');
+    btn.className = 'btn btn-danger';
+    setStatus('distance-status', d.rate_hz + ' Hz', 'success');
+    distanceStreamInterval = setInterval(updateDistanceStream, 250);
+}
+async function updateDistanceStream() {
+    const r = await fetch('/api/distance-stream?since=' + distanceStreamNext);
+    const d = await r.json();
+    distanceStreamNext = d.next;
+    d.samples.forEach(s => distanceHistory.push(s));
+    if (distanceHistory.length > 200) distanceHistory = distanceHistory.slice(-200);
+    let h = '';
+    h += '<div class="info-item"><div class="info-label" data-i18n="distance">' + tr('distance') + '</div><div class="info-value">' + (d.valid ? d.distance_cm.toFixed(1) + ' cm' : '-') + '</div></div>';
+    h += '<div class="info-item"><div class="info-label" data-i18n="distance_raw">' + tr('distance_raw') + '</div><div class="info-value">' + (d.valid ? d.raw_cm.toFixed(1) + ' cm' : '-') + '</div></div>';
+    h += '<div class="info-item"><div class="info-label" data-i18n="sound_speed">' + tr('sound_speed') + '</div><div class="info-value">' + d.sound_speed.toFixed(1) + ' m/s (' + d.temperature_c.toFixed(1) + ' °C)</div></div>';
+    h += '<div class="info-item"><div class="info-label">Timeouts</div><div class="info-value">' + d.timeouts + ' / ' + d.triggers + '</div></div>';
+    document.getElementById('distance-results').innerHTML = h;
+    const cv = document.getElementById('distance-chart');
+    if (cv && distanceHistory.length > 1) {
+        const ctx = cv.getContext('2d');
+        const values = distanceHistory.map(s => s[1]).concat(distanceHistory.map(s => s[2]));
+        const lo = Math.min(...values);
+        const hi = Math.max(lo + 1, ...values);
+        const x = i => i * cv.width / (distanceHistory.length - 1);
+        const y = v => cv.height - 4 - (v - lo) / (hi - lo) * (cv.height - 16);
+        ctx.clearRect(0, 0, cv.width, cv.height);
+        [[1, '#c3c8f5'], [2, '#667eea']].forEach(([k, color]) => {
+            ctx.strokeStyle = color;
+            ctx.beginPath();
+            distanceHistory.forEach((s, i) => {
+                if (i) ctx.lineTo(x(i), y(s[k]));
+                else ctx.moveTo(x(i), y(s[k]));
+            });
+            ctx.stroke();
+        });
+        ctx.fillStyle = '#333';
+        ctx.fillText(lo.toFixed(1) + ' … ' + hi.toFixed(1) + ' cm', 4, 11);
+    }
+    if (!d.running) {
+        clearInterval(distanceStreamInterval);
+        distanceStreamInterval = null;
+    }
+}
 async function applyMotionConfig() {
     const pin = parseInt(document.getElementById('motionPin').value);
     const resp = await fetch('/api/motion-sensor-config?pin=' + pin);
@@ -1968,6 +2223,81 @@ async function loadSDInfo() {
     }
     setStatus('sd-status', d.result, d.available ? 'success' : 'error');
 }
+function renderSDBenchmark(d) {
+    const fmtBlock = b => b >= 1024 ? (b / 1024) + ' KB' : b + ' B';
+    let h = '';
+    d.clocks.forEach(c => {
+        let v = '';
+        if (!c.mounted) {
+            v = tr('not_detected');
+        } else {
+            c.sequential.forEach(s => {
+                v += fmtBlock(s.block) + ': W ' + s.write_mbps.toFixed(2) + ' / R ' + s.read_mbps.toFixed(2) + ' MB/s (p99 ' + s.write_us.p99 + ' / ' + s.read_us.p99 + ' µs)<br>';
+            });
+            v += '4K random: ' + c.random_4k.read_iops.toFixed(0) + ' / ' + c.random_4k.write_iops.toFixed(0) + ' IOPS (p99 ' + c.random_4k.read_us.p99 + ' / ' + c.random_4k.write_us.p99 + ' µs)';
+        }
+        h += '<div class="info-item"><div class="info-label">SPI ' + (c.khz / 1000) + ' MHz</div><div class="info-value" style="font-size:0.85em">' + v + '</div></div>';
+    });
+    document.getElementById('sd-results').innerHTML = h;
+}
+async function benchmarkSD() {
+    setStatus('sd-status', {
+        key: 'test_in_progress'
+    }, null);
+    const r = await fetch('/api/sd-benchmark');
+    let d = await r.json();
+    while (d.running) {
+        await new Promise(res => setTimeout(res, 1000));
+        d = await (await fetch('/api/sd-benchmark-results')).json();
+    }
+    if (d.clocks) renderSDBenchmark(d);
+    setStatus('sd-status', d.result || d.message, d.completed ? 'success' : 'error');
+}
+let sdLoggerInterval = null;
+function renderSDLogger(d) {
+    const btn = document.getElementById('sd-log-btn');
+    if (btn) {
+        btn.textContent = d.running ? '⏹️ ' + tr('sd_log_stop') : '⏺️ ' + tr('sd_log_start');
+        btn.className = d.running ? 'btn btn-danger' : 'btn btn-success';
+    }
+    const items = [
+        [tr('sd_log_file'), d.file + ' (' + (d.file_bytes / 1024).toFixed(1) + ' KB)'],
+        [tr('sd_log_records'), d.records_logged + ' / ' + d.records_dropped + ' ' + tr('sd_log_dropped')],
+        [tr('sd_log_writes'), d.buffers_written + ' (' + d.last_write_ms + ' ms, max ' + d.max_write_ms + ' ms)'],
+        [tr('sd_log_errors'), d.write_errors + ' / ' + d.late_ticks + ' late, ' + d.rotations + ' rotations']
+    ];
+    let h = '';
+    items.forEach(it => {
+        h += '<div class="info-item"><div class="info-label">' + it[0] + '</div><div class="info-value">' + it[1] + '</div></div>';
+    });
+    document.getElementById('sd-log-results').innerHTML = h;
+}
+async function toggleSDLogger() {
+    const running = sdLoggerInterval !== null;
+    let url = '/api/sd-logger?action=' + (running ? 'stop' : 'start');
+    if (!running) url += '&interval_ms=' + encodeURIComponent(document.getElementById('sdLogInterval').value);
+    const r = await fetch(url);
+    const d = await r.json();
+    if (sdLoggerInterval) {
+        clearInterval(sdLoggerInterval);
+        sdLoggerInterval = null;
+    }
+    if (d.success === false) {
+        setStatus('sd-status', d.message, 'error');
+        return;
+    }
+    renderSDLogger(d);
+    if (d.running) {
+        sdLoggerInterval = setInterval(async () => {
+            const d = await (await fetch('/api/sd-logger')).json();
+            renderSDLogger(d);
+            if (!d.running) {
+                clearInterval(sdLoggerInterval);
+                sdLoggerInterval = null;
+            }
+        }, 2000);
+    }
+}
 async function testSDRead() {
     setStatus('sd-status', {
         key: 'sd_read_test_running'